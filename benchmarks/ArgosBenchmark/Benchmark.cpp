@@ -0,0 +1,97 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <thread>
+
+namespace argos_bench
+{
+    namespace
+    {
+        double scale_factor = 1.0;
+
+        const void* volatile sink = nullptr;
+    }
+
+    void keep_address(const void* ptr)
+    {
+        sink = ptr;
+    }
+
+    std::vector<Benchmark>& all_benchmarks()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    BenchmarkRegistrar::BenchmarkRegistrar(std::string name,
+                                           std::string description,
+                                           BenchmarkFunction function)
+    {
+        all_benchmarks().push_back({std::move(name), std::move(description),
+                                    function});
+    }
+
+    double measure_threads(unsigned thread_count, size_t iterations,
+                           const std::function<void(unsigned, size_t)>& func)
+    {
+        std::latch ready(thread_count + 1);
+        std::latch go(1);
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for (unsigned t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                ready.count_down();
+                go.wait();
+                for (size_t i = 0; i < iterations; ++i)
+                    func(t, i);
+            });
+        }
+
+        ready.arrive_and_wait();
+        const auto start = std::chrono::steady_clock::now();
+        go.count_down();
+        for (auto& thread : threads)
+            thread.join();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    std::vector<unsigned> thread_counts()
+    {
+        const auto max_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<unsigned> result;
+        for (unsigned n = 1; n < max_threads; n *= 2)
+            result.push_back(n);
+        result.push_back(max_threads);
+        return result;
+    }
+
+    size_t scaled(size_t iterations)
+    {
+        return std::max<size_t>(1, size_t(double(iterations) * scale_factor));
+    }
+
+    void set_scale(double scale)
+    {
+        scale_factor = scale;
+    }
+
+    void report(std::string_view label, double value, std::string_view unit)
+    {
+        std::cout << "    " << std::left << std::setw(48) << label
+                  << std::right << std::setw(14) << std::fixed
+                  << std::setprecision(1) << value << ' ' << unit << '\n';
+    }
+}
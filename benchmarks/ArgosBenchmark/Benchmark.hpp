@@ -0,0 +1,95 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace argos_bench
+{
+    using BenchmarkFunction = void (*)();
+
+    struct Benchmark
+    {
+        std::string name;
+        std::string description;
+        BenchmarkFunction function;
+    };
+
+    std::vector<Benchmark>& all_benchmarks();
+
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar(std::string name, std::string description,
+                           BenchmarkFunction function);
+    };
+
+    void keep_address(const void* ptr);
+
+    /**
+     * @brief Prevents the compiler from optimizing away the computation
+     *  of @a value.
+     */
+    template <typename T>
+    void keep(const T& value)
+    {
+        keep_address(&value);
+    }
+
+    /**
+     * @brief Returns the number of seconds it takes to call @a func
+     *  @a iterations times.
+     */
+    template <typename Func>
+    double measure(size_t iterations, Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            func(i);
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    /**
+     * @brief Starts @a thread_count threads that each call @a func
+     *  @a iterations times, and returns the number of seconds from all
+     *  threads started until the last one finished.
+     *
+     * @a func receives the thread index and the iteration number.
+     */
+    double measure_threads(unsigned thread_count, size_t iterations,
+                           const std::function<void(unsigned, size_t)>& func);
+
+    /**
+     * @brief Returns 1, 2, 4, ... up to and including the number of
+     *  hardware threads.
+     */
+    std::vector<unsigned> thread_counts();
+
+    /**
+     * @brief Returns the iteration count scaled by the --scale factor
+     *  given on the command line.
+     */
+    size_t scaled(size_t iterations);
+
+    void set_scale(double scale);
+
+    void report(std::string_view label, double value, std::string_view unit);
+}
+
+#define ARGOS_BENCHMARK_CONCAT2(a, b) a##b
+#define ARGOS_BENCHMARK_CONCAT(a, b) ARGOS_BENCHMARK_CONCAT2(a, b)
+
+#define ARGOS_BENCHMARK(name, description) \
+    static void name(); \
+    static ::argos_bench::BenchmarkRegistrar \
+        ARGOS_BENCHMARK_CONCAT(name, _registrar)(#name, description, name); \
+    static void name()
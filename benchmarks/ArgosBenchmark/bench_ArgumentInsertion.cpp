@@ -0,0 +1,74 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <climits>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    /**
+     * @brief Returns a parser where --profile=NAME expands to 300
+     *  arguments, among them --defaults, which expands to 50 more.
+     */
+    CompiledParser make_parser()
+    {
+        std::vector<std::string> profile;
+        for (int i = 0; i < 100; ++i)
+        {
+            profile.push_back("--set");
+            profile.push_back("key" + std::to_string(i) + "=value");
+            if (i % 10 == 0)
+                profile.emplace_back("--defaults");
+            else
+                profile.push_back("input" + std::to_string(i) + ".txt");
+        }
+        std::vector<std::string> defaults;
+        for (int i = 0; i < 25; ++i)
+        {
+            defaults.push_back("--set");
+            defaults.push_back("default" + std::to_string(i) + "=1");
+        }
+
+        return ArgumentParser("service")
+            .auto_exit(false)
+            .add(Arg("FILE").count(0, UINT_MAX))
+            .add(Opt("--set").argument("KEY=VALUE")
+                     .operation(OptionOperation::APPEND))
+            .add(Opt("--profile").argument("NAME").callback(
+                [profile](auto& oa) { oa.new_arguments = profile; }))
+            .add(Opt("--defaults").callback(
+                [defaults](auto& oa) { oa.new_arguments = defaults; }))
+            .compile();
+    }
+}
+
+ARGOS_BENCHMARK(argument_insertion,
+                "Time to parse 2000 arguments with 20 options whose"
+                " callbacks insert 300 arguments, including options whose"
+                " callbacks insert 50 more.")
+{
+    const auto parser = make_parser();
+    std::vector<std::string> args;
+    for (int i = 0; i < 2000; ++i)
+    {
+        if (i % 100 == 0)
+            args.emplace_back("--profile=prod");
+        else
+            args.push_back("file" + std::to_string(i) + ".txt");
+    }
+    const auto iterations = argos_bench::scaled(50);
+
+    const auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        argos_bench::keep(parser.parse(args).values("--set").size());
+    });
+    argos_bench::report("parse()", 1e3 * seconds / double(iterations),
+                        "ms/parse");
+}
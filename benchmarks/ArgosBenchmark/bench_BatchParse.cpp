@@ -0,0 +1,76 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    CompiledParser make_parser()
+    {
+        ArgumentParser parser("tool");
+        parser.auto_exit(false)
+            .add(Arg("INPUT").count(1, 10))
+            .add(Arg("OUTPUT"))
+            .add(Opt("-o", "--output-format").argument("FORMAT"))
+            .add(Opt("-j", "--jobs").argument("N"))
+            .add(Opt("-I", "--include").argument("DIR")
+                     .operation(OptionOperation::APPEND))
+            .add(Opt("-D", "--define").argument("NAME")
+                     .operation(OptionOperation::APPEND))
+            .add(Opt("-v", "--verbose"))
+            .add(Opt("--dry-run"));
+        return parser.compile();
+    }
+
+    /**
+     * @brief Makes command lines resembling a log of recorded
+     *  invocations, every tenth one is invalid.
+     */
+    std::vector<std::vector<std::string>> make_command_lines(size_t count)
+    {
+        std::vector<std::vector<std::string>> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::vector<std::string> args = {
+                "-j", std::to_string(i % 16), "-Iinclude", "-I", "src/" + std::to_string(i),
+                "--define=VERSION=" + std::to_string(i), "file" + std::to_string(i) + ".c",
+                "common.c", "out" + std::to_string(i)
+            };
+            if (i % 10 == 0)
+                args.emplace_back("--unknown");
+            if (i % 3 == 0)
+                args.emplace_back("-v");
+            result.push_back(std::move(args));
+        }
+        return result;
+    }
+}
+
+ARGOS_BENCHMARK(batch_parse,
+                "Command lines parsed per second by parse_batch, by thread"
+                " count.")
+{
+    const auto parser = make_parser();
+    const auto command_lines = make_command_lines(argos_bench::scaled(200000));
+    for (const auto thread_count : argos_bench::thread_counts())
+    {
+        size_t failures = 0;
+        const auto seconds = argos_bench::measure(1, [&](size_t)
+        {
+            for (const auto& result : parser.parse_batch(command_lines, thread_count))
+                failures += result.result_code == ParserResultCode::FAILURE;
+        });
+        argos_bench::keep(failures);
+        argos_bench::report(std::to_string(thread_count) + " threads",
+                            double(command_lines.size()) / seconds,
+                            "items/s");
+    }
+}
@@ -0,0 +1,89 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <random>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t CHOICE_COUNT = 10000;
+    constexpr size_t VALUE_COUNT = 1000;
+
+    std::vector<std::string> make_choices()
+    {
+        std::vector<std::string> result;
+        for (size_t i = 0; i < CHOICE_COUNT; ++i)
+            result.push_back("choice-" + std::to_string(i));
+        return result;
+    }
+
+    std::vector<std::string> make_values(const std::vector<std::string>& choices)
+    {
+        std::mt19937_64 rng(1);
+        std::vector<std::string> result;
+        for (size_t i = 0; i < VALUE_COUNT; ++i)
+            result.push_back(choices[rng() % choices.size()]);
+        return result;
+    }
+
+    template <typename Func>
+    void run(const char* label, const CompiledParser& compiled,
+             const std::vector<std::string>& values, Func func)
+    {
+        const std::vector<std::string_view> args(values.begin(), values.end());
+        const auto iterations = argos_bench::scaled(50);
+        const auto seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            const auto parsed = compiled.parse(args);
+            argos_bench::keep(func(parsed.values("VALUE")));
+        });
+        argos_bench::report(label,
+                            1e9 * seconds / double(iterations * values.size()),
+                            "ns/value");
+    }
+}
+
+ARGOS_BENCHMARK(choices,
+                "Time per value to parse 1000 values that must be among"
+                " 10000 choices, and get their positions.")
+{
+    const auto choices = make_choices();
+    const auto values = make_values(choices);
+
+    // What a program has to do without choices(): look up each value
+    // in the list after parsing.
+    const auto plain = ArgumentParser("tool")
+        .auto_exit(false)
+        .add(Argument("VALUE").count(0, VALUE_COUNT))
+        .compile();
+    run("Linear search", plain, values, [&](const ArgumentValues& v)
+    {
+        int sum = 0;
+        for (const auto& value : v.raw_values())
+        {
+            const auto it = std::find(choices.begin(), choices.end(), value);
+            sum += int(it - choices.begin());
+        }
+        return sum;
+    });
+
+    const auto with_choices = ArgumentParser("tool")
+        .auto_exit(false)
+        .add(Argument("VALUE").count(0, VALUE_COUNT).choices(choices))
+        .compile();
+    run("choices()", with_choices, values, [&](const ArgumentValues& v)
+    {
+        int sum = 0;
+        for (const auto index : v.as_choices())
+            sum += index;
+        return sum;
+    });
+}
@@ -0,0 +1,91 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <climits>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    ArgumentParser make_gateway_parser()
+    {
+        ArgumentParser parser("gateway");
+        parser.auto_exit(false)
+            .add(Opt("-v", "--verbose").help("Verbose output."))
+            .add(Opt("-q", "--quiet").help("Quiet output."))
+            .add(Opt("--config").argument("FILE").help("Configuration file."))
+            .add(Opt("--log-level").argument("LEVEL").help("Log level."));
+        for (int i = 0; i < 24; ++i)
+        {
+            parser.add(Opt("--flag-" + std::to_string(i))
+                .help("Generic flag number " + std::to_string(i) + "."));
+        }
+        for (const auto* name : {"get", "put", "delete", "list"})
+        {
+            Command cmd(name);
+            cmd.about(std::string("The ") + name + " command.")
+                .add(Arg("KEY").count(1, UINT_MAX).help("The keys."))
+                .add(Opt("-t", "--timeout").argument("MS").help("Timeout."))
+                .add(Opt("-r", "--retries").argument("N").help("Retries."))
+                .add(Opt("-f", "--force").help("Force."))
+                .add(Opt("--header").argument("NAME=VALUE")
+                    .operation(OptionOperation::APPEND).help("Header."));
+            parser.add(std::move(cmd));
+        }
+        return parser;
+    }
+
+    const std::vector<std::string_view> COMMAND_LINE = {
+        "--verbose", "--config", "gateway.conf", "--flag-7", "--flag-19",
+        "put", "-f", "--timeout", "250", "--header", "a=1",
+        "--header", "b=2", "key1", "key2", "key3"
+    };
+
+    void run_threads(const char* label, size_t iterations,
+                     const std::function<void()>& parse)
+    {
+        for (auto threads : argos_bench::thread_counts())
+        {
+            const auto seconds = argos_bench::measure_threads(
+                threads, iterations,
+                [&](unsigned, size_t) { parse(); });
+            argos_bench::report(std::string(label) + ", "
+                                + std::to_string(threads) + " thread(s)",
+                                double(threads * iterations) / seconds,
+                                "parses/s");
+        }
+    }
+}
+
+ARGOS_BENCHMARK(compiled_parser_threads,
+                "Parse throughput of ArgumentParser::parse() const,"
+                " CompiledParser::parse() and CompiledParser::parse_into()"
+                " versus number of threads.")
+{
+    const auto parser = make_gateway_parser();
+    const auto compiled = parser.compile();
+    const auto iterations = argos_bench::scaled(20000);
+
+    run_threads("ArgumentParser::parse() const", iterations / 4, [&]
+    {
+        argos_bench::keep(parser.parse(COMMAND_LINE));
+    });
+
+    run_threads("CompiledParser::parse()", iterations, [&]
+    {
+        argos_bench::keep(compiled.parse(COMMAND_LINE));
+    });
+
+    run_threads("CompiledParser::parse_into()", iterations, [&]
+    {
+        thread_local ParsedArguments args;
+        compiled.parse_into(args, COMMAND_LINE);
+        argos_bench::keep(args.result_code());
+    });
+}
@@ -0,0 +1,80 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t OPTION_COUNT = 3000;
+
+    std::string flag(size_t i)
+    {
+        return "--option-" + std::to_string(i);
+    }
+}
+
+ARGOS_BENCHMARK(mandatory_options,
+                "Time to parse a command line with one option in a command"
+                " with 3000 options where 1000 are mandatory.")
+{
+    // The mandatory options have initial values so that they don't
+    // have to be given.
+    ArgumentParser parser("tool");
+    parser.auto_exit(false);
+    for (size_t i = 0; i < OPTION_COUNT; ++i)
+    {
+        auto opt = Opt(flag(i)).argument("N");
+        if (i % 3 == 0)
+            opt.initial_value("0").mandatory();
+        parser.add(std::move(opt));
+    }
+    const auto compiled = parser.compile();
+    const std::vector<std::string_view> args{"--option-17", "1"};
+    const auto iterations = argos_bench::scaled(2000);
+
+    const auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        const auto parsed = compiled.parse(args);
+        argos_bench::keep(parsed.result_code());
+    });
+    argos_bench::report("parse()", 1e6 * seconds / double(iterations),
+                        "us/parse");
+}
+
+ARGOS_BENCHMARK(constraints,
+                "Time to check 1000 mutually exclusive pairs, 500"
+                " dependencies and 500 conflicts among 3000 options.")
+{
+    ArgumentParser parser("tool");
+    parser.auto_exit(false);
+    for (size_t i = 0; i < OPTION_COUNT; ++i)
+        parser.add(Opt(flag(i)));
+    for (size_t i = 0; i < 1000; ++i)
+        parser.mutually_exclusive({flag(3 * i), flag(3 * i + 1)});
+    for (size_t i = 0; i < 500; ++i)
+    {
+        parser.depends_on(flag(6 * i + 2), {flag(6 * i)});
+        parser.conflicts_with(flag(6 * i + 5), {flag(6 * i + 3)});
+    }
+    const auto compiled = parser.compile();
+    std::vector<std::string> flags;
+    for (size_t i = 0; i < 100; ++i)
+        flags.push_back(flag(30 * i));
+    const std::vector<std::string_view> args(flags.begin(), flags.end());
+    const auto iterations = argos_bench::scaled(200);
+
+    const auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        const auto parsed = compiled.parse(args);
+        argos_bench::keep(parsed.result_code());
+    });
+    argos_bench::report("parse()", 1e6 * seconds / double(iterations),
+                        "us/parse");
+}
@@ -0,0 +1,86 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <map>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t PAIR_COUNT = 5000;
+
+    std::vector<std::string> make_args()
+    {
+        std::vector<std::string> result;
+        for (size_t i = 0; i < PAIR_COUNT; ++i)
+        {
+            result.emplace_back("-D");
+            // Every tenth definition overrides an earlier one.
+            const auto key = i % 10 == 9 ? i / 2 : i;
+            result.push_back("NAME_" + std::to_string(key) + "="
+                             + std::to_string(i));
+        }
+        return result;
+    }
+
+    template <typename Func>
+    void run(const char* label, const CompiledParser& compiled,
+             const std::vector<std::string_view>& args, Func func)
+    {
+        const auto iterations = argos_bench::scaled(50);
+        const auto seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            const auto parsed = compiled.parse(args);
+            argos_bench::keep(func(parsed));
+        });
+        argos_bench::report(label, 1e6 * seconds / double(iterations),
+                            "us/parse");
+    }
+}
+
+ARGOS_BENCHMARK(dictionary,
+                "Time to parse 5000 -D NAME=VALUE options and look up"
+                " every 10th name.")
+{
+    const auto strings = make_args();
+    const std::vector<std::string_view> args(strings.begin(), strings.end());
+
+    // What a program has to do without dictionary().
+    const auto plain = ArgumentParser("tool")
+        .auto_exit(false)
+        .add(Opt("-D").argument("NAME=VALUE")
+                 .operation(OptionOperation::APPEND))
+        .compile();
+    run("split() + std::map", plain, args, [](const ParsedArguments& p)
+    {
+        std::map<std::string, std::string> map;
+        for (const auto& value : p.values("-D"))
+        {
+            const auto parts = value.split_n('=', 2).as_strings();
+            map[parts[0]] = parts[1];
+        }
+        size_t size = 0;
+        for (size_t i = 0; i < PAIR_COUNT; i += 10)
+            size += map["NAME_" + std::to_string(i)].size();
+        return size;
+    });
+
+    const auto with_dictionary = ArgumentParser("tool")
+        .auto_exit(false)
+        .add(Opt("-D").argument("NAME=VALUE").dictionary())
+        .compile();
+    run("dictionary()", with_dictionary, args, [](const ParsedArguments& p)
+    {
+        const auto dict = p.dictionary("-D");
+        size_t size = 0;
+        for (size_t i = 0; i < PAIR_COUNT; i += 10)
+            size += dict.lookup("NAME_" + std::to_string(i)).value_or("").size();
+        return size;
+    });
+}
@@ -0,0 +1,45 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t OPTION_COUNT = 300;
+}
+
+ARGOS_BENCHMARK(initial_values,
+                "Time to parse a command line with one option in a command"
+                " with 300 options that have initial values.")
+{
+    ArgumentParser parser("service");
+    parser.auto_exit(false);
+    for (size_t i = 0; i < OPTION_COUNT; ++i)
+    {
+        const auto n = std::to_string(i);
+        parser.add(Opt("--setting-" + n).argument("VALUE")
+                       .initial_value("default value of setting number " + n));
+    }
+    std::string path;
+    for (size_t i = 0; i < 100; ++i)
+        path += "/opt/packages/package-" + std::to_string(i) + "/bin:";
+    parser.add(Opt("--path").argument("DIRS").initial_value(path));
+    const auto compiled = parser.compile();
+    const std::vector<std::string_view> args{"--setting-17", "x"};
+    const auto iterations = argos_bench::scaled(20000);
+
+    const auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        const auto parsed = compiled.parse(args);
+        argos_bench::keep(parsed.value("--path").as_string().size());
+    });
+    argos_bench::report("parse()", 1e6 * seconds / double(iterations),
+                        "us/parse");
+}
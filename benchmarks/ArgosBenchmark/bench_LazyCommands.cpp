@@ -0,0 +1,73 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <climits>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr int COMMAND_COUNT = 1000;
+
+    void define_command(Command& cmd, int index)
+    {
+        const auto suffix = std::to_string(index);
+        cmd.add(Arg("INPUT").count(1, UINT_MAX)
+                .help("The input files for command " + suffix + "."))
+            .add(Arg("OUTPUT").help("The output file."));
+        for (int i = 0; i < 10; ++i)
+        {
+            const auto n = std::to_string(i);
+            cmd.add(Opt("--option-" + n).argument("VALUE")
+                .help("Option number " + n + " of command " + suffix
+                      + ". It has a help text that is long enough to be"
+                        " representative of a real program."));
+        }
+        cmd.add(Opt("-v", "--verbose").help("Verbose output."));
+    }
+
+    ArgumentParser make_parser(bool lazy)
+    {
+        ArgumentParser parser("multitool");
+        parser.auto_exit(false);
+        for (int i = 0; i < COMMAND_COUNT; ++i)
+        {
+            Command cmd("command" + std::to_string(i));
+            cmd.help("Summary of command " + std::to_string(i) + ".");
+            if (lazy)
+                cmd.lazy_definition([i](Command& c) { define_command(c, i); });
+            else
+                define_command(cmd, i);
+            parser.add(std::move(cmd));
+        }
+        return parser;
+    }
+
+    const std::vector<std::string_view> COMMAND_LINE = {
+        "command500", "--option-3", "x", "-v", "in1", "in2", "out"
+    };
+}
+
+ARGOS_BENCHMARK(lazy_commands,
+                "Time from start-up to parsed arguments for a program with"
+                " 1000 sub-commands, with and without lazy definitions.")
+{
+    const auto iterations = argos_bench::scaled(20);
+    for (const bool lazy : {false, true})
+    {
+        const auto seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            const auto parser = make_parser(lazy).compile();
+            argos_bench::keep(parser.parse(COMMAND_LINE));
+        });
+        argos_bench::report(lazy ? "Lazy definitions" : "Eager definitions",
+                            1000 * seconds / double(iterations),
+                            "ms/start-up");
+    }
+}
@@ -0,0 +1,168 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <Argos/Argos.hpp>
+#include "Argos/OptionData.hpp"
+#include "Argos/OptionTrie.hpp"
+#include "Argos/StringUtilities.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    using FlagIndex = std::vector<std::pair<std::string_view, const OptionData*>>;
+
+    /**
+     * @brief The sorted vector and binary search that OptionTrie
+     *  replaced, kept here as the baseline.
+     */
+    class BinarySearchIndex
+    {
+    public:
+        BinarySearchIndex(FlagIndex index, bool case_insensitive)
+            : m_index(std::move(index)),
+              m_case_insensitive(case_insensitive)
+        {
+            std::sort(m_index.begin(), m_index.end(),
+                      [&](const auto& a, const auto& b)
+                      {
+                          return is_less(a.first, b.first, m_case_insensitive);
+                      });
+        }
+
+        const OptionData* find(std::string_view flag,
+                               bool allow_abbreviations) const
+        {
+            auto opt = find_impl(flag, allow_abbreviations);
+            if (opt == nullptr && flag.size() > 2 && flag.back() == '=')
+            {
+                opt = find_impl(flag.substr(0, flag.size() - 1),
+                                allow_abbreviations);
+                if (opt && opt->argument.empty())
+                    opt = nullptr;
+            }
+            return opt;
+        }
+    private:
+        const OptionData* find_impl(std::string_view flag,
+                                    bool allow_abbreviations) const
+        {
+            const auto it = std::lower_bound(
+                m_index.begin(), m_index.end(), std::pair(flag, nullptr),
+                [&](auto& a, auto& b)
+                {
+                    return is_less(a.first, b.first, m_case_insensitive);
+                });
+            if (it == m_index.end())
+                return nullptr;
+            if (it->first == flag)
+                return it->second;
+            if (m_case_insensitive && are_equal_ci(it->first, flag))
+                return it->second;
+            if (!allow_abbreviations
+                || !starts_with(it->first, flag, m_case_insensitive))
+            {
+                return nullptr;
+            }
+            const auto nxt = next(it);
+            if (nxt != m_index.end()
+                && starts_with(nxt->first, flag, m_case_insensitive))
+            {
+                return nullptr;
+            }
+            return it->second;
+        }
+
+        FlagIndex m_index;
+        bool m_case_insensitive;
+    };
+
+    /**
+     * @brief Makes @a count options with flags like the ones generated
+     *  from a plugin registry.
+     */
+    std::vector<std::unique_ptr<OptionData>> make_options(size_t count)
+    {
+        const char* plugins[] = {"cache", "compiler", "database", "http",
+                                 "logging", "network", "render", "storage"};
+        std::vector<std::unique_ptr<OptionData>> result;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto option = Opt("--" + std::string(plugins[i % 8])
+                              + "-setting-" + std::to_string(i / 8));
+            if (i % 3 == 0)
+                option.argument("VALUE");
+            result.push_back(option.release());
+        }
+        return result;
+    }
+
+    std::vector<std::string> make_lookups(const FlagIndex& flags,
+                                          bool case_insensitive)
+    {
+        std::vector<std::string> result;
+        for (size_t i = 0; i < flags.size(); i += 7)
+        {
+            std::string flag(flags[i].first);
+            if (case_insensitive)
+                std::transform(flag.begin(), flag.end(), flag.begin(), ::toupper);
+            if (flags[i].second->argument.empty())
+                result.push_back(flag);
+            else
+                result.push_back(flag + "=");
+        }
+        return result;
+    }
+
+    template <typename Index>
+    void run_lookups(const char* label, const Index& index,
+                     const std::vector<std::string>& lookups,
+                     bool allow_abbreviations)
+    {
+        const auto iterations = argos_bench::scaled(200);
+        size_t found = 0;
+        const auto seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            for (const auto& flag : lookups)
+                found += index.find(flag, allow_abbreviations) != nullptr;
+        });
+        argos_bench::keep(found);
+        argos_bench::report(label,
+                            double(iterations * lookups.size()) / seconds,
+                            "lookups/s");
+    }
+}
+
+ARGOS_BENCHMARK(option_lookup,
+                "Flag lookups in a command with 5000 options with"
+                " OptionTrie versus binary search.")
+{
+    const auto options = make_options(5000);
+    FlagIndex flags;
+    for (const auto& option : options)
+        flags.emplace_back(option->flags.front(), option.get());
+
+    for (const bool case_insensitive : {false, true})
+    {
+        const BinarySearchIndex binary_search(flags, case_insensitive);
+        const OptionTrie trie(flags, case_insensitive);
+        const auto lookups = make_lookups(flags, case_insensitive);
+        const std::string suffix = case_insensitive
+                                   ? ", case-insensitive"
+                                   : ", case-sensitive";
+        for (const bool abbreviations : {false, true})
+        {
+            const auto full_suffix = suffix + (abbreviations ? ", abbreviations" : "");
+            run_lookups(("Binary search" + full_suffix).c_str(),
+                        binary_search, lookups, abbreviations);
+            run_lookups(("OptionTrie" + full_suffix).c_str(),
+                        trie, lookups, abbreviations);
+        }
+    }
+}
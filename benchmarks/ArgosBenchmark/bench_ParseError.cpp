@@ -0,0 +1,113 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <ostream>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    /// Discards the text, but not the work of formatting it.
+    struct NullBuffer : std::streambuf
+    {
+        int overflow(int c) override
+        {
+            return c;
+        }
+    };
+
+    CompiledParser make_parser(std::ostream& stream)
+    {
+        ArgumentParser parser("gateway");
+        parser.auto_exit(false)
+            .stream(&stream)
+            .about("Forwards a request to one of the back-end services.")
+            .add(Arg("SERVICE").help("The name of the service."))
+            .add(Arg("PATH").help("The path of the request."));
+        for (int i = 0; i < 20; ++i)
+        {
+            const auto n = std::to_string(i);
+            parser.add(Opt("--option-" + n).argument("VALUE")
+                           .help("Sets parameter " + n + " of the request."));
+        }
+        parser.add(Opt("--timeout").argument("MS").value_type(ValueType::INT)
+                       .help("The number of milliseconds to wait for a reply."))
+            .add(Opt("--token").argument("TOKEN")
+                     .help("The client's access token.")
+                     .callback([](OptionCallbackArguments& a)
+                     {
+                         if (a.value.size() != 8)
+                             a.builder.error("Invalid token.", a.view);
+                     }));
+        return parser.compile();
+    }
+
+    template <typename Func>
+    void run(const char* label, Func func)
+    {
+        const auto iterations = argos_bench::scaled(20000);
+        const auto seconds = argos_bench::measure(iterations, func);
+        argos_bench::report(label, 1e9 * seconds / double(iterations),
+                            "ns/parse");
+    }
+}
+
+ARGOS_BENCHMARK(parse_error,
+                "Time to parse a valid and two malformed requests with"
+                " parse() and try_parse().")
+{
+    NullBuffer buffer;
+    std::ostream stream(&buffer);
+    const auto parser = make_parser(stream);
+    const std::vector<std::string_view> valid = {
+        "--timeout", "500", "--token", "12345678", "users", "/list"
+    };
+    const std::vector<std::string_view> invalid_value = {
+        "--timeout", "soon", "--token", "12345678", "users", "/list"
+    };
+    const std::vector<std::string_view> invalid_token = {
+        "--timeout", "500", "--token", "1234", "users", "/list"
+    };
+
+    run("parse(), valid", [&](size_t)
+    {
+        argos_bench::keep(parser.parse(valid).result_code());
+    });
+    run("try_parse(), valid", [&](size_t)
+    {
+        argos_bench::keep(parser.try_parse(valid).has_value());
+    });
+    run("parse(), invalid value", [&](size_t)
+    {
+        argos_bench::keep(parser.parse(invalid_value).result_code());
+    });
+    run("try_parse(), invalid value", [&](size_t)
+    {
+        argos_bench::keep(parser.try_parse(invalid_value).error().code());
+    });
+    run("try_parse() + message(), invalid value", [&](size_t)
+    {
+        argos_bench::keep(parser.try_parse(invalid_value).error().message());
+    });
+    run("parse(), error from callback", [&](size_t)
+    {
+        try
+        {
+            argos_bench::keep(parser.parse(invalid_token).result_code());
+        }
+        catch (const ArgosException& ex)
+        {
+            argos_bench::keep(ex);
+        }
+    });
+    run("try_parse(), error from callback", [&](size_t)
+    {
+        argos_bench::keep(parser.try_parse(invalid_token).error().code());
+    });
+}
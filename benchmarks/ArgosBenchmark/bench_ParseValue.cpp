@@ -0,0 +1,174 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <random>
+#include <Argos/Argos.hpp>
+#include "Argos/ParseValue.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    /// The strtol-based implementation that parse_integer replaced.
+    std::optional<long> parse_with_strtol(const std::string& str, int base)
+    {
+        if (str.empty())
+            return {};
+        char* endp = nullptr;
+        errno = 0;
+        auto value = strtol(str.c_str(), &endp, base);
+        if (endp == str.c_str() + str.size() && errno == 0)
+            return value;
+        return {};
+    }
+
+    std::optional<double> parse_with_strtod(const std::string& str)
+    {
+        if (str.empty())
+            return {};
+        char* endp = nullptr;
+        errno = 0;
+        auto value = strtod(str.c_str(), &endp);
+        if (endp == str.c_str() + str.size() && errno == 0)
+            return value;
+        return {};
+    }
+
+    std::vector<std::string> make_integers(size_t count)
+    {
+        std::mt19937_64 rng(1);
+        std::vector<std::string> result;
+        for (size_t i = 0; i < count; ++i)
+            result.push_back(std::to_string(long(rng() >> (i % 40))));
+        return result;
+    }
+
+    std::vector<std::string> make_doubles(size_t count)
+    {
+        std::mt19937_64 rng(1);
+        std::uniform_real_distribution<double> dist(0, 1);
+        std::vector<std::string> result;
+        for (size_t i = 0; i < count; ++i)
+            result.push_back(std::to_string(dist(rng)));
+        return result;
+    }
+
+    template <typename Func>
+    void run(const char* label, const std::vector<std::string>& values,
+             Func func)
+    {
+        const auto iterations = argos_bench::scaled(20);
+        const auto seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            for (const auto& v : values)
+                argos_bench::keep(func(std::string_view(v)));
+        });
+        argos_bench::report(label,
+                            1e9 * seconds / double(iterations * values.size()),
+                            "ns/value");
+    }
+}
+
+ARGOS_BENCHMARK(parse_value,
+                "Time to convert a value to a number with strtol and strtod"
+                " on a std::string copy, std::from_chars and parse_integer"
+                " and parse_floating_point.")
+{
+    const auto integers = make_integers(100000);
+    run("strtol", integers, [](std::string_view s)
+    {
+        return parse_with_strtol(std::string(s), 10);
+    });
+    run("from_chars, long", integers, [](std::string_view s)
+    {
+        long value = 0;
+        std::from_chars(s.data(), s.data() + s.size(), value);
+        return value;
+    });
+    run("parse_integer<long>", integers, [](std::string_view s)
+    {
+        return parse_integer<long>(s, 10);
+    });
+
+    const auto doubles = make_doubles(100000);
+    run("strtod", doubles, [](std::string_view s)
+    {
+        return parse_with_strtod(std::string(s));
+    });
+    run("parse_floating_point<double>", doubles, [](std::string_view s)
+    {
+        return parse_floating_point<double>(s);
+    });
+
+    // The path through ArgumentValues::as_doubles(), as for
+    // "--weights 0.1,0.2,...".
+    std::string joined;
+    for (const auto& d : doubles)
+        joined += d + ",";
+    joined.pop_back();
+    ArgumentParser parser("tool");
+    parser.auto_exit(false).add(Opt("--weights").argument("W,..."));
+    const auto compiled = parser.compile();
+    const std::vector<std::string_view> args = {"--weights", joined};
+    const auto parsed = compiled.parse(args);
+    const auto iterations = argos_bench::scaled(20);
+    const auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        argos_bench::keep(parsed.value("--weights").split(',').as_doubles());
+    });
+    argos_bench::report("split(',').as_doubles()",
+                        1e9 * seconds / double(iterations * doubles.size()),
+                        "ns/value");
+}
+
+ARGOS_BENCHMARK(typed_values,
+                "Time to read integer values repeatedly, with and without"
+                " a value type that converts them while parsing.")
+{
+    const auto integers = make_integers(1000);
+    std::vector<std::string_view> args;
+    for (const auto& n : integers)
+    {
+        args.push_back("-n");
+        args.push_back(n);
+    }
+
+    for (const auto type : {ValueType::STRING, ValueType::LONG})
+    {
+        ArgumentParser parser("tool");
+        parser.auto_exit(false)
+            .add(Opt("-n").argument("N").value_type(type)
+                     .operation(OptionOperation::APPEND));
+        const auto compiled = parser.compile();
+        const auto label = type == ValueType::STRING ? "STRING" : "LONG";
+
+        const auto iterations = argos_bench::scaled(200);
+        const auto parse_seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            argos_bench::keep(compiled.parse(args).result_code());
+        });
+        argos_bench::report(std::string("parse, ") + label,
+                            1e9 * parse_seconds
+                                / double(iterations * integers.size()),
+                            "ns/value");
+
+        const auto parsed = compiled.parse(args);
+        const auto values = parsed.values("-n");
+        const auto read_seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            argos_bench::keep(values.as_longs());
+        });
+        argos_bench::report(std::string("as_longs(), ") + label,
+                            1e9 * read_seconds
+                                / double(iterations * integers.size()),
+                            "ns/value");
+    }
+}
@@ -0,0 +1,105 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <Argos/Argos.hpp>
+#include "Argos/ResponseFiles.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    /// Writes a response file with compiler-style arguments, returns
+    /// the number of arguments.
+    size_t write_response_file(const std::string& path, size_t size)
+    {
+        std::ofstream file(path, std::ios::binary);
+        size_t written = 0, count = 0;
+        std::string line;
+        for (size_t i = 0; written < size; ++i)
+        {
+            const auto n = std::to_string(i);
+            if (i % 2 == 0)
+                line = "-I \"/usr/include/project/module " + n + "\"\n";
+            else
+                line = "src/module_" + n + "/file_" + n + ".cpp\n";
+            file << line;
+            written += line.size();
+            count += i % 2 == 0 ? 2 : 1;
+        }
+        return count;
+    }
+
+    /// What client code had to do without response file support: read
+    /// the file and split it into strings.
+    std::vector<std::string> read_arguments(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        auto text = ss.str();
+        std::vector<std::string> result;
+        ResponseFileTokenizer tokenizer(text);
+        std::string_view token;
+        while (tokenizer.next(token))
+            result.emplace_back(token);
+        return result;
+    }
+}
+
+ARGOS_BENCHMARK(response_files,
+                "Time to expand and parse a 100 MB response file, versus"
+                " reading it into strings.")
+{
+    const auto size = argos_bench::scaled(100) << 20;
+    const auto path = (std::filesystem::temp_directory_path()
+                       / "argos_bench_args.rsp").string();
+    const auto count = write_response_file(path, size);
+    const auto arg = "@" + path;
+    const std::vector<std::string_view> args = {arg};
+    constexpr size_t ITERATIONS = 3;
+
+    const auto read_seconds = argos_bench::measure(ITERATIONS, [&](size_t)
+    {
+        argos_bench::keep(read_arguments(path));
+    });
+    argos_bench::report("Read into std::vector<std::string>",
+                        1e3 * read_seconds / ITERATIONS, "ms");
+
+    const auto expand_seconds = argos_bench::measure(ITERATIONS, [&](size_t)
+    {
+        ResponseFiles files;
+        files.expand(ArgumentSource(args));
+        if (files.arguments().size() != count)
+            throw std::runtime_error("Incorrect number of arguments.");
+    });
+    argos_bench::report("ResponseFiles::expand()",
+                        1e3 * expand_seconds / ITERATIONS, "ms");
+    argos_bench::report("ResponseFiles::expand()",
+                        double(size >> 20) * ITERATIONS / expand_seconds,
+                        "MB/s");
+
+    ArgumentParser parser("cc");
+    parser.auto_exit(false)
+        .allow_response_files(true)
+        .add(Opt("-I").argument("DIR").operation(OptionOperation::APPEND))
+        .add(Arg("SOURCE").count(0, UINT_MAX));
+    const auto compiled = parser.compile();
+    const auto parse_seconds = argos_bench::measure(ITERATIONS, [&](size_t)
+    {
+        argos_bench::keep(compiled.parse(args));
+    });
+    argos_bench::report("CompiledParser::parse() with @file",
+                        1e3 * parse_seconds / ITERATIONS, "ms");
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
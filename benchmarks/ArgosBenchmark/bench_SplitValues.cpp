@@ -0,0 +1,95 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <random>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t VALUE_COUNT = 1000000;
+
+    std::string make_ints()
+    {
+        std::mt19937 rng(1);
+        std::string result;
+        for (size_t i = 0; i < VALUE_COUNT; ++i)
+        {
+            if (i != 0)
+                result += ',';
+            result += std::to_string(int(rng() % 2000000) - 1000000);
+        }
+        return result;
+    }
+
+    std::string make_doubles()
+    {
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<double> dist(0, 1);
+        std::string result;
+        for (size_t i = 0; i < VALUE_COUNT; ++i)
+        {
+            if (i != 0)
+                result += ',';
+            result += std::to_string(dist(rng));
+        }
+        return result;
+    }
+
+    template <typename Func>
+    void run(const std::string& label, const ArgumentValue& value, Func func)
+    {
+        const auto iterations = argos_bench::scaled(5);
+        const auto seconds = argos_bench::measure(iterations, [&](size_t)
+        {
+            argos_bench::keep(func(value).size());
+        });
+        argos_bench::report(label,
+                            1e9 * seconds / double(iterations * VALUE_COUNT),
+                            "ns/value");
+    }
+
+    template <typename T, typename Func>
+    void run_all(const char* type, const std::string& text, Func as_vector)
+    {
+        const auto args = ArgumentParser("tool")
+            .auto_exit(false)
+            .add(Opt("-v").argument("V,..."))
+            .parse({"-v", text});
+        const auto value = args.value("-v");
+        const auto prefix = std::string(type) + ": ";
+
+        run(prefix + "split()", value, [&](const ArgumentValue& v)
+        {
+            return as_vector(v.split(','));
+        });
+        run(prefix + "split_as(1 thread)", value, [](const ArgumentValue& v)
+        {
+            return v.split_as<T>(',');
+        });
+        run(prefix + "split_as(4 threads)", value, [](const ArgumentValue& v)
+        {
+            return v.split_as<T>(',', 4);
+        });
+    }
+}
+
+ARGOS_BENCHMARK(split_values,
+                "Time per number to split and convert a value with one"
+                " million comma-separated numbers.")
+{
+    run_all<int>("int", make_ints(), [](const ArgumentValues& v)
+    {
+        return v.as_ints();
+    });
+    run_all<double>("double", make_doubles(), [](const ArgumentValues& v)
+    {
+        return v.as_doubles();
+    });
+}
@@ -0,0 +1,91 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    struct Config
+    {
+        int threads = 1;
+        long port = 0;
+        double ratio = 0;
+        bool verbose = false;
+        std::string host;
+        std::vector<double> weights;
+    };
+
+    const std::vector<std::string_view> COMMAND_LINE = {
+        "--threads", "8", "--port", "8080", "--ratio", "0.75", "-v",
+        "--host", "example.com", "-w", "0.1", "-w", "0.2", "-w", "0.3",
+        "-w", "0.4"
+    };
+
+    ArgumentParser make_parser(Config* cfg)
+    {
+        Option opts[] = {
+            Opt("--threads").argument("N"),
+            Opt("--port").argument("PORT"),
+            Opt("--ratio").argument("R"),
+            Opt("-v"),
+            Opt("--host").argument("HOST"),
+            Opt("-w").argument("W").operation(OptionOperation::APPEND)
+        };
+        if (cfg)
+        {
+            opts[0].bind(cfg->threads);
+            opts[1].bind(cfg->port);
+            opts[2].bind(cfg->ratio);
+            opts[3].bind(cfg->verbose);
+            opts[4].bind(cfg->host);
+            opts[5].bind(cfg->weights);
+        }
+        ArgumentParser parser("server");
+        parser.auto_exit(false);
+        for (auto& opt : opts)
+            parser.add(std::move(opt));
+        return parser;
+    }
+}
+
+ARGOS_BENCHMARK(value_binding,
+                "Time to parse a command line and fill a configuration"
+                " struct, by reading the values by name after parsing"
+                " and by binding the options to the struct's members.")
+{
+    const auto iterations = argos_bench::scaled(100000);
+
+    const auto by_name = make_parser(nullptr).compile();
+    auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        const auto args = by_name.parse(COMMAND_LINE);
+        Config cfg;
+        cfg.threads = args.value("--threads").as_int(1);
+        cfg.port = args.value("--port").as_long();
+        cfg.ratio = args.value("--ratio").as_double();
+        cfg.verbose = args.value("-v").as_bool();
+        cfg.host = args.value("--host").as_string();
+        cfg.weights = args.values("-w").as_doubles();
+        argos_bench::keep(cfg.weights.size());
+    });
+    argos_bench::report("parse and value(name)",
+                        1e9 * seconds / double(iterations), "ns/parse");
+
+    Config cfg;
+    const auto bound = make_parser(&cfg).compile();
+    seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        cfg.weights.clear();
+        argos_bench::keep(bound.parse(COMMAND_LINE).result_code());
+        argos_bench::keep(cfg.weights.size());
+    });
+    argos_bench::report("parse with bind()",
+                        1e9 * seconds / double(iterations), "ns/parse");
+}
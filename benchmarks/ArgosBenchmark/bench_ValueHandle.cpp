@@ -0,0 +1,75 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t OPTION_COUNT = 64;
+}
+
+ARGOS_BENCHMARK(value_handle,
+                "Time to look up a value by name and with a ValueHandle"
+                " in a command with 64 options.")
+{
+    ArgumentParser parser("tool");
+    parser.auto_exit(false);
+    std::vector<std::string> names;
+    std::vector<ValueHandle> handles(OPTION_COUNT);
+    for (size_t i = 0; i < OPTION_COUNT; ++i)
+    {
+        names.push_back("--option-" + std::to_string(i));
+        parser.add(Opt(names.back()).argument("N"), handles[i]);
+    }
+    std::vector<std::string_view> args;
+    for (size_t i = 0; i < OPTION_COUNT; i += 2)
+    {
+        args.push_back(names[i]);
+        args.push_back("42");
+    }
+    const auto parsed = parser.compile().parse(args);
+    const auto iterations = argos_bench::scaled(20000);
+
+    auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        for (const auto& name : names)
+            argos_bench::keep(parsed.has(name));
+    });
+    argos_bench::report("has(name)",
+                        1e9 * seconds / double(iterations * OPTION_COUNT),
+                        "ns/lookup");
+
+    seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        for (const auto& handle : handles)
+            argos_bench::keep(parsed.has(handle));
+    });
+    argos_bench::report("has(handle)",
+                        1e9 * seconds / double(iterations * OPTION_COUNT),
+                        "ns/lookup");
+
+    seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        for (size_t i = 0; i < OPTION_COUNT; i += 2)
+            argos_bench::keep(parsed.value(names[i]).as_int());
+    });
+    argos_bench::report("value(name).as_int()",
+                        2e9 * seconds / double(iterations * OPTION_COUNT),
+                        "ns/lookup");
+
+    seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        for (size_t i = 0; i < OPTION_COUNT; i += 2)
+            argos_bench::keep(parsed.value(handles[i]).as_int());
+    });
+    argos_bench::report("value(handle).as_int()",
+                        2e9 * seconds / double(iterations * OPTION_COUNT),
+                        "ns/lookup");
+}
@@ -0,0 +1,41 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t OPTION_COUNT = 5000;
+}
+
+ARGOS_BENCHMARK(value_index,
+                "Time to parse a command line with two options in a command"
+                " with 5000 options.")
+{
+    ArgumentParser parser("tool");
+    parser.auto_exit(false);
+    for (size_t i = 0; i < OPTION_COUNT; ++i)
+    {
+        const auto n = std::to_string(i);
+        parser.add(Opt("--option-" + n, "--alt-" + n).argument("N"));
+    }
+    const auto compiled = parser.compile();
+    const std::vector<std::string_view> args{"--option-17", "1",
+                                             "--option-4711", "2"};
+    const auto iterations = argos_bench::scaled(2000);
+
+    const auto seconds = argos_bench::measure(iterations, [&](size_t)
+    {
+        const auto parsed = compiled.parse(args);
+        argos_bench::keep(parsed.value("--option-4711").as_int());
+    });
+    argos_bench::report("parse()", 1e6 * seconds / double(iterations),
+                        "us/parse");
+}
@@ -0,0 +1,66 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    constexpr size_t VALUE_COUNT = 1000;
+
+    void run_threads(const char* label, size_t iterations,
+                     const std::function<long()>& sum_values)
+    {
+        for (auto threads : argos_bench::thread_counts())
+        {
+            const auto seconds = argos_bench::measure_threads(
+                threads, iterations,
+                [&](unsigned, size_t) { argos_bench::keep(sum_values()); });
+            argos_bench::report(std::string(label) + ", "
+                                + std::to_string(threads) + " thread(s)",
+                                1e9 * seconds / double(iterations * VALUE_COUNT),
+                                "ns/value");
+        }
+    }
+}
+
+ARGOS_BENCHMARK(values_view,
+                "Time per value to iterate over 1000 typed values with"
+                " ArgumentValues and ValuesView, with threads sharing one"
+                " ParsedArguments.")
+{
+    std::vector<std::string> args;
+    for (size_t i = 0; i < VALUE_COUNT; ++i)
+    {
+        args.emplace_back("-n");
+        args.push_back(std::to_string(i));
+    }
+    const auto parsed = ArgumentParser("tool")
+        .auto_exit(false)
+        .add(Opt("-n").argument("N").operation(OptionOperation::APPEND)
+                 .value_type(ValueType::LONG))
+        .parse(args);
+    const auto iterations = argos_bench::scaled(2000);
+
+    run_threads("ArgumentValues", iterations, [&]
+    {
+        long sum = 0;
+        for (const auto value : parsed.values("-n"))
+            sum += value.as_long();
+        return sum;
+    });
+
+    run_threads("ValuesView", iterations, [&]
+    {
+        long sum = 0;
+        for (const auto n : parsed.values_view("-n").view_as<long>())
+            sum += n;
+        return sum;
+    });
+}
@@ -0,0 +1,59 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <Argos/Argos.hpp>
+#include "Benchmark.hpp"
+
+int main(int argc, char* argv[])
+{
+    using namespace argos;
+    const auto args = ArgumentParser(argv[0])
+        .about("Runs the Argos benchmarks.")
+        .add(Arg("NAME").count(0, UINT_MAX)
+            .help("The names of the benchmarks to run. All benchmarks are"
+                  " run if no names are given."))
+        .add(Opt("-l", "--list")
+            .help("List the available benchmarks."))
+        .add(Opt("-s", "--scale").argument("FACTOR")
+            .help("Multiply the iteration counts with FACTOR."))
+        .parse(argc, argv);
+
+    auto& benchmarks = argos_bench::all_benchmarks();
+    if (args.value("--list").as_bool())
+    {
+        for (const auto& bm : benchmarks)
+            std::cout << bm.name << "\n    " << bm.description << '\n';
+        return 0;
+    }
+
+    argos_bench::set_scale(args.value("--scale").as_double(1.0));
+
+    const auto names = args.values("NAME").as_strings();
+    for (const auto& name : names)
+    {
+        if (std::none_of(benchmarks.begin(), benchmarks.end(),
+                         [&](auto& bm) { return bm.name == name; }))
+        {
+            args.value("NAME").error("unknown benchmark: " + name);
+        }
+    }
+
+    for (const auto& bm : benchmarks)
+    {
+        if (!names.empty()
+            && std::find(names.begin(), names.end(), bm.name) == names.end())
+        {
+            continue;
+        }
+        std::cout << bm.name << ": " << bm.description << '\n';
+        bm.function();
+    }
+    return 0;
+}
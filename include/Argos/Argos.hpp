@@ -10,6 +10,7 @@
 #include "ArgosException.hpp"
 #include "ArgosVersion.hpp"
 #include "ArgumentParser.hpp"
+#include "CompiledParser.hpp"
 
 /**
  * @file
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "Callbacks.hpp"
 
 /**
@@ -19,6 +20,7 @@
 namespace argos
 {
     struct ArgumentData;
+    class ValueBinding;
 
     /**
      * @brief Class for defining command line arguments.
@@ -214,6 +216,45 @@ namespace argos
          */
         Argument& count(unsigned min_count, unsigned max_count);
 
+        /**
+         * @brief Set the type the argument's values are converted to
+         *      while the command line is parsed.
+         *
+         * See ValueType for details. When several arguments and options
+         * share a value, it is sufficient to set the type on one of
+         * them, but they can't have different types.
+         * @return Reference to itself. This makes it possible to chain
+         *      method calls.
+         */
+        Argument& value_type(ValueType type);
+
+        /**
+         * @brief Only accept values that are among @a values.
+         *
+         * See Option::choices() for details.
+         * @return Reference to itself. This makes it possible to chain
+         *      method calls.
+         */
+        Argument& choices(std::vector<std::string> values);
+
+        /**
+         * @brief Write the argument's values directly to @a variable
+         *      while the command line is parsed.
+         *
+         * @a variable can be a bool, any of the integer and floating
+         * point types that ArgumentValue can convert to, a std::string,
+         * or a std::vector of any of these except bool. Each value is
+         * added to a vector, other variables get the last value.
+         * Invalid values are reported as errors by the parser.
+         *
+         * Bound values aren't stored in ParsedArguments, see
+         * Option::bind() for details.
+         * @return Reference to itself. This makes it possible to chain
+         *      method calls.
+         */
+        template <typename T>
+        Argument& bind(T& variable) = delete;
+
         /**
          * @private
          * @brief Used internally in Argos.
@@ -226,9 +267,68 @@ namespace argos
     private:
         void check_argument() const;
 
+        Argument& set_binding(std::shared_ptr<ValueBinding> binding);
+
         std::unique_ptr<ArgumentData> m_argument;
     };
 
+    template <>
+    Argument& Argument::bind<bool>(bool& variable);
+
+    template <>
+    Argument& Argument::bind<int>(int& variable);
+
+    template <>
+    Argument& Argument::bind<unsigned>(unsigned& variable);
+
+    template <>
+    Argument& Argument::bind<long>(long& variable);
+
+    template <>
+    Argument& Argument::bind<long long>(long long& variable);
+
+    template <>
+    Argument& Argument::bind<unsigned long>(unsigned long& variable);
+
+    template <>
+    Argument& Argument::bind<unsigned long long>(unsigned long long& variable);
+
+    template <>
+    Argument& Argument::bind<float>(float& variable);
+
+    template <>
+    Argument& Argument::bind<double>(double& variable);
+
+    template <>
+    Argument& Argument::bind<std::string>(std::string& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<int>>(std::vector<int>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<unsigned>>(std::vector<unsigned>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<long>>(std::vector<long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<long long>>(std::vector<long long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<unsigned long>>(std::vector<unsigned long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<unsigned long long>>(std::vector<unsigned long long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<float>>(std::vector<float>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<double>>(std::vector<double>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<std::string>>(std::vector<std::string>& variable);
+
     /**
      * @brief A convenient short alias for Argument.
      */
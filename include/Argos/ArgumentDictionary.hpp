@@ -0,0 +1,86 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "ArgumentValue.hpp"
+
+/**
+ * @file
+ * @brief Defines the ArgumentDictionary class.
+ */
+
+namespace argos
+{
+    /**
+     * @brief The keys and values of an option whose values are
+     *  key/value pairs, see Option::dictionary().
+     *
+     * The keys and values refer to the text in the ParsedArguments
+     * the dictionary came from, and are only valid as long as it
+     * exists. If a key is given more than once, the last value
+     * replaces the earlier ones, but the key keeps the position where
+     * it was first given.
+     */
+    class ArgumentDictionary
+    {
+    public:
+        using Entry = std::pair<std::string_view, std::string_view>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        ArgumentDictionary();
+
+        /**
+         * @private
+         * @brief Splits each of @a values on the first @a separator.
+         *
+         * Values without @a separator are keys with empty values.
+         */
+        ArgumentDictionary(
+            std::span<const std::pair<std::string_view, ArgumentId>> values,
+            char separator);
+
+        /**
+         * @brief Returns the number of distinct keys.
+         */
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Returns the value of @a key, or nothing if the key
+         *  wasn't given.
+         */
+        [[nodiscard]] std::optional<std::string_view>
+        lookup(std::string_view key) const;
+
+        [[nodiscard]] bool contains(std::string_view key) const;
+
+        /**
+         * @brief Returns the key/value pairs in the order the keys were
+         *  first given.
+         */
+        [[nodiscard]] const std::vector<Entry>& entries() const;
+
+        [[nodiscard]] const_iterator begin() const;
+
+        [[nodiscard]] const_iterator end() const;
+    private:
+        [[nodiscard]] std::optional<size_t> find(std::string_view key,
+                                                 uint32_t hash) const;
+
+        std::vector<Entry> m_entries;
+        /// A hash table of the keys' positions in m_entries, see
+        /// HashSlots in HashSlots.hpp.
+        std::vector<std::pair<uint32_t, uint32_t>> m_table;
+    };
+}
@@ -32,7 +32,7 @@ namespace argos
          * Client code must use ArgumentParser::make_iterator().
          */
         ArgumentIterator(std::vector<std::string_view> args,
-                         std::shared_ptr<ParserData> parser_data);
+                         std::shared_ptr<const ParserData> parser_data);
 
         /**
          * @private
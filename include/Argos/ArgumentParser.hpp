@@ -9,7 +9,9 @@
 #include <iosfwd>
 #include <memory>
 #include "ArgumentIterator.hpp"
+#include "ArgumentSource.hpp"
 #include "Command.hpp"
+#include "CompiledParser.hpp"
 
 /**
  * @file
@@ -91,6 +93,24 @@ namespace argos
          */
         ArgumentParser& add(Argument&& argument);
 
+        /**
+         * @brief Add a new argument definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Argument& argument, ValueHandle& handle);
+
+        /**
+         * @brief Add a new argument definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Argument&& argument, ValueHandle& handle);
+
         /**
          * @brief Add a new option definition to the ArgumentParser.
          *
@@ -107,6 +127,24 @@ namespace argos
          */
         ArgumentParser& add(Option&& option);
 
+        /**
+         * @brief Add a new option definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Option& option, ValueHandle& handle);
+
+        /**
+         * @brief Add a new option definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Option&& option, ValueHandle& handle);
+
         /**
          * @brief Add a new sub-command definition to the ArgumentParser.
          *
@@ -139,6 +177,46 @@ namespace argos
          */
         ArgumentParser& copy_from(const Command& command);
 
+        /**
+         * @brief Allow at most one of the options and arguments in
+         *  @a names to be given.
+         *
+         * Options are identified by any of their flags, arguments by
+         * their name. The constraints are checked when the command's
+         * arguments and options have been parsed, and the parser
+         * reports an error if one of them is violated. Only the
+         * options and arguments that are given on the command line
+         * count, not initial values or values set by callbacks.
+         *
+         * @throw ArgosException if @a names has less than two names.
+         *  The names are verified when parsing starts.
+         */
+        ArgumentParser& mutually_exclusive(std::vector<std::string> names);
+
+        /**
+         * @brief Require at least one of the options and arguments in
+         *  @a names to be given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        ArgumentParser& at_least_one_of(std::vector<std::string> names);
+
+        /**
+         * @brief Require all the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        ArgumentParser& depends_on(std::string name, std::vector<std::string> names);
+
+        /**
+         * @brief Allow none of the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        ArgumentParser& conflicts_with(std::string name, std::vector<std::string> names);
+
         /**
          * @brief Parses the arguments and options in argv.
          *
@@ -196,6 +274,50 @@ namespace argos
         [[nodiscard]]
         ParsedArguments parse(std::vector<std::string_view> args) const;
 
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @a args can be any contiguous range of char*, const char*,
+         * std::string_view or std::string, e.g. std::span<char*> or
+         * std::vector<std::string>. The arguments are read directly from
+         * @a args without being copied first.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         *
+         * @note The ArgumentParser instance is no longer valid after calling
+         *      the non-const version of parse(). All method calls on an invalid
+         *      ArgumentParser will throw an exception.
+         *
+         * @throw ArgosException if there are two or more options that use
+         *      the same flag.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParsedArguments parse(const Range& args)
+        {
+            return parse_source(ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @a args can be any contiguous range of char*, const char*,
+         * std::string_view or std::string, e.g. std::span<char*> or
+         * std::vector<std::string>. The arguments are read directly from
+         * @a args without being copied first.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         *
+         * @throw ArgosException if there are two or more options that use
+         *      the same flag.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParsedArguments parse(const Range& args) const
+        {
+            return parse_source(ArgumentSource(args));
+        }
+
         /**
          * @brief Creates an ArgumentIterator to iterate over the arguments
          *      in argv.
@@ -249,6 +371,21 @@ namespace argos
         [[nodiscard]]
         ArgumentIterator make_iterator(std::vector<std::string_view> args) const;
 
+        /**
+         * @brief Creates an immutable CompiledParser with the current
+         *      definitions and settings.
+         *
+         * The definitions are copied and finalized once. Parsing with the
+         * CompiledParser avoids the per-call copying done by the const
+         * versions of parse() and make_iterator(), and the CompiledParser
+         * can be shared by multiple threads. Later changes to the
+         * ArgumentParser do not affect the CompiledParser.
+         *
+         * @throw ArgosException if there are two or more options that use
+         *      the same flag.
+         */
+        [[nodiscard]] CompiledParser compile() const;
+
         /**
          * @brief Returns true if the ArgumentParser allows abbreviated options.
          */
@@ -267,6 +404,22 @@ namespace argos
          */
         ArgumentParser& allow_abbreviated_options(bool value);
 
+        /**
+         * @brief Returns true if the ArgumentParser allows abbreviated
+         *      command names.
+         */
+        [[nodiscard]] bool allow_abbreviated_commands() const;
+
+        /**
+         * @brief Enable or disable abbreviated command names.
+         *
+         * When enabled, it is sufficient to type the number of leading
+         * characters of a command's name that is needed to uniquely
+         * identify it among its sibling commands. A name that matches a
+         * command exactly is never considered an abbreviation.
+         */
+        ArgumentParser& allow_abbreviated_commands(bool value);
+
         /**
          * @brief Returns true if the program automatically exits if the
          *      command line has invalid options or arguments, or the help
@@ -391,6 +544,29 @@ namespace argos
          */
         ArgumentParser& ignore_undefined_options(bool value);
 
+        /**
+         * @brief Returns true if arguments starting with '@' are read as
+         *      names of response files.
+         */
+        [[nodiscard]] bool allow_response_files() const;
+
+        /**
+         * @brief Enable or disable reading arguments from response files.
+         *
+         * If this property is true, an argument "@FILE" is replaced by the
+         * arguments in FILE. The arguments are separated by whitespace,
+         * single and double quotes can be used for arguments containing
+         * whitespace, and a backslash makes the next character a normal
+         * character. Response files can themselves contain "@FILE"
+         * arguments, but not refer back to a file that is already being
+         * read. An argument "@FILE" where FILE can't be opened is kept as
+         * a normal argument.
+         *
+         * The files are memory-mapped, and the arguments are read
+         * directly from the mapped memory.
+         */
+        ArgumentParser& allow_response_files(bool value);
+
         /**
          * @brief Returns the callback function that will be called for every
          *      argument.
@@ -577,6 +753,10 @@ namespace argos
          */
         ArgumentParser&& move();
     private:
+        ParsedArguments parse_source(ArgumentSource args);
+
+        [[nodiscard]] ParsedArguments parse_source(ArgumentSource args) const;
+
         void check_data() const;
 
         std::unique_ptr<ParserData> m_data;
@@ -0,0 +1,140 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @file
+ * @brief Defines the ArgumentRange concept and the ArgumentSource class.
+ */
+
+namespace argos
+{
+    /**
+     * @brief A contiguous range of command line arguments, e.g.
+     *  std::vector<std::string>, std::span<char*> or
+     *  std::array<std::string_view, N>.
+     *
+     * The elements must be char*, const char*, std::string_view or
+     * std::string.
+     */
+    template <typename T>
+    concept ArgumentRange =
+        std::ranges::contiguous_range<T>
+        && std::ranges::sized_range<T>
+        && (std::is_same_v<std::ranges::range_value_t<T>, char*>
+            || std::is_same_v<std::ranges::range_value_t<T>, const char*>
+            || std::is_same_v<std::ranges::range_value_t<T>, std::string_view>
+            || std::is_same_v<std::ranges::range_value_t<T>, std::string>);
+
+    /**
+     * @private
+     * @brief A non-owning view of a contiguous sequence of command line
+     *  arguments.
+     *
+     * The arguments are read directly from the caller's memory, the
+     * parser only copies the values it stores in ParsedArguments.
+     */
+    class ArgumentSource
+    {
+    public:
+        constexpr ArgumentSource() noexcept = default;
+
+        constexpr ArgumentSource(const char* const* args, size_t size) noexcept
+            : m_c_strings(args),
+              m_size(size),
+              m_type(Type::C_STRING)
+        {}
+
+        constexpr ArgumentSource(const std::string_view* args, size_t size) noexcept
+            : m_string_views(args),
+              m_size(size),
+              m_type(Type::STRING_VIEW)
+        {}
+
+        constexpr ArgumentSource(const std::string* args, size_t size) noexcept
+            : m_strings(args),
+              m_size(size),
+              m_type(Type::STRING)
+        {}
+
+        template <ArgumentRange Range>
+        constexpr explicit ArgumentSource(const Range& args) noexcept
+            : ArgumentSource(std::ranges::data(args), std::ranges::size(args))
+        {}
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr std::string_view operator[](size_t i) const
+        {
+            switch (m_type)
+            {
+            case Type::C_STRING:
+                return m_c_strings[i];
+            case Type::STRING:
+                return m_strings[i];
+            default:
+                return m_string_views[i];
+            }
+        }
+
+        [[nodiscard]] constexpr std::string_view front() const
+        {
+            return (*this)[0];
+        }
+
+        constexpr void pop_front() noexcept
+        {
+            *this = subspan(1);
+        }
+
+        /**
+         * @brief Returns the arguments from @a offset to the end.
+         */
+        [[nodiscard]] constexpr ArgumentSource subspan(size_t offset) const noexcept
+        {
+            switch (m_type)
+            {
+            case Type::C_STRING:
+                return {m_c_strings + offset, m_size - offset};
+            case Type::STRING:
+                return {m_strings + offset, m_size - offset};
+            default:
+                return {m_string_views + offset, m_size - offset};
+            }
+        }
+    private:
+        enum class Type : unsigned char
+        {
+            C_STRING,
+            STRING_VIEW,
+            STRING
+        };
+
+        union
+        {
+            const char* const* m_c_strings;
+            const std::string_view* m_string_views = nullptr;
+            const std::string* m_strings;
+        };
+        size_t m_size = 0;
+        Type m_type = Type::STRING_VIEW;
+    };
+}
@@ -8,7 +8,10 @@
 #pragma once
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include "IArgumentView.hpp"
 
 /**
@@ -21,6 +24,39 @@ namespace argos
     class ParsedArgumentsImpl;
     class ArgumentValues;
 
+    /**
+     * @private
+     * @brief A value that has been converted to the ValueType of its
+     *      argument or option. Only the member that corresponds to
+     *      the ValueType is valid.
+     */
+    union TypedValue
+    {
+        unsigned long long ullong_value = 0;
+        bool bool_value;
+        int int_value;
+        unsigned uint_value;
+        long long_value;
+        long long llong_value;
+        unsigned long ulong_value;
+        float float_value;
+        double double_value;
+    };
+
+    /**
+     * @brief The types ArgumentValue::split_as() and
+     *  ArgumentValue::split_into() can convert values to.
+     */
+    template <typename T>
+    concept SplitNumber = std::is_same_v<T, int>
+                          || std::is_same_v<T, unsigned>
+                          || std::is_same_v<T, long>
+                          || std::is_same_v<T, long long>
+                          || std::is_same_v<T, unsigned long>
+                          || std::is_same_v<T, unsigned long long>
+                          || std::is_same_v<T, float>
+                          || std::is_same_v<T, double>;
+
     /**
      * @brief Wrapper class for the value of an argument or option.
      *
@@ -41,7 +77,9 @@ namespace argos
         ArgumentValue(const std::optional<std::string_view>& value,
                       std::shared_ptr<ParsedArgumentsImpl> args,
                       ValueId value_id,
-                      ArgumentId argument_id);
+                      ArgumentId argument_id,
+                      ValueType value_type = ValueType::STRING,
+                      TypedValue typed_value = {});
 
         /**
          * @private
@@ -232,6 +270,23 @@ namespace argos
          */
         [[nodiscard]] double as_double(double default_value = 0) const;
 
+        /**
+         * @brief Returns the position of the value from the command line
+         *      in the list of choices given to Option::choices() or
+         *      Argument::choices().
+         *
+         * Returns default_value if the value was not given on the command line.
+         *
+         * If the value is not among the choices, an error message
+         * is displayed and the program either exits (auto_exit is true) or the
+         * function throws an exception (auto_exit is false).
+         *
+         * @throw ArgosException if @a auto_exit is false and the given value
+         *      is not among the choices, or the value doesn't have any
+         *      choices.
+         */
+        [[nodiscard]] int as_choice(int default_value = -1) const;
+
         /**
          * @brief Returns the value from the command line as a string.
          *
@@ -278,6 +333,53 @@ namespace argos
         [[nodiscard]] ArgumentValues
         split_n(char separator, size_t num_parts) const;
 
+        /**
+         * @brief Splits the value from the command line on @a separator
+         *  and converts the parts to @a T.
+         *
+         * Unlike `split(separator).as_ints()` and similar, the parts
+         * are converted directly from the command line text, without
+         * creating any intermediate objects, which makes a difference
+         * for values with many thousands of parts. Integers are
+         * converted in base 10. An empty value has no parts.
+         *
+         * If a part can't be converted, an error message with the first
+         * such part is displayed and the program either exits
+         * (auto_exit is true) or the function throws an exception
+         * (auto_exit is false).
+         *
+         * @param separator The separator.
+         * @param thread_count The maximum number of threads that
+         *  convert the parts, 0 means the number of hardware threads.
+         *  Each thread gets at least 64 KiB of text.
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted.
+         */
+        template <SplitNumber T>
+        [[nodiscard]] std::vector<T>
+        split_as(char separator, unsigned thread_count = 1) const;
+
+        /**
+         * @brief Splits the value from the command line on @a separator
+         *  and writes the parts converted to @a T to @a buffer.
+         *
+         * Works like split_as(), but doesn't allocate memory for the
+         * result. Returns the number of parts. It is an error if
+         * @a buffer is too small. @a T can't be deduced from arrays
+         * and vectors, it must be given explicitly:
+         *
+         * ~~~{.cpp}
+         *  std::vector<int> ids(1000);
+         *  ids.resize(args.value("--ids").split_into<int>(ids, ','));
+         * ~~~
+         *
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted or @a buffer is too small.
+         */
+        template <SplitNumber T>
+        size_t split_into(std::span<T> buffer, char separator,
+                          unsigned thread_count = 1) const;
+
         /**
          * Display @a message as if it was an error produced within Argos
          * itself, including a reference to the argument or option this value
@@ -295,5 +397,7 @@ namespace argos
         std::shared_ptr<ParsedArgumentsImpl> m_args;
         ValueId m_value_id;
         ArgumentId m_argument_id;
+        ValueType m_value_type = ValueType::STRING;
+        TypedValue m_typed_value;
     };
 }
@@ -9,8 +9,9 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include "IArgumentView.hpp"
+#include "ArgumentValue.hpp"
 #include "ArgumentValueIterator.hpp"
+#include "ValuesView.hpp"
 
 /**
  * @file
@@ -19,7 +20,6 @@
 
 namespace argos
 {
-    class ArgumentValue;
     class ParsedArgumentsImpl;
 
     /**
@@ -36,7 +36,9 @@ namespace argos
          */
         ArgumentValues(std::vector<std::pair<std::string_view, ArgumentId>> values,
                        std::shared_ptr<ParsedArgumentsImpl> args,
-                       ValueId value_id);
+                       ValueId value_id,
+                       ValueType value_type = ValueType::STRING,
+                       std::vector<TypedValue> typed_values = {});
 
         /**
          * @private
@@ -129,6 +131,31 @@ namespace argos
          */
         [[nodiscard]] ArgumentValue value(size_t index) const;
 
+        /**
+         * @brief Returns a view of the values that neither allocates
+         *  memory nor shares ownership of the values.
+         *
+         * The view is only valid as long as this ArgumentValues exists.
+         */
+        [[nodiscard]] ValuesView<std::string_view> view() const &;
+
+        ValuesView<std::string_view> view() const && = delete;
+
+        /**
+         * @brief Returns a view of the values converted to @a T.
+         *
+         * See ValuesView::view_as() for the types @a T can be. The
+         * view is only valid as long as this ArgumentValues exists.
+         */
+        template <typename T>
+        [[nodiscard]] ValuesView<T> view_as() const &
+        {
+            return view().template view_as<T>();
+        }
+
+        template <typename T>
+        ValuesView<T> view_as() const && = delete;
+
         /**
          * @brief Returns a vector where every argument value has been
          *  converted to int.
@@ -261,6 +288,22 @@ namespace argos
         [[nodiscard]] std::vector<double>
         as_doubles(const std::vector<double>& default_value = {}) const;
 
+        /**
+         * @brief Returns a vector with every argument value's position in
+         *  the list of choices given to Option::choices() or
+         *  Argument::choices().
+         *
+         * If any of the argument values are not among the choices, an error
+         * message is written to stderr, the program also automatically exits
+         * if auto_exit is true.
+         *
+         * @param default_value This vector is returned if there are no values.
+         * @throw ArgosException if any value is not among the choices and
+         *  auto_exit is false, or the values don't have any choices.
+         */
+        [[nodiscard]] std::vector<int>
+        as_choices(const std::vector<int>& default_value = {}) const;
+
         /**
          * @brief Returns a vector with the argument values.
          *
@@ -301,6 +344,33 @@ namespace argos
         [[nodiscard]] ArgumentValues
         split_n(char separator, size_t num_parts) const;
 
+        /**
+         * @brief Splits each value on @a separator and returns all the
+         *  parts converted to @a T.
+         *
+         * See ArgumentValue::split_as() for details.
+         *
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted.
+         */
+        template <SplitNumber T>
+        [[nodiscard]] std::vector<T>
+        split_as(char separator, unsigned thread_count = 1) const;
+
+        /**
+         * @brief Splits each value on @a separator and writes all the
+         *  parts converted to @a T to @a buffer.
+         *
+         * Returns the number of parts. See ArgumentValue::split_into()
+         * for details.
+         *
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted or @a buffer is too small.
+         */
+        template <SplitNumber T>
+        size_t split_into(std::span<T> buffer, char separator,
+                          unsigned thread_count = 1) const;
+
         /**
          * @brief Returns an iterator pointing to the first value.
          */
@@ -314,5 +384,8 @@ namespace argos
         std::vector<std::pair<std::string_view, ArgumentId>> m_values;
         std::shared_ptr<ParsedArgumentsImpl> m_args;
         ValueId m_value_id;
+        ValueType m_value_type = ValueType::STRING;
+        /// The converted values, empty if m_value_type is STRING.
+        std::vector<TypedValue> m_typed_values;
     };
 }
@@ -8,6 +8,7 @@
 #pragma once
 #include "Argument.hpp"
 #include "Option.hpp"
+#include "ValueHandle.hpp"
 
 namespace argos
 {
@@ -93,6 +94,24 @@ namespace argos
          */
         Command& add(Argument&& argument);
 
+        /**
+         * @brief Add a new argument definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        Command& add(Argument& argument, ValueHandle& handle);
+
+        /**
+         * @brief Add a new argument definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        Command& add(Argument&& argument, ValueHandle& handle);
+
         /**
          * @brief Adds an option to the command.
          *
@@ -109,6 +128,24 @@ namespace argos
          */
         Command& add(Option&& option);
 
+        /**
+         * @brief Add a new option definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        Command& add(Option& option, ValueHandle& handle);
+
+        /**
+         * @brief Add a new option definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        Command& add(Option&& option, ValueHandle& handle);
+
         /**
          * @brief Adds a sub-command to the command.
          *
@@ -251,6 +288,29 @@ namespace argos
          */
         Command& require_subcommand(bool value);
 
+        /**
+         * @brief Defer adding the command's arguments, options and
+         *  sub-commands until the command is needed.
+         *
+         * @a callback receives a new Command with the same name, and
+         * should add the arguments, options and sub-commands to it. It
+         * can also set allow_multiple_subcommands and require_subcommand.
+         * The name, texts, section, visibility and id must be set on this
+         * command, changes to them in @a callback are ignored.
+         *
+         * The callback is called the first time the parser selects the
+         * command, or when the command's help text, or the arguments,
+         * options or sub-commands of its CommandView are requested.
+         * Programs with a large number of sub-commands can use this to
+         * avoid constructing all of them when only one is used.
+         *
+         * Each CompiledParser calls @a callback at most once. The const
+         * versions of ArgumentParser::parse() make a new copy of the
+         * definitions for each call, and will therefore call it every
+         * time the command is used.
+         */
+        Command& lazy_definition(std::function<void(Command&)> callback);
+
         /**
          * @brief Add copies of all arguments, options and sub-commands in
          *  @a command.
@@ -263,6 +323,46 @@ namespace argos
          */
         Command& copy_from(Command& command);
 
+        /**
+         * @brief Allow at most one of the options and arguments in
+         *  @a names to be given.
+         *
+         * Options are identified by any of their flags, arguments by
+         * their name. The constraints are checked when the command's
+         * arguments and options have been parsed, and the parser
+         * reports an error if one of them is violated. Only the
+         * options and arguments that are given on the command line
+         * count, not initial values or values set by callbacks.
+         *
+         * @throw ArgosException if @a names has less than two names.
+         *  The names are verified when parsing starts.
+         */
+        Command& mutually_exclusive(std::vector<std::string> names);
+
+        /**
+         * @brief Require at least one of the options and arguments in
+         *  @a names to be given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        Command& at_least_one_of(std::vector<std::string> names);
+
+        /**
+         * @brief Require all the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        Command& depends_on(std::string name, std::vector<std::string> names);
+
+        /**
+         * @brief Allow none of the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        Command& conflicts_with(std::string name, std::vector<std::string> names);
+
         /**
          * @private
          * @brief Used internally in Argos.
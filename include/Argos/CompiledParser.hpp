@@ -0,0 +1,326 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include "ArgumentIterator.hpp"
+#include "ArgumentSource.hpp"
+#include "IncrementalParser.hpp"
+#include "ParseError.hpp"
+
+/**
+ * @file
+ * @brief Defines the CompiledParser class.
+ */
+
+namespace argos
+{
+    class ParsedArgumentsImpl;
+    struct ParserData;
+
+    /**
+     * @brief The outcome of parsing one of the command lines given to
+     *  CompiledParser::parse_batch().
+     */
+    struct BatchParseResult
+    {
+        ParserResultCode result_code = ParserResultCode::NONE;
+        /**
+         * @brief The error message if result_code is FAILURE.
+         *
+         * The message starts with the name of the command that failed,
+         * as the first line of the message parse() writes.
+         */
+        std::string error_message;
+    };
+
+    /**
+     * @brief A function that receives the index and the parsed arguments
+     *  of each command line parsed by CompiledParser::parse_batch().
+     */
+    using BatchParseCallback =
+        std::function<void(size_t index, const ParsedArguments& args)>;
+
+    /**
+     * @brief An immutable, fully initialized parser created by
+     *      ArgumentParser::compile().
+     *
+     * The definitions of options, arguments and sub-commands are finalized
+     * once, when the CompiledParser is created. Every call to parse() or
+     * make_iterator() after that shares the same definitions instead of
+     * copying them, which makes CompiledParser the preferred choice for
+     * programs that parse many command lines with the same parser.
+     *
+     * All member functions are const and a CompiledParser can be shared
+     * and used concurrently by any number of threads, provided the
+     * callbacks and output stream it was compiled with are thread-safe.
+     * The exception is a parser with options or arguments that are bound
+     * to variables with Option::bind() or Argument::bind(): every parse
+     * writes to the variables, so such a parser can only parse one
+     * command line at a time.
+     *
+     * Copying a CompiledParser is cheap; the copies share the same
+     * definitions.
+     */
+    class CompiledParser
+    {
+    public:
+        /**
+         * @private
+         * @brief For internal use only.
+         *
+         * Client code must use ArgumentParser::compile().
+         */
+        explicit CompiledParser(std::shared_ptr<const ParserData> data);
+
+        /**
+         * @brief Parses the arguments and options in argv.
+         *
+         * Unlike the non-const ArgumentParser::parse(), this function does
+         * not change the program name to argv[0].
+         */
+        [[nodiscard]] ParsedArguments parse(int argc, char* argv[]) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        [[nodiscard]]
+        ParsedArguments parse(std::vector<std::string_view> args) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @a args can be any contiguous range of char*, const char*,
+         * std::string_view or std::string, e.g. std::span<char*> or
+         * std::vector<std::string>. The arguments are read directly from
+         * @a args without being copied first.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParsedArguments parse(const Range& args) const
+        {
+            return parse_source(ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses the arguments and options in argv into
+         *  @a result.
+         *
+         * Same as parse(argc, argv), see parse_into(ParsedArguments&,
+         * const Range&).
+         */
+        void parse_into(ParsedArguments& result, int argc, char* argv[]) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args into
+         *  @a result, reusing the memory of its previous values.
+         *
+         * The result is the same as if parse(args) had been assigned to
+         * @a result. If @a result was returned by this parser, or by an
+         * earlier call to parse_into() with this parser, its buffers are
+         * cleared and reused instead of allocating new ones. A loop
+         * that parses command lines of similar size this way stops
+         * allocating memory after the first few iterations, with the
+         * exception of arguments that callbacks add.
+         *
+         * @a result is assigned new parsed arguments instead if
+         * copies of it, or of the ParsedArguments of its sub-commands,
+         * exist, as clearing it would change their values too.
+         */
+        template <ArgumentRange Range>
+        void parse_into(ParsedArguments& result, const Range& args) const
+        {
+            parse_source_into(result, ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses the arguments and options in argv without
+         *  writing to the output stream, exiting or throwing exceptions.
+         *
+         * See try_parse(const Range&).
+         */
+        [[nodiscard]] ParseResult try_parse(int argc, char* argv[]) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args without
+         *  writing to the output stream, exiting or throwing exceptions.
+         *
+         * See try_parse(const Range&).
+         */
+        [[nodiscard]]
+        ParseResult try_parse(std::vector<std::string_view> args) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args without
+         *  writing to the output stream, exiting or throwing exceptions.
+         *
+         * Errors are returned as a ParseError regardless of the parser
+         * settings, and neither the error message nor the help text is
+         * formatted unless the program asks for it, which makes a
+         * failed parse about as fast as a successful one. The help
+         * text is not written when the help option is given either,
+         * the result code of the parsed arguments is STOP and the
+         * program can call write_help_text() itself.
+         *
+         * Errors that callbacks report with ParsedArgumentsBuilder::error()
+         * are returned too, with code ParseErrorCode::CALLBACK. If Argos
+         * is built without exception support, such errors are instead
+         * written to stderr and the program is aborted. Errors in the
+         * parser's definition, e.g. in a lazily defined sub-command, are
+         * not parse errors and are thrown as ArgosException.
+         *
+         * The returned ParsedArguments report errors in their values,
+         * e.g. from ArgumentValue::as_int(), the same way as those
+         * returned by parse().
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParseResult try_parse(const Range& args) const
+        {
+            return try_parse_source(ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses @a args into @a result like try_parse() does,
+         *  reusing the memory of its previous values.
+         *
+         * @a result is reused the same way as in parse_into().
+         *
+         * @return The error, if any.
+         */
+        template <ArgumentRange Range>
+        ParseError try_parse_into(ParsedArguments& result,
+                                  const Range& args) const
+        {
+            return try_parse_source_into(result, ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses each command line in @a command_lines on
+         *  @a thread_count threads.
+         *
+         * Nothing is written to the output stream and the program is
+         * never exited, regardless of the parser settings: errors
+         * are returned as BatchParseResult::error_message, and the
+         * help text is not written when the help option is given.
+         * The same goes for callbacks that use
+         * ParsedArgumentsBuilder::error() and
+         * ParsedArgumentsBuilder::stream().
+         *
+         * @param command_lines A random access range of command lines,
+         *  each one an ArgumentRange, e.g.
+         *  std::vector<std::vector<std::string>>. None of them should
+         *  have the name of the program as its first value. The
+         *  command lines must be stored in the range, views that create
+         *  them when they are read are not accepted as the arguments
+         *  are not copied.
+         * @param thread_count The number of threads, the number of
+         *  hardware threads if it is 0.
+         * @param callback If it is set, it is called with the parsed
+         *  arguments of each command line. The calls are made
+         *  concurrently from all the threads, in no particular order.
+         * @return The results in the same order as @a command_lines.
+         * @throw ArgosException if the parser has options or arguments
+         *  that are bound to variables, or if a command line uses a
+         *  lazily defined sub-command that binds variables and hasn't
+         *  been defined by an earlier parse.
+         */
+        template <std::ranges::random_access_range Range>
+            requires ArgumentRange<std::ranges::range_value_t<Range>>
+                     && std::is_reference_v<std::ranges::range_reference_t<const Range>>
+        [[nodiscard]] std::vector<BatchParseResult>
+        parse_batch(const Range& command_lines,
+                    unsigned thread_count = 0,
+                    const BatchParseCallback& callback = {}) const
+        {
+            std::vector<ArgumentSource> sources;
+            sources.reserve(std::ranges::size(command_lines));
+            for (const auto& args : command_lines)
+                sources.emplace_back(args);
+            return parse_batch_sources(sources, thread_count, callback);
+        }
+
+        /**
+         * @brief Creates an ArgumentIterator to iterate over the arguments
+         *      in argv.
+         */
+        [[nodiscard]]
+        ArgumentIterator make_iterator(int argc, char* argv[]) const;
+
+        /**
+         * @brief Creates an ArgumentIterator to iterate over the arguments
+         *      in @a args.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        [[nodiscard]]
+        ArgumentIterator make_iterator(std::vector<std::string_view> args) const;
+
+        /**
+         * @brief Creates an IncrementalParser that receives the
+         *  arguments one at a time.
+         */
+        [[nodiscard]] IncrementalParser make_incremental_parser() const;
+
+        /**
+         * @brief Return the program name.
+         */
+        [[nodiscard]] const std::string& program_name() const;
+
+        /**
+         * @brief Write the help text.
+         *
+         * @note The help text is printed automatically when the user gives
+         *  the help flag, this method is only needed if the program needs to
+         *  print it under other circumstances.
+         */
+        void write_help_text() const;
+
+        /**
+         * @brief Write the help text for the sub-command identified by
+         *      @a path.
+         *
+         * @param path The path to the sub-command.
+         */
+        void write_subcommand_help_text(const std::vector<std::string>& path) const;
+    private:
+        [[nodiscard]] ParsedArguments parse_source(ArgumentSource args) const;
+
+        void parse_source_into(ParsedArguments& result,
+                               ArgumentSource args) const;
+
+        [[nodiscard]] ParseResult try_parse_source(ArgumentSource args) const;
+
+        ParseError try_parse_source_into(ParsedArguments& result,
+                                         ArgumentSource args) const;
+
+        /**
+         * @brief Returns the ParsedArgumentsImpl of @a result, cleared,
+         *  if it can be reused, otherwise a new one.
+         */
+        [[nodiscard]] std::shared_ptr<ParsedArgumentsImpl>
+        reuse_or_create(ParsedArguments& result) const;
+
+        [[nodiscard]] std::vector<BatchParseResult>
+        parse_batch_sources(std::span<const ArgumentSource> sources,
+                            unsigned thread_count,
+                            const BatchParseCallback& callback) const;
+
+        std::shared_ptr<const ParserData> m_data;
+    };
+}
@@ -192,6 +192,47 @@ namespace argos
         FAILURE
     };
 
+    /**
+     * @brief Identifies the kind of error that made a parse fail, see
+     *      ParseError.
+     */
+    enum class ParseErrorCode
+    {
+        /// There was no error.
+        NONE,
+        /// An option that isn't defined.
+        UNKNOWN_OPTION,
+        /// An argument that isn't the name of a sub-command, where
+        /// one was expected.
+        UNKNOWN_COMMAND,
+        /// An option that requires a value was the last argument.
+        MISSING_VALUE,
+        /// A value that doesn't match the value type or choices of its
+        /// argument or option.
+        INVALID_VALUE,
+        /// More arguments than the command accepts.
+        TOO_MANY_ARGUMENTS,
+        /// Fewer arguments than the command requires.
+        TOO_FEW_ARGUMENTS,
+        /// A mandatory option wasn't given.
+        MISSING_OPTION,
+        /// The command requires a sub-command, but none was given.
+        MISSING_COMMAND,
+        /// The arguments or options violate a constraint, see
+        /// ArgumentParser::mutually_exclusive().
+        CONSTRAINT_VIOLATION,
+        /// An IncrementalParser couldn't tell which argument a value
+        /// belongs to within its lookahead limit.
+        AMBIGUOUS_ARGUMENT,
+        /// A response file could not be read.
+        RESPONSE_FILE,
+        /**
+         * @brief A callback reported an error with
+         *      ParsedArgumentsBuilder::error().
+         */
+        CALLBACK
+    };
+
     /**
      * @brief Tells which part of the help text (or error text) is assigned.
      *
@@ -301,6 +342,52 @@ namespace argos
         return Visibility(unsigned(a) & unsigned(b));
     }
 
+    /**
+     * @brief The type that the values of an argument or option are
+     *      converted to while the command line is parsed.
+     *
+     * The converted values are stored in ParsedArguments, and the
+     * ArgumentValue and ArgumentValues functions for the same type
+     * return them without converting the text again. Integers are
+     * converted with base 10, the functions convert the text as usual
+     * if they are called with a different base. Values that can't be
+     * converted are reported as errors by the parser.
+     */
+    enum class ValueType
+    {
+        /**
+         * @brief The values are only stored as text (the default).
+         */
+        STRING,
+        /// Corresponds to ArgumentValue::as_bool().
+        BOOL,
+        /// Corresponds to ArgumentValue::as_int().
+        INT,
+        /// Corresponds to ArgumentValue::as_uint().
+        UINT,
+        /// Corresponds to ArgumentValue::as_long().
+        LONG,
+        /// Corresponds to ArgumentValue::as_llong().
+        LLONG,
+        /// Corresponds to ArgumentValue::as_ulong().
+        ULONG,
+        /// Corresponds to ArgumentValue::as_ullong().
+        ULLONG,
+        /// Corresponds to ArgumentValue::as_float().
+        FLOAT,
+        /// Corresponds to ArgumentValue::as_double().
+        DOUBLE,
+        /**
+         * @brief Corresponds to ArgumentValue::as_choice().
+         *
+         * The values must be among the choices of the argument or
+         * option, and are stored as their position in the list of
+         * choices. Arguments and options with choices get this type
+         * unless they are given another one.
+         */
+        CHOICE
+    };
+
     /**
      * @brief Strong integer type for value ids.
      */
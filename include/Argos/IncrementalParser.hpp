@@ -0,0 +1,173 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+#include "ParsedArguments.hpp"
+
+/**
+ * @file
+ * @brief Defines the IncrementalParser class.
+ */
+namespace argos
+{
+    class ArgumentIteratorImpl;
+    struct ParserData;
+
+    /**
+     * @brief The return value of IncrementalParser::next().
+     */
+    enum class IncrementalResult
+    {
+        /**
+         * @brief An argument, option or sub-command was processed.
+         */
+        PROCESSED,
+        /**
+         * @brief More arguments are needed before the next argument or
+         *  option can be processed. Call IncrementalParser::push() or
+         *  IncrementalParser::finish() before calling next() again.
+         */
+        NEED_INPUT,
+        /**
+         * @brief All arguments and options have been processed.
+         */
+        DONE,
+        /**
+         * @brief The parser encountered an error.
+         */
+        FAILURE
+    };
+
+    /**
+     * @brief Parser created by CompiledParser that receives the command
+     *  line one argument at a time, and processes each argument as soon
+     *  as its meaning is known.
+     *
+     * This lets a program act on the first arguments of a long command
+     * line, e.g. one that is read from a pipe, before the rest of it
+     * has arrived. Arguments are added with push(), finish() tells the
+     * parser that there are no more, and next() returns the arguments
+     * and options in the same order as ArgumentIterator::next().
+     *
+     * Most arguments can be processed immediately, an option that
+     * takes a value must wait for the value. A command whose arguments
+     * have a variable count followed by other arguments, e.g.
+     * `FILE...` followed by `DEST`, is different: the argument that
+     * receives a value can depend on how many values follow it. Such
+     * values are held back until the parser can tell which argument
+     * they belong to, and the parser reports an error if that requires
+     * holding back more than max_lookahead() arguments.
+     *
+     * The parser is fully compatible with CompiledParser::parse(): the
+     * final result is the same as the one parse() returns for the
+     * complete command line.
+     */
+    class IncrementalParser
+    {
+    public:
+        /**
+         * @private
+         * @brief Constructs a new instance of IncrementalParser.
+         *
+         * Client code must use CompiledParser::make_incremental_parser().
+         */
+        explicit IncrementalParser(std::shared_ptr<const ParserData> parser_data);
+
+        /**
+         * @private
+         */
+        IncrementalParser(const IncrementalParser&) = delete;
+
+        /**
+         * @brief Moves the innards of the old object to the new one.
+         *
+         * Any attempt to use the old object will result in an exception.
+         */
+        IncrementalParser(IncrementalParser&&) noexcept;
+
+        ~IncrementalParser();
+
+        /**
+         * @private
+         */
+        IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+        /**
+         * @brief Moves the innards of the object on the right hand side
+         *      to the one on the left hand side.
+         *
+         * Any attempt to use the old object will result in an exception.
+         */
+        IncrementalParser& operator=(IncrementalParser&&) noexcept;
+
+        /**
+         * @brief Sets the maximum number of arguments that can be held
+         *  back while the parser waits to determine which argument the
+         *  first of them belongs to.
+         *
+         * The default is 1024.
+         */
+        IncrementalParser& max_lookahead(size_t n);
+
+        /**
+         * @brief Decides whether the values of arguments are stored in
+         *  parsed_arguments().
+         *
+         * The default is true. If it is false, the values of arguments
+         * are only available through next(), and the memory used by
+         * the parser doesn't grow with the number of arguments. The
+         * values of options are always stored.
+         */
+        IncrementalParser& store_argument_values(bool value);
+
+        /**
+         * @brief Adds the next argument of the command line.
+         *
+         * Arguments that are added after parsing has stopped, because
+         * of an error or an option like the help option, are added to
+         * the unprocessed arguments of parsed_arguments().
+         */
+        void push(std::string_view arg);
+
+        /**
+         * @brief Tells the parser that there are no more arguments.
+         */
+        void finish();
+
+        /**
+         * @brief Processes the next argument or option, if possible.
+         *
+         * @param arg The definition (ArgumentView, OptionView or
+         *      CommandView) of the processed argument, option or
+         *      sub-command. It is empty if the argument or option is
+         *      undefined, or if the result isn't PROCESSED.
+         * @param value As in ArgumentIterator::next(). The value remains
+         *      valid until the next call to next().
+         */
+        IncrementalResult next(std::unique_ptr<IArgumentView>& arg,
+                               std::string_view& value);
+
+        /**
+         * @brief Gives access to all the arguments and options processed
+         *      so far.
+         *
+         * The returned object belongs to the top-level command, the
+         * sub-commands are available through
+         * ParsedArguments::subcommands(). It is updated each time next()
+         * is called.
+         */
+        [[nodiscard]]
+        ParsedArguments parsed_arguments() const;
+    private:
+        ArgumentIteratorImpl& impl();
+
+        [[nodiscard]] const ArgumentIteratorImpl& impl() const;
+
+        std::unique_ptr<ArgumentIteratorImpl> m_impl;
+    };
+}
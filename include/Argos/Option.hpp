@@ -20,6 +20,7 @@
 namespace argos
 {
     struct OptionData;
+    class ValueBinding;
 
     /**
      * @brief Class for defining command line options.
@@ -312,6 +313,88 @@ namespace argos
          */
         Option& type(OptionType type);
 
+        /**
+         * @brief Set the type the option's values are converted to while
+         *  the command line is parsed.
+         *
+         * See ValueType for details. The option's constant and initial
+         * value must be valid values of the type. When several arguments
+         * and options share a value, it is sufficient to set the type on
+         * one of them, but they can't have different types.
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        Option& value_type(ValueType type);
+
+        /**
+         * @brief Only accept values that are among @a values.
+         *
+         * Values are checked while the command line is parsed, with a
+         * hash table that is built once when the parser is finished,
+         * and other values are reported as errors. The values are
+         * compared case-insensitively if
+         * ArgumentParser::case_insensitive() is true. The option's
+         * constant and initial value must be among @a values.
+         *
+         * Unless the option has been given another value type, its
+         * values get ValueType::CHOICE, and ArgumentValue::as_choice()
+         * returns the position of a value in @a values without
+         * comparing strings. When several arguments and options share
+         * a value, it is sufficient to set the choices on one of them,
+         * but they can't have different choices.
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        Option& choices(std::vector<std::string> values);
+
+        /**
+         * @brief Make the option's values key/value pairs, like the
+         *  values of a compiler's -D option.
+         *
+         * Sets the operation to APPEND. Every value must contain
+         * @a separator, the key is the text before the first
+         * @a separator and the value is the text after it. Values
+         * without @a separator are reported as errors by the parser.
+         *
+         * ParsedArguments::dictionary() returns the pairs with a hash
+         * table that finds a key's value without comparing it to the
+         * other keys.
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        Option& dictionary(char separator = '=');
+
+        /**
+         * @brief Write the option's values directly to @a variable
+         *  while the command line is parsed.
+         *
+         * @a variable can be a bool, any of the integer and floating
+         * point types that ArgumentValue can convert to, a std::string,
+         * or a std::vector of any of these except bool. The values are
+         * converted the same way as with value_type(), and invalid
+         * values are reported as errors by the parser.
+         *
+         * ASSIGN replaces the value of @a variable, APPEND adds values
+         * to vectors and replaces other values, and CLEAR empties
+         * vectors and gives other variables back the value they had
+         * when bind() was called. Every parse starts by giving all
+         * bound variables back that value.
+         *
+         * Bound values aren't stored in ParsedArguments: has() tells
+         * whether the option was given, but value() and values() return
+         * empty values. @a variable must exist for as long as the
+         * parser is used, and the parser can't parse several command
+         * lines at the same time (e.g. with parse_batch()).
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        template <typename T>
+        Option& bind(T& variable) = delete;
+
         /**
          * @brief Set whether this option is optional or mandatory.
          *
@@ -348,9 +431,68 @@ namespace argos
     private:
         void check_option() const;
 
+        Option& set_binding(std::shared_ptr<ValueBinding> binding);
+
         std::unique_ptr<OptionData> m_option;
     };
 
+    template <>
+    Option& Option::bind<bool>(bool& variable);
+
+    template <>
+    Option& Option::bind<int>(int& variable);
+
+    template <>
+    Option& Option::bind<unsigned>(unsigned& variable);
+
+    template <>
+    Option& Option::bind<long>(long& variable);
+
+    template <>
+    Option& Option::bind<long long>(long long& variable);
+
+    template <>
+    Option& Option::bind<unsigned long>(unsigned long& variable);
+
+    template <>
+    Option& Option::bind<unsigned long long>(unsigned long long& variable);
+
+    template <>
+    Option& Option::bind<float>(float& variable);
+
+    template <>
+    Option& Option::bind<double>(double& variable);
+
+    template <>
+    Option& Option::bind<std::string>(std::string& variable);
+
+    template <>
+    Option& Option::bind<std::vector<int>>(std::vector<int>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<unsigned>>(std::vector<unsigned>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<long>>(std::vector<long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<long long>>(std::vector<long long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<unsigned long>>(std::vector<unsigned long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<unsigned long long>>(std::vector<unsigned long long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<float>>(std::vector<float>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<double>>(std::vector<double>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<std::string>>(std::vector<std::string>& variable);
+
     /**
      * @brief A convenient short alias for Option.
      */
@@ -0,0 +1,152 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <optional>
+#include <string>
+#include "ParsedArguments.hpp"
+
+/**
+ * @file
+ * @brief Defines the ParseError and ParseResult classes.
+ */
+
+namespace argos
+{
+    struct CommandData;
+    struct ParserData;
+
+    /**
+     * @brief Describes the error that made CompiledParser::try_parse()
+     *  fail.
+     *
+     * Creating a ParseError is cheap, the error message is only
+     * formatted if message() or write() is called.
+     */
+    class ParseError
+    {
+    public:
+        /**
+         * @brief Creates an object that doesn't describe an error,
+         *  its code is NONE.
+         */
+        ParseError();
+
+        /**
+         * @private
+         * @brief For internal use only.
+         */
+        ParseError(ParseErrorCode code,
+                   std::string detail,
+                   ArgumentId argument_id,
+                   std::optional<size_t> token_index,
+                   const CommandData* command,
+                   std::shared_ptr<const ParserData> data);
+
+        /**
+         * @brief Returns true if there is an error, i.e. code() isn't
+         *  NONE.
+         */
+        explicit operator bool() const;
+
+        [[nodiscard]] ParseErrorCode code() const;
+
+        /**
+         * @brief Returns the position of the offending argument in the
+         *  arguments that were parsed.
+         *
+         * Errors that don't concern a particular argument, e.g. missing
+         * options, don't have a position. Arguments that were inserted
+         * by callbacks or read from response files are counted as if
+         * they had been part of the original arguments.
+         */
+        [[nodiscard]] std::optional<size_t> token_index() const;
+
+        /**
+         * @brief Returns the id of the argument or option the error
+         *  concerns, or 0 if it doesn't concern a particular one.
+         */
+        [[nodiscard]] ArgumentId argument_id() const;
+
+        /**
+         * @brief Returns the error message without the command and
+         *  argument names, e.g. "Invalid value: abc.".
+         */
+        [[nodiscard]] const std::string& detail() const;
+
+        /**
+         * @brief Returns the full error message, the same as the first
+         *  line parse() writes to the output stream.
+         */
+        [[nodiscard]] std::string message() const;
+
+        /**
+         * @brief Writes the error message and the command's usage to the
+         *  parser's output stream, the same way parse() does.
+         */
+        void write() const;
+    private:
+        /// Returns true if the message starts with the name of the
+        /// argument or option.
+        [[nodiscard]] bool has_argument_name() const;
+
+        ParseErrorCode m_code = ParseErrorCode::NONE;
+        ArgumentId m_argument_id = {};
+        std::optional<size_t> m_token_index;
+        std::string m_detail;
+        const CommandData* m_command = nullptr;
+        std::shared_ptr<const ParserData> m_data;
+    };
+
+    /**
+     * @brief The result of CompiledParser::try_parse(), either parsed
+     *  arguments or a ParseError.
+     *
+     * The interface mirrors the one of std::expected.
+     */
+    class ParseResult
+    {
+    public:
+        ParseResult();
+
+        /**
+         * @private
+         * @brief For internal use only.
+         */
+        ParseResult(ParsedArguments args, ParseError error);
+
+        /**
+         * @brief Returns true if the arguments were parsed without
+         *  errors.
+         */
+        [[nodiscard]] bool has_value() const;
+
+        /**
+         * @brief Same as has_value().
+         */
+        explicit operator bool() const;
+
+        /**
+         * @brief Returns the parsed arguments.
+         *
+         * If there was an error, the arguments are the ones that were
+         * processed before the error was found, and their result code
+         * is FAILURE.
+         */
+        [[nodiscard]] const ParsedArguments& value() const;
+
+        /**
+         * @brief Returns the error, its code is NONE if there was
+         *  no error.
+         */
+        [[nodiscard]] const ParseError& error() const;
+    private:
+        ParsedArguments m_args;
+        ParseError m_error;
+    };
+}
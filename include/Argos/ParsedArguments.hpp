@@ -8,11 +8,14 @@
 #pragma once
 #include <memory>
 #include <iosfwd>
+#include "ArgumentDictionary.hpp"
 #include "ArgumentValue.hpp"
 #include "ArgumentValues.hpp"
 #include "ArgumentView.hpp"
 #include "CommandView.hpp"
 #include "OptionView.hpp"
+#include "ValueHandle.hpp"
+#include "ValuesView.hpp"
 
 /**
  * @file
@@ -93,6 +96,15 @@ namespace argos
          */
         [[nodiscard]] bool has(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns true if the argument or option @a handle refers
+         *  to was given on command line.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] bool has(ValueHandle handle) const;
+
         /**
          * @brief Returns parsed arguments of sub-commands.
          *
@@ -114,6 +126,15 @@ namespace argos
          */
         [[nodiscard]] ArgumentValue value(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the value of the argument or option @a handle
+         *  refers to.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ArgumentValue value(ValueHandle handle) const;
+
         /**
          * @brief Returns the values of the argument with the given name.
          *
@@ -127,6 +148,78 @@ namespace argos
          */
         [[nodiscard]] ArgumentValues values(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the values of the argument or option @a handle
+         *  refers to.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ArgumentValues values(ValueHandle handle) const;
+
+        /**
+         * @brief Returns a view of the values of the argument or option
+         *  with the given name.
+         *
+         * Unlike values(), the view doesn't copy the values or share
+         * ownership of them, it is only valid as long as this
+         * ParsedArguments exists. Use ValuesView::view_as() to read
+         * the values as numbers.
+         *
+         * @throw ArgosException if @a name doesn't match the name of any
+         *  argument or option.
+         */
+        [[nodiscard]] ValuesView<std::string_view>
+        values_view(const std::string& name) const;
+
+        /**
+         * @brief Returns a view of the values of the given argument.
+         */
+        [[nodiscard]] ValuesView<std::string_view>
+        values_view(const IArgumentView& arg) const;
+
+        /**
+         * @brief Returns a view of the values of the argument or option
+         *  @a handle refers to.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ValuesView<std::string_view>
+        values_view(ValueHandle handle) const;
+
+        /**
+         * @brief Returns the values of the option with the given name
+         *  as key/value pairs, see Option::dictionary().
+         *
+         * Like values_view(), the dictionary doesn't copy the values,
+         * it is only valid as long as this ParsedArguments exists.
+         * Values of options that aren't dictionary options are split
+         * on '='.
+         *
+         * @throw ArgosException if @a name doesn't match the name of any
+         *  argument or option.
+         */
+        [[nodiscard]] ArgumentDictionary
+        dictionary(const std::string& name) const;
+
+        /**
+         * @brief Returns the values of the given option as key/value
+         *  pairs.
+         */
+        [[nodiscard]] ArgumentDictionary
+        dictionary(const IArgumentView& arg) const;
+
+        /**
+         * @brief Returns the values of the option @a handle refers to as
+         *  key/value pairs.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ArgumentDictionary
+        dictionary(ValueHandle handle) const;
+
         /**
          * @brief Returns all argument definitions that were added to the
          *  ArgumentParser.
@@ -216,6 +309,8 @@ namespace argos
         [[noreturn]]
         void error(const std::string& msg) const;
     private:
+        friend class CompiledParser;
+
         std::shared_ptr<ParsedArgumentsImpl> m_impl;
     };
 
@@ -8,6 +8,7 @@
 #pragma once
 #include "ArgumentValue.hpp"
 #include "ArgumentValues.hpp"
+#include "ValueHandle.hpp"
 
 /**
  * @file
@@ -71,6 +72,13 @@ namespace argos
         ParsedArgumentsBuilder& append(const IArgumentView& arg,
                                        const std::string& value);
 
+        /**
+         * @brief Add @a value to the argument or option @a handle
+         *  refers to.
+         */
+        ParsedArgumentsBuilder& append(ValueHandle handle,
+                                       const std::string& value);
+
         /**
          * @brief Set the value of the named argument or option.
          *
@@ -100,6 +108,13 @@ namespace argos
         ParsedArgumentsBuilder& assign(const IArgumentView& arg,
                                        const std::string& value);
 
+        /**
+         * @brief Set the value of the argument or option @a handle
+         *  refers to.
+         */
+        ParsedArgumentsBuilder& assign(ValueHandle handle,
+                                       const std::string& value);
+
         /**
          * @brief Removes the value or values of the named argument or option.
          *
@@ -125,6 +140,12 @@ namespace argos
          */
         ParsedArgumentsBuilder& clear(const IArgumentView& arg);
 
+        /**
+         * @brief Removes the value or values of the argument or option
+         *  @a handle refers to.
+         */
+        ParsedArgumentsBuilder& clear(ValueHandle handle);
+
         /**
          * @brief Returns the value of the named argument or option.
          * @throw ArgosException if the argument or option has multiple
@@ -140,6 +161,12 @@ namespace argos
          */
         [[nodiscard]] ArgumentValue value(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the value of the argument or option @a handle
+         *  refers to.
+         */
+        [[nodiscard]] ArgumentValue value(ValueHandle handle) const;
+
         /**
          * @brief Returns the value of the named argument or option.
          * @throw ArgosException if the name doesn't match any of names,
@@ -153,6 +180,12 @@ namespace argos
          */
         [[nodiscard]] ArgumentValues values(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the values of the argument or option @a handle
+         *  refers to.
+         */
+        [[nodiscard]] ArgumentValues values(ValueHandle handle) const;
+
         /**
          * @brief Returns true if the named argument or option has been
          *  assigned a value.
@@ -164,6 +197,12 @@ namespace argos
          */
         [[nodiscard]] bool has(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns true if the argument or option @a handle refers
+         *  to has been assigned a value.
+         */
+        [[nodiscard]] bool has(ValueHandle handle) const;
+
         /**
          * @brief Print @a msg along with a brief help text and exit.
          *
@@ -185,7 +224,9 @@ namespace argos
          *  ArgumentParser.
          *
          * Returns a reference to the default stream (std::cout) if none
-         * has been assigned.
+         * has been assigned, and a stream that discards everything
+         * written to it when the arguments are parsed with
+         * CompiledParser::parse_batch().
          */
         [[nodiscard]] std::ostream& stream() const;
 
@@ -0,0 +1,92 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+/**
+ * @file
+ * @brief Defines the ValueHandle class.
+ */
+
+namespace argos
+{
+    /**
+     * @brief Refers to the value of an argument or option without
+     *      using its name.
+     *
+     * ArgumentParser::add() and Command::add() set the handle when it
+     * is passed along with the argument or option. The handle can then
+     * be used with every ParsedArguments and ParsedArgumentsBuilder for
+     * the same command, and finds the value in constant time without
+     * allocating memory.
+     *
+     * A handle for an option or argument in a sub-command must be used
+     * with the ParsedArguments of that sub-command, using it with any
+     * other command's ParsedArguments is an error.
+     */
+    class ValueHandle
+    {
+    public:
+        /**
+         * @brief Creates a handle that doesn't refer to any value.
+         */
+        constexpr ValueHandle() = default;
+
+        /**
+         * @private
+         * @brief Used internally in Argos.
+         */
+        constexpr ValueHandle(unsigned command, bool is_option, unsigned index)
+            : m_command(command),
+              m_index(index),
+              m_is_option(is_option),
+              m_is_set(true)
+        {}
+
+        /**
+         * @brief Returns true if the handle has been set by add().
+         */
+        constexpr explicit operator bool() const
+        {
+            return m_is_set;
+        }
+
+        /**
+         * @private
+         * @brief Identifies the command the argument or option
+         *  belongs to.
+         */
+        [[nodiscard]] constexpr unsigned command() const
+        {
+            return m_command;
+        }
+
+        /**
+         * @private
+         * @brief Returns true if the handle refers to an option.
+         */
+        [[nodiscard]] constexpr bool is_option() const
+        {
+            return m_is_option;
+        }
+
+        /**
+         * @private
+         * @brief Returns the position of the argument or option among
+         *  the arguments or options in its command.
+         */
+        [[nodiscard]] constexpr unsigned index() const
+        {
+            return m_index;
+        }
+    private:
+        unsigned m_command = 0;
+        unsigned m_index = 0;
+        bool m_is_option = false;
+        bool m_is_set = false;
+    };
+}
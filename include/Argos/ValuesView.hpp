@@ -0,0 +1,267 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "ArgumentValue.hpp"
+
+/**
+ * @file
+ * @brief Defines the ValuesView class template.
+ */
+
+namespace argos
+{
+    class ParsedArgumentsImpl;
+
+    /**
+     * @private
+     * @brief The values a ValuesView refers to.
+     */
+    struct ValuesViewData
+    {
+        std::span<const std::pair<std::string_view, ArgumentId>> values;
+        /// Parallel to values unless type is STRING.
+        std::span<const TypedValue> typed_values;
+        ValueType type = ValueType::STRING;
+        const ParsedArgumentsImpl* args = nullptr;
+
+        /**
+         * @brief Returns value number @a index converted to @a type.
+         *
+         * Reports an invalid value the same way as ArgumentValue.
+         */
+        [[nodiscard]] TypedValue convert(size_t index, ValueType type) const;
+    };
+
+    /**
+     * @private
+     * @brief Maps the types ValuesView can convert values to to their
+     *  ValueType and TypedValue member.
+     */
+    template <typename T>
+    struct ValuesViewType;
+
+#define ARGOS_VALUES_VIEW_TYPE(type, value_type_, member) \
+    template <> \
+    struct ValuesViewType<type> \
+    { \
+        static constexpr ValueType VALUE_TYPE = ValueType::value_type_; \
+        static type get(const TypedValue& value) \
+        { \
+            return value.member; \
+        } \
+    }
+
+    ARGOS_VALUES_VIEW_TYPE(bool, BOOL, bool_value);
+    ARGOS_VALUES_VIEW_TYPE(int, INT, int_value);
+    ARGOS_VALUES_VIEW_TYPE(unsigned, UINT, uint_value);
+    ARGOS_VALUES_VIEW_TYPE(long, LONG, long_value);
+    ARGOS_VALUES_VIEW_TYPE(long long, LLONG, llong_value);
+    ARGOS_VALUES_VIEW_TYPE(unsigned long, ULONG, ulong_value);
+    ARGOS_VALUES_VIEW_TYPE(unsigned long long, ULLONG, ullong_value);
+    ARGOS_VALUES_VIEW_TYPE(float, FLOAT, float_value);
+    ARGOS_VALUES_VIEW_TYPE(double, DOUBLE, double_value);
+
+#undef ARGOS_VALUES_VIEW_TYPE
+
+    /**
+     * @brief A non-owning random access range over the values of an
+     *  argument or option.
+     *
+     * The values are std::string_views by default, view_as() returns
+     * a view that converts them to a number or bool. Values that were
+     * converted while parsing, because the argument or option has a
+     * ValueType, are not converted again.
+     *
+     * Neither the view nor its iterators allocate memory or update
+     * reference counts. They are only valid as long as the
+     * ParsedArguments they came from exists and hasn't been reused
+     * for another parse.
+     */
+    template <typename T>
+    class ValuesView : public std::ranges::view_interface<ValuesView<T>>
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            /**
+             * @private
+             */
+            Iterator(ValuesViewData data, size_t index)
+                : m_data(data),
+                  m_index(index)
+            {}
+
+            T operator*() const
+            {
+                return get_value(m_data, m_index);
+            }
+
+            T operator[](difference_type n) const
+            {
+                return get_value(m_data, m_index + n);
+            }
+
+            Iterator& operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto it = *this;
+                ++m_index;
+                return it;
+            }
+
+            Iterator& operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                auto it = *this;
+                --m_index;
+                return it;
+            }
+
+            Iterator& operator+=(difference_type n)
+            {
+                m_index += n;
+                return *this;
+            }
+
+            Iterator& operator-=(difference_type n)
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            friend Iterator operator+(Iterator it, difference_type n)
+            {
+                return it += n;
+            }
+
+            friend Iterator operator+(difference_type n, Iterator it)
+            {
+                return it += n;
+            }
+
+            friend Iterator operator-(Iterator it, difference_type n)
+            {
+                return it -= n;
+            }
+
+            friend difference_type operator-(const Iterator& a,
+                                             const Iterator& b)
+            {
+                return difference_type(a.m_index) - difference_type(b.m_index);
+            }
+
+            friend bool operator==(const Iterator& a, const Iterator& b)
+            {
+                return a.m_index == b.m_index;
+            }
+
+            friend std::strong_ordering operator<=>(const Iterator& a,
+                                                    const Iterator& b)
+            {
+                return a.m_index <=> b.m_index;
+            }
+        private:
+            ValuesViewData m_data;
+            size_t m_index = 0;
+        };
+
+        ValuesView() = default;
+
+        /**
+         * @private
+         */
+        explicit ValuesView(ValuesViewData data)
+            : m_data(data)
+        {}
+
+        [[nodiscard]] Iterator begin() const
+        {
+            return {m_data, 0};
+        }
+
+        [[nodiscard]] Iterator end() const
+        {
+            return {m_data, m_data.values.size()};
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return m_data.values.size();
+        }
+
+        /**
+         * @brief Returns the ArgumentId of the argument or option that
+         *  produced value number @a index.
+         */
+        [[nodiscard]] ArgumentId argument_id(size_t index) const
+        {
+            return m_data.values[index].second;
+        }
+
+        /**
+         * @brief Returns a view of the same values converted to @a U.
+         *
+         * @a U is bool, int, unsigned, long, long long, unsigned long,
+         * unsigned long long, float, double or std::string_view.
+         * Integers are parsed in base 10. Invalid values are reported
+         * when they are read, the same way as ArgumentValue reports
+         * them.
+         */
+        template <typename U>
+        [[nodiscard]] ValuesView<U> view_as() const
+        {
+            return ValuesView<U>(m_data);
+        }
+    private:
+        static T get_value(const ValuesViewData& data, size_t index)
+        {
+            if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                return data.values[index].first;
+            }
+            else
+            {
+                using Type = ValuesViewType<T>;
+                if (data.type == Type::VALUE_TYPE)
+                    return Type::get(data.typed_values[index]);
+                return Type::get(data.convert(index, Type::VALUE_TYPE));
+            }
+        }
+
+        ValuesViewData m_data;
+    };
+}
+
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<argos::ValuesView<T>> = true;
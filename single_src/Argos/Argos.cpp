@@ -7,8 +7,34 @@
 // License text is included with the source distribution.
 //****************************************************************************
 
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+    #define ARGOS_EXCEPTIONS 1
+#else
+    #define ARGOS_EXCEPTIONS 0
+    #include <cstdio>
+    #include <cstdlib>
+#endif
+
+namespace argos
+{
+    /**
+     * @brief Throws @a ex, or writes its message to stderr and aborts
+     *  the program if exceptions are disabled.
+     */
+    [[noreturn]] inline void throw_exception(const ArgosException& ex)
+    {
+#if ARGOS_EXCEPTIONS
+        throw ex;
+#else
+        std::fputs(ex.what(), stderr);
+        std::fputc('\n', stderr);
+        std::abort();
+#endif
+    }
+}
+
 #define _ARGOS_THROW_3(file, line, msg) \
-    throw ::argos::ArgosException(file ":" #line ": " msg)
+    ::argos::throw_exception(::argos::ArgosException(file ":" #line ": " msg))
 
 #define _ARGOS_THROW_2(file, line, msg) \
     _ARGOS_THROW_3(file, line, msg)
@@ -16,6 +42,132 @@
 #define ARGOS_THROW(msg) \
     _ARGOS_THROW_2(__FILE__, __LINE__, msg)
 
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace argos
+{
+    /**
+     * @brief The slots of a hash table that finds strings in a list
+     *  that is stored elsewhere.
+     *
+     * The table is open addressing with linear probing, and is at most
+     * half full. Each slot holds the hash of a string and the string's
+     * position in the list + 1, zero marks an empty slot. A lookup
+     * therefore normally makes a single string comparison regardless of
+     * the number of strings.
+     */
+    using HashSlots = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    /**
+     * @brief Makes @a slots an empty table with room for @a count
+     *  strings.
+     */
+    inline void init_hash_slots(HashSlots& slots, size_t count)
+    {
+        slots.assign(std::bit_ceil(2 * count), {0, 0});
+    }
+
+    /**
+     * @brief Adds the string at @a index, whose hash is @a hash, to
+     *  @a slots.
+     *
+     * The string must not be in the table already, and the table must
+     * have been made with room for it.
+     */
+    inline void insert_hash_slot(HashSlots& slots, uint32_t hash, size_t index)
+    {
+        const auto mask = slots.size() - 1;
+        auto i = hash & mask;
+        while (slots[i].second != 0)
+            i = (i + 1) & mask;
+        slots[i] = {hash, uint32_t(index + 1)};
+    }
+
+    /**
+     * @brief Returns the position of the string whose hash is @a hash
+     *  and for which @a is_match returns true.
+     *
+     * @a is_match is called with the positions of the strings that have
+     * the same hash.
+     */
+    template <typename IsMatch>
+    std::optional<size_t> find_hash_slot(const HashSlots& slots,
+                                         uint32_t hash,
+                                         IsMatch is_match)
+    {
+        if (slots.empty())
+            return {};
+
+        const auto mask = slots.size() - 1;
+        for (auto i = hash & mask; slots[i].second != 0; i = (i + 1) & mask)
+        {
+            const auto [slot_hash, index] = slots[i];
+            if (slot_hash == hash && is_match(size_t(index - 1)))
+                return index - 1;
+        }
+        return {};
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <string>
+#include <string_view>
+
+namespace argos
+{
+    /**
+     * @brief The values an argument or option accepts, and a hash
+     *  table that finds a value's position in the list.
+     */
+    class ChoiceSet
+    {
+    public:
+        ChoiceSet();
+
+        explicit ChoiceSet(std::vector<std::string> values);
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] const std::vector<std::string>& values() const;
+
+        /**
+         * @brief Builds the hash table, which must be done before
+         *  find() is called.
+         *
+         * @throw ArgosException if two values are equal.
+         */
+        void build_index(bool case_insensitive);
+
+        /**
+         * @brief Returns the position of @a value in values().
+         */
+        [[nodiscard]] std::optional<size_t> find(std::string_view value) const;
+    private:
+        [[nodiscard]] uint32_t hash(std::string_view value) const;
+
+        std::vector<std::string> m_values;
+        HashSlots m_table;
+        bool m_case_insensitive = false;
+    };
+}
+
 //****************************************************************************
 // Copyright © 2023 Jan Erik Breimo. All rights reserved.
 // Created by Jan Erik Breimo on 2023-10-10.
@@ -44,10 +196,12 @@ namespace argos
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-#include <string>
+#include <memory>
 
 namespace argos
 {
+    class ValueBinding;
+
     struct ArgumentData
     {
         std::string name;
@@ -57,6 +211,9 @@ namespace argos
         ArgumentCallback callback;
         unsigned min_count = 1;
         unsigned max_count = 1;
+        ValueType value_type = ValueType::STRING;
+        ChoiceSet choices;
+        std::shared_ptr<ValueBinding> binding;
         Visibility visibility = Visibility::NORMAL;
         int id = 0;
         ValueId value_id = {};
@@ -64,6 +221,184 @@ namespace argos
     };
 }
 
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    /**
+     * @brief Writes the values of an argument or option to a variable
+     *  in the program rather than to ParsedArguments.
+     */
+    class ValueBinding
+    {
+    public:
+        virtual ~ValueBinding() = default;
+
+        /**
+         * @brief The type the values must be converted to before they
+         *  are passed to assign() or append().
+         */
+        [[nodiscard]] virtual ValueType value_type() const = 0;
+
+        /**
+         * @brief Replaces the variable's current value or values with
+         *  @a value.
+         *
+         * @a text is the value before it was converted.
+         */
+        virtual void assign(std::string_view text, const TypedValue& value) = 0;
+
+        /**
+         * @brief Adds @a value to a vector, replaces any other value.
+         */
+        virtual void append(std::string_view text, const TypedValue& value) = 0;
+
+        /**
+         * @brief Empties a vector, gives any other variable back the
+         *  value it had when the binding was made.
+         */
+        virtual void clear() = 0;
+
+        /**
+         * @brief Gives the variable back the value it had when the
+         *  binding was made, which is done before each parse.
+         */
+        virtual void reset() = 0;
+    };
+
+    template <typename T>
+    struct BoundType;
+
+#define ARGOS_BOUND_TYPE(type, value_type_, member) \
+    template <> \
+    struct BoundType<type> \
+    { \
+        static constexpr ValueType VALUE_TYPE = ValueType::value_type_; \
+        static type get(std::string_view, const TypedValue& value) \
+        { \
+            return value.member; \
+        } \
+    }
+
+    ARGOS_BOUND_TYPE(bool, BOOL, bool_value);
+    ARGOS_BOUND_TYPE(int, INT, int_value);
+    ARGOS_BOUND_TYPE(unsigned, UINT, uint_value);
+    ARGOS_BOUND_TYPE(long, LONG, long_value);
+    ARGOS_BOUND_TYPE(long long, LLONG, llong_value);
+    ARGOS_BOUND_TYPE(unsigned long, ULONG, ulong_value);
+    ARGOS_BOUND_TYPE(unsigned long long, ULLONG, ullong_value);
+    ARGOS_BOUND_TYPE(float, FLOAT, float_value);
+    ARGOS_BOUND_TYPE(double, DOUBLE, double_value);
+
+#undef ARGOS_BOUND_TYPE
+
+    template <>
+    struct BoundType<std::string>
+    {
+        static constexpr ValueType VALUE_TYPE = ValueType::STRING;
+
+        static std::string get(std::string_view text, const TypedValue&)
+        {
+            return std::string(text);
+        }
+    };
+
+    template <typename T>
+    class ScalarBinding : public ValueBinding
+    {
+    public:
+        explicit ScalarBinding(T& variable)
+            : m_variable(variable),
+              m_default_value(variable)
+        {}
+
+        [[nodiscard]] ValueType value_type() const override
+        {
+            return BoundType<T>::VALUE_TYPE;
+        }
+
+        void assign(std::string_view text, const TypedValue& value) override
+        {
+            m_variable = BoundType<T>::get(text, value);
+        }
+
+        void append(std::string_view text, const TypedValue& value) override
+        {
+            m_variable = BoundType<T>::get(text, value);
+        }
+
+        void clear() override
+        {
+            m_variable = m_default_value;
+        }
+
+        void reset() override
+        {
+            m_variable = m_default_value;
+        }
+    private:
+        T& m_variable;
+        T m_default_value;
+    };
+
+    template <typename T>
+    class VectorBinding : public ValueBinding
+    {
+    public:
+        explicit VectorBinding(std::vector<T>& variable)
+            : m_variable(variable),
+              m_default_value(variable)
+        {}
+
+        [[nodiscard]] ValueType value_type() const override
+        {
+            return BoundType<T>::VALUE_TYPE;
+        }
+
+        void assign(std::string_view text, const TypedValue& value) override
+        {
+            m_variable.clear();
+            m_variable.push_back(BoundType<T>::get(text, value));
+        }
+
+        void append(std::string_view text, const TypedValue& value) override
+        {
+            m_variable.push_back(BoundType<T>::get(text, value));
+        }
+
+        void clear() override
+        {
+            m_variable.clear();
+        }
+
+        void reset() override
+        {
+            m_variable = m_default_value;
+        }
+    private:
+        std::vector<T>& m_variable;
+        std::vector<T> m_default_value;
+    };
+
+    template <typename T>
+    std::shared_ptr<ValueBinding> make_binding(T& variable)
+    {
+        return std::make_shared<ScalarBinding<T>>(variable);
+    }
+
+    template <typename T>
+    std::shared_ptr<ValueBinding> make_binding(std::vector<T>& variable)
+    {
+        return std::make_shared<VectorBinding<T>>(variable);
+    }
+}
+
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
 // Created by Jan Erik Breimo on 2020-01-07.
@@ -206,6 +541,57 @@ namespace argos
         return *this;
     }
 
+    Argument& Argument::value_type(ValueType type)
+    {
+        check_argument();
+        m_argument->value_type = type;
+        return *this;
+    }
+
+    Argument& Argument::choices(std::vector<std::string> values)
+    {
+        check_argument();
+        m_argument->choices = ChoiceSet(std::move(values));
+        return *this;
+    }
+
+    Argument& Argument::set_binding(std::shared_ptr<ValueBinding> binding)
+    {
+        check_argument();
+        m_argument->value_type = binding->value_type();
+        m_argument->binding = std::move(binding);
+        return *this;
+    }
+
+#define ARGOS_DEFINE_BIND(type) \
+    template <> \
+    Argument& Argument::bind<type>(type& variable) \
+    { \
+        return set_binding(make_binding(variable)); \
+    }
+
+    ARGOS_DEFINE_BIND(bool)
+    ARGOS_DEFINE_BIND(int)
+    ARGOS_DEFINE_BIND(unsigned)
+    ARGOS_DEFINE_BIND(long)
+    ARGOS_DEFINE_BIND(long long)
+    ARGOS_DEFINE_BIND(unsigned long)
+    ARGOS_DEFINE_BIND(unsigned long long)
+    ARGOS_DEFINE_BIND(float)
+    ARGOS_DEFINE_BIND(double)
+    ARGOS_DEFINE_BIND(std::string)
+    ARGOS_DEFINE_BIND(std::vector<int>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned>)
+    ARGOS_DEFINE_BIND(std::vector<long>)
+    ARGOS_DEFINE_BIND(std::vector<long long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long long>)
+    ARGOS_DEFINE_BIND(std::vector<float>)
+    ARGOS_DEFINE_BIND(std::vector<double>)
+    ARGOS_DEFINE_BIND(std::vector<std::string>)
+
+#undef ARGOS_DEFINE_BIND
+
     std::unique_ptr<ArgumentData> Argument::release()
     {
         check_argument();
@@ -220,132 +606,345 @@ namespace argos
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-09.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-#include <vector>
 
 namespace argos
 {
-    struct OptionData
+    struct CommandData;
+
+    /**
+     * @brief A sorted index of the names of a command's sub-commands.
+     *
+     * The names are case folded when the index is built if it is
+     * case-insensitive, lookups only fold the characters of the name
+     * they are looking for.
+     */
+    class CommandIndex
     {
-        std::vector<std::string> flags;
-        TextSource help;
-        std::string section;
-        std::string alias;
-        std::string argument;
-        std::string constant;
-        std::string initial_value;
-        OptionCallback callback;
-        OptionOperation operation = OptionOperation::ASSIGN;
-        OptionType type = OptionType::NORMAL;
-        Visibility visibility = Visibility::NORMAL;
-        bool optional = true;
-        int id = 0;
-        ArgumentId argument_id = {};
-        ValueId value_id = {};
-    };
+    public:
+        CommandIndex();
 
-    void validate_and_update(OptionData& option, OptionStyle style);
+        /**
+         * @throw ArgosException if two commands have the same name.
+         */
+        CommandIndex(const std::vector<std::unique_ptr<CommandData>>& commands,
+                     bool case_insensitive);
+
+        /**
+         * @brief Returns the command named @a name.
+         *
+         * If @a allow_abbreviations is true, @a name can also be a prefix
+         * of the name of a single command.
+         */
+        [[nodiscard]] const CommandData*
+        find(std::string_view name, bool allow_abbreviations) const;
+    private:
+        [[nodiscard]] char fold(char c) const;
+
+        /**
+         * @brief Returns true if @a name is a prefix of @a key.
+         */
+        [[nodiscard]] bool is_prefix(std::string_view name,
+                                     std::string_view key) const;
+
+        std::vector<std::pair<std::string, const CommandData*>> m_index;
+        bool m_case_insensitive = false;
+    };
 }
 
 //****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-09-04.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-#include <map>
-#include <memory>
+#include <algorithm>
+#include <cstddef>
 
 namespace argos
 {
-    struct CommandData
+    /**
+     * @brief A set of bits that is compared with other sets one 64-bit
+     *  word at a time.
+     *
+     * A set only stores the words in the range of bits it was assigned,
+     * the bits outside the range are zero. Sets with different ranges
+     * can be compared, only the words they have in common are read.
+     * This keeps sets with a few bits that are close together small,
+     * even if the bits' positions are large.
+     */
+    class BitSet
     {
-        CommandData();
+    public:
+        BitSet() = default;
 
-        CommandData(const CommandData&);
+        /**
+         * @brief Creates a set where the bits in [0, @a size) can be
+         *  set.
+         */
+        explicit BitSet(size_t size)
+        {
+            assign(0, size);
+        }
 
-        CommandData(CommandData&&) noexcept;
+        /**
+         * @brief Makes room for the bits in [@a first, @a last) and sets
+         *  all bits to 0.
+         */
+        void assign(size_t first, size_t last)
+        {
+            m_offset = first / 64;
+            m_words.assign(first < last ? (last + 63) / 64 - m_offset : 0, 0);
+        }
 
-        ~CommandData();
+        void set(size_t index)
+        {
+            m_words[index / 64 - m_offset] |= uint64_t(1) << (index % 64);
+        }
 
-        CommandData& operator=(const CommandData&);
+        void reset(size_t index)
+        {
+            m_words[index / 64 - m_offset] &= ~(uint64_t(1) << (index % 64));
+        }
 
-        CommandData& operator=(CommandData&&) noexcept;
+        /**
+         * @brief Sets all bits to 0.
+         */
+        void reset()
+        {
+            std::fill(m_words.begin(), m_words.end(), 0);
+        }
 
-        void add(std::unique_ptr<ArgumentData> arg);
+        [[nodiscard]] bool test(size_t index) const
+        {
+            const auto i = index / 64 - m_offset;
+            return i < m_words.size() && (m_words[i] >> (index % 64)) & 1;
+        }
 
-        void add(std::unique_ptr<OptionData> opt);
+        /**
+         * @brief Returns the number of bits that are set in both this
+         *  set and @a other.
+         */
+        [[nodiscard]] size_t count_common(const BitSet& other) const
+        {
+            size_t count = 0;
+            const auto [first, last] = common_words(other);
+            for (auto i = first; i < last; ++i)
+                count += std::popcount(word(i) & other.word(i));
+            return count;
+        }
 
-        void add(std::unique_ptr<CommandData> cmd);
+        /**
+         * @brief Returns true if at least one bit is set in both this
+         *  set and @a other.
+         */
+        [[nodiscard]] bool intersects(const BitSet& other) const
+        {
+            const auto [first, last] = common_words(other);
+            for (auto i = first; i < last; ++i)
+            {
+                if (word(i) & other.word(i))
+                    return true;
+            }
+            return false;
+        }
 
-        void copy_from(const CommandData& cmd);
+        /**
+         * @brief Returns the index of the first bit that is set in this
+         *  set, but not in @a other.
+         */
+        [[nodiscard]] std::optional<size_t>
+        find_first_missing(const BitSet& other) const
+        {
+            for (size_t i = 0; i < m_words.size(); ++i)
+            {
+                const auto n = i + m_offset;
+                auto w = m_words[i];
+                if (n >= other.m_offset
+                    && n - other.m_offset < other.m_words.size())
+                {
+                    w &= ~other.word(n);
+                }
+                if (w)
+                    return n * 64 + size_t(std::countr_zero(w));
+            }
+            return {};
+        }
+    private:
+        /**
+         * @brief Returns word number @a n, counting from bit 0, which
+         *  must be one of the stored words.
+         */
+        [[nodiscard]] uint64_t word(size_t n) const
+        {
+            return m_words[n - m_offset];
+        }
 
-        void build_option_index(bool case_insensitive);
+        [[nodiscard]] std::pair<size_t, size_t>
+        common_words(const BitSet& other) const
+        {
+            return {std::max(m_offset, other.m_offset),
+                    std::min(m_offset + m_words.size(),
+                             other.m_offset + other.m_words.size())};
+        }
 
-        [[nodiscard]] const OptionData*
-        find_option(std::string_view flag,
-                    bool allow_abbreviations,
-                    bool case_insensitive) const;
+        /// The number of the first word in m_words, counting from bit 0.
+        size_t m_offset = 0;
+        std::vector<uint64_t> m_words;
+    };
+}
 
-        [[nodiscard]] const CommandData*
-        find_command(std::string_view cmd_name,
-                     bool case_insensitive) const;
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
 
-        std::vector<std::unique_ptr<ArgumentData>> arguments;
-        std::vector<std::unique_ptr<OptionData>> options;
-        std::vector<std::unique_ptr<CommandData>> commands;
-        std::string current_section;
+namespace argos
+{
+    struct ArgumentData;
+    struct OptionData;
+    class ValueIndex;
+
+    enum class ConstraintType
+    {
+        /// At most one of the arguments and options can be given.
+        MUTUALLY_EXCLUSIVE,
+        /// At least one of the arguments and options must be given.
+        AT_LEAST_ONE_OF,
+        /// If the first argument or option is given, all the others
+        /// must be given too.
+        DEPENDS_ON,
+        /// If the first argument or option is given, none of the
+        /// others can be given.
+        CONFLICTS_WITH
+    };
+
+    /**
+     * @brief A constraint as it was defined, the names are flags and
+     *  argument names.
+     */
+    struct ConstraintData
+    {
+        ConstraintType type = ConstraintType::MUTUALLY_EXCLUSIVE;
+        std::vector<std::string> names;
+    };
+
+    /**
+     * @brief Checks the mandatory options and the constraints of a
+     *  command.
+     *
+     * Arguments and options are identified by their position in the
+     * command, i.e. argument_id - ValueIndex::first_argument_id(), and
+     * values by value_id - ValueIndex::first_value_id(). The checks
+     * compare bit sets with these positions a word at a time, the
+     * options are only looked at to produce an error message.
+     */
+    class ConstraintChecker
+    {
+    public:
+        ConstraintChecker();
 
-        std::string name;
-        std::string full_name;
-        std::map<TextId, TextSource> texts;
-        Visibility visibility = Visibility::NORMAL;
-        std::optional<bool> require_subcommand;
-        bool multi_command = false;
         /**
-         * The heading the command is listed under in the parent
-         * command's help.
+         * @brief Resolves the names in @a constraints to positions in
+         *  @a index.
+         *
+         * Throws ArgosException if a name isn't a flag or argument name
+         * in the command.
          */
-        std::string section;
-        int id = 0;
-        ArgumentId argument_id = {};
+        ConstraintChecker(
+            const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+            const std::vector<std::unique_ptr<OptionData>>& options,
+            const std::vector<ConstraintData>& constraints,
+            const ValueIndex& index);
 
-    private:
+        ConstraintChecker(ConstraintChecker&&) noexcept;
+
+        ~ConstraintChecker();
+
+        ConstraintChecker& operator=(ConstraintChecker&&) noexcept;
+
+        /**
+         * @brief Returns the first mandatory option that is missing.
+         *
+         * @a values has the positions of the values that are set,
+         * @a given has the positions of the arguments and options that
+         * have been given.
+         */
         [[nodiscard]] const OptionData*
-        find_option_impl(std::string_view flag,
-                         bool allow_abbreviations,
-                         bool case_insensitive) const;
+        find_missing_option(const BitSet& values, const BitSet& given) const;
 
-        std::vector<std::pair<std::string_view, const OptionData*>> option_index;
+        /**
+         * @brief Returns an error message for the first constraint
+         *  that is violated by @a given, or an empty string.
+         */
+        [[nodiscard]] std::string check_constraints(const BitSet& given) const;
+    private:
+        struct Constraint;
+
+        /// The mandatory options in the order they were defined.
+        std::vector<const OptionData*> m_mandatory_options;
+        /// The values of the mandatory options.
+        BitSet m_mandatory_values;
+        /// The mandatory options that don't have a value.
+        BitSet m_mandatory_flags;
+        ValueId m_first_value_id = {};
+        ArgumentId m_first_argument_id = {};
+        std::vector<Constraint> m_constraints;
     };
+}
 
-    struct ParserData;
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-09.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
 
-    /**
-     * Finish the initialization of this command and any subcommands, and
-     * make them ready for parsing arguments.
-     */
-    void finish_initialization(CommandData& cmd,
-                               const ParserData& data,
-                               ValueId start_id = {},
-                               ArgumentId argument_id = {});
+namespace argos
+{
+    class ValueBinding;
 
-    struct ParserSettings;
+    struct OptionData
+    {
+        std::vector<std::string> flags;
+        TextSource help;
+        std::string section;
+        std::string alias;
+        std::string argument;
+        std::string constant;
+        std::string initial_value;
+        OptionCallback callback;
+        OptionOperation operation = OptionOperation::ASSIGN;
+        OptionType type = OptionType::NORMAL;
+        ValueType value_type = ValueType::STRING;
+        ChoiceSet choices;
+        /// Non-zero if the values are key/value pairs separated by
+        /// this character.
+        char dictionary_separator = '\0';
+        std::shared_ptr<ValueBinding> binding;
+        Visibility visibility = Visibility::NORMAL;
+        bool optional = true;
+        int id = 0;
+        ArgumentId argument_id = {};
+        ValueId value_id = {};
+    };
 
-    bool has_flag(const CommandData& cmd,
-                  std::string_view flag,
-                  const ParserSettings& settings);
+    void validate_and_update(OptionData& option, OptionStyle style);
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-22.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -353,453 +952,718 @@ namespace argos
 
 namespace argos
 {
-    class ArgumentCounter
+    struct OptionData;
+
+    /**
+     * @brief A path-compressed trie that maps flags to options.
+     *
+     * The nodes are stored in a single vector where the children of a
+     * node are consecutive and sorted on the first character of their
+     * labels. Flags are case folded when the trie is built if it is
+     * case-insensitive, lookups only fold the characters of the flag
+     * they are looking for.
+     */
+    class OptionTrie
     {
     public:
-        ArgumentCounter();
+        OptionTrie();
 
-        explicit ArgumentCounter(const CommandData& command);
+        /**
+         * @brief Builds a trie from @a flags, which must be free of
+         *  duplicates.
+         */
+        OptionTrie(std::vector<std::pair<std::string_view, const OptionData*>> flags,
+                   bool case_insensitive);
 
-        ArgumentCounter(const CommandData& command,
-                        size_t argument_count,
-                        size_t initial_count = 0);
+        /**
+         * @brief Returns the option with the flag @a flag.
+         *
+         * If @a allow_abbreviations is true, @a flag can also be a prefix
+         * of a single flag. A flag ending with '=' that isn't a flag
+         * itself matches an option with the same flag without the '='
+         * if the option takes an argument.
+         */
+        [[nodiscard]] const OptionData*
+        find(std::string_view flag, bool allow_abbreviations) const;
 
-        const ArgumentData* next_argument();
+        [[nodiscard]] bool empty() const;
+    private:
+        struct Node
+        {
+            uint32_t label_offset = 0;
+            uint32_t label_size = 0;
+            uint32_t first_child = 0;
+            uint32_t child_count = 0;
+            /// The option whose flag ends at this node.
+            const OptionData* option = nullptr;
+            /// The option if there is only one flag in this node's
+            /// subtree.
+            const OptionData* unique_option = nullptr;
+        };
 
-        [[nodiscard]] size_t count() const;
+        using FlagIterator = std::vector<std::pair<std::string, const OptionData*>>::const_iterator;
 
-        [[nodiscard]] bool is_complete() const;
+        void add_children(uint32_t node_index,
+                          FlagIterator begin, FlagIterator end,
+                          size_t depth);
 
-        static std::pair<size_t, size_t>
-        get_min_max_count(const CommandData& command);
+        [[nodiscard]] uint32_t find_child(const Node& node, char c) const;
 
-        static bool requires_argument_count(const CommandData& command);
+        [[nodiscard]] const OptionData*
+        get_option(const Node& node, size_t label_pos,
+                   bool allow_abbreviations) const;
 
-    private:
-        using Counter = std::pair<size_t, const ArgumentData*>;
-        std::vector<Counter> m_counters;
-        size_t m_index = 0;
-        size_t m_first_optional = 0;
-        size_t m_counter = 0;
+        [[nodiscard]] char fold(char c) const;
+
+        std::vector<Node> m_nodes;
+        /// The labels of all nodes.
+        std::string m_labels;
+        bool m_case_insensitive = false;
     };
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-22.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <span>
+#include <tuple>
 
 namespace argos
 {
-    namespace
+    struct ArgumentData;
+    class ChoiceSet;
+    struct OptionData;
+    class ValueBinding;
+
+    /**
+     * @brief The ValueIds and ArgumentIds of a command's arguments and
+     *  options, and the names they can be looked up by.
+     *
+     * The index is built once when the command's definition is
+     * complete, so ParsedArgumentsImpl doesn't have to build it for
+     * every parse.
+     */
+    class ValueIndex
     {
-        size_t find_first_optional(const CommandData& command)
-        {
-            auto& arguments = command.arguments;
-            size_t result = 0;
-            for (size_t i = 0; i < arguments.size(); ++i)
-            {
-                if (arguments[i]->min_count > 0)
-                    result = i + 1;
-            }
-            return result;
-        }
+    public:
+        struct ValueInfo
+        {
+            ValueType type = ValueType::STRING;
+            ValueBinding* binding = nullptr;
+            /// The values the value is restricted to, if any.
+            const ChoiceSet* choices = nullptr;
+            /// Non-zero if the values are key/value pairs separated by
+            /// this character.
+            char dictionary_separator = '\0';
+        };
 
-        void make_argument_counters(
-            const CommandData& command,
-            std::vector<std::pair<size_t, const ArgumentData*>>& counters,
-            size_t& first_optional)
-        {
-            first_optional = find_first_optional(command);
-            for (size_t i = 0; i < command.arguments.size(); ++i)
-            {
-                auto& a = command.arguments[i];
-                if (i + 1 == first_optional && a->min_count != a->max_count)
-                {
-                    counters.emplace_back(a->min_count, a.get());
-                    counters.emplace_back(a->max_count - a->min_count, a.get());
-                }
-                else
-                {
-                    counters.emplace_back(a->max_count, a.get());
-                }
-            }
-        }
+        ValueIndex();
 
-        std::vector<std::pair<size_t, const ArgumentData*>>
-        make_argument_counters(const CommandData& command,
-                               size_t n)
-        {
-            const auto [lo, hi] = ArgumentCounter::get_min_max_count(command);
-            if (n < lo)
-                n = 0;
-            else if (n > hi)
-                n = hi - lo;
-            else
-                n -= lo;
+        /**
+         * @brief Indexes @a arguments and @a options, whose ValueIds
+         *  and ArgumentIds must have been assigned.
+         *
+         * Arguments and options that share a value are assumed to have
+         * the same ValueType, binding, choices and dictionary separator.
+         */
+        ValueIndex(const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+                   const std::vector<std::unique_ptr<OptionData>>& options);
 
-            std::vector<std::pair<size_t, const ArgumentData*>> result;
-            for (auto& arg : command.arguments)
-            {
-                if (n == 0 || arg->min_count == arg->max_count)
-                {
-                    result.emplace_back(arg->min_count, arg.get());
-                }
-                else if (arg->min_count + n <= arg->max_count)
-                {
-                    result.emplace_back(arg->min_count + n, arg.get());
-                    n = 0;
-                }
-                else
-                {
-                    result.emplace_back(arg->max_count, arg.get());
-                    n -= arg->max_count - arg->min_count;
-                }
-            }
-            return result;
-        }
-    }
+        /**
+         * @brief Returns the ValueId and ArgumentId of the argument or
+         *  option with the name, flag or alias @a name.
+         *
+         * The ArgumentId is empty if several arguments or options have
+         * the same name.
+         */
+        [[nodiscard]] std::optional<std::pair<ValueId, ArgumentId>>
+        find(std::string_view name) const;
 
-    ArgumentCounter::ArgumentCounter()
-        : m_counters()
-    {
-    }
+        /**
+         * @brief The lowest ValueId in the command.
+         */
+        [[nodiscard]] ValueId first_value_id() const;
 
-    ArgumentCounter::ArgumentCounter(const CommandData& command)
-    {
-        make_argument_counters(command, m_counters, m_first_optional);
-    }
+        /**
+         * @brief The type and binding of each value in the command,
+         *  indexed by value_id - first_value_id().
+         */
+        [[nodiscard]] std::span<const ValueInfo> values() const;
 
-    ArgumentCounter::ArgumentCounter(const CommandData& command,
-                                     size_t argument_count,
-                                     size_t initial_count)
-        : m_counters(make_argument_counters(command, argument_count)),
-          m_first_optional(m_counters.size())
-    {
-        for (size_t i = 0; i < initial_count; ++i)
-        {
-            if (next_argument() == nullptr)
-                break;
-        }
-    }
+        /**
+         * @brief Returns the bindings of the command's values.
+         */
+        [[nodiscard]] std::span<ValueBinding* const> bindings() const;
 
-    const ArgumentData* ArgumentCounter::next_argument()
-    {
-        while (m_index != m_counters.size() && m_counters[m_index].first == 0)
-            ++m_index;
+        /**
+         * @brief Returns the ArgumentIds of the arguments and options
+         *  with value @a value_id, arguments first.
+         */
+        [[nodiscard]] std::span<const ArgumentId>
+        argument_ids(ValueId value_id) const;
 
-        if (m_index == m_counters.size())
-            return nullptr;
+        /**
+         * @brief Returns the values that have initial values, in
+         *  ascending order.
+         */
+        [[nodiscard]] std::span<const ValueId> initialized_values() const;
 
-        ++m_counter;
-        --m_counters[m_index].first;
-        return m_counters[m_index].second;
-    }
+        /**
+         * @brief Returns the initial values of the options with value
+         *  @a value_id, and the ArgumentIds of the options.
+         *
+         * The views refer to the strings in the options' OptionData.
+         */
+        [[nodiscard]] std::span<const std::pair<std::string_view, ArgumentId>>
+        initial_values(ValueId value_id) const;
 
-    size_t ArgumentCounter::count() const
-    {
-        return m_counter;
-    }
+        /**
+         * @brief Returns the initial values of value @a value_id
+         *  converted to its ValueType, parallel to initial_values().
+         */
+        [[nodiscard]] std::span<const TypedValue>
+        typed_initial_values(ValueId value_id) const;
 
-    bool ArgumentCounter::is_complete() const
-    {
-        return m_index >= m_first_optional
-               || (m_index + 1 == m_first_optional
-                   && m_counters[m_index].first == 0);
-    }
+        /**
+         * @brief Returns the argument with @a argument_id, or nullptr
+         *  if it is an option or not part of the command.
+         */
+        [[nodiscard]] const ArgumentData*
+        find_argument(ArgumentId argument_id) const;
 
-    std::pair<size_t, size_t>
-    ArgumentCounter::get_min_max_count(const CommandData& command)
-    {
-        size_t lo = 0, hi = 0;
-        for (auto& arg : command.arguments)
-        {
-            lo += arg->min_count;
-            if (hi != SIZE_MAX)
-            {
-                if (arg->max_count > SIZE_MAX - hi)
-                    hi = SIZE_MAX;
-                else
-                    hi += arg->max_count;
-            }
-        }
-        return {lo, hi};
-    }
+        /**
+         * @brief Returns the option with @a argument_id, or nullptr if
+         *  it is an argument or not part of the command.
+         */
+        [[nodiscard]] const OptionData*
+        find_option(ArgumentId argument_id) const;
 
-    bool ArgumentCounter::requires_argument_count(const CommandData& command)
-    {
-        bool deterministic = true;
-        for (auto& arg : command.arguments)
-        {
-            if (!deterministic)
-                return true;
-            if (arg->min_count != arg->max_count)
-                deterministic = false;
-        }
-        return false;
-    }
+        /**
+         * @brief The lowest ArgumentId of the command's arguments and
+         *  options.
+         */
+        [[nodiscard]] ArgumentId first_argument_id() const;
+
+        /**
+         * @brief The number of arguments and options in the command,
+         *  their ArgumentIds are consecutive from first_argument_id().
+         */
+        [[nodiscard]] size_t argument_count() const;
+    private:
+        /// Flags, argument names and aliases sorted by name.
+        std::vector<std::tuple<std::string_view, ValueId, ArgumentId>> m_names;
+        ValueId m_first_value_id = {};
+        std::vector<ValueInfo> m_values;
+        std::vector<ValueBinding*> m_bindings;
+        /// The ArgumentIds of value i are in
+        /// [m_value_offsets[i], m_value_offsets[i + 1]).
+        std::vector<ArgumentId> m_value_arguments;
+        std::vector<size_t> m_value_offsets;
+        std::vector<ValueId> m_initialized_values;
+        /// The initial values of value i are in
+        /// [m_initial_offsets[i], m_initial_offsets[i + 1]).
+        std::vector<std::pair<std::string_view, ArgumentId>> m_initial_values;
+        std::vector<TypedValue> m_typed_initial_values;
+        std::vector<size_t> m_initial_offsets;
+        ArgumentId m_first_argument_id = {};
+        /// Indexed by argument_id - m_first_argument_id, exactly one
+        /// of the pointers is set in each entry.
+        std::vector<std::pair<const ArgumentData*, const OptionData*>> m_arguments;
+    };
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-27.
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-09-04.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-#include <iosfwd>
-#include <string_view>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
 
 namespace argos
 {
-    class TextWriter
+    class Command;
+    struct ParserData;
+
+    /**
+     * The part of a command's definition that is deferred until the
+     * command is needed.
+     */
+    struct LazyDefinition
+    {
+        explicit LazyDefinition(std::function<void(Command&)> callback);
+
+        /// Adds the command's arguments, options and sub-commands. It is
+        /// set to nullptr once it has been called.
+        std::function<void(Command&)> callback;
+        std::once_flag once;
+        /// The values finish_initialization() would have used for
+        /// the command.
+        const ParserData* data = nullptr;
+        ValueId start_id = {};
+        ArgumentId argument_id = {};
+        /// Set when the definition has been added to the command.
+        std::atomic<bool> defined = false;
+    };
+
+    struct CommandData
     {
-    public:
-        explicit TextWriter(unsigned line_width = 80);
+        CommandData();
 
-        [[nodiscard]] std::ostream* stream() const;
+        CommandData(const CommandData&);
 
-        void set_stream(std::ostream* stream);
+        CommandData(CommandData&&) noexcept;
 
-        [[nodiscard]] unsigned indentation() const;
+        ~CommandData();
 
-        bool set_indentation(unsigned indent);
+        CommandData& operator=(const CommandData&);
 
-        bool write(std::string_view str, bool force = false);
+        CommandData& operator=(CommandData&&) noexcept;
 
-        void newline();
+        void add(std::unique_ptr<ArgumentData> arg);
 
-        void flush();
+        void add(std::unique_ptr<OptionData> opt);
 
-        void tab();
+        void add(std::unique_ptr<CommandData> cmd);
 
-        [[nodiscard]] unsigned spaces() const;
+        /**
+         * @brief Adds a constraint, the first name is the argument or
+         *  option it applies to if @a type is DEPENDS_ON or
+         *  CONFLICTS_WITH.
+         */
+        void add_constraint(ConstraintType type,
+                            std::vector<std::string> names);
 
-        void set_spaces(unsigned n);
+        void copy_from(const CommandData& cmd);
 
-        [[nodiscard]] unsigned current_width() const;
+        /**
+         * @brief Completes the definition of a command with a lazy
+         *  definition, does nothing for other commands.
+         *
+         * The arguments, options and sub-commands of a lazily defined
+         * command are only available after this function has been
+         * called. It can safely be called from multiple threads.
+         */
+        void ensure_defined() const;
 
-        [[nodiscard]] unsigned remaining_width() const;
+        void build_option_index(bool case_insensitive);
 
-        [[nodiscard]] bool is_current_line_empty() const;
+        void build_command_index(bool case_insensitive);
 
-        [[nodiscard]] unsigned line_width() const;
+        /**
+         * @brief Builds the index returned by value_index(), the IDs of
+         *  the arguments and options must have been assigned.
+         */
+        void build_value_index();
 
-        void set_line_width(unsigned width);
+        /**
+         * @brief Builds the checker returned by constraint_checker(),
+         *  the value index must have been built.
+         */
+        void build_constraint_checker();
 
-        [[nodiscard]] std::string_view currentLine() const;
-    private:
-        std::ostream* m_stream;
-        std::string m_line;
-        unsigned m_line_width;
-        unsigned m_current_line_width = 0;
-        unsigned m_tab_size = 4;
-        unsigned m_indent = 0;
-        unsigned m_spaces = 0;
-    };
-}
+        /**
+         * @brief Returns the option with the given flag.
+         *
+         * Flags are compared case-insensitively if build_option_index()
+         * was called with case_insensitive set to true.
+         */
+        [[nodiscard]] const OptionData*
+        find_option(std::string_view flag,
+                    bool allow_abbreviations) const;
 
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-06.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
-#include <list>
+        /**
+         * @brief Returns the sub-command with the given name.
+         *
+         * Names are compared case-insensitively if build_command_index()
+         * was called with case_insensitive set to true.
+         */
+        [[nodiscard]] const CommandData*
+        find_command(std::string_view cmd_name,
+                     bool allow_abbreviations) const;
 
-namespace argos
-{
-    class WordSplitter
-    {
-    public:
-        void add_word(std::string word_rule);
+        /**
+         * @brief Returns the index of the command's values and
+         *  argument IDs.
+         */
+        [[nodiscard]] const ValueIndex& value_index() const;
 
-        void add_words(std::vector<std::string> word_rules);
+        /**
+         * @brief Returns the checker for the command's mandatory options
+         *  and constraints.
+         */
+        [[nodiscard]] const ConstraintChecker& constraint_checker() const;
+
+        /**
+         * @brief Adds the bindings of the arguments and options of this
+         *  command and its sub-commands to @a bindings.
+         *
+         * Lazily defined sub-commands that haven't been defined yet
+         * are skipped.
+         */
+        void collect_bindings(std::vector<ValueBinding*>& bindings) const;
+
+        std::vector<std::unique_ptr<ArgumentData>> arguments;
+        std::vector<std::unique_ptr<OptionData>> options;
+        std::vector<std::unique_ptr<CommandData>> commands;
+        std::vector<ConstraintData> constraints;
+        std::string current_section;
+
+        std::string name;
+        std::string full_name;
+        std::map<TextId, TextSource> texts;
+        Visibility visibility = Visibility::NORMAL;
+        std::optional<bool> require_subcommand;
+        bool multi_command = false;
+        /**
+         * The heading the command is listed under in the parent
+         * command's help.
+         */
+        std::string section;
+        int id = 0;
+        ArgumentId argument_id = {};
+        /**
+         * Identifies the command in the ValueHandles of its arguments
+         * and options. Copies of a command have the same handle_id.
+         */
+        unsigned handle_id;
+        std::unique_ptr<LazyDefinition> lazy_definition;
 
-        [[nodiscard]] std::tuple<std::string_view, char, std::string_view>
-        split(std::string_view word, size_t start_index, size_t max_length,
-              bool must_split) const;
     private:
-        static std::tuple<std::string_view, char, std::string_view>
-        default_rule(std::string_view word, size_t max_length) ;
+        /**
+         * @brief Moves the arguments, options and sub-commands of @a cmd
+         *  to this command.
+         */
+        void add_definition(CommandData&& cmd);
 
-        struct Split
-        {
-            unsigned index;
-            char separator;
-        };
-        std::map<std::string_view, std::vector<Split>> m_splits;
-        std::list<std::string> m_strings;
+        OptionTrie option_index;
+        CommandIndex command_index;
+        ValueIndex values;
+        ConstraintChecker checker;
     };
+
+    /**
+     * Finish the initialization of this command and any subcommands, and
+     * make them ready for parsing arguments.
+     */
+    void finish_initialization(CommandData& cmd,
+                               const ParserData& data,
+                               ValueId start_id = {},
+                               ArgumentId argument_id = {});
+
+    struct ParserSettings;
+
+    bool has_flag(const CommandData& cmd,
+                  std::string_view flag,
+                  const ParserSettings& settings);
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-05.
+// Created by Jan Erik Breimo on 2020-01-22.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-#include <climits>
 
 namespace argos
 {
-    class TextFormatter
+    class ArgumentCounter
     {
     public:
-        TextFormatter();
-
-        explicit TextFormatter(std::ostream* stream);
-
-        TextFormatter(std::ostream* stream, unsigned line_width);
-
-        WordSplitter& word_splitter();
-
-        [[nodiscard]] std::ostream* stream() const;
+        ArgumentCounter();
 
-        void set_stream(std::ostream* stream);
+        explicit ArgumentCounter(const CommandData& command);
 
-        [[nodiscard]] unsigned line_width() const;
+        ArgumentCounter(const CommandData& command,
+                        size_t argument_count,
+                        size_t initial_count = 0);
 
-        void set_line_width(unsigned line_width);
+        /**
+         * @brief Same as assigning ArgumentCounter(command), but reuses
+         *  the memory of the current counters.
+         */
+        void reset(const CommandData& command);
 
-        [[nodiscard]] unsigned current_line_width() const;
+        /**
+         * @brief Same as assigning ArgumentCounter(command,
+         *  argument_count, initial_count), but reuses the memory of the
+         *  current counters.
+         */
+        void reset(const CommandData& command,
+                   size_t argument_count,
+                   size_t initial_count = 0);
 
-        [[nodiscard]] bool is_current_line_empty() const;
+        /**
+         * @brief Removes all counters, but keeps their memory.
+         */
+        void clear();
 
-        static constexpr unsigned CURRENT_COLUMN = UINT_MAX;
+        const ArgumentData* next_argument();
 
-        void push_indentation(unsigned indent);
+        [[nodiscard]] size_t count() const;
 
-        void pop_indentation();
+        [[nodiscard]] bool is_complete() const;
 
-        void write_words(std::string_view text);
+        static std::pair<size_t, size_t>
+        get_min_max_count(const CommandData& command);
 
-        void write_lines(std::string_view text);
+        static bool requires_argument_count(const CommandData& command);
 
-        void newline();
+        /**
+         * @brief Returns the argument that receives the value at
+         *  @a ordinal if @a command receives @a argument_count values,
+         *  or nullptr if no argument receives it.
+         *
+         * The result for a given @a ordinal can only change from one
+         * argument to an earlier one as @a argument_count increases.
+         */
+        static const ArgumentData*
+        find_argument(const CommandData& command,
+                      size_t argument_count,
+                      size_t ordinal);
 
-        void flush();
     private:
-        void append_word(std::string_view word);
-
-        void begin_alignment();
-
-        void update_alignment(const std::string_view& token);
-
-        void end_alignment();
-
-        TextWriter m_writer;
-        std::vector<unsigned> m_indents;
-        WordSplitter m_word_splitter;
-        enum class State
-        {
-            NO_ALIGNMENT,
-            ALIGNMENT,
-            UNALIGNED_MARKER,
-            ALIGNED_MARKER
-        };
-        State m_state = State::NO_ALIGNMENT;
-    };
-}
+        using Counter = std::pair<size_t, const ArgumentData*>;
+        std::vector<Counter> m_counters;
+        size_t m_index = 0;
+        size_t m_first_optional = 0;
+        size_t m_counter = 0;
+    };
+}
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-13.
+// Created by Jan Erik Breimo on 2020-01-22.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
 
-#ifndef ARGOS_EX_USAGE
-    #ifdef EX_USAGE
-        #define ARGOS_EX_USAGE EX_USAGE
-    #else
-        #define ARGOS_EX_USAGE 64
-    #endif
-#endif
-
 namespace argos
 {
-    struct ParserSettings
+    namespace
     {
-        ArgumentCallback argument_callback;
-        OptionCallback option_callback;
-        OptionStyle option_style = OptionStyle::STANDARD;
-        bool auto_exit = true;
-        bool allow_abbreviated_options = false;
-        bool ignore_undefined_options = false;
-        bool ignore_undefined_arguments = false;
-        bool case_insensitive = false;
-        bool generate_help_option = true;
-        int normal_exit_code = 0;
-        int error_exit_code = ARGOS_EX_USAGE;
-    };
+        size_t find_first_optional(const CommandData& command)
+        {
+            auto& arguments = command.arguments;
+            size_t result = 0;
+            for (size_t i = 0; i < arguments.size(); ++i)
+            {
+                if (arguments[i]->min_count > 0)
+                    result = i + 1;
+            }
+            return result;
+        }
 
-    struct HelpSettings
+        void make_argument_counters(
+            const CommandData& command,
+            std::vector<std::pair<size_t, const ArgumentData*>>& counters,
+            size_t& first_optional)
+        {
+            first_optional = find_first_optional(command);
+            for (size_t i = 0; i < command.arguments.size(); ++i)
+            {
+                auto& a = command.arguments[i];
+                if (i + 1 == first_optional && a->min_count != a->max_count)
+                {
+                    counters.emplace_back(a->min_count, a.get());
+                    counters.emplace_back(a->max_count - a->min_count, a.get());
+                }
+                else
+                {
+                    counters.emplace_back(a->max_count, a.get());
+                }
+            }
+        }
+
+        void make_argument_counters(
+            const CommandData& command,
+            size_t n,
+            std::vector<std::pair<size_t, const ArgumentData*>>& counters)
+        {
+            const auto [lo, hi] = ArgumentCounter::get_min_max_count(command);
+            if (n < lo)
+                n = 0;
+            else if (n > hi)
+                n = hi - lo;
+            else
+                n -= lo;
+
+            for (auto& arg : command.arguments)
+            {
+                if (n == 0 || arg->min_count == arg->max_count)
+                {
+                    counters.emplace_back(arg->min_count, arg.get());
+                }
+                else if (arg->min_count + n <= arg->max_count)
+                {
+                    counters.emplace_back(arg->min_count + n, arg.get());
+                    n = 0;
+                }
+                else
+                {
+                    counters.emplace_back(arg->max_count, arg.get());
+                    n -= arg->max_count - arg->min_count;
+                }
+            }
+        }
+    }
+
+    ArgumentCounter::ArgumentCounter()
+        : m_counters()
     {
-        std::ostream* output_stream = nullptr;
-        unsigned line_width = 0;
-        std::vector<std::string> word_split_rules;
-    };
+    }
 
-    struct ParserData
+    ArgumentCounter::ArgumentCounter(const CommandData& command)
     {
-        CommandData command;
-        ParserSettings parser_settings;
-        HelpSettings help_settings;
-        std::string version;
-    };
+        reset(command);
+    }
 
-    void finish_initialization(ParserData& data);
-}
+    ArgumentCounter::ArgumentCounter(const CommandData& command,
+                                     size_t argument_count,
+                                     size_t initial_count)
+    {
+        reset(command, argument_count, initial_count);
+    }
 
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-18.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
-#include <optional>
-#include <span>
+    void ArgumentCounter::reset(const CommandData& command)
+    {
+        clear();
+        make_argument_counters(command, m_counters, m_first_optional);
+    }
 
-namespace argos
-{
-    class OptionIterator
+    void ArgumentCounter::reset(const CommandData& command,
+                                size_t argument_count,
+                                size_t initial_count)
     {
-    public:
-        OptionIterator();
+        clear();
+        make_argument_counters(command, argument_count, m_counters);
+        m_first_optional = m_counters.size();
 
-        explicit OptionIterator(std::vector<std::string_view> args,
-                                char prefix);
+        // Equivalent to calling next_argument() initial_count times, but
+        // without iterating over every single argument.
+        while (initial_count != 0)
+        {
+            while (m_index != m_counters.size() && m_counters[m_index].first == 0)
+                ++m_index;
 
-        OptionIterator(const OptionIterator& rhs);
+            if (m_index == m_counters.size())
+                break;
 
-        std::optional<std::string> next();
+            const auto n = std::min(initial_count, m_counters[m_index].first);
+            m_counters[m_index].first -= n;
+            m_counter += n;
+            initial_count -= n;
+        }
+    }
 
-        std::optional<std::string> next_value();
+    void ArgumentCounter::clear()
+    {
+        m_counters.clear();
+        m_index = 0;
+        m_first_optional = 0;
+        m_counter = 0;
+    }
 
-        [[nodiscard]] std::string_view current() const;
+    const ArgumentData* ArgumentCounter::next_argument()
+    {
+        while (m_index != m_counters.size() && m_counters[m_index].first == 0)
+            ++m_index;
 
-        [[nodiscard]] std::span<std::string> remaining_arguments() const;
+        if (m_index == m_counters.size())
+            return nullptr;
 
-        void insert(const std::vector<std::string>& args);
-    private:
-        std::vector<std::string> m_all_args;
-        std::span<std::string> m_args;
-        size_t m_pos = 0;
-        char m_prefix = '-';
-    };
+        ++m_counter;
+        --m_counters[m_index].first;
+        return m_counters[m_index].second;
+    }
+
+    size_t ArgumentCounter::count() const
+    {
+        return m_counter;
+    }
+
+    bool ArgumentCounter::is_complete() const
+    {
+        return m_index >= m_first_optional
+               || (m_index + 1 == m_first_optional
+                   && m_counters[m_index].first == 0);
+    }
+
+    std::pair<size_t, size_t>
+    ArgumentCounter::get_min_max_count(const CommandData& command)
+    {
+        size_t lo = 0, hi = 0;
+        for (auto& arg : command.arguments)
+        {
+            lo += arg->min_count;
+            if (hi != SIZE_MAX)
+            {
+                if (arg->max_count > SIZE_MAX - hi)
+                    hi = SIZE_MAX;
+                else
+                    hi += arg->max_count;
+            }
+        }
+        return {lo, hi};
+    }
+
+    bool ArgumentCounter::requires_argument_count(const CommandData& command)
+    {
+        bool deterministic = true;
+        for (auto& arg : command.arguments)
+        {
+            if (!deterministic)
+                return true;
+            if (arg->min_count != arg->max_count)
+                deterministic = false;
+        }
+        return false;
+    }
+
+    const ArgumentData*
+    ArgumentCounter::find_argument(const CommandData& command,
+                                   size_t argument_count,
+                                   size_t ordinal)
+    {
+        // Distributes the values the same way as make_argument_counters().
+        const auto [lo, hi] = get_min_max_count(command);
+        size_t n = 0;
+        if (argument_count > hi)
+            n = hi - lo;
+        else if (argument_count > lo)
+            n = argument_count - lo;
+
+        for (auto& arg : command.arguments)
+        {
+            size_t count = arg->min_count;
+            if (n != 0 && arg->min_count != arg->max_count)
+            {
+                const auto extra = std::min<size_t>(
+                    n, arg->max_count - arg->min_count);
+                count += extra;
+                n -= extra;
+            }
+            if (ordinal < count)
+                return arg.get();
+            ordinal -= count;
+        }
+        return nullptr;
+    }
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-09.
+// Created by Jan Erik Breimo on 2020-01-14.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -807,92 +1671,65 @@ namespace argos
 
 namespace argos
 {
-    class StandardOptionIterator
-    {
-    public:
-        StandardOptionIterator();
+    bool are_equal_ci(std::string_view str1, std::string_view str2);
 
-        explicit StandardOptionIterator(std::vector<std::string_view> args);
+    bool are_equal(std::string_view str1, std::string_view str2,
+                   bool case_insensitive);
 
-        StandardOptionIterator(const StandardOptionIterator& rhs);
+    bool starts_with(std::string_view str, std::string_view prefix);
 
-        std::optional<std::string> next();
+    bool starts_with_ci(std::string_view str, std::string_view prefix);
 
-        std::optional<std::string> next_value();
+    bool starts_with(std::string_view str, std::string_view prefix,
+                     bool case_insensitive);
 
-        [[nodiscard]] std::string_view current() const;
+    bool is_less_ci(std::string_view str1, std::string_view str2);
 
-        [[nodiscard]] std::span<std::string> remaining_arguments();
+    bool is_less(std::string_view str1, std::string_view str2,
+                 bool case_insensitive);
 
-        void insert(std::vector<std::string> args);
-    private:
-        void split_concatenated_flags();
+    std::vector<std::string_view>
+    split_string(std::string_view s, char delimiter, size_t max_split);
 
-        std::vector<std::string> m_all_args;
-        std::span<std::string> m_args;
-        size_t m_pos = 0;
-    };
-}
+    std::string_view get_base_name(std::string_view str);
 
-//****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-09-19.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
+    size_t count_code_points(std::string_view str);
 
-namespace argos
-{
-    struct OptionIteratorWrapper
-    {
-        std::optional<std::string> next()
-        {
-            if (std::holds_alternative<OptionIterator>(iterator))
-                return std::get<OptionIterator>(iterator).next();
-            else
-                return std::get<StandardOptionIterator>(iterator).next();
-        }
+    size_t find_nth_code_point(std::string_view str, size_t n);
 
-        std::optional<std::string> next_value()
-        {
-            if (std::holds_alternative<OptionIterator>(iterator))
-                return std::get<OptionIterator>(iterator).next_value();
-            else
-                return std::get<StandardOptionIterator>(iterator).next_value();
-        }
+    char to_lower(char c);
 
-        [[nodiscard]] std::string_view current() const
-        {
-            if (std::holds_alternative<OptionIterator>(iterator))
-                return std::get<OptionIterator>(iterator).current();
-            else
-                return std::get<StandardOptionIterator>(iterator).current();
-        }
+    void to_lower(std::string& word);
 
-        [[nodiscard]] std::span<std::string> remaining_arguments()
-        {
-            if (std::holds_alternative<OptionIterator>(iterator))
-                return std::get<OptionIterator>(iterator).remaining_arguments();
-            else
-                return std::get<StandardOptionIterator>(iterator).remaining_arguments();
-        }
+    std::string to_lower(std::string_view word);
 
-        void insert(const std::vector<std::string>& args)
-        {
-            if (std::holds_alternative<OptionIterator>(iterator))
-                std::get<OptionIterator>(iterator).insert(args);
-            else
-                std::get<StandardOptionIterator>(iterator).insert(args);
-        }
+    bool is_lower(std::string_view word);
 
-        std::variant<OptionIterator, StandardOptionIterator> iterator;
-    };
+    /**
+     * @brief Returns the 32-bit FNV-1a hash of @a str, or of @a str in
+     *  lower case if @a case_insensitive is true.
+     */
+    uint32_t hash_string(std::string_view str, bool case_insensitive = false);
+
+    /**
+     * @brief Returns true for the characters that isspace() accepts in
+     *  the "C" locale.
+     */
+    inline bool is_space(char c)
+    {
+        return c == ' ' || ('\t' <= c && c <= '\r');
+    }
+
+    template <typename T>
+    inline void pop_front(std::span<T>& span)
+    {
+        span = span.subspan(1);
+    }
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-07.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -900,275 +1737,356 @@ namespace argos
 
 namespace argos
 {
-    class ArgumentIteratorImpl;
+    ArgumentDictionary::ArgumentDictionary() = default;
 
-    class ParsedArgumentsImpl
+    ArgumentDictionary::ArgumentDictionary(
+            std::span<const std::pair<std::string_view, ArgumentId>> values,
+            char separator)
     {
-    public:
-        explicit ParsedArgumentsImpl(const CommandData* command,
-                                     std::shared_ptr<ParserData> data);
+        if (values.empty())
+            return;
 
-        [[nodiscard]] bool has(ValueId value_id) const;
+        m_entries.reserve(values.size());
+        init_hash_slots(m_table, values.size());
+        for (const auto& [value, _] : values)
+        {
+            const auto pos = value.find(separator);
+            const auto key = value.substr(0, pos);
+            const auto text = pos == std::string_view::npos
+                                  ? std::string_view()
+                                  : value.substr(pos + 1);
+            const auto h = hash_string(key);
+            if (const auto index = find(key, h))
+            {
+                m_entries[*index].second = text;
+                continue;
+            }
 
-        [[nodiscard]] const std::vector<std::string>& unprocessed_arguments() const;
+            insert_hash_slot(m_table, h, m_entries.size());
+            m_entries.emplace_back(key, text);
+        }
+    }
 
-        void add_unprocessed_argument(const std::string& arg);
+    size_t ArgumentDictionary::size() const
+    {
+        return m_entries.size();
+    }
 
-        std::string_view assign_value(ValueId value_id,
-                                      const std::string& value,
-                                      ArgumentId argument_id);
+    bool ArgumentDictionary::empty() const
+    {
+        return m_entries.empty();
+    }
 
-        std::string_view append_value(ValueId value_id,
-                                      const std::string& value,
-                                      ArgumentId argument_id);
+    std::optional<std::string_view>
+    ArgumentDictionary::lookup(std::string_view key) const
+    {
+        if (const auto index = find(key, hash_string(key)))
+            return m_entries[*index].second;
+        return {};
+    }
 
-        void clear_value(ValueId value_id);
+    bool ArgumentDictionary::contains(std::string_view key) const
+    {
+        return find(key, hash_string(key)).has_value();
+    }
 
-        [[nodiscard]] ValueId get_value_id(std::string_view value_name) const;
+    const std::vector<ArgumentDictionary::Entry>&
+    ArgumentDictionary::entries() const
+    {
+        return m_entries;
+    }
 
-        [[nodiscard]] std::optional<std::pair<std::string_view, ArgumentId>>
-        get_value(ValueId value_id) const;
+    ArgumentDictionary::const_iterator ArgumentDictionary::begin() const
+    {
+        return m_entries.begin();
+    }
 
-        [[nodiscard]] std::vector<std::pair<std::string_view, ArgumentId>>
-        get_values(ValueId value_id) const;
+    ArgumentDictionary::const_iterator ArgumentDictionary::end() const
+    {
+        return m_entries.end();
+    }
 
-        const std::shared_ptr<ParsedArgumentsImpl>&
-        add_subcommand(const CommandData* command);
+    std::optional<size_t>
+    ArgumentDictionary::find(std::string_view key, uint32_t hash) const
+    {
+        return find_hash_slot(m_table, hash, [&](size_t i)
+        {
+            return m_entries[i].first == key;
+        });
+    }
+}
 
-        const std::vector<std::shared_ptr<ParsedArgumentsImpl>>&
-        subcommands() const;
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-27.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <iosfwd>
 
-        [[nodiscard]] std::vector<std::unique_ptr<IArgumentView>>
-        get_argument_views(ValueId value_id) const;
+namespace argos
+{
+    class TextWriter
+    {
+    public:
+        explicit TextWriter(unsigned line_width = 80);
 
-        [[nodiscard]] std::unique_ptr<IArgumentView>
-        get_argument_view(ArgumentId argument_id) const;
+        [[nodiscard]] std::ostream* stream() const;
 
-        [[nodiscard]] const std::shared_ptr<ParserData>& parser_data() const;
+        void set_stream(std::ostream* stream);
 
-        [[nodiscard]] const CommandData* command() const;
+        [[nodiscard]] unsigned indentation() const;
 
-        [[nodiscard]] ParserResultCode result_code() const;
+        bool set_indentation(unsigned indent);
 
-        void set_result_code(ParserResultCode result_code);
+        bool write(std::string_view str, bool force = false);
 
-        [[nodiscard]] const OptionData* stop_option() const;
+        void newline();
 
-        void set_breaking_option(const OptionData* option);
+        void flush();
 
-        [[noreturn]]
-        void error(const std::string& message) const;
+        void tab();
 
-        [[noreturn]]
-        void error(const std::string& message, ArgumentId argument_id);
+        [[nodiscard]] unsigned spaces() const;
+
+        void set_spaces(unsigned n);
+
+        [[nodiscard]] unsigned current_width() const;
+
+        [[nodiscard]] unsigned remaining_width() const;
+
+        [[nodiscard]] bool is_current_line_empty() const;
+
+        [[nodiscard]] unsigned line_width() const;
+
+        void set_line_width(unsigned width);
 
+        [[nodiscard]] std::string_view currentLine() const;
     private:
-        /// The values received from ArgumentIteratorImpl.
-        std::multimap<ValueId, std::pair<std::string, ArgumentId>> m_values;
-        /// Index from flag, argument name or alias to ValueId and ArgumentId
-        std::vector<std::tuple<std::string_view, ValueId, ArgumentId>> m_ids;
-        std::vector<std::string> m_unprocessed_arguments;
-        const CommandData* m_command;
-        std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_commands;
-        std::shared_ptr<ParserData> m_data;
-        ParserResultCode m_result_code = ParserResultCode::NONE;
-        const OptionData* m_stop_option = nullptr;
+        std::ostream* m_stream;
+        std::string m_line;
+        unsigned m_line_width;
+        unsigned m_current_line_width = 0;
+        unsigned m_tab_size = 4;
+        unsigned m_indent = 0;
+        unsigned m_spaces = 0;
     };
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-07.
+// Created by Jan Erik Breimo on 2020-02-06.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <list>
 
 namespace argos
 {
-    enum class IteratorResultCode
+    class WordSplitter
     {
-        ARGUMENT,
-        OPTION,
-        COMMAND,
-        DONE,
-        UNKNOWN,
-        ERROR
-    };
+    public:
+        void add_word(std::string word_rule);
 
-    using IteratorResultData = std::variant<
-        std::monostate,
-        const ArgumentData*,
-        const OptionData*,
-        const CommandData*>;
+        void add_words(std::vector<std::string> word_rules);
 
-    using IteratorResult = std::tuple<
-        IteratorResultCode,
-        IteratorResultData,
-        std::string_view>;
+        [[nodiscard]] std::tuple<std::string_view, char, std::string_view>
+        split(std::string_view word, size_t start_index, size_t max_length,
+              bool must_split) const;
+    private:
+        static std::tuple<std::string_view, char, std::string_view>
+        default_rule(std::string_view word, size_t max_length) ;
 
-    class ArgumentIteratorImpl
+        struct Split
+        {
+            unsigned index;
+            char separator;
+        };
+        std::map<std::string_view, std::vector<Split>> m_splits;
+        std::list<std::string> m_strings;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-05.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <climits>
+
+namespace argos
+{
+    class TextFormatter
     {
     public:
-        ArgumentIteratorImpl(std::vector<std::string_view> args,
-                             std::shared_ptr<ParserData> data);
+        TextFormatter();
 
-        IteratorResult next();
+        explicit TextFormatter(std::ostream* stream);
 
-        static std::shared_ptr<ParsedArgumentsImpl>
-        parse(std::vector<std::string_view> args,
-              const std::shared_ptr<ParserData>& data);
+        TextFormatter(std::ostream* stream, unsigned line_width);
 
-        [[nodiscard]] const std::shared_ptr<ParsedArgumentsImpl>&
-        parsed_arguments() const;
+        WordSplitter& word_splitter();
 
-        [[nodiscard]] const std::shared_ptr<ParsedArgumentsImpl>&
-        toplevel_parsed_arguments() const;
+        [[nodiscard]] std::ostream* stream() const;
 
-    private:
-        enum class OptionResult
-        {
-            NORMAL,
-            LAST_ARGUMENT,
-            STOP,
-            EXIT,
-            ERROR
-        };
+        void set_stream(std::ostream* stream);
 
-        std::pair<OptionResult, std::string_view>
-        process_option(const OptionData& opt, const std::string& flag);
+        [[nodiscard]] unsigned line_width() const;
 
-        IteratorResult process_option(const std::string& flag);
+        void set_line_width(unsigned line_width);
 
-        IteratorResult process_argument(const std::string& value);
+        [[nodiscard]] unsigned current_line_width() const;
 
-        IteratorResult process_command(const CommandData* command);
+        [[nodiscard]] bool is_current_line_empty() const;
 
-        void copy_remaining_arguments_to_parser_result();
+        static constexpr unsigned CURRENT_COLUMN = UINT_MAX;
 
-        [[nodiscard]] size_t count_arguments() const;
+        void push_indentation(unsigned indent);
 
-        bool check_argument_and_option_counts();
+        void pop_indentation();
 
-        [[nodiscard]] std::pair<const CommandData*, size_t>
-        find_sibling_command(std::string_view name) const;
+        void write_words(std::string_view text);
 
-        [[nodiscard]]
-        std::optional<size_t> find_first_multi_command_parent() const;
+        void write_lines(std::string_view text);
 
-        void reactivate_multi_command_parent(size_t index);
+        void newline();
 
-        void update_arguments(const std::vector<std::string>& args);
+        void flush();
+    private:
+        void append_word(std::string_view word);
 
-        void error(const std::string& message = {});
+        void begin_alignment();
 
-        bool has_all_mandatory_options(const ParsedArgumentsImpl& parsed_args,
-                                       const CommandData& command);
+        void update_alignment(const std::string_view& token);
 
-        std::shared_ptr<ParserData> m_data;
-        const CommandData* m_command = nullptr;
-        std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_parsed_args;
-        OptionIteratorWrapper m_iterator;
-        ArgumentCounter m_argument_counter;
+        void end_alignment();
 
+        TextWriter m_writer;
+        std::vector<unsigned> m_indents;
+        WordSplitter m_word_splitter;
         enum class State
         {
-            ARGUMENTS_AND_OPTIONS,
-            ARGUMENTS_ONLY,
-            DONE,
-            ERROR
+            NO_ALIGNMENT,
+            ALIGNMENT,
+            UNALIGNED_MARKER,
+            ALIGNED_MARKER
         };
-
-        State m_state = State::ARGUMENTS_AND_OPTIONS;
+        State m_state = State::NO_ALIGNMENT;
     };
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-26.
+// Created by Jan Erik Breimo on 2020-01-13.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
 
+#ifndef ARGOS_EX_USAGE
+    #ifdef EX_USAGE
+        #define ARGOS_EX_USAGE EX_USAGE
+    #else
+        #define ARGOS_EX_USAGE 64
+    #endif
+#endif
+
 namespace argos
 {
-    ArgumentIterator::ArgumentIterator(std::vector<std::string_view> args,
-                                       std::shared_ptr<ParserData> parser_data)
-        : m_impl(std::make_unique<ArgumentIteratorImpl>(std::move(args),
-                                                        std::move(parser_data)))
-    {}
-
-    ArgumentIterator::ArgumentIterator(ArgumentIterator&& rhs) noexcept
-        : m_impl(std::move(rhs.m_impl))
-    {}
-
-    ArgumentIterator::~ArgumentIterator() = default;
-
-    ArgumentIterator&
-    ArgumentIterator::operator=(ArgumentIterator&& rhs) noexcept
+    struct ParserSettings
     {
-        m_impl = std::move(rhs.m_impl);
-        return *this;
-    }
+        ArgumentCallback argument_callback;
+        OptionCallback option_callback;
+        OptionStyle option_style = OptionStyle::STANDARD;
+        bool auto_exit = true;
+        bool allow_abbreviated_options = false;
+        bool allow_abbreviated_commands = false;
+        bool ignore_undefined_options = false;
+        bool ignore_undefined_arguments = false;
+        bool allow_response_files = false;
+        bool case_insensitive = false;
+        bool generate_help_option = true;
+        int normal_exit_code = 0;
+        int error_exit_code = ARGOS_EX_USAGE;
+    };
 
-    bool ArgumentIterator::next(std::unique_ptr<IArgumentView>& arg,
-                                std::string_view& value)
+    struct HelpSettings
     {
-        const auto res = impl().next();
-        switch (std::get<0>(res))
-        {
-        case IteratorResultCode::ARGUMENT:
-            arg = std::make_unique<ArgumentView>(
-                    std::get<const ArgumentData*>(std::get<1>(res)));
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::OPTION:
-            arg = std::make_unique<OptionView>(
-                    std::get<const OptionData*>(std::get<1>(res)));
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::COMMAND:
-            arg = std::make_unique<CommandView>(
-                    std::get<const CommandData*>(std::get<1>(res)));
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::UNKNOWN:
-            arg = {};
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::DONE:
-        case IteratorResultCode::ERROR:
-            break;
-        }
-        arg = {};
-        value = {};
-        return false;
-    }
+        std::ostream* output_stream = nullptr;
+        unsigned line_width = 0;
+        std::vector<std::string> word_split_rules;
+    };
 
-    ParsedArguments ArgumentIterator::parsed_arguments() const
+    /**
+     * @brief The variables that are bound to the arguments and options
+     *  of a parser.
+     *
+     * Lazily defined sub-commands add their bindings when they are
+     * defined, which can happen while the parser is in use.
+     */
+    class BindingList
     {
-        return ParsedArguments(impl().parsed_arguments());
-    }
+    public:
+        void assign(std::vector<ValueBinding*> bindings);
 
-    ArgumentIteratorImpl& ArgumentIterator::impl()
-    {
-        if (!m_impl)
-            ARGOS_THROW("This ArgumentIterator has been moved from.");
-        return *m_impl;
-    }
+        /**
+         * @brief Adds @a bindings to the list unless a batch is running.
+         *
+         * @return false if a batch is running and the bindings weren't
+         *  added.
+         */
+        [[nodiscard]] bool add(std::span<ValueBinding* const> bindings);
 
-    const ArgumentIteratorImpl& ArgumentIterator::impl() const
+        /**
+         * @brief Throws ArgosException if the list has any bindings,
+         *  otherwise makes add() refuse new ones until end_batch()
+         *  is called.
+         *
+         * Batches can overlap, add() accepts bindings again when every
+         * batch has ended.
+         */
+        void begin_batch() const;
+
+        void end_batch() const;
+
+        /**
+         * @brief Gives the variables back the values they had when they
+         *  were bound.
+         */
+        void reset() const;
+
+        [[nodiscard]] bool empty() const;
+
+    private:
+        std::vector<ValueBinding*> m_bindings;
+        std::atomic<bool> m_empty = true;
+        mutable size_t m_batches = 0;
+        mutable std::mutex m_mutex;
+    };
+
+    struct ParserData
     {
-        if (!m_impl)
-            ARGOS_THROW("This ArgumentIterator has been moved from.");
-        return *m_impl;
-    }
+        CommandData command;
+        ParserSettings parser_settings;
+        HelpSettings help_settings;
+        std::string version;
+        /**
+         * The bindings of all the arguments and options in command,
+         * they are collected by finish_initialization().
+         */
+        BindingList bindings;
+    };
+
+    void finish_initialization(ParserData& data);
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-21.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -1176,21 +2094,55 @@ namespace argos
 
 namespace argos
 {
-    void write_help_text(const ParserData& data, const CommandData& cmd);
+    /**
+     * @brief Stores the remaining arguments of an option iterator when
+     *  arguments have been inserted among them.
+     *
+     * The arguments are kept at the end of a buffer with a gap in
+     * front of them. Arguments are inserted at or next to the front,
+     * where the gap is, so inserting k arguments costs O(k) amortized
+     * regardless of how many arguments remain. The remaining arguments
+     * are still contiguous and are read through an ArgumentSource.
+     */
+    class ArgumentQueue
+    {
+    public:
+        ArgumentQueue();
 
-    void write_error_message(const ParserData& data,
-                             const CommandData& cmd,
-                             const std::string& msg);
+        /**
+         * @brief Creates a queue that holds @a args, and no gap.
+         */
+        explicit ArgumentQueue(std::vector<std::string_view> args);
 
-    void write_error_message(const ParserData& data,
-                             const CommandData& cmd,
-                             const std::string& msg,
-                             ArgumentId argument_id);
+        /**
+         * @brief Returns the arguments in the queue.
+         */
+        [[nodiscard]] ArgumentSource arguments() const;
+
+        /**
+         * @brief Inserts @a new_args in front of argument number @a pos
+         *  in @a remaining and returns the result.
+         *
+         * If the queue is empty, @a remaining is copied to the queue.
+         * Otherwise @a remaining must be the result of the previous
+         * call to arguments() or insert(), possibly with arguments
+         * removed from the front. The strings themselves are never
+         * copied.
+         */
+        ArgumentSource insert(ArgumentSource remaining, size_t pos,
+                              std::span<const std::string_view> new_args);
+    private:
+        /// The remaining arguments are the last m_size elements.
+        std::vector<std::string_view> m_buffer;
+        size_t m_size = 0;
+        /// True once the queue has received arguments.
+        bool m_is_used = false;
+    };
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-14.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -1198,1070 +2150,1179 @@ namespace argos
 
 namespace argos
 {
-    bool are_equal_ci(std::string_view str1, std::string_view str2);
+    /**
+     * @brief Stores strings in a small number of large blocks.
+     *
+     * Strings are never moved or freed individually, the string_views
+     * returned by add() remain valid until the arena is destroyed.
+     */
+    class StringArena
+    {
+    public:
+        /**
+         * @brief Makes sure that strings with a total size of at least
+         *  @a size can be added without allocating more memory.
+         */
+        void reserve(size_t size);
 
-    bool are_equal(std::string_view str1, std::string_view str2,
-                   bool case_insensitive);
+        std::string_view add(std::string_view str);
 
-    bool starts_with(std::string_view str, std::string_view prefix);
+        /**
+         * @brief Removes all strings, but keeps the largest block for
+         *  the strings that are added next.
+         *
+         * Invalidates all string_views returned by add().
+         */
+        void clear();
+    private:
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        char* m_next = nullptr;
+        size_t m_available = 0;
+        size_t m_block_size = 0;
+    };
+}
 
-    bool starts_with_ci(std::string_view str, std::string_view prefix);
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
 
-    bool starts_with(std::string_view str, std::string_view prefix,
-                     bool case_insensitive);
+namespace argos
+{
+    class OptionIterator
+    {
+    public:
+        OptionIterator();
 
-    bool is_less_ci(std::string_view str1, std::string_view str2);
+        explicit OptionIterator(std::vector<std::string_view> args,
+                                char prefix);
 
-    bool is_less(std::string_view str1, std::string_view str2,
-                 bool case_insensitive);
+        explicit OptionIterator(ArgumentSource args,
+                                char prefix);
 
-    std::vector<std::string_view>
-    split_string(std::string_view s, char delimiter, size_t max_split);
+        OptionIterator(const OptionIterator&) = delete;
 
-    std::string_view get_base_name(std::string_view str);
+        OptionIterator(OptionIterator&&) noexcept = default;
 
-    size_t count_code_points(std::string_view str);
+        OptionIterator& operator=(OptionIterator&&) noexcept = default;
 
-    size_t find_nth_code_point(std::string_view str, size_t n);
+        /**
+         * @brief Returns an iterator that reads the remaining arguments of
+         *  this iterator without copying them.
+         *
+         * The returned iterator is only valid as long as this iterator is
+         * not modified, and it must not be used to insert arguments.
+         */
+        [[nodiscard]] OptionIterator lookahead() const;
 
-    char to_lower(char c);
+        std::optional<std::string_view> next();
 
-    void to_lower(std::string& word);
+        std::optional<std::string_view> next_value();
 
-    std::string to_lower(std::string_view word);
+        [[nodiscard]] std::string_view current() const;
 
-    bool is_lower(std::string_view word);
+        /**
+         * @brief Returns the position of current() among the arguments
+         *  the iterator was created with, including the ones that have
+         *  been inserted before it.
+         */
+        [[nodiscard]] size_t index() const;
 
-    template <typename T>
-    inline void pop_front(std::span<T>& span)
-    {
-        span = span.subspan(1);
-    }
+        /**
+         * @brief Returns true if the next call to next() will return
+         *  a flag from the argument the previous call returned a flag
+         *  from.
+         */
+        [[nodiscard]] bool is_within_argument() const;
+
+        [[nodiscard]] ArgumentSource remaining_arguments() const;
+
+        void insert(const std::vector<std::string>& args);
+    private:
+        /**
+         * @brief Inserts @a args after the first @a pos remaining
+         *  arguments.
+         */
+        void insert_arguments(size_t pos,
+                              std::span<const std::string_view> args);
+
+        /// The remaining arguments. They are read directly from the
+        /// caller's memory until arguments are inserted, then from
+        /// m_queue.
+        ArgumentSource m_args;
+        ArgumentQueue m_queue;
+        /// The text of inserted arguments. Unlike a container of
+        /// strings, an empty arena doesn't allocate any memory.
+        StringArena m_strings;
+        size_t m_pos = 0;
+        /// The number of arguments that have been removed from m_args.
+        size_t m_index = 0;
+        char m_prefix = '-';
+    };
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-07.
+// Created by Jan Erik Breimo on 2020-01-09.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
 
-#include <algorithm>
-
 namespace argos
 {
-    namespace
+    class StandardOptionIterator
     {
-        bool is_option(const std::string& s, OptionStyle style)
-        {
-            if (s.size() < 2)
-                return false;
+    public:
+        StandardOptionIterator();
 
-            return s[0] == (style == OptionStyle::SLASH ? '/' : '-');
-        }
+        explicit StandardOptionIterator(std::vector<std::string_view> args);
 
-        std::variant<OptionIterator, StandardOptionIterator>
-        make_option_iterator(OptionStyle style,
-                             std::vector<std::string_view> args)
-        {
-            switch (style)
-            {
-            case OptionStyle::SLASH:
-                return OptionIterator(std::move(args), '/');
-            case OptionStyle::DASH:
-                return OptionIterator(std::move(args), '-');
-            default:
-                return StandardOptionIterator(std::move(args));
-            }
-        }
-    }
+        explicit StandardOptionIterator(ArgumentSource args);
 
-    ArgumentIteratorImpl::ArgumentIteratorImpl(std::vector<std::string_view> args,
-                                               std::shared_ptr<ParserData> data)
-        : m_data(std::move(data)),
-          m_command(&m_data->command),
-          m_parsed_args{std::make_shared<ParsedArgumentsImpl>(m_command, m_data)},
-          m_iterator{
-              make_option_iterator(m_data->parser_settings.option_style,
-                                   std::move(args))
-          }
-    {
-        auto& parsed_args = *parsed_arguments();
-        for (const auto& option : m_command->options)
-        {
-            if (!option->initial_value.empty())
-            {
-                parsed_args.append_value(option->value_id,
-                                         option->initial_value,
-                                         option->argument_id);
-            }
-        }
+        StandardOptionIterator(const StandardOptionIterator&) = delete;
 
-        if (!ArgumentCounter::requires_argument_count(*m_command))
-        {
-            m_argument_counter = ArgumentCounter(*m_command);
-        }
-        else
-        {
-            m_argument_counter = ArgumentCounter(*m_command,
-                                                 count_arguments());
-        }
-    }
+        StandardOptionIterator(StandardOptionIterator&&) noexcept = default;
 
-    std::shared_ptr<ParsedArgumentsImpl>
-    ArgumentIteratorImpl::parse(std::vector<std::string_view> args,
-                                const std::shared_ptr<ParserData>& data)
-    {
-        ArgumentIteratorImpl iterator(std::move(args), data);
-        while (true)
-        {
-            const auto code = std::get<0>(iterator.next());
-            if (code == IteratorResultCode::ERROR
-                || code == IteratorResultCode::DONE)
-            {
-                break;
-            }
-        }
-        return iterator.toplevel_parsed_arguments();
-    }
+        StandardOptionIterator& operator=(StandardOptionIterator&&) noexcept = default;
 
-    IteratorResult ArgumentIteratorImpl::next()
-    {
-        if (m_state == State::ERROR)
-            ARGOS_THROW("next() called after error.");
-        if (m_state == State::DONE)
-            return {IteratorResultCode::DONE, {}, {}};
+        /**
+         * @brief Returns an iterator that reads the remaining arguments of
+         *  this iterator without copying them.
+         *
+         * The returned iterator is only valid as long as this iterator is
+         * not modified, and it must not be used to insert arguments.
+         */
+        [[nodiscard]] StandardOptionIterator lookahead() const;
 
-        const auto arg = m_state == State::ARGUMENTS_AND_OPTIONS
-                             ? m_iterator.next()
-                             : m_iterator.next_value();
-        if (!arg)
-        {
-            if (check_argument_and_option_counts())
-                return {IteratorResultCode::DONE, {}, {}};
-            else
-                return {IteratorResultCode::ERROR, {}, {}};
-        }
+        std::optional<std::string_view> next();
 
-        if (m_state == State::ARGUMENTS_AND_OPTIONS
-            && is_option(*arg, m_data->parser_settings.option_style))
-        {
-            return process_option(*arg);
-        }
-        else if (m_command->commands.empty())
-        {
-            return process_argument(*arg);
-        }
-        else if (auto cmd = m_command->find_command(
-            *arg, m_data->parser_settings.case_insensitive))
-        {
-            return process_command(cmd);
-        }
-        else
-        {
-            error("Unknown command: " + std::string(*arg));
-            return {IteratorResultCode::ERROR, {}, {}};
-        }
-    }
+        std::optional<std::string_view> next_value();
 
-    const std::shared_ptr<ParsedArgumentsImpl>&
-    ArgumentIteratorImpl::parsed_arguments() const
-    {
-        return m_parsed_args.back();
-    }
+        [[nodiscard]] std::string_view current() const;
 
-    const std::shared_ptr<ParsedArgumentsImpl>&
-    ArgumentIteratorImpl::toplevel_parsed_arguments() const
-    {
-        return m_parsed_args.front();
-    }
+        /**
+         * @brief Returns the position of current() among the arguments
+         *  the iterator was created with, including the ones that have
+         *  been inserted before it.
+         */
+        [[nodiscard]] size_t index() const;
 
-    std::pair<ArgumentIteratorImpl::OptionResult, std::string_view>
-    ArgumentIteratorImpl::process_option(const OptionData& opt,
-                                         const std::string& flag)
+        /**
+         * @brief Returns true if the next call to next() will return
+         *  a flag from the argument the previous call returned a flag
+         *  from.
+         */
+        [[nodiscard]] bool is_within_argument() const;
+
+        [[nodiscard]] ArgumentSource remaining_arguments();
+
+        void insert(const std::vector<std::string>& args);
+    private:
+        void split_concatenated_flags();
+
+        /**
+         * @brief Inserts @a args after the first @a pos remaining
+         *  arguments.
+         */
+        void insert_arguments(size_t pos,
+                              std::span<const std::string_view> args);
+
+        /// The remaining arguments. They are read directly from the
+        /// caller's memory until arguments are inserted, then from
+        /// m_queue.
+        ArgumentSource m_args;
+        ArgumentQueue m_queue;
+        /// The text of inserted arguments. Unlike a container of
+        /// strings, an empty arena doesn't allocate any memory.
+        StringArena m_strings;
+        size_t m_pos = 0;
+        /// The number of arguments that have been removed from m_args.
+        size_t m_index = 0;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-09-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    struct OptionIteratorWrapper
     {
-        const auto& parsed_args = parsed_arguments();
-        std::string_view arg;
-        switch (opt.operation)
+        std::optional<std::string_view> next()
         {
-        case OptionOperation::ASSIGN:
-            if (!opt.constant.empty())
-            {
-                parsed_args->assign_value(opt.value_id, opt.constant,
-                                          opt.argument_id);
-            }
-            else if (const auto value = m_iterator.next_value())
-            {
-                arg = parsed_args->assign_value(opt.value_id, *value,
-                                                opt.argument_id);
-            }
-            else
-            {
-                error(flag + ": no value given.");
-                return {OptionResult::ERROR, {}};
-            }
-            break;
-        case OptionOperation::APPEND:
-            if (!opt.constant.empty())
-            {
-                parsed_args->append_value(opt.value_id, opt.constant,
-                                          opt.argument_id);
-            }
-            else if (const auto value = m_iterator.next_value())
-            {
-                arg = parsed_args->append_value(opt.value_id, *value,
-                                                opt.argument_id);
-            }
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).next();
             else
-            {
-                error(flag + ": no value given.");
-                return {OptionResult::ERROR, {}};
-            }
-            break;
-        case OptionOperation::CLEAR:
-            parsed_args->clear_value(opt.value_id);
-            break;
-        case OptionOperation::NONE:
-            break;
+                return std::get<StandardOptionIterator>(iterator).next();
         }
 
-        if (opt.callback)
-        {
-            CallbackArguments args(OptionView(&opt), arg, parsed_args);
-            opt.callback(args);
-            update_arguments(args.new_arguments);
-        }
-        if (m_data->parser_settings.option_callback)
+        std::optional<std::string_view> next_value()
         {
-            CallbackArguments args(OptionView(&opt), arg, parsed_args);
-            m_data->parser_settings.option_callback(args);
-            update_arguments(args.new_arguments);
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).next_value();
+            else
+                return std::get<StandardOptionIterator>(iterator).next_value();
         }
 
-        switch (opt.type)
+        [[nodiscard]] std::string_view current() const
         {
-        case OptionType::NORMAL:
-            return {OptionResult::NORMAL, arg};
-        case OptionType::HELP:
-            write_help_text(*m_data, *m_command);
-            [[fallthrough]];
-        case OptionType::EXIT:
-            m_state = State::DONE;
-            parsed_args->set_breaking_option(&opt);
-            return {OptionResult::EXIT, arg};
-        case OptionType::STOP:
-            m_state = State::DONE;
-            parsed_args->set_breaking_option(&opt);
-            return {OptionResult::STOP, arg};
-        case OptionType::LAST_ARGUMENT:
-            m_state = State::DONE;
-            return {OptionResult::LAST_ARGUMENT, arg};
-        case OptionType::LAST_OPTION:
-            m_state = State::ARGUMENTS_ONLY;
-            return {OptionResult::NORMAL, arg};
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).current();
+            else
+                return std::get<StandardOptionIterator>(iterator).current();
         }
-        return {};
-    }
 
-    IteratorResult
-    ArgumentIteratorImpl::process_option(const std::string& flag)
-    {
-        auto option = m_command->find_option(
-            flag,
-            m_data->parser_settings.allow_abbreviated_options,
-            m_data->parser_settings.case_insensitive);
-        if (option)
+        [[nodiscard]] size_t index() const
         {
-            auto [res, arg] = process_option(*option, flag);
-            switch (res)
-            {
-            case OptionResult::EXIT:
-                if (m_data->parser_settings.auto_exit)
-                    exit(m_data->parser_settings.normal_exit_code);
-                copy_remaining_arguments_to_parser_result();
-                return {IteratorResultCode::OPTION, option, arg};
-            case OptionResult::ERROR:
-                return {IteratorResultCode::ERROR, option, {}};
-            case OptionResult::LAST_ARGUMENT:
-                if (!check_argument_and_option_counts())
-                    return {IteratorResultCode::ERROR, {}, {}};
-
-                if (auto index = find_first_multi_command_parent())
-                {
-                    reactivate_multi_command_parent(*index);
-                    return {IteratorResultCode::OPTION, option, arg};
-                }
-
-                [[fallthrough]];
-            case OptionResult::STOP:
-                copy_remaining_arguments_to_parser_result();
-                [[fallthrough]];
-            default:
-                return {IteratorResultCode::OPTION, option, arg};
-            }
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).index();
+            else
+                return std::get<StandardOptionIterator>(iterator).index();
         }
-        if (!m_data->parser_settings.ignore_undefined_options
-            || !starts_with(m_iterator.current(), flag))
+
+        [[nodiscard]] bool is_within_argument() const
         {
-            error("Unknown option: " + std::string(m_iterator.current()));
-            return {IteratorResultCode::ERROR, {}, {}};
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).is_within_argument();
+            else
+                return std::get<StandardOptionIterator>(iterator).is_within_argument();
         }
-        else
+
+        [[nodiscard]] ArgumentSource remaining_arguments()
         {
-            parsed_arguments()->add_unprocessed_argument(
-                std::string(m_iterator.current()));
-            return {IteratorResultCode::UNKNOWN, {}, m_iterator.current()};
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).remaining_arguments();
+            else
+                return std::get<StandardOptionIterator>(iterator).remaining_arguments();
         }
-    }
 
-    IteratorResult
-    ArgumentIteratorImpl::process_argument(const std::string& value)
-    {
-        const auto& parsed_args = parsed_arguments();
-        if (auto [next_cmd, i] = find_sibling_command(value); next_cmd)
+        [[nodiscard]] OptionIteratorWrapper lookahead() const
         {
-            reactivate_multi_command_parent(i);
-            return process_command(next_cmd);
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return {std::get<OptionIterator>(iterator).lookahead()};
+            else
+                return {std::get<StandardOptionIterator>(iterator).lookahead()};
         }
-        if (auto argument = m_argument_counter.next_argument())
-        {
-            auto s = parsed_args->append_value(argument->value_id, value,
-                                               argument->argument_id);
-            if (argument->callback)
-            {
-                CallbackArguments args(ArgumentView(argument), s, parsed_args);
-                argument->callback(args);
-                update_arguments(args.new_arguments);
-            }
 
-            if (m_data->parser_settings.argument_callback)
-            {
-                CallbackArguments args(ArgumentView(argument), s, parsed_args);
-                m_data->parser_settings.argument_callback(args);
-                update_arguments(args.new_arguments);
-            }
-            return {IteratorResultCode::ARGUMENT, argument, s};
-        }
-        if (m_data->parser_settings.ignore_undefined_arguments)
+        void insert(const std::vector<std::string>& args)
         {
-            parsed_args->add_unprocessed_argument(value);
-            return {IteratorResultCode::UNKNOWN, {}, m_iterator.current()};
+            if (std::holds_alternative<OptionIterator>(iterator))
+                std::get<OptionIterator>(iterator).insert(args);
+            else
+                std::get<StandardOptionIterator>(iterator).insert(args);
         }
 
-        error("Too many arguments, starting from \"" + value + "\".");
-        return {IteratorResultCode::ERROR, {}, {}};
-    }
+        std::variant<OptionIterator, StandardOptionIterator> iterator;
+    };
+}
 
-    IteratorResult
-    ArgumentIteratorImpl::process_command(const CommandData* command)
-    {
-        m_parsed_args.push_back(parsed_arguments()->add_subcommand(command));
-        m_command = command;
-        if (!ArgumentCounter::requires_argument_count(*m_command))
-        {
-            m_argument_counter = ArgumentCounter(*m_command);
-        }
-        else
-        {
-            m_argument_counter = ArgumentCounter(*m_command,
-                                                 count_arguments());
-        }
-        m_state = State::ARGUMENTS_AND_OPTIONS;
-        return {IteratorResultCode::COMMAND, command, m_iterator.current()};
-    }
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-07.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
 
-    // ReSharper disable once CppMemberFunctionMayBeConst
-    void ArgumentIteratorImpl::copy_remaining_arguments_to_parser_result()
-    {
-        auto& parsed_args = *parsed_arguments();
-        for (auto str : m_iterator.remaining_arguments())
-            parsed_args.add_unprocessed_argument(std::string(str));
-    }
+namespace argos
+{
+    class ArgumentIteratorImpl;
+    class ChoiceSet;
+    class ValueBinding;
+    struct IteratorBuffers;
 
-    size_t ArgumentIteratorImpl::count_arguments() const
+    class ParsedArgumentsImpl
     {
-        size_t result = 0;
-        auto it = m_iterator;
-        auto [min_count, _] = ArgumentCounter::get_min_max_count(*m_command);
-        for (auto arg = it.next(); arg; arg = it.next())
-        {
-            const OptionData* option = m_command->find_option(
-                *arg,
-                m_data->parser_settings.allow_abbreviated_options,
-                m_data->parser_settings.case_insensitive);
+    public:
+        explicit ParsedArgumentsImpl(const CommandData* command,
+                                     std::shared_ptr<const ParserData> data,
+                                     std::shared_ptr<StringArena> arena = {});
 
-            if (option)
-            {
-                if (!option->argument.empty())
-                    it.next_value();
+        ParsedArgumentsImpl(const ParsedArgumentsImpl&) = delete;
 
-                bool arguments_only = false;
+        ~ParsedArgumentsImpl();
 
-                switch (option->type)
-                {
-                case OptionType::HELP:
-                case OptionType::LAST_ARGUMENT:
-                case OptionType::STOP:
-                    return result;
-                case OptionType::LAST_OPTION:
-                    arguments_only = true;
-                    break;
-                default:
-                    break;
-                }
+        ParsedArgumentsImpl& operator=(const ParsedArgumentsImpl&) = delete;
 
-                if (arguments_only)
-                    break;
-            }
-            else if (!is_option(*arg, m_data->parser_settings.option_style))
-            {
-                if (m_command->find_command(*arg, m_data->parser_settings.case_insensitive))
-                    return result;
+        /**
+         * @brief Returns true if the parsed arguments of any of the
+         *  sub-commands are referenced by other objects than their
+         *  parent, i.e. if clear() would invalidate values that are
+         *  still in use.
+         */
+        [[nodiscard]] bool has_shared_subcommands() const;
 
-                if (result >= min_count && find_sibling_command(*arg).first)
-                    return result;
+        /**
+         * @brief Removes all values, sub-commands and unprocessed
+         *  arguments, but keeps the memory for the next parse.
+         *
+         * The sub-commands are kept as well, add_subcommand() reuses
+         * them. Invalidates all string_views to the values. Must not
+         * be called if has_shared_subcommands() returns true.
+         */
+        void clear();
 
-                ++result;
-            }
-        }
+        /**
+         * @brief Reserves room for @a value_count values with a total
+         *  length of @a text_size.
+         */
+        void reserve(size_t value_count, size_t text_size);
 
-        for (auto arg = it.next_value(); arg; arg = it.next_value())
-        {
-            if (m_command->find_command(*arg, m_data->parser_settings.case_insensitive))
-                return result;
+        /**
+         * @brief Gives the options their initial values.
+         *
+         * The initial values are not copied, the values are read from
+         * the command's ValueIndex until they are assigned, appended
+         * to or cleared.
+         */
+        void add_initial_values();
 
-            if (result >= min_count && find_sibling_command(*arg).first)
-                return result;
+        [[nodiscard]] bool has(ValueId value_id) const;
 
-            ++result;
-        }
-        return result;
-    }
+        /**
+         * @brief Returns the values that have at least one value, by
+         *  position in the command (value_id - first ValueId).
+         */
+        [[nodiscard]] const BitSet& nonempty_values() const;
 
-    bool ArgumentIteratorImpl::check_argument_and_option_counts()
-    {
-        auto& parsed_args = *parsed_arguments();
-        if (!has_all_mandatory_options(parsed_args, *m_command))
-            return false;
+        /**
+         * @brief Marks the argument or option with @a argument_id as
+         *  given on the command line.
+         */
+        void set_given(ArgumentId argument_id);
 
-        if (*m_command->require_subcommand && parsed_args.subcommands().empty())
-        {
-            error("No command was given.");
-            return false;
-        }
+        /**
+         * @brief Returns the arguments and options that were given on
+         *  the command line, by position in the command
+         *  (argument_id - first ArgumentId).
+         */
+        [[nodiscard]] const BitSet& given_arguments() const;
 
-        if (m_argument_counter.is_complete())
-        {
-            m_state = State::DONE;
-            for (const auto& pa : m_parsed_args)
-                pa->set_result_code(ParserResultCode::SUCCESS);
-            return true;
-        }
-        else
-        {
-            auto [lo, hi] = ArgumentCounter::get_min_max_count(*m_command);
-            error((lo == hi
-                       ? "Too few arguments. Expected "
-                       : "Too few arguments. Expected at least ")
-                  + std::to_string(lo) + ", received "
-                  + std::to_string(m_argument_counter.count()) + ".");
-            return false;
-        }
-    }
+        [[nodiscard]] const std::vector<std::string>& unprocessed_arguments() const;
 
-    std::optional<size_t>
-    ArgumentIteratorImpl::find_first_multi_command_parent() const
-    {
-        auto size = m_parsed_args.size();
-        if (size <= 1)
-            return {};
+        void add_unprocessed_argument(std::string_view arg);
 
-        for (size_t i = size - 1; i-- > 0;)
-        {
-            const auto& parent = *m_parsed_args[i]->command();
-            if (parent.multi_command)
-                return i;
-        }
+        /**
+         * @brief Replaces the current values of @a value_id with
+         *  @a value.
+         *
+         * Returns the stored copy of @a value, or nothing if @a value
+         * isn't valid, see is_valid_value(). Nothing is changed in
+         * that case. If the value is bound to a variable,
+         * @a value itself is returned.
+         */
+        std::optional<std::string_view> assign_value(ValueId value_id,
+                                                     std::string_view value,
+                                                     ArgumentId argument_id);
 
-        return {};
-    }
+        /**
+         * @brief Adds @a value to the values of @a value_id.
+         *
+         * Returns the stored copy of @a value, or nothing if @a value
+         * isn't valid, see is_valid_value().
+         */
+        std::optional<std::string_view> append_value(ValueId value_id,
+                                                     std::string_view value,
+                                                     ArgumentId argument_id);
 
-    std::pair<const CommandData*, size_t>
-    ArgumentIteratorImpl::find_sibling_command(std::string_view name) const
-    {
-        if (!m_argument_counter.is_complete())
-            return {nullptr, 0};
+        void clear_value(ValueId value_id);
 
-        if (auto index = find_first_multi_command_parent())
-        {
-            return {
-                m_parsed_args[*index]->command()->find_command(
-                    name, m_data->parser_settings.case_insensitive),
-                *index
-            };
-        }
+        [[nodiscard]] ValueId get_value_id(std::string_view value_name) const;
 
-        return {nullptr, 0};
-    }
+        /**
+         * @brief Returns the choices of @a value_id, or nullptr if it
+         *  doesn't have any.
+         */
+        [[nodiscard]] const ChoiceSet* get_choices(ValueId value_id) const;
 
-    void ArgumentIteratorImpl::reactivate_multi_command_parent(size_t index)
-    {
-        m_parsed_args.resize(index + 1);
-        m_command = m_parsed_args.back()->command();
-        m_argument_counter = {};
-        m_state = State::ARGUMENTS_ONLY;
-    }
+        /**
+         * @brief Returns the ValueId and ArgumentId of the argument or
+         *  option @a handle refers to.
+         */
+        [[nodiscard]] std::pair<ValueId, ArgumentId>
+        get_ids(ValueHandle handle) const;
 
-    void ArgumentIteratorImpl::update_arguments(
-        const std::vector<std::string>& args)
-    {
-        if (args.empty())
-            return;
+        [[nodiscard]] std::optional<std::pair<std::string_view, ArgumentId>>
+        get_value(ValueId value_id) const;
 
-        m_iterator.insert(args);
-        if (!ArgumentCounter::requires_argument_count(*m_command))
-            return;
+        [[nodiscard]] std::span<const std::pair<std::string_view, ArgumentId>>
+        get_values(ValueId value_id) const;
 
-        auto current_count = m_argument_counter.count();
-        auto total_count = current_count + count_arguments();
-        m_argument_counter = ArgumentCounter(*m_command, total_count,
-                                             current_count);
-    }
+        /**
+         * @brief Returns the ArgumentValue for @a value_id in @a args.
+         *
+         * The value's argument ID is used unless @a argument_id is
+         * given. The value carries its converted value if it has a
+         * ValueType.
+         */
+        [[nodiscard]] static ArgumentValue
+        make_value(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                   ValueId value_id,
+                   std::optional<ArgumentId> argument_id = {});
 
-    void ArgumentIteratorImpl::error(const std::string& message)
-    {
-        if (!message.empty())
-            write_error_message(*m_data, *m_command, message);
+        /**
+         * @brief Returns the ArgumentValues for @a value_id in @a args.
+         */
+        [[nodiscard]] static ArgumentValues
+        make_values(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                    ValueId value_id);
 
-        if (m_data->parser_settings.auto_exit)
-            exit(m_data->parser_settings.error_exit_code);
+        /**
+         * @brief Returns the data for a ValuesView of the values of
+         *  @a value_id.
+         *
+         * The view refers to the values in this object, compact()
+         * must have been called if several threads use the values.
+         */
+        [[nodiscard]] ValuesViewData make_view(ValueId value_id) const;
 
-        copy_remaining_arguments_to_parser_result();
-        for (const auto& parsed_args : m_parsed_args)
-            parsed_args->set_result_code(ParserResultCode::FAILURE);
-        m_state = State::ERROR;
-    }
+        /**
+         * @brief Returns the values of @a value_id as key/value pairs.
+         *
+         * The separator is the one given to Option::dictionary(), or
+         * '=' if the value doesn't have one.
+         */
+        [[nodiscard]] ArgumentDictionary make_dictionary(ValueId value_id) const;
 
-    bool ArgumentIteratorImpl::has_all_mandatory_options(
-        const ParsedArgumentsImpl& parsed_args,
-        const CommandData& command)
-    {
-        for (const auto& o : command.options)
+        /**
+         * @brief Groups the values of this command and its sub-commands
+         *  by ValueId.
+         *
+         * get_values() does this on demand, calling compact() when
+         * parsing is complete ensures that the const member functions
+         * can be called concurrently.
+         */
+        void compact();
+
+        const std::shared_ptr<ParsedArgumentsImpl>&
+        add_subcommand(const CommandData* command);
+
+        const std::vector<std::shared_ptr<ParsedArgumentsImpl>>&
+        subcommands() const;
+
+        [[nodiscard]] std::vector<std::unique_ptr<IArgumentView>>
+        get_argument_views(ValueId value_id) const;
+
+        [[nodiscard]] std::unique_ptr<IArgumentView>
+        get_argument_view(ArgumentId argument_id) const;
+
+        [[nodiscard]] const std::shared_ptr<const ParserData>& parser_data() const;
+
+        [[nodiscard]] const CommandData* command() const;
+
+        [[nodiscard]] ParserResultCode result_code() const;
+
+        void set_result_code(ParserResultCode result_code);
+
+        [[nodiscard]] const OptionData* stop_option() const;
+
+        void set_breaking_option(const OptionData* option);
+
+        /**
+         * @brief Returns true if errors must be reported with
+         *  exceptions rather than written to the output stream.
+         */
+        [[nodiscard]] bool silent() const;
+
+        /**
+         * @brief Makes error() store the error message and throw an
+         *  ArgosException instead of writing it to the output stream and
+         *  exiting. The setting applies to the current sub-commands,
+         *  and sub-commands added later inherit it.
+         */
+        void set_silent(bool silent);
+
+        /**
+         * @brief Returns the message and argument of the last error()
+         *  in silent mode, if there was one.
+         */
+        [[nodiscard]] const std::optional<std::pair<std::string, ArgumentId>>&
+        silent_error() const;
+
+        /**
+         * @brief Returns the buffers ArgumentIteratorImpl uses when
+         *  this is the top-level command, they are created on demand.
+         */
+        IteratorBuffers& iterator_buffers();
+
+        [[noreturn]]
+        void error(const std::string& message) const;
+
+        [[noreturn]]
+        void error(const std::string& message, ArgumentId argument_id) const;
+
+    private:
+        [[noreturn]]
+        void throw_silent_error(const std::string& message,
+                                ArgumentId argument_id) const;
+
+        struct ValueEntry
         {
-            if (!o->optional && !parsed_args.has(o->value_id))
-            {
-                auto flags = o->flags.front();
-                for (unsigned i = 1; i < o->flags.size(); ++i)
-                    flags += ", " + o->flags[i];
-                error("Mandatory option is missing: " + flags);
-                return false;
-            }
-        }
+            ValueId value_id;
+            ArgumentId argument_id;
+            std::string_view value;
+            TypedValue typed_value;
+        };
 
-        return true;
-    }
+        struct ValueSlot
+        {
+            /// Index of the first live entry in m_entries.
+            size_t first = 0;
+            size_t count = 0;
+            /// The values are converted to this type when they are added.
+            ValueType type = ValueType::STRING;
+            /// If set, the values are written to the binding instead of
+            /// m_entries, and count is only the number of values.
+            ValueBinding* binding = nullptr;
+            /// If set, the values must be among these.
+            const ChoiceSet* choices = nullptr;
+            /// If non-zero, the values must contain this character.
+            char dictionary_separator = '\0';
+            /// If true, the values are the initial values in the
+            /// command's ValueIndex rather than entries in m_entries.
+            bool is_initial = false;
+        };
+
+        /**
+         * @brief Returns true if @a value can be converted to the
+         *  slot's ValueType, is among its choices and contains its
+         *  dictionary separator.
+         */
+        static bool is_valid_value(const ValueSlot& slot,
+                                   std::string_view value,
+                                   TypedValue& typed_value);
+
+        std::string_view add_entry(ValueSlot& slot,
+                                   ValueId value_id,
+                                   std::string_view value,
+                                   ArgumentId argument_id,
+                                   TypedValue typed_value);
+
+        /**
+         * @brief Copies the views of the initial values in @a slot to
+         *  m_entries so that more values can be added after them.
+         */
+        void copy_initial_values(ValueSlot& slot, ValueId value_id);
+
+        ValueSlot* find_slot(ValueId value_id);
+
+        [[nodiscard]] const ValueSlot* find_slot(ValueId value_id) const;
+
+        ValueSlot& get_slot(ValueId value_id);
+
+        void do_compact() const;
+
+        /// The values received from ArgumentIteratorImpl in the order
+        /// they were received. Entries that precede their slot's first
+        /// index have been overwritten or cleared.
+        std::vector<ValueEntry> m_entries;
+        /// One slot per ValueId in this command, indexed by
+        /// value_id - m_first_value_id.
+        std::vector<ValueSlot> m_slots;
+        ValueId m_first_value_id = {};
+        /// Bit i is set if slot i has at least one value.
+        BitSet m_nonempty_values;
+        /// Bit i is set if the argument or option with ArgumentId
+        /// m_first_argument_id + i has been given.
+        BitSet m_given_arguments;
+        ArgumentId m_first_argument_id = {};
+        /// The live values from m_entries grouped by ValueId, the values
+        /// for slot i are in [m_offsets[i], m_offsets[i + 1]).
+        mutable std::vector<std::pair<std::string_view, ArgumentId>> m_values;
+        /// The converted values, parallel to m_values.
+        mutable std::vector<TypedValue> m_typed_values;
+        mutable std::vector<size_t> m_offsets;
+        mutable bool m_is_compact = true;
+        /// Owns the text of the values, shared with the sub-commands.
+        std::shared_ptr<StringArena> m_arena;
+        std::vector<std::string> m_unprocessed_arguments;
+        const CommandData* m_command;
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_commands;
+        /// Sub-commands from before the last call to clear() that
+        /// add_subcommand() can reuse.
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_spare_commands;
+        std::unique_ptr<IteratorBuffers> m_iterator_buffers;
+        std::shared_ptr<const ParserData> m_data;
+        ParserResultCode m_result_code = ParserResultCode::NONE;
+        const OptionData* m_stop_option = nullptr;
+        bool m_silent = false;
+        /// Lets ArgumentIteratorImpl report errors from callbacks
+        /// without parsing the exception's message.
+        mutable std::optional<std::pair<std::string, ArgumentId>> m_silent_error;
+    };
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-26.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
 
-#include <cstring>
-#include <iostream>
-
 namespace argos
 {
-    namespace
+    /**
+     * @brief A private, writable memory-mapping of a file.
+     *
+     * Changes to the mapped memory are never written back to the file,
+     * and only the pages that are changed are copied. On platforms
+     * without memory-mapping the file is read into a buffer.
+     */
+    class MappedFile
     {
-        std::unique_ptr<ParserData> make_copy(const ParserData& data)
-        {
-            auto result = std::make_unique<ParserData>();
-            result->parser_settings = data.parser_settings;
-            result->help_settings = data.help_settings;
-            result->command = data.command;
-            return result;
-        }
+    public:
+        MappedFile();
 
-        constexpr char DEFAULT_NAME[] = "UNINITIALIZED";
+        MappedFile(const MappedFile&) = delete;
 
-        ParsedArguments parse_arguments(std::vector<std::string_view> args,
-                                        const std::shared_ptr<ParserData>& data)
-        {
-            finish_initialization(*data);
-            return ParsedArguments(
-                ArgumentIteratorImpl::parse(std::move(args), data));
-        }
+        ~MappedFile();
 
-        ArgumentIterator
-        make_argument_iterator(std::vector<std::string_view> args,
-                               const std::shared_ptr<ParserData>& data)
-        {
-            finish_initialization(*data);
-            return {std::move(args), data};
-        }
-    }
+        MappedFile& operator=(const MappedFile&) = delete;
 
-    ArgumentParser::ArgumentParser()
-        : ArgumentParser(DEFAULT_NAME)
-    {}
+        /**
+         * @brief Maps the file at @a path, returns false if it can't be
+         *  opened.
+         */
+        bool open(const std::string& path);
 
-    ArgumentParser::ArgumentParser(std::string_view program_name,
-                                   bool extract_file_name)
-        : m_data(std::make_unique<ParserData>())
-    {
-        m_data->command.name = extract_file_name
-                                   ? get_base_name(program_name)
-                                   : program_name;
-    }
+        [[nodiscard]] std::span<char> data() const;
+    private:
+        void close();
 
-    ArgumentParser::ArgumentParser(ArgumentParser&& rhs) noexcept
-        : m_data(std::move(rhs.m_data))
-    {
-    }
+        char* m_data = nullptr;
+        size_t m_size = 0;
+        /// Only used when memory-mapping isn't available.
+        std::unique_ptr<char[]> m_buffer;
+    };
+}
 
-    ArgumentParser::~ArgumentParser() = default;
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <filesystem>
 
-    ArgumentParser& ArgumentParser::operator=(ArgumentParser&& rhs) noexcept
+namespace argos
+{
+    /**
+     * @brief Replaces "@FILE" arguments with the arguments in FILE.
+     *
+     * The files are memory-mapped and tokenized in place: quotes and
+     * escape characters are removed by moving the rest of the token
+     * backwards in the mapped memory, and the arguments are views of
+     * the mapped memory. Both the files and the arguments remain valid
+     * until the ResponseFiles instance is destroyed.
+     */
+    class ResponseFiles
     {
-        m_data = std::move(rhs.m_data);
-        return *this;
-    }
+    public:
+        /**
+         * @brief Returns true if any of @a args starts with '@'.
+         */
+        static bool has_response_files(ArgumentSource args);
 
-    ArgumentParser& ArgumentParser::add(Argument& argument)
-    {
-        return add(std::move(argument));
-    }
+        /**
+         * @brief Appends @a args to arguments(), with response files
+         *  replaced by their contents.
+         *
+         * Returns false if a response file refers to itself, directly or
+         * through other response files, see error_message().
+         */
+        bool expand(ArgumentSource args);
 
-    ArgumentParser& ArgumentParser::add(Argument&& argument)
-    {
-        check_data();
-        m_data->command.add(argument.release());
-        return *this;
-    }
+        [[nodiscard]] ArgumentSource arguments() const;
 
-    ArgumentParser& ArgumentParser::add(Option& option)
-    {
-        return add(std::move(option));
-    }
+        [[nodiscard]] const std::string& error_message() const;
+    private:
+        bool expand_file(std::string_view arg);
 
-    ArgumentParser& ArgumentParser::add(Option&& option)
-    {
-        check_data();
-        m_data->command.add(option.release());
-        return *this;
-    }
+        std::vector<std::unique_ptr<MappedFile>> m_files;
+        std::vector<std::string_view> m_arguments;
+        /// The files that are currently being expanded.
+        std::vector<std::filesystem::path> m_file_stack;
+        std::string m_error_message;
+    };
 
-    ArgumentParser& ArgumentParser::add(Command& command)
+    /**
+     * @brief Splits @a text into arguments in place.
+     *
+     * Arguments are separated by whitespace. Single and double quotes
+     * group characters, including whitespace, into a single argument,
+     * and a backslash makes the next character a normal character.
+     * Characters are only written to @a text where a quote or backslash
+     * has been removed earlier in the same argument.
+     */
+    class ResponseFileTokenizer
     {
-        return add(std::move(command));
-    }
+    public:
+        explicit ResponseFileTokenizer(std::span<char> text);
 
-    ArgumentParser& ArgumentParser::add(Command&& command)
-    {
-        check_data();
-        m_data->command.add(command.release());
-        return *this;
-    }
+        bool next(std::string_view& token);
+    private:
+        std::span<char> m_text;
+        size_t m_pos = 0;
+    };
+}
 
-    ArgumentParser& ArgumentParser::copy_from(const Command& command)
-    {
-        check_data();
-        m_data->command.copy_from(command.internal_ref());
-        return *this;
-    }
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-07.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <deque>
 
-    ParsedArguments ArgumentParser::parse(int argc, char** argv)
+namespace argos
+{
+    enum class IteratorResultCode
     {
-        if (argc <= 0)
-            return parse(std::vector<std::string_view>());
+        ARGUMENT,
+        OPTION,
+        COMMAND,
+        DONE,
+        UNKNOWN,
+        ERROR,
+        /// The iterator needs more arguments, see ArgumentIteratorImpl::push().
+        INCOMPLETE
+    };
 
-        if (m_data->command.name == DEFAULT_NAME
-            && std::strlen(argv[0]) != 0)
-        {
-            m_data->command.name = get_base_name(argv[0]);
-        }
+    using IteratorResultData = std::variant<
+        std::monostate,
+        const ArgumentData*,
+        const OptionData*,
+        const CommandData*>;
 
-        return parse(std::vector<std::string_view>(argv + 1, argv + argc));
-    }
+    using IteratorResult = std::tuple<
+        IteratorResultCode,
+        IteratorResultData,
+        std::string_view>;
 
-    ParsedArguments ArgumentParser::parse(int argc, char** argv) const
-    {
-        if (argc <= 0)
-            return parse(std::vector<std::string_view>());
-        return parse(std::vector<std::string_view>(argv + 1, argv + argc));
-    }
+    /**
+     * @brief Assigns the view and value of @a result to @a arg and
+     *  @a value, returns false if @a result isn't an argument, option,
+     *  command or unknown argument.
+     */
+    bool get_result_view(const IteratorResult& result,
+                         std::unique_ptr<IArgumentView>& arg,
+                         std::string_view& value);
 
-    ParsedArguments ArgumentParser::parse(std::vector<std::string_view> args)
+    /**
+     * @brief The containers ArgumentIteratorImpl uses while parsing.
+     *
+     * They are owned by the top-level ParsedArgumentsImpl, which lets
+     * a parse that reuses a ParsedArgumentsImpl also reuse the memory
+     * that was allocated by the previous one.
+     */
+    struct IteratorBuffers
     {
-        check_data();
-        return parse_arguments(std::move(args), std::move(m_data));
-    }
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>> parsed_args;
+        ArgumentCounter argument_counter;
+        std::deque<size_t> sibling_ordinals;
+    };
 
-    ParsedArguments ArgumentParser::parse(std::vector<std::string_view> args) const
+    class ArgumentIteratorImpl
     {
-        check_data();
-        return parse_arguments(std::move(args), make_copy(*m_data));
-    }
+    public:
+        /**
+         * Creates an iterator that reads @a args directly, the arguments
+         * must outlive the iterator.
+         */
+        ArgumentIteratorImpl(ArgumentSource args,
+                             std::shared_ptr<const ParserData> data);
 
-    ArgumentIterator ArgumentParser::make_iterator(int argc, char** argv)
-    {
-        if (argc <= 0)
-            ARGOS_THROW("argc and argv must at least contain the command name.");
-        return make_iterator(std::vector<std::string_view>(argv + 1, argv + argc));
-    }
+        /**
+         * Creates an iterator with its own copy of @a args.
+         */
+        ArgumentIteratorImpl(const std::vector<std::string_view>& args,
+                             std::shared_ptr<const ParserData> data);
 
-    ArgumentIterator ArgumentParser::make_iterator(int argc, char** argv) const
-    {
-        if (argc <= 0)
-            ARGOS_THROW("argc and argv must at least contain the command name.");
-        return make_iterator(std::vector<std::string_view>(argv + 1, argv + argc));
-    }
+        /**
+         * Creates an iterator that receives its arguments one at a time
+         * through push().
+         */
+        explicit ArgumentIteratorImpl(std::shared_ptr<const ParserData> data);
 
-    ArgumentIterator
-    ArgumentParser::make_iterator(std::vector<std::string_view> args)
-    {
-        if (!m_data)
-            ARGOS_THROW("This instance of ArgumentParser can no longer be used.");
-        return make_argument_iterator(std::move(args), std::move(m_data));
-    }
+        ArgumentIteratorImpl(const ArgumentIteratorImpl&) = delete;
 
-    ArgumentIterator
-    ArgumentParser::make_iterator(std::vector<std::string_view> args) const
-    {
-        check_data();
-        return make_argument_iterator(std::move(args), make_copy(*m_data));
-    }
+        ~ArgumentIteratorImpl();
 
-    bool ArgumentParser::allow_abbreviated_options() const
-    {
-        check_data();
-        return m_data->parser_settings.allow_abbreviated_options;
-    }
+        ArgumentIteratorImpl& operator=(const ArgumentIteratorImpl&) = delete;
 
-    ArgumentParser& ArgumentParser::allow_abbreviated_options(bool value)
-    {
-        check_data();
-        m_data->parser_settings.allow_abbreviated_options = value;
-        return *this;
-    }
+        IteratorResult next();
 
-    bool ArgumentParser::auto_exit() const
-    {
-        check_data();
-        return m_data->parser_settings.auto_exit;
-    }
+        /**
+         * Adds @a arg to the arguments of an iterator created with
+         * the constructor that only takes the parser data.
+         *
+         * The arguments are processed by next() as soon as they can be,
+         * which for options with values means when the value has been
+         * added too. Arguments of commands where the number of values
+         * that each argument receives depends on the total number of
+         * arguments are held back until the argument they belong to can
+         * be determined, and next() returns INCOMPLETE until then.
+         *
+         * If response files are allowed and @a arg is "@FILE", the
+         * arguments in FILE are added instead.
+         */
+        void push(std::string_view arg);
 
-    ArgumentParser& ArgumentParser::auto_exit(bool value)
-    {
-        check_data();
-        m_data->parser_settings.auto_exit = value;
-        return *this;
-    }
+        /**
+         * Tells the iterator that push() will not be called again.
+         */
+        void finish();
 
-    bool ArgumentParser::case_insensitive() const
-    {
-        check_data();
-        return m_data->parser_settings.case_insensitive;
-    }
+        /**
+         * Sets the maximum number of arguments push() can add while
+         * next() is unable to determine which argument the first of
+         * them belongs to. next() reports an error if the limit is
+         * exceeded.
+         */
+        void set_max_lookahead(size_t max_lookahead);
 
-    ArgumentParser& ArgumentParser::case_insensitive(bool value)
-    {
-        check_data();
-        m_data->parser_settings.case_insensitive = value;
-        return *this;
-    }
+        /**
+         * If @a store is false, the values of arguments are not stored in
+         * the parsed arguments, they are only returned by next().
+         */
+        void set_store_argument_values(bool store);
 
-    bool ArgumentParser::generate_help_option() const
-    {
-        check_data();
-        return m_data->parser_settings.generate_help_option;
-    }
+        /**
+         * Parses @a args.
+         *
+         * If @a result is given, the values are stored in it rather than
+         * in a new ParsedArgumentsImpl. It must have been created for
+         * the main command of @a data, and it must be empty, see
+         * ParsedArgumentsImpl::clear().
+         */
+        static std::shared_ptr<ParsedArgumentsImpl>
+        parse(ArgumentSource args,
+              const std::shared_ptr<const ParserData>& data,
+              std::shared_ptr<ParsedArgumentsImpl> result = {});
 
-    ArgumentParser& ArgumentParser::generate_help_option(bool value)
-    {
-        check_data();
-        m_data->parser_settings.generate_help_option = value;
-        return *this;
-    }
+        /**
+         * Parses @a args without writing to the output stream or
+         * exiting the program, regardless of the parser settings.
+         * An error is stored in @a error. Errors reported by callbacks
+         * are caught if exceptions are enabled.
+         *
+         * @a result is used the same way as in parse().
+         */
+        static std::shared_ptr<ParsedArgumentsImpl>
+        parse_silently(ArgumentSource args,
+                       const std::shared_ptr<const ParserData>& data,
+                       std::shared_ptr<ParsedArgumentsImpl> result,
+                       ParseError& error);
 
-    OptionStyle ArgumentParser::option_style() const
-    {
-        check_data();
-        return m_data->parser_settings.option_style;
-    }
+        [[nodiscard]] const std::shared_ptr<ParsedArgumentsImpl>&
+        parsed_arguments() const;
 
-    ArgumentParser& ArgumentParser::option_style(OptionStyle value)
-    {
-        check_data();
-        if (value != m_data->parser_settings.option_style)
-        {
-            if (!m_data->command.options.empty())
-                ARGOS_THROW("Can't change option style after"
-                            " options have been added.");
-            m_data->parser_settings.option_style = value;
-        }
-        return *this;
-    }
+        [[nodiscard]] const std::shared_ptr<ParsedArgumentsImpl>&
+        toplevel_parsed_arguments() const;
 
-    std::optional<bool> ArgumentParser::require_subcommand() const
-    {
-        check_data();
-        return m_data->command.require_subcommand;
-    }
+        /**
+         * @brief Returns the number of options and arguments the calling
+         *  thread has read while counting arguments ahead of parsing them.
+         *
+         * Lets tests verify that the work of counting arguments grows
+         * linearly with the number of arguments.
+         */
+        static size_t scanned_argument_count();
 
-    ArgumentParser& ArgumentParser::require_subcommand(bool value)
-    {
-        check_data();
-        m_data->command.require_subcommand = value;
-        return *this;
-    }
+    private:
+        enum class OptionResult
+        {
+            NORMAL,
+            LAST_ARGUMENT,
+            STOP,
+            EXIT,
+            ERROR
+        };
 
-    bool ArgumentParser::allow_multiple_subcommands() const
-    {
-        check_data();
-        return m_data->command.multi_command;
-    }
+        std::pair<OptionResult, std::string_view>
+        process_option(const OptionData& opt, std::string_view flag);
 
-    ArgumentParser& ArgumentParser::allow_multiple_subcommands(bool value)
-    {
-        check_data();
-        m_data->command.multi_command = value;
-        return *this;
-    }
+        IteratorResult process_option(std::string_view flag);
 
-    bool ArgumentParser::ignore_undefined_arguments() const
-    {
-        check_data();
-        return m_data->parser_settings.ignore_undefined_arguments;
-    }
+        IteratorResult process_argument(std::string_view value);
 
-    ArgumentParser& ArgumentParser::ignore_undefined_arguments(bool value)
-    {
-        check_data();
-        m_data->parser_settings.ignore_undefined_arguments = value;
-        return *this;
-    }
+        IteratorResult process_command(const CommandData* command);
 
-    bool ArgumentParser::ignore_undefined_options() const
-    {
-        check_data();
-        return m_data->parser_settings.ignore_undefined_options;
-    }
+        void copy_remaining_arguments_to_parser_result();
 
-    ArgumentParser& ArgumentParser::ignore_undefined_options(bool value)
-    {
-        check_data();
-        m_data->parser_settings.ignore_undefined_options = value;
-        return *this;
-    }
+        /**
+         * @brief Makes the parsed arguments ready to be handed out. Must
+         *  be called whenever parsing ends, with or without errors.
+         *
+         * The const functions of ParsedArgumentsImpl don't modify the
+         * object once it has been compacted, which makes it safe to
+         * share the result between threads.
+         */
+        void finish_parsed_arguments();
+
+        bool prepare_stream_argument();
+
+        void update_stream_window();
+
+        [[nodiscard]] bool needs_next_argument(OptionIteratorWrapper& it,
+                                               std::string_view flag) const;
+
+        bool count_stream_arguments(std::string_view arg);
+
+        struct ArgumentScan
+        {
+            /// The number of arguments found.
+            size_t count = 0;
+            /// Ordinals of arguments that are also names of sibling commands.
+            std::vector<size_t> sibling_ordinals;
+            /// True if the scan reached the end of the command's arguments
+            /// before running out of input.
+            bool stopped = false;
+            /// True if the input ended with an option missing its value.
+            bool value_pending = false;
+            /// True if the input contained a LAST_OPTION option.
+            bool last_option_found = false;
+            /// True if the name of a sibling command stopped the scan.
+            bool stopped_by_sibling = false;
+            /// True if options were no longer recognized when the scan
+            /// ended.
+            bool arguments_only = false;
+            /// If stopped is true: the number of arguments from the one
+            /// that stopped the scan to the end of the input, that
+            /// argument included.
+            size_t stop_distance = 0;
+        };
 
-    const ArgumentCallback& ArgumentParser::argument_callback() const
-    {
-        check_data();
-        return m_data->parser_settings.argument_callback;
-    }
+        class ArgumentScanner;
 
-    ArgumentParser& ArgumentParser::argument_callback(ArgumentCallback callback)
-    {
-        check_data();
-        m_data->parser_settings.argument_callback = std::move(callback);
-        return *this;
-    }
+        [[nodiscard]] ArgumentScan
+        scan_arguments(ArgumentSource args,
+                       size_t first_ordinal,
+                       bool arguments_only) const;
 
-    const OptionCallback& ArgumentParser::option_callback() const
-    {
-        check_data();
-        return m_data->parser_settings.option_callback;
-    }
+        void count_arguments();
 
-    ArgumentParser& ArgumentParser::option_callback(OptionCallback callback)
-    {
-        check_data();
-        m_data->parser_settings.option_callback = std::move(callback);
-        return *this;
-    }
+        ArgumentSource expand_response_files(ArgumentSource args);
 
-    std::ostream* ArgumentParser::stream() const
-    {
-        check_data();
-        return m_data->help_settings.output_stream;
-    }
+        void set_argument_scan(const ArgumentScan& scan, size_t first_ordinal);
 
-    ArgumentParser& ArgumentParser::stream(std::ostream* stream)
-    {
-        check_data();
-        m_data->help_settings.output_stream = stream;
-        return *this;
-    }
+        void update_argument_end();
 
-    const std::string& ArgumentParser::program_name() const
-    {
-        check_data();
-        return m_data->command.name;
-    }
+        bool check_argument_and_option_counts();
 
-    ArgumentParser& ArgumentParser::program_name(const std::string& name)
-    {
-        check_data();
-        m_data->command.name = name;
-        return *this;
-    }
+        [[nodiscard]] std::pair<const CommandData*, size_t>
+        find_sibling_command(std::string_view name) const;
 
-    ArgumentParser& ArgumentParser::about(std::string text)
-    {
-        return this->text(TextId::ABOUT, std::move(text));
-    }
+        [[nodiscard]]
+        std::optional<size_t> find_first_multi_command_parent() const;
 
-    ArgumentParser& ArgumentParser::text(TextId textId, std::string text)
-    {
-        check_data();
-        m_data->command.texts[textId] = std::move(text);
-        return *this;
-    }
+        void reactivate_multi_command_parent(size_t index);
 
-    ArgumentParser& ArgumentParser::text(TextId textId,
-                                         std::function<std::string()> callback)
-    {
-        check_data();
-        m_data->command.texts[textId] = std::move(callback);
-        return *this;
-    }
+        void update_arguments(const std::vector<std::string>& args);
 
-    ArgumentParser& ArgumentParser::version(const std::string& version)
-    {
-        check_data();
-        m_data->version = version;
-        return *this;
-    }
+        /**
+         * Reports the error, either by writing it to the output stream
+         * (and possibly exiting) or, in silent mode, by storing it in
+         * m_error.
+         */
+        void error(ParseErrorCode code,
+                   const std::string& message,
+                   ArgumentId argument_id = {},
+                   std::optional<size_t> token_index = {});
 
-    ArgumentParser& ArgumentParser::current_section(const std::string& name)
-    {
-        check_data();
-        m_data->command.current_section = name;
-        return *this;
-    }
+        bool has_all_mandatory_options(const ParsedArgumentsImpl& parsed_args,
+                                       const CommandData& command);
 
-    const std::string& ArgumentParser::current_section() const
-    {
-        check_data();
-        return m_data->command.current_section;
-    }
+        ArgumentIteratorImpl(std::vector<std::string> owned_args,
+                             ArgumentSource args,
+                             std::shared_ptr<const ParserData> data,
+                             std::shared_ptr<ParsedArgumentsImpl> result = {},
+                             bool silent = false);
+
+        [[nodiscard]] bool auto_exit() const;
+
+        /// The state of an iterator that receives its arguments through
+        /// push().
+        struct ArgumentStream
+        {
+            /// The arguments that haven't been processed yet. Arguments
+            /// that precede m_iterator's position in window have been
+            /// processed, but not yet removed.
+            std::deque<std::string> arguments;
+            /// The arguments that m_iterator reads.
+            std::vector<std::string_view> window;
+            /// True if push() has added arguments that aren't in window.
+            bool window_is_outdated = false;
+            /// True if callbacks have inserted arguments into m_iterator
+            /// that aren't in arguments.
+            bool has_insertions = false;
+            bool finished = false;
+            bool store_argument_values = true;
+            size_t max_lookahead = 1024;
+        };
 
-    ArgumentParser& ArgumentParser::section(const std::string& name)
-    {
-        return current_section(name);
-    }
+        /// Only used when the iterator must keep its own copy of the
+        /// arguments.
+        std::vector<std::string> m_owned_args;
+        std::shared_ptr<const ParserData> m_data;
+        /// True if errors are stored in m_error instead of being
+        /// written to the output stream, and the program never exits.
+        bool m_silent = false;
+        ParseError m_error;
+        std::unique_ptr<ArgumentStream> m_stream;
+        /// Owns the arguments read from response files.
+        std::unique_ptr<ResponseFiles> m_response_files;
+        /// An error found before parsing started, next() reports it
+        /// instead of processing the first argument.
+        std::string m_pending_error;
+        const CommandData* m_command = nullptr;
+        /// Keeps the parsed arguments, and with them the buffers that
+        /// the references below refer to, alive.
+        std::shared_ptr<ParsedArgumentsImpl> m_toplevel;
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>>& m_parsed_args;
+        OptionIteratorWrapper m_iterator;
+        ArgumentCounter& m_argument_counter;
+
+        // The lookahead that determines the current command's argument
+        // count. Ordinals are indices in the sequence of the command's
+        // arguments. The arguments before m_scan_end have been counted,
+        // m_sibling_ordinals lists the ones among them that are names
+        // of sibling commands. The first sibling command that comes after
+        // the command's minimum number of arguments ends the sequence,
+        // m_argument_end is its ordinal, or m_scan_end if there is none,
+        // and m_early_siblings is the number of sibling commands before
+        // it. m_scan_end and m_sibling_ordinals are stored relative to
+        // m_ordinal_offset (the subtraction may wrap around, only the sum
+        // is meaningful) to let inserted arguments move all of them in
+        // constant time.
+        size_t m_argument_end = 0;
+        size_t m_scan_end = 0;
+        std::deque<size_t>& m_sibling_ordinals;
+        size_t m_early_siblings = 0;
+        size_t m_ordinal_offset = 0;
+        /// The stop_distance, stopped_by_sibling and arguments_only of
+        /// the scan that ended at m_scan_end. They tell where the counted
+        /// arguments end, and let the scan continue if inserted arguments
+        /// turn the sibling command that stopped it into an argument.
+        size_t m_scan_stop = 0;
+        bool m_scan_stopped_by_sibling = false;
+        bool m_scan_stop_arguments_only = false;
 
-    ArgumentParser& ArgumentParser::line_width(unsigned int line_width)
-    {
-        check_data();
-        m_data->help_settings.line_width = line_width;
-        return *this;
-    }
+        enum class State
+        {
+            ARGUMENTS_AND_OPTIONS,
+            ARGUMENTS_ONLY,
+            DONE,
+            ERROR
+        };
 
-    void ArgumentParser::write_help_text() const
-    {
-        write_subcommand_help_text({});
-    }
+        State m_state = State::ARGUMENTS_AND_OPTIONS;
+    };
+}
 
-    void ArgumentParser::write_subcommand_help_text(const std::vector<std::string>& path) const
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-26.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    ArgumentIterator::ArgumentIterator(std::vector<std::string_view> args,
+                                       std::shared_ptr<const ParserData> parser_data)
+        : m_impl(std::make_unique<ArgumentIteratorImpl>(std::move(args),
+                                                        std::move(parser_data)))
+    {}
+
+    ArgumentIterator::ArgumentIterator(ArgumentIterator&& rhs) noexcept
+        : m_impl(std::move(rhs.m_impl))
+    {}
+
+    ArgumentIterator::~ArgumentIterator() = default;
+
+    ArgumentIterator&
+    ArgumentIterator::operator=(ArgumentIterator&& rhs) noexcept
     {
-        check_data();
-        const auto data = make_copy(*m_data);
-        finish_initialization(*data);
-        const auto* cmd = &data->command;
-        for (auto& name : path)
-        {
-            cmd = cmd->find_command(name, data->parser_settings.case_insensitive);
-            if (!cmd)
-                ARGOS_THROW("Unknown command: " + name);
-        }
-        argos::write_help_text(*data, *cmd);
+        m_impl = std::move(rhs.m_impl);
+        return *this;
     }
 
-    ArgumentParser& ArgumentParser::add_word_splitting_rule(std::string str)
+    bool ArgumentIterator::next(std::unique_ptr<IArgumentView>& arg,
+                                std::string_view& value)
     {
-        check_data();
-        m_data->help_settings.word_split_rules.push_back(std::move(str));
-        return *this;
+        return get_result_view(impl().next(), arg, value);
     }
 
-    ArgumentParser& ArgumentParser::set_exit_codes(int error, int normal_exit)
+    ParsedArguments ArgumentIterator::parsed_arguments() const
     {
-        check_data();
-        m_data->parser_settings.error_exit_code = error;
-        m_data->parser_settings.normal_exit_code = normal_exit;
-        return *this;
+        return ParsedArguments(impl().parsed_arguments());
     }
 
-    ArgumentParser&& ArgumentParser::move()
+    ArgumentIteratorImpl& ArgumentIterator::impl()
     {
-        return std::move(*this);
+        if (!m_impl)
+            ARGOS_THROW("This ArgumentIterator has been moved from.");
+        return *m_impl;
     }
 
-    void ArgumentParser::check_data() const
+    const ArgumentIteratorImpl& ArgumentIterator::impl() const
     {
-        if (!m_data)
-            ARGOS_THROW("This instance of ArgumentParser can no longer be used.");
+        if (!m_impl)
+            ARGOS_THROW("This ArgumentIterator has been moved from.");
+        return *m_impl;
     }
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-03.
+// Created by Jan Erik Breimo on 2020-01-21.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-#include <cerrno>
-#include <cinttypes>
-#include <type_traits>
 
 namespace argos
 {
-    template <typename T>
-    std::optional<T> parse_integer(const std::string& str, int base) = delete;
+    void write_help_text(const ParserData& data, const CommandData& cmd);
 
-    template <>
-    std::optional<int> parse_integer<int>(const std::string& str, int base);
+    void write_error_message(const ParserData& data,
+                             const CommandData& cmd,
+                             const std::string& msg);
 
-    template <>
-    std::optional<unsigned>
-    parse_integer<unsigned>(const std::string& str, int base);
+    void write_error_message(const ParserData& data,
+                             const CommandData& cmd,
+                             const std::string& msg,
+                             ArgumentId argument_id);
 
-    template <>
-    std::optional<long> parse_integer<long>(const std::string& str, int base);
+    /**
+     * @brief Returns the first line of the error message that
+     *  write_error_message() writes, without any line breaks.
+     */
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg);
 
-    template <>
-    std::optional<long long>
-    parse_integer<long long>(const std::string& str, int base);
-
-    template <>
-    std::optional<unsigned long>
-    parse_integer<unsigned long>(const std::string& str, int base);
-
-    template <>
-    std::optional<unsigned long long>
-    parse_integer<unsigned long long>(const std::string& str, int base);
-
-    template <typename T>
-    std::optional<T> parse_floating_point(const std::string& str);
-
-    template <>
-    std::optional<float> parse_floating_point<float>(const std::string& str);
-
-    template <>
-    std::optional<double> parse_floating_point<double>(const std::string& str);
-}
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg,
+                                  ArgumentId argument_id);
+}
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-31.
+// Created by Jan Erik Breimo on 2020-01-07.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -2271,487 +3332,5525 @@ namespace argos
 {
     namespace
     {
-        template <typename T>
-        T get_integer(const ArgumentValue& value, T default_value, int base)
+        bool is_option(std::string_view s, OptionStyle style)
         {
-            const auto s = value.value();
-            if (!s)
-                return default_value;
-            auto n = parse_integer<T>(std::string(*s), base);
-            if (!n)
-                value.error();
-            return *n;
+            if (s.size() < 2)
+                return false;
+
+            return s[0] == (style == OptionStyle::SLASH ? '/' : '-');
         }
 
-        template <typename T>
-        T get_floating_point(const ArgumentValue& value, T default_value)
+        std::variant<OptionIterator, StandardOptionIterator>
+        make_option_iterator(OptionStyle style, ArgumentSource args)
         {
-            const auto s = value.value();
-            if (!s)
-                return default_value;
-            auto n = parse_floating_point<T>(std::string(*s));
-            if (!n)
-                value.error();
-            return *n;
+            switch (style)
+            {
+            case OptionStyle::SLASH:
+                return OptionIterator(args, '/');
+            case OptionStyle::DASH:
+                return OptionIterator(args, '-');
+            default:
+                return StandardOptionIterator(args);
+            }
         }
+
+        thread_local size_t scanned_arguments = 0;
     }
 
-    ArgumentValue::ArgumentValue()
-        : m_value_id(),
-          m_argument_id()
-    {}
+    bool get_result_view(const IteratorResult& result,
+                         std::unique_ptr<IArgumentView>& arg,
+                         std::string_view& value)
+    {
+        switch (std::get<0>(result))
+        {
+        case IteratorResultCode::ARGUMENT:
+            arg = std::make_unique<ArgumentView>(
+                    std::get<const ArgumentData*>(std::get<1>(result)));
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::OPTION:
+            arg = std::make_unique<OptionView>(
+                    std::get<const OptionData*>(std::get<1>(result)));
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::COMMAND:
+            arg = std::make_unique<CommandView>(
+                    std::get<const CommandData*>(std::get<1>(result)));
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::UNKNOWN:
+            arg = {};
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::DONE:
+        case IteratorResultCode::ERROR:
+        case IteratorResultCode::INCOMPLETE:
+            break;
+        }
+        arg = {};
+        value = {};
+        return false;
+    }
 
-    ArgumentValue::ArgumentValue(const std::optional<std::string_view>& value,
-                                 std::shared_ptr<ParsedArgumentsImpl> args,
-                                 ValueId value_id,
-                                 ArgumentId argument_id)
-        : m_value(value),
-          m_args(std::move(args)),
-          m_value_id(value_id),
-          m_argument_id(argument_id)
+    ArgumentIteratorImpl::ArgumentIteratorImpl(ArgumentSource args,
+                                               std::shared_ptr<const ParserData> data)
+        : ArgumentIteratorImpl({}, args, std::move(data))
     {}
 
-    ArgumentValue::ArgumentValue(const ArgumentValue&) = default;
-
-    ArgumentValue::ArgumentValue(ArgumentValue&& ) noexcept = default;
-
-    ArgumentValue::~ArgumentValue() = default;
+    ArgumentIteratorImpl::ArgumentIteratorImpl(std::shared_ptr<const ParserData> data)
+        : ArgumentIteratorImpl({}, {}, std::move(data))
+    {
+        m_stream = std::make_unique<ArgumentStream>();
+    }
 
-    ArgumentValue&
-    ArgumentValue::operator=(const ArgumentValue&) = default;
+    ArgumentIteratorImpl::ArgumentIteratorImpl(const std::vector<std::string_view>& args,
+                                               std::shared_ptr<const ParserData> data)
+        : ArgumentIteratorImpl(std::vector<std::string>(args.begin(), args.end()),
+                               {}, std::move(data))
+    {}
 
-    ArgumentValue&
-    ArgumentValue::operator=(ArgumentValue&&) noexcept = default;
+    ArgumentIteratorImpl::ArgumentIteratorImpl(std::vector<std::string> owned_args,
+                                               ArgumentSource args,
+                                               std::shared_ptr<const ParserData> data,
+                                               std::shared_ptr<ParsedArgumentsImpl> result,
+                                               bool silent)
+        : m_owned_args(std::move(owned_args)),
+          m_data(std::move(data)),
+          m_silent(silent),
+          m_command(&m_data->command),
+          m_toplevel(result
+                         ? std::move(result)
+                         : std::make_shared<ParsedArgumentsImpl>(m_command,
+                                                                 m_data)),
+          m_parsed_args(m_toplevel->iterator_buffers().parsed_args),
+          m_iterator{
+              make_option_iterator(m_data->parser_settings.option_style,
+                                   expand_response_files(
+                                       m_owned_args.empty()
+                                           ? args
+                                           : ArgumentSource(m_owned_args)))
+          },
+          m_argument_counter(m_toplevel->iterator_buffers().argument_counter),
+          m_sibling_ordinals(m_toplevel->iterator_buffers().sibling_ordinals)
+    {
+        m_parsed_args.assign(1, m_toplevel);
+        m_sibling_ordinals.clear();
+        auto& parsed_args = *parsed_arguments();
+        parsed_args.set_silent(m_silent);
+        const auto source = m_iterator.remaining_arguments();
+        size_t text_size = 0;
+        for (size_t i = 0; i < source.size(); ++i)
+            text_size += source[i].size();
+        parsed_args.reserve(source.size(), text_size);
+        // Bound variables must not keep the values of the previous parse.
+        m_data->bindings.reset();
+        parsed_args.add_initial_values();
 
-    ArgumentValue::operator bool() const
-    {
-        return m_value.has_value();
+        count_arguments();
     }
 
-    std::unique_ptr<IArgumentView>
-    ArgumentValue::argument() const
+    ArgumentIteratorImpl::~ArgumentIteratorImpl()
     {
-        if (!m_args)
-            ARGOS_THROW("ArgumentValue has not been initialized.");
-        return m_args->get_argument_view(m_argument_id);
+        // The buffers belong to m_toplevel, which must not keep a
+        // reference to itself when the iterator is gone.
+        m_parsed_args.clear();
     }
 
-    std::optional<std::string_view> ArgumentValue::value() const
+    std::shared_ptr<ParsedArgumentsImpl>
+    ArgumentIteratorImpl::parse(ArgumentSource args,
+                                const std::shared_ptr<const ParserData>& data,
+                                std::shared_ptr<ParsedArgumentsImpl> result)
     {
-        return m_value;
+        ArgumentIteratorImpl iterator({}, args, data, std::move(result));
+        while (true)
+        {
+            const auto code = std::get<0>(iterator.next());
+            if (code == IteratorResultCode::ERROR
+                || code == IteratorResultCode::DONE)
+            {
+                break;
+            }
+        }
+        return iterator.toplevel_parsed_arguments();
     }
 
-    bool ArgumentValue::as_bool(bool default_value) const
+    std::shared_ptr<ParsedArgumentsImpl>
+    ArgumentIteratorImpl::parse_silently(ArgumentSource args,
+                                         const std::shared_ptr<const ParserData>& data,
+                                         std::shared_ptr<ParsedArgumentsImpl> result,
+                                         ParseError& error)
     {
-        if (!m_value)
-            return default_value;
-        return !m_value->empty() && m_value != "0" && m_value != "false";
+        ArgumentIteratorImpl iterator({}, args, data, std::move(result), true);
+#if ARGOS_EXCEPTIONS
+        try
+        {
+#endif
+            while (true)
+            {
+                const auto code = std::get<0>(iterator.next());
+                if (code == IteratorResultCode::ERROR
+                    || code == IteratorResultCode::DONE)
+                {
+                    break;
+                }
+            }
+#if ARGOS_EXCEPTIONS
+        }
+        catch (const ArgosException&)
+        {
+            // Only errors from ParsedArgumentsBuilder::error() in a
+            // callback, or from the callback's attempt to read an invalid
+            // value, are parse errors. Others, e.g. errors in the
+            // definition of a lazily defined sub-command, are passed on.
+            auto silent_error = iterator.parsed_arguments()->silent_error();
+            if (!silent_error)
+                throw;
+            iterator.error(ParseErrorCode::CALLBACK,
+                           silent_error->first, silent_error->second);
+        }
+#endif
+        error = std::move(iterator.m_error);
+        // Errors in the values that are read after parsing, e.g. from
+        // ArgumentValue::as_int(), are reported the usual way.
+        auto parsed_args = iterator.toplevel_parsed_arguments();
+        parsed_args->set_silent(false);
+        return parsed_args;
     }
 
-    int ArgumentValue::as_int(int default_value, int base) const
+    IteratorResult ArgumentIteratorImpl::next()
     {
-        return get_integer<int>(*this, default_value, base);
-    }
+        if (m_state == State::ERROR)
+            ARGOS_THROW("next() called after error.");
+        if (m_state == State::DONE)
+            return {IteratorResultCode::DONE, {}, {}};
 
-    unsigned ArgumentValue::as_uint(unsigned default_value, int base) const
-    {
-        return get_integer<unsigned>(*this, default_value, base);
-    }
+        if (!m_pending_error.empty())
+        {
+            error(ParseErrorCode::RESPONSE_FILE,
+                  std::exchange(m_pending_error, {}));
+            return {IteratorResultCode::ERROR, {}, {}};
+        }
 
-    long ArgumentValue::as_long(long default_value, int base) const
-    {
-        return get_integer<long>(*this, default_value, base);
-    }
+        if (m_stream && !prepare_stream_argument())
+        {
+            if (m_state == State::ERROR)
+                return {IteratorResultCode::ERROR, {}, {}};
+            return {IteratorResultCode::INCOMPLETE, {}, {}};
+        }
 
-    long long ArgumentValue::as_llong(long long default_value, int base) const
-    {
-        return get_integer<long long>(*this, default_value, base);
-    }
+        const auto arg = m_state == State::ARGUMENTS_AND_OPTIONS
+                             ? m_iterator.next()
+                             : m_iterator.next_value();
+        if (!arg)
+        {
+            if (check_argument_and_option_counts())
+                return {IteratorResultCode::DONE, {}, {}};
+            else
+                return {IteratorResultCode::ERROR, {}, {}};
+        }
 
-    unsigned long
-    ArgumentValue::as_ulong(unsigned long default_value, int base) const
-    {
-        return get_integer<unsigned long>(*this, default_value, base);
+        if (m_state == State::ARGUMENTS_AND_OPTIONS
+            && is_option(*arg, m_data->parser_settings.option_style))
+        {
+            return process_option(*arg);
+        }
+        else if (m_command->commands.empty())
+        {
+            return process_argument(*arg);
+        }
+        else if (auto cmd = m_command->find_command(
+            *arg, m_data->parser_settings.allow_abbreviated_commands))
+        {
+            return process_command(cmd);
+        }
+        else
+        {
+            error(ParseErrorCode::UNKNOWN_COMMAND,
+                  "Unknown command: " + std::string(*arg), {},
+                  m_iterator.index());
+            return {IteratorResultCode::ERROR, {}, {}};
+        }
     }
 
-    unsigned long long
-    ArgumentValue::as_ullong(unsigned long long default_value, int base) const
+    void ArgumentIteratorImpl::push(std::string_view arg)
     {
-        return get_integer<unsigned long long>(*this, default_value, base);
-    }
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        if (m_stream->finished)
+            ARGOS_THROW("Arguments can't be added after finish().");
 
-    float ArgumentValue::as_float(float default_value) const
-    {
-        return get_floating_point<float>(*this, default_value);
+        if (m_state == State::DONE || m_state == State::ERROR)
+        {
+            // The same as copy_remaining_arguments_to_parser_result()
+            // would have done if the argument had arrived earlier.
+            parsed_arguments()->add_unprocessed_argument(arg);
+            return;
+        }
+
+        const ArgumentSource source(&arg, 1);
+        if (m_data->parser_settings.allow_response_files
+            && ResponseFiles::has_response_files(source))
+        {
+            ResponseFiles files;
+            if (!files.expand(source) && m_pending_error.empty())
+                m_pending_error = files.error_message();
+            const auto args = files.arguments();
+            for (size_t i = 0; i < args.size(); ++i)
+                m_stream->arguments.emplace_back(args[i]);
+        }
+        else
+        {
+            m_stream->arguments.emplace_back(arg);
+        }
+        m_stream->window_is_outdated = true;
     }
 
-    double ArgumentValue::as_double(double default_value) const
+    void ArgumentIteratorImpl::finish()
     {
-        return get_floating_point<double>(*this, default_value);
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        m_stream->finished = true;
     }
 
-    std::string ArgumentValue::as_string(const std::string& default_value) const
+    void ArgumentIteratorImpl::set_max_lookahead(size_t max_lookahead)
     {
-        return m_value ? std::string(*m_value) : default_value;
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        m_stream->max_lookahead = max_lookahead;
     }
 
-    ArgumentValues
-    ArgumentValue::split(char separator,
-                         size_t min_parts, size_t max_parts) const
+    void ArgumentIteratorImpl::set_store_argument_values(bool store)
     {
-        if (!m_args)
-            ARGOS_THROW("ArgumentValue has not been initialized.");
-        if (!m_value)
-            return {{}, m_args, m_value_id};
-        auto parts = split_string(*m_value, separator, max_parts - 1);
-        if (parts.size() < min_parts)
-        {
-            error("Invalid value: \"" + std::string(*m_value)
-                  + "\". Must have at least " + std::to_string(min_parts)
-                  + " values separated by \"" + separator + "\".");
-        }
-        std::vector<std::pair<std::string_view, ArgumentId>> values;
-        values.reserve(parts.size());
-        for (auto& part : parts)
-            values.emplace_back(part, m_argument_id);
-        return {std::move(values), m_args, m_value_id};
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        m_stream->store_argument_values = store;
     }
 
-    ArgumentValues
-    ArgumentValue::split_n(char separator, size_t num_parts) const
+    const std::shared_ptr<ParsedArgumentsImpl>&
+    ArgumentIteratorImpl::parsed_arguments() const
     {
-        return split(separator, num_parts, num_parts);
+        return m_parsed_args.back();
     }
 
-    void ArgumentValue::error(const std::string& message) const
+    const std::shared_ptr<ParsedArgumentsImpl>&
+    ArgumentIteratorImpl::toplevel_parsed_arguments() const
     {
-        if (!m_args)
-            ARGOS_THROW("ArgumentValue has not been initialized.");
-        m_args->error(message, m_argument_id);
+        return m_toplevel;
     }
 
-    void ArgumentValue::error() const
+    size_t ArgumentIteratorImpl::scanned_argument_count()
     {
-        if (!m_value)
-            ARGOS_THROW("ArgumentValue has no value.");
-        error("Invalid value: " + std::string(*m_value) + ".");
+        return scanned_arguments;
     }
-}
-
-//****************************************************************************
-// Copyright © 2021 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2021-07-07.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
-
-namespace argos
-{
-    ArgumentValueIterator::ArgumentValueIterator() = default;
 
-    ArgumentValueIterator::ArgumentValueIterator(
-        const ArgumentValueIterator::It& internal_iterator,
-        std::shared_ptr<ParsedArgumentsImpl> args,
-        ValueId value_id)
-    : m_iterator(internal_iterator),
-      m_args(std::move(args)),
-      m_value_id(value_id)
-    {}
-
-    ArgumentValueIterator& ArgumentValueIterator::operator++()
+    std::pair<ArgumentIteratorImpl::OptionResult, std::string_view>
+    ArgumentIteratorImpl::process_option(const OptionData& opt,
+                                         std::string_view flag)
     {
-        ++m_iterator;
-        return *this;
+        const auto& parsed_args = parsed_arguments();
+        parsed_args->set_given(opt.argument_id);
+        std::string_view arg;
+        switch (opt.operation)
+        {
+        case OptionOperation::ASSIGN:
+            if (!opt.constant.empty())
+            {
+                parsed_args->assign_value(opt.value_id, opt.constant,
+                                          opt.argument_id);
+            }
+            else if (const auto value = m_iterator.next_value())
+            {
+                const auto stored = parsed_args->assign_value(
+                    opt.value_id, *value, opt.argument_id);
+                if (!stored)
+                {
+                    error(ParseErrorCode::INVALID_VALUE,
+                          "Invalid value: " + std::string(*value) + ".",
+                          opt.argument_id, m_iterator.index());
+                    return {OptionResult::ERROR, {}};
+                }
+                arg = *stored;
+            }
+            else
+            {
+                // next_value() has moved past the flag.
+                error(ParseErrorCode::MISSING_VALUE,
+                      std::string(flag) + ": no value given.", {},
+                      m_iterator.index() - 1);
+                return {OptionResult::ERROR, {}};
+            }
+            break;
+        case OptionOperation::APPEND:
+            if (!opt.constant.empty())
+            {
+                parsed_args->append_value(opt.value_id, opt.constant,
+                                          opt.argument_id);
+            }
+            else if (const auto value = m_iterator.next_value())
+            {
+                const auto stored = parsed_args->append_value(
+                    opt.value_id, *value, opt.argument_id);
+                if (!stored)
+                {
+                    error(ParseErrorCode::INVALID_VALUE,
+                          "Invalid value: " + std::string(*value) + ".",
+                          opt.argument_id, m_iterator.index());
+                    return {OptionResult::ERROR, {}};
+                }
+                arg = *stored;
+            }
+            else
+            {
+                // next_value() has moved past the flag.
+                error(ParseErrorCode::MISSING_VALUE,
+                      std::string(flag) + ": no value given.", {},
+                      m_iterator.index() - 1);
+                return {OptionResult::ERROR, {}};
+            }
+            break;
+        case OptionOperation::CLEAR:
+            parsed_args->clear_value(opt.value_id);
+            break;
+        case OptionOperation::NONE:
+            break;
+        }
+
+        if (opt.callback)
+        {
+            CallbackArguments args(OptionView(&opt), arg, parsed_args);
+            opt.callback(args);
+            update_arguments(args.new_arguments);
+        }
+        if (m_data->parser_settings.option_callback)
+        {
+            CallbackArguments args(OptionView(&opt), arg, parsed_args);
+            m_data->parser_settings.option_callback(args);
+            update_arguments(args.new_arguments);
+        }
+
+        switch (opt.type)
+        {
+        case OptionType::NORMAL:
+            return {OptionResult::NORMAL, arg};
+        case OptionType::HELP:
+            if (!m_silent)
+                write_help_text(*m_data, *m_command);
+            [[fallthrough]];
+        case OptionType::EXIT:
+            m_state = State::DONE;
+            parsed_args->set_breaking_option(&opt);
+            return {OptionResult::EXIT, arg};
+        case OptionType::STOP:
+            m_state = State::DONE;
+            parsed_args->set_breaking_option(&opt);
+            return {OptionResult::STOP, arg};
+        case OptionType::LAST_ARGUMENT:
+            m_state = State::DONE;
+            return {OptionResult::LAST_ARGUMENT, arg};
+        case OptionType::LAST_OPTION:
+            m_state = State::ARGUMENTS_ONLY;
+            return {OptionResult::NORMAL, arg};
+        }
+        return {};
     }
 
-    ArgumentValueIterator ArgumentValueIterator::operator++(int) &
+    IteratorResult
+    ArgumentIteratorImpl::process_option(std::string_view flag)
     {
-        auto it = *this;
-        ++m_iterator;
-        return it;
+        auto option = m_command->find_option(
+            flag,
+            m_data->parser_settings.allow_abbreviated_options);
+        if (option)
+        {
+            auto [res, arg] = process_option(*option, flag);
+            switch (res)
+            {
+            case OptionResult::EXIT:
+                if (auto_exit())
+                    exit(m_data->parser_settings.normal_exit_code);
+                copy_remaining_arguments_to_parser_result();
+                finish_parsed_arguments();
+                return {IteratorResultCode::OPTION, option, arg};
+            case OptionResult::ERROR:
+                return {IteratorResultCode::ERROR, option, {}};
+            case OptionResult::LAST_ARGUMENT:
+                if (!check_argument_and_option_counts())
+                    return {IteratorResultCode::ERROR, {}, {}};
+
+                if (auto index = find_first_multi_command_parent())
+                {
+                    reactivate_multi_command_parent(*index);
+                    return {IteratorResultCode::OPTION, option, arg};
+                }
+
+                [[fallthrough]];
+            case OptionResult::STOP:
+                copy_remaining_arguments_to_parser_result();
+                finish_parsed_arguments();
+                [[fallthrough]];
+            default:
+                return {IteratorResultCode::OPTION, option, arg};
+            }
+        }
+        if (!m_data->parser_settings.ignore_undefined_options
+            || !starts_with(m_iterator.current(), flag))
+        {
+            error(ParseErrorCode::UNKNOWN_OPTION,
+                  "Unknown option: " + std::string(m_iterator.current()), {},
+                  m_iterator.index());
+            return {IteratorResultCode::ERROR, {}, {}};
+        }
+        else
+        {
+            parsed_arguments()->add_unprocessed_argument(m_iterator.current());
+            return {IteratorResultCode::UNKNOWN, {}, m_iterator.current()};
+        }
     }
 
-    ArgumentValue ArgumentValueIterator::operator*() const
+    IteratorResult
+    ArgumentIteratorImpl::process_argument(std::string_view value)
     {
-        return {m_iterator->first, m_args,
-                m_value_id, m_iterator->second};
+        const auto& parsed_args = parsed_arguments();
+        if (auto [next_cmd, i] = find_sibling_command(value); next_cmd)
+        {
+            reactivate_multi_command_parent(i);
+            return process_command(next_cmd);
+        }
+        if (auto argument = m_argument_counter.next_argument())
+        {
+            parsed_args->set_given(argument->argument_id);
+            auto s = value;
+            if (!m_stream || m_stream->store_argument_values
+                || argument->binding)
+            {
+                const auto stored = parsed_args->append_value(
+                    argument->value_id, value, argument->argument_id);
+                if (!stored)
+                {
+                    error(ParseErrorCode::INVALID_VALUE,
+                          "Invalid value: " + std::string(value) + ".",
+                          argument->argument_id, m_iterator.index());
+                    return {IteratorResultCode::ERROR, argument, {}};
+                }
+                s = *stored;
+            }
+            if (argument->callback)
+            {
+                CallbackArguments args(ArgumentView(argument), s, parsed_args);
+                argument->callback(args);
+                update_arguments(args.new_arguments);
+            }
+
+            if (m_data->parser_settings.argument_callback)
+            {
+                CallbackArguments args(ArgumentView(argument), s, parsed_args);
+                m_data->parser_settings.argument_callback(args);
+                update_arguments(args.new_arguments);
+            }
+            return {IteratorResultCode::ARGUMENT, argument, s};
+        }
+        if (m_data->parser_settings.ignore_undefined_arguments)
+        {
+            parsed_args->add_unprocessed_argument(value);
+            return {IteratorResultCode::UNKNOWN, {}, m_iterator.current()};
+        }
+
+        error(ParseErrorCode::TOO_MANY_ARGUMENTS,
+              "Too many arguments, starting from \""
+              + std::string(value) + "\".", {}, m_iterator.index());
+        return {IteratorResultCode::ERROR, {}, {}};
     }
 
-    ArgumentValueIterator::It ArgumentValueIterator::internal_iterator() const
+    IteratorResult
+    ArgumentIteratorImpl::process_command(const CommandData* command)
     {
-        return m_iterator;
+        command->ensure_defined();
+        m_parsed_args.push_back(parsed_arguments()->add_subcommand(command));
+        m_command = command;
+        count_arguments();
+        m_state = State::ARGUMENTS_AND_OPTIONS;
+        return {IteratorResultCode::COMMAND, command, m_iterator.current()};
     }
 
-    bool operator==(const ArgumentValueIterator& a, const ArgumentValueIterator& b)
+    // ReSharper disable once CppMemberFunctionMayBeConst
+    void ArgumentIteratorImpl::copy_remaining_arguments_to_parser_result()
     {
-        return a.internal_iterator() == b.internal_iterator();
+        auto& parsed_args = *parsed_arguments();
+        const auto args = m_iterator.remaining_arguments();
+        for (size_t i = 0; i < args.size(); ++i)
+            parsed_args.add_unprocessed_argument(args[i]);
+
+        // Arguments that have been pushed since m_iterator was created.
+        if (m_stream)
+        {
+            const auto& stream = *m_stream;
+            for (auto i = stream.window.size(); i < stream.arguments.size(); ++i)
+                parsed_args.add_unprocessed_argument(stream.arguments[i]);
+        }
     }
 
-    bool operator!=(const ArgumentValueIterator& a, const ArgumentValueIterator& b)
+    void ArgumentIteratorImpl::finish_parsed_arguments()
     {
-        return a.internal_iterator() != b.internal_iterator();
+        m_toplevel->compact();
     }
-}
-
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-17.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
 
-namespace argos
-{
-    namespace
+    bool ArgumentIteratorImpl::prepare_stream_argument()
     {
-        ArgumentId get_argument_id(
-            const std::vector<std::pair<std::string_view, ArgumentId>>& values)
+        // The remaining flags in a group of concatenated flags were
+        // ready when the first one was.
+        if (m_iterator.is_within_argument())
+            return true;
+
+        update_stream_window();
+        auto it = m_iterator.lookahead();
+        const auto arg = m_state == State::ARGUMENTS_AND_OPTIONS
+                             ? it.next()
+                             : it.next_value();
+        if (!arg)
         {
-            if (values.empty())
-                return {};
-            for (auto it = next(values.begin()); it != values.end(); ++it)
+            if (!m_stream->finished)
+                return false;
+
+            // Now the total number of arguments is known.
+            if (ArgumentCounter::requires_argument_count(*m_command))
             {
-                if (it->second != prev(it)->second)
-                    return {};
+                const auto count = m_argument_counter.count();
+                m_argument_counter.reset(*m_command, count, count);
             }
-            return values.front().second;
+            return true;
         }
 
-        void error(const ArgumentValues& values, std::string_view value)
+        if (m_state == State::ARGUMENTS_AND_OPTIONS
+            && is_option(*arg, m_data->parser_settings.option_style))
         {
-            values.error("Invalid value: " + std::string(value) + ".");
+            return m_stream->finished
+                   || !needs_next_argument(it, *arg)
+                   || m_iterator.remaining_arguments().size() > 1;
         }
 
-        template <typename T>
-        std::vector<T> parse_floats(const ArgumentValues& values,
-                                    const std::vector<T>& default_value)
+        if (!m_command->commands.empty()
+            || !ArgumentCounter::requires_argument_count(*m_command))
         {
-            if (values.empty())
-                return default_value;
-
-            std::vector<T> result;
-            result.reserve(values.size());
-            for (auto& v : values.raw_values())
-            {
-                auto value = parse_floating_point<T>(std::string(v));
-                if (!value)
-                    error(values, v);
-                else
-                    result.push_back(*value);
-            }
-            return result;
+            return true;
         }
 
-        template <typename T>
-        std::vector<T> parse_integers(const ArgumentValues& values,
-                                      const std::vector<T>& default_value,
-                                      int base)
+        return count_stream_arguments(*arg);
+    }
+
+    void ArgumentIteratorImpl::update_stream_window()
+    {
+        auto& stream = *m_stream;
+        if (!stream.window_is_outdated && !stream.has_insertions)
+            return;
+
+        const auto remaining = m_iterator.remaining_arguments();
+        if (stream.has_insertions)
         {
-            if (values.empty())
-                return default_value;
+            // m_iterator's remaining arguments are no longer a suffix
+            // of the window.
+            std::deque<std::string> arguments;
+            for (size_t i = 0; i < remaining.size(); ++i)
+                arguments.emplace_back(remaining[i]);
+            for (auto i = stream.window.size(); i < stream.arguments.size(); ++i)
+                arguments.push_back(std::move(stream.arguments[i]));
+            stream.arguments = std::move(arguments);
+            stream.has_insertions = false;
+        }
+        else
+        {
+            const auto processed = stream.window.size() - remaining.size();
+            stream.arguments.erase(stream.arguments.begin(),
+                                   stream.arguments.begin() + ptrdiff_t(processed));
+        }
 
-            std::vector<T> result;
-            result.reserve(values.size());
-            for (auto& v : values.raw_values())
-            {
-                auto value = parse_integer<T>(std::string(v), base);
-                if (!value)
-                    error(values, v);
+        stream.window.assign(stream.arguments.begin(), stream.arguments.end());
+        m_iterator = {
+            make_option_iterator(m_data->parser_settings.option_style,
+                                 ArgumentSource(stream.window))
+        };
+        stream.window_is_outdated = false;
+    }
+
+    bool ArgumentIteratorImpl::needs_next_argument(OptionIteratorWrapper& it,
+                                                   std::string_view flag) const
+    {
+        // it has just returned flag. Returns true if flag, or one of the
+        // flags concatenated with it, takes its value from the next
+        // argument.
+        const auto allow_abbreviations =
+            m_data->parser_settings.allow_abbreviated_options;
+        while (true)
+        {
+            const auto* option = m_command->find_option(flag,
+                                                        allow_abbreviations);
+            if (!option)
+                return false;
+            if (!option->argument.empty())
+                return flag.back() != '=' && !it.is_within_argument();
+            if (!it.is_within_argument())
+                return false;
+            flag = *it.next();
+        }
+    }
+
+    bool ArgumentIteratorImpl::count_stream_arguments(std::string_view arg)
+    {
+        // The argument that receives arg can only change to an earlier
+        // one as the total number of arguments increases. If it is the
+        // same for the smallest and the largest possible totals, it is
+        // the right one.
+        const auto count = m_argument_counter.count();
+        const auto scan = scan_arguments(m_iterator.remaining_arguments(), count,
+                                         m_state == State::ARGUMENTS_ONLY);
+        const auto total = count + scan.count;
+        if (m_stream->finished || scan.stopped)
+        {
+            m_argument_counter.reset(*m_command, total, count);
+            return true;
+        }
+
+        const auto max_total = ArgumentCounter::get_min_max_count(*m_command).second;
+        const auto* argument = ArgumentCounter::find_argument(
+            *m_command, total, count);
+        const auto* alternative = ArgumentCounter::find_argument(
+            *m_command, max_total, count);
+        if (argument == alternative)
+        {
+            m_argument_counter.reset(*m_command, total, count);
+            return true;
+        }
+
+        if (m_iterator.remaining_arguments().size() > m_stream->max_lookahead)
+        {
+            error(ParseErrorCode::AMBIGUOUS_ARGUMENT,
+                  "Unable to determine if \"" + std::string(arg) + "\" is "
+                  + argument->name + " or " + alternative->name
+                  + " without reading more than "
+                  + std::to_string(m_stream->max_lookahead)
+                  + " arguments ahead.");
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reads the options and arguments of the current command one
+     *  at a time, without processing them, to count the arguments.
+     */
+    class ArgumentIteratorImpl::ArgumentScanner
+    {
+    public:
+        ArgumentScanner(const ArgumentIteratorImpl& owner,
+                        ArgumentSource args,
+                        size_t first_ordinal,
+                        bool arguments_only)
+            : m_command(*owner.m_command),
+              m_settings(owner.m_data->parser_settings),
+              m_min_count(ArgumentCounter::get_min_max_count(m_command).first),
+              m_iterator{make_option_iterator(m_settings.option_style, args)},
+              m_size(args.size()),
+              m_remaining(args.size()),
+              m_first_ordinal(first_ordinal)
+        {
+            if (const auto index = owner.find_first_multi_command_parent())
+                m_parent = owner.m_parsed_args[*index]->command();
+            m_scan.arguments_only = arguments_only;
+        }
+
+        /**
+         * @brief Reads the next option or argument. Returns false if
+         *  there are none, or if it ends the command's arguments.
+         */
+        bool next()
+        {
+            ++scanned_arguments;
+            const auto arg = m_scan.arguments_only
+                                 ? m_iterator.next_value()
+                                 : m_iterator.next();
+            if (!arg)
+            {
+                m_remaining = 0;
+                return false;
+            }
+
+            if (m_scan.arguments_only)
+                return update_remaining(add_argument(*arg));
+
+            const OptionData* option = m_command.find_option(
+                *arg,
+                m_settings.allow_abbreviated_options);
+
+            if (!option)
+            {
+                return update_remaining(is_option(*arg, m_settings.option_style)
+                                        || add_argument(*arg));
+            }
+
+            if (!option->argument.empty() && !m_iterator.next_value())
+            {
+                m_scan.value_pending = true;
+                m_remaining = 0;
+                return false;
+            }
+
+            switch (option->type)
+            {
+            case OptionType::HELP:
+            case OptionType::LAST_ARGUMENT:
+            case OptionType::STOP:
+                stop();
+                return false;
+            case OptionType::LAST_OPTION:
+                m_scan.last_option_found = true;
+                m_scan.arguments_only = true;
+                break;
+            default:
+                break;
+            }
+
+            return update_remaining(true);
+        }
+
+        ArgumentScan& scan()
+        {
+            return m_scan;
+        }
+
+        /**
+         * @brief Returns the number of arguments after the one that was
+         *  read last.
+         */
+        [[nodiscard]] size_t remaining() const
+        {
+            return m_remaining;
+        }
+
+        [[nodiscard]] bool is_within_argument() const
+        {
+            return m_iterator.is_within_argument();
+        }
+
+        /// If true, names of sibling commands are always counted as
+        /// arguments, they never stop the scan.
+        bool count_all_siblings = false;
+    private:
+        // Returns false if arg ends the command's arguments.
+        bool add_argument(std::string_view arg)
+        {
+            if (m_command.find_command(arg,
+                                       m_settings.allow_abbreviated_commands))
+            {
+                stop();
+                return false;
+            }
+
+            if (m_parent
+                && m_parent->find_command(arg,
+                                          m_settings.allow_abbreviated_commands))
+            {
+                const auto ordinal = m_first_ordinal + m_scan.count;
+                if (ordinal >= m_min_count && !count_all_siblings)
+                {
+                    stop();
+                    m_scan.stopped_by_sibling = true;
+                    return false;
+                }
+                m_scan.sibling_ordinals.push_back(ordinal);
+            }
+
+            ++m_scan.count;
+            return true;
+        }
+
+        void stop()
+        {
+            m_scan.stopped = true;
+            m_scan.stop_distance = m_size - m_iterator.index();
+            m_remaining = 0;
+        }
+
+        bool update_remaining(bool result)
+        {
+            m_remaining = m_size - m_iterator.index() - 1;
+            return result;
+        }
+
+        const CommandData& m_command;
+        const ParserSettings& m_settings;
+        size_t m_min_count;
+        /// The first multi-command parent of m_command, if any.
+        const CommandData* m_parent = nullptr;
+        OptionIteratorWrapper m_iterator;
+        size_t m_size;
+        size_t m_remaining;
+        size_t m_first_ordinal;
+        ArgumentScan m_scan;
+    };
+
+    ArgumentIteratorImpl::ArgumentScan
+    ArgumentIteratorImpl::scan_arguments(ArgumentSource args,
+                                         size_t first_ordinal,
+                                         bool arguments_only) const
+    {
+        ArgumentScanner scanner(*this, args, first_ordinal, arguments_only);
+        while (scanner.next())
+        {}
+        return std::move(scanner.scan());
+    }
+
+    ArgumentSource ArgumentIteratorImpl::expand_response_files(ArgumentSource args)
+    {
+        if (!m_data->parser_settings.allow_response_files
+            || !ResponseFiles::has_response_files(args))
+        {
+            return args;
+        }
+
+        m_response_files = std::make_unique<ResponseFiles>();
+        if (!m_response_files->expand(args))
+            m_pending_error = m_response_files->error_message();
+        return m_response_files->arguments();
+    }
+
+    void ArgumentIteratorImpl::count_arguments()
+    {
+        if (!ArgumentCounter::requires_argument_count(*m_command))
+        {
+            m_argument_counter.reset(*m_command);
+            return;
+        }
+
+        // Arguments that arrive one at a time are counted as they arrive,
+        // see count_stream_arguments().
+        if (m_stream)
+        {
+            m_argument_counter.reset(*m_command, 0);
+            return;
+        }
+
+        set_argument_scan(scan_arguments(m_iterator.remaining_arguments(), 0, false), 0);
+        update_argument_end();
+        m_argument_counter.reset(*m_command, m_argument_end);
+    }
+
+    void ArgumentIteratorImpl::set_argument_scan(const ArgumentScan& scan,
+                                                 size_t first_ordinal)
+    {
+        m_scan_end = first_ordinal + scan.count;
+        m_sibling_ordinals.assign(scan.sibling_ordinals.begin(),
+                                  scan.sibling_ordinals.end());
+        m_early_siblings = 0;
+        m_ordinal_offset = 0;
+        m_scan_stop = scan.stop_distance;
+        m_scan_stopped_by_sibling = scan.stopped_by_sibling;
+        m_scan_stop_arguments_only = scan.arguments_only;
+    }
+
+    void ArgumentIteratorImpl::update_argument_end()
+    {
+        // Inserted arguments move all the sibling commands the same
+        // distance, m_early_siblings only has to move past the ones that
+        // cross the minimum count.
+        const auto min_count = ArgumentCounter::get_min_max_count(*m_command).first;
+        auto& siblings = m_sibling_ordinals;
+        while (m_early_siblings < siblings.size()
+               && siblings[m_early_siblings] + m_ordinal_offset < min_count)
+        {
+            ++m_early_siblings;
+        }
+        while (m_early_siblings > 0
+               && siblings[m_early_siblings - 1] + m_ordinal_offset >= min_count)
+        {
+            --m_early_siblings;
+        }
+
+        if (m_early_siblings == siblings.size()
+            && m_scan_stopped_by_sibling
+            && m_scan_end + m_ordinal_offset < min_count)
+        {
+            // The sibling command that stopped the scan comes too early
+            // to end the arguments now, the scan continues from it.
+            const auto args = m_iterator.remaining_arguments();
+            if (m_scan_stop <= args.size())
+            {
+                const auto scan = scan_arguments(
+                    args.subspan(args.size() - m_scan_stop),
+                    m_scan_end + m_ordinal_offset,
+                    m_scan_stop_arguments_only);
+                for (const auto ordinal : scan.sibling_ordinals)
+                    siblings.push_back(ordinal - m_ordinal_offset);
+                m_early_siblings = siblings.size();
+                m_scan_end += scan.count;
+                m_scan_stop = scan.stop_distance;
+                m_scan_stopped_by_sibling = scan.stopped_by_sibling;
+                m_scan_stop_arguments_only = scan.arguments_only;
+            }
+        }
+
+        m_argument_end = m_early_siblings < siblings.size()
+                             ? siblings[m_early_siblings] + m_ordinal_offset
+                             : m_scan_end + m_ordinal_offset;
+    }
+
+    bool ArgumentIteratorImpl::check_argument_and_option_counts()
+    {
+        auto& parsed_args = *parsed_arguments();
+        if (!has_all_mandatory_options(parsed_args, *m_command))
+            return false;
+
+        const auto message = m_command->constraint_checker()
+            .check_constraints(parsed_args.given_arguments());
+        if (!message.empty())
+        {
+            error(ParseErrorCode::CONSTRAINT_VIOLATION, message);
+            return false;
+        }
+
+        if (*m_command->require_subcommand && parsed_args.subcommands().empty())
+        {
+            error(ParseErrorCode::MISSING_COMMAND, "No command was given.");
+            return false;
+        }
+
+        if (m_argument_counter.is_complete())
+        {
+            m_state = State::DONE;
+            for (const auto& pa : m_parsed_args)
+                pa->set_result_code(ParserResultCode::SUCCESS);
+            finish_parsed_arguments();
+            return true;
+        }
+        else
+        {
+            auto [lo, hi] = ArgumentCounter::get_min_max_count(*m_command);
+            error(ParseErrorCode::TOO_FEW_ARGUMENTS,
+                  (lo == hi
+                       ? "Too few arguments. Expected "
+                       : "Too few arguments. Expected at least ")
+                  + std::to_string(lo) + ", received "
+                  + std::to_string(m_argument_counter.count()) + ".");
+            return false;
+        }
+    }
+
+    std::optional<size_t>
+    ArgumentIteratorImpl::find_first_multi_command_parent() const
+    {
+        auto size = m_parsed_args.size();
+        if (size <= 1)
+            return {};
+
+        for (size_t i = size - 1; i-- > 0;)
+        {
+            const auto& parent = *m_parsed_args[i]->command();
+            if (parent.multi_command)
+                return i;
+        }
+
+        return {};
+    }
+
+    std::pair<const CommandData*, size_t>
+    ArgumentIteratorImpl::find_sibling_command(std::string_view name) const
+    {
+        if (!m_argument_counter.is_complete())
+            return {nullptr, 0};
+
+        if (auto index = find_first_multi_command_parent())
+        {
+            return {
+                m_parsed_args[*index]->command()->find_command(
+                    name, m_data->parser_settings.allow_abbreviated_commands),
+                *index
+            };
+        }
+
+        return {nullptr, 0};
+    }
+
+    void ArgumentIteratorImpl::reactivate_multi_command_parent(size_t index)
+    {
+        m_parsed_args.resize(index + 1);
+        m_command = m_parsed_args.back()->command();
+        m_argument_counter.clear();
+        m_state = State::ARGUMENTS_ONLY;
+    }
+
+    void ArgumentIteratorImpl::update_arguments(
+        const std::vector<std::string>& args)
+    {
+        if (args.empty())
+            return;
+
+        m_iterator.insert(args);
+        if (m_stream)
+        {
+            m_stream->has_insertions = true;
+            return;
+        }
+
+        if (!ArgumentCounter::requires_argument_count(*m_command))
+            return;
+
+        // Only the new arguments are scanned, the remaining arguments have
+        // already been counted.
+        const auto current_count = m_argument_counter.count();
+        const auto remaining = m_iterator.remaining_arguments();
+        const auto tail = remaining.subspan(args.size());
+        auto scan = scan_arguments(ArgumentSource(args), current_count,
+                                   m_state == State::ARGUMENTS_ONLY);
+        if (scan.stopped)
+            scan.stop_distance += tail.size();
+
+        while (!m_sibling_ordinals.empty()
+               && m_sibling_ordinals.front() + m_ordinal_offset < current_count)
+        {
+            m_sibling_ordinals.pop_front();
+            if (m_early_siblings != 0)
+                --m_early_siblings;
+        }
+
+        bool new_done = false;
+        if (scan.stopped)
+        {
+            set_argument_scan(scan, current_count);
+        }
+        else if (scan.value_pending || scan.last_option_found)
+        {
+            // The new arguments change how the first of the remaining
+            // arguments are interpreted: either the first one is a value,
+            // or none of them are options. They are scanned both the old
+            // way and the new way until the two scans reach the same
+            // argument in the same state, the arguments after that are
+            // interpreted as before.
+            ArgumentScanner old_scanner(*this, tail, current_count, false);
+            old_scanner.count_all_siblings = true;
+            ArgumentScanner new_scanner(
+                *this,
+                scan.value_pending && !tail.empty() ? tail.subspan(1) : tail,
+                current_count + scan.count,
+                scan.last_option_found);
+            // The old scan can't go past the argument that stopped it.
+            bool old_done = tail.size() <= m_scan_stop;
+            while (true)
+            {
+                if (!old_done
+                    && old_scanner.remaining() == new_scanner.remaining()
+                    && old_scanner.scan().arguments_only
+                       == new_scanner.scan().arguments_only
+                    && !old_scanner.is_within_argument()
+                    && !new_scanner.is_within_argument())
+                {
+                    break;
+                }
+
+                if (old_done || new_scanner.remaining() >= old_scanner.remaining())
+                {
+                    new_scanner.count_all_siblings = !old_done;
+                    if (!new_scanner.next())
+                    {
+                        new_done = true;
+                        break;
+                    }
+                }
                 else
-                    result.push_back(*value);
+                {
+                    old_done = !old_scanner.next()
+                               || old_scanner.remaining() <= m_scan_stop;
+                }
+            }
+
+            auto& new_scan = new_scanner.scan();
+            if (new_done)
+            {
+                // The scans never agreed, the new one replaces the old.
+                scan.count += new_scan.count;
+                scan.sibling_ordinals.insert(scan.sibling_ordinals.end(),
+                                             new_scan.sibling_ordinals.begin(),
+                                             new_scan.sibling_ordinals.end());
+                scan.stopped_by_sibling = new_scan.stopped_by_sibling;
+                scan.arguments_only = new_scan.arguments_only;
+                scan.stop_distance = new_scan.stop_distance;
+                set_argument_scan(scan, current_count);
+            }
+            else
+            {
+                const auto old_end = current_count + old_scanner.scan().count;
+                while (!m_sibling_ordinals.empty()
+                       && m_sibling_ordinals.front() + m_ordinal_offset < old_end)
+                {
+                    m_sibling_ordinals.pop_front();
+                    if (m_early_siblings != 0)
+                        --m_early_siblings;
+                }
+
+                m_ordinal_offset += scan.count + new_scan.count
+                                    - old_scanner.scan().count;
+                for (auto i = new_scan.sibling_ordinals.rbegin();
+                     i != new_scan.sibling_ordinals.rend(); ++i)
+                {
+                    m_sibling_ordinals.push_front(*i - m_ordinal_offset);
+                }
+                m_early_siblings += new_scan.sibling_ordinals.size();
+            }
+        }
+        else
+        {
+            m_ordinal_offset += scan.count;
+        }
+
+        if (!scan.stopped && !new_done)
+        {
+            for (auto i = scan.sibling_ordinals.rbegin();
+                 i != scan.sibling_ordinals.rend(); ++i)
+            {
+                m_sibling_ordinals.push_front(*i - m_ordinal_offset);
+            }
+            m_early_siblings += scan.sibling_ordinals.size();
+        }
+
+        update_argument_end();
+        m_argument_counter.reset(*m_command, m_argument_end, current_count);
+    }
+
+    void ArgumentIteratorImpl::error(ParseErrorCode code,
+                                     const std::string& message,
+                                     ArgumentId argument_id,
+                                     std::optional<size_t> token_index)
+    {
+        // The message isn't formatted in silent mode, ParseError does
+        // that if and when it's needed.
+        m_error = ParseError(code, message, argument_id, token_index,
+                             m_command, m_data);
+        if (!m_silent)
+            m_error.write();
+
+        if (auto_exit())
+            exit(m_data->parser_settings.error_exit_code);
+
+        copy_remaining_arguments_to_parser_result();
+        for (const auto& parsed_args : m_parsed_args)
+            parsed_args->set_result_code(ParserResultCode::FAILURE);
+        m_state = State::ERROR;
+        finish_parsed_arguments();
+    }
+
+    bool ArgumentIteratorImpl::auto_exit() const
+    {
+        return m_data->parser_settings.auto_exit && !m_silent;
+    }
+
+    bool ArgumentIteratorImpl::has_all_mandatory_options(
+        const ParsedArgumentsImpl& parsed_args,
+        const CommandData& command)
+    {
+        const auto* o = command.constraint_checker().find_missing_option(
+            parsed_args.nonempty_values(), parsed_args.given_arguments());
+        if (!o)
+            return true;
+
+        auto flags = o->flags.front();
+        for (unsigned i = 1; i < o->flags.size(); ++i)
+            flags += ", " + o->flags[i];
+        error(ParseErrorCode::MISSING_OPTION,
+              "Mandatory option is missing: " + flags, o->argument_id);
+        return false;
+    }
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-26.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+#include <cstring>
+#include <iostream>
+
+namespace argos
+{
+    namespace
+    {
+        std::unique_ptr<ParserData> make_copy(const ParserData& data)
+        {
+            auto result = std::make_unique<ParserData>();
+            result->parser_settings = data.parser_settings;
+            result->help_settings = data.help_settings;
+            result->command = data.command;
+            result->version = data.version;
+            return result;
+        }
+
+        constexpr char DEFAULT_NAME[] = "UNINITIALIZED";
+
+        ParsedArguments parse_arguments(ArgumentSource args,
+                                        const std::shared_ptr<ParserData>& data)
+        {
+            finish_initialization(*data);
+            return ParsedArguments(ArgumentIteratorImpl::parse(args, data));
+        }
+
+        ArgumentIterator
+        make_argument_iterator(std::vector<std::string_view> args,
+                               const std::shared_ptr<ParserData>& data)
+        {
+            finish_initialization(*data);
+            return {std::move(args), data};
+        }
+    }
+
+    ArgumentParser::ArgumentParser()
+        : ArgumentParser(DEFAULT_NAME)
+    {}
+
+    ArgumentParser::ArgumentParser(std::string_view program_name,
+                                   bool extract_file_name)
+        : m_data(std::make_unique<ParserData>())
+    {
+        m_data->command.name = extract_file_name
+                                   ? get_base_name(program_name)
+                                   : program_name;
+    }
+
+    ArgumentParser::ArgumentParser(ArgumentParser&& rhs) noexcept
+        : m_data(std::move(rhs.m_data))
+    {
+    }
+
+    ArgumentParser::~ArgumentParser() = default;
+
+    ArgumentParser& ArgumentParser::operator=(ArgumentParser&& rhs) noexcept
+    {
+        m_data = std::move(rhs.m_data);
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::add(Argument& argument)
+    {
+        return add(std::move(argument));
+    }
+
+    ArgumentParser& ArgumentParser::add(Argument&& argument)
+    {
+        check_data();
+        m_data->command.add(argument.release());
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::add(Argument& argument, ValueHandle& handle)
+    {
+        return add(std::move(argument), handle);
+    }
+
+    ArgumentParser& ArgumentParser::add(Argument&& argument, ValueHandle& handle)
+    {
+        check_data();
+        const auto index = unsigned(m_data->command.arguments.size());
+        m_data->command.add(argument.release());
+        handle = ValueHandle(m_data->command.handle_id, false, index);
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::add(Option& option)
+    {
+        return add(std::move(option));
+    }
+
+    ArgumentParser& ArgumentParser::add(Option&& option)
+    {
+        check_data();
+        m_data->command.add(option.release());
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::add(Option& option, ValueHandle& handle)
+    {
+        return add(std::move(option), handle);
+    }
+
+    ArgumentParser& ArgumentParser::add(Option&& option, ValueHandle& handle)
+    {
+        check_data();
+        const auto index = unsigned(m_data->command.options.size());
+        m_data->command.add(option.release());
+        handle = ValueHandle(m_data->command.handle_id, true, index);
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::add(Command& command)
+    {
+        return add(std::move(command));
+    }
+
+    ArgumentParser& ArgumentParser::add(Command&& command)
+    {
+        check_data();
+        m_data->command.add(command.release());
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::copy_from(const Command& command)
+    {
+        check_data();
+        m_data->command.copy_from(command.internal_ref());
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::mutually_exclusive(std::vector<std::string> names)
+    {
+        check_data();
+        m_data->command.add_constraint(ConstraintType::MUTUALLY_EXCLUSIVE,
+                                       std::move(names));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::at_least_one_of(std::vector<std::string> names)
+    {
+        check_data();
+        m_data->command.add_constraint(ConstraintType::AT_LEAST_ONE_OF,
+                                       std::move(names));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::depends_on(std::string name,
+                                               std::vector<std::string> names)
+    {
+        check_data();
+        names.insert(names.begin(), std::move(name));
+        m_data->command.add_constraint(ConstraintType::DEPENDS_ON,
+                                       std::move(names));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::conflicts_with(std::string name,
+                                                   std::vector<std::string> names)
+    {
+        check_data();
+        names.insert(names.begin(), std::move(name));
+        m_data->command.add_constraint(ConstraintType::CONFLICTS_WITH,
+                                       std::move(names));
+        return *this;
+    }
+
+    ParsedArguments ArgumentParser::parse(int argc, char** argv)
+    {
+        if (argc <= 0)
+            return parse_source({});
+
+        check_data();
+        if (m_data->command.name == DEFAULT_NAME
+            && std::strlen(argv[0]) != 0)
+        {
+            m_data->command.name = get_base_name(argv[0]);
+        }
+
+        return parse_source({argv + 1, size_t(argc - 1)});
+    }
+
+    ParsedArguments ArgumentParser::parse(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return parse_source({});
+        return parse_source({argv + 1, size_t(argc - 1)});
+    }
+
+    ParsedArguments ArgumentParser::parse(std::vector<std::string_view> args)
+    {
+        return parse_source(ArgumentSource(args));
+    }
+
+    ParsedArguments ArgumentParser::parse(std::vector<std::string_view> args) const
+    {
+        return parse_source(ArgumentSource(args));
+    }
+
+    ParsedArguments ArgumentParser::parse_source(ArgumentSource args)
+    {
+        check_data();
+        return parse_arguments(args, std::move(m_data));
+    }
+
+    ParsedArguments ArgumentParser::parse_source(ArgumentSource args) const
+    {
+        check_data();
+        return parse_arguments(args, make_copy(*m_data));
+    }
+
+    ArgumentIterator ArgumentParser::make_iterator(int argc, char** argv)
+    {
+        if (argc <= 0)
+            ARGOS_THROW("argc and argv must at least contain the command name.");
+        return make_iterator(std::vector<std::string_view>(argv + 1, argv + argc));
+    }
+
+    ArgumentIterator ArgumentParser::make_iterator(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            ARGOS_THROW("argc and argv must at least contain the command name.");
+        return make_iterator(std::vector<std::string_view>(argv + 1, argv + argc));
+    }
+
+    ArgumentIterator
+    ArgumentParser::make_iterator(std::vector<std::string_view> args)
+    {
+        if (!m_data)
+            ARGOS_THROW("This instance of ArgumentParser can no longer be used.");
+        return make_argument_iterator(std::move(args), std::move(m_data));
+    }
+
+    ArgumentIterator
+    ArgumentParser::make_iterator(std::vector<std::string_view> args) const
+    {
+        return compile().make_iterator(std::move(args));
+    }
+
+    CompiledParser ArgumentParser::compile() const
+    {
+        check_data();
+        std::shared_ptr<ParserData> data = make_copy(*m_data);
+        finish_initialization(*data);
+        return CompiledParser(std::move(data));
+    }
+
+    bool ArgumentParser::allow_abbreviated_options() const
+    {
+        check_data();
+        return m_data->parser_settings.allow_abbreviated_options;
+    }
+
+    ArgumentParser& ArgumentParser::allow_abbreviated_options(bool value)
+    {
+        check_data();
+        m_data->parser_settings.allow_abbreviated_options = value;
+        return *this;
+    }
+
+    bool ArgumentParser::allow_abbreviated_commands() const
+    {
+        check_data();
+        return m_data->parser_settings.allow_abbreviated_commands;
+    }
+
+    ArgumentParser& ArgumentParser::allow_abbreviated_commands(bool value)
+    {
+        check_data();
+        m_data->parser_settings.allow_abbreviated_commands = value;
+        return *this;
+    }
+
+    bool ArgumentParser::auto_exit() const
+    {
+        check_data();
+        return m_data->parser_settings.auto_exit;
+    }
+
+    ArgumentParser& ArgumentParser::auto_exit(bool value)
+    {
+        check_data();
+        m_data->parser_settings.auto_exit = value;
+        return *this;
+    }
+
+    bool ArgumentParser::case_insensitive() const
+    {
+        check_data();
+        return m_data->parser_settings.case_insensitive;
+    }
+
+    ArgumentParser& ArgumentParser::case_insensitive(bool value)
+    {
+        check_data();
+        m_data->parser_settings.case_insensitive = value;
+        return *this;
+    }
+
+    bool ArgumentParser::generate_help_option() const
+    {
+        check_data();
+        return m_data->parser_settings.generate_help_option;
+    }
+
+    ArgumentParser& ArgumentParser::generate_help_option(bool value)
+    {
+        check_data();
+        m_data->parser_settings.generate_help_option = value;
+        return *this;
+    }
+
+    OptionStyle ArgumentParser::option_style() const
+    {
+        check_data();
+        return m_data->parser_settings.option_style;
+    }
+
+    ArgumentParser& ArgumentParser::option_style(OptionStyle value)
+    {
+        check_data();
+        if (value != m_data->parser_settings.option_style)
+        {
+            if (!m_data->command.options.empty())
+                ARGOS_THROW("Can't change option style after"
+                            " options have been added.");
+            m_data->parser_settings.option_style = value;
+        }
+        return *this;
+    }
+
+    std::optional<bool> ArgumentParser::require_subcommand() const
+    {
+        check_data();
+        return m_data->command.require_subcommand;
+    }
+
+    ArgumentParser& ArgumentParser::require_subcommand(bool value)
+    {
+        check_data();
+        m_data->command.require_subcommand = value;
+        return *this;
+    }
+
+    bool ArgumentParser::allow_multiple_subcommands() const
+    {
+        check_data();
+        return m_data->command.multi_command;
+    }
+
+    ArgumentParser& ArgumentParser::allow_multiple_subcommands(bool value)
+    {
+        check_data();
+        m_data->command.multi_command = value;
+        return *this;
+    }
+
+    bool ArgumentParser::ignore_undefined_arguments() const
+    {
+        check_data();
+        return m_data->parser_settings.ignore_undefined_arguments;
+    }
+
+    ArgumentParser& ArgumentParser::ignore_undefined_arguments(bool value)
+    {
+        check_data();
+        m_data->parser_settings.ignore_undefined_arguments = value;
+        return *this;
+    }
+
+    bool ArgumentParser::ignore_undefined_options() const
+    {
+        check_data();
+        return m_data->parser_settings.ignore_undefined_options;
+    }
+
+    ArgumentParser& ArgumentParser::ignore_undefined_options(bool value)
+    {
+        check_data();
+        m_data->parser_settings.ignore_undefined_options = value;
+        return *this;
+    }
+
+    bool ArgumentParser::allow_response_files() const
+    {
+        check_data();
+        return m_data->parser_settings.allow_response_files;
+    }
+
+    ArgumentParser& ArgumentParser::allow_response_files(bool value)
+    {
+        check_data();
+        m_data->parser_settings.allow_response_files = value;
+        return *this;
+    }
+
+    const ArgumentCallback& ArgumentParser::argument_callback() const
+    {
+        check_data();
+        return m_data->parser_settings.argument_callback;
+    }
+
+    ArgumentParser& ArgumentParser::argument_callback(ArgumentCallback callback)
+    {
+        check_data();
+        m_data->parser_settings.argument_callback = std::move(callback);
+        return *this;
+    }
+
+    const OptionCallback& ArgumentParser::option_callback() const
+    {
+        check_data();
+        return m_data->parser_settings.option_callback;
+    }
+
+    ArgumentParser& ArgumentParser::option_callback(OptionCallback callback)
+    {
+        check_data();
+        m_data->parser_settings.option_callback = std::move(callback);
+        return *this;
+    }
+
+    std::ostream* ArgumentParser::stream() const
+    {
+        check_data();
+        return m_data->help_settings.output_stream;
+    }
+
+    ArgumentParser& ArgumentParser::stream(std::ostream* stream)
+    {
+        check_data();
+        m_data->help_settings.output_stream = stream;
+        return *this;
+    }
+
+    const std::string& ArgumentParser::program_name() const
+    {
+        check_data();
+        return m_data->command.name;
+    }
+
+    ArgumentParser& ArgumentParser::program_name(const std::string& name)
+    {
+        check_data();
+        m_data->command.name = name;
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::about(std::string text)
+    {
+        return this->text(TextId::ABOUT, std::move(text));
+    }
+
+    ArgumentParser& ArgumentParser::text(TextId textId, std::string text)
+    {
+        check_data();
+        m_data->command.texts[textId] = std::move(text);
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::text(TextId textId,
+                                         std::function<std::string()> callback)
+    {
+        check_data();
+        m_data->command.texts[textId] = std::move(callback);
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::version(const std::string& version)
+    {
+        check_data();
+        m_data->version = version;
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::current_section(const std::string& name)
+    {
+        check_data();
+        m_data->command.current_section = name;
+        return *this;
+    }
+
+    const std::string& ArgumentParser::current_section() const
+    {
+        check_data();
+        return m_data->command.current_section;
+    }
+
+    ArgumentParser& ArgumentParser::section(const std::string& name)
+    {
+        return current_section(name);
+    }
+
+    ArgumentParser& ArgumentParser::line_width(unsigned int line_width)
+    {
+        check_data();
+        m_data->help_settings.line_width = line_width;
+        return *this;
+    }
+
+    void ArgumentParser::write_help_text() const
+    {
+        write_subcommand_help_text({});
+    }
+
+    void ArgumentParser::write_subcommand_help_text(const std::vector<std::string>& path) const
+    {
+        compile().write_subcommand_help_text(path);
+    }
+
+    ArgumentParser& ArgumentParser::add_word_splitting_rule(std::string str)
+    {
+        check_data();
+        m_data->help_settings.word_split_rules.push_back(std::move(str));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::set_exit_codes(int error, int normal_exit)
+    {
+        check_data();
+        m_data->parser_settings.error_exit_code = error;
+        m_data->parser_settings.normal_exit_code = normal_exit;
+        return *this;
+    }
+
+    ArgumentParser&& ArgumentParser::move()
+    {
+        return std::move(*this);
+    }
+
+    void ArgumentParser::check_data() const
+    {
+        if (!m_data)
+            ARGOS_THROW("This instance of ArgumentParser can no longer be used.");
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+#include <cassert>
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t MIN_GAP = 16;
+    }
+
+    ArgumentQueue::ArgumentQueue() = default;
+
+    ArgumentQueue::ArgumentQueue(std::vector<std::string_view> args)
+        : m_buffer(std::move(args)),
+          m_size(m_buffer.size()),
+          m_is_used(true)
+    {}
+
+    ArgumentSource ArgumentQueue::arguments() const
+    {
+        return {m_buffer.data() + m_buffer.size() - m_size, m_size};
+    }
+
+    ArgumentSource
+    ArgumentQueue::insert(ArgumentSource remaining, size_t pos,
+                          std::span<const std::string_view> new_args)
+    {
+        const auto count = new_args.size();
+        const auto size = remaining.size();
+        // Arguments are only removed from the front, so remaining is
+        // still the end of the buffer.
+        assert(!m_is_used || size <= m_size);
+        const auto gap = m_buffer.size() - size;
+        if (m_is_used && gap >= count)
+        {
+            const auto start = gap - count;
+            for (size_t i = 0; i < pos; ++i)
+                m_buffer[start + i] = m_buffer[gap + i];
+            std::copy(new_args.begin(), new_args.end(),
+                      m_buffer.begin() + ptrdiff_t(start + pos));
+            m_size = size + count;
+            return arguments();
+        }
+
+        // Make a new buffer with a gap in front that is at least as
+        // large as the arguments, i.e. the cost of copying them is
+        // paid for by the insertions that fill the gap.
+        const auto new_size = size + count;
+        const auto new_gap = std::max(new_size, MIN_GAP);
+        std::vector<std::string_view> buffer;
+        buffer.reserve(new_gap + new_size);
+        buffer.resize(new_gap);
+        for (size_t i = 0; i < pos; ++i)
+            buffer.push_back(remaining[i]);
+        buffer.insert(buffer.end(), new_args.begin(), new_args.end());
+        for (size_t i = pos; i < size; ++i)
+            buffer.push_back(remaining[i]);
+        m_buffer = std::move(buffer);
+        m_size = new_size;
+        m_is_used = true;
+        return arguments();
+    }
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-03.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    class ChoiceSet;
+
+    /**
+     * @brief Parses @a str the same way as strtol and its siblings in
+     *  the "C" locale, but fails rather than returning a partial result
+     *  if @a str contains anything else than the number.
+     *
+     * Leading whitespace and a sign are accepted. If @a base is 0, the
+     * base is determined by the prefix: "0x" for 16 and "0" for 8.
+     * Unsigned types accept negative numbers and wrap them around,
+     * like strtoul does.
+     */
+    template <typename T>
+    std::optional<T> parse_integer(std::string_view str, int base) = delete;
+
+    template <>
+    std::optional<int> parse_integer<int>(std::string_view str, int base);
+
+    template <>
+    std::optional<unsigned>
+    parse_integer<unsigned>(std::string_view str, int base);
+
+    template <>
+    std::optional<long> parse_integer<long>(std::string_view str, int base);
+
+    template <>
+    std::optional<long long>
+    parse_integer<long long>(std::string_view str, int base);
+
+    template <>
+    std::optional<unsigned long>
+    parse_integer<unsigned long>(std::string_view str, int base);
+
+    template <>
+    std::optional<unsigned long long>
+    parse_integer<unsigned long long>(std::string_view str, int base);
+
+    /**
+     * @brief Parses @a str the same way as strtod and strtof in the "C"
+     *  locale, but fails if @a str contains anything else than the
+     *  number, or if the number is out of range.
+     *
+     * Leading whitespace, a sign, hexadecimal numbers, infinity and NaN
+     * are accepted. Non-zero numbers that are too small to be
+     * represented as normalized numbers are out of range.
+     */
+    template <typename T>
+    std::optional<T> parse_floating_point(std::string_view str);
+
+    template <>
+    std::optional<float> parse_floating_point<float>(std::string_view str);
+
+    template <>
+    std::optional<double> parse_floating_point<double>(std::string_view str);
+
+    /**
+     * @brief Converts @a str to @a type and stores the result in the
+     *  corresponding member of @a value.
+     *
+     * Integers are parsed in base 10, and booleans the same way as
+     * ArgumentValue::as_bool() does. Returns false if @a str isn't a
+     * valid value of @a type.
+     */
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           TypedValue& value);
+
+    /**
+     * @brief Same as parse_typed_value(), but @a str must also be one of
+     *  @a choices unless @a choices is nullptr.
+     *
+     * If @a type is CHOICE, the position of @a str in @a choices is
+     * stored in value.uint_value.
+     */
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           const ChoiceSet* choices, TypedValue& value);
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    /**
+     * @brief A text that is split on a separator, divided into chunks
+     *  of whole parts that can be converted by different threads.
+     */
+    struct SplitChunks
+    {
+        /// The chunks in order. The separators between them are not
+        /// included.
+        std::vector<std::string_view> chunks;
+        /// The index of the first part of each chunk.
+        std::vector<size_t> offsets;
+        /// The total number of parts.
+        size_t count = 0;
+    };
+
+    /**
+     * @brief Divides @a text into at most @a thread_count chunks and
+     *  counts the parts separated by @a separator in each of them.
+     *
+     * An empty text has no parts. Small texts are not divided, every
+     * chunk gets at least 64 KiB. If @a thread_count is 0, the number
+     * of hardware threads is used.
+     */
+    SplitChunks split_chunks(std::string_view text, char separator,
+                             unsigned thread_count);
+
+    /**
+     * @brief Converts the parts of @a chunks to numbers and writes them
+     *  to @a out, which must have room for chunks.count numbers.
+     *
+     * Each chunk is converted by its own thread. Returns the first
+     * part that isn't a valid number, if any, in which case the
+     * contents of @a out are unspecified. Integers are parsed in
+     * base 10.
+     */
+    template <typename T>
+    std::optional<std::string_view>
+    convert_chunks(const SplitChunks& chunks, char separator, T* out);
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-31.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
+    {
+        template <typename T>
+        T get_integer(const ArgumentValue& value, T default_value, int base)
+        {
+            const auto s = value.value();
+            if (!s)
+                return default_value;
+            auto n = parse_integer<T>(*s, base);
+            if (!n)
+                value.error();
+            return *n;
+        }
+
+        template <typename T>
+        T get_floating_point(const ArgumentValue& value, T default_value)
+        {
+            const auto s = value.value();
+            if (!s)
+                return default_value;
+            auto n = parse_floating_point<T>(*s);
+            if (!n)
+                value.error();
+            return *n;
+        }
+    }
+
+    ArgumentValue::ArgumentValue()
+        : m_value_id(),
+          m_argument_id()
+    {}
+
+    ArgumentValue::ArgumentValue(const std::optional<std::string_view>& value,
+                                 std::shared_ptr<ParsedArgumentsImpl> args,
+                                 ValueId value_id,
+                                 ArgumentId argument_id,
+                                 ValueType value_type,
+                                 TypedValue typed_value)
+        : m_value(value),
+          m_args(std::move(args)),
+          m_value_id(value_id),
+          m_argument_id(argument_id),
+          m_value_type(value_type),
+          m_typed_value(typed_value)
+    {}
+
+    ArgumentValue::ArgumentValue(const ArgumentValue&) = default;
+
+    ArgumentValue::ArgumentValue(ArgumentValue&& ) noexcept = default;
+
+    ArgumentValue::~ArgumentValue() = default;
+
+    ArgumentValue&
+    ArgumentValue::operator=(const ArgumentValue&) = default;
+
+    ArgumentValue&
+    ArgumentValue::operator=(ArgumentValue&&) noexcept = default;
+
+    ArgumentValue::operator bool() const
+    {
+        return m_value.has_value();
+    }
+
+    std::unique_ptr<IArgumentView>
+    ArgumentValue::argument() const
+    {
+        if (!m_args)
+            ARGOS_THROW("ArgumentValue has not been initialized.");
+        return m_args->get_argument_view(m_argument_id);
+    }
+
+    std::optional<std::string_view> ArgumentValue::value() const
+    {
+        return m_value;
+    }
+
+    bool ArgumentValue::as_bool(bool default_value) const
+    {
+        if (!m_value)
+            return default_value;
+        if (m_value_type == ValueType::BOOL)
+            return m_typed_value.bool_value;
+        return !m_value->empty() && m_value != "0" && m_value != "false";
+    }
+
+    int ArgumentValue::as_int(int default_value, int base) const
+    {
+        if (m_value && m_value_type == ValueType::INT && base == 10)
+            return m_typed_value.int_value;
+        return get_integer<int>(*this, default_value, base);
+    }
+
+    unsigned ArgumentValue::as_uint(unsigned default_value, int base) const
+    {
+        if (m_value && m_value_type == ValueType::UINT && base == 10)
+            return m_typed_value.uint_value;
+        return get_integer<unsigned>(*this, default_value, base);
+    }
+
+    long ArgumentValue::as_long(long default_value, int base) const
+    {
+        if (m_value && m_value_type == ValueType::LONG && base == 10)
+            return m_typed_value.long_value;
+        return get_integer<long>(*this, default_value, base);
+    }
+
+    long long ArgumentValue::as_llong(long long default_value, int base) const
+    {
+        if (m_value && m_value_type == ValueType::LLONG && base == 10)
+            return m_typed_value.llong_value;
+        return get_integer<long long>(*this, default_value, base);
+    }
+
+    unsigned long
+    ArgumentValue::as_ulong(unsigned long default_value, int base) const
+    {
+        if (m_value && m_value_type == ValueType::ULONG && base == 10)
+            return m_typed_value.ulong_value;
+        return get_integer<unsigned long>(*this, default_value, base);
+    }
+
+    unsigned long long
+    ArgumentValue::as_ullong(unsigned long long default_value, int base) const
+    {
+        if (m_value && m_value_type == ValueType::ULLONG && base == 10)
+            return m_typed_value.ullong_value;
+        return get_integer<unsigned long long>(*this, default_value, base);
+    }
+
+    float ArgumentValue::as_float(float default_value) const
+    {
+        if (m_value && m_value_type == ValueType::FLOAT)
+            return m_typed_value.float_value;
+        return get_floating_point<float>(*this, default_value);
+    }
+
+    double ArgumentValue::as_double(double default_value) const
+    {
+        if (m_value && m_value_type == ValueType::DOUBLE)
+            return m_typed_value.double_value;
+        return get_floating_point<double>(*this, default_value);
+    }
+
+    int ArgumentValue::as_choice(int default_value) const
+    {
+        if (!m_value)
+            return default_value;
+        if (m_value_type == ValueType::CHOICE)
+            return int(m_typed_value.uint_value);
+        const auto* choices = m_args ? m_args->get_choices(m_value_id) : nullptr;
+        if (!choices)
+            ARGOS_THROW("The value doesn't have any choices.");
+        const auto index = choices->find(*m_value);
+        if (!index)
+            error();
+        return int(*index);
+    }
+
+    std::string ArgumentValue::as_string(const std::string& default_value) const
+    {
+        return m_value ? std::string(*m_value) : default_value;
+    }
+
+    ArgumentValues
+    ArgumentValue::split(char separator,
+                         size_t min_parts, size_t max_parts) const
+    {
+        if (!m_args)
+            ARGOS_THROW("ArgumentValue has not been initialized.");
+        if (!m_value)
+            return {{}, m_args, m_value_id};
+        auto parts = split_string(*m_value, separator, max_parts - 1);
+        if (parts.size() < min_parts)
+        {
+            error("Invalid value: \"" + std::string(*m_value)
+                  + "\". Must have at least " + std::to_string(min_parts)
+                  + " values separated by \"" + separator + "\".");
+        }
+        std::vector<std::pair<std::string_view, ArgumentId>> values;
+        values.reserve(parts.size());
+        for (auto& part : parts)
+            values.emplace_back(part, m_argument_id);
+        return {std::move(values), m_args, m_value_id};
+    }
+
+    ArgumentValues
+    ArgumentValue::split_n(char separator, size_t num_parts) const
+    {
+        return split(separator, num_parts, num_parts);
+    }
+
+    template <SplitNumber T>
+    std::vector<T>
+    ArgumentValue::split_as(char separator, unsigned thread_count) const
+    {
+        if (!m_value)
+            return {};
+        const auto chunks = split_chunks(*m_value, separator, thread_count);
+        std::vector<T> result(chunks.count);
+        if (const auto part = convert_chunks(chunks, separator, result.data()))
+            error("Invalid value: " + std::string(*part) + ".");
+        return result;
+    }
+
+    template <SplitNumber T>
+    size_t ArgumentValue::split_into(std::span<T> buffer, char separator,
+                                     unsigned thread_count) const
+    {
+        if (!m_value)
+            return 0;
+        const auto chunks = split_chunks(*m_value, separator, thread_count);
+        if (chunks.count > buffer.size())
+        {
+            error("Too many values: " + std::to_string(chunks.count)
+                  + ". The maximum is " + std::to_string(buffer.size()) + ".");
+        }
+        if (const auto part = convert_chunks(chunks, separator, buffer.data()))
+            error("Invalid value: " + std::string(*part) + ".");
+        return chunks.count;
+    }
+
+#define ARGOS_SPLIT_NUMBER(type) \
+    template std::vector<type> \
+    ArgumentValue::split_as<type>(char, unsigned) const; \
+    template size_t \
+    ArgumentValue::split_into<type>(std::span<type>, char, unsigned) const
+
+    ARGOS_SPLIT_NUMBER(int);
+    ARGOS_SPLIT_NUMBER(unsigned);
+    ARGOS_SPLIT_NUMBER(long);
+    ARGOS_SPLIT_NUMBER(long long);
+    ARGOS_SPLIT_NUMBER(unsigned long);
+    ARGOS_SPLIT_NUMBER(unsigned long long);
+    ARGOS_SPLIT_NUMBER(float);
+    ARGOS_SPLIT_NUMBER(double);
+
+#undef ARGOS_SPLIT_NUMBER
+
+    void ArgumentValue::error(const std::string& message) const
+    {
+        if (!m_args)
+            ARGOS_THROW("ArgumentValue has not been initialized.");
+        m_args->error(message, m_argument_id);
+    }
+
+    void ArgumentValue::error() const
+    {
+        if (!m_value)
+            ARGOS_THROW("ArgumentValue has no value.");
+        error("Invalid value: " + std::string(*m_value) + ".");
+    }
+}
+
+//****************************************************************************
+// Copyright © 2021 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2021-07-07.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    ArgumentValueIterator::ArgumentValueIterator() = default;
+
+    ArgumentValueIterator::ArgumentValueIterator(
+        const ArgumentValueIterator::It& internal_iterator,
+        std::shared_ptr<ParsedArgumentsImpl> args,
+        ValueId value_id)
+    : m_iterator(internal_iterator),
+      m_args(std::move(args)),
+      m_value_id(value_id)
+    {}
+
+    ArgumentValueIterator& ArgumentValueIterator::operator++()
+    {
+        ++m_iterator;
+        return *this;
+    }
+
+    ArgumentValueIterator ArgumentValueIterator::operator++(int) &
+    {
+        auto it = *this;
+        ++m_iterator;
+        return it;
+    }
+
+    ArgumentValue ArgumentValueIterator::operator*() const
+    {
+        return {m_iterator->first, m_args,
+                m_value_id, m_iterator->second};
+    }
+
+    ArgumentValueIterator::It ArgumentValueIterator::internal_iterator() const
+    {
+        return m_iterator;
+    }
+
+    bool operator==(const ArgumentValueIterator& a, const ArgumentValueIterator& b)
+    {
+        return a.internal_iterator() == b.internal_iterator();
+    }
+
+    bool operator!=(const ArgumentValueIterator& a, const ArgumentValueIterator& b)
+    {
+        return a.internal_iterator() != b.internal_iterator();
+    }
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
+    {
+        ArgumentId get_argument_id(
+            const std::vector<std::pair<std::string_view, ArgumentId>>& values)
+        {
+            if (values.empty())
+                return {};
+            for (auto it = next(values.begin()); it != values.end(); ++it)
+            {
+                if (it->second != prev(it)->second)
+                    return {};
+            }
+            return values.front().second;
+        }
+
+        void error(const ArgumentValues& values, std::string_view value)
+        {
+            values.error("Invalid value: " + std::string(value) + ".");
+        }
+
+        template <typename T>
+        std::vector<T> parse_floats(const ArgumentValues& values,
+                                    const std::vector<T>& default_value)
+        {
+            if (values.empty())
+                return default_value;
+
+            std::vector<T> result;
+            result.reserve(values.size());
+            for (auto& v : values.raw_values())
+            {
+                auto value = parse_floating_point<T>(v);
+                if (!value)
+                    error(values, v);
+                else
+                    result.push_back(*value);
+            }
+            return result;
+        }
+
+        template <typename T>
+        std::vector<T> get_typed_values(const std::vector<TypedValue>& values,
+                                        T TypedValue::* member)
+        {
+            std::vector<T> result;
+            result.reserve(values.size());
+            for (const auto& value : values)
+                result.push_back(value.*member);
+            return result;
+        }
+
+        std::vector<SplitChunks> split_all_chunks(
+            const std::vector<std::pair<std::string_view, ArgumentId>>& values,
+            char separator,
+            unsigned thread_count)
+        {
+            std::vector<SplitChunks> result;
+            result.reserve(values.size());
+            for (const auto& [value, _] : values)
+                result.push_back(split_chunks(value, separator, thread_count));
+            return result;
+        }
+
+        size_t count_parts(const std::vector<SplitChunks>& chunks)
+        {
+            size_t count = 0;
+            for (const auto& c : chunks)
+                count += c.count;
+            return count;
+        }
+
+        template <typename T>
+        void convert_all_chunks(const ArgumentValues& values,
+                                const std::vector<SplitChunks>& chunks,
+                                char separator,
+                                T* out)
+        {
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                if (const auto part = convert_chunks(chunks[i], separator, out))
+                    values.value(i).error("Invalid value: " + std::string(*part) + ".");
+                out += chunks[i].count;
+            }
+        }
+
+        template <typename T>
+        std::vector<T> parse_integers(const ArgumentValues& values,
+                                      const std::vector<T>& default_value,
+                                      int base)
+        {
+            if (values.empty())
+                return default_value;
+
+            std::vector<T> result;
+            result.reserve(values.size());
+            for (auto& v : values.raw_values())
+            {
+                auto value = parse_integer<T>(v, base);
+                if (!value)
+                    error(values, v);
+                else
+                    result.push_back(*value);
+            }
+            return result;
+        }
+    }
+
+    ArgumentValues::ArgumentValues(
+            std::vector<std::pair<std::string_view, ArgumentId>> values,
+            std::shared_ptr<ParsedArgumentsImpl> args,
+            ValueId value_id,
+            ValueType value_type,
+            std::vector<TypedValue> typed_values)
+        : m_values(std::move(values)),
+          m_args(std::move(args)),
+          m_value_id(value_id),
+          m_value_type(value_type),
+          m_typed_values(std::move(typed_values))
+    {
+        if (m_typed_values.size() != m_values.size())
+            m_value_type = ValueType::STRING;
+    }
+
+    ArgumentValues::ArgumentValues(const ArgumentValues&) = default;
+
+    ArgumentValues::ArgumentValues(ArgumentValues&&) noexcept = default;
+
+    ArgumentValues::~ArgumentValues() = default;
+
+    ArgumentValues&
+    ArgumentValues::operator=(const ArgumentValues&) = default;
+
+    ArgumentValues&
+    ArgumentValues::operator=(ArgumentValues&&) noexcept = default;
+
+    ArgumentValues::operator bool() const
+    {
+        return !m_values.empty();
+    }
+
+    ArgumentValue ArgumentValues::operator[](size_t index) const
+    {
+        return value(index);
+    }
+
+    std::vector<std::unique_ptr<IArgumentView>>
+    ArgumentValues::arguments() const
+    {
+        return m_args->get_argument_views(m_value_id);
+    }
+
+    void ArgumentValues::error(const std::string& message) const
+    {
+        m_args->error(message, get_argument_id(m_values));
+    }
+
+    bool ArgumentValues::empty() const
+    {
+        return m_values.empty();
+    }
+
+    size_t ArgumentValues::size() const
+    {
+        return m_values.size();
+    }
+
+    std::vector<ArgumentValue> ArgumentValues::values() const
+    {
+        std::vector<ArgumentValue> result;
+        result.reserve(m_values.size());
+        for (size_t i = 0; i < m_values.size(); ++i)
+            result.push_back(value(i));
+        return result;
+    }
+
+    std::vector<std::string_view> ArgumentValues::raw_values() const
+    {
+        std::vector<std::string_view> result;
+        result.reserve(m_values.size());
+        for (const auto& [value, _] : m_values)
+            result.push_back(value);
+        return result;
+    }
+
+    ArgumentValue ArgumentValues::value(size_t index) const
+    {
+        if (m_values.empty())
+            return {{}, m_args, m_value_id, {}};
+
+        const auto& [value, arg_id] = m_values.at(index);
+        if (m_value_type == ValueType::STRING)
+            return {value, m_args, m_value_id, arg_id};
+        return {value, m_args, m_value_id, arg_id,
+                m_value_type, m_typed_values[index]};
+    }
+
+    ValuesView<std::string_view> ArgumentValues::view() const &
+    {
+        return ValuesView<std::string_view>(
+            {m_values, m_typed_values, m_value_type, m_args.get()});
+    }
+
+    std::vector<int>
+    ArgumentValues::as_ints(const std::vector<int>& default_value,
+                            int base) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::INT && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::int_value);
+        return parse_integers<int>(*this, default_value, base);
+    }
+
+    std::vector<unsigned>
+    ArgumentValues::as_uints(const std::vector<unsigned>& default_value,
+                             int base) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::UINT && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::uint_value);
+        return parse_integers<unsigned>(*this, default_value, base);
+    }
+
+    std::vector<long>
+    ArgumentValues::as_longs(const std::vector<long>& default_value,
+                             int base) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::LONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::long_value);
+        return parse_integers<long>(*this, default_value, base);
+    }
+
+    std::vector<long long>
+    ArgumentValues::as_llongs(const std::vector<long long>& default_value,
+                              int base) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::LLONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::llong_value);
+        return parse_integers<long long>(*this, default_value, base);
+    }
+
+    std::vector<unsigned long>
+    ArgumentValues::as_ulongs(const std::vector<unsigned long>& default_value,
+                              int base) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::ULONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::ulong_value);
+        return parse_integers<unsigned long>(*this, default_value, base);
+    }
+
+    std::vector<unsigned long long> ArgumentValues::as_ullongs(
+        const std::vector<unsigned long long>& default_value,
+        int base) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::ULLONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::ullong_value);
+        return parse_integers<unsigned long long>(*this, default_value, base);
+    }
+
+    std::vector<float>
+    ArgumentValues::as_floats(const std::vector<float>& default_value) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::FLOAT)
+            return get_typed_values(m_typed_values, &TypedValue::float_value);
+        return parse_floats(*this, default_value);
+    }
+
+    std::vector<double>
+    ArgumentValues::as_doubles(const std::vector<double>& default_value) const
+    {
+        if (!m_values.empty() && m_value_type == ValueType::DOUBLE)
+            return get_typed_values(m_typed_values, &TypedValue::double_value);
+        return parse_floats(*this, default_value);
+    }
+
+    std::vector<int>
+    ArgumentValues::as_choices(const std::vector<int>& default_value) const
+    {
+        if (m_values.empty())
+            return default_value;
+
+        std::vector<int> result;
+        result.reserve(m_values.size());
+        if (m_value_type == ValueType::CHOICE)
+        {
+            for (const auto& value : m_typed_values)
+                result.push_back(int(value.uint_value));
+            return result;
+        }
+
+        const auto* choices = m_args ? m_args->get_choices(m_value_id) : nullptr;
+        if (!choices)
+            ARGOS_THROW("The values don't have any choices.");
+        for (const auto& [value, _] : m_values)
+        {
+            const auto index = choices->find(value);
+            if (!index)
+                argos::error(*this, value);
+            result.push_back(int(*index));
+        }
+        return result;
+    }
+
+    template <SplitNumber T>
+    std::vector<T>
+    ArgumentValues::split_as(char separator, unsigned thread_count) const
+    {
+        const auto chunks = split_all_chunks(m_values, separator, thread_count);
+        std::vector<T> result(count_parts(chunks));
+        convert_all_chunks(*this, chunks, separator, result.data());
+        return result;
+    }
+
+    template <SplitNumber T>
+    size_t ArgumentValues::split_into(std::span<T> buffer, char separator,
+                                      unsigned thread_count) const
+    {
+        const auto chunks = split_all_chunks(m_values, separator, thread_count);
+        const auto count = count_parts(chunks);
+        if (count > buffer.size())
+        {
+            error("Too many values: " + std::to_string(count)
+                  + ". The maximum is " + std::to_string(buffer.size()) + ".");
+        }
+        convert_all_chunks(*this, chunks, separator, buffer.data());
+        return count;
+    }
+
+#define ARGOS_SPLIT_NUMBERS(type) \
+    template std::vector<type> \
+    ArgumentValues::split_as<type>(char, unsigned) const; \
+    template size_t \
+    ArgumentValues::split_into<type>(std::span<type>, char, unsigned) const
+
+    ARGOS_SPLIT_NUMBERS(int);
+    ARGOS_SPLIT_NUMBERS(unsigned);
+    ARGOS_SPLIT_NUMBERS(long);
+    ARGOS_SPLIT_NUMBERS(long long);
+    ARGOS_SPLIT_NUMBERS(unsigned long);
+    ARGOS_SPLIT_NUMBERS(unsigned long long);
+    ARGOS_SPLIT_NUMBERS(float);
+    ARGOS_SPLIT_NUMBERS(double);
+
+#undef ARGOS_SPLIT_NUMBERS
+
+    std::vector<std::string> ArgumentValues::as_strings(
+            const std::vector<std::string>& default_value) const
+    {
+        if (m_values.empty())
+            return default_value;
+
+        std::vector<std::string> result;
+        result.reserve(m_values.size());
+        for (const auto& [value, _] : m_values)
+            result.emplace_back(value);
+        return result;
+    }
+
+    ArgumentValues
+    ArgumentValues::split(char separator,
+                          size_t min_parts, size_t max_parts) const
+    {
+        std::vector<std::pair<std::string_view, ArgumentId>> values;
+        for (auto [value, arg_id] : m_values)
+        {
+            auto parts = split_string(value, separator, max_parts - 1);
+            if (parts.size() < min_parts)
+            {
+                error("Invalid value: \"" + std::string(value)
+                      + "\". Must be at least " + std::to_string(min_parts)
+                      + " values separated by \"" + separator + "\".");
+            }
+            for (auto& part : parts)
+                values.emplace_back(part, arg_id);
+        }
+        return {std::move(values), m_args, m_value_id};
+    }
+
+    ArgumentValues
+    ArgumentValues::split_n(char separator, size_t num_parts) const
+    {
+        return split(separator, num_parts, num_parts);
+    }
+
+    ArgumentValueIterator ArgumentValues::begin() const
+    {
+        return {m_values.begin(), m_args, m_value_id};
+    }
+
+    ArgumentValueIterator ArgumentValues::end() const
+    {
+        return {m_values.end(), m_args, m_value_id};
+    }
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-28.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    ArgumentView::ArgumentView(const ArgumentData* data)
+            : m_argument(data)
+    {
+        if (!data)
+            ARGOS_THROW("data can not be null");
+    }
+
+    std::string ArgumentView::help() const
+    {
+        return get_text(m_argument->help);
+    }
+
+    const std::string& ArgumentView::section() const
+    {
+        return m_argument->section;
+    }
+
+    const std::string& ArgumentView::alias() const
+    {
+        return m_argument->alias;
+    }
+
+    Visibility ArgumentView::visibility() const
+    {
+        return m_argument->visibility;
+    }
+
+    int ArgumentView::id() const
+    {
+        return m_argument->id;
+    }
+
+    const std::string& ArgumentView::name() const
+    {
+        return m_argument->name;
+    }
+
+    bool ArgumentView::optional() const
+    {
+        return m_argument->min_count == 0;
+    }
+
+    std::pair<unsigned, unsigned> ArgumentView::count() const
+    {
+        return {m_argument->min_count, m_argument->max_count};
+    }
+
+    ValueId ArgumentView::value_id() const
+    {
+        return m_argument->value_id;
+    }
+
+    ArgumentId ArgumentView::argument_id() const
+    {
+        return m_argument->argument_id;
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    class ParsedArgumentsImpl;
+
+    /**
+     * @brief Parses many command lines with the same parser on a number
+     *  of threads.
+     *
+     * The command lines are split into chunks that are distributed
+     * evenly among the threads. A thread that runs out of chunks steals
+     * half of the remaining chunks of another thread.
+     */
+    class BatchParser
+    {
+    public:
+        BatchParser(std::shared_ptr<const ParserData> data,
+                    BatchParseCallback callback);
+
+        [[nodiscard]] std::vector<BatchParseResult>
+        parse(std::span<const ArgumentSource> sources,
+              unsigned thread_count) const;
+    private:
+        /**
+         * The state each thread reuses from one command line to the
+         * next.
+         */
+        struct Scratch
+        {
+            std::shared_ptr<ParsedArgumentsImpl> result;
+        };
+
+        void parse(ArgumentSource source,
+                   Scratch& scratch,
+                   size_t index,
+                   BatchParseResult& result) const;
+
+        std::shared_ptr<const ParserData> m_data;
+        BatchParseCallback m_callback;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+#include <thread>
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t CHUNK_SIZE = 32;
+
+        /**
+         * @brief The chunks that remain for each thread.
+         *
+         * Each thread's chunks are a range [begin, end) packed into a
+         * single atomic 64-bit integer. The owner takes chunks from the
+         * front, other threads steal from the back. Chunks are never
+         * given back, which means a range that is seen to be empty
+         * stays empty until its owner steals a new one.
+         */
+        class ChunkRanges
+        {
+        public:
+            ChunkRanges(size_t chunk_count, unsigned thread_count)
+                : m_ranges(thread_count)
+            {
+                for (unsigned i = 0; i < thread_count; ++i)
+                {
+                    m_ranges[i].bounds = pack(
+                        uint32_t(chunk_count * i / thread_count),
+                        uint32_t(chunk_count * (i + 1) / thread_count));
+                }
+            }
+
+            /**
+             * @brief Gets the next chunk for @a thread, from its own
+             *  range or from the range of another thread.
+             */
+            bool next(unsigned thread, size_t& chunk)
+            {
+                return pop_front(thread, chunk) || steal(thread, chunk);
+            }
+        private:
+            struct alignas(64) Range
+            {
+                std::atomic<uint64_t> bounds;
+            };
+
+            static uint64_t pack(uint32_t begin, uint32_t end)
+            {
+                return uint64_t(begin) << 32 | end;
+            }
+
+            static std::pair<uint32_t, uint32_t> unpack(uint64_t bounds)
+            {
+                return {uint32_t(bounds >> 32), uint32_t(bounds)};
+            }
+
+            bool pop_front(unsigned thread, size_t& chunk)
+            {
+                auto& bounds = m_ranges[thread].bounds;
+                auto value = bounds.load();
+                while (true)
+                {
+                    const auto [begin, end] = unpack(value);
+                    if (begin >= end)
+                        return false;
+                    if (bounds.compare_exchange_weak(value, pack(begin + 1, end)))
+                    {
+                        chunk = begin;
+                        return true;
+                    }
+                }
+            }
+
+            bool steal(unsigned thread, size_t& chunk)
+            {
+                const auto n = unsigned(m_ranges.size());
+                for (unsigned i = 1; i < n; ++i)
+                {
+                    auto& victim = m_ranges[(thread + i) % n].bounds;
+                    auto value = victim.load();
+                    while (true)
+                    {
+                        const auto [begin, end] = unpack(value);
+                        if (begin >= end)
+                            break;
+                        const auto mid = begin + (end - begin) / 2;
+                        if (victim.compare_exchange_weak(value, pack(begin, mid)))
+                        {
+                            chunk = mid;
+                            m_ranges[thread].bounds = pack(mid + 1, end);
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            std::vector<Range> m_ranges;
+        };
+    }
+
+    BatchParser::BatchParser(std::shared_ptr<const ParserData> data,
+                             BatchParseCallback callback)
+        : m_data(std::move(data)),
+          m_callback(std::move(callback))
+    {}
+
+    std::vector<BatchParseResult>
+    BatchParser::parse(std::span<const ArgumentSource> sources,
+                       unsigned thread_count) const
+    {
+        std::vector<BatchParseResult> results(sources.size());
+        const auto chunk_count = (sources.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        if (chunk_count > UINT32_MAX)
+            ARGOS_THROW("Too many command lines in batch.");
+
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        thread_count = unsigned(std::min<size_t>(thread_count, chunk_count));
+        if (thread_count == 0)
+            return results;
+
+        ChunkRanges ranges(chunk_count, thread_count);
+        std::atomic<bool> stop = false;
+#if ARGOS_EXCEPTIONS
+        std::mutex mutex;
+        std::exception_ptr exception;
+#endif
+
+        auto work = [&](unsigned thread)
+        {
+#if ARGOS_EXCEPTIONS
+            try
+            {
+#endif
+                Scratch scratch;
+                size_t chunk;
+                while (!stop && ranges.next(thread, chunk))
+                {
+                    const auto end = std::min((chunk + 1) * CHUNK_SIZE,
+                                              sources.size());
+                    for (auto i = chunk * CHUNK_SIZE; i < end; ++i)
+                        parse(sources[i], scratch, i, results[i]);
+                }
+#if ARGOS_EXCEPTIONS
+            }
+            catch (...)
+            {
+                // Exceptions from the batch callback, or other
+                // exceptions than ArgosException from option and
+                // argument callbacks.
+                std::lock_guard lock(mutex);
+                if (!exception)
+                    exception = std::current_exception();
+                stop = true;
+            }
+#endif
+        };
+
+        // If creating a thread throws, the destructors of the jthreads
+        // join the ones that are already running.
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1);
+        for (unsigned i = 1; i < thread_count; ++i)
+            threads.emplace_back(work, i);
+        work(0);
+        for (auto& thread : threads)
+            thread.join();
+
+#if ARGOS_EXCEPTIONS
+        if (exception)
+            std::rethrow_exception(exception);
+#endif
+        return results;
+    }
+
+    void BatchParser::parse(ArgumentSource source,
+                            Scratch& scratch,
+                            size_t index,
+                            BatchParseResult& result) const
+    {
+        // The previous result can only be reused if the callback
+        // didn't keep it.
+        auto& impl = scratch.result;
+        if (impl && impl.use_count() == 1 && !impl->has_shared_subcommands())
+            impl->clear();
+        else
+            impl = std::make_shared<ParsedArgumentsImpl>(&m_data->command, m_data);
+
+        ParseError error;
+        ArgumentIteratorImpl::parse_silently(source, m_data, impl, error);
+        result.result_code = impl->result_code();
+        if (error)
+            result.error_message = error.message();
+        if (m_callback)
+            m_callback(index, ParsedArguments(impl));
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    ChoiceSet::ChoiceSet() = default;
+
+    ChoiceSet::ChoiceSet(std::vector<std::string> values)
+        : m_values(std::move(values))
+    {}
+
+    bool ChoiceSet::empty() const
+    {
+        return m_values.empty();
+    }
+
+    const std::vector<std::string>& ChoiceSet::values() const
+    {
+        return m_values;
+    }
+
+    void ChoiceSet::build_index(bool case_insensitive)
+    {
+        m_case_insensitive = case_insensitive;
+        init_hash_slots(m_table, m_values.size());
+        for (size_t i = 0; i < m_values.size(); ++i)
+        {
+            if (find(m_values[i]))
+                ARGOS_THROW("Choice listed more than once: " + m_values[i]);
+            insert_hash_slot(m_table, hash(m_values[i]), i);
+        }
+    }
+
+    std::optional<size_t> ChoiceSet::find(std::string_view value) const
+    {
+        return find_hash_slot(m_table, hash(value), [&](size_t i)
+        {
+            return are_equal(m_values[i], value, m_case_insensitive);
+        });
+    }
+
+    uint32_t ChoiceSet::hash(std::string_view value) const
+    {
+        return hash_string(value, m_case_insensitive);
+    }
+}
+
+//****************************************************************************
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-09-04.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    Command::Command()
+        : data_(std::make_unique<CommandData>())
+    {}
+
+    Command::Command(std::string name)
+        : data_(std::make_unique<CommandData>())
+    {
+        data_->name = std::move(name);
+    }
+
+    Command::Command(const Command& rhs)
+        : data_(rhs.data_ ? std::make_unique<CommandData>(*rhs.data_) : nullptr)
+    {
+    }
+
+    Command::Command(Command&& rhs) noexcept
+        : data_(std::move(rhs.data_))
+    {
+    }
+
+    Command::~Command() = default;
+
+    Command& Command::operator=(const Command& rhs)
+    {
+        if (this != &rhs)
+        {
+            data_ = rhs.data_
+                        ? std::make_unique<CommandData>(*rhs.data_)
+                        : nullptr;
+        }
+        return *this;
+    }
+
+    Command& Command::operator=(Command&& rhs) noexcept
+    {
+        data_ = std::move(rhs.data_);
+        return *this;
+    }
+
+    Command& Command::add(Argument& argument)
+    {
+        return add(std::move(argument));
+    }
+
+    Command& Command::add(Argument&& argument)
+    {
+        check_command();
+        data_->add(argument.release());
+        return *this;
+    }
+
+    Command& Command::add(Argument& argument, ValueHandle& handle)
+    {
+        return add(std::move(argument), handle);
+    }
+
+    Command& Command::add(Argument&& argument, ValueHandle& handle)
+    {
+        check_command();
+        const auto index = unsigned(data_->arguments.size());
+        data_->add(argument.release());
+        handle = ValueHandle(data_->handle_id, false, index);
+        return *this;
+    }
+
+    Command& Command::add(Option& option)
+    {
+        return add(std::move(option));
+    }
+
+    Command& Command::add(Option&& option)
+    {
+        check_command();
+        data_->add(option.release());
+        return *this;
+    }
+
+    Command& Command::add(Option& option, ValueHandle& handle)
+    {
+        return add(std::move(option), handle);
+    }
+
+    Command& Command::add(Option&& option, ValueHandle& handle)
+    {
+        check_command();
+        const auto index = unsigned(data_->options.size());
+        data_->add(option.release());
+        handle = ValueHandle(data_->handle_id, true, index);
+        return *this;
+    }
+
+    Command& Command::add(Command& command)
+    {
+        return add(std::move(command));
+    }
+
+    Command& Command::add(Command&& command)
+    {
+        check_command();
+        data_->add(command.release());
+        return *this;
+    }
+
+    Command& Command::name(std::string name)
+    {
+        check_command();
+        data_->name = std::move(name);
+        return *this;
+    }
+
+    Command& Command::help(std::string text)
+    {
+        check_command();
+        data_->texts[TextId::HELP] = std::move(text);
+        return *this;
+    }
+
+    Command& Command::about(std::string text)
+    {
+        check_command();
+        data_->texts[TextId::ABOUT] = std::move(text);
+        return *this;
+    }
+
+    Command& Command::section(std::string name)
+    {
+        check_command();
+        data_->section = std::move(name);
+        return *this;
+    }
+
+    Command& Command::current_section(std::string name)
+    {
+        check_command();
+        data_->current_section = std::move(name);
+        return *this;
+    }
+
+    Command& Command::text(TextId textId, std::string text)
+    {
+        check_command();
+        data_->texts[textId] = std::move(text);
+        return *this;
+    }
+
+    Command& Command::text(TextId textId, std::function<std::string()> callback)
+    {
+        check_command();
+        data_->texts[textId] = std::move(callback);
+        return *this;
+    }
+
+    Command& Command::visibility(Visibility visibility)
+    {
+        check_command();
+        data_->visibility = visibility;
+        return *this;
+    }
+
+    Command& Command::id(int id)
+    {
+        check_command();
+        data_->id = id;
+        return *this;
+    }
+
+    Command& Command::allow_multiple_subcommands(bool multi_command)
+    {
+        check_command();
+        data_->multi_command = multi_command;
+        return *this;
+    }
+
+    Command& Command::require_subcommand(bool require_subcommand)
+    {
+        check_command();
+        data_->require_subcommand = require_subcommand;
+        return *this;
+    }
+
+    Command& Command::lazy_definition(std::function<void(Command&)> callback)
+    {
+        check_command();
+        if (!callback)
+            ARGOS_THROW("The lazy definition callback is empty.");
+        data_->lazy_definition = std::make_unique<LazyDefinition>(std::move(callback));
+        return *this;
+    }
+
+    Command& Command::copy_from(Command& command)
+    {
+        check_command();
+        data_->copy_from(*command.data_);
+        return *this;
+    }
+
+    Command& Command::mutually_exclusive(std::vector<std::string> names)
+    {
+        check_command();
+        data_->add_constraint(ConstraintType::MUTUALLY_EXCLUSIVE,
+                              std::move(names));
+        return *this;
+    }
+
+    Command& Command::at_least_one_of(std::vector<std::string> names)
+    {
+        check_command();
+        data_->add_constraint(ConstraintType::AT_LEAST_ONE_OF,
+                              std::move(names));
+        return *this;
+    }
+
+    Command& Command::depends_on(std::string name,
+                                 std::vector<std::string> names)
+    {
+        check_command();
+        names.insert(names.begin(), std::move(name));
+        data_->add_constraint(ConstraintType::DEPENDS_ON,
+                              std::move(names));
+        return *this;
+    }
+
+    Command& Command::conflicts_with(std::string name,
+                                     std::vector<std::string> names)
+    {
+        check_command();
+        names.insert(names.begin(), std::move(name));
+        data_->add_constraint(ConstraintType::CONFLICTS_WITH,
+                              std::move(names));
+        return *this;
+    }
+
+    std::unique_ptr<CommandData> Command::release()
+    {
+        return std::move(data_);
+    }
+
+    const CommandData& Command::internal_ref() const
+    {
+        check_command();
+        return *data_;
+    }
+
+    void Command::check_command() const
+    {
+        if (!data_)
+            ARGOS_THROW("Command has been moved.");
+    }
+}
+
+//****************************************************************************
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-09-05.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    constexpr char DEFAULT_HELP_TEXT[] = "Display this help text.";
+
+    namespace
+    {
+        std::unique_ptr<LazyDefinition>
+        copy_lazy_definition(const std::unique_ptr<LazyDefinition>& lazy)
+        {
+            // A lazy definition that has been used is already part of the
+            // copied command.
+            if (!lazy || !lazy->callback)
+                return {};
+            return std::make_unique<LazyDefinition>(lazy->callback);
+        }
+
+        unsigned make_handle_id()
+        {
+            static std::atomic<unsigned> next_id = 0;
+            return ++next_id;
+        }
+    }
+
+    LazyDefinition::LazyDefinition(std::function<void(Command&)> callback)
+        : callback(std::move(callback))
+    {}
+
+    CommandData::CommandData()
+        : handle_id(make_handle_id())
+    {}
+
+    CommandData::CommandData(const CommandData& rhs)
+        : constraints(rhs.constraints),
+          current_section(rhs.current_section),
+          name(rhs.name),
+          full_name(rhs.full_name),
+          texts(rhs.texts),
+          require_subcommand(rhs.require_subcommand),
+          multi_command(rhs.multi_command),
+          section(rhs.section),
+          id(rhs.id),
+          argument_id(rhs.argument_id),
+          handle_id(rhs.handle_id),
+          lazy_definition(copy_lazy_definition(rhs.lazy_definition))
+    {
+        arguments.reserve(rhs.arguments.size());
+        for (const auto& a : rhs.arguments)
+            arguments.push_back(std::make_unique<ArgumentData>(*a));
+        options.reserve(rhs.options.size());
+        for (const auto& o : rhs.options)
+            options.push_back(std::make_unique<OptionData>(*o));
+        commands.reserve(rhs.commands.size());
+        for (const auto& c : rhs.commands)
+            commands.push_back(std::make_unique<CommandData>(*c));
+    }
+
+    CommandData::CommandData(CommandData&& rhs) noexcept
+        : arguments(std::move(rhs.arguments)),
+          options(std::move(rhs.options)),
+          commands(std::move(rhs.commands)),
+          constraints(std::move(rhs.constraints)),
+          current_section(std::move(rhs.current_section)),
+          name(std::move(rhs.name)),
+          full_name(std::move(rhs.full_name)),
+          texts(std::move(rhs.texts)),
+          require_subcommand(rhs.require_subcommand),
+          multi_command(rhs.multi_command),
+          section(std::move(rhs.section)),
+          id(rhs.id),
+          argument_id(rhs.argument_id),
+          handle_id(rhs.handle_id),
+          lazy_definition(std::move(rhs.lazy_definition))
+    {
+    }
+
+    CommandData::~CommandData() = default;
+
+    CommandData& CommandData::operator=(const CommandData& rhs)
+    {
+        if (&rhs == this)
+            return *this;
+        constraints = rhs.constraints;
+        current_section = rhs.current_section;
+        name = rhs.name;
+        full_name = rhs.full_name;
+        texts = rhs.texts;
+        require_subcommand = rhs.require_subcommand;
+        multi_command = rhs.multi_command;
+        section = rhs.section;
+        id = rhs.id;
+        argument_id = rhs.argument_id;
+        handle_id = rhs.handle_id;
+        lazy_definition = copy_lazy_definition(rhs.lazy_definition);
+
+        arguments.clear();
+        arguments.reserve(rhs.arguments.size());
+        for (const auto& a : rhs.arguments)
+            arguments.push_back(std::make_unique<ArgumentData>(*a));
+
+        options.clear();
+        options.reserve(rhs.options.size());
+        for (const auto& o : rhs.options)
+            options.push_back(std::make_unique<OptionData>(*o));
+
+        commands.clear();
+        commands.reserve(rhs.commands.size());
+        for (const auto& c : rhs.commands)
+            commands.push_back(std::make_unique<CommandData>(*c));
+
+        return *this;
+    }
+
+    CommandData& CommandData::operator=(CommandData&& rhs) noexcept
+    {
+        if (&rhs == this)
+            return *this;
+
+        current_section = std::move(rhs.current_section);
+        name = std::move(rhs.name);
+        full_name = std::move(rhs.full_name);
+        texts = std::move(rhs.texts);
+        arguments = std::move(rhs.arguments);
+        options = std::move(rhs.options);
+        commands = std::move(rhs.commands);
+        constraints = std::move(rhs.constraints);
+        require_subcommand = rhs.require_subcommand;
+        multi_command = rhs.multi_command;
+        section = std::move(rhs.section);
+        id = rhs.id;
+        argument_id = rhs.argument_id;
+        handle_id = rhs.handle_id;
+        lazy_definition = std::move(rhs.lazy_definition);
+        return *this;
+    }
+
+    void CommandData::add(std::unique_ptr<ArgumentData> arg)
+    {
+        if (!arg)
+            ARGOS_THROW("Argument is empty (it has probably already been added).");
+        if (!commands.empty())
+            ARGOS_THROW("A command cannot have both arguments and subcommands.");
+        if (arg->name.empty())
+            ARGOS_THROW("Argument must have a name.");
+        if (arg->section.empty())
+            arg->section = current_section;
+        arguments.emplace_back(std::move(arg));
+    }
+
+    void CommandData::add(std::unique_ptr<OptionData> opt)
+    {
+        if (!opt)
+            ARGOS_THROW("Option is empty (it has probably already been added).");
+        if (opt->flags.empty())
+            ARGOS_THROW("Option must have at least one flag.");
+        if (opt->section.empty())
+            opt->section = current_section;
+        options.push_back(std::move(opt));
+    }
+
+    void CommandData::add(std::unique_ptr<CommandData> cmd)
+    {
+        if (!cmd)
+            ARGOS_THROW("Command is empty (it has probably already been added).");
+        if (!arguments.empty())
+            ARGOS_THROW("A command cannot have both arguments and subcommands.");
+        if (cmd->name.empty())
+            ARGOS_THROW("Command must have a name.");
+        if (cmd->section.empty())
+            cmd->section = current_section;
+        commands.push_back(std::move(cmd));
+    }
+
+    void CommandData::add_constraint(ConstraintType type,
+                                     std::vector<std::string> names)
+    {
+        switch (type)
+        {
+        case ConstraintType::MUTUALLY_EXCLUSIVE:
+            if (names.size() < 2)
+                ARGOS_THROW("A mutually exclusive group must have at least two names.");
+            break;
+        case ConstraintType::AT_LEAST_ONE_OF:
+            if (names.empty())
+                ARGOS_THROW("An at-least-one-of group must have at least one name.");
+            break;
+        case ConstraintType::DEPENDS_ON:
+        case ConstraintType::CONFLICTS_WITH:
+            if (names.size() < 2)
+                ARGOS_THROW("A dependency or conflict must have at least two names.");
+            break;
+        }
+        constraints.push_back({type, std::move(names)});
+    }
+
+    void CommandData::copy_from(const CommandData& cmd)
+    {
+        if (cmd.lazy_definition && cmd.lazy_definition->callback)
+        {
+            Command definition(cmd.name);
+            cmd.lazy_definition->callback(definition);
+            copy_from(*definition.release());
+        }
+
+        for (const auto& a : cmd.arguments)
+            arguments.push_back(std::make_unique<ArgumentData>(*a));
+
+        for (const auto& o : cmd.options)
+            options.push_back(std::make_unique<OptionData>(*o));
+
+        for (const auto& c : cmd.commands)
+            commands.push_back(std::make_unique<CommandData>(*c));
+
+        constraints.insert(constraints.end(), cmd.constraints.begin(),
+                           cmd.constraints.end());
+
+        for (const auto& [text_id, source] : cmd.texts)
+        {
+            if (texts.contains(text_id))
+                ARGOS_THROW("Text with ID " + to_string(text_id) + " already exists.");
+            texts.emplace(text_id, source);
+        }
+
+        if (!multi_command)
+            multi_command = cmd.multi_command;
+    }
+
+    void CommandData::add_definition(CommandData&& cmd)
+    {
+        // The handles that were created along with the definition are
+        // valid for this command if the indexes are the same.
+        if (arguments.empty() && options.empty())
+            handle_id = cmd.handle_id;
+        for (auto& a : cmd.arguments)
+            add(std::move(a));
+        for (auto& o : cmd.options)
+            add(std::move(o));
+        for (auto& c : cmd.commands)
+            add(std::move(c));
+        for (auto& c : cmd.constraints)
+            constraints.push_back(std::move(c));
+        if (!require_subcommand)
+            require_subcommand = cmd.require_subcommand;
+        if (!multi_command)
+            multi_command = cmd.multi_command;
+    }
+
+    void CommandData::build_option_index(bool case_insensitive)
+    {
+        std::vector<std::pair<std::string_view, const OptionData*>> index;
+        for (auto& option : options)
+        {
+            for (auto& flag : option->flags)
+                index.emplace_back(flag, option.get());
+        }
+
+        sort(index.begin(), index.end(), [&](const auto& a, const auto& b)
+        {
+            return is_less(a.first, b.first, case_insensitive);
+        });
+
+        const auto it = adjacent_find(
+            index.begin(), index.end(),
+            [&](const auto& a, const auto& b)
+            {
+                return are_equal(a.first, b.first, case_insensitive);
+            });
+
+        if (it == index.end())
+        {
+            option_index = OptionTrie(std::move(index), case_insensitive);
+            return;
+        }
+
+        if (it->first == next(it)->first)
+        {
+            ARGOS_THROW("Multiple definitions of flag "
+                + std::string(it->first));
+        }
+
+        ARGOS_THROW("Conflicting flags: " + std::string(it->first)
+            + " and " + std::string(next(it)->first));
+    }
+
+    const OptionData* CommandData::find_option(std::string_view flag,
+                                               bool allow_abbreviations) const
+    {
+        return option_index.find(flag, allow_abbreviations);
+    }
+
+    void CommandData::build_command_index(bool case_insensitive)
+    {
+        command_index = CommandIndex(commands, case_insensitive);
+    }
+
+    const CommandData* CommandData::find_command(std::string_view cmd_name,
+                                                 bool allow_abbreviations) const
+    {
+        return command_index.find(cmd_name, allow_abbreviations);
+    }
+
+    void CommandData::build_value_index()
+    {
+        values = ValueIndex(arguments, options);
+    }
+
+    const ValueIndex& CommandData::value_index() const
+    {
+        return values;
+    }
+
+    void CommandData::build_constraint_checker()
+    {
+        checker = ConstraintChecker(arguments, options, constraints, values);
+    }
+
+    const ConstraintChecker& CommandData::constraint_checker() const
+    {
+        return checker;
+    }
+
+    namespace
+    {
+        void update_require_command(CommandData& cmd)
+        {
+            if (cmd.require_subcommand.value_or(false) && cmd.commands.empty())
+                ARGOS_THROW("require_command is true, but no commands have been added.");
+
+            if (!cmd.require_subcommand)
+            {
+                cmd.require_subcommand = !cmd.commands.empty();
+            }
+        }
+
+        bool has_help_option(const CommandData& cmd)
+        {
+            for (const auto& o : cmd.options)
+            {
+                if (o->type == OptionType::HELP)
+                    return true;
+            }
+            return false;
+        }
+
+        void add_help_option(CommandData& cmd, const ParserSettings& settings)
+        {
+            if (!settings.generate_help_option)
+                return;
+            if (has_help_option(cmd))
+                return;
+            std::vector<std::string> flags;
+            switch (settings.option_style)
+            {
+            case OptionStyle::STANDARD:
+                if (!has_flag(cmd, "-h", settings))
+                    flags.emplace_back("-h");
+                if (!has_flag(cmd, "--help", settings))
+                    flags.emplace_back("--help");
+                break;
+            case OptionStyle::SLASH:
+                if (!has_flag(cmd, "/?", settings))
+                    flags.emplace_back("/?");
+                break;
+            case OptionStyle::DASH:
+                if (!has_flag(cmd, "-h", settings))
+                    flags.emplace_back("-h");
+                else if (!has_flag(cmd, "-help", settings))
+                    flags.emplace_back("-help");
+                break;
+            }
+
+            if (flags.empty())
+                return;
+
+            auto opt = Option().flags(std::move(flags)).type(OptionType::HELP)
+                .help(DEFAULT_HELP_TEXT)
+                .constant("1").release();
+            opt->section = cmd.current_section;
+            cmd.options.push_back(std::move(opt));
+        }
+
+        std::pair<ValueId, ArgumentId>
+        set_internal_ids(const CommandData& cmd,
+                         ValueId value_id_offset,
+                         ArgumentId argument_id_offset)
+        {
+            struct InternalIdMaker
+            {
+                std::map<std::string_view, ValueId> explicit_ids;
+                int id;
+
+                explicit InternalIdMaker(ValueId start_id)
+                    : id(start_id)
+                {
+                }
+
+                std::optional<ValueId> find_value_id(std::string_view name)
+                {
+                    const auto it = explicit_ids.find(name);
+                    if (it == explicit_ids.end())
+                        return {};
+                    return it->second;
+                }
+
+                ValueId get_value_id(std::string_view name)
+                {
+                    if (const auto value_id = find_value_id(name))
+                        return *value_id;
+                    id++;
+                    explicit_ids.emplace(name, ValueId(id));
+                    return ValueId(id);
+                }
+
+                ValueId get_value_id(const std::vector<std::string>& names)
+                {
+                    for (const auto& name : names)
+                    {
+                        if (const auto value_id = find_value_id(name))
+                            return *value_id;
+                    }
+                    id++;
+                    for (const auto& name : names)
+                        explicit_ids.emplace(name, ValueId(id));
+                    return ValueId(id);
+                }
+            };
+
+            int argument_id = argument_id_offset;
+            InternalIdMaker id_maker(value_id_offset);
+            for (const auto& a : cmd.arguments)
+            {
+                a->argument_id = ArgumentId(++argument_id);
+                if (!a->alias.empty())
+                {
+                    a->value_id = id_maker.get_value_id(a->alias);
+                    id_maker.explicit_ids.emplace(a->name, a->value_id);
+                }
+                else
+                {
+                    a->value_id = id_maker.get_value_id(a->name);
+                }
+            }
+            for (const auto& o : cmd.options)
+            {
+                o->argument_id = ArgumentId(++argument_id);
+                if (o->operation == OptionOperation::NONE)
+                    continue;
+                if (!o->alias.empty())
+                {
+                    o->value_id = id_maker.get_value_id(o->alias);
+                    for (auto& f : o->flags)
+                        id_maker.explicit_ids.emplace(f, o->value_id);
+                }
+                else
+                {
+                    o->value_id = id_maker.get_value_id(o->flags);
+                }
+            }
+
+            return {ValueId(id_maker.id), ArgumentId(argument_id)};
+        }
+
+        /**
+         * @brief Builds the hash table for @a choices, and gives values
+         *  with choices ValueType::CHOICE unless they have another type.
+         */
+        void update_choices(ChoiceSet& choices, ValueType& type,
+                            bool has_binding, bool case_insensitive)
+        {
+            if (choices.empty())
+                return;
+            choices.build_index(case_insensitive);
+            if (type == ValueType::STRING && !has_binding)
+                type = ValueType::CHOICE;
+        }
+
+        struct ValueProperties
+        {
+            std::map<ValueId, ValueType> types;
+            std::map<ValueId, const ValueBinding*> bindings;
+            std::map<ValueId, const ChoiceSet*> choices;
+            std::map<ValueId, char> separators;
+        };
+
+        void check_value_type(ValueProperties& props,
+                              ValueId value_id,
+                              ValueType type,
+                              const ValueBinding* binding,
+                              const ChoiceSet& choices,
+                              char separator,
+                              std::string_view name)
+        {
+            if (separator != '\0')
+            {
+                const auto [it, inserted] = props.separators.emplace(value_id,
+                                                                     separator);
+                if (!inserted && it->second != separator)
+                {
+                    ARGOS_THROW("Conflicting dictionary separators for "
+                                + std::string(name) + ".");
+                }
+            }
+
+            if (!choices.empty())
+            {
+                const auto [it, inserted] = props.choices.emplace(value_id,
+                                                                  &choices);
+                if (!inserted && it->second->values() != choices.values())
+                {
+                    ARGOS_THROW("Conflicting choices for "
+                                + std::string(name) + ".");
+                }
+            }
+
+            auto& types = props.types;
+            auto& bindings = props.bindings;
+            if (binding)
+            {
+                const auto [it, inserted] = bindings.emplace(value_id, binding);
+                if (!inserted && it->second != binding)
+                {
+                    ARGOS_THROW("Conflicting bindings for "
+                                + std::string(name) + ".");
+                }
+                if (type != binding->value_type())
+                {
+                    ARGOS_THROW("Conflicting value types for "
+                                + std::string(name) + ".");
+                }
+            }
+
+            if (type == ValueType::STRING)
+                return;
+            const auto [it, inserted] = types.emplace(value_id, type);
+            if (!inserted && it->second != type)
+            {
+                ARGOS_THROW("Conflicting value types for "
+                            + std::string(name) + ".");
+            }
+        }
+
+        /**
+         * @brief Verifies that arguments and options that share a value
+         *  have the same ValueType, binding, choices and dictionary
+         *  separator, and that the constants and initial values of
+         *  options are valid values.
+         */
+        void check_value_types(const CommandData& cmd)
+        {
+            ValueProperties props;
+            for (const auto& a : cmd.arguments)
+            {
+                check_value_type(props, a->value_id, a->value_type,
+                                 a->binding.get(), a->choices, '\0',
+                                 a->name);
+            }
+            for (const auto& o : cmd.options)
+            {
+                if (o->operation == OptionOperation::NONE)
+                    continue;
+                check_value_type(props, o->value_id, o->value_type,
+                                 o->binding.get(), o->choices,
+                                 o->dictionary_separator, o->flags.front());
+            }
+
+            for (const auto& [value_id, type] : props.types)
+            {
+                if (type == ValueType::CHOICE
+                    && !props.choices.contains(value_id))
+                {
+                    ARGOS_THROW("Values of type CHOICE require a list of choices.");
+                }
+            }
+
+            for (const auto& o : cmd.options)
+            {
+                if (o->operation == OptionOperation::NONE)
+                    continue;
+                const auto type_it = props.types.find(o->value_id);
+                const auto choice_it = props.choices.find(o->value_id);
+                const auto separator_it = props.separators.find(o->value_id);
+                if (type_it == props.types.end()
+                    && choice_it == props.choices.end()
+                    && separator_it == props.separators.end())
+                {
+                    continue;
+                }
+
+                const auto type = type_it != props.types.end()
+                                      ? type_it->second
+                                      : ValueType::STRING;
+                const auto* choices = choice_it != props.choices.end()
+                                          ? choice_it->second
+                                          : nullptr;
+                const auto separator = separator_it != props.separators.end()
+                                           ? separator_it->second
+                                           : '\0';
+                auto is_valid = [&](const std::string& str)
+                {
+                    TypedValue value;
+                    return parse_typed_value(str, type, choices, value)
+                           && (separator == '\0'
+                               || str.find(separator) != std::string::npos);
+                };
+                // CLEAR-options don't use their constant.
+                if (!o->constant.empty()
+                    && o->operation != OptionOperation::CLEAR
+                    && !is_valid(o->constant))
+                {
+                    ARGOS_THROW("Invalid constant for " + o->flags.front()
+                                + ": " + o->constant);
+                }
+                if (!o->initial_value.empty() && !is_valid(o->initial_value))
+                {
+                    ARGOS_THROW("Invalid initial value for " + o->flags.front()
+                                + ": " + o->initial_value);
+                }
+            }
+        }
+
+        // NOLINT(*-no-recursion)
+        void finish_definition(CommandData& cmd,
+                               const ParserData& data,
+                               ValueId start_id,
+                               ArgumentId argument_id)
+        {
+            const auto case_insensitive = data.parser_settings.case_insensitive;
+            for (auto& o : cmd.options)
+            {
+                validate_and_update(*o, data.parser_settings.option_style);
+                update_choices(o->choices, o->value_type, bool(o->binding),
+                               case_insensitive);
+            }
+            for (auto& a : cmd.arguments)
+            {
+                update_choices(a->choices, a->value_type, bool(a->binding),
+                               case_insensitive);
+            }
+            update_require_command(cmd);
+            add_help_option(cmd, data.parser_settings);
+
+            std::tie(start_id, argument_id) = set_internal_ids(cmd, start_id, argument_id);
+            check_value_types(cmd);
+            cmd.build_value_index();
+            cmd.build_constraint_checker();
+
+            cmd.build_option_index(data.parser_settings.case_insensitive);
+            cmd.build_command_index(data.parser_settings.case_insensitive);
+            for (auto& c : cmd.commands)
+            {
+                c->full_name = cmd.name + ' ' + c->name;
+                finish_initialization(*c, data, start_id, argument_id);
+            }
+        }
+    }
+
+    bool has_flag(const CommandData& cmd,
+                  std::string_view flag,
+                  const ParserSettings& settings)
+    {
+        for (auto& o : cmd.options)
+        {
+            for (auto& f : o->flags)
+            {
+                if (are_equal(f, flag, settings.case_insensitive))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // NOLINT(*-no-recursion)
+    void finish_initialization(CommandData& cmd,
+                               const ParserData& data,
+                               ValueId start_id,
+                               ArgumentId argument_id)
+    {
+        if (cmd.full_name.empty())
+            cmd.full_name = cmd.name;
+
+        argument_id = ArgumentId(argument_id + 1);
+        cmd.argument_id = argument_id;
+
+        if (cmd.lazy_definition && cmd.lazy_definition->callback)
+        {
+            cmd.lazy_definition->data = &data;
+            cmd.lazy_definition->start_id = start_id;
+            cmd.lazy_definition->argument_id = argument_id;
+            return;
+        }
+
+        finish_definition(cmd, data, start_id, argument_id);
+    }
+
+    void CommandData::ensure_defined() const
+    {
+        if (!lazy_definition)
+            return;
+
+        auto& lazy = *lazy_definition;
+        std::call_once(lazy.once, [&]
+        {
+            if (!lazy.callback)
+                return;
+
+            Command definition(name);
+            lazy.callback(definition);
+            // The definition is completed on a copy to leave the command
+            // unchanged if it is invalid. call_once lets the next call
+            // try again (and fail the same way) if this one throws.
+            CommandData cmd(*this);
+            cmd.lazy_definition = nullptr;
+            cmd.add_definition(std::move(*definition.release()));
+            if (lazy.data)
+            {
+                finish_definition(cmd, *lazy.data, lazy.start_id, lazy.argument_id);
+                std::vector<ValueBinding*> bindings;
+                cmd.collect_bindings(bindings);
+                // Like the command, the ParserData is only const because
+                // it is shared. parse_batch() doesn't reset or guard
+                // bound variables, the bindings are refused while a
+                // batch is running.
+                if (!bindings.empty()
+                    && !const_cast<ParserData*>(lazy.data)->bindings.add(bindings))
+                {
+                    ARGOS_THROW("The sub-command \"" + name
+                                + "\" has bound variables, it can't be"
+                                  " defined by parse_batch().");
+                }
+            }
+
+            // The command is const because it is part of a shared
+            // ParserData, but only this function modifies it, and it
+            // only does so once.
+            auto& self = const_cast<CommandData&>(*this);
+            self.arguments = std::move(cmd.arguments);
+            self.options = std::move(cmd.options);
+            self.commands = std::move(cmd.commands);
+            self.constraints = std::move(cmd.constraints);
+            self.require_subcommand = cmd.require_subcommand;
+            self.multi_command = cmd.multi_command;
+            self.handle_id = cmd.handle_id;
+            self.option_index = std::move(cmd.option_index);
+            self.command_index = std::move(cmd.command_index);
+            self.values = std::move(cmd.values);
+            self.checker = std::move(cmd.checker);
+            lazy.callback = nullptr;
+            lazy.defined = true;
+        });
+    }
+
+    void CommandData::collect_bindings(std::vector<ValueBinding*>& bindings) const
+    {
+        if (lazy_definition && !lazy_definition->defined)
+            return;
+
+        const auto own_bindings = values.bindings();
+        bindings.insert(bindings.end(), own_bindings.begin(), own_bindings.end());
+        for (const auto& cmd : commands)
+            cmd->collect_bindings(bindings);
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    CommandIndex::CommandIndex() = default;
+
+    CommandIndex::CommandIndex(
+        const std::vector<std::unique_ptr<CommandData>>& commands,
+        bool case_insensitive)
+        : m_case_insensitive(case_insensitive)
+    {
+        m_index.reserve(commands.size());
+        for (const auto& cmd : commands)
+        {
+            auto& [name, command] = m_index.emplace_back(cmd->name, cmd.get());
+            for (auto& c : name)
+                c = fold(c);
+        }
+
+        std::sort(m_index.begin(), m_index.end());
+
+        const auto it = std::adjacent_find(
+            m_index.begin(), m_index.end(),
+            [](const auto& a, const auto& b) { return a.first == b.first; });
+        if (it != m_index.end())
+        {
+            ARGOS_THROW("Multiple definitions of command "
+                        + it->second->name);
+        }
+    }
+
+    const CommandData*
+    CommandIndex::find(std::string_view name, bool allow_abbreviations) const
+    {
+        // Compares like std::string's operator<, i.e. with the characters
+        // as unsigned.
+        const auto it = std::lower_bound(
+            m_index.begin(), m_index.end(), name,
+            [&](const auto& entry, std::string_view str)
+            {
+                const std::string_view key = entry.first;
+                const auto size = std::min(key.size(), str.size());
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const auto a = uint8_t(key[i]);
+                    const auto b = uint8_t(fold(str[i]));
+                    if (a != b)
+                        return a < b;
+                }
+                return key.size() < str.size();
+            });
+
+        if (it == m_index.end() || !is_prefix(name, it->first))
+            return nullptr;
+        if (it->first.size() == name.size())
+            return it->second;
+        if (!allow_abbreviations)
+            return nullptr;
+        const auto nxt = std::next(it);
+        if (nxt != m_index.end() && is_prefix(name, nxt->first))
+            return nullptr;
+        return it->second;
+    }
+
+    char CommandIndex::fold(char c) const
+    {
+        if (m_case_insensitive && 'a' <= c && c <= 'z')
+            return char(c - ('a' - 'A'));
+        return c;
+    }
+
+    bool CommandIndex::is_prefix(std::string_view name,
+                                 std::string_view key) const
+    {
+        if (key.size() < name.size())
+            return false;
+        for (size_t i = 0; i < name.size(); ++i)
+        {
+            if (key[i] != fold(name[i]))
+                return false;
+        }
+        return true;
+    }
+}
+
+//****************************************************************************
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-09-21.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    CommandView::CommandView(const CommandData* command)
+        : m_command(command)
+    {}
+
+    std::string CommandView::help() const
+    {
+        auto it = m_command->texts.find(TextId::ABOUT);
+        return it != m_command->texts.end() ? get_text(it->second) : "";
+    }
+
+    const std::string& CommandView::section() const
+    {
+        return m_command->section;
+    }
+
+    const std::string& CommandView::alias() const
+    {
+        return m_command->name;
+    }
+
+    Visibility CommandView::visibility() const
+    {
+        return m_command->visibility;
+    }
+
+    int CommandView::id() const
+    {
+        return m_command->id;
+    }
+
+    ValueId CommandView::value_id() const
+    {
+        return {};
+    }
+
+    ArgumentId CommandView::argument_id() const
+    {
+        return m_command->argument_id;
+    }
+
+    std::string CommandView::name() const
+    {
+        return m_command->name;
+    }
+
+    std::vector<ArgumentView> CommandView::arguments() const
+    {
+        m_command->ensure_defined();
+        std::vector<ArgumentView> result;
+        for (const auto& arg : m_command->arguments)
+            result.emplace_back(arg.get());
+        return result;
+    }
+
+    std::vector<OptionView> CommandView::options() const
+    {
+        m_command->ensure_defined();
+        std::vector<OptionView> result;
+        for (const auto& opt : m_command->options)
+            result.emplace_back(opt.get());
+        return result;
+    }
+
+    std::vector<CommandView> CommandView::subcommands() const
+    {
+        m_command->ensure_defined();
+        std::vector<CommandView> result;
+        for (const auto& cmd : m_command->commands)
+            result.emplace_back(cmd.get());
+        return result;
+    }
+
+    bool CommandView::require_subcommand() const
+    {
+        // Instances of CommandView are only created after require_subcommand
+        // has been automatically set, the or-value should therefore never
+        // be returned, and it doesn't matter that it might not be correct.
+        m_command->ensure_defined();
+        return m_command->require_subcommand.value_or(false);
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
+    {
+        /**
+         * @brief Keeps lazily defined sub-commands from adding bindings
+         *  while a batch is parsed.
+         */
+        class BatchGuard
+        {
+        public:
+            explicit BatchGuard(const BindingList& bindings)
+                : m_bindings(bindings)
+            {
+                m_bindings.begin_batch();
+            }
+
+            BatchGuard(const BatchGuard&) = delete;
+
+            ~BatchGuard()
+            {
+                m_bindings.end_batch();
+            }
+
+            BatchGuard& operator=(const BatchGuard&) = delete;
+        private:
+            const BindingList& m_bindings;
+        };
+    }
+
+    CompiledParser::CompiledParser(std::shared_ptr<const ParserData> data)
+        : m_data(std::move(data))
+    {
+        if (!m_data)
+            ARGOS_THROW("CompiledParser requires parser data.");
+    }
+
+    ParsedArguments CompiledParser::parse(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return parse_source({});
+        return parse_source({argv + 1, size_t(argc - 1)});
+    }
+
+    ParsedArguments
+    CompiledParser::parse(std::vector<std::string_view> args) const
+    {
+        return parse_source(ArgumentSource(args));
+    }
+
+    ParseResult CompiledParser::try_parse(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return try_parse_source({});
+        return try_parse_source({argv + 1, size_t(argc - 1)});
+    }
+
+    ParseResult
+    CompiledParser::try_parse(std::vector<std::string_view> args) const
+    {
+        return try_parse_source(ArgumentSource(args));
+    }
+
+    void CompiledParser::parse_into(ParsedArguments& result,
+                                    int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return parse_source_into(result, {});
+        parse_source_into(result, {argv + 1, size_t(argc - 1)});
+    }
+
+    ArgumentIterator CompiledParser::make_iterator(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            ARGOS_THROW("argc and argv must at least contain the command name.");
+        return make_iterator(std::vector<std::string_view>(argv + 1, argv + argc));
+    }
+
+    ArgumentIterator
+    CompiledParser::make_iterator(std::vector<std::string_view> args) const
+    {
+        return {std::move(args), m_data};
+    }
+
+    IncrementalParser CompiledParser::make_incremental_parser() const
+    {
+        return IncrementalParser(m_data);
+    }
+
+    ParsedArguments CompiledParser::parse_source(ArgumentSource args) const
+    {
+        return ParsedArguments(ArgumentIteratorImpl::parse(args, m_data));
+    }
+
+    void CompiledParser::parse_source_into(ParsedArguments& result,
+                                           ArgumentSource args) const
+    {
+        result.m_impl = ArgumentIteratorImpl::parse(args, m_data,
+                                                    reuse_or_create(result));
+    }
+
+    ParseResult CompiledParser::try_parse_source(ArgumentSource args) const
+    {
+        ParseError error;
+        auto impl = ArgumentIteratorImpl::parse_silently(args, m_data, {},
+                                                         error);
+        return {ParsedArguments(std::move(impl)), std::move(error)};
+    }
+
+    ParseError CompiledParser::try_parse_source_into(ParsedArguments& result,
+                                                     ArgumentSource args) const
+    {
+        ParseError error;
+        result.m_impl = ArgumentIteratorImpl::parse_silently(
+            args, m_data, reuse_or_create(result), error);
+        return error;
+    }
+
+    std::shared_ptr<ParsedArgumentsImpl>
+    CompiledParser::reuse_or_create(ParsedArguments& result) const
+    {
+        auto& impl = result.m_impl;
+        if (impl && impl.use_count() == 1 && impl->parser_data() == m_data
+            && !impl->has_shared_subcommands())
+        {
+            impl->clear();
+            return std::move(impl);
+        }
+        return {};
+    }
+
+    std::vector<BatchParseResult>
+    CompiledParser::parse_batch_sources(std::span<const ArgumentSource> sources,
+                                        unsigned thread_count,
+                                        const BatchParseCallback& callback) const
+    {
+        BatchGuard guard(m_data->bindings);
+        return BatchParser(m_data, callback).parse(sources, thread_count);
+    }
+
+    const std::string& CompiledParser::program_name() const
+    {
+        return m_data->command.name;
+    }
+
+    void CompiledParser::write_help_text() const
+    {
+        write_subcommand_help_text({});
+    }
+
+    void CompiledParser::write_subcommand_help_text(
+        const std::vector<std::string>& path) const
+    {
+        const auto* cmd = &m_data->command;
+        for (auto& name : path)
+        {
+            cmd = cmd->find_command(
+                name, m_data->parser_settings.allow_abbreviated_commands);
+            if (!cmd)
+                ARGOS_THROW("Unknown command: " + name);
+            cmd->ensure_defined();
+        }
+        argos::write_help_text(*m_data, *cmd);
+    }
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-10.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    unsigned get_console_width();
+
+    unsigned get_console_width(unsigned min_width, unsigned default_width = 80);
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-10.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#elif defined(WIN32)
+    #define NOMINMAX
+    #include <Windows.h>
+#endif
+
+namespace argos
+{
+#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+
+    unsigned get_console_width()
+    {
+        winsize ws = {};
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) <= -1)
+            return 0;
+        return unsigned(ws.ws_col);
+    }
+
+#elif defined(WIN32)
+
+    unsigned get_console_width()
+    {
+        const HANDLE h_con = GetStdHandle(STD_OUTPUT_HANDLE);
+        if (h_con == INVALID_HANDLE_VALUE)
+            return 0;
+
+        CONSOLE_SCREEN_BUFFER_INFO con_info;
+        if (!GetConsoleScreenBufferInfo(h_con, &con_info))
+            return 0;
+
+        return unsigned(con_info.srWindow.Right - con_info.srWindow.Left);
+    }
+
+#else
+
+    unsigned get_console_width()
+    {
+        return 0;
+    }
+
+#endif
+
+    unsigned get_console_width(unsigned min_width, unsigned int default_width)
+    {
+        const auto width = get_console_width();
+        if (width == 0)
+            return default_width;
+        return width < min_width ? min_width : width;
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    struct ConstraintChecker::Constraint
+    {
+        ConstraintType type = ConstraintType::MUTUALLY_EXCLUSIVE;
+        /// The position of the first name for DEPENDS_ON and
+        /// CONFLICTS_WITH.
+        size_t subject = 0;
+        /// The positions of the other names.
+        BitSet members;
+        /// The positions of all the names, in the order they were
+        /// defined, and the names.
+        std::vector<std::pair<size_t, std::string>> names;
+    };
+
+    namespace
+    {
+        using NameMap = std::map<std::string_view, ArgumentId>;
+
+        NameMap make_name_map(
+            const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+            const std::vector<std::unique_ptr<OptionData>>& options)
+        {
+            NameMap result;
+            for (const auto& a : arguments)
+            {
+                // Argument names don't have to be unique, an empty
+                // ArgumentId marks the ones that aren't.
+                const auto [it, inserted] = result.emplace(a->name,
+                                                           a->argument_id);
+                if (!inserted)
+                    it->second = {};
+            }
+            for (const auto& o : options)
+            {
+                for (const auto& flag : o->flags)
+                    result.emplace(flag, o->argument_id);
+            }
+            return result;
+        }
+
+        size_t get_position(const NameMap& names,
+                            const std::string& name,
+                            ArgumentId first_argument_id)
+        {
+            const auto it = names.find(name);
+            if (it == names.end())
+                ARGOS_THROW("Unknown option or argument in constraint: " + name);
+            if (it->second == ArgumentId{})
+                ARGOS_THROW("Ambiguous argument name in constraint: " + name);
+            return size_t(it->second) - size_t(first_argument_id);
+        }
+
+        std::string join_names(
+            const std::vector<std::pair<size_t, std::string>>& names)
+        {
+            std::string result;
+            for (const auto& [_, name] : names)
+            {
+                if (!result.empty())
+                    result += ", ";
+                result += name;
+            }
+            return result;
+        }
+    }
+
+    ConstraintChecker::ConstraintChecker() = default;
+
+    ConstraintChecker::ConstraintChecker(
+        const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+        const std::vector<std::unique_ptr<OptionData>>& options,
+        const std::vector<ConstraintData>& constraints,
+        const ValueIndex& index)
+        : m_first_value_id(index.first_value_id()),
+          m_first_argument_id(index.first_argument_id())
+    {
+        m_mandatory_values.assign(0, index.values().size());
+        m_mandatory_flags.assign(0, index.argument_count());
+        for (const auto& o : options)
+        {
+            if (o->optional)
+                continue;
+            m_mandatory_options.push_back(o.get());
+            if (o->operation == OptionOperation::NONE)
+                m_mandatory_flags.set(size_t(o->argument_id - m_first_argument_id));
+            else
+                m_mandatory_values.set(size_t(o->value_id - m_first_value_id));
+        }
+
+        if (constraints.empty())
+            return;
+
+        const auto names = make_name_map(arguments, options);
+        for (const auto& c : constraints)
+        {
+            auto& constraint = m_constraints.emplace_back();
+            constraint.type = c.type;
+            BitSet positions(index.argument_count());
+            for (const auto& name : c.names)
+            {
+                const auto pos = get_position(names, name, m_first_argument_id);
+                if (positions.test(pos))
+                {
+                    ARGOS_THROW("Option or argument is used twice in a constraint: "
+                                + name);
+                }
+                positions.set(pos);
+                constraint.names.emplace_back(pos, name);
+            }
+
+            auto it = constraint.names.begin();
+            if (c.type == ConstraintType::DEPENDS_ON
+                || c.type == ConstraintType::CONFLICTS_WITH)
+            {
+                constraint.subject = it->first;
+                ++it;
+            }
+            // The members' bits are usually close together, only the
+            // words between the first and last are stored.
+            const auto [lo, hi] = std::minmax_element(
+                it, constraint.names.end(),
+                [](auto& a, auto& b) {return a.first < b.first;});
+            constraint.members.assign(lo->first, hi->first + 1);
+            for (; it != constraint.names.end(); ++it)
+                constraint.members.set(it->first);
+        }
+    }
+
+    ConstraintChecker::ConstraintChecker(ConstraintChecker&&) noexcept = default;
+
+    ConstraintChecker::~ConstraintChecker() = default;
+
+    ConstraintChecker&
+    ConstraintChecker::operator=(ConstraintChecker&&) noexcept = default;
+
+    const OptionData*
+    ConstraintChecker::find_missing_option(const BitSet& values,
+                                           const BitSet& given) const
+    {
+        if (!m_mandatory_values.find_first_missing(values)
+            && !m_mandatory_flags.find_first_missing(given))
+        {
+            return nullptr;
+        }
+
+        // Report the missing options in the order they were defined,
+        // which isn't necessarily the order of their values.
+        for (const auto* o : m_mandatory_options)
+        {
+            const auto found = o->operation == OptionOperation::NONE
+                ? given.test(size_t(o->argument_id - m_first_argument_id))
+                : values.test(size_t(o->value_id - m_first_value_id));
+            if (!found)
+                return o;
+        }
+        return nullptr;
+    }
+
+    std::string ConstraintChecker::check_constraints(const BitSet& given) const
+    {
+        for (const auto& c : m_constraints)
+        {
+            switch (c.type)
+            {
+            case ConstraintType::MUTUALLY_EXCLUSIVE:
+                if (c.members.count_common(given) > 1)
+                {
+                    std::vector<std::string_view> found;
+                    for (const auto& [pos, name] : c.names)
+                    {
+                        if (given.test(pos))
+                            found.push_back(name);
+                    }
+                    return std::string(found[0]) + " cannot be used with "
+                           + std::string(found[1]) + ".";
+                }
+                break;
+            case ConstraintType::AT_LEAST_ONE_OF:
+                if (!c.members.intersects(given))
+                    return "At least one of these is required: "
+                           + join_names(c.names);
+                break;
+            case ConstraintType::DEPENDS_ON:
+                if (!given.test(c.subject)
+                    || !c.members.find_first_missing(given))
+                {
+                    break;
+                }
+                for (auto it = c.names.begin() + 1; it != c.names.end(); ++it)
+                {
+                    if (!given.test(it->first))
+                        return c.names.front().second + " requires "
+                               + it->second + ".";
+                }
+                break;
+            case ConstraintType::CONFLICTS_WITH:
+                if (!given.test(c.subject) || !c.members.intersects(given))
+                    break;
+                for (const auto& [pos, name] : c.names)
+                {
+                    if (pos != c.subject && given.test(pos))
+                        return c.names.front().second
+                               + " cannot be used with " + name + ".";
+                }
+                break;
+            }
+        }
+        return {};
+    }
+}
+
+//****************************************************************************
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+#define ENUM_CASE(x) case TextId::x: return #x
+
+    std::string to_string(TextId textId)
+    {
+        switch (textId)
+        {
+        ENUM_CASE(INITIAL_TEXT);
+        ENUM_CASE(USAGE_TITLE);
+        ENUM_CASE(USAGE);
+        ENUM_CASE(ABOUT);
+        ENUM_CASE(SUBCOMMANDS_TITLE);
+        ENUM_CASE(ARGUMENTS_TITLE);
+        ENUM_CASE(OPTIONS_TITLE);
+        ENUM_CASE(FINAL_TEXT);
+        ENUM_CASE(ERROR_USAGE);
+        ENUM_CASE(HELP);
+        default:
+            return "<Unknown>";
+        }
+    }
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-21.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
+    {
+        constexpr auto DEFAULT_SUBCOMMANDS_TITLE = "COMMANDS";
+        constexpr auto DEFAULT_ARGUMENTS_TITLE = "ARGUMENTS";
+        constexpr auto DEFAULT_OPTIONS_TITLE = "OPTIONS";
+        constexpr auto DEFAULT_USAGE_TITLE = "USAGE";
+
+        std::string get_argument_name(const ArgumentData& arg)
+        {
+            if (arg.name[0] == '<' || arg.name[0] == '[')
+                return arg.name;
+
+            std::string result;
+            for (unsigned i = 0; i < arg.min_count; ++i)
+            {
+                if (!result.empty())
+                    result += " ";
+                result += "<" + arg.name + ">";
+            }
+
+            if (arg.max_count == arg.min_count)
+                return result;
+
+            if (!result.empty())
+                result += " ";
+            if (arg.max_count - arg.min_count == 1)
+                result += "[<" + arg.name + ">]";
+            else
+                result += "[<" + arg.name + ">]...";
+            return result;
+        }
+
+        bool is_stop_option(OptionType type)
+        {
+            return type == OptionType::HELP
+                   || type == OptionType::STOP
+                   || type == OptionType::EXIT;
+        }
+
+        std::string get_brief_option_name(const OptionData& opt,
+                                          bool prefer_long_flag)
+        {
+            std::string opt_txt;
+            const bool braces = opt.optional
+                                && !is_stop_option(opt.type);
+            if (braces)
+                opt_txt.push_back('[');
+
+            std::string_view flag;
+            if (prefer_long_flag)
+            {
+                const auto it = std::find_if(opt.flags.begin(), opt.flags.end(),
+                                             [](auto& s) { return s.size() > 2; });
+                if (it != opt.flags.end())
+                    flag = *it;
+            }
+
+            if (flag.empty())
+                flag = opt.flags.front();
+
+            opt_txt += flag;
+            if (!opt.argument.empty())
+            {
+                if (flag.back() != '=')
+                    opt_txt += " ";
+                if (opt.argument.front() != '<')
+                {
+                    opt_txt += "<";
+                    opt_txt += opt.argument;
+                    opt_txt.push_back('>');
+                }
+                else
+                {
+                    opt_txt += opt.argument;
+                }
+            }
+            if (braces)
+                opt_txt.push_back(']');
+            return opt_txt;
+        }
+
+        std::string get_long_option_name(const OptionData& opt)
+        {
+            std::string opt_txt;
+            for (const auto& flag : opt.flags)
+            {
+                if (!opt_txt.empty())
+                    opt_txt.append(", ");
+                opt_txt += flag;
+                if (!opt.argument.empty())
+                {
+                    if (flag.back() != '=')
+                        opt_txt.push_back(' ');
+                    if (opt.argument.front() != '<')
+                    {
+                        opt_txt += "<";
+                        opt_txt += opt.argument;
+                        opt_txt.push_back('>');
+                    }
+                    else
+                    {
+                        opt_txt += opt.argument;
+                    }
+                }
+            }
+            return opt_txt;
+        }
+
+        std::optional<std::string>
+        get_custom_text(const CommandData& data, TextId text_id)
+        {
+            const auto it = data.texts.find(text_id);
+            if (it != data.texts.end())
+            {
+                return get_text(it->second);
+            }
+            return {};
+        }
+
+        bool is_empty(const std::optional<std::string>& str)
+        {
+            return !str || str->empty();
+        }
+
+        std::optional<std::string>
+        write_custom_text(TextFormatter& formatter,
+                          const CommandData& cmd,
+                          TextId text_id,
+                          bool prepend_newline = false)
+        {
+            auto text = get_custom_text(cmd, text_id);
+            if (!is_empty(text))
+            {
+                if (prepend_newline)
+                    formatter.newline();
+                formatter.write_words(*text);
+                if (!formatter.is_current_line_empty())
+                    formatter.newline();
+            }
+            return text;
+        }
+
+        void write_stop_and_help_usage(TextFormatter& formatter,
+                                       const CommandData& cmd)
+        {
+            for (auto& opt : cmd.options)
+            {
+                if ((opt->visibility & Visibility::USAGE) == Visibility::HIDDEN
+                    || !is_stop_option(opt->type))
+                {
+                    continue;
+                }
+
+                formatter.write_words(cmd.full_name);
+                formatter.write_words(" ");
+                formatter.push_indentation(TextFormatter::CURRENT_COLUMN);
+                formatter.write_lines(get_brief_option_name(*opt, true));
+                formatter.write_words(" ");
+                formatter.pop_indentation();
+                formatter.newline();
+            }
+        }
+
+        using HelpText = std::pair<std::string, std::string>;
+        using HelpTextVector = std::vector<HelpText>;
+        using SectionHelpTexts = std::pair<std::string_view, HelpTextVector>;
+
+        unsigned int get_help_text_label_width(
+            const TextFormatter& formatter,
+            const std::vector<SectionHelpTexts>& sections)
+        {
+            // Determine what width should be reserved for the argument names
+            // and option flags.
+            std::vector<unsigned> name_widths;
+            std::vector<unsigned> text_widths;
+            for (const auto& [_, help_texts] : sections)
+            {
+                for (const auto& [name, txt] : help_texts)
+                {
+                    name_widths.push_back(static_cast<unsigned>(name.size()));
+                    text_widths.push_back(static_cast<unsigned>(txt.size()));
+                }
+            }
+
+            std::sort(name_widths.begin(), name_widths.end());
+            std::sort(text_widths.begin(), text_widths.end());
+            const auto line_width = formatter.line_width();
+            // Check if both the longest name and the longest help text
+            // can fit on the same line.
+            const auto name_width = name_widths.back() + 3;
+            if (name_width > 32 || name_width + text_widths.back() > line_width)
+                return 0;
+            return name_width;
+        }
+
+        void write_argument_sections(TextFormatter& formatter,
+                                     const CommandData& command,
+                                     bool prepend_newline)
+        {
+            std::vector<SectionHelpTexts> sections;
+
+            auto add_help_text = [&](std::string_view s, std::string a, std::string b)
+            {
+                auto it = find_if(sections.begin(), sections.end(),
+                                  [&](const auto& v)
+                                  {
+                                      return v.first == s;
+                                  });
+                if (it == sections.end())
+                {
+                    sections.push_back({s, {}});
+                    it = std::prev(sections.end());
+                }
+                it->second.emplace_back(std::move(a), std::move(b));
+            };
+
+            // List all arguments
+            auto arg_title = get_custom_text(command, TextId::ARGUMENTS_TITLE);
+            if (!arg_title)
+                arg_title = DEFAULT_ARGUMENTS_TITLE;
+            for (auto& a : command.arguments)
+            {
+                if ((a->visibility & Visibility::TEXT) == Visibility::HIDDEN)
+                    continue;
+                auto& section = a->section.empty() ? *arg_title : a->section;
+                add_help_text(section, get_argument_name(*a), get_text(a->help));
+            }
+
+            // List all sub-commands after arguments, as arguments must be
+            // given first.
+            auto cmd_title = get_custom_text(command, TextId::SUBCOMMANDS_TITLE);
+            if (!cmd_title)
+                cmd_title = DEFAULT_SUBCOMMANDS_TITLE;
+            for (auto& c : command.commands)
+            {
+                if ((c->visibility & Visibility::TEXT) == Visibility::HIDDEN)
+                    continue;
+                auto& section = c->section.empty() ? *cmd_title : c->section;
+                add_help_text(section, c->name,
+                              get_custom_text(*c, TextId::HELP).value_or(""));
+            }
+
+            // List all options.
+            auto opt_title = get_custom_text(command, TextId::OPTIONS_TITLE);
+            if (!opt_title)
+                opt_title = DEFAULT_OPTIONS_TITLE;
+            for (auto& o : command.options)
+            {
+                if ((o->visibility & Visibility::TEXT) == Visibility::HIDDEN)
+                    continue;
+                auto& section = o->section.empty() ? *opt_title : o->section;
+                add_help_text(section, get_long_option_name(*o), get_text(o->help));
+            }
+
+            if (sections.empty())
+                return;
+
+            const unsigned name_width = get_help_text_label_width(formatter, sections);
+
+            for (auto& [section, texts] : sections)
+            {
+                if (prepend_newline)
+                    formatter.newline();
+                formatter.write_words(section);
+                formatter.newline();
+                formatter.push_indentation(2);
+                for (auto& [name, text] : texts)
+                {
+                    formatter.write_words(name);
+                    if (!text.empty())
+                    {
+                        if (name_width)
+                        {
+                            if (formatter.current_line_width() >= name_width)
+                                formatter.write_words("  ");
+                            formatter.push_indentation(name_width);
+                        }
+                        else
+                        {
+                            formatter.newline();
+                            formatter.push_indentation(8);
+                        }
+                        formatter.write_words(text);
+                        formatter.pop_indentation();
+                    }
+                    formatter.newline();
+                }
+                formatter.pop_indentation();
+                prepend_newline = true;
+            }
+        }
+
+        void write_brief_regular_options(TextFormatter& formatter,
+                                         const CommandData& command)
+        {
+            for (auto& opt : command.options)
+            {
+                if ((opt->visibility & Visibility::USAGE) == Visibility::HIDDEN
+                    || is_stop_option(opt->type))
+                {
+                    continue;
+                }
+
+                formatter.write_lines(get_brief_option_name(*opt, false));
+                formatter.write_words(" ");
+            }
+        }
+
+        void write_brief_arguments(TextFormatter& formatter,
+                                   const CommandData& command)
+        {
+            for (auto& arg : command.arguments)
+            {
+                if ((arg->visibility & Visibility::USAGE) == Visibility::HIDDEN)
+                    continue;
+                formatter.write_lines(get_argument_name(*arg));
+                formatter.write_words(" ");
+            }
+        }
+
+        void write_brief_commands(TextFormatter& formatter,
+                                  const CommandData& command)
+        {
+            if (command.commands.empty())
+                return;
+
+            auto brackets = !command.require_subcommand.value_or(false);
+
+            if (brackets)
+                formatter.write_words("[");
+
+            bool first_command = true;
+            for (auto& cmd : command.commands)
+            {
+                if ((cmd->visibility & Visibility::USAGE) == Visibility::HIDDEN)
+                    continue;
+                if (!first_command)
+                    formatter.write_words("|");
+                first_command = false;
+                formatter.write_words(cmd->name);
+            }
+
+            if (brackets)
+                formatter.write_words("]");
+        }
+
+        void write_brief_usage(TextFormatter& formatter,
+                               const CommandData& command,
+                               bool prepend_newline)
+        {
+            if (prepend_newline)
+                formatter.newline();
+
+            formatter.push_indentation(2);
+            write_stop_and_help_usage(formatter, command);
+            formatter.write_words(command.full_name);
+            formatter.write_words(" ");
+            formatter.push_indentation(TextFormatter::CURRENT_COLUMN);
+
+            write_brief_regular_options(formatter, command);
+            write_brief_arguments(formatter, command);
+            write_brief_commands(formatter, command);
+
+            formatter.pop_indentation();
+            formatter.newline();
+            formatter.pop_indentation();
+        }
+
+        bool write_usage(TextFormatter& formatter,
+                         const CommandData& command,
+                         bool prepend_newline = false)
+        {
+            if (const auto t = get_custom_text(command, TextId::USAGE); t && t->empty())
+                return false;
+
+            const auto text1 = write_custom_text(formatter, command,
+                                                 TextId::USAGE_TITLE,
+                                                 prepend_newline);
+            if (!text1)
+            {
+                if (prepend_newline)
+                    formatter.newline();
+                formatter.write_words(DEFAULT_USAGE_TITLE);
+                formatter.newline();
+                prepend_newline = false;
+            }
+            else
+            {
+                prepend_newline = prepend_newline && is_empty(text1);
+            }
+            const auto text2 = write_custom_text(formatter, command,
+                                                 TextId::USAGE,
+                                                 prepend_newline);
+            if (text2)
+                return !is_empty(text1) || !is_empty(text2);
+            write_brief_usage(formatter, command, prepend_newline);
+            return true;
+        }
+
+        std::string get_name(const CommandData& data, ArgumentId argument_id)
+        {
+            for (const auto& a : data.arguments)
+            {
+                if (a->argument_id == argument_id)
+                    return a->name;
+            }
+            for (const auto& o : data.options)
+            {
+                if (o->argument_id == argument_id)
+                {
+                    std::string name = o->flags.front();
+                    for (size_t i = 1; i < o->flags.size(); ++i)
+                        name += ", " + o->flags[i];
+                    return name;
+                }
             }
-            return result;
+            return {};
         }
     }
 
-    ArgumentValues::ArgumentValues(
-            std::vector<std::pair<std::string_view, ArgumentId>> values,
-            std::shared_ptr<ParsedArgumentsImpl> args,
-            ValueId value_id)
-        : m_values(std::move(values)),
-          m_args(std::move(args)),
-          m_value_id(value_id)
-    {}
-
-    ArgumentValues::ArgumentValues(const ArgumentValues&) = default;
-
-    ArgumentValues::ArgumentValues(ArgumentValues&&) noexcept = default;
-
-    ArgumentValues::~ArgumentValues() = default;
-
-    ArgumentValues&
-    ArgumentValues::operator=(const ArgumentValues&) = default;
-
-    ArgumentValues&
-    ArgumentValues::operator=(ArgumentValues&&) noexcept = default;
-
-    ArgumentValues::operator bool() const
+    void write_help_text(const ParserData& data, const CommandData& cmd)
     {
-        return !m_values.empty();
+        TextFormatter formatter;
+        if (data.help_settings.line_width)
+            formatter.set_line_width(data.help_settings.line_width);
+        if (data.help_settings.output_stream)
+            formatter.set_stream(data.help_settings.output_stream);
+        formatter.word_splitter().add_words(data.help_settings.word_split_rules);
+        bool newline = !is_empty(write_custom_text(formatter, cmd, TextId::INITIAL_TEXT));
+        newline = write_usage(formatter, cmd, newline) || newline;
+        newline = !is_empty(write_custom_text(formatter, cmd, TextId::ABOUT, newline))
+                  || !is_empty(write_custom_text(formatter, cmd, TextId::HELP, newline))
+                  || newline;
+        write_argument_sections(formatter, cmd, newline);
+        write_custom_text(formatter, cmd, TextId::FINAL_TEXT, true);
     }
 
-    ArgumentValue ArgumentValues::operator[](size_t index) const
+    void write_error_message(const ParserData& data,
+                             const CommandData& cmd,
+                             const std::string& msg)
     {
-        return value(index);
+        TextFormatter formatter;
+        if (data.help_settings.line_width)
+            formatter.set_line_width(data.help_settings.line_width);
+        if (data.help_settings.output_stream)
+            formatter.set_stream(data.help_settings.output_stream);
+        else
+            formatter.set_stream(&std::cerr);
+        formatter.word_splitter().add_words(data.help_settings.word_split_rules);
+        formatter.write_words(cmd.full_name + ": ");
+        formatter.write_words(msg);
+        formatter.newline();
+        if (!write_custom_text(formatter, cmd, TextId::ERROR_USAGE))
+            write_usage(formatter, cmd);
     }
 
-    std::vector<std::unique_ptr<IArgumentView>>
-    ArgumentValues::arguments() const
+    void write_error_message(const ParserData& data,
+                             const CommandData& cmd,
+                             const std::string& msg,
+                             ArgumentId argument_id)
     {
-        return m_args->get_argument_views(m_value_id);
+        if (const auto name = get_name(cmd, argument_id); !name.empty())
+            write_error_message(data, cmd, name + ": " + msg);
+        else
+            write_error_message(data, cmd, msg);
     }
 
-    void ArgumentValues::error(const std::string& message) const
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg)
     {
-        m_args->error(message, get_argument_id(m_values));
+        return cmd.full_name + ": " + msg;
     }
 
-    bool ArgumentValues::empty() const
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg,
+                                  ArgumentId argument_id)
     {
-        return m_values.empty();
+        if (const auto name = get_name(cmd, argument_id); !name.empty())
+            return get_error_message(cmd, name + ": " + msg);
+        return get_error_message(cmd, msg);
     }
+}
 
-    size_t ArgumentValues::size() const
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    IncrementalParser::IncrementalParser(std::shared_ptr<const ParserData> parser_data)
+        : m_impl(std::make_unique<ArgumentIteratorImpl>(std::move(parser_data)))
+    {}
+
+    IncrementalParser::IncrementalParser(IncrementalParser&& rhs) noexcept
+        : m_impl(std::move(rhs.m_impl))
+    {}
+
+    IncrementalParser::~IncrementalParser() = default;
+
+    IncrementalParser&
+    IncrementalParser::operator=(IncrementalParser&& rhs) noexcept
     {
-        return m_values.size();
+        m_impl = std::move(rhs.m_impl);
+        return *this;
     }
 
-    std::vector<ArgumentValue> ArgumentValues::values() const
+    IncrementalParser& IncrementalParser::max_lookahead(size_t n)
     {
-        std::vector<ArgumentValue> result;
-        result.reserve(m_values.size());
-        for (const auto& [value, arg_id] : m_values)
-            result.emplace_back(value, m_args, m_value_id, arg_id);
-        return result;
+        impl().set_max_lookahead(n);
+        return *this;
     }
 
-    std::vector<std::string_view> ArgumentValues::raw_values() const
+    IncrementalParser& IncrementalParser::store_argument_values(bool value)
     {
-        std::vector<std::string_view> result;
-        result.reserve(m_values.size());
-        for (const auto& [value, _] : m_values)
-            result.push_back(value);
-        return result;
+        impl().set_store_argument_values(value);
+        return *this;
     }
 
-    ArgumentValue ArgumentValues::value(size_t index) const
+    void IncrementalParser::push(std::string_view arg)
     {
-        if (m_values.empty())
-            return {{}, m_args, m_value_id, {}};
-
-        const auto& [value, arg_id] = m_values.at(index);
-        return {value, m_args, m_value_id, arg_id};
+        impl().push(arg);
     }
 
-    std::vector<int>
-    ArgumentValues::as_ints(const std::vector<int>& default_value,
-                            int base) const
+    void IncrementalParser::finish()
     {
-        return parse_integers<int>(*this, default_value, base);
+        impl().finish();
     }
 
-    std::vector<unsigned>
-    ArgumentValues::as_uints(const std::vector<unsigned>& default_value,
-                             int base) const
+    IncrementalResult
+    IncrementalParser::next(std::unique_ptr<IArgumentView>& arg,
+                            std::string_view& value)
     {
-        return parse_integers<unsigned>(*this, default_value, base);
+        const auto result = impl().next();
+        if (get_result_view(result, arg, value))
+            return IncrementalResult::PROCESSED;
+
+        switch (std::get<0>(result))
+        {
+        case IteratorResultCode::INCOMPLETE:
+            return IncrementalResult::NEED_INPUT;
+        case IteratorResultCode::ERROR:
+            return IncrementalResult::FAILURE;
+        default:
+            return IncrementalResult::DONE;
+        }
     }
 
-    std::vector<long>
-    ArgumentValues::as_longs(const std::vector<long>& default_value,
-                             int base) const
+    ParsedArguments IncrementalParser::parsed_arguments() const
     {
-        return parse_integers<long>(*this, default_value, base);
+        return ParsedArguments(impl().toplevel_parsed_arguments());
     }
 
-    std::vector<long long>
-    ArgumentValues::as_llongs(const std::vector<long long>& default_value,
-                              int base) const
+    ArgumentIteratorImpl& IncrementalParser::impl()
     {
-        return parse_integers<long long>(*this, default_value, base);
+        if (!m_impl)
+            ARGOS_THROW("This IncrementalParser has been moved from.");
+        return *m_impl;
     }
 
-    std::vector<unsigned long>
-    ArgumentValues::as_ulongs(const std::vector<unsigned long>& default_value,
-                              int base) const
+    const ArgumentIteratorImpl& IncrementalParser::impl() const
     {
-        return parse_integers<unsigned long>(*this, default_value, base);
+        if (!m_impl)
+            ARGOS_THROW("This IncrementalParser has been moved from.");
+        return *m_impl;
     }
+}
 
-    std::vector<unsigned long long> ArgumentValues::as_ullongs(
-        const std::vector<unsigned long long>& default_value,
-        int base) const
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#elif defined(WIN32)
+    #define NOMINMAX
+#else
+    #include <fstream>
+#endif
+
+namespace argos
+{
+    MappedFile::MappedFile() = default;
+
+    MappedFile::~MappedFile()
     {
-        return parse_integers<unsigned long long>(*this, default_value, base);
+        close();
     }
 
-    std::vector<float>
-    ArgumentValues::as_floats(const std::vector<float>& default_value) const
+    std::span<char> MappedFile::data() const
     {
-        return parse_floats(*this, default_value);
+        return {m_data, m_size};
     }
 
-    std::vector<double>
-    ArgumentValues::as_doubles(const std::vector<double>& default_value) const
+#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+
+    bool MappedFile::open(const std::string& path)
     {
-        return parse_floats(*this, default_value);
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            return false;
+
+        struct stat st = {};
+        bool success = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+        if (success && st.st_size != 0)
+        {
+            auto ptr = mmap(nullptr, size_t(st.st_size),
+                            PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                m_data = static_cast<char*>(ptr);
+                m_size = size_t(st.st_size);
+            }
+            else
+            {
+                success = false;
+            }
+        }
+        ::close(fd);
+        return success;
     }
 
-    std::vector<std::string> ArgumentValues::as_strings(
-            const std::vector<std::string>& default_value) const
+    void MappedFile::close()
     {
-        if (m_values.empty())
-            return default_value;
-
-        std::vector<std::string> result;
-        result.reserve(m_values.size());
-        for (const auto& [value, _] : m_values)
-            result.emplace_back(value);
-        return result;
+        if (m_data)
+            munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
     }
 
-    ArgumentValues
-    ArgumentValues::split(char separator,
-                          size_t min_parts, size_t max_parts) const
+#elif defined(WIN32)
+
+    bool MappedFile::open(const std::string& path)
     {
-        std::vector<std::pair<std::string_view, ArgumentId>> values;
-        for (auto [value, arg_id] : m_values)
+        close();
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                                        FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size = {};
+        bool success = GetFileSizeEx(file, &size) != 0;
+        if (success && size.QuadPart != 0)
         {
-            auto parts = split_string(value, separator, max_parts - 1);
-            if (parts.size() < min_parts)
+            success = false;
+            const HANDLE mapping = CreateFileMappingA(file, nullptr,
+                                                      PAGE_WRITECOPY,
+                                                      0, 0, nullptr);
+            if (mapping)
             {
-                error("Invalid value: \"" + std::string(value)
-                      + "\". Must be at least " + std::to_string(min_parts)
-                      + " values separated by \"" + separator + "\".");
+                auto ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                if (ptr)
+                {
+                    m_data = static_cast<char*>(ptr);
+                    m_size = size_t(size.QuadPart);
+                    success = true;
+                }
+                CloseHandle(mapping);
             }
-            for (auto& part : parts)
-                values.emplace_back(part, arg_id);
         }
-        return {std::move(values), m_args, m_value_id};
+        CloseHandle(file);
+        return success;
     }
 
-    ArgumentValues
-    ArgumentValues::split_n(char separator, size_t num_parts) const
+    void MappedFile::close()
     {
-        return split(separator, num_parts, num_parts);
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        m_data = nullptr;
+        m_size = 0;
     }
 
-    ArgumentValueIterator ArgumentValues::begin() const
+#else
+
+    bool MappedFile::open(const std::string& path)
     {
-        return {m_values.begin(), m_args, m_value_id};
+        close();
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+
+        const auto size = size_t(file.tellg());
+        file.seekg(0);
+        m_buffer = std::make_unique<char[]>(size);
+        if (!file.read(m_buffer.get(), std::streamsize(size)))
+        {
+            m_buffer = {};
+            return false;
+        }
+        m_data = m_buffer.get();
+        m_size = size;
+        return true;
     }
 
-    ArgumentValueIterator ArgumentValues::end() const
+    void MappedFile::close()
     {
-        return {m_values.end(), m_args, m_value_id};
+        m_buffer = {};
+        m_data = nullptr;
+        m_size = 0;
     }
+
+#endif
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-28.
+// Created by Jan Erik Breimo on 2020-01-10.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -2759,254 +8858,392 @@ namespace argos
 
 namespace argos
 {
-    ArgumentView::ArgumentView(const ArgumentData* data)
-            : m_argument(data)
+    Option::Option()
+        : m_option(std::make_unique<OptionData>())
+    {}
+
+    Option::Option(std::string flag)
+        : m_option(std::make_unique<OptionData>())
     {
-        if (!data)
-            ARGOS_THROW("data can not be null");
+        m_option->flags.emplace_back(std::move(flag));
     }
 
-    std::string ArgumentView::help() const
+    Option::Option(std::string flag1, std::string flag2)
+        : m_option(std::make_unique<OptionData>())
     {
-        return get_text(m_argument->help);
+        m_option->flags.emplace_back(std::move(flag1));
+        m_option->flags.emplace_back(std::move(flag2));
+    }
+
+    Option::Option(std::initializer_list<std::string> flags)
+        : m_option(std::make_unique<OptionData>())
+    {
+        m_option->flags = flags;
     }
 
-    const std::string& ArgumentView::section() const
-    {
-        return m_argument->section;
-    }
+    Option::Option(const Option& rhs)
+        : m_option(rhs.m_option
+                   ? std::make_unique<OptionData>(*rhs.m_option)
+                   : std::unique_ptr<OptionData>())
+    {}
+
+    Option::Option(Option&& rhs) noexcept
+        : m_option(std::move(rhs.m_option))
+    {}
 
-    const std::string& ArgumentView::alias() const
+    Option::~Option() = default;
+
+    Option& Option::operator=(const Option& rhs)
     {
-        return m_argument->alias;
+        if (this != &rhs)
+        {
+            if (rhs.m_option)
+                m_option = std::make_unique<OptionData>(*rhs.m_option);
+            else
+                m_option = {};
+        }
+        return *this;
     }
 
-    Visibility ArgumentView::visibility() const
+    Option& Option::operator=(Option&& rhs) noexcept
     {
-        return m_argument->visibility;
+        m_option = std::move(rhs.m_option);
+        return *this;
     }
 
-    int ArgumentView::id() const
+    Option& Option::help(const std::string& text)
     {
-        return m_argument->id;
+        check_option();
+        m_option->help = text;
+        return *this;
     }
 
-    const std::string& ArgumentView::name() const
+    Option& Option::help(TextCallback callback)
     {
-        return m_argument->name;
+        check_option();
+        m_option->help = callback;
+        return *this;
     }
 
-    bool ArgumentView::optional() const
+    Option& Option::section(const std::string& name)
     {
-        return m_argument->min_count == 0;
+        check_option();
+        m_option->section = name;
+        return *this;
     }
 
-    std::pair<unsigned, unsigned> ArgumentView::count() const
+    Option& Option::alias(const std::string& id)
     {
-        return {m_argument->min_count, m_argument->max_count};
+        check_option();
+        m_option->alias = id;
+        return *this;
     }
 
-    ValueId ArgumentView::value_id() const
+    Option& Option::operation(OptionOperation operation)
     {
-        return m_argument->value_id;
+        check_option();
+        m_option->operation = operation;
+        return *this;
     }
 
-    ArgumentId ArgumentView::argument_id() const
+    Option& Option::visibility(Visibility visibility)
     {
-        return m_argument->argument_id;
+        check_option();
+        m_option->visibility = visibility;
+        return *this;
     }
-}
-
-//****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-09-04.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
-
-namespace argos
-{
-    Command::Command()
-        : data_(std::make_unique<CommandData>())
-    {}
 
-    Command::Command(std::string name)
-        : data_(std::make_unique<CommandData>())
+    Option& Option::id(int id)
     {
-        data_->name = std::move(name);
+        check_option();
+        m_option->id = id;
+        return *this;
     }
 
-    Command::Command(const Command& rhs)
-        : data_(rhs.data_ ? std::make_unique<CommandData>(*rhs.data_) : nullptr)
+    Option& Option::flag(const std::string& f)
     {
+        check_option();
+        m_option->flags = {f};
+        return *this;
     }
 
-    Command::Command(Command&& rhs) noexcept
-        : data_(std::move(rhs.data_))
+    Option& Option::flags(std::vector<std::string> f)
     {
+        check_option();
+        m_option->flags = std::move(f);
+        return *this;
     }
 
-    Command::~Command() = default;
-
-    Command& Command::operator=(const Command& rhs)
+    Option& Option::argument(const std::string& name)
     {
-        if (this != &rhs)
-        {
-            data_ = rhs.data_
-                        ? std::make_unique<CommandData>(*rhs.data_)
-                        : nullptr;
-        }
+        check_option();
+        m_option->argument = name;
         return *this;
     }
 
-    Command& Command::operator=(Command&& rhs) noexcept
+    Option& Option::initial_value(const std::string& value)
     {
-        data_ = std::move(rhs.data_);
+        check_option();
+        m_option->initial_value = value;
         return *this;
     }
 
-    Command& Command::add(Argument& argument)
+    Option& Option::constant(const char* value)
     {
-        return add(std::move(argument));
+        return this->constant(std::string(value));
     }
 
-    Command& Command::add(Argument&& argument)
+    Option& Option::constant(const std::string& value)
     {
-        check_command();
-        data_->add(argument.release());
+        check_option();
+        m_option->constant = value;
         return *this;
     }
 
-    Command& Command::add(Option& option)
+    Option& Option::constant(bool value)
     {
-        return add(std::move(option));
+        return this->constant(value ? 1LL : 0LL);
     }
 
-    Command& Command::add(Option&& option)
+    Option& Option::constant(int value)
     {
-        check_command();
-        data_->add(option.release());
-        return *this;
+        return this->constant(static_cast<long long>(value));
     }
 
-    Command& Command::add(Command& command)
+    Option& Option::constant(long long value)
     {
-        return add(std::move(command));
+        check_option();
+        m_option->constant = std::to_string(value);
+        return *this;
     }
 
-    Command& Command::add(Command&& command)
+    Option& Option::callback(OptionCallback callback)
     {
-        check_command();
-        data_->add(command.release());
+        check_option();
+        m_option->callback = std::move(callback);
         return *this;
     }
 
-    Command& Command::name(std::string name)
+    Option& Option::type(OptionType type)
     {
-        check_command();
-        data_->name = std::move(name);
+        check_option();
+        m_option->type = type;
         return *this;
     }
 
-    Command& Command::help(std::string text)
+    Option& Option::value_type(ValueType type)
     {
-        check_command();
-        data_->texts[TextId::HELP] = std::move(text);
+        check_option();
+        m_option->value_type = type;
         return *this;
     }
 
-    Command& Command::about(std::string text)
+    Option& Option::choices(std::vector<std::string> values)
     {
-        check_command();
-        data_->texts[TextId::ABOUT] = std::move(text);
+        check_option();
+        m_option->choices = ChoiceSet(std::move(values));
         return *this;
     }
 
-    Command& Command::section(std::string name)
+    Option& Option::dictionary(char separator)
     {
-        check_command();
-        data_->section = std::move(name);
+        check_option();
+        if (separator == '\0')
+            ARGOS_THROW("The separator can not be '\\0'.");
+        m_option->dictionary_separator = separator;
+        m_option->operation = OptionOperation::APPEND;
         return *this;
     }
 
-    Command& Command::current_section(std::string name)
+    Option& Option::set_binding(std::shared_ptr<ValueBinding> binding)
     {
-        check_command();
-        data_->current_section = std::move(name);
+        check_option();
+        m_option->value_type = binding->value_type();
+        m_option->binding = std::move(binding);
         return *this;
     }
 
-    Command& Command::text(TextId textId, std::string text)
+#define ARGOS_DEFINE_BIND(type) \
+    template <> \
+    Option& Option::bind<type>(type& variable) \
+    { \
+        return set_binding(make_binding(variable)); \
+    }
+
+    ARGOS_DEFINE_BIND(bool)
+    ARGOS_DEFINE_BIND(int)
+    ARGOS_DEFINE_BIND(unsigned)
+    ARGOS_DEFINE_BIND(long)
+    ARGOS_DEFINE_BIND(long long)
+    ARGOS_DEFINE_BIND(unsigned long)
+    ARGOS_DEFINE_BIND(unsigned long long)
+    ARGOS_DEFINE_BIND(float)
+    ARGOS_DEFINE_BIND(double)
+    ARGOS_DEFINE_BIND(std::string)
+    ARGOS_DEFINE_BIND(std::vector<int>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned>)
+    ARGOS_DEFINE_BIND(std::vector<long>)
+    ARGOS_DEFINE_BIND(std::vector<long long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long long>)
+    ARGOS_DEFINE_BIND(std::vector<float>)
+    ARGOS_DEFINE_BIND(std::vector<double>)
+    ARGOS_DEFINE_BIND(std::vector<std::string>)
+
+#undef ARGOS_DEFINE_BIND
+
+    Option& Option::optional(bool optional)
     {
-        check_command();
-        data_->texts[textId] = std::move(text);
+        check_option();
+        m_option->optional = optional;
         return *this;
     }
 
-    Command& Command::text(TextId textId, std::function<std::string()> callback)
+    Option& Option::mandatory(bool mandatory)
     {
-        check_command();
-        data_->texts[textId] = std::move(callback);
-        return *this;
+        return optional(!mandatory);
     }
 
-    Command& Command::visibility(Visibility visibility)
+    const OptionData& Option::data() const
     {
-        check_command();
-        data_->visibility = visibility;
-        return *this;
+        check_option();
+        return *m_option;
     }
 
-    Command& Command::id(int id)
+    std::unique_ptr<OptionData> Option::release()
     {
-        check_command();
-        data_->id = id;
-        return *this;
+        check_option();
+        return std::move(m_option);
     }
 
-    Command& Command::allow_multiple_subcommands(bool multi_command)
+    void Option::check_option() const
     {
-        check_command();
-        data_->multi_command = multi_command;
-        return *this;
+        if (!m_option)
+            ARGOS_THROW("Cannot use Option instance after"
+                        " release() has been called.");
     }
+}
 
-    Command& Command::require_subcommand(bool require_subcommand)
+//****************************************************************************
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-10-05.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
     {
-        check_command();
-        data_->require_subcommand = require_subcommand;
-        return *this;
+        bool check_flag_with_equal(const std::string& flag,
+                                   const OptionData& od)
+        {
+            const auto eq_pos = flag.find('=');
+            if (eq_pos == std::string::npos)
+                return true;
+            if (eq_pos != flag.size() - 1)
+                ARGOS_THROW("Options can not have a '=' in the middle: " + flag);
+            if (od.argument.empty())
+                ARGOS_THROW("Options ending with '=' must have a named argument: " + flag);
+            return true;
+        }
+
+        bool check_standard_flag(const std::string& flag,
+                                 const OptionData& od)
+        {
+            if (flag.find_first_of(" \t\n\r") != std::string::npos)
+                return false;
+            if (flag.size() < 2)
+                return false;
+            if (flag[0] != '-')
+                return false;
+            if (flag.size() == 2)
+                return true;
+            if (flag[1] != '-')
+                return false;
+            return check_flag_with_equal(flag, od);
+        }
+
+        bool check_flag(const std::string& flag, char prefix,
+                        const OptionData& od)
+        {
+            if (flag.size() < 2 || flag[0] != prefix)
+                return false;
+            if (flag.find_first_of(" \t\n\r") != std::string::npos)
+                return false;
+            if (flag.size() == 2)
+                return true;
+            return check_flag_with_equal(flag, od);
+        }
     }
 
-    Command& Command::copy_from(Command& command)
+    void validate_and_update(OptionData& option, OptionStyle style)
     {
-        check_command();
-        data_->copy_from(*command.data_);
-        return *this;
-    }
+        if (option.flags.empty())
+            ARGOS_THROW("Option must have one or more flags.");
 
-    std::unique_ptr<CommandData> Command::release()
-    {
-        return std::move(data_);
-    }
+        for (auto& flag : option.flags)
+        {
+            bool ok = false;
+            switch (style)
+            {
+            case OptionStyle::STANDARD:
+                ok = check_standard_flag(flag, option);
+                break;
+            case OptionStyle::SLASH:
+                ok = check_flag(flag, '/', option);
+                break;
+            case OptionStyle::DASH:
+                ok = check_flag(flag, '-', option);
+                break;
+            default:
+                break;
+            }
+            if (!ok)
+                ARGOS_THROW("Invalid flag: '" + flag + "'.");
+        }
 
-    const CommandData& Command::internal_ref() const
-    {
-        check_command();
-        return *data_;
-    }
+        if (!option.argument.empty() && !option.constant.empty())
+            ARGOS_THROW("Option cannot have both argument and constant.");
 
-    void Command::check_command() const
-    {
-        if (!data_)
-            ARGOS_THROW("Command has been moved.");
+        if (option.dictionary_separator != '\0')
+        {
+            if (option.operation != OptionOperation::APPEND)
+                ARGOS_THROW("Dictionary options must have operation APPEND.");
+            if (option.binding)
+                ARGOS_THROW("Dictionary options can not be bound to a variable.");
+        }
+
+        switch (option.operation)
+        {
+        case OptionOperation::NONE:
+            if (!option.constant.empty())
+                ARGOS_THROW("NONE-options cannot have a constant.");
+            if (!option.alias.empty())
+                ARGOS_THROW("NONE-options cannot have an alias.");
+            break;
+        case OptionOperation::ASSIGN:
+            if (option.argument.empty() && option.constant.empty())
+                option.constant = "1";
+            break;
+        case OptionOperation::APPEND:
+            if (option.argument.empty() && option.constant.empty())
+                ARGOS_THROW("Options that appends must have either constant or argument.");
+            break;
+        case OptionOperation::CLEAR:
+            if (!option.argument.empty() || !option.constant.empty())
+                option.constant = "1";
+            if (!option.optional)
+                ARGOS_THROW("CLEAR-options must be optional.");
+            break;
+        }
     }
 }
 
 //****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-09-05.
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-02-18.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -3014,442 +9251,302 @@ namespace argos
 
 namespace argos
 {
-    constexpr char DEFAULT_HELP_TEXT[] = "Display this help text.";
-
-    CommandData::CommandData() = default;
-
-    CommandData::CommandData(const CommandData& rhs)
-        : current_section(rhs.current_section),
-          name(rhs.name),
-          full_name(rhs.full_name),
-          texts(rhs.texts),
-          require_subcommand(rhs.require_subcommand),
-          multi_command(rhs.multi_command),
-          section(rhs.section),
-          id(rhs.id),
-          argument_id(rhs.argument_id)
-    {
-        arguments.reserve(rhs.arguments.size());
-        for (const auto& a : rhs.arguments)
-            arguments.push_back(std::make_unique<ArgumentData>(*a));
-        options.reserve(rhs.options.size());
-        for (const auto& o : rhs.options)
-            options.push_back(std::make_unique<OptionData>(*o));
-        commands.reserve(rhs.commands.size());
-        for (const auto& c : rhs.commands)
-            commands.push_back(std::make_unique<CommandData>(*c));
-    }
-
-    CommandData::CommandData(CommandData&& rhs) noexcept
-        : arguments(std::move(rhs.arguments)),
-          options(std::move(rhs.options)),
-          commands(std::move(rhs.commands)),
-          current_section(std::move(rhs.current_section)),
-          name(std::move(rhs.name)),
-          full_name(std::move(rhs.full_name)),
-          texts(std::move(rhs.texts)),
-          require_subcommand(rhs.require_subcommand),
-          multi_command(rhs.multi_command),
-          section(std::move(rhs.section)),
-          id(rhs.id),
-          argument_id(rhs.argument_id)
-    {
-    }
-
-    CommandData::~CommandData() = default;
-
-    CommandData& CommandData::operator=(const CommandData& rhs)
-    {
-        if (&rhs == this)
-            return *this;
-        current_section = rhs.current_section;
-        name = rhs.name;
-        full_name = rhs.full_name;
-        texts = rhs.texts;
-        require_subcommand = rhs.require_subcommand;
-        multi_command = rhs.multi_command;
-        section = rhs.section;
-        id = rhs.id;
-        argument_id = rhs.argument_id;
-
-        arguments.clear();
-        arguments.reserve(rhs.arguments.size());
-        for (const auto& a : rhs.arguments)
-            arguments.push_back(std::make_unique<ArgumentData>(*a));
-
-        options.clear();
-        options.reserve(rhs.options.size());
-        for (const auto& o : rhs.options)
-            options.push_back(std::make_unique<OptionData>(*o));
-
-        commands.clear();
-        commands.reserve(rhs.commands.size());
-        for (const auto& c : rhs.commands)
-            commands.push_back(std::make_unique<CommandData>(*c));
-
-        return *this;
-    }
-
-    CommandData& CommandData::operator=(CommandData&& rhs) noexcept
-    {
-        if (&rhs == this)
-            return *this;
-
-        current_section = std::move(rhs.current_section);
-        name = std::move(rhs.name);
-        full_name = std::move(rhs.full_name);
-        texts = std::move(rhs.texts);
-        arguments = std::move(rhs.arguments);
-        options = std::move(rhs.options);
-        commands = std::move(rhs.commands);
-        require_subcommand = rhs.require_subcommand;
-        multi_command = rhs.multi_command;
-        section = std::move(rhs.section);
-        id = rhs.id;
-        argument_id = rhs.argument_id;
-        return *this;
-    }
+    OptionIterator::OptionIterator() = default;
 
-    void CommandData::add(std::unique_ptr<ArgumentData> arg)
+    OptionIterator::OptionIterator(std::vector<std::string_view> args, char prefix)
+        : m_queue(std::move(args)),
+          m_prefix(prefix)
     {
-        if (!arg)
-            ARGOS_THROW("Argument is empty (it has probably already been added).");
-        if (!commands.empty())
-            ARGOS_THROW("A command cannot have both arguments and subcommands.");
-        if (arg->name.empty())
-            ARGOS_THROW("Argument must have a name.");
-        if (arg->section.empty())
-            arg->section = current_section;
-        arguments.emplace_back(std::move(arg));
+        m_args = m_queue.arguments();
     }
 
-    void CommandData::add(std::unique_ptr<OptionData> opt)
+    OptionIterator::OptionIterator(ArgumentSource args, char prefix)
+        : m_args(args),
+          m_prefix(prefix)
     {
-        if (!opt)
-            ARGOS_THROW("Option is empty (it has probably already been added).");
-        if (opt->flags.empty())
-            ARGOS_THROW("Option must have at least one flag.");
-        if (opt->section.empty())
-            opt->section = current_section;
-        options.push_back(std::move(opt));
     }
 
-    void CommandData::add(std::unique_ptr<CommandData> cmd)
+    OptionIterator OptionIterator::lookahead() const
     {
-        if (!cmd)
-            ARGOS_THROW("Command is empty (it has probably already been added).");
-        if (!arguments.empty())
-            ARGOS_THROW("A command cannot have both arguments and subcommands.");
-        if (cmd->name.empty())
-            ARGOS_THROW("Command must have a name.");
-        if (cmd->section.empty())
-            cmd->section = current_section;
-        commands.push_back(std::move(cmd));
+        OptionIterator result(m_args, m_prefix);
+        result.m_pos = m_pos;
+        result.m_index = m_index;
+        return result;
     }
 
-    void CommandData::copy_from(const CommandData& cmd)
+    std::optional<std::string_view> OptionIterator::next()
     {
-        for (const auto& a : cmd.arguments)
-            arguments.push_back(std::make_unique<ArgumentData>(*a));
-
-        for (const auto& o : cmd.options)
-            options.push_back(std::make_unique<OptionData>(*o));
-
-        for (const auto& c : cmd.commands)
-            commands.push_back(std::make_unique<CommandData>(*c));
-
-        for (const auto& [text_id, source] : cmd.texts)
+        if (m_pos != 0)
         {
-            if (texts.contains(text_id))
-                ARGOS_THROW("Text with ID " + to_string(text_id) + " already exists.");
-            texts.emplace(text_id, source);
+            m_pos = 0;
+            m_args.pop_front();
+            ++m_index;
         }
 
-        if (!multi_command)
-            multi_command = cmd.multi_command;
-    }
+        if (m_args.empty())
+            return {};
 
-    void CommandData::build_option_index(bool case_insensitive)
-    {
-        std::vector<std::pair<std::string_view, const OptionData*>> index;
-        for (auto& option : options)
+        const auto arg = m_args.front();
+        if (arg.size() <= 2 || arg[0] != m_prefix)
         {
-            for (auto& flag : option->flags)
-                index.emplace_back(flag, option.get());
+            m_pos = std::string_view::npos;
+            return arg;
         }
 
-        sort(index.begin(), index.end(), [&](const auto& a, const auto& b)
+        const auto eq = arg.find('=');
+        if (eq == std::string_view::npos)
         {
-            return is_less(a.first, b.first, case_insensitive);
-        });
+            m_pos = std::string_view::npos;
+            return arg;
+        }
 
-        const auto it = adjacent_find(
-            index.begin(), index.end(),
-            [&](const auto& a, const auto& b)
-            {
-                return are_equal(a.first, b.first, case_insensitive);
-            });
+        m_pos = eq + 1;
+        return arg.substr(0, m_pos);
+    }
 
-        if (it == index.end())
+    std::optional<std::string_view> OptionIterator::next_value()
+    {
+        if (m_args.empty())
+            return {};
+
+        if (m_pos != std::string_view::npos)
         {
-            option_index = std::move(index);
-            return;
+            const auto result = m_args.front().substr(m_pos);
+            m_pos = std::string_view::npos;
+            return result;
         }
 
-        if (it->first == next(it)->first)
+        m_args.pop_front();
+        ++m_index;
+        if (m_args.empty())
         {
-            ARGOS_THROW("Multiple definitions of flag "
-                + std::string(it->first));
+            m_pos = 0;
+            return {};
         }
 
-        ARGOS_THROW("Conflicting flags: " + std::string(it->first)
-            + " and " + std::string(next(it)->first));
+        m_pos = std::string_view::npos;
+        return m_args.front();
+    }
+
+    std::string_view OptionIterator::current() const
+    {
+        if (m_args.empty())
+            ARGOS_THROW("There is no current argument.");
+        return m_args.front();
     }
 
-    const OptionData* CommandData::find_option(std::string_view flag,
-                                               bool allow_abbreviations,
-                                               bool case_insensitive) const
+    size_t OptionIterator::index() const
     {
-        auto opt = find_option_impl(flag, allow_abbreviations,
-                                    case_insensitive);
-        if (opt == nullptr && flag.size() > 2 && flag.back() == '=')
-        {
-            flag = flag.substr(0, flag.size() - 1);
-            opt = find_option_impl(flag, allow_abbreviations,
-                                   case_insensitive);
-            if (opt && opt->argument.empty())
-                opt = nullptr;
-        }
-        return opt;
+        return m_index;
     }
 
-    const OptionData* CommandData::find_option_impl(std::string_view flag,
-                                                    bool allow_abbreviations,
-                                                    bool case_insensitive) const
+    bool OptionIterator::is_within_argument() const
     {
-        const auto it = std::lower_bound(
-            option_index.begin(), option_index.end(),
-            std::pair(flag, nullptr),
-            [&](auto& a, auto& b)
-            {
-                return is_less(a.first, b.first, case_insensitive);
-            });
-        if (it == option_index.end())
-            return nullptr;
-        if (it->first == flag)
-            return it->second;
-        if (case_insensitive && are_equal_ci(it->first, flag))
-            return it->second;
-        if (!allow_abbreviations)
-            return nullptr;
-        if (!starts_with(it->first, flag, case_insensitive))
-            return nullptr;
-        const auto nxt = next(it);
-        if (nxt != option_index.end()
-            && starts_with(nxt->first, flag, case_insensitive))
-        {
-            return nullptr;
-        }
-        return it->second;
+        // Flags are never concatenated.
+        return false;
     }
 
-    const CommandData* CommandData::find_command(std::string_view cmd_name,
-                                                 bool case_insensitive) const
+    ArgumentSource OptionIterator::remaining_arguments() const
     {
-        for (const auto& c : commands)
-        {
-            if (are_equal(c->name, cmd_name, case_insensitive))
-                return c.get();
-        }
-        return nullptr;
+        return m_pos == 0 ? m_args : m_args.subspan(1);
     }
 
-    namespace
+    void OptionIterator::insert(const std::vector<std::string>& args)
     {
-        void update_require_command(CommandData& cmd)
-        {
-            if (cmd.require_subcommand.value_or(false) && cmd.commands.empty())
-                ARGOS_THROW("require_command is true, but no commands have been added.");
+        std::vector<std::string_view> views;
+        views.reserve(args.size());
+        for (const auto& arg : args)
+            views.push_back(m_strings.add(arg));
+        insert_arguments(m_pos != 0 ? 1 : 0, views);
+    }
 
-            if (!cmd.require_subcommand)
-            {
-                cmd.require_subcommand = !cmd.commands.empty();
-            }
-        }
+    void OptionIterator::insert_arguments(
+        size_t pos,
+        std::span<const std::string_view> args)
+    {
+        m_args = m_queue.insert(m_args, pos, args);
+    }
+}
 
-        bool has_help_option(const CommandData& cmd)
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    OptionTrie::OptionTrie() = default;
+
+    OptionTrie::OptionTrie(
+        std::vector<std::pair<std::string_view, const OptionData*>> flags,
+        bool case_insensitive)
+        : m_case_insensitive(case_insensitive)
+    {
+        std::vector<std::pair<std::string, const OptionData*>> folded;
+        folded.reserve(flags.size());
+        size_t text_size = 0;
+        for (const auto& [flag, option] : flags)
         {
-            for (const auto& o : cmd.options)
-            {
-                if (o->type == OptionType::HELP)
-                    return true;
-            }
-            return false;
+            auto& [str, opt] = folded.emplace_back(flag, option);
+            for (auto& c : str)
+                c = fold(c);
+            text_size += str.size();
         }
+        std::sort(folded.begin(), folded.end());
 
-        void add_help_option(CommandData& cmd, const ParserSettings& settings)
-        {
-            if (!settings.generate_help_option)
-                return;
-            if (has_help_option(cmd))
-                return;
-            std::vector<std::string> flags;
-            switch (settings.option_style)
-            {
-            case OptionStyle::STANDARD:
-                if (!has_flag(cmd, "-h", settings))
-                    flags.emplace_back("-h");
-                if (!has_flag(cmd, "--help", settings))
-                    flags.emplace_back("--help");
-                break;
-            case OptionStyle::SLASH:
-                if (!has_flag(cmd, "/?", settings))
-                    flags.emplace_back("/?");
-                break;
-            case OptionStyle::DASH:
-                if (!has_flag(cmd, "-h", settings))
-                    flags.emplace_back("-h");
-                else if (!has_flag(cmd, "-help", settings))
-                    flags.emplace_back("-help");
-                break;
-            }
+        m_labels.reserve(text_size);
+        m_nodes.emplace_back();
+        if (folded.size() == 1)
+            m_nodes[0].unique_option = folded[0].second;
+        add_children(0, folded.begin(), folded.end(), 0);
+    }
 
-            if (flags.empty())
-                return;
+    const OptionData*
+    OptionTrie::find(std::string_view flag, bool allow_abbreviations) const
+    {
+        if (m_nodes.empty())
+            return nullptr;
 
-            auto opt = Option().flags(std::move(flags)).type(OptionType::HELP)
-                .help(DEFAULT_HELP_TEXT)
-                .constant("1").release();
-            opt->section = cmd.current_section;
-            cmd.options.push_back(std::move(opt));
-        }
+        // The position of a trailing '=' that is part of the option's
+        // argument rather than its flag.
+        const auto stem_size = flag.size() > 2 && flag.back() == '='
+                               ? flag.size() - 1
+                               : std::string_view::npos;
+        const OptionData* stem_option = nullptr;
 
-        std::pair<ValueId, ArgumentId>
-        set_internal_ids(const CommandData& cmd,
-                         ValueId value_id_offset,
-                         ArgumentId argument_id_offset)
+        const Node* node = &m_nodes[0];
+        size_t label_pos = 0;
+        for (size_t i = 0; i < flag.size(); ++i)
         {
-            struct InternalIdMaker
+            if (i == stem_size)
             {
-                std::map<std::string_view, ValueId> explicit_ids;
-                int id;
-
-                explicit InternalIdMaker(ValueId start_id)
-                    : id(start_id)
-                {
-                }
-
-                std::optional<ValueId> find_value_id(std::string_view name)
-                {
-                    const auto it = explicit_ids.find(name);
-                    if (it == explicit_ids.end())
-                        return {};
-                    return it->second;
-                }
-
-                ValueId get_value_id(std::string_view name)
-                {
-                    if (const auto value_id = find_value_id(name))
-                        return *value_id;
-                    id++;
-                    explicit_ids.emplace(name, ValueId(id));
-                    return ValueId(id);
-                }
-
-                ValueId get_value_id(const std::vector<std::string>& names)
-                {
-                    for (const auto& name : names)
-                    {
-                        if (const auto value_id = find_value_id(name))
-                            return *value_id;
-                    }
-                    id++;
-                    for (const auto& name : names)
-                        explicit_ids.emplace(name, ValueId(id));
-                    return ValueId(id);
-                }
-            };
+                stem_option = get_option(*node, label_pos, allow_abbreviations);
+                if (stem_option && stem_option->argument.empty())
+                    stem_option = nullptr;
+            }
 
-            int argument_id = argument_id_offset;
-            InternalIdMaker id_maker(value_id_offset);
-            for (const auto& a : cmd.arguments)
+            const auto c = fold(flag[i]);
+            if (label_pos == node->label_size)
             {
-                a->argument_id = ArgumentId(++argument_id);
-                if (!a->alias.empty())
-                {
-                    a->value_id = id_maker.get_value_id(a->alias);
-                    id_maker.explicit_ids.emplace(a->name, a->value_id);
-                }
-                else
-                {
-                    a->value_id = id_maker.get_value_id(a->name);
-                }
+                const auto child = find_child(*node, c);
+                if (child == 0)
+                    return stem_option;
+                node = &m_nodes[child];
+                label_pos = 1;
             }
-            for (const auto& o : cmd.options)
+            else if (m_labels[node->label_offset + label_pos] == c)
             {
-                o->argument_id = ArgumentId(++argument_id);
-                if (o->operation == OptionOperation::NONE)
-                    continue;
-                if (!o->alias.empty())
-                {
-                    o->value_id = id_maker.get_value_id(o->alias);
-                    for (auto& f : o->flags)
-                        id_maker.explicit_ids.emplace(f, o->value_id);
-                }
-                else
-                {
-                    o->value_id = id_maker.get_value_id(o->flags);
-                }
+                ++label_pos;
+            }
+            else
+            {
+                return stem_option;
             }
-
-            return {ValueId(id_maker.id), ArgumentId(argument_id)};
         }
+
+        if (const auto* option = get_option(*node, label_pos, allow_abbreviations))
+            return option;
+        return stem_option;
     }
 
-    bool has_flag(const CommandData& cmd,
-                  std::string_view flag,
-                  const ParserSettings& settings)
+    bool OptionTrie::empty() const
     {
-        for (auto& o : cmd.options)
-        {
-            for (auto& f : o->flags)
-            {
-                if (are_equal(f, flag, settings.case_insensitive))
-                    return true;
-            }
-        }
-        return false;
+        return m_nodes.empty();
     }
 
     // NOLINT(*-no-recursion)
-    void finish_initialization(CommandData& cmd,
-                               const ParserData& data,
-                               ValueId start_id,
-                               ArgumentId argument_id)
+    void OptionTrie::add_children(uint32_t node_index,
+                                  FlagIterator begin, FlagIterator end,
+                                  size_t depth)
     {
-        if (cmd.full_name.empty())
-            cmd.full_name = cmd.name;
-        for (auto& o : cmd.options)
-            validate_and_update(*o, data.parser_settings.option_style);
-        update_require_command(cmd);
-        add_help_option(cmd, data.parser_settings);
+        // The flags are sorted, so flags with the same character at
+        // position depth are consecutive.
+        auto group_end = [&](FlagIterator it)
+        {
+            const auto c = it->first[depth];
+            return std::find_if(it, end, [&](const auto& f)
+            {
+                return f.first[depth] != c;
+            });
+        };
 
-        argument_id = ArgumentId(argument_id + 1);
-        cmd.argument_id = argument_id;
-        std::tie(start_id, argument_id) = set_internal_ids(cmd, start_id, argument_id);
+        uint32_t child_count = 0;
+        for (auto it = begin; it != end; it = group_end(it))
+            ++child_count;
+
+        const auto first_child = uint32_t(m_nodes.size());
+        m_nodes[node_index].first_child = first_child;
+        m_nodes[node_index].child_count = child_count;
+        m_nodes.resize(m_nodes.size() + child_count);
+
+        auto child_index = first_child;
+        for (auto it = begin; it != end; ++child_index)
+        {
+            const auto next = group_end(it);
+            // The label is the longest prefix shared by all the flags in
+            // the group, i.e. the shared prefix of the first and the last.
+            const auto& first = it->first;
+            const auto& last = std::prev(next)->first;
+            const auto label_end = size_t(std::mismatch(
+                first.begin() + ptrdiff_t(depth), first.end(),
+                last.begin() + ptrdiff_t(depth), last.end()).first - first.begin());
+
+            auto& child = m_nodes[child_index];
+            child.label_offset = uint32_t(m_labels.size());
+            child.label_size = uint32_t(label_end - depth);
+            m_labels.append(first, depth, label_end - depth);
+            if (std::next(it) == next)
+                child.unique_option = it->second;
+
+            auto rest = it;
+            if (first.size() == label_end)
+                child.option = (rest++)->second;
+            if (rest != next)
+                add_children(child_index, rest, next, label_end);
+            it = next;
+        }
+    }
+
+    uint32_t OptionTrie::find_child(const Node& node, char c) const
+    {
+        const auto begin = m_nodes.begin() + node.first_child;
+        const auto end = begin + node.child_count;
+        // The flags were sorted with std::string's operator<, which
+        // compares the characters as unsigned.
+        const auto it = std::lower_bound(
+            begin, end, uint8_t(c),
+            [&](const Node& n, uint8_t ch)
+            {
+                return uint8_t(m_labels[n.label_offset]) < ch;
+            });
+        if (it == end || m_labels[it->label_offset] != c)
+            return 0;
+        return uint32_t(it - m_nodes.begin());
+    }
 
-        cmd.build_option_index(data.parser_settings.case_insensitive);
-        for (auto& c : cmd.commands)
-        {
-            c->full_name = cmd.name + ' ' + c->name;
-            finish_initialization(*c, data, start_id, argument_id);
-        }
+    const OptionData* OptionTrie::get_option(const Node& node,
+                                             size_t label_pos,
+                                             bool allow_abbreviations) const
+    {
+        if (label_pos == node.label_size && node.option)
+            return node.option;
+        return allow_abbreviations ? node.unique_option : nullptr;
+    }
+
+    char OptionTrie::fold(char c) const
+    {
+        if (m_case_insensitive && 'a' <= c && c <= 'z')
+            return char(c - ('a' - 'A'));
+        return c;
     }
 }
 
 //****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-09-21.
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-28.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -3457,87 +9554,87 @@ namespace argos
 
 namespace argos
 {
-    CommandView::CommandView(const CommandData* command)
-        : m_command(command)
-    {}
+    OptionView::OptionView(const OptionData* data)
+        : m_option(data)
+    {
+        if (!data)
+            ARGOS_THROW("data can not be null");
+    }
 
-    std::string CommandView::help() const
+    std::string OptionView::help() const
     {
-        auto it = m_command->texts.find(TextId::ABOUT);
-        return it != m_command->texts.end() ? get_text(it->second) : "";
+        return get_text(m_option->help);
     }
 
-    const std::string& CommandView::section() const
+    const std::string& OptionView::section() const
     {
-        return m_command->section;
+        return m_option->section;
     }
 
-    const std::string& CommandView::alias() const
+    const std::string& OptionView::alias() const
     {
-        return m_command->name;
+        return m_option->alias;
     }
 
-    Visibility CommandView::visibility() const
+    OptionOperation OptionView::operation() const
     {
-        return m_command->visibility;
+        return m_option->operation;
     }
 
-    int CommandView::id() const
+    Visibility OptionView::visibility() const
     {
-        return m_command->id;
+        return m_option->visibility;
+    }
+
+    int OptionView::id() const
+    {
+        return m_option->id;
+    }
+
+    ValueId OptionView::value_id() const
+    {
+        return m_option->value_id;
     }
 
-    ValueId CommandView::value_id() const
+    const std::vector<std::string>& OptionView::flags() const
     {
-        return {};
+        return m_option->flags;
     }
 
-    ArgumentId CommandView::argument_id() const
+    const std::string& OptionView::argument() const
     {
-        return m_command->argument_id;
+        return m_option->argument;
     }
 
-    std::string CommandView::name() const
+    const std::string& OptionView::initial_value() const
     {
-        return m_command->name;
+        return m_option->initial_value;
     }
 
-    std::vector<ArgumentView> CommandView::arguments() const
+    const std::string& OptionView::constant() const
     {
-        std::vector<ArgumentView> result;
-        for (const auto& arg : m_command->arguments)
-            result.emplace_back(arg.get());
-        return result;
+        return m_option->constant;
     }
 
-    std::vector<OptionView> CommandView::options() const
+    OptionType OptionView::type() const
     {
-        std::vector<OptionView> result;
-        for (const auto& opt : m_command->options)
-            result.emplace_back(opt.get());
-        return result;
+        return m_option->type;
     }
 
-    std::vector<CommandView> CommandView::subcommands() const
+    bool OptionView::optional() const
     {
-        std::vector<CommandView> result;
-        for (const auto& cmd : m_command->commands)
-            result.emplace_back(cmd.get());
-        return result;
+        return m_option->optional;
     }
 
-    bool CommandView::require_subcommand() const
+    ArgumentId OptionView::argument_id() const
     {
-        // Instances of CommandView are only created after require_subcommand
-        // has been automatically set, the or-value should therefore never
-        // be returned, and it doesn't matter that it might not be correct.
-        return m_command->require_subcommand.value_or(false);
+        return m_option->argument_id;
     }
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-10.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -3545,585 +9642,486 @@ namespace argos
 
 namespace argos
 {
-    unsigned get_console_width();
-
-    unsigned get_console_width(unsigned min_width, unsigned default_width = 80);
-}
-
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-10.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
-
-#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
-    #include <sys/ioctl.h>
-    #include <unistd.h>
-#elif defined(WIN32)
-    #define NOMINMAX
-    #include <Windows.h>
-#endif
+    ParseError::ParseError() = default;
+
+    ParseError::ParseError(ParseErrorCode code,
+                           std::string detail,
+                           ArgumentId argument_id,
+                           std::optional<size_t> token_index,
+                           const CommandData* command,
+                           std::shared_ptr<const ParserData> data)
+        : m_code(code),
+          m_argument_id(argument_id),
+          m_token_index(token_index),
+          m_detail(std::move(detail)),
+          m_command(command),
+          m_data(std::move(data))
+    {}
 
-namespace argos
-{
-#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+    ParseError::operator bool() const
+    {
+        return m_code != ParseErrorCode::NONE;
+    }
 
-    unsigned get_console_width()
+    ParseErrorCode ParseError::code() const
     {
-        winsize ws = {};
-        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) <= -1)
-            return 0;
-        return unsigned(ws.ws_col);
+        return m_code;
     }
 
-#elif defined(WIN32)
+    std::optional<size_t> ParseError::token_index() const
+    {
+        return m_token_index;
+    }
 
-    unsigned get_console_width()
+    ArgumentId ParseError::argument_id() const
     {
-        const HANDLE h_con = GetStdHandle(STD_OUTPUT_HANDLE);
-        if (h_con == INVALID_HANDLE_VALUE)
-            return 0;
+        return m_argument_id;
+    }
 
-        CONSOLE_SCREEN_BUFFER_INFO con_info;
-        if (!GetConsoleScreenBufferInfo(h_con, &con_info))
-            return 0;
+    const std::string& ParseError::detail() const
+    {
+        return m_detail;
+    }
 
-        return unsigned(con_info.srWindow.Right - con_info.srWindow.Left);
+    std::string ParseError::message() const
+    {
+        if (!m_command)
+            return m_detail;
+        if (!has_argument_name())
+            return get_error_message(*m_command, m_detail);
+        return get_error_message(*m_command, m_detail, m_argument_id);
     }
 
-#else
+    void ParseError::write() const
+    {
+        if (!m_command)
+            return;
+        if (!has_argument_name())
+            write_error_message(*m_data, *m_command, m_detail);
+        else
+            write_error_message(*m_data, *m_command, m_detail, m_argument_id);
+    }
 
-    unsigned get_console_width()
+    bool ParseError::has_argument_name() const
     {
-        return 0;
+        // The detail of a missing option already names it.
+        return m_argument_id != ArgumentId{}
+               && m_code != ParseErrorCode::MISSING_OPTION;
     }
 
-#endif
+    ParseResult::ParseResult() = default;
 
-    unsigned get_console_width(unsigned min_width, unsigned int default_width)
+    ParseResult::ParseResult(ParsedArguments args, ParseError error)
+        : m_args(std::move(args)),
+          m_error(std::move(error))
+    {}
+
+    bool ParseResult::has_value() const
     {
-        const auto width = get_console_width();
-        if (width == 0)
-            return default_width;
-        return width < min_width ? min_width : width;
+        return !m_error;
     }
-}
 
-//****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-10-18.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
+    ParseResult::operator bool() const
+    {
+        return has_value();
+    }
 
-namespace argos
-{
-#define ENUM_CASE(x) case TextId::x: return #x
+    const ParsedArguments& ParseResult::value() const
+    {
+        return m_args;
+    }
 
-    std::string to_string(TextId textId)
+    const ParseError& ParseResult::error() const
     {
-        switch (textId)
-        {
-        ENUM_CASE(INITIAL_TEXT);
-        ENUM_CASE(USAGE_TITLE);
-        ENUM_CASE(USAGE);
-        ENUM_CASE(ABOUT);
-        ENUM_CASE(SUBCOMMANDS_TITLE);
-        ENUM_CASE(ARGUMENTS_TITLE);
-        ENUM_CASE(OPTIONS_TITLE);
-        ENUM_CASE(FINAL_TEXT);
-        ENUM_CASE(ERROR_USAGE);
-        ENUM_CASE(HELP);
-        default:
-            return "<Unknown>";
-        }
+        return m_error;
     }
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-21.
+// Created by Jan Erik Breimo on 2020-02-13.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
 
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 namespace argos
 {
     namespace
     {
-        constexpr auto DEFAULT_SUBCOMMANDS_TITLE = "COMMANDS";
-        constexpr auto DEFAULT_ARGUMENTS_TITLE = "ARGUMENTS";
-        constexpr auto DEFAULT_OPTIONS_TITLE = "OPTIONS";
-        constexpr auto DEFAULT_USAGE_TITLE = "USAGE";
-
-        std::string get_argument_name(const ArgumentData& arg)
-        {
-            if (arg.name[0] == '<' || arg.name[0] == '[')
-                return arg.name;
-
-            std::string result;
-            for (unsigned i = 0; i < arg.min_count; ++i)
-            {
-                if (!result.empty())
-                    result += " ";
-                result += "<" + arg.name + ">";
-            }
-
-            if (arg.max_count == arg.min_count)
-                return result;
-
-            if (!result.empty())
-                result += " ";
-            if (arg.max_count - arg.min_count == 1)
-                result += "[<" + arg.name + ">]";
-            else
-                result += "[<" + arg.name + ">]...";
-            return result;
-        }
-
-        bool is_stop_option(OptionType type)
-        {
-            return type == OptionType::HELP
-                   || type == OptionType::STOP
-                   || type == OptionType::EXIT;
-        }
-
-        std::string get_brief_option_name(const OptionData& opt,
-                                          bool prefer_long_flag)
-        {
-            std::string opt_txt;
-            const bool braces = opt.optional
-                                && !is_stop_option(opt.type);
-            if (braces)
-                opt_txt.push_back('[');
-
-            std::string_view flag;
-            if (prefer_long_flag)
-            {
-                const auto it = std::find_if(opt.flags.begin(), opt.flags.end(),
-                                             [](auto& s) { return s.size() > 2; });
-                if (it != opt.flags.end())
-                    flag = *it;
-            }
-
-            if (flag.empty())
-                flag = opt.flags.front();
-
-            opt_txt += flag;
-            if (!opt.argument.empty())
-            {
-                if (flag.back() != '=')
-                    opt_txt += " ";
-                if (opt.argument.front() != '<')
-                {
-                    opt_txt += "<";
-                    opt_txt += opt.argument;
-                    opt_txt.push_back('>');
-                }
-                else
-                {
-                    opt_txt += opt.argument;
-                }
-            }
-            if (braces)
-                opt_txt.push_back(']');
-            return opt_txt;
-        }
-
-        std::string get_long_option_name(const OptionData& opt)
-        {
-            std::string opt_txt;
-            for (const auto& flag : opt.flags)
-            {
-                if (!opt_txt.empty())
-                    opt_txt.append(", ");
-                opt_txt += flag;
-                if (!opt.argument.empty())
-                {
-                    if (flag.back() != '=')
-                        opt_txt.push_back(' ');
-                    if (opt.argument.front() != '<')
-                    {
-                        opt_txt += "<";
-                        opt_txt += opt.argument;
-                        opt_txt.push_back('>');
-                    }
-                    else
-                    {
-                        opt_txt += opt.argument;
-                    }
-                }
-            }
-            return opt_txt;
-        }
-
-        std::optional<std::string>
-        get_custom_text(const CommandData& data, TextId text_id)
-        {
-            const auto it = data.texts.find(text_id);
-            if (it != data.texts.end())
-            {
-                return get_text(it->second);
-            }
-            return {};
+        /**
+         * @brief Removes leading whitespace and the sign from @a str,
+         *  returns true if the sign is '-'.
+         */
+        bool remove_whitespace_and_sign(std::string_view& str)
+        {
+            size_t i = 0;
+            while (i < str.size() && is_space(str[i]))
+                ++i;
+            bool negative = false;
+            if (i < str.size() && (str[i] == '-' || str[i] == '+'))
+                negative = str[i++] == '-';
+            str.remove_prefix(i);
+            return negative;
         }
 
-        bool is_empty(const std::optional<std::string>& str)
+        bool has_hex_prefix(std::string_view str)
         {
-            return !str || str->empty();
+            return str.size() >= 2 && str[0] == '0'
+                   && (str[1] == 'x' || str[1] == 'X');
         }
 
-        std::optional<std::string>
-        write_custom_text(TextFormatter& formatter,
-                          const CommandData& cmd,
-                          TextId text_id,
-                          bool prepend_newline = false)
+        /**
+         * @brief Returns true if all eight bytes in @a chunk are digits.
+         */
+        bool is_eight_digits(uint64_t chunk)
         {
-            auto text = get_custom_text(cmd, text_id);
-            if (!is_empty(text))
-            {
-                if (prepend_newline)
-                    formatter.newline();
-                formatter.write_words(*text);
-                if (!formatter.is_current_line_empty())
-                    formatter.newline();
-            }
-            return text;
+            return ((chunk & 0xF0F0F0F0F0F0F0F0)
+                    | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0)
+                       >> 4)) == 0x3333333333333333;
         }
 
-        void write_stop_and_help_usage(TextFormatter& formatter,
-                                       const CommandData& cmd)
+        /**
+         * @brief Returns the value of the eight digits in @a chunk, where
+         *  the first digit is in the least significant byte.
+         */
+        uint32_t parse_eight_digits(uint64_t chunk)
         {
-            for (auto& opt : cmd.options)
-            {
-                if ((opt->visibility & Visibility::USAGE) == Visibility::HIDDEN
-                    || !is_stop_option(opt->type))
-                {
-                    continue;
-                }
-
-                formatter.write_words(cmd.full_name);
-                formatter.write_words(" ");
-                formatter.push_indentation(TextFormatter::CURRENT_COLUMN);
-                formatter.write_lines(get_brief_option_name(*opt, true));
-                formatter.write_words(" ");
-                formatter.pop_indentation();
-                formatter.newline();
-            }
+            chunk -= 0x3030303030303030;
+            chunk = chunk * 10 + (chunk >> 8);
+            chunk = ((chunk & 0x000000FF000000FF)
+                     * (100 + (1000000ULL << 32))
+                     + ((chunk >> 16) & 0x000000FF000000FF)
+                       * (1 + (10000ULL << 32))) >> 32;
+            return uint32_t(chunk);
         }
 
-        using HelpText = std::pair<std::string, std::string>;
-        using HelpTextVector = std::vector<HelpText>;
-        using SectionHelpTexts = std::pair<std::string_view, HelpTextVector>;
-
-        unsigned int get_help_text_label_width(
-            const TextFormatter& formatter,
-            const std::vector<SectionHelpTexts>& sections)
+        /**
+         * @brief Parses @a str, which must have at most 19 characters, if
+         *  it only consists of decimal digits.
+         *
+         * Eight digits are converted at a time with ordinary 64-bit
+         * arithmetic, which is considerably faster than std::from_chars
+         * for the long numbers that are typical of data values.
+         */
+        bool parse_decimal_digits(std::string_view str, uint64_t& value)
         {
-            // Determine what width should be reserved for the argument names
-            // and option flags.
-            std::vector<unsigned> name_widths;
-            std::vector<unsigned> text_widths;
-            for (const auto& [_, help_texts] : sections)
+            uint64_t result = 0;
+            size_t i = 0;
+            if constexpr (std::endian::native == std::endian::little)
             {
-                for (const auto& [name, txt] : help_texts)
+                for (; i + 8 <= str.size(); i += 8)
                 {
-                    name_widths.push_back(static_cast<unsigned>(name.size()));
-                    text_widths.push_back(static_cast<unsigned>(txt.size()));
+                    uint64_t chunk;
+                    std::memcpy(&chunk, str.data() + i, 8);
+                    if (!is_eight_digits(chunk))
+                        return false;
+                    result = result * 100000000 + parse_eight_digits(chunk);
                 }
             }
-
-            std::sort(name_widths.begin(), name_widths.end());
-            std::sort(text_widths.begin(), text_widths.end());
-            const auto line_width = formatter.line_width();
-            // Check if both the longest name and the longest help text
-            // can fit on the same line.
-            const auto name_width = name_widths.back() + 3;
-            if (name_width > 32 || name_width + text_widths.back() > line_width)
-                return 0;
-            return name_width;
+            for (; i < str.size(); ++i)
+            {
+                const auto digit = unsigned(str[i]) - '0';
+                if (digit > 9)
+                    return false;
+                result = result * 10 + digit;
+            }
+            value = result;
+            return true;
         }
 
-        void write_argument_sections(TextFormatter& formatter,
-                                     const CommandData& command,
-                                     bool prepend_newline)
+        /**
+         * @brief Parses the digits in @a str as an unsigned number,
+         *  after removing the base prefix if there is one.
+         */
+        template <typename T>
+        bool parse_magnitude(std::string_view str, int base, T& value)
         {
-            std::vector<SectionHelpTexts> sections;
-
-            auto add_help_text = [&](std::string_view s, std::string a, std::string b)
+            if (base == 0)
             {
-                auto it = find_if(sections.begin(), sections.end(),
-                                  [&](const auto& v)
-                                  {
-                                      return v.first == s;
-                                  });
-                if (it == sections.end())
+                if (has_hex_prefix(str))
                 {
-                    sections.push_back({s, {}});
-                    it = std::prev(sections.end());
+                    str.remove_prefix(2);
+                    base = 16;
                 }
-                it->second.emplace_back(std::move(a), std::move(b));
-            };
-
-            // List all arguments
-            auto arg_title = get_custom_text(command, TextId::ARGUMENTS_TITLE);
-            if (!arg_title)
-                arg_title = DEFAULT_ARGUMENTS_TITLE;
-            for (auto& a : command.arguments)
+                else
+                {
+                    // A leading 0 is parsed as an octal digit.
+                    base = !str.empty() && str[0] == '0' ? 8 : 10;
+                }
+            }
+            else if (base == 16 && has_hex_prefix(str))
             {
-                if ((a->visibility & Visibility::TEXT) == Visibility::HIDDEN)
-                    continue;
-                auto& section = a->section.empty() ? *arg_title : a->section;
-                add_help_text(section, get_argument_name(*a), get_text(a->help));
+                str.remove_prefix(2);
             }
-
-            // List all sub-commands after arguments, as arguments must be
-            // given first.
-            auto cmd_title = get_custom_text(command, TextId::SUBCOMMANDS_TITLE);
-            if (!cmd_title)
-                cmd_title = DEFAULT_SUBCOMMANDS_TITLE;
-            for (auto& c : command.commands)
+            else if (base < 2 || 36 < base)
             {
-                if ((c->visibility & Visibility::TEXT) == Visibility::HIDDEN)
-                    continue;
-                auto& section = c->section.empty() ? *cmd_title : c->section;
-                add_help_text(section, c->name,
-                              get_custom_text(*c, TextId::HELP).value_or(""));
+                return false;
             }
 
-            // List all options.
-            auto opt_title = get_custom_text(command, TextId::OPTIONS_TITLE);
-            if (!opt_title)
-                opt_title = DEFAULT_OPTIONS_TITLE;
-            for (auto& o : command.options)
+            if (str.empty())
+                return false;
+
+            if (base == 10 && str.size() <= size_t(std::numeric_limits<T>::digits10))
             {
-                if ((o->visibility & Visibility::TEXT) == Visibility::HIDDEN)
-                    continue;
-                auto& section = o->section.empty() ? *opt_title : o->section;
-                add_help_text(section, get_long_option_name(*o), get_text(o->help));
+                uint64_t n;
+                if (!parse_decimal_digits(str, n))
+                    return false;
+                value = T(n);
+                return true;
             }
 
-            if (sections.empty())
-                return;
+            // The sign has been removed, and from_chars accepts none for
+            // unsigned types.
+            const auto end = str.data() + str.size();
+            const auto [ptr, ec] = std::from_chars(str.data(), end, value, base);
+            return ec == std::errc() && ptr == end;
+        }
 
-            const unsigned name_width = get_help_text_label_width(formatter, sections);
+        template <typename T>
+        std::optional<T> parse_integer_impl(std::string_view str, int base)
+        {
+            using U = std::make_unsigned_t<T>;
+            const auto negative = remove_whitespace_and_sign(str);
+            U magnitude;
+            if (!parse_magnitude(str, base, magnitude))
+                return {};
 
-            for (auto& [section, texts] : sections)
+            if constexpr (std::is_signed_v<T>)
             {
-                if (prepend_newline)
-                    formatter.newline();
-                formatter.write_words(section);
-                formatter.newline();
-                formatter.push_indentation(2);
-                for (auto& [name, text] : texts)
-                {
-                    formatter.write_words(name);
-                    if (!text.empty())
-                    {
-                        if (name_width)
-                        {
-                            if (formatter.current_line_width() >= name_width)
-                                formatter.write_words("  ");
-                            formatter.push_indentation(name_width);
-                        }
-                        else
-                        {
-                            formatter.newline();
-                            formatter.push_indentation(8);
-                        }
-                        formatter.write_words(text);
-                        formatter.pop_indentation();
-                    }
-                    formatter.newline();
-                }
-                formatter.pop_indentation();
-                prepend_newline = true;
+                constexpr auto max = U(std::numeric_limits<T>::max());
+                if (magnitude > max + U(negative))
+                    return {};
             }
+
+            // The negation of unsigned numbers wraps around, just like in
+            // strtoul.
+            return T(negative ? U(0) - magnitude : magnitude);
         }
+    }
 
-        void write_brief_regular_options(TextFormatter& formatter,
-                                         const CommandData& command)
+    template <>
+    std::optional<int> parse_integer<int>(std::string_view str, int base)
+    {
+        const auto n = parse_integer_impl<long>(str, base);
+        if (!n)
+            return {};
+
+        if constexpr (sizeof(int) != sizeof(long))
         {
-            for (auto& opt : command.options)
-            {
-                if ((opt->visibility & Visibility::USAGE) == Visibility::HIDDEN
-                    || is_stop_option(opt->type))
-                {
-                    continue;
-                }
+            if (*n < INT_MIN || INT_MAX < *n)
+                return {};
+        }
+        return static_cast<int>(*n);
+    }
 
-                formatter.write_lines(get_brief_option_name(*opt, false));
-                formatter.write_words(" ");
-            }
+    template <>
+    std::optional<unsigned>
+    parse_integer<unsigned>(std::string_view str, int base)
+    {
+        auto n = parse_integer_impl<unsigned long>(str, base);
+        if (!n)
+            return {};
+
+        if constexpr (sizeof(unsigned) != sizeof(unsigned long))
+        {
+            if (UINT_MAX < *n)
+                return {};
+        }
+        return static_cast<unsigned>(*n);
+    }
+
+    template <>
+    std::optional<long> parse_integer<long>(std::string_view str, int base)
+    {
+        return parse_integer_impl<long>(str, base);
+    }
+
+    template <>
+    std::optional<long long>
+    parse_integer<long long>(std::string_view str, int base)
+    {
+        return parse_integer_impl<long long>(str, base);
+    }
+
+    template <>
+    std::optional<unsigned long>
+    parse_integer<unsigned long>(std::string_view str, int base)
+    {
+        return parse_integer_impl<unsigned long>(str, base);
+    }
+
+    template <>
+    std::optional<unsigned long long>
+    parse_integer<unsigned long long>(std::string_view str, int base)
+    {
+        return parse_integer_impl<unsigned long long>(str, base);
+    }
+
+    namespace
+    {
+        template <typename T>
+        T str_to_float(const char* str, char** endp);
+
+        template <>
+        float str_to_float<float>(const char* str, char** endp)
+        {
+            return strtof(str, endp);
+        }
+
+        template <>
+        double str_to_float<double>(const char* str, char** endp)
+        {
+            return strtod(str, endp);
+        }
+
+        template <typename T>
+        std::optional<T> parse_with_strtod(std::string_view sv)
+        {
+            if (sv.empty())
+                return {};
+            const std::string str(sv);
+            char* endp = nullptr;
+            errno = 0;
+            auto value = str_to_float<T>(str.c_str(), &endp);
+            if (endp == str.c_str() + str.size() && errno == 0)
+                return value;
+            return {};
         }
 
-        void write_brief_arguments(TextFormatter& formatter,
-                                   const CommandData& command)
+#ifdef __cpp_lib_to_chars
+
+        template <typename T>
+        std::optional<T> parse_floating_point_impl(std::string_view str)
         {
-            for (auto& arg : command.arguments)
+            const auto original = str;
+            const auto negative = remove_whitespace_and_sign(str);
+            auto format = std::chars_format::general;
+            if (has_hex_prefix(str))
             {
-                if ((arg->visibility & Visibility::USAGE) == Visibility::HIDDEN)
-                    continue;
-                formatter.write_lines(get_argument_name(*arg));
-                formatter.write_words(" ");
+                str.remove_prefix(2);
+                format = std::chars_format::hex;
+                // from_chars accepts "inf" and "nan" in hex format too.
+                if (str.empty() || !(std::isxdigit(uint8_t(str[0])) || str[0] == '.'))
+                    return {};
             }
-        }
-
-        void write_brief_commands(TextFormatter& formatter,
-                                  const CommandData& command)
-        {
-            if (command.commands.empty())
-                return;
 
-            auto brackets = !command.require_subcommand.value_or(false);
+            // The sign has already been removed.
+            if (str.empty() || str[0] == '-')
+                return {};
 
-            if (brackets)
-                formatter.write_words("[");
+            T value;
+            const auto end = str.data() + str.size();
+            const auto [ptr, ec] = std::from_chars(str.data(), end, value, format);
+            if (ec != std::errc() || ptr != end)
+                return {};
 
-            bool first_command = true;
-            for (auto& cmd : command.commands)
-            {
-                if ((cmd->visibility & Visibility::USAGE) == Visibility::HIDDEN)
-                    continue;
-                if (!first_command)
-                    formatter.write_words("|");
-                first_command = false;
-                formatter.write_words(cmd->name);
-            }
+            // strtod reports a range error if the result is subnormal
+            // and inexact, which from_chars doesn't tell us. Subnormal
+            // numbers are rare enough to let strtod decide.
+            if (std::fpclassify(value) == FP_SUBNORMAL)
+                return parse_with_strtod<T>(original);
 
-            if (brackets)
-                formatter.write_words("]");
+            return negative ? -value : value;
         }
 
-        void write_brief_usage(TextFormatter& formatter,
-                               const CommandData& command,
-                               bool prepend_newline)
+#else
+
+        template <typename T>
+        std::optional<T> parse_floating_point_impl(std::string_view str)
         {
-            if (prepend_newline)
-                formatter.newline();
+            return parse_with_strtod<T>(str);
+        }
 
-            formatter.push_indentation(2);
-            write_stop_and_help_usage(formatter, command);
-            formatter.write_words(command.full_name);
-            formatter.write_words(" ");
-            formatter.push_indentation(TextFormatter::CURRENT_COLUMN);
+#endif
+    }
 
-            write_brief_regular_options(formatter, command);
-            write_brief_arguments(formatter, command);
-            write_brief_commands(formatter, command);
+    template <>
+    std::optional<float> parse_floating_point<float>(std::string_view str)
+    {
+        return parse_floating_point_impl<float>(str);
+    }
 
-            formatter.pop_indentation();
-            formatter.newline();
-            formatter.pop_indentation();
-        }
+    template <>
+    std::optional<double> parse_floating_point<double>(std::string_view str)
+    {
+        return parse_floating_point_impl<double>(str);
+    }
 
-        bool write_usage(TextFormatter& formatter,
-                         const CommandData& command,
-                         bool prepend_newline = false)
+    namespace
+    {
+        template <typename T>
+        bool set_if_valid(const std::optional<T>& src, T& dst)
         {
-            if (const auto t = get_custom_text(command, TextId::USAGE); t && t->empty())
+            if (!src)
                 return false;
-
-            const auto text1 = write_custom_text(formatter, command,
-                                                 TextId::USAGE_TITLE,
-                                                 prepend_newline);
-            if (!text1)
-            {
-                if (prepend_newline)
-                    formatter.newline();
-                formatter.write_words(DEFAULT_USAGE_TITLE);
-                formatter.newline();
-                prepend_newline = false;
-            }
-            else
-            {
-                prepend_newline = prepend_newline && is_empty(text1);
-            }
-            const auto text2 = write_custom_text(formatter, command,
-                                                 TextId::USAGE,
-                                                 prepend_newline);
-            if (text2)
-                return !is_empty(text1) || !is_empty(text2);
-            write_brief_usage(formatter, command, prepend_newline);
+            dst = *src;
             return true;
         }
-
-        std::string get_name(const CommandData& data, ArgumentId argument_id)
-        {
-            for (const auto& a : data.arguments)
-            {
-                if (a->argument_id == argument_id)
-                    return a->name;
-            }
-            for (const auto& o : data.options)
-            {
-                if (o->argument_id == argument_id)
-                {
-                    std::string name = o->flags.front();
-                    for (size_t i = 1; i < o->flags.size(); ++i)
-                        name += ", " + o->flags[i];
-                    return name;
-                }
-            }
-            return {};
-        }
     }
 
-    void write_help_text(const ParserData& data, const CommandData& cmd)
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           TypedValue& value)
     {
-        TextFormatter formatter;
-        if (data.help_settings.line_width)
-            formatter.set_line_width(data.help_settings.line_width);
-        if (data.help_settings.output_stream)
-            formatter.set_stream(data.help_settings.output_stream);
-        formatter.word_splitter().add_words(data.help_settings.word_split_rules);
-        bool newline = !is_empty(write_custom_text(formatter, cmd, TextId::INITIAL_TEXT));
-        newline = write_usage(formatter, cmd, newline) || newline;
-        newline = !is_empty(write_custom_text(formatter, cmd, TextId::ABOUT, newline))
-                  || !is_empty(write_custom_text(formatter, cmd, TextId::HELP, newline))
-                  || newline;
-        write_argument_sections(formatter, cmd, newline);
-        write_custom_text(formatter, cmd, TextId::FINAL_TEXT, true);
+        switch (type)
+        {
+        case ValueType::STRING:
+            return true;
+        case ValueType::BOOL:
+            value.bool_value = !str.empty() && str != "0" && str != "false";
+            return true;
+        case ValueType::INT:
+            return set_if_valid(parse_integer<int>(str, 10), value.int_value);
+        case ValueType::UINT:
+            return set_if_valid(parse_integer<unsigned>(str, 10), value.uint_value);
+        case ValueType::LONG:
+            return set_if_valid(parse_integer<long>(str, 10), value.long_value);
+        case ValueType::LLONG:
+            return set_if_valid(parse_integer<long long>(str, 10), value.llong_value);
+        case ValueType::ULONG:
+            return set_if_valid(parse_integer<unsigned long>(str, 10),
+                          value.ulong_value);
+        case ValueType::ULLONG:
+            return set_if_valid(parse_integer<unsigned long long>(str, 10),
+                          value.ullong_value);
+        case ValueType::FLOAT:
+            return set_if_valid(parse_floating_point<float>(str), value.float_value);
+        case ValueType::DOUBLE:
+            return set_if_valid(parse_floating_point<double>(str),
+                          value.double_value);
+        case ValueType::CHOICE:
+            // Requires the list of choices.
+            return false;
+        }
+        return false;
     }
 
-    void write_error_message(const ParserData& data,
-                             const CommandData& cmd,
-                             const std::string& msg)
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           const ChoiceSet* choices, TypedValue& value)
     {
-        TextFormatter formatter;
-        if (data.help_settings.line_width)
-            formatter.set_line_width(data.help_settings.line_width);
-        if (data.help_settings.output_stream)
-            formatter.set_stream(data.help_settings.output_stream);
-        else
-            formatter.set_stream(&std::cerr);
-        formatter.word_splitter().add_words(data.help_settings.word_split_rules);
-        formatter.write_words(cmd.full_name + ": ");
-        formatter.write_words(msg);
-        formatter.newline();
-        if (!write_custom_text(formatter, cmd, TextId::ERROR_USAGE))
-            write_usage(formatter, cmd);
-    }
+        if (!choices)
+            return parse_typed_value(str, type, value);
 
-    void write_error_message(const ParserData& data,
-                             const CommandData& cmd,
-                             const std::string& msg,
-                             ArgumentId argument_id)
-    {
-        if (const auto name = get_name(cmd, argument_id); !name.empty())
-            write_error_message(data, cmd, name + ": " + msg);
-        else
-            write_error_message(data, cmd, msg);
+        const auto index = choices->find(str);
+        if (!index)
+            return false;
+        if (type != ValueType::CHOICE)
+            return parse_typed_value(str, type, value);
+        value.uint_value = unsigned(*index);
+        return true;
     }
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-10.
+// Created by Jan Erik Breimo on 2020-01-26.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -4131,428 +10129,279 @@ namespace argos
 
 namespace argos
 {
-    Option::Option()
-        : m_option(std::make_unique<OptionData>())
-    {}
-
-    Option::Option(std::string flag)
-        : m_option(std::make_unique<OptionData>())
-    {
-        m_option->flags.emplace_back(std::move(flag));
-    }
-
-    Option::Option(std::string flag1, std::string flag2)
-        : m_option(std::make_unique<OptionData>())
-    {
-        m_option->flags.emplace_back(std::move(flag1));
-        m_option->flags.emplace_back(std::move(flag2));
-    }
-
-    Option::Option(std::initializer_list<std::string> flags)
-        : m_option(std::make_unique<OptionData>())
-    {
-        m_option->flags = flags;
-    }
-
-    Option::Option(const Option& rhs)
-        : m_option(rhs.m_option
-                   ? std::make_unique<OptionData>(*rhs.m_option)
-                   : std::unique_ptr<OptionData>())
-    {}
+    ParsedArguments::ParsedArguments() = default;
 
-    Option::Option(Option&& rhs) noexcept
-        : m_option(std::move(rhs.m_option))
+    ParsedArguments::ParsedArguments(std::shared_ptr<ParsedArgumentsImpl> impl)
+        : m_impl(std::move(impl))
     {}
 
-    Option::~Option() = default;
+    ParsedArguments::ParsedArguments(const ParsedArguments& rhs) = default;
 
-    Option& Option::operator=(const Option& rhs)
-    {
-        if (this != &rhs)
-        {
-            if (rhs.m_option)
-                m_option = std::make_unique<OptionData>(*rhs.m_option);
-            else
-                m_option = {};
-        }
-        return *this;
-    }
+    ParsedArguments::ParsedArguments(ParsedArguments&& rhs) noexcept = default;
 
-    Option& Option::operator=(Option&& rhs) noexcept
-    {
-        m_option = std::move(rhs.m_option);
-        return *this;
-    }
+    ParsedArguments::~ParsedArguments() = default;
 
-    Option& Option::help(const std::string& text)
-    {
-        check_option();
-        m_option->help = text;
-        return *this;
-    }
+    ParsedArguments& ParsedArguments::operator=(const ParsedArguments&) = default;
 
-    Option& Option::help(TextCallback callback)
-    {
-        check_option();
-        m_option->help = callback;
-        return *this;
-    }
+    ParsedArguments& ParsedArguments::operator=(ParsedArguments&& rhs) noexcept = default;
 
-    Option& Option::section(const std::string& name)
+    CommandView ParsedArguments::command() const
     {
-        check_option();
-        m_option->section = name;
-        return *this;
+        return CommandView(m_impl->command());
     }
 
-    Option& Option::alias(const std::string& id)
+    std::string_view ParsedArguments::name() const
     {
-        check_option();
-        m_option->alias = id;
-        return *this;
+        return m_impl->command()->name;
     }
 
-    Option& Option::operation(OptionOperation operation)
+    bool ParsedArguments::has(const std::string& name) const
     {
-        check_option();
-        m_option->operation = operation;
-        return *this;
+        return m_impl->has(m_impl->get_value_id(name));
     }
 
-    Option& Option::visibility(Visibility visibility)
+    bool ParsedArguments::has(const IArgumentView& arg) const
     {
-        check_option();
-        m_option->visibility = visibility;
-        return *this;
+        return m_impl->has(arg.value_id());
     }
 
-    Option& Option::id(int id)
+    bool ParsedArguments::has(ValueHandle handle) const
     {
-        check_option();
-        m_option->id = id;
-        return *this;
+        return m_impl->has(m_impl->get_ids(handle).first);
     }
 
-    Option& Option::flag(const std::string& f)
+    std::vector<ParsedArguments> ParsedArguments::subcommands() const
     {
-        check_option();
-        m_option->flags = {f};
-        return *this;
+        std::vector<ParsedArguments> result;
+        for (const auto& subcommand : m_impl->subcommands())
+            result.emplace_back(subcommand);
+        return result;
     }
 
-    Option& Option::flags(std::vector<std::string> f)
+    ArgumentValue ParsedArguments::value(const std::string& name) const
     {
-        check_option();
-        m_option->flags = std::move(f);
-        return *this;
+        return ParsedArgumentsImpl::make_value(m_impl,
+                                               m_impl->get_value_id(name));
     }
 
-    Option& Option::argument(const std::string& name)
+    ArgumentValue ParsedArguments::value(const IArgumentView& arg) const
     {
-        check_option();
-        m_option->argument = name;
-        return *this;
+        return ParsedArgumentsImpl::make_value(m_impl, arg.value_id(),
+                                               arg.argument_id());
     }
 
-    Option& Option::initial_value(const std::string& value)
+    ArgumentValue ParsedArguments::value(ValueHandle handle) const
     {
-        check_option();
-        m_option->initial_value = value;
-        return *this;
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        return ParsedArgumentsImpl::make_value(m_impl, value_id, argument_id);
     }
 
-    Option& Option::constant(const char* value)
+    ArgumentValues ParsedArguments::values(const std::string& name) const
     {
-        return this->constant(std::string(value));
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_value_id(name));
     }
 
-    Option& Option::constant(const std::string& value)
+    ArgumentValues ParsedArguments::values(const IArgumentView& arg) const
     {
-        check_option();
-        m_option->constant = value;
-        return *this;
+        return ParsedArgumentsImpl::make_values(m_impl, arg.value_id());
     }
 
-    Option& Option::constant(bool value)
+    ArgumentValues ParsedArguments::values(ValueHandle handle) const
     {
-        return this->constant(value ? 1LL : 0LL);
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_ids(handle).first);
     }
 
-    Option& Option::constant(int value)
+    ValuesView<std::string_view>
+    ParsedArguments::values_view(const std::string& name) const
     {
-        return this->constant(static_cast<long long>(value));
+        return ValuesView<std::string_view>(
+            m_impl->make_view(m_impl->get_value_id(name)));
     }
 
-    Option& Option::constant(long long value)
+    ValuesView<std::string_view>
+    ParsedArguments::values_view(const IArgumentView& arg) const
     {
-        check_option();
-        m_option->constant = std::to_string(value);
-        return *this;
+        return ValuesView<std::string_view>(m_impl->make_view(arg.value_id()));
     }
 
-    Option& Option::callback(OptionCallback callback)
+    ValuesView<std::string_view>
+    ParsedArguments::values_view(ValueHandle handle) const
     {
-        check_option();
-        m_option->callback = std::move(callback);
-        return *this;
+        return ValuesView<std::string_view>(
+            m_impl->make_view(m_impl->get_ids(handle).first));
     }
 
-    Option& Option::type(OptionType type)
+    ArgumentDictionary ParsedArguments::dictionary(const std::string& name) const
     {
-        check_option();
-        m_option->type = type;
-        return *this;
+        return m_impl->make_dictionary(m_impl->get_value_id(name));
     }
 
-    Option& Option::optional(bool optional)
+    ArgumentDictionary
+    ParsedArguments::dictionary(const IArgumentView& arg) const
     {
-        check_option();
-        m_option->optional = optional;
-        return *this;
+        return m_impl->make_dictionary(arg.value_id());
     }
 
-    Option& Option::mandatory(bool mandatory)
+    ArgumentDictionary ParsedArguments::dictionary(ValueHandle handle) const
     {
-        return optional(!mandatory);
+        return m_impl->make_dictionary(m_impl->get_ids(handle).first);
     }
 
-    const OptionData& Option::data() const
+    std::vector<std::unique_ptr<ArgumentView>>
+    ParsedArguments::all_arguments() const
     {
-        check_option();
-        return *m_option;
+        std::vector<std::unique_ptr<ArgumentView>> result;
+        for (auto& a : m_impl->command()->arguments)
+            result.emplace_back(std::make_unique<ArgumentView>(a.get()));
+        return result;
     }
 
-    std::unique_ptr<OptionData> Option::release()
+    std::vector<std::unique_ptr<OptionView>>
+    ParsedArguments::all_options() const
     {
-        check_option();
-        return std::move(m_option);
+        std::vector<std::unique_ptr<OptionView>> result;
+        for (auto& o : m_impl->command()->options)
+            result.emplace_back(std::make_unique<OptionView>(o.get()));
+        return result;
     }
 
-    void Option::check_option() const
+    std::vector<std::unique_ptr<CommandView>>
+    ParsedArguments::all_subcommands() const
     {
-        if (!m_option)
-            ARGOS_THROW("Cannot use Option instance after"
-                        " release() has been called.");
+        std::vector<std::unique_ptr<CommandView>> result;
+        for (auto& c : m_impl->command()->commands)
+            result.emplace_back(std::make_unique<CommandView>(c.get()));
+        return result;
     }
-}
-
-//****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-10-05.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
 
-namespace argos
-{
-    namespace
+    ParserResultCode ParsedArguments::result_code() const
     {
-        bool check_flag_with_equal(const std::string& flag,
-                                   const OptionData& od)
-        {
-            const auto eq_pos = flag.find('=');
-            if (eq_pos == std::string::npos)
-                return true;
-            if (eq_pos != flag.size() - 1)
-                ARGOS_THROW("Options can not have a '=' in the middle: " + flag);
-            if (od.argument.empty())
-                ARGOS_THROW("Options ending with '=' must have a named argument: " + flag);
-            return true;
-        }
-
-        bool check_standard_flag(const std::string& flag,
-                                 const OptionData& od)
-        {
-            if (flag.find_first_of(" \t\n\r") != std::string::npos)
-                return false;
-            if (flag.size() < 2)
-                return false;
-            if (flag[0] != '-')
-                return false;
-            if (flag.size() == 2)
-                return true;
-            if (flag[1] != '-')
-                return false;
-            return check_flag_with_equal(flag, od);
-        }
-
-        bool check_flag(const std::string& flag, char prefix,
-                        const OptionData& od)
-        {
-            if (flag.size() < 2 || flag[0] != prefix)
-                return false;
-            if (flag.find_first_of(" \t\n\r") != std::string::npos)
-                return false;
-            if (flag.size() == 2)
-                return true;
-            return check_flag_with_equal(flag, od);
-        }
+        return m_impl->result_code();
     }
 
-    void validate_and_update(OptionData& option, OptionStyle style)
+    OptionView ParsedArguments::stop_option() const
     {
-        if (option.flags.empty())
-            ARGOS_THROW("Option must have one or more flags.");
-
-        for (auto& flag : option.flags)
-        {
-            bool ok = false;
-            switch (style)
-            {
-            case OptionStyle::STANDARD:
-                ok = check_standard_flag(flag, option);
-                break;
-            case OptionStyle::SLASH:
-                ok = check_flag(flag, '/', option);
-                break;
-            case OptionStyle::DASH:
-                ok = check_flag(flag, '-', option);
-                break;
-            default:
-                break;
-            }
-            if (!ok)
-                ARGOS_THROW("Invalid flag: '" + flag + "'.");
-        }
-
-        if (!option.argument.empty() && !option.constant.empty())
-            ARGOS_THROW("Option cannot have both argument and constant.");
-
-        switch (option.operation)
-        {
-        case OptionOperation::NONE:
-            if (!option.constant.empty())
-                ARGOS_THROW("NONE-options cannot have a constant.");
-            if (!option.alias.empty())
-                ARGOS_THROW("NONE-options cannot have an alias.");
-            break;
-        case OptionOperation::ASSIGN:
-            if (option.argument.empty() && option.constant.empty())
-                option.constant = "1";
-            break;
-        case OptionOperation::APPEND:
-            if (option.argument.empty() && option.constant.empty())
-                ARGOS_THROW("Options that appends must have either constant or argument.");
-            break;
-        case OptionOperation::CLEAR:
-            if (!option.argument.empty() || !option.constant.empty())
-                option.constant = "1";
-            if (!option.optional)
-                ARGOS_THROW("CLEAR-options must be optional.");
-            break;
-        }
+        const auto* option = m_impl->stop_option();
+        if (!option)
+            ARGOS_THROW("There is no special option.");
+        return OptionView(option);
     }
-}
-
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-18.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
 
-namespace argos
-{
-    OptionIterator::OptionIterator()
-        : m_args(m_all_args)
+    const std::vector<std::string>&
+    ParsedArguments::unprocessed_arguments() const
     {
+        return m_impl->unprocessed_arguments();
     }
 
-    OptionIterator::OptionIterator(std::vector<std::string_view> args, char prefix)
-        : m_all_args(args.begin(), args.end()),
-          m_args(m_all_args),
-          m_prefix(prefix)
+    void ParsedArguments::filter_parsed_arguments(int& argc, char**& argv) const
     {
+        if (argc <= 1)
+            return;
+        const auto& unprocessed = m_impl->unprocessed_arguments();
+        auto it = unprocessed.begin();
+        int out = 1;
+        if (!unprocessed.empty())
+        {
+            for (int in = 1; in < argc; ++in)
+            {
+                if (argv[in] == *it)
+                {
+                    argv[out++] = argv[in];
+                    if (++it == unprocessed.end())
+                        break;
+                }
+            }
+        }
+        argc = out;
     }
 
-    OptionIterator::OptionIterator(const OptionIterator& rhs)
-        : m_all_args(rhs.m_all_args),
-          m_args(m_all_args.begin() + rhs.m_all_args.size() - rhs.m_args.size(), m_all_args.end()),
-          m_pos(rhs.m_pos),
-          m_prefix(rhs.m_prefix)
+    void ParsedArguments::error(const std::string& msg) const
     {
+        m_impl->error(msg);
     }
 
-    std::optional<std::string> OptionIterator::next()
+    namespace
     {
-        if (m_pos != 0)
+        std::string get_name(const IArgumentView& arg)
         {
-            m_pos = 0;
-            pop_front(m_args);
-        }
+            if (const auto* a = dynamic_cast<const ArgumentView*>(&arg))
+                return a->name();
 
-        if (m_args.empty())
+            if (const auto* o = dynamic_cast<const OptionView*>(&arg))
+            {
+                std::string s;
+                for (const auto& f : o->flags())
+                {
+                    if (!s.empty())
+                        s += ", ";
+                    s += f;
+                }
+                return s;
+            }
             return {};
-
-        if (m_args[0].size() <= 2 || m_args[0][0] != m_prefix)
-        {
-            m_pos = std::string_view::npos;
-            return std::string(m_args[0]);
         }
 
-        const auto eq = m_args[0].find('=');
-        if (eq == std::string_view::npos)
+        void print_argument(std::ostream& stream,
+                            const std::string& label,
+                            const ArgumentValues& values)
         {
-            m_pos = std::string_view::npos;
-            return std::string(m_args[0]);
+            stream << label << ":";
+            for (const auto value : values)
+                stream << " \"" << value.as_string() << "\"";
+            stream << "\n";
         }
+    }
 
-        m_pos = eq + 1;
-        return std::string(m_args[0].substr(0, m_pos));
+    void print(const ParsedArguments& args)
+    {
+        print(args, std::cout);
     }
 
-    std::optional<std::string> OptionIterator::next_value()
+    void print(const ParsedArguments& parsed_args, std::ostream& stream)
     {
-        if (m_args.empty())
-            return {};
+        std::vector<const IArgumentView*> argViews;
+        auto args = parsed_args.all_arguments();
+        std::transform(args.begin(), args.end(), back_inserter(argViews),
+                       [](auto& av) {return av.get();});
+        auto opts = parsed_args.all_options();
+        std::transform(opts.begin(), opts.end(), back_inserter(argViews),
+                       [](auto& ov) {return ov.get();});
 
-        if (m_pos != std::string_view::npos)
-        {
-            const auto result = m_args[0].substr(m_pos);
-            m_pos = std::string_view::npos;
-            return std::string(result);
-        }
+        stable_sort(argViews.begin(), argViews.end(),
+                    [](auto& a, auto& b) {return a->value_id() < b->value_id();});
 
-        pop_front(m_args);
-        if (m_args.empty())
+        std::vector<std::pair<const IArgumentView*, std::string>> labels;
+        for (const auto* arg : argViews)
         {
-            m_pos = 0;
-            return {};
+            if (!labels.empty() && labels.back().first->value_id() == arg->value_id())
+                labels.back().second += ", " + get_name(*arg);
+            else
+                labels.emplace_back(arg, get_name(*arg));
         }
 
-        m_pos = m_args[0].size();
-        return std::string(m_args[0]);
-    }
-
-    std::string_view OptionIterator::current() const
-    {
-        if (m_args.empty())
-            ARGOS_THROW("There is no current argument.");
-        return m_args[0];
-    }
+        for (const auto&[arg, label] : labels)
+            print_argument(stream, label, parsed_args.values(*arg));
 
-    std::span<std::string> OptionIterator::remaining_arguments() const
-    {
-        return m_pos == 0 ? m_args : m_args.subspan(1);
-    }
+        if (!parsed_args.unprocessed_arguments().empty())
+        {
+            stream << "Unprocessed arguments:";
+            for (auto& arg : parsed_args.unprocessed_arguments())
+                stream << " \"" << arg << "\"";
+        }
 
-    void OptionIterator::insert(const std::vector<std::string>& args)
-    {
-        auto args_index = m_all_args.size() - m_args.size();
-        auto insert_index = args_index;
-        if (m_pos != 0)
-            insert_index++;
-        m_all_args.insert(m_all_args.begin() + insert_index,
-                          args.begin(), args.end());
-        m_args = std::span(m_all_args.begin() + args_index, m_all_args.end());
+        for (const auto& subcommand : parsed_args.subcommands())
+        {
+            stream << "\nSubcommand: " << subcommand.name() << "\n";
+            print(subcommand, stream);
+        }
     }
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-28.
+// Created by Jan Erik Breimo on 2020-01-29.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -4560,246 +10409,174 @@ namespace argos
 
 namespace argos
 {
-    OptionView::OptionView(const OptionData* data)
-        : m_option(data)
-    {
-        if (!data)
-            ARGOS_THROW("data can not be null");
-    }
-
-    std::string OptionView::help() const
-    {
-        return get_text(m_option->help);
-    }
-
-    const std::string& OptionView::section() const
-    {
-        return m_option->section;
-    }
+    ParsedArgumentsBuilder::ParsedArgumentsBuilder(
+            std::shared_ptr<ParsedArgumentsImpl> impl)
+        : m_impl(std::move(impl))
+    {}
 
-    const std::string& OptionView::alias() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::append(const std::string& name,
+                                   const std::string& value)
     {
-        return m_option->alias;
+        if (!m_impl->append_value(m_impl->get_value_id(name), value, {}))
+            m_impl->error("Invalid value: " + value + ".");
+        return *this;
     }
 
-    OptionOperation OptionView::operation() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::append(const IArgumentView& arg,
+                                   const std::string& value)
     {
-        return m_option->operation;
+        if (!m_impl->append_value(arg.value_id(), value, arg.argument_id()))
+            m_impl->error("Invalid value: " + value + ".", arg.argument_id());
+        return *this;
     }
 
-    Visibility OptionView::visibility() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::append(ValueHandle handle,
+                                   const std::string& value)
     {
-        return m_option->visibility;
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        if (!m_impl->append_value(value_id, value, argument_id))
+            m_impl->error("Invalid value: " + value + ".", argument_id);
+        return *this;
     }
 
-    int OptionView::id() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::assign(const std::string& name,
+                                   const std::string& value)
     {
-        return m_option->id;
+        if (!m_impl->assign_value(m_impl->get_value_id(name), value, {}))
+            m_impl->error("Invalid value: " + value + ".");
+        return *this;
     }
 
-    ValueId OptionView::value_id() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::assign(const IArgumentView& arg,
+                                   const std::string& value)
     {
-        return m_option->value_id;
+        if (!m_impl->assign_value(arg.value_id(), value, arg.argument_id()))
+            m_impl->error("Invalid value: " + value + ".", arg.argument_id());
+        return *this;
     }
 
-    const std::vector<std::string>& OptionView::flags() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::assign(ValueHandle handle,
+                                   const std::string& value)
     {
-        return m_option->flags;
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        if (!m_impl->assign_value(value_id, value, argument_id))
+            m_impl->error("Invalid value: " + value + ".", argument_id);
+        return *this;
     }
 
-    const std::string& OptionView::argument() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::clear(const std::string& name)
     {
-        return m_option->argument;
+        m_impl->clear_value(m_impl->get_value_id(name));
+        return *this;
     }
 
-    const std::string& OptionView::initial_value() const
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::clear(const IArgumentView& arg)
     {
-        return m_option->initial_value;
+        m_impl->clear_value(arg.value_id());
+        return *this;
     }
 
-    const std::string& OptionView::constant() const
+    ParsedArgumentsBuilder& ParsedArgumentsBuilder::clear(ValueHandle handle)
     {
-        return m_option->constant;
+        m_impl->clear_value(m_impl->get_ids(handle).first);
+        return *this;
     }
 
-    OptionType OptionView::type() const
+    ArgumentValue ParsedArgumentsBuilder::value(const std::string& name) const
     {
-        return m_option->type;
+        return ParsedArgumentsImpl::make_value(m_impl,
+                                               m_impl->get_value_id(name));
     }
 
-    bool OptionView::optional() const
+    ArgumentValue
+    ParsedArgumentsBuilder::value(const IArgumentView& arg) const
     {
-        return m_option->optional;
+        return ParsedArgumentsImpl::make_value(m_impl, arg.value_id(),
+                                               arg.argument_id());
     }
 
-    ArgumentId OptionView::argument_id() const
+    ArgumentValue ParsedArgumentsBuilder::value(ValueHandle handle) const
     {
-        return m_option->argument_id;
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        return ParsedArgumentsImpl::make_value(m_impl, value_id, argument_id);
     }
-}
 
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-02-13.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
-
-#include <cstdlib>
-
-namespace argos
-{
-    namespace
+    ArgumentValues
+    ParsedArgumentsBuilder::values(const std::string& name) const
     {
-        template <typename T>
-        T str_to_int(const char* str, char** endp, int base);
-
-        template <>
-        long str_to_int<long>(const char* str, char** endp, int base)
-        {
-            return strtol(str, endp, base);
-        }
-
-        template <>
-        long long str_to_int<long long>(const char* str, char** endp, int base)
-        {
-            return strtoll(str, endp, base);
-        }
-
-        template <>
-        unsigned long
-        str_to_int<unsigned long>(const char* str, char** endp, int base)
-        {
-            return strtoul(str, endp, base);
-        }
-
-        template <>
-        unsigned long long
-        str_to_int<unsigned long long>(const char* str, char** endp, int base)
-        {
-            return strtoull(str, endp, base);
-        }
-
-        template <typename T>
-        std::optional<T> parse_integer_impl(const std::string& str, int base)
-        {
-            if (str.empty())
-                return {};
-            char* endp = nullptr;
-            errno = 0;
-            auto value = str_to_int<T>(str.c_str(), &endp, base);
-            if (endp == str.c_str() + str.size() && errno == 0)
-                return value;
-            return {};
-        }
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_value_id(name));
     }
 
-    template <>
-    std::optional<int> parse_integer<int>(const std::string& str, int base)
+    ArgumentValues
+    ParsedArgumentsBuilder::values(const IArgumentView& arg) const
     {
-        const auto n = parse_integer_impl<long>(str, base);
-        if (!n)
-            return {};
-
-        if constexpr (sizeof(int) != sizeof(long))
-        {
-            if (*n < INT_MIN || INT_MAX < *n)
-                return {};
-        }
-        return static_cast<int>(*n);
+        return ParsedArgumentsImpl::make_values(m_impl, arg.value_id());
     }
 
-    template <>
-    std::optional<unsigned>
-    parse_integer<unsigned>(const std::string& str, int base)
+    ArgumentValues ParsedArgumentsBuilder::values(ValueHandle handle) const
     {
-        auto n = parse_integer_impl<unsigned long>(str, base);
-        if (!n)
-            return {};
-
-        if constexpr (sizeof(unsigned) != sizeof(unsigned long))
-        {
-            if (UINT_MAX < *n)
-                return {};
-        }
-        return static_cast<unsigned>(*n);
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_ids(handle).first);
     }
 
-    template <>
-    std::optional<long> parse_integer<long>(const std::string& str, int base)
+    bool ParsedArgumentsBuilder::has(const std::string& name) const
     {
-        return parse_integer_impl<long>(str, base);
+        return m_impl->has(m_impl->get_value_id(name));
     }
 
-    template <>
-    std::optional<long long>
-    parse_integer<long long>(const std::string& str, int base)
+    bool ParsedArgumentsBuilder::has(const IArgumentView& arg) const
     {
-        return parse_integer_impl<long long>(str, base);
+        return m_impl->has(arg.value_id());
     }
 
-    template <>
-    std::optional<unsigned long>
-    parse_integer<unsigned long>(const std::string& str, int base)
+    bool ParsedArgumentsBuilder::has(ValueHandle handle) const
     {
-        return parse_integer_impl<unsigned long>(str, base);
+        return m_impl->has(m_impl->get_ids(handle).first);
     }
 
-    template <>
-    std::optional<unsigned long long>
-    parse_integer<unsigned long long>(const std::string& str, int base)
+    void ParsedArgumentsBuilder::error(const std::string& msg) const
     {
-        return parse_integer_impl<unsigned long long>(str, base);
+         m_impl->error(msg);
     }
 
-    namespace
-    {
-        template <typename T>
-        T str_to_float(const char* str, char** endp);
-
-        template <>
-        float str_to_float<float>(const char* str, char** endp)
-        {
-            return strtof(str, endp);
-        }
-
-        template <>
-        double str_to_float<double>(const char* str, char** endp)
-        {
-            return strtod(str, endp);
-        }
-
-        template <typename T>
-        std::optional<T> parse_floating_point_impl(const std::string& str)
-        {
-            if (str.empty())
-                return {};
-            char* endp = nullptr;
-            errno = 0;
-            auto value = str_to_float<T>(str.c_str(), &endp);
-            if (endp == str.c_str() + str.size() && errno == 0)
-                return value;
-            return {};
-        }
+    void ParsedArgumentsBuilder::error(const std::string& msg,
+                                       const IArgumentView& arg) const
+    {
+        m_impl->error(msg, arg.argument_id());
     }
 
-    template <>
-    std::optional<float> parse_floating_point<float>(const std::string& str)
+    std::ostream& ParsedArgumentsBuilder::stream() const
     {
-        return parse_floating_point_impl<float>(str);
+        if (m_impl->silent())
+        {
+            // Each thread has its own instance as writing to a stream
+            // without a buffer changes its state.
+            thread_local std::ostream null_stream(nullptr);
+            null_stream.clear();
+            return null_stream;
+        }
+        const auto custom_stream = m_impl->parser_data()->help_settings.output_stream;
+        return custom_stream ? *custom_stream : std::cout;
     }
 
-    template <>
-    std::optional<double> parse_floating_point<double>(const std::string& str)
+    const std::string& ParsedArgumentsBuilder::program_name() const
     {
-        return parse_floating_point_impl<double>(str);
+      return m_impl->parser_data()->command.name;
     }
 }
 
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-26.
+// Created by Jan Erik Breimo on 2020-01-07.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -4807,604 +10584,833 @@ namespace argos
 
 namespace argos
 {
-    ParsedArguments::ParsedArguments() = default;
-
-    ParsedArguments::ParsedArguments(std::shared_ptr<ParsedArgumentsImpl> impl)
-        : m_impl(std::move(impl))
-    {}
-
-    ParsedArguments::ParsedArguments(const ParsedArguments& rhs) = default;
-
-    ParsedArguments::ParsedArguments(ParsedArguments&& rhs) noexcept = default;
-
-    ParsedArguments::~ParsedArguments() = default;
-
-    ParsedArguments& ParsedArguments::operator=(const ParsedArguments&) = default;
+    ParsedArgumentsImpl::ParsedArgumentsImpl(const CommandData* command,
+                                             std::shared_ptr<const ParserData> data,
+                                             std::shared_ptr<StringArena> arena)
+        : m_arena(arena ? std::move(arena) : std::make_shared<StringArena>()),
+          m_command(command),
+          m_data(std::move(data))
+    {
+        assert(m_data);
+        const auto& index = m_command->value_index();
+        m_first_value_id = index.first_value_id();
+        m_first_argument_id = index.first_argument_id();
+        const auto values = index.values();
+        m_slots.resize(values.size());
+        m_nonempty_values.assign(0, values.size());
+        m_given_arguments.assign(0, index.argument_count());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            m_slots[i].type = values[i].type;
+            m_slots[i].binding = values[i].binding;
+            m_slots[i].choices = values[i].choices;
+            m_slots[i].dictionary_separator = values[i].dictionary_separator;
+        }
+    }
 
-    ParsedArguments& ParsedArguments::operator=(ParsedArguments&& rhs) noexcept = default;
+    ParsedArgumentsImpl::~ParsedArgumentsImpl() = default;
 
-    CommandView ParsedArguments::command() const
+    bool ParsedArgumentsImpl::has_shared_subcommands() const
     {
-        return CommandView(m_impl->command());
+        return std::any_of(m_commands.begin(), m_commands.end(),
+                           [](auto& c)
+                           {
+                               return c.use_count() != 1
+                                      || c->has_shared_subcommands();
+                           });
     }
 
-    std::string_view ParsedArguments::name() const
+    void ParsedArgumentsImpl::clear()
     {
-        return m_impl->command()->name;
+        m_entries.clear();
+        for (auto& slot : m_slots)
+        {
+            slot.first = slot.count = 0;
+            slot.is_initial = false;
+        }
+        m_nonempty_values.reset();
+        m_given_arguments.reset();
+        m_values.clear();
+        m_typed_values.clear();
+        m_offsets.clear();
+        m_is_compact = true;
+        // All the sub-commands share the arena, clearing it more than
+        // once is harmless.
+        m_arena->clear();
+        m_unprocessed_arguments.clear();
+        for (auto& command : m_commands)
+        {
+            command->clear();
+            m_spare_commands.push_back(std::move(command));
+        }
+        m_commands.clear();
+        m_result_code = ParserResultCode::NONE;
+        m_stop_option = nullptr;
+        m_silent_error = {};
     }
 
-    bool ParsedArguments::has(const std::string& name) const
+    void ParsedArgumentsImpl::reserve(size_t value_count, size_t text_size)
     {
-        return m_impl->has(m_impl->get_value_id(name));
+        m_entries.reserve(value_count);
+        m_arena->reserve(text_size);
     }
 
-    bool ParsedArguments::has(const IArgumentView& arg) const
+    void ParsedArgumentsImpl::add_initial_values()
     {
-        return m_impl->has(arg.value_id());
+        const auto& index = m_command->value_index();
+        for (const auto value_id : index.initialized_values())
+        {
+            auto& slot = get_slot(value_id);
+            const auto values = index.initial_values(value_id);
+            m_nonempty_values.set(size_t(value_id - m_first_value_id));
+            if (!slot.binding)
+            {
+                slot.count = values.size();
+                slot.is_initial = true;
+                continue;
+            }
+
+            const auto typed_values = index.typed_initial_values(value_id);
+            for (size_t i = 0; i < values.size(); ++i)
+                slot.binding->append(values[i].first, typed_values[i]);
+            slot.count += values.size();
+        }
     }
 
-    std::vector<ParsedArguments> ParsedArguments::subcommands() const
+    bool ParsedArgumentsImpl::has(ValueId value_id) const
     {
-        std::vector<ParsedArguments> result;
-        for (const auto& subcommand : m_impl->subcommands())
-            result.emplace_back(subcommand);
-        return result;
+        const auto* slot = find_slot(value_id);
+        return slot && slot->count != 0;
     }
 
-    ArgumentValue ParsedArguments::value(const std::string& name) const
+    const BitSet& ParsedArgumentsImpl::nonempty_values() const
     {
-        auto id = m_impl->get_value_id(name);
-        if (auto value = m_impl->get_value(id))
-            return {value->first, m_impl, id, value->second};
-        else
-            return {{}, m_impl, id, {}};
+        return m_nonempty_values;
     }
 
-    ArgumentValue ParsedArguments::value(const IArgumentView& arg) const
+    void ParsedArgumentsImpl::set_given(ArgumentId argument_id)
     {
-        if (auto value = m_impl->get_value(arg.value_id()))
-            return {value->first, m_impl, arg.value_id(), arg.argument_id()};
-        else
-            return {{}, m_impl, arg.value_id(), arg.argument_id()};
+        m_given_arguments.set(size_t(argument_id - m_first_argument_id));
     }
 
-    ArgumentValues ParsedArguments::values(const std::string& name) const
+    const BitSet& ParsedArgumentsImpl::given_arguments() const
     {
-        auto id = m_impl->get_value_id(name);
-        auto values = m_impl->get_values(id);
-        return {values, m_impl, id};
+        return m_given_arguments;
     }
 
-    ArgumentValues ParsedArguments::values(const IArgumentView& arg) const
+    const std::vector<std::string>&
+    ParsedArgumentsImpl::unprocessed_arguments() const
     {
-        auto values = m_impl->get_values(arg.value_id());
-        return {values, m_impl, arg.value_id()};
+        return m_unprocessed_arguments;
     }
 
-    std::vector<std::unique_ptr<ArgumentView>>
-    ParsedArguments::all_arguments() const
+    void ParsedArgumentsImpl::add_unprocessed_argument(std::string_view arg)
     {
-        std::vector<std::unique_ptr<ArgumentView>> result;
-        for (auto& a : m_impl->command()->arguments)
-            result.emplace_back(std::make_unique<ArgumentView>(a.get()));
-        return result;
+        m_unprocessed_arguments.emplace_back(arg);
     }
 
-    std::vector<std::unique_ptr<OptionView>>
-    ParsedArguments::all_options() const
+    std::optional<std::string_view>
+    ParsedArgumentsImpl::assign_value(ValueId value_id,
+                                      std::string_view value,
+                                      ArgumentId argument_id)
     {
-        std::vector<std::unique_ptr<OptionView>> result;
-        for (auto& o : m_impl->command()->options)
-            result.emplace_back(std::make_unique<OptionView>(o.get()));
-        return result;
+        auto& slot = get_slot(value_id);
+        TypedValue typed_value;
+        if (!is_valid_value(slot, value, typed_value))
+            return {};
+        m_nonempty_values.set(size_t(value_id - m_first_value_id));
+        if (slot.binding)
+        {
+            slot.binding->assign(value, typed_value);
+            slot.count = 1;
+            return value;
+        }
+        slot.count = 0;
+        slot.is_initial = false;
+        return add_entry(slot, value_id, value, argument_id, typed_value);
     }
 
-    std::vector<std::unique_ptr<CommandView>>
-    ParsedArguments::all_subcommands() const
+    std::optional<std::string_view>
+    ParsedArgumentsImpl::append_value(ValueId value_id,
+                                      std::string_view value,
+                                      ArgumentId argument_id)
     {
-        std::vector<std::unique_ptr<CommandView>> result;
-        for (auto& c : m_impl->command()->commands)
-            result.emplace_back(std::make_unique<CommandView>(c.get()));
-        return result;
+        auto& slot = get_slot(value_id);
+        TypedValue typed_value;
+        if (!is_valid_value(slot, value, typed_value))
+            return {};
+        m_nonempty_values.set(size_t(value_id - m_first_value_id));
+        if (slot.binding)
+        {
+            slot.binding->append(value, typed_value);
+            ++slot.count;
+            return value;
+        }
+        if (slot.is_initial)
+            copy_initial_values(slot, value_id);
+        return add_entry(slot, value_id, value, argument_id, typed_value);
     }
 
-    ParserResultCode ParsedArguments::result_code() const
+    void ParsedArgumentsImpl::clear_value(ValueId value_id)
     {
-        return m_impl->result_code();
+        auto* slot = find_slot(value_id);
+        if (slot)
+            m_nonempty_values.reset(size_t(value_id - m_first_value_id));
+        if (slot && slot->binding)
+        {
+            slot->binding->clear();
+            slot->count = 0;
+        }
+        else if (slot && slot->count != 0)
+        {
+            slot->count = 0;
+            slot->is_initial = false;
+            m_is_compact = false;
+        }
     }
 
-    OptionView ParsedArguments::stop_option() const
+    ValueId
+    ParsedArgumentsImpl::get_value_id(std::string_view value_name) const
     {
-        const auto* option = m_impl->stop_option();
-        if (!option)
-            ARGOS_THROW("There is no special option.");
-        return OptionView(option);
+        const auto ids = m_command->value_index().find(value_name);
+        if (!ids)
+            ARGOS_THROW("Unknown value: " + std::string(value_name));
+        return ids->first;
     }
 
-    const std::vector<std::string>&
-    ParsedArguments::unprocessed_arguments() const
+    const ChoiceSet* ParsedArgumentsImpl::get_choices(ValueId value_id) const
     {
-        return m_impl->unprocessed_arguments();
+        const auto* slot = find_slot(value_id);
+        return slot ? slot->choices : nullptr;
     }
 
-    void ParsedArguments::filter_parsed_arguments(int& argc, char**& argv) const
+    std::pair<ValueId, ArgumentId>
+    ParsedArgumentsImpl::get_ids(ValueHandle handle) const
     {
-        if (argc <= 1)
-            return;
-        const auto& unprocessed = m_impl->unprocessed_arguments();
-        auto it = unprocessed.begin();
-        int out = 1;
-        if (!unprocessed.empty())
+        if (!handle)
+            ARGOS_THROW("ValueHandle has not been set.");
+        const auto index = handle.index();
+        if (handle.command() != m_command->handle_id)
         {
-            for (int in = 1; in < argc; ++in)
-            {
-                if (argv[in] == *it)
-                {
-                    argv[out++] = argv[in];
-                    if (++it == unprocessed.end())
-                        break;
-                }
-            }
+            ARGOS_THROW("ValueHandle doesn't belong to command "
+                        + m_command->full_name + ".");
         }
-        argc = out;
+        if (handle.is_option() && index < m_command->options.size())
+        {
+            const auto& o = *m_command->options[index];
+            return {o.value_id, o.argument_id};
+        }
+        if (!handle.is_option() && index < m_command->arguments.size())
+        {
+            const auto& a = *m_command->arguments[index];
+            return {a.value_id, a.argument_id};
+        }
+        ARGOS_THROW("ValueHandle doesn't belong to command "
+                    + m_command->full_name + ".");
     }
 
-    void ParsedArguments::error(const std::string& msg) const
+    std::optional<std::pair<std::string_view, ArgumentId>>
+    ParsedArgumentsImpl::get_value(ValueId value_id) const
     {
-        m_impl->error(msg);
+        const auto* slot = find_slot(value_id);
+        if (!slot || slot->count == 0 || slot->binding)
+            return {};
+        if (slot->count != 1)
+            ARGOS_THROW("Attempt to read multiple values as a single value.");
+        if (slot->is_initial)
+            return m_command->value_index().initial_values(value_id).front();
+        const auto& entry = m_entries[slot->first];
+        return std::pair(entry.value, entry.argument_id);
     }
 
-    namespace
+    std::span<const std::pair<std::string_view, ArgumentId>>
+    ParsedArgumentsImpl::get_values(ValueId value_id) const
     {
-        std::string get_name(const IArgumentView& arg)
-        {
-            if (const auto* a = dynamic_cast<const ArgumentView*>(&arg))
-                return a->name();
-
-            if (const auto* o = dynamic_cast<const OptionView*>(&arg))
-            {
-                std::string s;
-                for (const auto& f : o->flags())
-                {
-                    if (!s.empty())
-                        s += ", ";
-                    s += f;
-                }
-                return s;
-            }
+        const auto* slot = find_slot(value_id);
+        if (!slot || slot->count == 0 || slot->binding)
             return {};
-        }
+        if (slot->is_initial)
+            return m_command->value_index().initial_values(value_id);
+        if (!m_is_compact)
+            do_compact();
+        const auto index = size_t(slot - m_slots.data());
+        return std::span(m_values).subspan(m_offsets[index], slot->count);
+    }
 
-        void print_argument(std::ostream& stream,
-                            const std::string& label,
-                            const ArgumentValues& values)
+    ArgumentValue
+    ParsedArgumentsImpl::make_value(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                                    ValueId value_id,
+                                    std::optional<ArgumentId> argument_id)
+    {
+        const auto* slot = args->find_slot(value_id);
+        if (!slot || slot->count == 0 || slot->binding)
+            return {{}, args, value_id, argument_id.value_or(ArgumentId())};
+        if (slot->count != 1)
+            ARGOS_THROW("Attempt to read multiple values as a single value.");
+        if (slot->is_initial)
         {
-            stream << label << ":";
-            for (const auto value : values)
-                stream << " \"" << value.as_string() << "\"";
-            stream << "\n";
+            const auto& index = args->m_command->value_index();
+            const auto [value, id] = index.initial_values(value_id).front();
+            return {value, args, value_id, argument_id.value_or(id),
+                    slot->type, index.typed_initial_values(value_id).front()};
         }
+        const auto& entry = args->m_entries[slot->first];
+        return {entry.value, args, value_id,
+                argument_id.value_or(entry.argument_id),
+                slot->type, entry.typed_value};
     }
 
-    void print(const ParsedArguments& args)
+    ArgumentValues
+    ParsedArgumentsImpl::make_values(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                                     ValueId value_id)
     {
-        print(args, std::cout);
+        const auto values = args->get_values(value_id);
+        const auto* slot = args->find_slot(value_id);
+        if (values.empty() || slot->type == ValueType::STRING)
+            return {{values.begin(), values.end()}, args, value_id};
+
+        if (slot->is_initial)
+        {
+            const auto typed_values = args->m_command->value_index()
+                .typed_initial_values(value_id);
+            return {{values.begin(), values.end()}, args, value_id,
+                    slot->type, {typed_values.begin(), typed_values.end()}};
+        }
+
+        const auto index = size_t(slot - args->m_slots.data());
+        const auto typed_values = std::span(args->m_typed_values)
+            .subspan(args->m_offsets[index], slot->count);
+        return {{values.begin(), values.end()}, args, value_id,
+                slot->type, {typed_values.begin(), typed_values.end()}};
     }
 
-    void print(const ParsedArguments& parsed_args, std::ostream& stream)
+    ValuesViewData ParsedArgumentsImpl::make_view(ValueId value_id) const
     {
-        std::vector<const IArgumentView*> argViews;
-        auto args = parsed_args.all_arguments();
-        std::transform(args.begin(), args.end(), back_inserter(argViews),
-                       [](auto& av) {return av.get();});
-        auto opts = parsed_args.all_options();
-        std::transform(opts.begin(), opts.end(), back_inserter(argViews),
-                       [](auto& ov) {return ov.get();});
+        const auto values = get_values(value_id);
+        if (values.empty())
+            return {{}, {}, ValueType::STRING, this};
 
-        stable_sort(argViews.begin(), argViews.end(),
-                    [](auto& a, auto& b) {return a->value_id() < b->value_id();});
+        const auto* slot = find_slot(value_id);
+        if (slot->type == ValueType::STRING)
+            return {values, {}, ValueType::STRING, this};
 
-        std::vector<std::pair<const IArgumentView*, std::string>> labels;
-        for (const auto* arg : argViews)
+        if (slot->is_initial)
         {
-            if (!labels.empty() && labels.back().first->value_id() == arg->value_id())
-                labels.back().second += ", " + get_name(*arg);
-            else
-                labels.emplace_back(arg, get_name(*arg));
+            return {values,
+                    m_command->value_index().typed_initial_values(value_id),
+                    slot->type, this};
         }
 
-        for (const auto&[arg, label] : labels)
-            print_argument(stream, label, parsed_args.values(*arg));
+        const auto index = size_t(slot - m_slots.data());
+        return {values,
+                std::span(m_typed_values).subspan(m_offsets[index], slot->count),
+                slot->type, this};
+    }
 
-        if (!parsed_args.unprocessed_arguments().empty())
+    ArgumentDictionary
+    ParsedArgumentsImpl::make_dictionary(ValueId value_id) const
+    {
+        const auto* slot = find_slot(value_id);
+        const auto separator = slot && slot->dictionary_separator != '\0'
+                                   ? slot->dictionary_separator
+                                   : '=';
+        return {get_values(value_id), separator};
+    }
+
+    void ParsedArgumentsImpl::compact()
+    {
+        if (!m_is_compact)
+            do_compact();
+        for (const auto& command : m_commands)
+            command->compact();
+    }
+
+    const std::shared_ptr<ParsedArgumentsImpl>&
+    ParsedArgumentsImpl::add_subcommand(const CommandData* command)
+    {
+        const auto spare = std::find_if(
+            m_spare_commands.begin(), m_spare_commands.end(),
+            [&](auto& c) { return c->command() == command; });
+        if (spare != m_spare_commands.end())
         {
-            stream << "Unprocessed arguments:";
-            for (auto& arg : parsed_args.unprocessed_arguments())
-                stream << " \"" << arg << "\"";
+            m_commands.push_back(std::move(*spare));
+            m_spare_commands.erase(spare);
         }
-
-        for (const auto& subcommand : parsed_args.subcommands())
+        else
         {
-            stream << "\nSubcommand: " << subcommand.name() << "\n";
-            print(subcommand, stream);
+            m_commands.push_back(std::make_shared<ParsedArgumentsImpl>(
+                command, m_data, m_arena));
         }
+        m_commands.back()->set_silent(m_silent);
+        return m_commands.back();
     }
-}
 
-//****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-29.
-//
-// This file is distributed under the Zero-Clause BSD License.
-// License text is included with the source distribution.
-//****************************************************************************
+    const std::vector<std::shared_ptr<ParsedArgumentsImpl>>&
+    ParsedArgumentsImpl::subcommands() const
+    {
+        return m_commands;
+    }
+
+    std::vector<std::unique_ptr<IArgumentView>>
+    ParsedArgumentsImpl::get_argument_views(ValueId value_id) const
+    {
+        std::vector<std::unique_ptr<IArgumentView>> result;
+        for (const auto argument_id : m_command->value_index().argument_ids(value_id))
+            result.push_back(get_argument_view(argument_id));
+        return result;
+    }
+
+    std::unique_ptr<IArgumentView>
+    ParsedArgumentsImpl::get_argument_view(ArgumentId argument_id) const
+    {
+        const auto& index = m_command->value_index();
+        if (const auto* a = index.find_argument(argument_id))
+            return std::make_unique<ArgumentView>(a);
+        if (const auto* o = index.find_option(argument_id))
+            return std::make_unique<OptionView>(o);
+        return {};
+    }
+
+    const std::shared_ptr<const ParserData>& ParsedArgumentsImpl::parser_data() const
+    {
+        return m_data;
+    }
+
+    const CommandData* ParsedArgumentsImpl::command() const
+    {
+        return m_command;
+    }
+
+    ParserResultCode ParsedArgumentsImpl::result_code() const
+    {
+        return m_result_code;
+    }
 
-namespace argos
-{
-    ParsedArgumentsBuilder::ParsedArgumentsBuilder(
-            std::shared_ptr<ParsedArgumentsImpl> impl)
-        : m_impl(std::move(impl))
-    {}
+    void ParsedArgumentsImpl::set_result_code(ParserResultCode result_code)
+    {
+        m_result_code = result_code;
+    }
 
-    ParsedArgumentsBuilder&
-    ParsedArgumentsBuilder::append(const std::string& name,
-                                   const std::string& value)
+    const OptionData* ParsedArgumentsImpl::stop_option() const
     {
-        m_impl->append_value(m_impl->get_value_id(name), value, {});
-        return *this;
+        return m_stop_option;
     }
 
-    ParsedArgumentsBuilder&
-    ParsedArgumentsBuilder::append(const IArgumentView& arg,
-                                   const std::string& value)
+    void ParsedArgumentsImpl::set_breaking_option(const OptionData* option)
     {
-        m_impl->append_value(arg.value_id(), value, arg.argument_id());
-        return *this;
+        m_result_code = ParserResultCode::STOP;
+        m_stop_option = option;
     }
 
-    ParsedArgumentsBuilder&
-    ParsedArgumentsBuilder::assign(const std::string& name,
-                                   const std::string& value)
+    bool ParsedArgumentsImpl::silent() const
     {
-        m_impl->assign_value(m_impl->get_value_id(name), value, {});
-        return *this;
+        return m_silent;
     }
 
-    ParsedArgumentsBuilder&
-    ParsedArgumentsBuilder::assign(const IArgumentView& arg,
-                                   const std::string& value)
+    void ParsedArgumentsImpl::set_silent(bool silent)
     {
-        m_impl->assign_value(arg.value_id(), value, arg.argument_id());
-        return *this;
+        m_silent = silent;
+        for (const auto& command : m_commands)
+            command->set_silent(silent);
     }
 
-    ParsedArgumentsBuilder&
-    ParsedArgumentsBuilder::clear(const std::string& name)
+    const std::optional<std::pair<std::string, ArgumentId>>&
+    ParsedArgumentsImpl::silent_error() const
     {
-        m_impl->clear_value(m_impl->get_value_id(name));
-        return *this;
+        return m_silent_error;
     }
 
-    ParsedArgumentsBuilder&
-    ParsedArgumentsBuilder::clear(const IArgumentView& arg)
+    IteratorBuffers& ParsedArgumentsImpl::iterator_buffers()
     {
-        m_impl->clear_value(arg.value_id());
-        return *this;
+        if (!m_iterator_buffers)
+            m_iterator_buffers = std::make_unique<IteratorBuffers>();
+        return *m_iterator_buffers;
     }
 
-    ArgumentValue ParsedArgumentsBuilder::value(const std::string& name) const
+    void ParsedArgumentsImpl::error(const std::string& message) const
     {
-        auto id = m_impl->get_value_id(name);
-        if (auto value = m_impl->get_value(id))
-            return {value->first, m_impl, id, value->second};
+        if (m_silent)
+            throw_silent_error(message, {});
+        write_error_message(*m_data, *m_command, message);
+        if (m_data->parser_settings.auto_exit)
+            exit(m_data->parser_settings.error_exit_code);
         else
-            return {{}, m_impl, id, {}};
+            ARGOS_THROW("Error while parsing arguments.");
     }
 
-    ArgumentValue
-    ParsedArgumentsBuilder::value(const IArgumentView& arg) const
+    void ParsedArgumentsImpl::error(const std::string& message,
+                                    ArgumentId argument_id) const
     {
-        if (auto value = m_impl->get_value(arg.value_id()))
-            return {value->first, m_impl, arg.value_id(), arg.argument_id()};
+        if (m_silent)
+            throw_silent_error(message, argument_id);
+        write_error_message(*m_data, *m_command, message, argument_id);
+        if (m_data->parser_settings.auto_exit)
+            exit(m_data->parser_settings.error_exit_code);
         else
-            return {{}, m_impl, arg.value_id(), arg.argument_id()};
+            ARGOS_THROW("Error while parsing arguments.");
     }
 
-    ArgumentValues
-    ParsedArgumentsBuilder::values(const std::string& name) const
+    void ParsedArgumentsImpl::throw_silent_error(const std::string& message,
+                                                 ArgumentId argument_id) const
     {
-        auto id = m_impl->get_value_id(name);
-        auto values = m_impl->get_values(id);
-        return {std::move(values), m_impl, id};
+        // ArgumentIteratorImpl turns the stored message into a ParseError,
+        // which only formats it on demand.
+        m_silent_error.emplace(message, argument_id);
+#if ARGOS_EXCEPTIONS
+        ARGOS_THROW("Error while parsing arguments.");
+#else
+        throw_exception(ArgosException(
+            argument_id == ArgumentId{}
+                ? get_error_message(*m_command, message)
+                : get_error_message(*m_command, message, argument_id)));
+#endif
     }
 
-    ArgumentValues
-    ParsedArgumentsBuilder::values(const IArgumentView& arg) const
+    ParsedArgumentsImpl::ValueSlot*
+    ParsedArgumentsImpl::find_slot(ValueId value_id)
     {
-        auto values = m_impl->get_values(arg.value_id());
-        return {std::move(values), m_impl, arg.value_id()};
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        return index < m_slots.size() ? &m_slots[index] : nullptr;
     }
 
-    bool ParsedArgumentsBuilder::has(const std::string& name) const
+    const ParsedArgumentsImpl::ValueSlot*
+    ParsedArgumentsImpl::find_slot(ValueId value_id) const
     {
-        return m_impl->has(m_impl->get_value_id(name));
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        return index < m_slots.size() ? &m_slots[index] : nullptr;
     }
 
-    bool ParsedArgumentsBuilder::has(const IArgumentView& arg) const
+    ParsedArgumentsImpl::ValueSlot&
+    ParsedArgumentsImpl::get_slot(ValueId value_id)
     {
-        return m_impl->has(arg.value_id());
+        auto* slot = find_slot(value_id);
+        if (!slot)
+            ARGOS_THROW("Unknown value ID: " + std::to_string(value_id));
+        return *slot;
     }
 
-    void ParsedArgumentsBuilder::error(const std::string& msg) const
+    void ParsedArgumentsImpl::copy_initial_values(ValueSlot& slot,
+                                                  ValueId value_id)
     {
-         m_impl->error(msg);
+        const auto& index = m_command->value_index();
+        const auto values = index.initial_values(value_id);
+        const auto typed_values = index.typed_initial_values(value_id);
+        slot.first = m_entries.size();
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            m_entries.push_back({value_id, values[i].second,
+                                 values[i].first, typed_values[i]});
+        }
+        slot.is_initial = false;
+        m_is_compact = false;
     }
 
-    void ParsedArgumentsBuilder::error(const std::string& msg,
-                                       const IArgumentView& arg) const
+    bool ParsedArgumentsImpl::is_valid_value(const ValueSlot& slot,
+                                             std::string_view value,
+                                             TypedValue& typed_value)
     {
-        m_impl->error(msg, arg.argument_id());
+        if (slot.dictionary_separator != '\0'
+            && value.find(slot.dictionary_separator) == std::string_view::npos)
+        {
+            return false;
+        }
+        return parse_typed_value(value, slot.type, slot.choices, typed_value);
     }
 
-    std::ostream& ParsedArgumentsBuilder::stream() const
+    std::string_view ParsedArgumentsImpl::add_entry(ValueSlot& slot,
+                                                    ValueId value_id,
+                                                    std::string_view value,
+                                                    ArgumentId argument_id,
+                                                    TypedValue typed_value)
     {
-        const auto custom_stream = m_impl->parser_data()->help_settings.output_stream;
-        return custom_stream ? *custom_stream : std::cout;
+        if (slot.count++ == 0)
+            slot.first = m_entries.size();
+        const auto text = m_arena->add(value);
+        m_entries.push_back({value_id, argument_id, text, typed_value});
+        m_is_compact = false;
+        return text;
     }
 
-    const std::string& ParsedArgumentsBuilder::program_name() const
+    void ParsedArgumentsImpl::do_compact() const
     {
-      return m_impl->parser_data()->command.name;
+        // Counting sort of the live entries by ValueId. m_offsets[i + 1]
+        // is used as the insertion point for slot i while the values
+        // are copied, and ends up as the start of slot i + 1.
+        // Bound values and initial values have no entries.
+        auto entry_count = [](const ValueSlot& slot)
+        {
+            return slot.binding || slot.is_initial ? 0 : slot.count;
+        };
+        m_offsets.assign(m_slots.size() + 1, 0);
+        for (size_t i = 1; i < m_slots.size(); ++i)
+            m_offsets[i + 1] = m_offsets[i] + entry_count(m_slots[i - 1]);
+
+        m_values.resize(m_offsets.back() + (m_slots.empty() ? 0 : entry_count(m_slots.back())));
+        m_typed_values.resize(m_values.size());
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            const auto& entry = m_entries[i];
+            const auto index = size_t(entry.value_id) - size_t(m_first_value_id);
+            const auto& slot = m_slots[index];
+            if (entry_count(slot) != 0 && i >= slot.first)
+            {
+                const auto pos = m_offsets[index + 1]++;
+                m_values[pos] = {entry.value, entry.argument_id};
+                m_typed_values[pos] = entry.typed_value;
+            }
+        }
+        m_is_compact = true;
     }
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-07.
+// Copyright © 2024 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2024-09-11.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
 
-#include <cassert>
-
 namespace argos
 {
     namespace
     {
-        template <typename ItT, typename ValueT, typename IsLessT>
-        ItT lower_bound(ItT begin, ItT end, ValueT&& v, IsLessT is_less)
+        void add_version_option(ParserData& data)
         {
-            while (begin != end)
+            if (data.version.empty())
+                return;
+            auto& cmd = data.command;
+            std::string flag;
+            switch (data.parser_settings.option_style)
             {
-                auto offset = std::distance(begin, end) / 2;
-                auto mid = begin + offset;
-                if (is_less(*mid, v))
-                    begin = mid + 1;
-                else
-                    end = mid;
+            case OptionStyle::STANDARD:
+                if (!has_flag(cmd, "--version", data.parser_settings))
+                    flag = "--version";
+                break;
+            case OptionStyle::SLASH:
+                if (!has_flag(cmd, "/VERSION", data.parser_settings))
+                    flag = "/VERSION";
+                break;
+            case OptionStyle::DASH:
+                if (!has_flag(cmd, "-version", data.parser_settings))
+                    flag = "-version";
+                break;
             }
-            return begin;
-        }
-    }
 
-    ParsedArgumentsImpl::ParsedArgumentsImpl(const CommandData* command,
-                                             std::shared_ptr<ParserData> data)
-        : m_command(command),
-          m_data(std::move(data))
-    {
-        assert(m_data);
-        for (auto& a : m_command->arguments)
-        {
-            m_ids.emplace_back(a->name, a->value_id, a->argument_id);
-            if (!a->alias.empty())
-                m_ids.emplace_back(a->alias, a->value_id, a->argument_id);
-        }
-        for (auto& o : m_command->options)
-        {
-            if (o->operation == OptionOperation::NONE)
-                continue;
+            if (flag.empty())
+                return;
 
-            for (auto& f : o->flags)
-                m_ids.emplace_back(f, o->value_id, o->argument_id);
-            if (!o->alias.empty())
-                m_ids.emplace_back(o->alias, o->value_id, o->argument_id);
-        }
-        if (!m_ids.empty())
-        {
-            using std::get;
-            sort(m_ids.begin(), m_ids.end());
-            for (auto it = next(m_ids.begin()); it != m_ids.end(); ++it)
-            {
-                auto p = prev(it);
-                if (get<0>(*it) == get<0>(*p) && get<2>(*it) != get<2>(*p))
-                    get<2>(*it) = get<2>(*p) = {};
-            }
-            m_ids.erase(unique(m_ids.begin(), m_ids.end()), m_ids.end());
+            auto opt = Option().flag(flag).type(OptionType::STOP)
+                .help("Display the program version.")
+                .constant("1")
+                .callback([v = data.version](auto& a)
+                {
+                    a.builder.stream() << a.builder.program_name() << " " << v << "\n";
+                    return true;
+                })
+                .release();
+            opt->section = cmd.current_section;
+            cmd.options.push_back(std::move(opt));
         }
     }
 
-    bool ParsedArgumentsImpl::has(ValueId value_id) const
-    {
-        return m_values.find(value_id) != m_values.end();
-    }
-
-    const std::vector<std::string>&
-    ParsedArgumentsImpl::unprocessed_arguments() const
+    void BindingList::assign(std::vector<ValueBinding*> bindings)
     {
-        return m_unprocessed_arguments;
+        std::lock_guard lock(m_mutex);
+        m_bindings = std::move(bindings);
+        m_empty = m_bindings.empty();
     }
 
-    void ParsedArgumentsImpl::add_unprocessed_argument(const std::string& arg)
+    bool BindingList::add(std::span<ValueBinding* const> bindings)
     {
-        m_unprocessed_arguments.push_back(arg);
+        std::lock_guard lock(m_mutex);
+        if (m_batches != 0)
+            return false;
+        m_bindings.insert(m_bindings.end(), bindings.begin(), bindings.end());
+        m_empty = m_bindings.empty();
+        return true;
     }
 
-    std::string_view
-    ParsedArgumentsImpl::assign_value(ValueId value_id,
-                                      const std::string& value,
-                                      ArgumentId argument_id)
+    void BindingList::reset() const
     {
-        auto it = m_values.lower_bound(value_id);
-        if (it == m_values.end() || it->first != value_id)
-            return append_value(value_id, value, argument_id);
+        // Most parsers have no bindings, they don't need the lock.
+        if (m_empty)
+            return;
 
-        it->second = {value, argument_id};
-        auto nxt = next(it);
-        while (nxt != m_values.end() && nxt->first == value_id)
-            m_values.erase(nxt++);
-        return it->second.first;
+        std::lock_guard lock(m_mutex);
+        for (auto* binding : m_bindings)
+            binding->reset();
     }
 
-    std::string_view
-    ParsedArgumentsImpl::append_value(ValueId value_id,
-                                      const std::string& value,
-                                      ArgumentId argument_id)
+    bool BindingList::empty() const
     {
-        return m_values.insert({value_id, {value, argument_id}})->second.first;
+        return m_empty;
     }
 
-    void ParsedArgumentsImpl::clear_value(ValueId value_id)
+    void BindingList::begin_batch() const
     {
-        m_values.erase(value_id);
+        std::lock_guard lock(m_mutex);
+        if (!m_bindings.empty())
+            ARGOS_THROW("parse_batch() can't be used with bound variables.");
+        ++m_batches;
     }
 
-    ValueId
-    ParsedArgumentsImpl::get_value_id(std::string_view value_name) const
+    void BindingList::end_batch() const
     {
-        using std::get;
-        auto it = lower_bound(m_ids.begin(), m_ids.end(), value_name,
-                              [](auto& p, auto& s) { return get<0>(p) < s; });
-        if (it == m_ids.end() || get<0>(*it) != value_name)
-            ARGOS_THROW("Unknown value: " + std::string(value_name));
-        return get<1>(*it);
+        std::lock_guard lock(m_mutex);
+        --m_batches;
     }
 
-    std::optional<std::pair<std::string_view, ArgumentId>>
-    ParsedArgumentsImpl::get_value(ValueId value_id) const
+    void finish_initialization(ParserData& data)
     {
-        auto it = m_values.lower_bound(value_id);
-        if (it == m_values.end() || it->first != value_id)
-            return {};
-        auto nx = next(it);
-        if (nx != m_values.end() && nx->first == value_id)
-            ARGOS_THROW("Attempt to read multiple values as a single value.");
-        return it->second;
+        add_version_option(data);
+        finish_initialization(data.command, data);
+        std::vector<ValueBinding*> bindings;
+        data.command.collect_bindings(bindings);
+        data.bindings.assign(std::move(bindings));
     }
+}
 
-    std::vector<std::pair<std::string_view, ArgumentId>>
-    ParsedArgumentsImpl::get_values(ValueId value_id) const
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
     {
-        std::vector<std::pair<std::string_view, ArgumentId>> result;
-        for (auto it = m_values.lower_bound(value_id);
-             it != m_values.end() && it->first == value_id; ++it)
+        bool is_response_file(std::string_view arg)
         {
-            result.emplace_back(it->second);
+            return arg.size() > 1 && arg[0] == '@';
         }
-        return result;
-    }
-
-    const std::shared_ptr<ParsedArgumentsImpl>&
-    ParsedArgumentsImpl::add_subcommand(const CommandData* command)
-    {
-        m_commands.push_back(std::make_shared<ParsedArgumentsImpl>(
-            command, m_data));
-        return m_commands.back();
-    }
-
-    const std::vector<std::shared_ptr<ParsedArgumentsImpl>>&
-    ParsedArgumentsImpl::subcommands() const
-    {
-        return m_commands;
     }
 
-    std::vector<std::unique_ptr<IArgumentView>>
-    ParsedArgumentsImpl::get_argument_views(ValueId value_id) const
+    bool ResponseFiles::has_response_files(ArgumentSource args)
     {
-        std::vector<std::unique_ptr<IArgumentView>> result;
-        for (auto& a : m_command->arguments)
-        {
-            if (a->value_id == value_id)
-                result.emplace_back(std::make_unique<ArgumentView>(a.get()));
-        }
-        for (auto& o : m_command->options)
+        for (size_t i = 0; i < args.size(); ++i)
         {
-            if (o->value_id == value_id)
-                result.emplace_back(std::make_unique<OptionView>(o.get()));
+            if (is_response_file(args[i]))
+                return true;
         }
-        return result;
+        return false;
     }
 
-    std::unique_ptr<IArgumentView>
-    ParsedArgumentsImpl::get_argument_view(ArgumentId argument_id) const
+    bool ResponseFiles::expand(ArgumentSource args)
     {
-        for (auto& a : m_command->arguments)
-        {
-            if (a->argument_id == argument_id)
-                return std::make_unique<ArgumentView>(a.get());
-        }
-        for (auto& o : m_command->options)
+        m_arguments.reserve(m_arguments.size() + args.size());
+        for (size_t i = 0; i < args.size(); ++i)
         {
-            if (o->argument_id == argument_id)
-                return std::make_unique<OptionView>(o.get());
+            const auto arg = args[i];
+            if (!is_response_file(arg))
+                m_arguments.push_back(arg);
+            else if (!expand_file(arg))
+                return false;
         }
-        return {};
+        return true;
     }
 
-    const std::shared_ptr<ParserData>& ParsedArgumentsImpl::parser_data() const
+    ArgumentSource ResponseFiles::arguments() const
     {
-        return m_data;
+        return ArgumentSource(m_arguments);
     }
 
-    const CommandData* ParsedArgumentsImpl::command() const
+    const std::string& ResponseFiles::error_message() const
     {
-        return m_command;
+        return m_error_message;
     }
 
-    ParserResultCode ParsedArgumentsImpl::result_code() const
+    bool ResponseFiles::expand_file(std::string_view arg)
     {
-        return m_result_code;
-    }
+        std::error_code ec;
+        auto path = std::filesystem::canonical(
+            std::filesystem::path(arg.substr(1)), ec);
+        auto file = std::make_unique<MappedFile>();
+        if (ec || !file->open(path.string()))
+        {
+            // The same as GCC: files that can't be read are kept as
+            // normal arguments.
+            m_arguments.push_back(arg);
+            return true;
+        }
 
-    void ParsedArgumentsImpl::set_result_code(ParserResultCode result_code)
-    {
-        m_result_code = result_code;
-    }
+        if (std::find(m_file_stack.begin(), m_file_stack.end(), path)
+            != m_file_stack.end())
+        {
+            m_error_message = "Response file includes itself: "
+                              + std::string(arg.substr(1));
+            return false;
+        }
 
-    const OptionData* ParsedArgumentsImpl::stop_option() const
-    {
-        return m_stop_option;
+        ResponseFileTokenizer tokenizer(file->data());
+        m_files.push_back(std::move(file));
+        m_file_stack.push_back(std::move(path));
+        std::string_view token;
+        while (tokenizer.next(token))
+        {
+            if (!is_response_file(token))
+                m_arguments.push_back(token);
+            else if (!expand_file(token))
+                return false;
+        }
+        m_file_stack.pop_back();
+        return true;
     }
 
-    void ParsedArgumentsImpl::set_breaking_option(const OptionData* option)
-    {
-        m_result_code = ParserResultCode::STOP;
-        m_stop_option = option;
-    }
+    ResponseFileTokenizer::ResponseFileTokenizer(std::span<char> text)
+        : m_text(text)
+    {}
 
-    void ParsedArgumentsImpl::error(const std::string& message) const
+    bool ResponseFileTokenizer::next(std::string_view& token)
     {
-        write_error_message(*m_data, *m_command, message);
-        if (m_data->parser_settings.auto_exit)
-            exit(m_data->parser_settings.error_exit_code);
-        else
-            ARGOS_THROW("Error while parsing arguments.");
-    }
+        const auto size = m_text.size();
+        while (m_pos < size && is_space(m_text[m_pos]))
+            ++m_pos;
+        if (m_pos == size)
+            return false;
 
-    void ParsedArgumentsImpl::error(const std::string& message,
-                                    ArgumentId argument_id)
-    {
-        write_error_message(*m_data, *m_command, message, argument_id);
-        if (m_data->parser_settings.auto_exit)
-            exit(m_data->parser_settings.error_exit_code);
-        else
-            ARGOS_THROW("Error while parsing arguments.");
+        const auto start = m_pos;
+        auto out = m_pos;
+        char quote = 0;
+        while (m_pos < size)
+        {
+            auto c = m_text[m_pos];
+            if (quote != 0 && c == quote)
+            {
+                quote = 0;
+                ++m_pos;
+                continue;
+            }
+            if (quote == 0)
+            {
+                if (is_space(c))
+                    break;
+                if (c == '\'' || c == '"')
+                {
+                    quote = c;
+                    ++m_pos;
+                    continue;
+                }
+            }
+            if (c == '\\' && m_pos + 1 < size)
+                c = m_text[++m_pos];
+            if (out != m_pos)
+                m_text[out] = c;
+            ++out;
+            ++m_pos;
+        }
+
+        token = {m_text.data() + start, out - start};
+        return true;
     }
 }
 
 //****************************************************************************
-// Copyright © 2024 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2024-09-11.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -5414,54 +11420,141 @@ namespace argos
 {
     namespace
     {
-        void add_version_option(ParserData& data)
+        constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+        /**
+         * @brief Counts the occurrences of @a c in @a text eight bytes
+         *  at a time.
+         */
+        size_t count_char(std::string_view text, char c)
+        {
+            constexpr uint64_t ONES = 0x0101010101010101u;
+            constexpr uint64_t LOW_BITS = 0x7F7F7F7F7F7F7F7Fu;
+            const auto pattern = ONES * uint8_t(c);
+            size_t count = 0;
+            size_t i = 0;
+            for (; i + 8 <= text.size(); i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, text.data() + i, 8);
+                // The high bit of a byte in zeros is set if and only if
+                // the byte in word equals c.
+                const auto x = word ^ pattern;
+                const auto zeros = ~(((x & LOW_BITS) + LOW_BITS) | x | LOW_BITS);
+                count += size_t(std::popcount(zeros));
+            }
+            for (; i < text.size(); ++i)
+                count += text[i] == c ? 1 : 0;
+            return count;
+        }
+
+        template <typename T>
+        std::optional<T> convert_part(std::string_view part)
         {
-            if (data.version.empty())
-                return;
-            auto& cmd = data.command;
-            std::string flag;
-            switch (data.parser_settings.option_style)
+            if constexpr (std::is_integral_v<T>)
+                return parse_integer<T>(part, 10);
+            else
+                return parse_floating_point<T>(part);
+        }
+
+        template <typename T>
+        std::optional<std::string_view>
+        convert_chunk(std::string_view chunk, char separator, T* out)
+        {
+            while (true)
             {
-            case OptionStyle::STANDARD:
-                if (!has_flag(cmd, "--version", data.parser_settings))
-                    flag = "--version";
-                break;
-            case OptionStyle::SLASH:
-                if (!has_flag(cmd, "/VERSION", data.parser_settings))
-                    flag = "/VERSION";
-                break;
-            case OptionStyle::DASH:
-                if (!has_flag(cmd, "-version", data.parser_settings))
-                    flag = "-version";
-                break;
+                const auto pos = chunk.find(separator);
+                const auto part = chunk.substr(0, pos);
+                const auto value = convert_part<T>(part);
+                if (!value)
+                    return part;
+                *out++ = *value;
+                if (pos == std::string_view::npos)
+                    return {};
+                chunk.remove_prefix(pos + 1);
             }
+        }
+    }
 
-            if (flag.empty())
-                return;
+    SplitChunks split_chunks(std::string_view text, char separator,
+                             unsigned thread_count)
+    {
+        SplitChunks result;
+        if (text.empty())
+            return result;
 
-            auto stream = data.help_settings.output_stream
-                              ? data.help_settings.output_stream
-                              : &std::cout;
-            auto opt = Option().flag(flag).type(OptionType::STOP)
-                .help("Display the program version.")
-                .constant("1")
-                .callback([v = data.version, stream]
-                (auto& a)
-                    {
-                        *stream << a.builder.program_name() << " " << v << "\n";
-                        return true;
-                    })
-                .release();
-            opt->section = cmd.current_section;
-            cmd.options.push_back(std::move(opt));
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        const auto chunk_count = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE,
+                                                    1, thread_count);
+
+        // Each chunk ends where the first separator after its share of
+        // the text is.
+        size_t begin = 0;
+        for (size_t i = 1; i < chunk_count; ++i)
+        {
+            const auto pos = text.find(separator, std::max(
+                begin, text.size() * i / chunk_count));
+            if (pos == std::string_view::npos)
+                break;
+            result.chunks.push_back(text.substr(begin, pos - begin));
+            begin = pos + 1;
         }
+        result.chunks.push_back(text.substr(begin));
+
+        for (const auto& chunk : result.chunks)
+        {
+            result.offsets.push_back(result.count);
+            result.count += count_char(chunk, separator) + 1;
+        }
+        return result;
     }
 
-    void finish_initialization(ParserData& data)
+    template <typename T>
+    std::optional<std::string_view>
+    convert_chunks(const SplitChunks& chunks, char separator, T* out)
     {
-        add_version_option(data);
-        finish_initialization(data.command, data);
+        const auto n = chunks.chunks.size();
+        std::vector<std::optional<std::string_view>> errors(n);
+        auto work = [&](size_t i)
+        {
+            errors[i] = convert_chunk(chunks.chunks[i], separator,
+                                      out + chunks.offsets[i]);
+        };
+
+        // jthread, as the threads that have been started must be joined
+        // if starting one of the others fails.
+        std::vector<std::jthread> threads;
+        threads.reserve(n == 0 ? 0 : n - 1);
+        for (size_t i = 1; i < n; ++i)
+            threads.emplace_back(work, i);
+        if (n != 0)
+            work(0);
+        for (auto& thread : threads)
+            thread.join();
+
+        for (const auto& error : errors)
+        {
+            if (error)
+                return error;
+        }
+        return {};
     }
+
+#define ARGOS_CONVERT_CHUNKS(type) \
+    template std::optional<std::string_view> \
+    convert_chunks<type>(const SplitChunks&, char, type*)
+
+    ARGOS_CONVERT_CHUNKS(int);
+    ARGOS_CONVERT_CHUNKS(unsigned);
+    ARGOS_CONVERT_CHUNKS(long);
+    ARGOS_CONVERT_CHUNKS(long long);
+    ARGOS_CONVERT_CHUNKS(unsigned long);
+    ARGOS_CONVERT_CHUNKS(unsigned long long);
+    ARGOS_CONVERT_CHUNKS(float);
+    ARGOS_CONVERT_CHUNKS(double);
+
+#undef ARGOS_CONVERT_CHUNKS
 }
 
 //****************************************************************************
@@ -5472,122 +11565,234 @@ namespace argos
 // License text is included with the source distribution.
 //****************************************************************************
 
+#include <array>
+
 namespace argos
 {
-    StandardOptionIterator::StandardOptionIterator()
+    namespace
     {
+        /// "-\0-\1-\2...", lets next() return split short flags without
+        /// allocating strings.
+        constexpr auto SHORT_FLAGS = []
+        {
+            std::array<char, 512> result = {};
+            for (size_t i = 0; i < 256; ++i)
+            {
+                result[2 * i] = '-';
+                result[2 * i + 1] = char(i);
+            }
+            return result;
+        }();
+
+        std::string_view get_short_flag(char c)
+        {
+            return {&SHORT_FLAGS[2 * static_cast<unsigned char>(c)], 2};
+        }
     }
 
+    StandardOptionIterator::StandardOptionIterator() = default;
+
     StandardOptionIterator::StandardOptionIterator(std::vector<std::string_view> args)
-        : m_all_args(args.begin(), args.end()),
-          m_args(m_all_args)
+        : m_queue(std::move(args))
     {
+        m_args = m_queue.arguments();
     }
 
-    StandardOptionIterator::StandardOptionIterator(const StandardOptionIterator& rhs)
-        : m_all_args(rhs.m_all_args),
-          m_args(m_all_args.begin() + rhs.m_all_args.size() - rhs.m_args.size(), m_all_args.end()),
-          m_pos(rhs.m_pos)
+    StandardOptionIterator::StandardOptionIterator(ArgumentSource args)
+        : m_args(args)
     {
     }
 
-    std::optional<std::string> StandardOptionIterator::next()
+    StandardOptionIterator StandardOptionIterator::lookahead() const
+    {
+        StandardOptionIterator result(m_args);
+        result.m_pos = m_pos;
+        result.m_index = m_index;
+        return result;
+    }
+
+    std::optional<std::string_view> StandardOptionIterator::next()
     {
         if (m_pos != 0)
         {
             // m_pos is always greater than one if we get here.
-            if (m_pos < m_args[0].size() && m_args[0][1] != '-')
+            const auto arg = m_args.front();
+            if (m_pos < arg.size() && arg[1] != '-')
             {
-                const auto c = m_args[0][m_pos++];
-                if (m_pos == m_args[0].size())
-                    m_pos = std::string::npos;
-                return std::string{'-', c};
+                const auto c = arg[m_pos++];
+                if (m_pos == arg.size())
+                    m_pos = std::string_view::npos;
+                return get_short_flag(c);
             }
-            pop_front(m_args);
+            m_args.pop_front();
+            ++m_index;
             m_pos = 0;
         }
 
         if (m_args.empty())
             return {};
 
-        if (m_args[0].size() <= 2 || m_args[0][0] != '-')
+        const auto arg = m_args.front();
+        if (arg.size() <= 2 || arg[0] != '-')
         {
-            m_pos = std::string::npos;
-            return m_args[0];
+            m_pos = std::string_view::npos;
+            return arg;
         }
 
-        if (m_args[0][1] != '-')
+        if (arg[1] != '-')
         {
             m_pos = 2;
-            return m_args[0].substr(0, 2);
+            return arg.substr(0, 2);
         }
 
-        m_pos = m_args[0].find('=');
+        m_pos = arg.find('=');
 
-        if (m_pos == std::string::npos)
-            return m_args[0];
+        if (m_pos == std::string_view::npos)
+            return arg;
 
         m_pos++;
-        return m_args[0].substr(0, m_pos);
+        return arg.substr(0, m_pos);
     }
 
-    std::optional<std::string> StandardOptionIterator::next_value()
+    std::optional<std::string_view> StandardOptionIterator::next_value()
     {
         if (m_args.empty())
             return {};
 
-        if (m_pos != std::string::npos)
+        if (m_pos != std::string_view::npos)
         {
             const auto pos = m_pos;
-            m_pos = std::string::npos;
-            return m_args[0].substr(pos);
+            m_pos = std::string_view::npos;
+            return m_args.front().substr(pos);
         }
 
-        pop_front(m_args);
+        m_args.pop_front();
+        ++m_index;
         if (m_args.empty())
         {
             m_pos = 0;
             return {};
         }
 
-        return m_args[0];
+        return m_args.front();
     }
 
     std::string_view StandardOptionIterator::current() const
     {
         if (m_args.empty())
             ARGOS_THROW("There is no current argument.");
-        return m_args[0];
+        return m_args.front();
     }
 
-    std::span<std::string> StandardOptionIterator::remaining_arguments()
+    size_t StandardOptionIterator::index() const
+    {
+        return m_index;
+    }
+
+    bool StandardOptionIterator::is_within_argument() const
+    {
+        // Mirrors the first test in next().
+        if (m_pos == 0 || m_args.empty())
+            return false;
+        const auto arg = m_args.front();
+        return m_pos < arg.size() && arg[1] != '-';
+    }
+
+    ArgumentSource StandardOptionIterator::remaining_arguments()
     {
         split_concatenated_flags();
         return m_pos == 0 ? m_args : m_args.subspan(1);
     }
 
-    void StandardOptionIterator::insert(std::vector<std::string> args)
+    void StandardOptionIterator::insert(const std::vector<std::string>& args)
     {
         split_concatenated_flags();
-        auto args_index = m_all_args.size() - m_args.size();
-        auto insert_index = args_index;
-        if (m_pos != 0)
-            insert_index++;
-        m_all_args.insert(m_all_args.begin() + insert_index,
-                          args.begin(), args.end());
-        m_args = std::span(m_all_args.begin() + args_index, m_all_args.end());
+        std::vector<std::string_view> views;
+        views.reserve(args.size());
+        for (const auto& arg : args)
+            views.push_back(m_strings.add(arg));
+        insert_arguments(m_pos != 0 ? 1 : 0, views);
     }
 
     void StandardOptionIterator::split_concatenated_flags()
     {
-        if (m_pos == 0 || m_pos >= m_args[0].size() || m_args[0][1] == '-')
+        if (m_pos == 0 || m_args.empty())
+            return;
+
+        const auto arg = m_args.front();
+        if (m_pos >= arg.size() || arg[1] == '-')
+            return;
+
+        // Replaces "-abc" with "-a" and "-bc".
+        const std::string_view parts[] = {
+            arg.substr(0, m_pos),
+            m_strings.add("-" + std::string(arg.substr(m_pos)))
+        };
+        m_args.pop_front();
+        insert_arguments(0, parts);
+        // Both parts have the position of the argument they came from.
+        --m_index;
+    }
+
+    void StandardOptionIterator::insert_arguments(
+        size_t pos,
+        std::span<const std::string_view> args)
+    {
+        m_args = m_queue.insert(m_args, pos, args);
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t MIN_BLOCK_SIZE = 256;
+    }
+
+    void StringArena::reserve(size_t size)
+    {
+        if (size <= m_available)
             return;
 
-        auto index = m_all_args.size() - m_args.size();
-        m_all_args.insert(m_all_args.begin() + index + 1,
-                          "-" + m_args[0].substr(m_pos));
-        m_all_args[index].resize(m_pos);
-        m_args = std::span(m_all_args.begin() + index, m_all_args.end());
+        m_block_size = std::max(size, MIN_BLOCK_SIZE);
+        m_blocks.push_back(std::make_unique_for_overwrite<char[]>(m_block_size));
+        m_next = m_blocks.back().get();
+        m_available = m_block_size;
+    }
+
+    std::string_view StringArena::add(std::string_view str)
+    {
+        if (str.empty())
+            return {};
+
+        if (str.size() > m_available)
+            reserve(std::max(str.size(), 2 * m_block_size));
+
+        std::memcpy(m_next, str.data(), str.size());
+        std::string_view result(m_next, str.size());
+        m_next += str.size();
+        m_available -= str.size();
+        return result;
+    }
+
+    void StringArena::clear()
+    {
+        if (m_blocks.empty())
+            return;
+
+        // The last block is the largest one.
+        if (m_blocks.size() > 1)
+            m_blocks.erase(m_blocks.begin(), std::prev(m_blocks.end()));
+        m_next = m_blocks.back().get();
+        m_available = m_block_size;
     }
 }
 
@@ -5599,8 +11804,6 @@ namespace argos
 // License text is included with the source distribution.
 //****************************************************************************
 
-#include <cstdint>
-
 namespace argos
 {
     bool are_equal_chars_ci(char a, char b)
@@ -5811,6 +12014,17 @@ namespace argos
             return c < 'A' || 'Z' < c;
         });
     }
+
+    uint32_t hash_string(std::string_view str, bool case_insensitive)
+    {
+        uint32_t h = 2166136261u;
+        for (const char c : str)
+        {
+            h ^= uint8_t(case_insensitive ? to_lower(c) : c);
+            h *= 16777619u;
+        }
+        return h;
+    }
 }
 
 //****************************************************************************
@@ -6201,6 +12415,279 @@ namespace argos
     }
 }
 
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    ValueIndex::ValueIndex() = default;
+
+    ValueIndex::ValueIndex(
+        const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+        const std::vector<std::unique_ptr<OptionData>>& options)
+    {
+        using std::get;
+
+        // Every argument and option that has a value, in the order
+        // argument_ids() returns them.
+        std::vector<std::tuple<ValueId, ArgumentId, ValueType, ValueBinding*,
+                               const ChoiceSet*, char>> values;
+        auto get_choices = [](const ChoiceSet& choices)
+        {
+            return choices.empty() ? nullptr : &choices;
+        };
+        for (const auto& a : arguments)
+        {
+            m_names.emplace_back(a->name, a->value_id, a->argument_id);
+            if (!a->alias.empty())
+                m_names.emplace_back(a->alias, a->value_id, a->argument_id);
+            values.emplace_back(a->value_id, a->argument_id,
+                                a->value_type, a->binding.get(),
+                                get_choices(a->choices), '\0');
+        }
+        for (const auto& o : options)
+        {
+            if (o->operation == OptionOperation::NONE)
+                continue;
+
+            for (const auto& f : o->flags)
+                m_names.emplace_back(f, o->value_id, o->argument_id);
+            if (!o->alias.empty())
+                m_names.emplace_back(o->alias, o->value_id, o->argument_id);
+            values.emplace_back(o->value_id, o->argument_id,
+                                o->value_type, o->binding.get(),
+                                get_choices(o->choices),
+                                o->dictionary_separator);
+        }
+
+        if (!m_names.empty())
+        {
+            std::sort(m_names.begin(), m_names.end());
+            for (auto it = next(m_names.begin()); it != m_names.end(); ++it)
+            {
+                auto p = prev(it);
+                if (get<0>(*it) == get<0>(*p) && get<2>(*it) != get<2>(*p))
+                    get<2>(*it) = get<2>(*p) = {};
+            }
+            m_names.erase(std::unique(m_names.begin(), m_names.end()),
+                          m_names.end());
+        }
+
+        if (!values.empty())
+        {
+            // The value IDs of a command are consecutive.
+            const auto [min_it, max_it] = std::minmax_element(
+                values.begin(), values.end(),
+                [](auto& a, auto& b) { return get<0>(a) < get<0>(b); });
+            m_first_value_id = get<0>(*min_it);
+            m_values.resize(size_t(get<0>(*max_it) - m_first_value_id) + 1);
+
+            // Counting sort of the ArgumentIds by ValueId, m_value_offsets
+            // is used as the insertion point like in
+            // ParsedArgumentsImpl::do_compact().
+            m_value_offsets.assign(m_values.size() + 1, 0);
+            for (const auto& v : values)
+                ++m_value_offsets[size_t(get<0>(v) - m_first_value_id) + 1];
+            for (size_t i = 1; i < m_value_offsets.size(); ++i)
+                m_value_offsets[i] += m_value_offsets[i - 1];
+            m_value_arguments.resize(values.size());
+            auto next_pos = m_value_offsets;
+            for (const auto& [value_id, argument_id, type, binding, choices,
+                              separator] : values)
+            {
+                const auto index = size_t(value_id - m_first_value_id);
+                m_value_arguments[next_pos[index]++] = argument_id;
+                // CommandData has verified that values that are shared
+                // by several arguments and options don't have
+                // conflicting types, bindings, choices or separators.
+                auto& info = m_values[index];
+                if (type != ValueType::STRING)
+                    info.type = type;
+                if (binding)
+                    info.binding = binding;
+                if (choices)
+                    info.choices = choices;
+                if (separator)
+                    info.dictionary_separator = separator;
+            }
+        }
+
+        for (const auto& info : m_values)
+        {
+            if (info.binding)
+                m_bindings.push_back(info.binding);
+        }
+
+        // The initial values, grouped by value in the order of the
+        // options. CommandData has verified that they can be converted
+        // to the values' types.
+        m_initial_offsets.assign(m_values.size() + 1, 0);
+        std::vector<const OptionData*> initialized;
+        for (const auto& o : options)
+        {
+            if (o->operation == OptionOperation::NONE
+                || o->initial_value.empty())
+            {
+                continue;
+            }
+            initialized.push_back(o.get());
+            ++m_initial_offsets[size_t(o->value_id - m_first_value_id) + 1];
+        }
+        std::stable_sort(initialized.begin(), initialized.end(),
+                         [](auto* a, auto* b) { return a->value_id < b->value_id; });
+        for (size_t i = 1; i < m_initial_offsets.size(); ++i)
+            m_initial_offsets[i] += m_initial_offsets[i - 1];
+        for (const auto* o : initialized)
+        {
+            if (m_initialized_values.empty()
+                || m_initialized_values.back() != o->value_id)
+            {
+                m_initialized_values.push_back(o->value_id);
+            }
+            m_initial_values.emplace_back(o->initial_value, o->argument_id);
+            TypedValue value;
+            const auto& info = m_values[size_t(o->value_id - m_first_value_id)];
+            parse_typed_value(o->initial_value, info.type, info.choices, value);
+            m_typed_initial_values.push_back(value);
+        }
+
+        // The argument IDs of a command are consecutive too.
+        int min_id = INT_MAX, max_id = INT_MIN;
+        auto update_range = [&](ArgumentId id)
+        {
+            min_id = std::min(min_id, int(id));
+            max_id = std::max(max_id, int(id));
+        };
+        for (const auto& a : arguments)
+            update_range(a->argument_id);
+        for (const auto& o : options)
+            update_range(o->argument_id);
+        if (min_id > max_id)
+            return;
+
+        m_first_argument_id = ArgumentId(min_id);
+        m_arguments.resize(size_t(max_id - min_id) + 1);
+        for (const auto& a : arguments)
+            m_arguments[size_t(a->argument_id - min_id)].first = a.get();
+        for (const auto& o : options)
+            m_arguments[size_t(o->argument_id - min_id)].second = o.get();
+    }
+
+    std::optional<std::pair<ValueId, ArgumentId>>
+    ValueIndex::find(std::string_view name) const
+    {
+        using std::get;
+        const auto it = std::lower_bound(
+            m_names.begin(), m_names.end(), name,
+            [](auto& entry, std::string_view s) { return get<0>(entry) < s; });
+        if (it == m_names.end() || get<0>(*it) != name)
+            return {};
+        return std::pair(get<1>(*it), get<2>(*it));
+    }
+
+    ValueId ValueIndex::first_value_id() const
+    {
+        return m_first_value_id;
+    }
+
+    std::span<const ValueIndex::ValueInfo> ValueIndex::values() const
+    {
+        return m_values;
+    }
+
+    std::span<ValueBinding* const> ValueIndex::bindings() const
+    {
+        return m_bindings;
+    }
+
+    std::span<const ArgumentId>
+    ValueIndex::argument_ids(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        if (index >= m_values.size())
+            return {};
+        return std::span(m_value_arguments).subspan(
+            m_value_offsets[index],
+            m_value_offsets[index + 1] - m_value_offsets[index]);
+    }
+
+    std::span<const ValueId> ValueIndex::initialized_values() const
+    {
+        return m_initialized_values;
+    }
+
+    std::span<const std::pair<std::string_view, ArgumentId>>
+    ValueIndex::initial_values(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        if (index >= m_values.size())
+            return {};
+        return std::span(m_initial_values).subspan(
+            m_initial_offsets[index],
+            m_initial_offsets[index + 1] - m_initial_offsets[index]);
+    }
+
+    std::span<const TypedValue>
+    ValueIndex::typed_initial_values(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        if (index >= m_values.size())
+            return {};
+        return std::span(m_typed_initial_values).subspan(
+            m_initial_offsets[index],
+            m_initial_offsets[index + 1] - m_initial_offsets[index]);
+    }
+
+    const ArgumentData* ValueIndex::find_argument(ArgumentId argument_id) const
+    {
+        const auto index = size_t(argument_id) - size_t(m_first_argument_id);
+        return index < m_arguments.size() ? m_arguments[index].first : nullptr;
+    }
+
+    const OptionData* ValueIndex::find_option(ArgumentId argument_id) const
+    {
+        const auto index = size_t(argument_id) - size_t(m_first_argument_id);
+        return index < m_arguments.size() ? m_arguments[index].second : nullptr;
+    }
+
+    ArgumentId ValueIndex::first_argument_id() const
+    {
+        return m_first_argument_id;
+    }
+
+    size_t ValueIndex::argument_count() const
+    {
+        return m_arguments.size();
+    }
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+namespace argos
+{
+    TypedValue ValuesViewData::convert(size_t index, ValueType type) const
+    {
+        const auto& [value, argument_id] = values[index];
+        TypedValue result;
+        if (parse_typed_value(value, type, result))
+            return result;
+        if (!args)
+            ARGOS_THROW("Invalid value: " + std::string(value) + ".");
+        args->error("Invalid value: " + std::string(value) + ".", argument_id);
+    }
+}
+
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
 // Created by Jan Erik Breimo on 2020-02-06.
@@ -258,6 +258,47 @@ namespace argos
         FAILURE
     };
 
+    /**
+     * @brief Identifies the kind of error that made a parse fail, see
+     *      ParseError.
+     */
+    enum class ParseErrorCode
+    {
+        /// There was no error.
+        NONE,
+        /// An option that isn't defined.
+        UNKNOWN_OPTION,
+        /// An argument that isn't the name of a sub-command, where
+        /// one was expected.
+        UNKNOWN_COMMAND,
+        /// An option that requires a value was the last argument.
+        MISSING_VALUE,
+        /// A value that doesn't match the value type or choices of its
+        /// argument or option.
+        INVALID_VALUE,
+        /// More arguments than the command accepts.
+        TOO_MANY_ARGUMENTS,
+        /// Fewer arguments than the command requires.
+        TOO_FEW_ARGUMENTS,
+        /// A mandatory option wasn't given.
+        MISSING_OPTION,
+        /// The command requires a sub-command, but none was given.
+        MISSING_COMMAND,
+        /// The arguments or options violate a constraint, see
+        /// ArgumentParser::mutually_exclusive().
+        CONSTRAINT_VIOLATION,
+        /// An IncrementalParser couldn't tell which argument a value
+        /// belongs to within its lookahead limit.
+        AMBIGUOUS_ARGUMENT,
+        /// A response file could not be read.
+        RESPONSE_FILE,
+        /**
+         * @brief A callback reported an error with
+         *      ParsedArgumentsBuilder::error().
+         */
+        CALLBACK
+    };
+
     /**
      * @brief Tells which part of the help text (or error text) is assigned.
      *
@@ -367,6 +408,52 @@ namespace argos
         return Visibility(unsigned(a) & unsigned(b));
     }
 
+    /**
+     * @brief The type that the values of an argument or option are
+     *      converted to while the command line is parsed.
+     *
+     * The converted values are stored in ParsedArguments, and the
+     * ArgumentValue and ArgumentValues functions for the same type
+     * return them without converting the text again. Integers are
+     * converted with base 10, the functions convert the text as usual
+     * if they are called with a different base. Values that can't be
+     * converted are reported as errors by the parser.
+     */
+    enum class ValueType
+    {
+        /**
+         * @brief The values are only stored as text (the default).
+         */
+        STRING,
+        /// Corresponds to ArgumentValue::as_bool().
+        BOOL,
+        /// Corresponds to ArgumentValue::as_int().
+        INT,
+        /// Corresponds to ArgumentValue::as_uint().
+        UINT,
+        /// Corresponds to ArgumentValue::as_long().
+        LONG,
+        /// Corresponds to ArgumentValue::as_llong().
+        LLONG,
+        /// Corresponds to ArgumentValue::as_ulong().
+        ULONG,
+        /// Corresponds to ArgumentValue::as_ullong().
+        ULLONG,
+        /// Corresponds to ArgumentValue::as_float().
+        FLOAT,
+        /// Corresponds to ArgumentValue::as_double().
+        DOUBLE,
+        /**
+         * @brief Corresponds to ArgumentValue::as_choice().
+         *
+         * The values must be among the choices of the argument or
+         * option, and are stored as their position in the list of
+         * choices. Arguments and options with choices get this type
+         * unless they are given another one.
+         */
+        CHOICE
+    };
+
     /**
      * @brief Strong integer type for value ids.
      */
@@ -462,6 +549,9 @@ namespace argos
 //****************************************************************************
 #include <memory>
 #include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 /**
  * @file
@@ -473,6 +563,39 @@ namespace argos
     class ParsedArgumentsImpl;
     class ArgumentValues;
 
+    /**
+     * @private
+     * @brief A value that has been converted to the ValueType of its
+     *      argument or option. Only the member that corresponds to
+     *      the ValueType is valid.
+     */
+    union TypedValue
+    {
+        unsigned long long ullong_value = 0;
+        bool bool_value;
+        int int_value;
+        unsigned uint_value;
+        long long_value;
+        long long llong_value;
+        unsigned long ulong_value;
+        float float_value;
+        double double_value;
+    };
+
+    /**
+     * @brief The types ArgumentValue::split_as() and
+     *  ArgumentValue::split_into() can convert values to.
+     */
+    template <typename T>
+    concept SplitNumber = std::is_same_v<T, int>
+                          || std::is_same_v<T, unsigned>
+                          || std::is_same_v<T, long>
+                          || std::is_same_v<T, long long>
+                          || std::is_same_v<T, unsigned long>
+                          || std::is_same_v<T, unsigned long long>
+                          || std::is_same_v<T, float>
+                          || std::is_same_v<T, double>;
+
     /**
      * @brief Wrapper class for the value of an argument or option.
      *
@@ -493,7 +616,9 @@ namespace argos
         ArgumentValue(const std::optional<std::string_view>& value,
                       std::shared_ptr<ParsedArgumentsImpl> args,
                       ValueId value_id,
-                      ArgumentId argument_id);
+                      ArgumentId argument_id,
+                      ValueType value_type = ValueType::STRING,
+                      TypedValue typed_value = {});
 
         /**
          * @private
@@ -684,6 +809,23 @@ namespace argos
          */
         [[nodiscard]] double as_double(double default_value = 0) const;
 
+        /**
+         * @brief Returns the position of the value from the command line
+         *      in the list of choices given to Option::choices() or
+         *      Argument::choices().
+         *
+         * Returns default_value if the value was not given on the command line.
+         *
+         * If the value is not among the choices, an error message
+         * is displayed and the program either exits (auto_exit is true) or the
+         * function throws an exception (auto_exit is false).
+         *
+         * @throw ArgosException if @a auto_exit is false and the given value
+         *      is not among the choices, or the value doesn't have any
+         *      choices.
+         */
+        [[nodiscard]] int as_choice(int default_value = -1) const;
+
         /**
          * @brief Returns the value from the command line as a string.
          *
@@ -729,6 +871,53 @@ namespace argos
         [[nodiscard]] ArgumentValues
         split_n(char separator, size_t num_parts) const;
 
+        /**
+         * @brief Splits the value from the command line on @a separator
+         *  and converts the parts to @a T.
+         *
+         * Unlike `split(separator).as_ints()` and similar, the parts
+         * are converted directly from the command line text, without
+         * creating any intermediate objects, which makes a difference
+         * for values with many thousands of parts. Integers are
+         * converted in base 10. An empty value has no parts.
+         *
+         * If a part can't be converted, an error message with the first
+         * such part is displayed and the program either exits
+         * (auto_exit is true) or the function throws an exception
+         * (auto_exit is false).
+         *
+         * @param separator The separator.
+         * @param thread_count The maximum number of threads that
+         *  convert the parts, 0 means the number of hardware threads.
+         *  Each thread gets at least 64 KiB of text.
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted.
+         */
+        template <SplitNumber T>
+        [[nodiscard]] std::vector<T>
+        split_as(char separator, unsigned thread_count = 1) const;
+
+        /**
+         * @brief Splits the value from the command line on @a separator
+         *  and writes the parts converted to @a T to @a buffer.
+         *
+         * Works like split_as(), but doesn't allocate memory for the
+         * result. Returns the number of parts. It is an error if
+         * @a buffer is too small. @a T can't be deduced from arrays
+         * and vectors, it must be given explicitly:
+         *
+         * ~~~{.cpp}
+         *  std::vector<int> ids(1000);
+         *  ids.resize(args.value("--ids").split_into<int>(ids, ','));
+         * ~~~
+         *
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted or @a buffer is too small.
+         */
+        template <SplitNumber T>
+        size_t split_into(std::span<T> buffer, char separator,
+                          unsigned thread_count = 1) const;
+
         /**
          * Display @a message as if it was an error produced within Argos
          * itself, including a reference to the argument or option this value
@@ -746,6 +935,90 @@ namespace argos
         std::shared_ptr<ParsedArgumentsImpl> m_args;
         ValueId m_value_id;
         ArgumentId m_argument_id;
+        ValueType m_value_type = ValueType::STRING;
+        TypedValue m_typed_value;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+/**
+ * @file
+ * @brief Defines the ArgumentDictionary class.
+ */
+
+namespace argos
+{
+    /**
+     * @brief The keys and values of an option whose values are
+     *  key/value pairs, see Option::dictionary().
+     *
+     * The keys and values refer to the text in the ParsedArguments
+     * the dictionary came from, and are only valid as long as it
+     * exists. If a key is given more than once, the last value
+     * replaces the earlier ones, but the key keeps the position where
+     * it was first given.
+     */
+    class ArgumentDictionary
+    {
+    public:
+        using Entry = std::pair<std::string_view, std::string_view>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        ArgumentDictionary();
+
+        /**
+         * @private
+         * @brief Splits each of @a values on the first @a separator.
+         *
+         * Values without @a separator are keys with empty values.
+         */
+        ArgumentDictionary(
+            std::span<const std::pair<std::string_view, ArgumentId>> values,
+            char separator);
+
+        /**
+         * @brief Returns the number of distinct keys.
+         */
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Returns the value of @a key, or nothing if the key
+         *  wasn't given.
+         */
+        [[nodiscard]] std::optional<std::string_view>
+        lookup(std::string_view key) const;
+
+        [[nodiscard]] bool contains(std::string_view key) const;
+
+        /**
+         * @brief Returns the key/value pairs in the order the keys were
+         *  first given.
+         */
+        [[nodiscard]] const std::vector<Entry>& entries() const;
+
+        [[nodiscard]] const_iterator begin() const;
+
+        [[nodiscard]] const_iterator end() const;
+    private:
+        [[nodiscard]] std::optional<size_t> find(std::string_view key,
+                                                 uint32_t hash) const;
+
+        std::vector<Entry> m_entries;
+        /// A hash table of the keys' positions in m_entries, see
+        /// HashSlots in HashSlots.hpp.
+        std::vector<std::pair<uint32_t, uint32_t>> m_table;
     };
 }
 
@@ -757,8 +1030,6 @@ namespace argos
 // License text is included with the source distribution.
 //****************************************************************************
 #include <iterator>
-#include <string_view>
-#include <vector>
 
 /**
  * @file
@@ -844,6 +1115,267 @@ namespace argos
                     const ArgumentValueIterator& b);
 }
 
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <compare>
+#include <cstddef>
+#include <ranges>
+
+/**
+ * @file
+ * @brief Defines the ValuesView class template.
+ */
+
+namespace argos
+{
+    class ParsedArgumentsImpl;
+
+    /**
+     * @private
+     * @brief The values a ValuesView refers to.
+     */
+    struct ValuesViewData
+    {
+        std::span<const std::pair<std::string_view, ArgumentId>> values;
+        /// Parallel to values unless type is STRING.
+        std::span<const TypedValue> typed_values;
+        ValueType type = ValueType::STRING;
+        const ParsedArgumentsImpl* args = nullptr;
+
+        /**
+         * @brief Returns value number @a index converted to @a type.
+         *
+         * Reports an invalid value the same way as ArgumentValue.
+         */
+        [[nodiscard]] TypedValue convert(size_t index, ValueType type) const;
+    };
+
+    /**
+     * @private
+     * @brief Maps the types ValuesView can convert values to to their
+     *  ValueType and TypedValue member.
+     */
+    template <typename T>
+    struct ValuesViewType;
+
+#define ARGOS_VALUES_VIEW_TYPE(type, value_type_, member) \
+    template <> \
+    struct ValuesViewType<type> \
+    { \
+        static constexpr ValueType VALUE_TYPE = ValueType::value_type_; \
+        static type get(const TypedValue& value) \
+        { \
+            return value.member; \
+        } \
+    }
+
+    ARGOS_VALUES_VIEW_TYPE(bool, BOOL, bool_value);
+    ARGOS_VALUES_VIEW_TYPE(int, INT, int_value);
+    ARGOS_VALUES_VIEW_TYPE(unsigned, UINT, uint_value);
+    ARGOS_VALUES_VIEW_TYPE(long, LONG, long_value);
+    ARGOS_VALUES_VIEW_TYPE(long long, LLONG, llong_value);
+    ARGOS_VALUES_VIEW_TYPE(unsigned long, ULONG, ulong_value);
+    ARGOS_VALUES_VIEW_TYPE(unsigned long long, ULLONG, ullong_value);
+    ARGOS_VALUES_VIEW_TYPE(float, FLOAT, float_value);
+    ARGOS_VALUES_VIEW_TYPE(double, DOUBLE, double_value);
+
+#undef ARGOS_VALUES_VIEW_TYPE
+
+    /**
+     * @brief A non-owning random access range over the values of an
+     *  argument or option.
+     *
+     * The values are std::string_views by default, view_as() returns
+     * a view that converts them to a number or bool. Values that were
+     * converted while parsing, because the argument or option has a
+     * ValueType, are not converted again.
+     *
+     * Neither the view nor its iterators allocate memory or update
+     * reference counts. They are only valid as long as the
+     * ParsedArguments they came from exists and hasn't been reused
+     * for another parse.
+     */
+    template <typename T>
+    class ValuesView : public std::ranges::view_interface<ValuesView<T>>
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            /**
+             * @private
+             */
+            Iterator(ValuesViewData data, size_t index)
+                : m_data(data),
+                  m_index(index)
+            {}
+
+            T operator*() const
+            {
+                return get_value(m_data, m_index);
+            }
+
+            T operator[](difference_type n) const
+            {
+                return get_value(m_data, m_index + n);
+            }
+
+            Iterator& operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto it = *this;
+                ++m_index;
+                return it;
+            }
+
+            Iterator& operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                auto it = *this;
+                --m_index;
+                return it;
+            }
+
+            Iterator& operator+=(difference_type n)
+            {
+                m_index += n;
+                return *this;
+            }
+
+            Iterator& operator-=(difference_type n)
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            friend Iterator operator+(Iterator it, difference_type n)
+            {
+                return it += n;
+            }
+
+            friend Iterator operator+(difference_type n, Iterator it)
+            {
+                return it += n;
+            }
+
+            friend Iterator operator-(Iterator it, difference_type n)
+            {
+                return it -= n;
+            }
+
+            friend difference_type operator-(const Iterator& a,
+                                             const Iterator& b)
+            {
+                return difference_type(a.m_index) - difference_type(b.m_index);
+            }
+
+            friend bool operator==(const Iterator& a, const Iterator& b)
+            {
+                return a.m_index == b.m_index;
+            }
+
+            friend std::strong_ordering operator<=>(const Iterator& a,
+                                                    const Iterator& b)
+            {
+                return a.m_index <=> b.m_index;
+            }
+        private:
+            ValuesViewData m_data;
+            size_t m_index = 0;
+        };
+
+        ValuesView() = default;
+
+        /**
+         * @private
+         */
+        explicit ValuesView(ValuesViewData data)
+            : m_data(data)
+        {}
+
+        [[nodiscard]] Iterator begin() const
+        {
+            return {m_data, 0};
+        }
+
+        [[nodiscard]] Iterator end() const
+        {
+            return {m_data, m_data.values.size()};
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return m_data.values.size();
+        }
+
+        /**
+         * @brief Returns the ArgumentId of the argument or option that
+         *  produced value number @a index.
+         */
+        [[nodiscard]] ArgumentId argument_id(size_t index) const
+        {
+            return m_data.values[index].second;
+        }
+
+        /**
+         * @brief Returns a view of the same values converted to @a U.
+         *
+         * @a U is bool, int, unsigned, long, long long, unsigned long,
+         * unsigned long long, float, double or std::string_view.
+         * Integers are parsed in base 10. Invalid values are reported
+         * when they are read, the same way as ArgumentValue reports
+         * them.
+         */
+        template <typename U>
+        [[nodiscard]] ValuesView<U> view_as() const
+        {
+            return ValuesView<U>(m_data);
+        }
+    private:
+        static T get_value(const ValuesViewData& data, size_t index)
+        {
+            if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                return data.values[index].first;
+            }
+            else
+            {
+                using Type = ValuesViewType<T>;
+                if (data.type == Type::VALUE_TYPE)
+                    return Type::get(data.typed_values[index]);
+                return Type::get(data.convert(index, Type::VALUE_TYPE));
+            }
+        }
+
+        ValuesViewData m_data;
+    };
+}
+
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<argos::ValuesView<T>> = true;
+
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
 // Created by Jan Erik Breimo on 2020-02-17.
@@ -859,7 +1391,6 @@ namespace argos
 
 namespace argos
 {
-    class ArgumentValue;
     class ParsedArgumentsImpl;
 
     /**
@@ -876,7 +1407,9 @@ namespace argos
          */
         ArgumentValues(std::vector<std::pair<std::string_view, ArgumentId>> values,
                        std::shared_ptr<ParsedArgumentsImpl> args,
-                       ValueId value_id);
+                       ValueId value_id,
+                       ValueType value_type = ValueType::STRING,
+                       std::vector<TypedValue> typed_values = {});
 
         /**
          * @private
@@ -969,6 +1502,31 @@ namespace argos
          */
         [[nodiscard]] ArgumentValue value(size_t index) const;
 
+        /**
+         * @brief Returns a view of the values that neither allocates
+         *  memory nor shares ownership of the values.
+         *
+         * The view is only valid as long as this ArgumentValues exists.
+         */
+        [[nodiscard]] ValuesView<std::string_view> view() const &;
+
+        ValuesView<std::string_view> view() const && = delete;
+
+        /**
+         * @brief Returns a view of the values converted to @a T.
+         *
+         * See ValuesView::view_as() for the types @a T can be. The
+         * view is only valid as long as this ArgumentValues exists.
+         */
+        template <typename T>
+        [[nodiscard]] ValuesView<T> view_as() const &
+        {
+            return view().template view_as<T>();
+        }
+
+        template <typename T>
+        ValuesView<T> view_as() const && = delete;
+
         /**
          * @brief Returns a vector where every argument value has been
          *  converted to int.
@@ -1101,6 +1659,22 @@ namespace argos
         [[nodiscard]] std::vector<double>
         as_doubles(const std::vector<double>& default_value = {}) const;
 
+        /**
+         * @brief Returns a vector with every argument value's position in
+         *  the list of choices given to Option::choices() or
+         *  Argument::choices().
+         *
+         * If any of the argument values are not among the choices, an error
+         * message is written to stderr, the program also automatically exits
+         * if auto_exit is true.
+         *
+         * @param default_value This vector is returned if there are no values.
+         * @throw ArgosException if any value is not among the choices and
+         *  auto_exit is false, or the values don't have any choices.
+         */
+        [[nodiscard]] std::vector<int>
+        as_choices(const std::vector<int>& default_value = {}) const;
+
         /**
          * @brief Returns a vector with the argument values.
          *
@@ -1141,6 +1715,33 @@ namespace argos
         [[nodiscard]] ArgumentValues
         split_n(char separator, size_t num_parts) const;
 
+        /**
+         * @brief Splits each value on @a separator and returns all the
+         *  parts converted to @a T.
+         *
+         * See ArgumentValue::split_as() for details.
+         *
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted.
+         */
+        template <SplitNumber T>
+        [[nodiscard]] std::vector<T>
+        split_as(char separator, unsigned thread_count = 1) const;
+
+        /**
+         * @brief Splits each value on @a separator and writes all the
+         *  parts converted to @a T to @a buffer.
+         *
+         * Returns the number of parts. See ArgumentValue::split_into()
+         * for details.
+         *
+         * @throw ArgosException if @a auto_exit is false and a part
+         *  can't be converted or @a buffer is too small.
+         */
+        template <SplitNumber T>
+        size_t split_into(std::span<T> buffer, char separator,
+                          unsigned thread_count = 1) const;
+
         /**
          * @brief Returns an iterator pointing to the first value.
          */
@@ -1154,6 +1755,9 @@ namespace argos
         std::vector<std::pair<std::string_view, ArgumentId>> m_values;
         std::shared_ptr<ParsedArgumentsImpl> m_args;
         ValueId m_value_id;
+        ValueType m_value_type = ValueType::STRING;
+        /// The converted values, empty if m_value_type is STRING.
+        std::vector<TypedValue> m_typed_values;
     };
 }
 
@@ -1464,6 +2068,98 @@ namespace argos
     };
 }
 
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+/**
+ * @file
+ * @brief Defines the ValueHandle class.
+ */
+
+namespace argos
+{
+    /**
+     * @brief Refers to the value of an argument or option without
+     *      using its name.
+     *
+     * ArgumentParser::add() and Command::add() set the handle when it
+     * is passed along with the argument or option. The handle can then
+     * be used with every ParsedArguments and ParsedArgumentsBuilder for
+     * the same command, and finds the value in constant time without
+     * allocating memory.
+     *
+     * A handle for an option or argument in a sub-command must be used
+     * with the ParsedArguments of that sub-command, using it with any
+     * other command's ParsedArguments is an error.
+     */
+    class ValueHandle
+    {
+    public:
+        /**
+         * @brief Creates a handle that doesn't refer to any value.
+         */
+        constexpr ValueHandle() = default;
+
+        /**
+         * @private
+         * @brief Used internally in Argos.
+         */
+        constexpr ValueHandle(unsigned command, bool is_option, unsigned index)
+            : m_command(command),
+              m_index(index),
+              m_is_option(is_option),
+              m_is_set(true)
+        {}
+
+        /**
+         * @brief Returns true if the handle has been set by add().
+         */
+        constexpr explicit operator bool() const
+        {
+            return m_is_set;
+        }
+
+        /**
+         * @private
+         * @brief Identifies the command the argument or option
+         *  belongs to.
+         */
+        [[nodiscard]] constexpr unsigned command() const
+        {
+            return m_command;
+        }
+
+        /**
+         * @private
+         * @brief Returns true if the handle refers to an option.
+         */
+        [[nodiscard]] constexpr bool is_option() const
+        {
+            return m_is_option;
+        }
+
+        /**
+         * @private
+         * @brief Returns the position of the argument or option among
+         *  the arguments or options in its command.
+         */
+        [[nodiscard]] constexpr unsigned index() const
+        {
+            return m_index;
+        }
+    private:
+        unsigned m_command = 0;
+        unsigned m_index = 0;
+        bool m_is_option = false;
+        bool m_is_set = false;
+    };
+}
+
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
 // Created by Jan Erik Breimo on 2020-01-26.
@@ -1552,6 +2248,15 @@ namespace argos
          */
         [[nodiscard]] bool has(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns true if the argument or option @a handle refers
+         *  to was given on command line.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] bool has(ValueHandle handle) const;
+
         /**
          * @brief Returns parsed arguments of sub-commands.
          *
@@ -1573,6 +2278,15 @@ namespace argos
          */
         [[nodiscard]] ArgumentValue value(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the value of the argument or option @a handle
+         *  refers to.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ArgumentValue value(ValueHandle handle) const;
+
         /**
          * @brief Returns the values of the argument with the given name.
          *
@@ -1587,10 +2301,82 @@ namespace argos
         [[nodiscard]] ArgumentValues values(const IArgumentView& arg) const;
 
         /**
-         * @brief Returns all argument definitions that were added to the
-         *  ArgumentParser.
+         * @brief Returns the values of the argument or option @a handle
+         *  refers to.
          *
-         * Intended for testing and debugging, for instance to list all
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ArgumentValues values(ValueHandle handle) const;
+
+        /**
+         * @brief Returns a view of the values of the argument or option
+         *  with the given name.
+         *
+         * Unlike values(), the view doesn't copy the values or share
+         * ownership of them, it is only valid as long as this
+         * ParsedArguments exists. Use ValuesView::view_as() to read
+         * the values as numbers.
+         *
+         * @throw ArgosException if @a name doesn't match the name of any
+         *  argument or option.
+         */
+        [[nodiscard]] ValuesView<std::string_view>
+        values_view(const std::string& name) const;
+
+        /**
+         * @brief Returns a view of the values of the given argument.
+         */
+        [[nodiscard]] ValuesView<std::string_view>
+        values_view(const IArgumentView& arg) const;
+
+        /**
+         * @brief Returns a view of the values of the argument or option
+         *  @a handle refers to.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ValuesView<std::string_view>
+        values_view(ValueHandle handle) const;
+
+        /**
+         * @brief Returns the values of the option with the given name
+         *  as key/value pairs, see Option::dictionary().
+         *
+         * Like values_view(), the dictionary doesn't copy the values,
+         * it is only valid as long as this ParsedArguments exists.
+         * Values of options that aren't dictionary options are split
+         * on '='.
+         *
+         * @throw ArgosException if @a name doesn't match the name of any
+         *  argument or option.
+         */
+        [[nodiscard]] ArgumentDictionary
+        dictionary(const std::string& name) const;
+
+        /**
+         * @brief Returns the values of the given option as key/value
+         *  pairs.
+         */
+        [[nodiscard]] ArgumentDictionary
+        dictionary(const IArgumentView& arg) const;
+
+        /**
+         * @brief Returns the values of the option @a handle refers to as
+         *  key/value pairs.
+         *
+         * @throw ArgosException if @a handle doesn't refer to an
+         *  argument or option in this command.
+         */
+        [[nodiscard]] ArgumentDictionary
+        dictionary(ValueHandle handle) const;
+
+        /**
+         * @brief Returns all argument definitions that were added to the
+         *  ArgumentParser.
+         *
+         * Intended for testing and debugging, for instance to list all
          * defined arguments along with their given values.
          *
          * @warning The returned instances are referring to data managed
@@ -1675,6 +2461,8 @@ namespace argos
         [[noreturn]]
         void error(const std::string& msg) const;
     private:
+        friend class CompiledParser;
+
         std::shared_ptr<ParsedArgumentsImpl> m_impl;
     };
 
@@ -1726,7 +2514,7 @@ namespace argos
          * Client code must use ArgumentParser::make_iterator().
          */
         ArgumentIterator(std::vector<std::string_view> args,
-                         std::shared_ptr<ParserData> parser_data);
+                         std::shared_ptr<const ParserData> parser_data);
 
         /**
          * @private
@@ -1795,6 +2583,141 @@ namespace argos
     };
 }
 
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+/**
+ * @file
+ * @brief Defines the ArgumentRange concept and the ArgumentSource class.
+ */
+
+namespace argos
+{
+    /**
+     * @brief A contiguous range of command line arguments, e.g.
+     *  std::vector<std::string>, std::span<char*> or
+     *  std::array<std::string_view, N>.
+     *
+     * The elements must be char*, const char*, std::string_view or
+     * std::string.
+     */
+    template <typename T>
+    concept ArgumentRange =
+        std::ranges::contiguous_range<T>
+        && std::ranges::sized_range<T>
+        && (std::is_same_v<std::ranges::range_value_t<T>, char*>
+            || std::is_same_v<std::ranges::range_value_t<T>, const char*>
+            || std::is_same_v<std::ranges::range_value_t<T>, std::string_view>
+            || std::is_same_v<std::ranges::range_value_t<T>, std::string>);
+
+    /**
+     * @private
+     * @brief A non-owning view of a contiguous sequence of command line
+     *  arguments.
+     *
+     * The arguments are read directly from the caller's memory, the
+     * parser only copies the values it stores in ParsedArguments.
+     */
+    class ArgumentSource
+    {
+    public:
+        constexpr ArgumentSource() noexcept = default;
+
+        constexpr ArgumentSource(const char* const* args, size_t size) noexcept
+            : m_c_strings(args),
+              m_size(size),
+              m_type(Type::C_STRING)
+        {}
+
+        constexpr ArgumentSource(const std::string_view* args, size_t size) noexcept
+            : m_string_views(args),
+              m_size(size),
+              m_type(Type::STRING_VIEW)
+        {}
+
+        constexpr ArgumentSource(const std::string* args, size_t size) noexcept
+            : m_strings(args),
+              m_size(size),
+              m_type(Type::STRING)
+        {}
+
+        template <ArgumentRange Range>
+        constexpr explicit ArgumentSource(const Range& args) noexcept
+            : ArgumentSource(std::ranges::data(args), std::ranges::size(args))
+        {}
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr std::string_view operator[](size_t i) const
+        {
+            switch (m_type)
+            {
+            case Type::C_STRING:
+                return m_c_strings[i];
+            case Type::STRING:
+                return m_strings[i];
+            default:
+                return m_string_views[i];
+            }
+        }
+
+        [[nodiscard]] constexpr std::string_view front() const
+        {
+            return (*this)[0];
+        }
+
+        constexpr void pop_front() noexcept
+        {
+            *this = subspan(1);
+        }
+
+        /**
+         * @brief Returns the arguments from @a offset to the end.
+         */
+        [[nodiscard]] constexpr ArgumentSource subspan(size_t offset) const noexcept
+        {
+            switch (m_type)
+            {
+            case Type::C_STRING:
+                return {m_c_strings + offset, m_size - offset};
+            case Type::STRING:
+                return {m_strings + offset, m_size - offset};
+            default:
+                return {m_string_views + offset, m_size - offset};
+            }
+        }
+    private:
+        enum class Type : unsigned char
+        {
+            C_STRING,
+            STRING_VIEW,
+            STRING
+        };
+
+        union
+        {
+            const char* const* m_c_strings;
+            const std::string_view* m_string_views = nullptr;
+            const std::string* m_strings;
+        };
+        size_t m_size = 0;
+        Type m_type = Type::STRING_VIEW;
+    };
+}
+
 //****************************************************************************
 // Copyright © 2020 Jan Erik Breimo. All rights reserved.
 // Created by Jan Erik Breimo on 2020-01-29.
@@ -1865,6 +2788,13 @@ namespace argos
         ParsedArgumentsBuilder& append(const IArgumentView& arg,
                                        const std::string& value);
 
+        /**
+         * @brief Add @a value to the argument or option @a handle
+         *  refers to.
+         */
+        ParsedArgumentsBuilder& append(ValueHandle handle,
+                                       const std::string& value);
+
         /**
          * @brief Set the value of the named argument or option.
          *
@@ -1894,6 +2824,13 @@ namespace argos
         ParsedArgumentsBuilder& assign(const IArgumentView& arg,
                                        const std::string& value);
 
+        /**
+         * @brief Set the value of the argument or option @a handle
+         *  refers to.
+         */
+        ParsedArgumentsBuilder& assign(ValueHandle handle,
+                                       const std::string& value);
+
         /**
          * @brief Removes the value or values of the named argument or option.
          *
@@ -1919,6 +2856,12 @@ namespace argos
          */
         ParsedArgumentsBuilder& clear(const IArgumentView& arg);
 
+        /**
+         * @brief Removes the value or values of the argument or option
+         *  @a handle refers to.
+         */
+        ParsedArgumentsBuilder& clear(ValueHandle handle);
+
         /**
          * @brief Returns the value of the named argument or option.
          * @throw ArgosException if the argument or option has multiple
@@ -1934,6 +2877,12 @@ namespace argos
          */
         [[nodiscard]] ArgumentValue value(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the value of the argument or option @a handle
+         *  refers to.
+         */
+        [[nodiscard]] ArgumentValue value(ValueHandle handle) const;
+
         /**
          * @brief Returns the value of the named argument or option.
          * @throw ArgosException if the name doesn't match any of names,
@@ -1947,6 +2896,12 @@ namespace argos
          */
         [[nodiscard]] ArgumentValues values(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns the values of the argument or option @a handle
+         *  refers to.
+         */
+        [[nodiscard]] ArgumentValues values(ValueHandle handle) const;
+
         /**
          * @brief Returns true if the named argument or option has been
          *  assigned a value.
@@ -1958,6 +2913,12 @@ namespace argos
          */
         [[nodiscard]] bool has(const IArgumentView& arg) const;
 
+        /**
+         * @brief Returns true if the argument or option @a handle refers
+         *  to has been assigned a value.
+         */
+        [[nodiscard]] bool has(ValueHandle handle) const;
+
         /**
          * @brief Print @a msg along with a brief help text and exit.
          *
@@ -1979,7 +2940,9 @@ namespace argos
          *  ArgumentParser.
          *
          * Returns a reference to the default stream (std::cout) if none
-         * has been assigned.
+         * has been assigned, and a stream that discards everything
+         * written to it when the arguments are parsed with
+         * CompiledParser::parse_batch().
          */
         [[nodiscard]] std::ostream& stream() const;
 
@@ -2095,6 +3058,7 @@ namespace argos
 namespace argos
 {
     struct ArgumentData;
+    class ValueBinding;
 
     /**
      * @brief Class for defining command line arguments.
@@ -2290,6 +3254,45 @@ namespace argos
          */
         Argument& count(unsigned min_count, unsigned max_count);
 
+        /**
+         * @brief Set the type the argument's values are converted to
+         *      while the command line is parsed.
+         *
+         * See ValueType for details. When several arguments and options
+         * share a value, it is sufficient to set the type on one of
+         * them, but they can't have different types.
+         * @return Reference to itself. This makes it possible to chain
+         *      method calls.
+         */
+        Argument& value_type(ValueType type);
+
+        /**
+         * @brief Only accept values that are among @a values.
+         *
+         * See Option::choices() for details.
+         * @return Reference to itself. This makes it possible to chain
+         *      method calls.
+         */
+        Argument& choices(std::vector<std::string> values);
+
+        /**
+         * @brief Write the argument's values directly to @a variable
+         *      while the command line is parsed.
+         *
+         * @a variable can be a bool, any of the integer and floating
+         * point types that ArgumentValue can convert to, a std::string,
+         * or a std::vector of any of these except bool. Each value is
+         * added to a vector, other variables get the last value.
+         * Invalid values are reported as errors by the parser.
+         *
+         * Bound values aren't stored in ParsedArguments, see
+         * Option::bind() for details.
+         * @return Reference to itself. This makes it possible to chain
+         *      method calls.
+         */
+        template <typename T>
+        Argument& bind(T& variable) = delete;
+
         /**
          * @private
          * @brief Used internally in Argos.
@@ -2302,9 +3305,68 @@ namespace argos
     private:
         void check_argument() const;
 
+        Argument& set_binding(std::shared_ptr<ValueBinding> binding);
+
         std::unique_ptr<ArgumentData> m_argument;
     };
 
+    template <>
+    Argument& Argument::bind<bool>(bool& variable);
+
+    template <>
+    Argument& Argument::bind<int>(int& variable);
+
+    template <>
+    Argument& Argument::bind<unsigned>(unsigned& variable);
+
+    template <>
+    Argument& Argument::bind<long>(long& variable);
+
+    template <>
+    Argument& Argument::bind<long long>(long long& variable);
+
+    template <>
+    Argument& Argument::bind<unsigned long>(unsigned long& variable);
+
+    template <>
+    Argument& Argument::bind<unsigned long long>(unsigned long long& variable);
+
+    template <>
+    Argument& Argument::bind<float>(float& variable);
+
+    template <>
+    Argument& Argument::bind<double>(double& variable);
+
+    template <>
+    Argument& Argument::bind<std::string>(std::string& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<int>>(std::vector<int>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<unsigned>>(std::vector<unsigned>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<long>>(std::vector<long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<long long>>(std::vector<long long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<unsigned long>>(std::vector<unsigned long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<unsigned long long>>(std::vector<unsigned long long>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<float>>(std::vector<float>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<double>>(std::vector<double>& variable);
+
+    template <>
+    Argument& Argument::bind<std::vector<std::string>>(std::vector<std::string>& variable);
+
     /**
      * @brief A convenient short alias for Argument.
      */
@@ -2328,6 +3390,7 @@ namespace argos
 namespace argos
 {
     struct OptionData;
+    class ValueBinding;
 
     /**
      * @brief Class for defining command line options.
@@ -2620,6 +3683,88 @@ namespace argos
          */
         Option& type(OptionType type);
 
+        /**
+         * @brief Set the type the option's values are converted to while
+         *  the command line is parsed.
+         *
+         * See ValueType for details. The option's constant and initial
+         * value must be valid values of the type. When several arguments
+         * and options share a value, it is sufficient to set the type on
+         * one of them, but they can't have different types.
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        Option& value_type(ValueType type);
+
+        /**
+         * @brief Only accept values that are among @a values.
+         *
+         * Values are checked while the command line is parsed, with a
+         * hash table that is built once when the parser is finished,
+         * and other values are reported as errors. The values are
+         * compared case-insensitively if
+         * ArgumentParser::case_insensitive() is true. The option's
+         * constant and initial value must be among @a values.
+         *
+         * Unless the option has been given another value type, its
+         * values get ValueType::CHOICE, and ArgumentValue::as_choice()
+         * returns the position of a value in @a values without
+         * comparing strings. When several arguments and options share
+         * a value, it is sufficient to set the choices on one of them,
+         * but they can't have different choices.
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        Option& choices(std::vector<std::string> values);
+
+        /**
+         * @brief Make the option's values key/value pairs, like the
+         *  values of a compiler's -D option.
+         *
+         * Sets the operation to APPEND. Every value must contain
+         * @a separator, the key is the text before the first
+         * @a separator and the value is the text after it. Values
+         * without @a separator are reported as errors by the parser.
+         *
+         * ParsedArguments::dictionary() returns the pairs with a hash
+         * table that finds a key's value without comparing it to the
+         * other keys.
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        Option& dictionary(char separator = '=');
+
+        /**
+         * @brief Write the option's values directly to @a variable
+         *  while the command line is parsed.
+         *
+         * @a variable can be a bool, any of the integer and floating
+         * point types that ArgumentValue can convert to, a std::string,
+         * or a std::vector of any of these except bool. The values are
+         * converted the same way as with value_type(), and invalid
+         * values are reported as errors by the parser.
+         *
+         * ASSIGN replaces the value of @a variable, APPEND adds values
+         * to vectors and replaces other values, and CLEAR empties
+         * vectors and gives other variables back the value they had
+         * when bind() was called. Every parse starts by giving all
+         * bound variables back that value.
+         *
+         * Bound values aren't stored in ParsedArguments: has() tells
+         * whether the option was given, but value() and values() return
+         * empty values. @a variable must exist for as long as the
+         * parser is used, and the parser can't parse several command
+         * lines at the same time (e.g. with parse_batch()).
+         *
+         * @return Reference to itself. This makes it possible to chain
+         *  method calls.
+         */
+        template <typename T>
+        Option& bind(T& variable) = delete;
+
         /**
          * @brief Set whether this option is optional or mandatory.
          *
@@ -2656,9 +3801,68 @@ namespace argos
     private:
         void check_option() const;
 
+        Option& set_binding(std::shared_ptr<ValueBinding> binding);
+
         std::unique_ptr<OptionData> m_option;
     };
 
+    template <>
+    Option& Option::bind<bool>(bool& variable);
+
+    template <>
+    Option& Option::bind<int>(int& variable);
+
+    template <>
+    Option& Option::bind<unsigned>(unsigned& variable);
+
+    template <>
+    Option& Option::bind<long>(long& variable);
+
+    template <>
+    Option& Option::bind<long long>(long long& variable);
+
+    template <>
+    Option& Option::bind<unsigned long>(unsigned long& variable);
+
+    template <>
+    Option& Option::bind<unsigned long long>(unsigned long long& variable);
+
+    template <>
+    Option& Option::bind<float>(float& variable);
+
+    template <>
+    Option& Option::bind<double>(double& variable);
+
+    template <>
+    Option& Option::bind<std::string>(std::string& variable);
+
+    template <>
+    Option& Option::bind<std::vector<int>>(std::vector<int>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<unsigned>>(std::vector<unsigned>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<long>>(std::vector<long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<long long>>(std::vector<long long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<unsigned long>>(std::vector<unsigned long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<unsigned long long>>(std::vector<unsigned long long>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<float>>(std::vector<float>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<double>>(std::vector<double>& variable);
+
+    template <>
+    Option& Option::bind<std::vector<std::string>>(std::vector<std::string>& variable);
+
     /**
      * @brief A convenient short alias for Option.
      */
@@ -2757,6 +3961,24 @@ namespace argos
          */
         Command& add(Argument&& argument);
 
+        /**
+         * @brief Add a new argument definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        Command& add(Argument& argument, ValueHandle& handle);
+
+        /**
+         * @brief Add a new argument definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        Command& add(Argument&& argument, ValueHandle& handle);
+
         /**
          * @brief Adds an option to the command.
          *
@@ -2773,6 +3995,24 @@ namespace argos
          */
         Command& add(Option&& option);
 
+        /**
+         * @brief Add a new option definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        Command& add(Option& option, ValueHandle& handle);
+
+        /**
+         * @brief Add a new option definition to the command and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        Command& add(Option&& option, ValueHandle& handle);
+
         /**
          * @brief Adds a sub-command to the command.
          *
@@ -2915,6 +4155,29 @@ namespace argos
          */
         Command& require_subcommand(bool value);
 
+        /**
+         * @brief Defer adding the command's arguments, options and
+         *  sub-commands until the command is needed.
+         *
+         * @a callback receives a new Command with the same name, and
+         * should add the arguments, options and sub-commands to it. It
+         * can also set allow_multiple_subcommands and require_subcommand.
+         * The name, texts, section, visibility and id must be set on this
+         * command, changes to them in @a callback are ignored.
+         *
+         * The callback is called the first time the parser selects the
+         * command, or when the command's help text, or the arguments,
+         * options or sub-commands of its CommandView are requested.
+         * Programs with a large number of sub-commands can use this to
+         * avoid constructing all of them when only one is used.
+         *
+         * Each CompiledParser calls @a callback at most once. The const
+         * versions of ArgumentParser::parse() make a new copy of the
+         * definitions for each call, and will therefore call it every
+         * time the command is used.
+         */
+        Command& lazy_definition(std::function<void(Command&)> callback);
+
         /**
          * @brief Add copies of all arguments, options and sub-commands in
          *  @a command.
@@ -2927,6 +4190,46 @@ namespace argos
          */
         Command& copy_from(Command& command);
 
+        /**
+         * @brief Allow at most one of the options and arguments in
+         *  @a names to be given.
+         *
+         * Options are identified by any of their flags, arguments by
+         * their name. The constraints are checked when the command's
+         * arguments and options have been parsed, and the parser
+         * reports an error if one of them is violated. Only the
+         * options and arguments that are given on the command line
+         * count, not initial values or values set by callbacks.
+         *
+         * @throw ArgosException if @a names has less than two names.
+         *  The names are verified when parsing starts.
+         */
+        Command& mutually_exclusive(std::vector<std::string> names);
+
+        /**
+         * @brief Require at least one of the options and arguments in
+         *  @a names to be given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        Command& at_least_one_of(std::vector<std::string> names);
+
+        /**
+         * @brief Require all the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        Command& depends_on(std::string name, std::vector<std::string> names);
+
+        /**
+         * @brief Allow none of the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        Command& conflicts_with(std::string name, std::vector<std::string> names);
+
         /**
          * @private
          * @brief Used internally in Argos.
@@ -2954,8 +4257,8 @@ namespace argos
 }
 
 //****************************************************************************
-// Copyright © 2020 Jan Erik Breimo. All rights reserved.
-// Created by Jan Erik Breimo on 2020-01-26.
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
 //
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
@@ -2963,36 +4266,673 @@ namespace argos
 
 /**
  * @file
- * @brief Defines the ArgumentParser class.
+ * @brief Defines the IncrementalParser class.
  */
-
 namespace argos
 {
+    class ArgumentIteratorImpl;
     struct ParserData;
 
     /**
-     * @brief This main class of Argos.
-     *
-     * Use this class to define the program's command line interface and
-     * parse the actual command line arguments.
+     * @brief The return value of IncrementalParser::next().
      */
-    class ArgumentParser
+    enum class IncrementalResult
     {
-    public:
-        ArgumentParser();
-
         /**
-         * @brief Creates a new argument parser.
-         *
-         * @param program_name The name of the program that will be displayed
-         *      in the help text and error messages.
-         * @param extract_file_name Set this to true if @a program_name is a
-         *      path that may contain directories, but the help text should
-         *      only use the file name part. This is particularly useful if
-         *      @a argv[0] is used as the program_name.
+         * @brief An argument, option or sub-command was processed.
          */
-        explicit ArgumentParser(std::string_view program_name,
-                                bool extract_file_name = true);
+        PROCESSED,
+        /**
+         * @brief More arguments are needed before the next argument or
+         *  option can be processed. Call IncrementalParser::push() or
+         *  IncrementalParser::finish() before calling next() again.
+         */
+        NEED_INPUT,
+        /**
+         * @brief All arguments and options have been processed.
+         */
+        DONE,
+        /**
+         * @brief The parser encountered an error.
+         */
+        FAILURE
+    };
+
+    /**
+     * @brief Parser created by CompiledParser that receives the command
+     *  line one argument at a time, and processes each argument as soon
+     *  as its meaning is known.
+     *
+     * This lets a program act on the first arguments of a long command
+     * line, e.g. one that is read from a pipe, before the rest of it
+     * has arrived. Arguments are added with push(), finish() tells the
+     * parser that there are no more, and next() returns the arguments
+     * and options in the same order as ArgumentIterator::next().
+     *
+     * Most arguments can be processed immediately, an option that
+     * takes a value must wait for the value. A command whose arguments
+     * have a variable count followed by other arguments, e.g.
+     * `FILE...` followed by `DEST`, is different: the argument that
+     * receives a value can depend on how many values follow it. Such
+     * values are held back until the parser can tell which argument
+     * they belong to, and the parser reports an error if that requires
+     * holding back more than max_lookahead() arguments.
+     *
+     * The parser is fully compatible with CompiledParser::parse(): the
+     * final result is the same as the one parse() returns for the
+     * complete command line.
+     */
+    class IncrementalParser
+    {
+    public:
+        /**
+         * @private
+         * @brief Constructs a new instance of IncrementalParser.
+         *
+         * Client code must use CompiledParser::make_incremental_parser().
+         */
+        explicit IncrementalParser(std::shared_ptr<const ParserData> parser_data);
+
+        /**
+         * @private
+         */
+        IncrementalParser(const IncrementalParser&) = delete;
+
+        /**
+         * @brief Moves the innards of the old object to the new one.
+         *
+         * Any attempt to use the old object will result in an exception.
+         */
+        IncrementalParser(IncrementalParser&&) noexcept;
+
+        ~IncrementalParser();
+
+        /**
+         * @private
+         */
+        IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+        /**
+         * @brief Moves the innards of the object on the right hand side
+         *      to the one on the left hand side.
+         *
+         * Any attempt to use the old object will result in an exception.
+         */
+        IncrementalParser& operator=(IncrementalParser&&) noexcept;
+
+        /**
+         * @brief Sets the maximum number of arguments that can be held
+         *  back while the parser waits to determine which argument the
+         *  first of them belongs to.
+         *
+         * The default is 1024.
+         */
+        IncrementalParser& max_lookahead(size_t n);
+
+        /**
+         * @brief Decides whether the values of arguments are stored in
+         *  parsed_arguments().
+         *
+         * The default is true. If it is false, the values of arguments
+         * are only available through next(), and the memory used by
+         * the parser doesn't grow with the number of arguments. The
+         * values of options are always stored.
+         */
+        IncrementalParser& store_argument_values(bool value);
+
+        /**
+         * @brief Adds the next argument of the command line.
+         *
+         * Arguments that are added after parsing has stopped, because
+         * of an error or an option like the help option, are added to
+         * the unprocessed arguments of parsed_arguments().
+         */
+        void push(std::string_view arg);
+
+        /**
+         * @brief Tells the parser that there are no more arguments.
+         */
+        void finish();
+
+        /**
+         * @brief Processes the next argument or option, if possible.
+         *
+         * @param arg The definition (ArgumentView, OptionView or
+         *      CommandView) of the processed argument, option or
+         *      sub-command. It is empty if the argument or option is
+         *      undefined, or if the result isn't PROCESSED.
+         * @param value As in ArgumentIterator::next(). The value remains
+         *      valid until the next call to next().
+         */
+        IncrementalResult next(std::unique_ptr<IArgumentView>& arg,
+                               std::string_view& value);
+
+        /**
+         * @brief Gives access to all the arguments and options processed
+         *      so far.
+         *
+         * The returned object belongs to the top-level command, the
+         * sub-commands are available through
+         * ParsedArguments::subcommands(). It is updated each time next()
+         * is called.
+         */
+        [[nodiscard]]
+        ParsedArguments parsed_arguments() const;
+    private:
+        ArgumentIteratorImpl& impl();
+
+        [[nodiscard]] const ArgumentIteratorImpl& impl() const;
+
+        std::unique_ptr<ArgumentIteratorImpl> m_impl;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+/**
+ * @file
+ * @brief Defines the ParseError and ParseResult classes.
+ */
+
+namespace argos
+{
+    struct CommandData;
+    struct ParserData;
+
+    /**
+     * @brief Describes the error that made CompiledParser::try_parse()
+     *  fail.
+     *
+     * Creating a ParseError is cheap, the error message is only
+     * formatted if message() or write() is called.
+     */
+    class ParseError
+    {
+    public:
+        /**
+         * @brief Creates an object that doesn't describe an error,
+         *  its code is NONE.
+         */
+        ParseError();
+
+        /**
+         * @private
+         * @brief For internal use only.
+         */
+        ParseError(ParseErrorCode code,
+                   std::string detail,
+                   ArgumentId argument_id,
+                   std::optional<size_t> token_index,
+                   const CommandData* command,
+                   std::shared_ptr<const ParserData> data);
+
+        /**
+         * @brief Returns true if there is an error, i.e. code() isn't
+         *  NONE.
+         */
+        explicit operator bool() const;
+
+        [[nodiscard]] ParseErrorCode code() const;
+
+        /**
+         * @brief Returns the position of the offending argument in the
+         *  arguments that were parsed.
+         *
+         * Errors that don't concern a particular argument, e.g. missing
+         * options, don't have a position. Arguments that were inserted
+         * by callbacks or read from response files are counted as if
+         * they had been part of the original arguments.
+         */
+        [[nodiscard]] std::optional<size_t> token_index() const;
+
+        /**
+         * @brief Returns the id of the argument or option the error
+         *  concerns, or 0 if it doesn't concern a particular one.
+         */
+        [[nodiscard]] ArgumentId argument_id() const;
+
+        /**
+         * @brief Returns the error message without the command and
+         *  argument names, e.g. "Invalid value: abc.".
+         */
+        [[nodiscard]] const std::string& detail() const;
+
+        /**
+         * @brief Returns the full error message, the same as the first
+         *  line parse() writes to the output stream.
+         */
+        [[nodiscard]] std::string message() const;
+
+        /**
+         * @brief Writes the error message and the command's usage to the
+         *  parser's output stream, the same way parse() does.
+         */
+        void write() const;
+    private:
+        /// Returns true if the message starts with the name of the
+        /// argument or option.
+        [[nodiscard]] bool has_argument_name() const;
+
+        ParseErrorCode m_code = ParseErrorCode::NONE;
+        ArgumentId m_argument_id = {};
+        std::optional<size_t> m_token_index;
+        std::string m_detail;
+        const CommandData* m_command = nullptr;
+        std::shared_ptr<const ParserData> m_data;
+    };
+
+    /**
+     * @brief The result of CompiledParser::try_parse(), either parsed
+     *  arguments or a ParseError.
+     *
+     * The interface mirrors the one of std::expected.
+     */
+    class ParseResult
+    {
+    public:
+        ParseResult();
+
+        /**
+         * @private
+         * @brief For internal use only.
+         */
+        ParseResult(ParsedArguments args, ParseError error);
+
+        /**
+         * @brief Returns true if the arguments were parsed without
+         *  errors.
+         */
+        [[nodiscard]] bool has_value() const;
+
+        /**
+         * @brief Same as has_value().
+         */
+        explicit operator bool() const;
+
+        /**
+         * @brief Returns the parsed arguments.
+         *
+         * If there was an error, the arguments are the ones that were
+         * processed before the error was found, and their result code
+         * is FAILURE.
+         */
+        [[nodiscard]] const ParsedArguments& value() const;
+
+        /**
+         * @brief Returns the error, its code is NONE if there was
+         *  no error.
+         */
+        [[nodiscard]] const ParseError& error() const;
+    private:
+        ParsedArguments m_args;
+        ParseError m_error;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+/**
+ * @file
+ * @brief Defines the CompiledParser class.
+ */
+
+namespace argos
+{
+    class ParsedArgumentsImpl;
+    struct ParserData;
+
+    /**
+     * @brief The outcome of parsing one of the command lines given to
+     *  CompiledParser::parse_batch().
+     */
+    struct BatchParseResult
+    {
+        ParserResultCode result_code = ParserResultCode::NONE;
+        /**
+         * @brief The error message if result_code is FAILURE.
+         *
+         * The message starts with the name of the command that failed,
+         * as the first line of the message parse() writes.
+         */
+        std::string error_message;
+    };
+
+    /**
+     * @brief A function that receives the index and the parsed arguments
+     *  of each command line parsed by CompiledParser::parse_batch().
+     */
+    using BatchParseCallback =
+        std::function<void(size_t index, const ParsedArguments& args)>;
+
+    /**
+     * @brief An immutable, fully initialized parser created by
+     *      ArgumentParser::compile().
+     *
+     * The definitions of options, arguments and sub-commands are finalized
+     * once, when the CompiledParser is created. Every call to parse() or
+     * make_iterator() after that shares the same definitions instead of
+     * copying them, which makes CompiledParser the preferred choice for
+     * programs that parse many command lines with the same parser.
+     *
+     * All member functions are const and a CompiledParser can be shared
+     * and used concurrently by any number of threads, provided the
+     * callbacks and output stream it was compiled with are thread-safe.
+     * The exception is a parser with options or arguments that are bound
+     * to variables with Option::bind() or Argument::bind(): every parse
+     * writes to the variables, so such a parser can only parse one
+     * command line at a time.
+     *
+     * Copying a CompiledParser is cheap; the copies share the same
+     * definitions.
+     */
+    class CompiledParser
+    {
+    public:
+        /**
+         * @private
+         * @brief For internal use only.
+         *
+         * Client code must use ArgumentParser::compile().
+         */
+        explicit CompiledParser(std::shared_ptr<const ParserData> data);
+
+        /**
+         * @brief Parses the arguments and options in argv.
+         *
+         * Unlike the non-const ArgumentParser::parse(), this function does
+         * not change the program name to argv[0].
+         */
+        [[nodiscard]] ParsedArguments parse(int argc, char* argv[]) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        [[nodiscard]]
+        ParsedArguments parse(std::vector<std::string_view> args) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @a args can be any contiguous range of char*, const char*,
+         * std::string_view or std::string, e.g. std::span<char*> or
+         * std::vector<std::string>. The arguments are read directly from
+         * @a args without being copied first.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParsedArguments parse(const Range& args) const
+        {
+            return parse_source(ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses the arguments and options in argv into
+         *  @a result.
+         *
+         * Same as parse(argc, argv), see parse_into(ParsedArguments&,
+         * const Range&).
+         */
+        void parse_into(ParsedArguments& result, int argc, char* argv[]) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args into
+         *  @a result, reusing the memory of its previous values.
+         *
+         * The result is the same as if parse(args) had been assigned to
+         * @a result. If @a result was returned by this parser, or by an
+         * earlier call to parse_into() with this parser, its buffers are
+         * cleared and reused instead of allocating new ones. A loop
+         * that parses command lines of similar size this way stops
+         * allocating memory after the first few iterations, with the
+         * exception of arguments that callbacks add.
+         *
+         * @a result is assigned new parsed arguments instead if
+         * copies of it, or of the ParsedArguments of its sub-commands,
+         * exist, as clearing it would change their values too.
+         */
+        template <ArgumentRange Range>
+        void parse_into(ParsedArguments& result, const Range& args) const
+        {
+            parse_source_into(result, ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses the arguments and options in argv without
+         *  writing to the output stream, exiting or throwing exceptions.
+         *
+         * See try_parse(const Range&).
+         */
+        [[nodiscard]] ParseResult try_parse(int argc, char* argv[]) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args without
+         *  writing to the output stream, exiting or throwing exceptions.
+         *
+         * See try_parse(const Range&).
+         */
+        [[nodiscard]]
+        ParseResult try_parse(std::vector<std::string_view> args) const;
+
+        /**
+         * @brief Parses the arguments and options in @a args without
+         *  writing to the output stream, exiting or throwing exceptions.
+         *
+         * Errors are returned as a ParseError regardless of the parser
+         * settings, and neither the error message nor the help text is
+         * formatted unless the program asks for it, which makes a
+         * failed parse about as fast as a successful one. The help
+         * text is not written when the help option is given either,
+         * the result code of the parsed arguments is STOP and the
+         * program can call write_help_text() itself.
+         *
+         * Errors that callbacks report with ParsedArgumentsBuilder::error()
+         * are returned too, with code ParseErrorCode::CALLBACK. If Argos
+         * is built without exception support, such errors are instead
+         * written to stderr and the program is aborted. Errors in the
+         * parser's definition, e.g. in a lazily defined sub-command, are
+         * not parse errors and are thrown as ArgosException.
+         *
+         * The returned ParsedArguments report errors in their values,
+         * e.g. from ArgumentValue::as_int(), the same way as those
+         * returned by parse().
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParseResult try_parse(const Range& args) const
+        {
+            return try_parse_source(ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses @a args into @a result like try_parse() does,
+         *  reusing the memory of its previous values.
+         *
+         * @a result is reused the same way as in parse_into().
+         *
+         * @return The error, if any.
+         */
+        template <ArgumentRange Range>
+        ParseError try_parse_into(ParsedArguments& result,
+                                  const Range& args) const
+        {
+            return try_parse_source_into(result, ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses each command line in @a command_lines on
+         *  @a thread_count threads.
+         *
+         * Nothing is written to the output stream and the program is
+         * never exited, regardless of the parser settings: errors
+         * are returned as BatchParseResult::error_message, and the
+         * help text is not written when the help option is given.
+         * The same goes for callbacks that use
+         * ParsedArgumentsBuilder::error() and
+         * ParsedArgumentsBuilder::stream().
+         *
+         * @param command_lines A random access range of command lines,
+         *  each one an ArgumentRange, e.g.
+         *  std::vector<std::vector<std::string>>. None of them should
+         *  have the name of the program as its first value. The
+         *  command lines must be stored in the range, views that create
+         *  them when they are read are not accepted as the arguments
+         *  are not copied.
+         * @param thread_count The number of threads, the number of
+         *  hardware threads if it is 0.
+         * @param callback If it is set, it is called with the parsed
+         *  arguments of each command line. The calls are made
+         *  concurrently from all the threads, in no particular order.
+         * @return The results in the same order as @a command_lines.
+         * @throw ArgosException if the parser has options or arguments
+         *  that are bound to variables, or if a command line uses a
+         *  lazily defined sub-command that binds variables and hasn't
+         *  been defined by an earlier parse.
+         */
+        template <std::ranges::random_access_range Range>
+            requires ArgumentRange<std::ranges::range_value_t<Range>>
+                     && std::is_reference_v<std::ranges::range_reference_t<const Range>>
+        [[nodiscard]] std::vector<BatchParseResult>
+        parse_batch(const Range& command_lines,
+                    unsigned thread_count = 0,
+                    const BatchParseCallback& callback = {}) const
+        {
+            std::vector<ArgumentSource> sources;
+            sources.reserve(std::ranges::size(command_lines));
+            for (const auto& args : command_lines)
+                sources.emplace_back(args);
+            return parse_batch_sources(sources, thread_count, callback);
+        }
+
+        /**
+         * @brief Creates an ArgumentIterator to iterate over the arguments
+         *      in argv.
+         */
+        [[nodiscard]]
+        ArgumentIterator make_iterator(int argc, char* argv[]) const;
+
+        /**
+         * @brief Creates an ArgumentIterator to iterate over the arguments
+         *      in @a args.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         */
+        [[nodiscard]]
+        ArgumentIterator make_iterator(std::vector<std::string_view> args) const;
+
+        /**
+         * @brief Creates an IncrementalParser that receives the
+         *  arguments one at a time.
+         */
+        [[nodiscard]] IncrementalParser make_incremental_parser() const;
+
+        /**
+         * @brief Return the program name.
+         */
+        [[nodiscard]] const std::string& program_name() const;
+
+        /**
+         * @brief Write the help text.
+         *
+         * @note The help text is printed automatically when the user gives
+         *  the help flag, this method is only needed if the program needs to
+         *  print it under other circumstances.
+         */
+        void write_help_text() const;
+
+        /**
+         * @brief Write the help text for the sub-command identified by
+         *      @a path.
+         *
+         * @param path The path to the sub-command.
+         */
+        void write_subcommand_help_text(const std::vector<std::string>& path) const;
+    private:
+        [[nodiscard]] ParsedArguments parse_source(ArgumentSource args) const;
+
+        void parse_source_into(ParsedArguments& result,
+                               ArgumentSource args) const;
+
+        [[nodiscard]] ParseResult try_parse_source(ArgumentSource args) const;
+
+        ParseError try_parse_source_into(ParsedArguments& result,
+                                         ArgumentSource args) const;
+
+        /**
+         * @brief Returns the ParsedArgumentsImpl of @a result, cleared,
+         *  if it can be reused, otherwise a new one.
+         */
+        [[nodiscard]] std::shared_ptr<ParsedArgumentsImpl>
+        reuse_or_create(ParsedArguments& result) const;
+
+        [[nodiscard]] std::vector<BatchParseResult>
+        parse_batch_sources(std::span<const ArgumentSource> sources,
+                            unsigned thread_count,
+                            const BatchParseCallback& callback) const;
+
+        std::shared_ptr<const ParserData> m_data;
+    };
+}
+
+//****************************************************************************
+// Copyright © 2020 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2020-01-26.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+
+/**
+ * @file
+ * @brief Defines the ArgumentParser class.
+ */
+
+namespace argos
+{
+    struct ParserData;
+
+    /**
+     * @brief This main class of Argos.
+     *
+     * Use this class to define the program's command line interface and
+     * parse the actual command line arguments.
+     */
+    class ArgumentParser
+    {
+    public:
+        ArgumentParser();
+
+        /**
+         * @brief Creates a new argument parser.
+         *
+         * @param program_name The name of the program that will be displayed
+         *      in the help text and error messages.
+         * @param extract_file_name Set this to true if @a program_name is a
+         *      path that may contain directories, but the help text should
+         *      only use the file name part. This is particularly useful if
+         *      @a argv[0] is used as the program_name.
+         */
+        explicit ArgumentParser(std::string_view program_name,
+                                bool extract_file_name = true);
 
         /**
          * @brief Moves the innards of the old object to the new one.
@@ -3041,6 +4981,24 @@ namespace argos
          */
         ArgumentParser& add(Argument&& argument);
 
+        /**
+         * @brief Add a new argument definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Argument& argument, ValueHandle& handle);
+
+        /**
+         * @brief Add a new argument definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the argument's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Argument&& argument, ValueHandle& handle);
+
         /**
          * @brief Add a new option definition to the ArgumentParser.
          *
@@ -3057,6 +5015,24 @@ namespace argos
          */
         ArgumentParser& add(Option&& option);
 
+        /**
+         * @brief Add a new option definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Option& option, ValueHandle& handle);
+
+        /**
+         * @brief Add a new option definition to the ArgumentParser and set
+         *  @a handle to refer to its value.
+         *
+         * @a handle can be used instead of the option's name with
+         * ParsedArguments.
+         */
+        ArgumentParser& add(Option&& option, ValueHandle& handle);
+
         /**
          * @brief Add a new sub-command definition to the ArgumentParser.
          *
@@ -3089,6 +5065,46 @@ namespace argos
          */
         ArgumentParser& copy_from(const Command& command);
 
+        /**
+         * @brief Allow at most one of the options and arguments in
+         *  @a names to be given.
+         *
+         * Options are identified by any of their flags, arguments by
+         * their name. The constraints are checked when the command's
+         * arguments and options have been parsed, and the parser
+         * reports an error if one of them is violated. Only the
+         * options and arguments that are given on the command line
+         * count, not initial values or values set by callbacks.
+         *
+         * @throw ArgosException if @a names has less than two names.
+         *  The names are verified when parsing starts.
+         */
+        ArgumentParser& mutually_exclusive(std::vector<std::string> names);
+
+        /**
+         * @brief Require at least one of the options and arguments in
+         *  @a names to be given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        ArgumentParser& at_least_one_of(std::vector<std::string> names);
+
+        /**
+         * @brief Require all the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        ArgumentParser& depends_on(std::string name, std::vector<std::string> names);
+
+        /**
+         * @brief Allow none of the options and arguments in @a names to
+         *  be given if the option or argument @a name is given.
+         *
+         * @throw ArgosException if @a names is empty.
+         */
+        ArgumentParser& conflicts_with(std::string name, std::vector<std::string> names);
+
         /**
          * @brief Parses the arguments and options in argv.
          *
@@ -3146,6 +5162,50 @@ namespace argos
         [[nodiscard]]
         ParsedArguments parse(std::vector<std::string_view> args) const;
 
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @a args can be any contiguous range of char*, const char*,
+         * std::string_view or std::string, e.g. std::span<char*> or
+         * std::vector<std::string>. The arguments are read directly from
+         * @a args without being copied first.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         *
+         * @note The ArgumentParser instance is no longer valid after calling
+         *      the non-const version of parse(). All method calls on an invalid
+         *      ArgumentParser will throw an exception.
+         *
+         * @throw ArgosException if there are two or more options that use
+         *      the same flag.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParsedArguments parse(const Range& args)
+        {
+            return parse_source(ArgumentSource(args));
+        }
+
+        /**
+         * @brief Parses the arguments and options in @a args.
+         *
+         * @a args can be any contiguous range of char*, const char*,
+         * std::string_view or std::string, e.g. std::span<char*> or
+         * std::vector<std::string>. The arguments are read directly from
+         * @a args without being copied first.
+         *
+         * @note @a args should not have the name of the program itself as its
+         *      first value, unlike when parse is called with argc and argv.
+         *
+         * @throw ArgosException if there are two or more options that use
+         *      the same flag.
+         */
+        template <ArgumentRange Range>
+        [[nodiscard]] ParsedArguments parse(const Range& args) const
+        {
+            return parse_source(ArgumentSource(args));
+        }
+
         /**
          * @brief Creates an ArgumentIterator to iterate over the arguments
          *      in argv.
@@ -3199,6 +5259,21 @@ namespace argos
         [[nodiscard]]
         ArgumentIterator make_iterator(std::vector<std::string_view> args) const;
 
+        /**
+         * @brief Creates an immutable CompiledParser with the current
+         *      definitions and settings.
+         *
+         * The definitions are copied and finalized once. Parsing with the
+         * CompiledParser avoids the per-call copying done by the const
+         * versions of parse() and make_iterator(), and the CompiledParser
+         * can be shared by multiple threads. Later changes to the
+         * ArgumentParser do not affect the CompiledParser.
+         *
+         * @throw ArgosException if there are two or more options that use
+         *      the same flag.
+         */
+        [[nodiscard]] CompiledParser compile() const;
+
         /**
          * @brief Returns true if the ArgumentParser allows abbreviated options.
          */
@@ -3217,6 +5292,22 @@ namespace argos
          */
         ArgumentParser& allow_abbreviated_options(bool value);
 
+        /**
+         * @brief Returns true if the ArgumentParser allows abbreviated
+         *      command names.
+         */
+        [[nodiscard]] bool allow_abbreviated_commands() const;
+
+        /**
+         * @brief Enable or disable abbreviated command names.
+         *
+         * When enabled, it is sufficient to type the number of leading
+         * characters of a command's name that is needed to uniquely
+         * identify it among its sibling commands. A name that matches a
+         * command exactly is never considered an abbreviation.
+         */
+        ArgumentParser& allow_abbreviated_commands(bool value);
+
         /**
          * @brief Returns true if the program automatically exits if the
          *      command line has invalid options or arguments, or the help
@@ -3341,6 +5432,29 @@ namespace argos
          */
         ArgumentParser& ignore_undefined_options(bool value);
 
+        /**
+         * @brief Returns true if arguments starting with '@' are read as
+         *      names of response files.
+         */
+        [[nodiscard]] bool allow_response_files() const;
+
+        /**
+         * @brief Enable or disable reading arguments from response files.
+         *
+         * If this property is true, an argument "@FILE" is replaced by the
+         * arguments in FILE. The arguments are separated by whitespace,
+         * single and double quotes can be used for arguments containing
+         * whitespace, and a backslash makes the next character a normal
+         * character. Response files can themselves contain "@FILE"
+         * arguments, but not refer back to a file that is already being
+         * read. An argument "@FILE" where FILE can't be opened is kept as
+         * a normal argument.
+         *
+         * The files are memory-mapped, and the arguments are read
+         * directly from the mapped memory.
+         */
+        ArgumentParser& allow_response_files(bool value);
+
         /**
          * @brief Returns the callback function that will be called for every
          *      argument.
@@ -3527,6 +5641,10 @@ namespace argos
          */
         ArgumentParser&& move();
     private:
+        ParsedArguments parse_source(ArgumentSource args);
+
+        [[nodiscard]] ParsedArguments parse_source(ArgumentSource args) const;
+
         void check_data() const;
 
         std::unique_ptr<ParserData> m_data;
@@ -8,8 +8,34 @@
 #pragma once
 #include "Argos/ArgosException.hpp"
 
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+    #define ARGOS_EXCEPTIONS 1
+#else
+    #define ARGOS_EXCEPTIONS 0
+    #include <cstdio>
+    #include <cstdlib>
+#endif
+
+namespace argos
+{
+    /**
+     * @brief Throws @a ex, or writes its message to stderr and aborts
+     *  the program if exceptions are disabled.
+     */
+    [[noreturn]] inline void throw_exception(const ArgosException& ex)
+    {
+#if ARGOS_EXCEPTIONS
+        throw ex;
+#else
+        std::fputs(ex.what(), stderr);
+        std::fputc('\n', stderr);
+        std::abort();
+#endif
+    }
+}
+
 #define _ARGOS_THROW_3(file, line, msg) \
-    throw ::argos::ArgosException(file ":" #line ": " msg)
+    ::argos::throw_exception(::argos::ArgosException(file ":" #line ": " msg))
 
 #define _ARGOS_THROW_2(file, line, msg) \
     _ARGOS_THROW_3(file, line, msg)
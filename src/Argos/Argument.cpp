@@ -9,6 +9,7 @@
 
 #include "ArgosThrow.hpp"
 #include "ArgumentData.hpp"
+#include "ValueBinding.hpp"
 
 namespace argos
 {
@@ -144,6 +145,57 @@ namespace argos
         return *this;
     }
 
+    Argument& Argument::value_type(ValueType type)
+    {
+        check_argument();
+        m_argument->value_type = type;
+        return *this;
+    }
+
+    Argument& Argument::choices(std::vector<std::string> values)
+    {
+        check_argument();
+        m_argument->choices = ChoiceSet(std::move(values));
+        return *this;
+    }
+
+    Argument& Argument::set_binding(std::shared_ptr<ValueBinding> binding)
+    {
+        check_argument();
+        m_argument->value_type = binding->value_type();
+        m_argument->binding = std::move(binding);
+        return *this;
+    }
+
+#define ARGOS_DEFINE_BIND(type) \
+    template <> \
+    Argument& Argument::bind<type>(type& variable) \
+    { \
+        return set_binding(make_binding(variable)); \
+    }
+
+    ARGOS_DEFINE_BIND(bool)
+    ARGOS_DEFINE_BIND(int)
+    ARGOS_DEFINE_BIND(unsigned)
+    ARGOS_DEFINE_BIND(long)
+    ARGOS_DEFINE_BIND(long long)
+    ARGOS_DEFINE_BIND(unsigned long)
+    ARGOS_DEFINE_BIND(unsigned long long)
+    ARGOS_DEFINE_BIND(float)
+    ARGOS_DEFINE_BIND(double)
+    ARGOS_DEFINE_BIND(std::string)
+    ARGOS_DEFINE_BIND(std::vector<int>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned>)
+    ARGOS_DEFINE_BIND(std::vector<long>)
+    ARGOS_DEFINE_BIND(std::vector<long long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long long>)
+    ARGOS_DEFINE_BIND(std::vector<float>)
+    ARGOS_DEFINE_BIND(std::vector<double>)
+    ARGOS_DEFINE_BIND(std::vector<std::string>)
+
+#undef ARGOS_DEFINE_BIND
+
     std::unique_ptr<ArgumentData> Argument::release()
     {
         check_argument();
@@ -7,6 +7,8 @@
 //****************************************************************************
 #include "ArgumentCounter.hpp"
 
+#include <algorithm>
+
 namespace argos
 {
     namespace
@@ -44,9 +46,10 @@ namespace argos
             }
         }
 
-        std::vector<std::pair<size_t, const ArgumentData*>>
-        make_argument_counters(const CommandData& command,
-                               size_t n)
+        void make_argument_counters(
+            const CommandData& command,
+            size_t n,
+            std::vector<std::pair<size_t, const ArgumentData*>>& counters)
         {
             const auto [lo, hi] = ArgumentCounter::get_min_max_count(command);
             if (n < lo)
@@ -56,25 +59,23 @@ namespace argos
             else
                 n -= lo;
 
-            std::vector<std::pair<size_t, const ArgumentData*>> result;
             for (auto& arg : command.arguments)
             {
                 if (n == 0 || arg->min_count == arg->max_count)
                 {
-                    result.emplace_back(arg->min_count, arg.get());
+                    counters.emplace_back(arg->min_count, arg.get());
                 }
                 else if (arg->min_count + n <= arg->max_count)
                 {
-                    result.emplace_back(arg->min_count + n, arg.get());
+                    counters.emplace_back(arg->min_count + n, arg.get());
                     n = 0;
                 }
                 else
                 {
-                    result.emplace_back(arg->max_count, arg.get());
+                    counters.emplace_back(arg->max_count, arg.get());
                     n -= arg->max_count - arg->min_count;
                 }
             }
-            return result;
         }
     }
 
@@ -85,22 +86,55 @@ namespace argos
 
     ArgumentCounter::ArgumentCounter(const CommandData& command)
     {
-        make_argument_counters(command, m_counters, m_first_optional);
+        reset(command);
     }
 
     ArgumentCounter::ArgumentCounter(const CommandData& command,
                                      size_t argument_count,
                                      size_t initial_count)
-        : m_counters(make_argument_counters(command, argument_count)),
-          m_first_optional(m_counters.size())
     {
-        for (size_t i = 0; i < initial_count; ++i)
+        reset(command, argument_count, initial_count);
+    }
+
+    void ArgumentCounter::reset(const CommandData& command)
+    {
+        clear();
+        make_argument_counters(command, m_counters, m_first_optional);
+    }
+
+    void ArgumentCounter::reset(const CommandData& command,
+                                size_t argument_count,
+                                size_t initial_count)
+    {
+        clear();
+        make_argument_counters(command, argument_count, m_counters);
+        m_first_optional = m_counters.size();
+
+        // Equivalent to calling next_argument() initial_count times, but
+        // without iterating over every single argument.
+        while (initial_count != 0)
         {
-            if (next_argument() == nullptr)
+            while (m_index != m_counters.size() && m_counters[m_index].first == 0)
+                ++m_index;
+
+            if (m_index == m_counters.size())
                 break;
+
+            const auto n = std::min(initial_count, m_counters[m_index].first);
+            m_counters[m_index].first -= n;
+            m_counter += n;
+            initial_count -= n;
         }
     }
 
+    void ArgumentCounter::clear()
+    {
+        m_counters.clear();
+        m_index = 0;
+        m_first_optional = 0;
+        m_counter = 0;
+    }
+
     const ArgumentData* ArgumentCounter::next_argument()
     {
         while (m_index != m_counters.size() && m_counters[m_index].first == 0)
@@ -156,4 +190,34 @@ namespace argos
         }
         return false;
     }
+
+    const ArgumentData*
+    ArgumentCounter::find_argument(const CommandData& command,
+                                   size_t argument_count,
+                                   size_t ordinal)
+    {
+        // Distributes the values the same way as make_argument_counters().
+        const auto [lo, hi] = get_min_max_count(command);
+        size_t n = 0;
+        if (argument_count > hi)
+            n = hi - lo;
+        else if (argument_count > lo)
+            n = argument_count - lo;
+
+        for (auto& arg : command.arguments)
+        {
+            size_t count = arg->min_count;
+            if (n != 0 && arg->min_count != arg->max_count)
+            {
+                const auto extra = std::min<size_t>(
+                    n, arg->max_count - arg->min_count);
+                count += extra;
+                n -= extra;
+            }
+            if (ordinal < count)
+                return arg.get();
+            ordinal -= count;
+        }
+        return nullptr;
+    }
 }
@@ -23,6 +23,26 @@ namespace argos
                         size_t argument_count,
                         size_t initial_count = 0);
 
+        /**
+         * @brief Same as assigning ArgumentCounter(command), but reuses
+         *  the memory of the current counters.
+         */
+        void reset(const CommandData& command);
+
+        /**
+         * @brief Same as assigning ArgumentCounter(command,
+         *  argument_count, initial_count), but reuses the memory of the
+         *  current counters.
+         */
+        void reset(const CommandData& command,
+                   size_t argument_count,
+                   size_t initial_count = 0);
+
+        /**
+         * @brief Removes all counters, but keeps their memory.
+         */
+        void clear();
+
         const ArgumentData* next_argument();
 
         [[nodiscard]] size_t count() const;
@@ -34,6 +54,19 @@ namespace argos
 
         static bool requires_argument_count(const CommandData& command);
 
+        /**
+         * @brief Returns the argument that receives the value at
+         *  @a ordinal if @a command receives @a argument_count values,
+         *  or nullptr if no argument receives it.
+         *
+         * The result for a given @a ordinal can only change from one
+         * argument to an earlier one as @a argument_count increases.
+         */
+        static const ArgumentData*
+        find_argument(const CommandData& command,
+                      size_t argument_count,
+                      size_t ordinal);
+
     private:
         using Counter = std::pair<size_t, const ArgumentData*>;
         std::vector<Counter> m_counters;
@@ -6,13 +6,17 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory>
 #include <string>
 #include "Argos/Callbacks.hpp"
 #include "Argos/Enums.hpp"
+#include "ChoiceSet.hpp"
 #include "TextSource.hpp"
 
 namespace argos
 {
+    class ValueBinding;
+
     struct ArgumentData
     {
         std::string name;
@@ -22,6 +26,9 @@ namespace argos
         ArgumentCallback callback;
         unsigned min_count = 1;
         unsigned max_count = 1;
+        ValueType value_type = ValueType::STRING;
+        ChoiceSet choices;
+        std::shared_ptr<ValueBinding> binding;
         Visibility visibility = Visibility::NORMAL;
         int id = 0;
         ValueId value_id = {};
@@ -0,0 +1,92 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Argos/ArgumentDictionary.hpp"
+
+#include "HashSlots.hpp"
+#include "StringUtilities.hpp"
+
+namespace argos
+{
+    ArgumentDictionary::ArgumentDictionary() = default;
+
+    ArgumentDictionary::ArgumentDictionary(
+            std::span<const std::pair<std::string_view, ArgumentId>> values,
+            char separator)
+    {
+        if (values.empty())
+            return;
+
+        m_entries.reserve(values.size());
+        init_hash_slots(m_table, values.size());
+        for (const auto& [value, _] : values)
+        {
+            const auto pos = value.find(separator);
+            const auto key = value.substr(0, pos);
+            const auto text = pos == std::string_view::npos
+                                  ? std::string_view()
+                                  : value.substr(pos + 1);
+            const auto h = hash_string(key);
+            if (const auto index = find(key, h))
+            {
+                m_entries[*index].second = text;
+                continue;
+            }
+
+            insert_hash_slot(m_table, h, m_entries.size());
+            m_entries.emplace_back(key, text);
+        }
+    }
+
+    size_t ArgumentDictionary::size() const
+    {
+        return m_entries.size();
+    }
+
+    bool ArgumentDictionary::empty() const
+    {
+        return m_entries.empty();
+    }
+
+    std::optional<std::string_view>
+    ArgumentDictionary::lookup(std::string_view key) const
+    {
+        if (const auto index = find(key, hash_string(key)))
+            return m_entries[*index].second;
+        return {};
+    }
+
+    bool ArgumentDictionary::contains(std::string_view key) const
+    {
+        return find(key, hash_string(key)).has_value();
+    }
+
+    const std::vector<ArgumentDictionary::Entry>&
+    ArgumentDictionary::entries() const
+    {
+        return m_entries;
+    }
+
+    ArgumentDictionary::const_iterator ArgumentDictionary::begin() const
+    {
+        return m_entries.begin();
+    }
+
+    ArgumentDictionary::const_iterator ArgumentDictionary::end() const
+    {
+        return m_entries.end();
+    }
+
+    std::optional<size_t>
+    ArgumentDictionary::find(std::string_view key, uint32_t hash) const
+    {
+        return find_hash_slot(m_table, hash, [&](size_t i)
+        {
+            return m_entries[i].first == key;
+        });
+    }
+}
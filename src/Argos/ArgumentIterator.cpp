@@ -13,7 +13,7 @@
 namespace argos
 {
     ArgumentIterator::ArgumentIterator(std::vector<std::string_view> args,
-                                       std::shared_ptr<ParserData> parser_data)
+                                       std::shared_ptr<const ParserData> parser_data)
         : m_impl(std::make_unique<ArgumentIteratorImpl>(std::move(args),
                                                         std::move(parser_data)))
     {}
@@ -34,35 +34,7 @@ namespace argos
     bool ArgumentIterator::next(std::unique_ptr<IArgumentView>& arg,
                                 std::string_view& value)
     {
-        const auto res = impl().next();
-        switch (std::get<0>(res))
-        {
-        case IteratorResultCode::ARGUMENT:
-            arg = std::make_unique<ArgumentView>(
-                    std::get<const ArgumentData*>(std::get<1>(res)));
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::OPTION:
-            arg = std::make_unique<OptionView>(
-                    std::get<const OptionData*>(std::get<1>(res)));
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::COMMAND:
-            arg = std::make_unique<CommandView>(
-                    std::get<const CommandData*>(std::get<1>(res)));
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::UNKNOWN:
-            arg = {};
-            value = std::get<2>(res);
-            return true;
-        case IteratorResultCode::DONE:
-        case IteratorResultCode::ERROR:
-            break;
-        }
-        arg = {};
-        value = {};
-        return false;
+        return get_result_view(impl().next(), arg, value);
     }
 
     ParsedArguments ArgumentIterator::parsed_arguments() const
@@ -8,6 +8,8 @@
 #include "ArgumentIteratorImpl.hpp"
 
 #include <algorithm>
+#include <utility>
+#include "Argos/CommandView.hpp"
 #include "ArgosThrow.hpp"
 #include "HelpText.hpp"
 #include "StringUtilities.hpp"
@@ -17,7 +19,7 @@ namespace argos
 {
     namespace
     {
-        bool is_option(const std::string& s, OptionStyle style)
+        bool is_option(std::string_view s, OptionStyle style)
         {
             if (s.size() < 2)
                 return false;
@@ -26,58 +28,127 @@ namespace argos
         }
 
         std::variant<OptionIterator, StandardOptionIterator>
-        make_option_iterator(OptionStyle style,
-                             std::vector<std::string_view> args)
+        make_option_iterator(OptionStyle style, ArgumentSource args)
         {
             switch (style)
             {
             case OptionStyle::SLASH:
-                return OptionIterator(std::move(args), '/');
+                return OptionIterator(args, '/');
             case OptionStyle::DASH:
-                return OptionIterator(std::move(args), '-');
+                return OptionIterator(args, '-');
             default:
-                return StandardOptionIterator(std::move(args));
+                return StandardOptionIterator(args);
             }
         }
+
+        thread_local size_t scanned_arguments = 0;
+    }
+
+    bool get_result_view(const IteratorResult& result,
+                         std::unique_ptr<IArgumentView>& arg,
+                         std::string_view& value)
+    {
+        switch (std::get<0>(result))
+        {
+        case IteratorResultCode::ARGUMENT:
+            arg = std::make_unique<ArgumentView>(
+                    std::get<const ArgumentData*>(std::get<1>(result)));
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::OPTION:
+            arg = std::make_unique<OptionView>(
+                    std::get<const OptionData*>(std::get<1>(result)));
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::COMMAND:
+            arg = std::make_unique<CommandView>(
+                    std::get<const CommandData*>(std::get<1>(result)));
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::UNKNOWN:
+            arg = {};
+            value = std::get<2>(result);
+            return true;
+        case IteratorResultCode::DONE:
+        case IteratorResultCode::ERROR:
+        case IteratorResultCode::INCOMPLETE:
+            break;
+        }
+        arg = {};
+        value = {};
+        return false;
     }
 
-    ArgumentIteratorImpl::ArgumentIteratorImpl(std::vector<std::string_view> args,
-                                               std::shared_ptr<ParserData> data)
-        : m_data(std::move(data)),
+    ArgumentIteratorImpl::ArgumentIteratorImpl(ArgumentSource args,
+                                               std::shared_ptr<const ParserData> data)
+        : ArgumentIteratorImpl({}, args, std::move(data))
+    {}
+
+    ArgumentIteratorImpl::ArgumentIteratorImpl(std::shared_ptr<const ParserData> data)
+        : ArgumentIteratorImpl({}, {}, std::move(data))
+    {
+        m_stream = std::make_unique<ArgumentStream>();
+    }
+
+    ArgumentIteratorImpl::ArgumentIteratorImpl(const std::vector<std::string_view>& args,
+                                               std::shared_ptr<const ParserData> data)
+        : ArgumentIteratorImpl(std::vector<std::string>(args.begin(), args.end()),
+                               {}, std::move(data))
+    {}
+
+    ArgumentIteratorImpl::ArgumentIteratorImpl(std::vector<std::string> owned_args,
+                                               ArgumentSource args,
+                                               std::shared_ptr<const ParserData> data,
+                                               std::shared_ptr<ParsedArgumentsImpl> result,
+                                               bool silent)
+        : m_owned_args(std::move(owned_args)),
+          m_data(std::move(data)),
+          m_silent(silent),
           m_command(&m_data->command),
-          m_parsed_args{std::make_shared<ParsedArgumentsImpl>(m_command, m_data)},
+          m_toplevel(result
+                         ? std::move(result)
+                         : std::make_shared<ParsedArgumentsImpl>(m_command,
+                                                                 m_data)),
+          m_parsed_args(m_toplevel->iterator_buffers().parsed_args),
           m_iterator{
               make_option_iterator(m_data->parser_settings.option_style,
-                                   std::move(args))
-          }
+                                   expand_response_files(
+                                       m_owned_args.empty()
+                                           ? args
+                                           : ArgumentSource(m_owned_args)))
+          },
+          m_argument_counter(m_toplevel->iterator_buffers().argument_counter),
+          m_sibling_ordinals(m_toplevel->iterator_buffers().sibling_ordinals)
     {
+        m_parsed_args.assign(1, m_toplevel);
+        m_sibling_ordinals.clear();
         auto& parsed_args = *parsed_arguments();
-        for (const auto& option : m_command->options)
-        {
-            if (!option->initial_value.empty())
-            {
-                parsed_args.append_value(option->value_id,
-                                         option->initial_value,
-                                         option->argument_id);
-            }
-        }
+        parsed_args.set_silent(m_silent);
+        const auto source = m_iterator.remaining_arguments();
+        size_t text_size = 0;
+        for (size_t i = 0; i < source.size(); ++i)
+            text_size += source[i].size();
+        parsed_args.reserve(source.size(), text_size);
+        // Bound variables must not keep the values of the previous parse.
+        m_data->bindings.reset();
+        parsed_args.add_initial_values();
 
-        if (!ArgumentCounter::requires_argument_count(*m_command))
-        {
-            m_argument_counter = ArgumentCounter(*m_command);
-        }
-        else
-        {
-            m_argument_counter = ArgumentCounter(*m_command,
-                                                 count_arguments());
-        }
+        count_arguments();
+    }
+
+    ArgumentIteratorImpl::~ArgumentIteratorImpl()
+    {
+        // The buffers belong to m_toplevel, which must not keep a
+        // reference to itself when the iterator is gone.
+        m_parsed_args.clear();
     }
 
     std::shared_ptr<ParsedArgumentsImpl>
-    ArgumentIteratorImpl::parse(std::vector<std::string_view> args,
-                                const std::shared_ptr<ParserData>& data)
+    ArgumentIteratorImpl::parse(ArgumentSource args,
+                                const std::shared_ptr<const ParserData>& data,
+                                std::shared_ptr<ParsedArgumentsImpl> result)
     {
-        ArgumentIteratorImpl iterator(std::move(args), data);
+        ArgumentIteratorImpl iterator({}, args, data, std::move(result));
         while (true)
         {
             const auto code = std::get<0>(iterator.next());
@@ -90,6 +161,49 @@ namespace argos
         return iterator.toplevel_parsed_arguments();
     }
 
+    std::shared_ptr<ParsedArgumentsImpl>
+    ArgumentIteratorImpl::parse_silently(ArgumentSource args,
+                                         const std::shared_ptr<const ParserData>& data,
+                                         std::shared_ptr<ParsedArgumentsImpl> result,
+                                         ParseError& error)
+    {
+        ArgumentIteratorImpl iterator({}, args, data, std::move(result), true);
+#if ARGOS_EXCEPTIONS
+        try
+        {
+#endif
+            while (true)
+            {
+                const auto code = std::get<0>(iterator.next());
+                if (code == IteratorResultCode::ERROR
+                    || code == IteratorResultCode::DONE)
+                {
+                    break;
+                }
+            }
+#if ARGOS_EXCEPTIONS
+        }
+        catch (const ArgosException&)
+        {
+            // Only errors from ParsedArgumentsBuilder::error() in a
+            // callback, or from the callback's attempt to read an invalid
+            // value, are parse errors. Others, e.g. errors in the
+            // definition of a lazily defined sub-command, are passed on.
+            auto silent_error = iterator.parsed_arguments()->silent_error();
+            if (!silent_error)
+                throw;
+            iterator.error(ParseErrorCode::CALLBACK,
+                           silent_error->first, silent_error->second);
+        }
+#endif
+        error = std::move(iterator.m_error);
+        // Errors in the values that are read after parsing, e.g. from
+        // ArgumentValue::as_int(), are reported the usual way.
+        auto parsed_args = iterator.toplevel_parsed_arguments();
+        parsed_args->set_silent(false);
+        return parsed_args;
+    }
+
     IteratorResult ArgumentIteratorImpl::next()
     {
         if (m_state == State::ERROR)
@@ -97,6 +211,20 @@ namespace argos
         if (m_state == State::DONE)
             return {IteratorResultCode::DONE, {}, {}};
 
+        if (!m_pending_error.empty())
+        {
+            error(ParseErrorCode::RESPONSE_FILE,
+                  std::exchange(m_pending_error, {}));
+            return {IteratorResultCode::ERROR, {}, {}};
+        }
+
+        if (m_stream && !prepare_stream_argument())
+        {
+            if (m_state == State::ERROR)
+                return {IteratorResultCode::ERROR, {}, {}};
+            return {IteratorResultCode::INCOMPLETE, {}, {}};
+        }
+
         const auto arg = m_state == State::ARGUMENTS_AND_OPTIONS
                              ? m_iterator.next()
                              : m_iterator.next_value();
@@ -118,17 +246,73 @@ namespace argos
             return process_argument(*arg);
         }
         else if (auto cmd = m_command->find_command(
-            *arg, m_data->parser_settings.case_insensitive))
+            *arg, m_data->parser_settings.allow_abbreviated_commands))
         {
             return process_command(cmd);
         }
         else
         {
-            error("Unknown command: " + std::string(*arg));
+            error(ParseErrorCode::UNKNOWN_COMMAND,
+                  "Unknown command: " + std::string(*arg), {},
+                  m_iterator.index());
             return {IteratorResultCode::ERROR, {}, {}};
         }
     }
 
+    void ArgumentIteratorImpl::push(std::string_view arg)
+    {
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        if (m_stream->finished)
+            ARGOS_THROW("Arguments can't be added after finish().");
+
+        if (m_state == State::DONE || m_state == State::ERROR)
+        {
+            // The same as copy_remaining_arguments_to_parser_result()
+            // would have done if the argument had arrived earlier.
+            parsed_arguments()->add_unprocessed_argument(arg);
+            return;
+        }
+
+        const ArgumentSource source(&arg, 1);
+        if (m_data->parser_settings.allow_response_files
+            && ResponseFiles::has_response_files(source))
+        {
+            ResponseFiles files;
+            if (!files.expand(source) && m_pending_error.empty())
+                m_pending_error = files.error_message();
+            const auto args = files.arguments();
+            for (size_t i = 0; i < args.size(); ++i)
+                m_stream->arguments.emplace_back(args[i]);
+        }
+        else
+        {
+            m_stream->arguments.emplace_back(arg);
+        }
+        m_stream->window_is_outdated = true;
+    }
+
+    void ArgumentIteratorImpl::finish()
+    {
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        m_stream->finished = true;
+    }
+
+    void ArgumentIteratorImpl::set_max_lookahead(size_t max_lookahead)
+    {
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        m_stream->max_lookahead = max_lookahead;
+    }
+
+    void ArgumentIteratorImpl::set_store_argument_values(bool store)
+    {
+        if (!m_stream)
+            ARGOS_THROW("This iterator doesn't receive arguments one at a time.");
+        m_stream->store_argument_values = store;
+    }
+
     const std::shared_ptr<ParsedArgumentsImpl>&
     ArgumentIteratorImpl::parsed_arguments() const
     {
@@ -138,14 +322,20 @@ namespace argos
     const std::shared_ptr<ParsedArgumentsImpl>&
     ArgumentIteratorImpl::toplevel_parsed_arguments() const
     {
-        return m_parsed_args.front();
+        return m_toplevel;
+    }
+
+    size_t ArgumentIteratorImpl::scanned_argument_count()
+    {
+        return scanned_arguments;
     }
 
     std::pair<ArgumentIteratorImpl::OptionResult, std::string_view>
     ArgumentIteratorImpl::process_option(const OptionData& opt,
-                                         const std::string& flag)
+                                         std::string_view flag)
     {
         const auto& parsed_args = parsed_arguments();
+        parsed_args->set_given(opt.argument_id);
         std::string_view arg;
         switch (opt.operation)
         {
@@ -157,12 +347,23 @@ namespace argos
             }
             else if (const auto value = m_iterator.next_value())
             {
-                arg = parsed_args->assign_value(opt.value_id, *value,
-                                                opt.argument_id);
+                const auto stored = parsed_args->assign_value(
+                    opt.value_id, *value, opt.argument_id);
+                if (!stored)
+                {
+                    error(ParseErrorCode::INVALID_VALUE,
+                          "Invalid value: " + std::string(*value) + ".",
+                          opt.argument_id, m_iterator.index());
+                    return {OptionResult::ERROR, {}};
+                }
+                arg = *stored;
             }
             else
             {
-                error(flag + ": no value given.");
+                // next_value() has moved past the flag.
+                error(ParseErrorCode::MISSING_VALUE,
+                      std::string(flag) + ": no value given.", {},
+                      m_iterator.index() - 1);
                 return {OptionResult::ERROR, {}};
             }
             break;
@@ -174,12 +375,23 @@ namespace argos
             }
             else if (const auto value = m_iterator.next_value())
             {
-                arg = parsed_args->append_value(opt.value_id, *value,
-                                                opt.argument_id);
+                const auto stored = parsed_args->append_value(
+                    opt.value_id, *value, opt.argument_id);
+                if (!stored)
+                {
+                    error(ParseErrorCode::INVALID_VALUE,
+                          "Invalid value: " + std::string(*value) + ".",
+                          opt.argument_id, m_iterator.index());
+                    return {OptionResult::ERROR, {}};
+                }
+                arg = *stored;
             }
             else
             {
-                error(flag + ": no value given.");
+                // next_value() has moved past the flag.
+                error(ParseErrorCode::MISSING_VALUE,
+                      std::string(flag) + ": no value given.", {},
+                      m_iterator.index() - 1);
                 return {OptionResult::ERROR, {}};
             }
             break;
@@ -208,7 +420,8 @@ namespace argos
         case OptionType::NORMAL:
             return {OptionResult::NORMAL, arg};
         case OptionType::HELP:
-            write_help_text(*m_data, *m_command);
+            if (!m_silent)
+                write_help_text(*m_data, *m_command);
             [[fallthrough]];
         case OptionType::EXIT:
             m_state = State::DONE;
@@ -229,21 +442,21 @@ namespace argos
     }
 
     IteratorResult
-    ArgumentIteratorImpl::process_option(const std::string& flag)
+    ArgumentIteratorImpl::process_option(std::string_view flag)
     {
         auto option = m_command->find_option(
             flag,
-            m_data->parser_settings.allow_abbreviated_options,
-            m_data->parser_settings.case_insensitive);
+            m_data->parser_settings.allow_abbreviated_options);
         if (option)
         {
             auto [res, arg] = process_option(*option, flag);
             switch (res)
             {
             case OptionResult::EXIT:
-                if (m_data->parser_settings.auto_exit)
+                if (auto_exit())
                     exit(m_data->parser_settings.normal_exit_code);
                 copy_remaining_arguments_to_parser_result();
+                finish_parsed_arguments();
                 return {IteratorResultCode::OPTION, option, arg};
             case OptionResult::ERROR:
                 return {IteratorResultCode::ERROR, option, {}};
@@ -260,6 +473,7 @@ namespace argos
                 [[fallthrough]];
             case OptionResult::STOP:
                 copy_remaining_arguments_to_parser_result();
+                finish_parsed_arguments();
                 [[fallthrough]];
             default:
                 return {IteratorResultCode::OPTION, option, arg};
@@ -268,19 +482,20 @@ namespace argos
         if (!m_data->parser_settings.ignore_undefined_options
             || !starts_with(m_iterator.current(), flag))
         {
-            error("Unknown option: " + std::string(m_iterator.current()));
+            error(ParseErrorCode::UNKNOWN_OPTION,
+                  "Unknown option: " + std::string(m_iterator.current()), {},
+                  m_iterator.index());
             return {IteratorResultCode::ERROR, {}, {}};
         }
         else
         {
-            parsed_arguments()->add_unprocessed_argument(
-                std::string(m_iterator.current()));
+            parsed_arguments()->add_unprocessed_argument(m_iterator.current());
             return {IteratorResultCode::UNKNOWN, {}, m_iterator.current()};
         }
     }
 
     IteratorResult
-    ArgumentIteratorImpl::process_argument(const std::string& value)
+    ArgumentIteratorImpl::process_argument(std::string_view value)
     {
         const auto& parsed_args = parsed_arguments();
         if (auto [next_cmd, i] = find_sibling_command(value); next_cmd)
@@ -290,8 +505,22 @@ namespace argos
         }
         if (auto argument = m_argument_counter.next_argument())
         {
-            auto s = parsed_args->append_value(argument->value_id, value,
-                                               argument->argument_id);
+            parsed_args->set_given(argument->argument_id);
+            auto s = value;
+            if (!m_stream || m_stream->store_argument_values
+                || argument->binding)
+            {
+                const auto stored = parsed_args->append_value(
+                    argument->value_id, value, argument->argument_id);
+                if (!stored)
+                {
+                    error(ParseErrorCode::INVALID_VALUE,
+                          "Invalid value: " + std::string(value) + ".",
+                          argument->argument_id, m_iterator.index());
+                    return {IteratorResultCode::ERROR, argument, {}};
+                }
+                s = *stored;
+            }
             if (argument->callback)
             {
                 CallbackArguments args(ArgumentView(argument), s, parsed_args);
@@ -313,24 +542,19 @@ namespace argos
             return {IteratorResultCode::UNKNOWN, {}, m_iterator.current()};
         }
 
-        error("Too many arguments, starting from \"" + value + "\".");
+        error(ParseErrorCode::TOO_MANY_ARGUMENTS,
+              "Too many arguments, starting from \""
+              + std::string(value) + "\".", {}, m_iterator.index());
         return {IteratorResultCode::ERROR, {}, {}};
     }
 
     IteratorResult
     ArgumentIteratorImpl::process_command(const CommandData* command)
     {
+        command->ensure_defined();
         m_parsed_args.push_back(parsed_arguments()->add_subcommand(command));
         m_command = command;
-        if (!ArgumentCounter::requires_argument_count(*m_command))
-        {
-            m_argument_counter = ArgumentCounter(*m_command);
-        }
-        else
-        {
-            m_argument_counter = ArgumentCounter(*m_command,
-                                                 count_arguments());
-        }
+        count_arguments();
         m_state = State::ARGUMENTS_AND_OPTIONS;
         return {IteratorResultCode::COMMAND, command, m_iterator.current()};
     }
@@ -339,68 +563,419 @@ namespace argos
     void ArgumentIteratorImpl::copy_remaining_arguments_to_parser_result()
     {
         auto& parsed_args = *parsed_arguments();
-        for (auto str : m_iterator.remaining_arguments())
-            parsed_args.add_unprocessed_argument(std::string(str));
+        const auto args = m_iterator.remaining_arguments();
+        for (size_t i = 0; i < args.size(); ++i)
+            parsed_args.add_unprocessed_argument(args[i]);
+
+        // Arguments that have been pushed since m_iterator was created.
+        if (m_stream)
+        {
+            const auto& stream = *m_stream;
+            for (auto i = stream.window.size(); i < stream.arguments.size(); ++i)
+                parsed_args.add_unprocessed_argument(stream.arguments[i]);
+        }
+    }
+
+    void ArgumentIteratorImpl::finish_parsed_arguments()
+    {
+        m_toplevel->compact();
     }
 
-    size_t ArgumentIteratorImpl::count_arguments() const
+    bool ArgumentIteratorImpl::prepare_stream_argument()
     {
-        size_t result = 0;
-        auto it = m_iterator;
-        auto [min_count, _] = ArgumentCounter::get_min_max_count(*m_command);
-        for (auto arg = it.next(); arg; arg = it.next())
+        // The remaining flags in a group of concatenated flags were
+        // ready when the first one was.
+        if (m_iterator.is_within_argument())
+            return true;
+
+        update_stream_window();
+        auto it = m_iterator.lookahead();
+        const auto arg = m_state == State::ARGUMENTS_AND_OPTIONS
+                             ? it.next()
+                             : it.next_value();
+        if (!arg)
         {
-            const OptionData* option = m_command->find_option(
-                *arg,
-                m_data->parser_settings.allow_abbreviated_options,
-                m_data->parser_settings.case_insensitive);
+            if (!m_stream->finished)
+                return false;
 
-            if (option)
+            // Now the total number of arguments is known.
+            if (ArgumentCounter::requires_argument_count(*m_command))
             {
-                if (!option->argument.empty())
-                    it.next_value();
+                const auto count = m_argument_counter.count();
+                m_argument_counter.reset(*m_command, count, count);
+            }
+            return true;
+        }
+
+        if (m_state == State::ARGUMENTS_AND_OPTIONS
+            && is_option(*arg, m_data->parser_settings.option_style))
+        {
+            return m_stream->finished
+                   || !needs_next_argument(it, *arg)
+                   || m_iterator.remaining_arguments().size() > 1;
+        }
 
-                bool arguments_only = false;
+        if (!m_command->commands.empty()
+            || !ArgumentCounter::requires_argument_count(*m_command))
+        {
+            return true;
+        }
 
-                switch (option->type)
-                {
-                case OptionType::HELP:
-                case OptionType::LAST_ARGUMENT:
-                case OptionType::STOP:
-                    return result;
-                case OptionType::LAST_OPTION:
-                    arguments_only = true;
-                    break;
-                default:
-                    break;
-                }
+        return count_stream_arguments(*arg);
+    }
 
-                if (arguments_only)
-                    break;
+    void ArgumentIteratorImpl::update_stream_window()
+    {
+        auto& stream = *m_stream;
+        if (!stream.window_is_outdated && !stream.has_insertions)
+            return;
+
+        const auto remaining = m_iterator.remaining_arguments();
+        if (stream.has_insertions)
+        {
+            // m_iterator's remaining arguments are no longer a suffix
+            // of the window.
+            std::deque<std::string> arguments;
+            for (size_t i = 0; i < remaining.size(); ++i)
+                arguments.emplace_back(remaining[i]);
+            for (auto i = stream.window.size(); i < stream.arguments.size(); ++i)
+                arguments.push_back(std::move(stream.arguments[i]));
+            stream.arguments = std::move(arguments);
+            stream.has_insertions = false;
+        }
+        else
+        {
+            const auto processed = stream.window.size() - remaining.size();
+            stream.arguments.erase(stream.arguments.begin(),
+                                   stream.arguments.begin() + ptrdiff_t(processed));
+        }
+
+        stream.window.assign(stream.arguments.begin(), stream.arguments.end());
+        m_iterator = {
+            make_option_iterator(m_data->parser_settings.option_style,
+                                 ArgumentSource(stream.window))
+        };
+        stream.window_is_outdated = false;
+    }
+
+    bool ArgumentIteratorImpl::needs_next_argument(OptionIteratorWrapper& it,
+                                                   std::string_view flag) const
+    {
+        // it has just returned flag. Returns true if flag, or one of the
+        // flags concatenated with it, takes its value from the next
+        // argument.
+        const auto allow_abbreviations =
+            m_data->parser_settings.allow_abbreviated_options;
+        while (true)
+        {
+            const auto* option = m_command->find_option(flag,
+                                                        allow_abbreviations);
+            if (!option)
+                return false;
+            if (!option->argument.empty())
+                return flag.back() != '=' && !it.is_within_argument();
+            if (!it.is_within_argument())
+                return false;
+            flag = *it.next();
+        }
+    }
+
+    bool ArgumentIteratorImpl::count_stream_arguments(std::string_view arg)
+    {
+        // The argument that receives arg can only change to an earlier
+        // one as the total number of arguments increases. If it is the
+        // same for the smallest and the largest possible totals, it is
+        // the right one.
+        const auto count = m_argument_counter.count();
+        const auto scan = scan_arguments(m_iterator.remaining_arguments(), count,
+                                         m_state == State::ARGUMENTS_ONLY);
+        const auto total = count + scan.count;
+        if (m_stream->finished || scan.stopped)
+        {
+            m_argument_counter.reset(*m_command, total, count);
+            return true;
+        }
+
+        const auto max_total = ArgumentCounter::get_min_max_count(*m_command).second;
+        const auto* argument = ArgumentCounter::find_argument(
+            *m_command, total, count);
+        const auto* alternative = ArgumentCounter::find_argument(
+            *m_command, max_total, count);
+        if (argument == alternative)
+        {
+            m_argument_counter.reset(*m_command, total, count);
+            return true;
+        }
+
+        if (m_iterator.remaining_arguments().size() > m_stream->max_lookahead)
+        {
+            error(ParseErrorCode::AMBIGUOUS_ARGUMENT,
+                  "Unable to determine if \"" + std::string(arg) + "\" is "
+                  + argument->name + " or " + alternative->name
+                  + " without reading more than "
+                  + std::to_string(m_stream->max_lookahead)
+                  + " arguments ahead.");
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reads the options and arguments of the current command one
+     *  at a time, without processing them, to count the arguments.
+     */
+    class ArgumentIteratorImpl::ArgumentScanner
+    {
+    public:
+        ArgumentScanner(const ArgumentIteratorImpl& owner,
+                        ArgumentSource args,
+                        size_t first_ordinal,
+                        bool arguments_only)
+            : m_command(*owner.m_command),
+              m_settings(owner.m_data->parser_settings),
+              m_min_count(ArgumentCounter::get_min_max_count(m_command).first),
+              m_iterator{make_option_iterator(m_settings.option_style, args)},
+              m_size(args.size()),
+              m_remaining(args.size()),
+              m_first_ordinal(first_ordinal)
+        {
+            if (const auto index = owner.find_first_multi_command_parent())
+                m_parent = owner.m_parsed_args[*index]->command();
+            m_scan.arguments_only = arguments_only;
+        }
+
+        /**
+         * @brief Reads the next option or argument. Returns false if
+         *  there are none, or if it ends the command's arguments.
+         */
+        bool next()
+        {
+            ++scanned_arguments;
+            const auto arg = m_scan.arguments_only
+                                 ? m_iterator.next_value()
+                                 : m_iterator.next();
+            if (!arg)
+            {
+                m_remaining = 0;
+                return false;
+            }
+
+            if (m_scan.arguments_only)
+                return update_remaining(add_argument(*arg));
+
+            const OptionData* option = m_command.find_option(
+                *arg,
+                m_settings.allow_abbreviated_options);
+
+            if (!option)
+            {
+                return update_remaining(is_option(*arg, m_settings.option_style)
+                                        || add_argument(*arg));
             }
-            else if (!is_option(*arg, m_data->parser_settings.option_style))
+
+            if (!option->argument.empty() && !m_iterator.next_value())
             {
-                if (m_command->find_command(*arg, m_data->parser_settings.case_insensitive))
-                    return result;
+                m_scan.value_pending = true;
+                m_remaining = 0;
+                return false;
+            }
+
+            switch (option->type)
+            {
+            case OptionType::HELP:
+            case OptionType::LAST_ARGUMENT:
+            case OptionType::STOP:
+                stop();
+                return false;
+            case OptionType::LAST_OPTION:
+                m_scan.last_option_found = true;
+                m_scan.arguments_only = true;
+                break;
+            default:
+                break;
+            }
+
+            return update_remaining(true);
+        }
+
+        ArgumentScan& scan()
+        {
+            return m_scan;
+        }
+
+        /**
+         * @brief Returns the number of arguments after the one that was
+         *  read last.
+         */
+        [[nodiscard]] size_t remaining() const
+        {
+            return m_remaining;
+        }
 
-                if (result >= min_count && find_sibling_command(*arg).first)
-                    return result;
+        [[nodiscard]] bool is_within_argument() const
+        {
+            return m_iterator.is_within_argument();
+        }
 
-                ++result;
+        /// If true, names of sibling commands are always counted as
+        /// arguments, they never stop the scan.
+        bool count_all_siblings = false;
+    private:
+        // Returns false if arg ends the command's arguments.
+        bool add_argument(std::string_view arg)
+        {
+            if (m_command.find_command(arg,
+                                       m_settings.allow_abbreviated_commands))
+            {
+                stop();
+                return false;
+            }
+
+            if (m_parent
+                && m_parent->find_command(arg,
+                                          m_settings.allow_abbreviated_commands))
+            {
+                const auto ordinal = m_first_ordinal + m_scan.count;
+                if (ordinal >= m_min_count && !count_all_siblings)
+                {
+                    stop();
+                    m_scan.stopped_by_sibling = true;
+                    return false;
+                }
+                m_scan.sibling_ordinals.push_back(ordinal);
             }
+
+            ++m_scan.count;
+            return true;
+        }
+
+        void stop()
+        {
+            m_scan.stopped = true;
+            m_scan.stop_distance = m_size - m_iterator.index();
+            m_remaining = 0;
+        }
+
+        bool update_remaining(bool result)
+        {
+            m_remaining = m_size - m_iterator.index() - 1;
+            return result;
+        }
+
+        const CommandData& m_command;
+        const ParserSettings& m_settings;
+        size_t m_min_count;
+        /// The first multi-command parent of m_command, if any.
+        const CommandData* m_parent = nullptr;
+        OptionIteratorWrapper m_iterator;
+        size_t m_size;
+        size_t m_remaining;
+        size_t m_first_ordinal;
+        ArgumentScan m_scan;
+    };
+
+    ArgumentIteratorImpl::ArgumentScan
+    ArgumentIteratorImpl::scan_arguments(ArgumentSource args,
+                                         size_t first_ordinal,
+                                         bool arguments_only) const
+    {
+        ArgumentScanner scanner(*this, args, first_ordinal, arguments_only);
+        while (scanner.next())
+        {}
+        return std::move(scanner.scan());
+    }
+
+    ArgumentSource ArgumentIteratorImpl::expand_response_files(ArgumentSource args)
+    {
+        if (!m_data->parser_settings.allow_response_files
+            || !ResponseFiles::has_response_files(args))
+        {
+            return args;
         }
 
-        for (auto arg = it.next_value(); arg; arg = it.next_value())
+        m_response_files = std::make_unique<ResponseFiles>();
+        if (!m_response_files->expand(args))
+            m_pending_error = m_response_files->error_message();
+        return m_response_files->arguments();
+    }
+
+    void ArgumentIteratorImpl::count_arguments()
+    {
+        if (!ArgumentCounter::requires_argument_count(*m_command))
         {
-            if (m_command->find_command(*arg, m_data->parser_settings.case_insensitive))
-                return result;
+            m_argument_counter.reset(*m_command);
+            return;
+        }
+
+        // Arguments that arrive one at a time are counted as they arrive,
+        // see count_stream_arguments().
+        if (m_stream)
+        {
+            m_argument_counter.reset(*m_command, 0);
+            return;
+        }
+
+        set_argument_scan(scan_arguments(m_iterator.remaining_arguments(), 0, false), 0);
+        update_argument_end();
+        m_argument_counter.reset(*m_command, m_argument_end);
+    }
 
-            if (result >= min_count && find_sibling_command(*arg).first)
-                return result;
+    void ArgumentIteratorImpl::set_argument_scan(const ArgumentScan& scan,
+                                                 size_t first_ordinal)
+    {
+        m_scan_end = first_ordinal + scan.count;
+        m_sibling_ordinals.assign(scan.sibling_ordinals.begin(),
+                                  scan.sibling_ordinals.end());
+        m_early_siblings = 0;
+        m_ordinal_offset = 0;
+        m_scan_stop = scan.stop_distance;
+        m_scan_stopped_by_sibling = scan.stopped_by_sibling;
+        m_scan_stop_arguments_only = scan.arguments_only;
+    }
+
+    void ArgumentIteratorImpl::update_argument_end()
+    {
+        // Inserted arguments move all the sibling commands the same
+        // distance, m_early_siblings only has to move past the ones that
+        // cross the minimum count.
+        const auto min_count = ArgumentCounter::get_min_max_count(*m_command).first;
+        auto& siblings = m_sibling_ordinals;
+        while (m_early_siblings < siblings.size()
+               && siblings[m_early_siblings] + m_ordinal_offset < min_count)
+        {
+            ++m_early_siblings;
+        }
+        while (m_early_siblings > 0
+               && siblings[m_early_siblings - 1] + m_ordinal_offset >= min_count)
+        {
+            --m_early_siblings;
+        }
 
-            ++result;
+        if (m_early_siblings == siblings.size()
+            && m_scan_stopped_by_sibling
+            && m_scan_end + m_ordinal_offset < min_count)
+        {
+            // The sibling command that stopped the scan comes too early
+            // to end the arguments now, the scan continues from it.
+            const auto args = m_iterator.remaining_arguments();
+            if (m_scan_stop <= args.size())
+            {
+                const auto scan = scan_arguments(
+                    args.subspan(args.size() - m_scan_stop),
+                    m_scan_end + m_ordinal_offset,
+                    m_scan_stop_arguments_only);
+                for (const auto ordinal : scan.sibling_ordinals)
+                    siblings.push_back(ordinal - m_ordinal_offset);
+                m_early_siblings = siblings.size();
+                m_scan_end += scan.count;
+                m_scan_stop = scan.stop_distance;
+                m_scan_stopped_by_sibling = scan.stopped_by_sibling;
+                m_scan_stop_arguments_only = scan.arguments_only;
+            }
         }
-        return result;
+
+        m_argument_end = m_early_siblings < siblings.size()
+                             ? siblings[m_early_siblings] + m_ordinal_offset
+                             : m_scan_end + m_ordinal_offset;
     }
 
     bool ArgumentIteratorImpl::check_argument_and_option_counts()
@@ -409,9 +984,17 @@ namespace argos
         if (!has_all_mandatory_options(parsed_args, *m_command))
             return false;
 
+        const auto message = m_command->constraint_checker()
+            .check_constraints(parsed_args.given_arguments());
+        if (!message.empty())
+        {
+            error(ParseErrorCode::CONSTRAINT_VIOLATION, message);
+            return false;
+        }
+
         if (*m_command->require_subcommand && parsed_args.subcommands().empty())
         {
-            error("No command was given.");
+            error(ParseErrorCode::MISSING_COMMAND, "No command was given.");
             return false;
         }
 
@@ -420,12 +1003,14 @@ namespace argos
             m_state = State::DONE;
             for (const auto& pa : m_parsed_args)
                 pa->set_result_code(ParserResultCode::SUCCESS);
+            finish_parsed_arguments();
             return true;
         }
         else
         {
             auto [lo, hi] = ArgumentCounter::get_min_max_count(*m_command);
-            error((lo == hi
+            error(ParseErrorCode::TOO_FEW_ARGUMENTS,
+                  (lo == hi
                        ? "Too few arguments. Expected "
                        : "Too few arguments. Expected at least ")
                   + std::to_string(lo) + ", received "
@@ -461,7 +1046,7 @@ namespace argos
         {
             return {
                 m_parsed_args[*index]->command()->find_command(
-                    name, m_data->parser_settings.case_insensitive),
+                    name, m_data->parser_settings.allow_abbreviated_commands),
                 *index
             };
         }
@@ -473,7 +1058,7 @@ namespace argos
     {
         m_parsed_args.resize(index + 1);
         m_command = m_parsed_args.back()->command();
-        m_argument_counter = {};
+        m_argument_counter.clear();
         m_state = State::ARGUMENTS_ONLY;
     }
 
@@ -484,45 +1069,177 @@ namespace argos
             return;
 
         m_iterator.insert(args);
+        if (m_stream)
+        {
+            m_stream->has_insertions = true;
+            return;
+        }
+
         if (!ArgumentCounter::requires_argument_count(*m_command))
             return;
 
-        auto current_count = m_argument_counter.count();
-        auto total_count = current_count + count_arguments();
-        m_argument_counter = ArgumentCounter(*m_command, total_count,
-                                             current_count);
+        // Only the new arguments are scanned, the remaining arguments have
+        // already been counted.
+        const auto current_count = m_argument_counter.count();
+        const auto remaining = m_iterator.remaining_arguments();
+        const auto tail = remaining.subspan(args.size());
+        auto scan = scan_arguments(ArgumentSource(args), current_count,
+                                   m_state == State::ARGUMENTS_ONLY);
+        if (scan.stopped)
+            scan.stop_distance += tail.size();
+
+        while (!m_sibling_ordinals.empty()
+               && m_sibling_ordinals.front() + m_ordinal_offset < current_count)
+        {
+            m_sibling_ordinals.pop_front();
+            if (m_early_siblings != 0)
+                --m_early_siblings;
+        }
+
+        bool new_done = false;
+        if (scan.stopped)
+        {
+            set_argument_scan(scan, current_count);
+        }
+        else if (scan.value_pending || scan.last_option_found)
+        {
+            // The new arguments change how the first of the remaining
+            // arguments are interpreted: either the first one is a value,
+            // or none of them are options. They are scanned both the old
+            // way and the new way until the two scans reach the same
+            // argument in the same state, the arguments after that are
+            // interpreted as before.
+            ArgumentScanner old_scanner(*this, tail, current_count, false);
+            old_scanner.count_all_siblings = true;
+            ArgumentScanner new_scanner(
+                *this,
+                scan.value_pending && !tail.empty() ? tail.subspan(1) : tail,
+                current_count + scan.count,
+                scan.last_option_found);
+            // The old scan can't go past the argument that stopped it.
+            bool old_done = tail.size() <= m_scan_stop;
+            while (true)
+            {
+                if (!old_done
+                    && old_scanner.remaining() == new_scanner.remaining()
+                    && old_scanner.scan().arguments_only
+                       == new_scanner.scan().arguments_only
+                    && !old_scanner.is_within_argument()
+                    && !new_scanner.is_within_argument())
+                {
+                    break;
+                }
+
+                if (old_done || new_scanner.remaining() >= old_scanner.remaining())
+                {
+                    new_scanner.count_all_siblings = !old_done;
+                    if (!new_scanner.next())
+                    {
+                        new_done = true;
+                        break;
+                    }
+                }
+                else
+                {
+                    old_done = !old_scanner.next()
+                               || old_scanner.remaining() <= m_scan_stop;
+                }
+            }
+
+            auto& new_scan = new_scanner.scan();
+            if (new_done)
+            {
+                // The scans never agreed, the new one replaces the old.
+                scan.count += new_scan.count;
+                scan.sibling_ordinals.insert(scan.sibling_ordinals.end(),
+                                             new_scan.sibling_ordinals.begin(),
+                                             new_scan.sibling_ordinals.end());
+                scan.stopped_by_sibling = new_scan.stopped_by_sibling;
+                scan.arguments_only = new_scan.arguments_only;
+                scan.stop_distance = new_scan.stop_distance;
+                set_argument_scan(scan, current_count);
+            }
+            else
+            {
+                const auto old_end = current_count + old_scanner.scan().count;
+                while (!m_sibling_ordinals.empty()
+                       && m_sibling_ordinals.front() + m_ordinal_offset < old_end)
+                {
+                    m_sibling_ordinals.pop_front();
+                    if (m_early_siblings != 0)
+                        --m_early_siblings;
+                }
+
+                m_ordinal_offset += scan.count + new_scan.count
+                                    - old_scanner.scan().count;
+                for (auto i = new_scan.sibling_ordinals.rbegin();
+                     i != new_scan.sibling_ordinals.rend(); ++i)
+                {
+                    m_sibling_ordinals.push_front(*i - m_ordinal_offset);
+                }
+                m_early_siblings += new_scan.sibling_ordinals.size();
+            }
+        }
+        else
+        {
+            m_ordinal_offset += scan.count;
+        }
+
+        if (!scan.stopped && !new_done)
+        {
+            for (auto i = scan.sibling_ordinals.rbegin();
+                 i != scan.sibling_ordinals.rend(); ++i)
+            {
+                m_sibling_ordinals.push_front(*i - m_ordinal_offset);
+            }
+            m_early_siblings += scan.sibling_ordinals.size();
+        }
+
+        update_argument_end();
+        m_argument_counter.reset(*m_command, m_argument_end, current_count);
     }
 
-    void ArgumentIteratorImpl::error(const std::string& message)
+    void ArgumentIteratorImpl::error(ParseErrorCode code,
+                                     const std::string& message,
+                                     ArgumentId argument_id,
+                                     std::optional<size_t> token_index)
     {
-        if (!message.empty())
-            write_error_message(*m_data, *m_command, message);
+        // The message isn't formatted in silent mode, ParseError does
+        // that if and when it's needed.
+        m_error = ParseError(code, message, argument_id, token_index,
+                             m_command, m_data);
+        if (!m_silent)
+            m_error.write();
 
-        if (m_data->parser_settings.auto_exit)
+        if (auto_exit())
             exit(m_data->parser_settings.error_exit_code);
 
         copy_remaining_arguments_to_parser_result();
         for (const auto& parsed_args : m_parsed_args)
             parsed_args->set_result_code(ParserResultCode::FAILURE);
         m_state = State::ERROR;
+        finish_parsed_arguments();
+    }
+
+    bool ArgumentIteratorImpl::auto_exit() const
+    {
+        return m_data->parser_settings.auto_exit && !m_silent;
     }
 
     bool ArgumentIteratorImpl::has_all_mandatory_options(
         const ParsedArgumentsImpl& parsed_args,
         const CommandData& command)
     {
-        for (const auto& o : command.options)
-        {
-            if (!o->optional && !parsed_args.has(o->value_id))
-            {
-                auto flags = o->flags.front();
-                for (unsigned i = 1; i < o->flags.size(); ++i)
-                    flags += ", " + o->flags[i];
-                error("Mandatory option is missing: " + flags);
-                return false;
-            }
-        }
+        const auto* o = command.constraint_checker().find_missing_option(
+            parsed_args.nonempty_values(), parsed_args.given_arguments());
+        if (!o)
+            return true;
 
-        return true;
+        auto flags = o->flags.front();
+        for (unsigned i = 1; i < o->flags.size(); ++i)
+            flags += ", " + o->flags[i];
+        error(ParseErrorCode::MISSING_OPTION,
+              "Mandatory option is missing: " + flags, o->argument_id);
+        return false;
     }
 }
@@ -6,13 +6,16 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <deque>
 #include <string>
 #include <variant>
+#include "Argos/ParseError.hpp"
 #include "ArgumentCounter.hpp"
 #include "ParserData.hpp"
 #include "OptionData.hpp"
 #include "OptionIteratorWrapper.hpp"
 #include "ParsedArgumentsImpl.hpp"
+#include "ResponseFiles.hpp"
 
 namespace argos
 {
@@ -23,7 +26,9 @@ namespace argos
         COMMAND,
         DONE,
         UNKNOWN,
-        ERROR
+        ERROR,
+        /// The iterator needs more arguments, see ArgumentIteratorImpl::push().
+        INCOMPLETE
     };
 
     using IteratorResultData = std::variant<
@@ -37,17 +42,120 @@ namespace argos
         IteratorResultData,
         std::string_view>;
 
+    /**
+     * @brief Assigns the view and value of @a result to @a arg and
+     *  @a value, returns false if @a result isn't an argument, option,
+     *  command or unknown argument.
+     */
+    bool get_result_view(const IteratorResult& result,
+                         std::unique_ptr<IArgumentView>& arg,
+                         std::string_view& value);
+
+    /**
+     * @brief The containers ArgumentIteratorImpl uses while parsing.
+     *
+     * They are owned by the top-level ParsedArgumentsImpl, which lets
+     * a parse that reuses a ParsedArgumentsImpl also reuse the memory
+     * that was allocated by the previous one.
+     */
+    struct IteratorBuffers
+    {
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>> parsed_args;
+        ArgumentCounter argument_counter;
+        std::deque<size_t> sibling_ordinals;
+    };
+
     class ArgumentIteratorImpl
     {
     public:
-        ArgumentIteratorImpl(std::vector<std::string_view> args,
-                             std::shared_ptr<ParserData> data);
+        /**
+         * Creates an iterator that reads @a args directly, the arguments
+         * must outlive the iterator.
+         */
+        ArgumentIteratorImpl(ArgumentSource args,
+                             std::shared_ptr<const ParserData> data);
+
+        /**
+         * Creates an iterator with its own copy of @a args.
+         */
+        ArgumentIteratorImpl(const std::vector<std::string_view>& args,
+                             std::shared_ptr<const ParserData> data);
+
+        /**
+         * Creates an iterator that receives its arguments one at a time
+         * through push().
+         */
+        explicit ArgumentIteratorImpl(std::shared_ptr<const ParserData> data);
+
+        ArgumentIteratorImpl(const ArgumentIteratorImpl&) = delete;
+
+        ~ArgumentIteratorImpl();
+
+        ArgumentIteratorImpl& operator=(const ArgumentIteratorImpl&) = delete;
 
         IteratorResult next();
 
+        /**
+         * Adds @a arg to the arguments of an iterator created with
+         * the constructor that only takes the parser data.
+         *
+         * The arguments are processed by next() as soon as they can be,
+         * which for options with values means when the value has been
+         * added too. Arguments of commands where the number of values
+         * that each argument receives depends on the total number of
+         * arguments are held back until the argument they belong to can
+         * be determined, and next() returns INCOMPLETE until then.
+         *
+         * If response files are allowed and @a arg is "@FILE", the
+         * arguments in FILE are added instead.
+         */
+        void push(std::string_view arg);
+
+        /**
+         * Tells the iterator that push() will not be called again.
+         */
+        void finish();
+
+        /**
+         * Sets the maximum number of arguments push() can add while
+         * next() is unable to determine which argument the first of
+         * them belongs to. next() reports an error if the limit is
+         * exceeded.
+         */
+        void set_max_lookahead(size_t max_lookahead);
+
+        /**
+         * If @a store is false, the values of arguments are not stored in
+         * the parsed arguments, they are only returned by next().
+         */
+        void set_store_argument_values(bool store);
+
+        /**
+         * Parses @a args.
+         *
+         * If @a result is given, the values are stored in it rather than
+         * in a new ParsedArgumentsImpl. It must have been created for
+         * the main command of @a data, and it must be empty, see
+         * ParsedArgumentsImpl::clear().
+         */
         static std::shared_ptr<ParsedArgumentsImpl>
-        parse(std::vector<std::string_view> args,
-              const std::shared_ptr<ParserData>& data);
+        parse(ArgumentSource args,
+              const std::shared_ptr<const ParserData>& data,
+              std::shared_ptr<ParsedArgumentsImpl> result = {});
+
+        /**
+         * Parses @a args without writing to the output stream or
+         * exiting the program, regardless of the parser settings.
+         * An error is stored in @a error. Errors reported by callbacks
+         * are caught if exceptions are enabled.
+         *
+         * @a result is used the same way as in parse().
+         */
+        static std::shared_ptr<ParsedArgumentsImpl>
+        parse_silently(ArgumentSource args,
+                       const std::shared_ptr<const ParserData>& data,
+                       std::shared_ptr<ParsedArgumentsImpl> result,
+                       ParseError& error);
 
         [[nodiscard]] const std::shared_ptr<ParsedArgumentsImpl>&
         parsed_arguments() const;
@@ -55,6 +163,15 @@ namespace argos
         [[nodiscard]] const std::shared_ptr<ParsedArgumentsImpl>&
         toplevel_parsed_arguments() const;
 
+        /**
+         * @brief Returns the number of options and arguments the calling
+         *  thread has read while counting arguments ahead of parsing them.
+         *
+         * Lets tests verify that the work of counting arguments grows
+         * linearly with the number of arguments.
+         */
+        static size_t scanned_argument_count();
+
     private:
         enum class OptionResult
         {
@@ -66,17 +183,73 @@ namespace argos
         };
 
         std::pair<OptionResult, std::string_view>
-        process_option(const OptionData& opt, const std::string& flag);
+        process_option(const OptionData& opt, std::string_view flag);
 
-        IteratorResult process_option(const std::string& flag);
+        IteratorResult process_option(std::string_view flag);
 
-        IteratorResult process_argument(const std::string& value);
+        IteratorResult process_argument(std::string_view value);
 
         IteratorResult process_command(const CommandData* command);
 
         void copy_remaining_arguments_to_parser_result();
 
-        [[nodiscard]] size_t count_arguments() const;
+        /**
+         * @brief Makes the parsed arguments ready to be handed out. Must
+         *  be called whenever parsing ends, with or without errors.
+         *
+         * The const functions of ParsedArgumentsImpl don't modify the
+         * object once it has been compacted, which makes it safe to
+         * share the result between threads.
+         */
+        void finish_parsed_arguments();
+
+        bool prepare_stream_argument();
+
+        void update_stream_window();
+
+        [[nodiscard]] bool needs_next_argument(OptionIteratorWrapper& it,
+                                               std::string_view flag) const;
+
+        bool count_stream_arguments(std::string_view arg);
+
+        struct ArgumentScan
+        {
+            /// The number of arguments found.
+            size_t count = 0;
+            /// Ordinals of arguments that are also names of sibling commands.
+            std::vector<size_t> sibling_ordinals;
+            /// True if the scan reached the end of the command's arguments
+            /// before running out of input.
+            bool stopped = false;
+            /// True if the input ended with an option missing its value.
+            bool value_pending = false;
+            /// True if the input contained a LAST_OPTION option.
+            bool last_option_found = false;
+            /// True if the name of a sibling command stopped the scan.
+            bool stopped_by_sibling = false;
+            /// True if options were no longer recognized when the scan
+            /// ended.
+            bool arguments_only = false;
+            /// If stopped is true: the number of arguments from the one
+            /// that stopped the scan to the end of the input, that
+            /// argument included.
+            size_t stop_distance = 0;
+        };
+
+        class ArgumentScanner;
+
+        [[nodiscard]] ArgumentScan
+        scan_arguments(ArgumentSource args,
+                       size_t first_ordinal,
+                       bool arguments_only) const;
+
+        void count_arguments();
+
+        ArgumentSource expand_response_files(ArgumentSource args);
+
+        void set_argument_scan(const ArgumentScan& scan, size_t first_ordinal);
+
+        void update_argument_end();
 
         bool check_argument_and_option_counts();
 
@@ -90,16 +263,93 @@ namespace argos
 
         void update_arguments(const std::vector<std::string>& args);
 
-        void error(const std::string& message = {});
+        /**
+         * Reports the error, either by writing it to the output stream
+         * (and possibly exiting) or, in silent mode, by storing it in
+         * m_error.
+         */
+        void error(ParseErrorCode code,
+                   const std::string& message,
+                   ArgumentId argument_id = {},
+                   std::optional<size_t> token_index = {});
 
         bool has_all_mandatory_options(const ParsedArgumentsImpl& parsed_args,
                                        const CommandData& command);
 
-        std::shared_ptr<ParserData> m_data;
+        ArgumentIteratorImpl(std::vector<std::string> owned_args,
+                             ArgumentSource args,
+                             std::shared_ptr<const ParserData> data,
+                             std::shared_ptr<ParsedArgumentsImpl> result = {},
+                             bool silent = false);
+
+        [[nodiscard]] bool auto_exit() const;
+
+        /// The state of an iterator that receives its arguments through
+        /// push().
+        struct ArgumentStream
+        {
+            /// The arguments that haven't been processed yet. Arguments
+            /// that precede m_iterator's position in window have been
+            /// processed, but not yet removed.
+            std::deque<std::string> arguments;
+            /// The arguments that m_iterator reads.
+            std::vector<std::string_view> window;
+            /// True if push() has added arguments that aren't in window.
+            bool window_is_outdated = false;
+            /// True if callbacks have inserted arguments into m_iterator
+            /// that aren't in arguments.
+            bool has_insertions = false;
+            bool finished = false;
+            bool store_argument_values = true;
+            size_t max_lookahead = 1024;
+        };
+
+        /// Only used when the iterator must keep its own copy of the
+        /// arguments.
+        std::vector<std::string> m_owned_args;
+        std::shared_ptr<const ParserData> m_data;
+        /// True if errors are stored in m_error instead of being
+        /// written to the output stream, and the program never exits.
+        bool m_silent = false;
+        ParseError m_error;
+        std::unique_ptr<ArgumentStream> m_stream;
+        /// Owns the arguments read from response files.
+        std::unique_ptr<ResponseFiles> m_response_files;
+        /// An error found before parsing started, next() reports it
+        /// instead of processing the first argument.
+        std::string m_pending_error;
         const CommandData* m_command = nullptr;
-        std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_parsed_args;
+        /// Keeps the parsed arguments, and with them the buffers that
+        /// the references below refer to, alive.
+        std::shared_ptr<ParsedArgumentsImpl> m_toplevel;
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>>& m_parsed_args;
         OptionIteratorWrapper m_iterator;
-        ArgumentCounter m_argument_counter;
+        ArgumentCounter& m_argument_counter;
+
+        // The lookahead that determines the current command's argument
+        // count. Ordinals are indices in the sequence of the command's
+        // arguments. The arguments before m_scan_end have been counted,
+        // m_sibling_ordinals lists the ones among them that are names
+        // of sibling commands. The first sibling command that comes after
+        // the command's minimum number of arguments ends the sequence,
+        // m_argument_end is its ordinal, or m_scan_end if there is none,
+        // and m_early_siblings is the number of sibling commands before
+        // it. m_scan_end and m_sibling_ordinals are stored relative to
+        // m_ordinal_offset (the subtraction may wrap around, only the sum
+        // is meaningful) to let inserted arguments move all of them in
+        // constant time.
+        size_t m_argument_end = 0;
+        size_t m_scan_end = 0;
+        std::deque<size_t>& m_sibling_ordinals;
+        size_t m_early_siblings = 0;
+        size_t m_ordinal_offset = 0;
+        /// The stop_distance, stopped_by_sibling and arguments_only of
+        /// the scan that ended at m_scan_end. They tell where the counted
+        /// arguments end, and let the scan continue if inserted arguments
+        /// turn the sibling command that stopped it into an argument.
+        size_t m_scan_stop = 0;
+        bool m_scan_stopped_by_sibling = false;
+        bool m_scan_stop_arguments_only = false;
 
         enum class State
         {
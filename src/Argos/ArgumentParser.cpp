@@ -12,7 +12,6 @@
 #include <iostream>
 #include "ArgosThrow.hpp"
 #include "ArgumentIteratorImpl.hpp"
-#include "HelpText.hpp"
 #include "ParserData.hpp"
 #include "StringUtilities.hpp"
 
@@ -26,17 +25,17 @@ namespace argos
             result->parser_settings = data.parser_settings;
             result->help_settings = data.help_settings;
             result->command = data.command;
+            result->version = data.version;
             return result;
         }
 
         constexpr char DEFAULT_NAME[] = "UNINITIALIZED";
 
-        ParsedArguments parse_arguments(std::vector<std::string_view> args,
+        ParsedArguments parse_arguments(ArgumentSource args,
                                         const std::shared_ptr<ParserData>& data)
         {
             finish_initialization(*data);
-            return ParsedArguments(
-                ArgumentIteratorImpl::parse(std::move(args), data));
+            return ParsedArguments(ArgumentIteratorImpl::parse(args, data));
         }
 
         ArgumentIterator
@@ -86,6 +85,20 @@ namespace argos
         return *this;
     }
 
+    ArgumentParser& ArgumentParser::add(Argument& argument, ValueHandle& handle)
+    {
+        return add(std::move(argument), handle);
+    }
+
+    ArgumentParser& ArgumentParser::add(Argument&& argument, ValueHandle& handle)
+    {
+        check_data();
+        const auto index = unsigned(m_data->command.arguments.size());
+        m_data->command.add(argument.release());
+        handle = ValueHandle(m_data->command.handle_id, false, index);
+        return *this;
+    }
+
     ArgumentParser& ArgumentParser::add(Option& option)
     {
         return add(std::move(option));
@@ -98,6 +111,20 @@ namespace argos
         return *this;
     }
 
+    ArgumentParser& ArgumentParser::add(Option& option, ValueHandle& handle)
+    {
+        return add(std::move(option), handle);
+    }
+
+    ArgumentParser& ArgumentParser::add(Option&& option, ValueHandle& handle)
+    {
+        check_data();
+        const auto index = unsigned(m_data->command.options.size());
+        m_data->command.add(option.release());
+        handle = ValueHandle(m_data->command.handle_id, true, index);
+        return *this;
+    }
+
     ArgumentParser& ArgumentParser::add(Command& command)
     {
         return add(std::move(command));
@@ -117,37 +144,84 @@ namespace argos
         return *this;
     }
 
+    ArgumentParser& ArgumentParser::mutually_exclusive(std::vector<std::string> names)
+    {
+        check_data();
+        m_data->command.add_constraint(ConstraintType::MUTUALLY_EXCLUSIVE,
+                                       std::move(names));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::at_least_one_of(std::vector<std::string> names)
+    {
+        check_data();
+        m_data->command.add_constraint(ConstraintType::AT_LEAST_ONE_OF,
+                                       std::move(names));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::depends_on(std::string name,
+                                               std::vector<std::string> names)
+    {
+        check_data();
+        names.insert(names.begin(), std::move(name));
+        m_data->command.add_constraint(ConstraintType::DEPENDS_ON,
+                                       std::move(names));
+        return *this;
+    }
+
+    ArgumentParser& ArgumentParser::conflicts_with(std::string name,
+                                                   std::vector<std::string> names)
+    {
+        check_data();
+        names.insert(names.begin(), std::move(name));
+        m_data->command.add_constraint(ConstraintType::CONFLICTS_WITH,
+                                       std::move(names));
+        return *this;
+    }
+
     ParsedArguments ArgumentParser::parse(int argc, char** argv)
     {
         if (argc <= 0)
-            return parse(std::vector<std::string_view>());
+            return parse_source({});
 
+        check_data();
         if (m_data->command.name == DEFAULT_NAME
             && std::strlen(argv[0]) != 0)
         {
             m_data->command.name = get_base_name(argv[0]);
         }
 
-        return parse(std::vector<std::string_view>(argv + 1, argv + argc));
+        return parse_source({argv + 1, size_t(argc - 1)});
     }
 
     ParsedArguments ArgumentParser::parse(int argc, char** argv) const
     {
         if (argc <= 0)
-            return parse(std::vector<std::string_view>());
-        return parse(std::vector<std::string_view>(argv + 1, argv + argc));
+            return parse_source({});
+        return parse_source({argv + 1, size_t(argc - 1)});
     }
 
     ParsedArguments ArgumentParser::parse(std::vector<std::string_view> args)
     {
-        check_data();
-        return parse_arguments(std::move(args), std::move(m_data));
+        return parse_source(ArgumentSource(args));
     }
 
     ParsedArguments ArgumentParser::parse(std::vector<std::string_view> args) const
+    {
+        return parse_source(ArgumentSource(args));
+    }
+
+    ParsedArguments ArgumentParser::parse_source(ArgumentSource args)
+    {
+        check_data();
+        return parse_arguments(args, std::move(m_data));
+    }
+
+    ParsedArguments ArgumentParser::parse_source(ArgumentSource args) const
     {
         check_data();
-        return parse_arguments(std::move(args), make_copy(*m_data));
+        return parse_arguments(args, make_copy(*m_data));
     }
 
     ArgumentIterator ArgumentParser::make_iterator(int argc, char** argv)
@@ -174,9 +248,16 @@ namespace argos
 
     ArgumentIterator
     ArgumentParser::make_iterator(std::vector<std::string_view> args) const
+    {
+        return compile().make_iterator(std::move(args));
+    }
+
+    CompiledParser ArgumentParser::compile() const
     {
         check_data();
-        return make_argument_iterator(std::move(args), make_copy(*m_data));
+        std::shared_ptr<ParserData> data = make_copy(*m_data);
+        finish_initialization(*data);
+        return CompiledParser(std::move(data));
     }
 
     bool ArgumentParser::allow_abbreviated_options() const
@@ -192,6 +273,19 @@ namespace argos
         return *this;
     }
 
+    bool ArgumentParser::allow_abbreviated_commands() const
+    {
+        check_data();
+        return m_data->parser_settings.allow_abbreviated_commands;
+    }
+
+    ArgumentParser& ArgumentParser::allow_abbreviated_commands(bool value)
+    {
+        check_data();
+        m_data->parser_settings.allow_abbreviated_commands = value;
+        return *this;
+    }
+
     bool ArgumentParser::auto_exit() const
     {
         check_data();
@@ -302,6 +396,19 @@ namespace argos
         return *this;
     }
 
+    bool ArgumentParser::allow_response_files() const
+    {
+        check_data();
+        return m_data->parser_settings.allow_response_files;
+    }
+
+    ArgumentParser& ArgumentParser::allow_response_files(bool value)
+    {
+        check_data();
+        m_data->parser_settings.allow_response_files = value;
+        return *this;
+    }
+
     const ArgumentCallback& ArgumentParser::argument_callback() const
     {
         check_data();
@@ -413,17 +520,7 @@ namespace argos
 
     void ArgumentParser::write_subcommand_help_text(const std::vector<std::string>& path) const
     {
-        check_data();
-        const auto data = make_copy(*m_data);
-        finish_initialization(*data);
-        const auto* cmd = &data->command;
-        for (auto& name : path)
-        {
-            cmd = cmd->find_command(name, data->parser_settings.case_insensitive);
-            if (!cmd)
-                ARGOS_THROW("Unknown command: " + name);
-        }
-        argos::write_help_text(*data, *cmd);
+        compile().write_subcommand_help_text(path);
     }
 
     ArgumentParser& ArgumentParser::add_word_splitting_rule(std::string str)
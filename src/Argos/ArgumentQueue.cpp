@@ -0,0 +1,72 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ArgumentQueue.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t MIN_GAP = 16;
+    }
+
+    ArgumentQueue::ArgumentQueue() = default;
+
+    ArgumentQueue::ArgumentQueue(std::vector<std::string_view> args)
+        : m_buffer(std::move(args)),
+          m_size(m_buffer.size()),
+          m_is_used(true)
+    {}
+
+    ArgumentSource ArgumentQueue::arguments() const
+    {
+        return {m_buffer.data() + m_buffer.size() - m_size, m_size};
+    }
+
+    ArgumentSource
+    ArgumentQueue::insert(ArgumentSource remaining, size_t pos,
+                          std::span<const std::string_view> new_args)
+    {
+        const auto count = new_args.size();
+        const auto size = remaining.size();
+        // Arguments are only removed from the front, so remaining is
+        // still the end of the buffer.
+        assert(!m_is_used || size <= m_size);
+        const auto gap = m_buffer.size() - size;
+        if (m_is_used && gap >= count)
+        {
+            const auto start = gap - count;
+            for (size_t i = 0; i < pos; ++i)
+                m_buffer[start + i] = m_buffer[gap + i];
+            std::copy(new_args.begin(), new_args.end(),
+                      m_buffer.begin() + ptrdiff_t(start + pos));
+            m_size = size + count;
+            return arguments();
+        }
+
+        // Make a new buffer with a gap in front that is at least as
+        // large as the arguments, i.e. the cost of copying them is
+        // paid for by the insertions that fill the gap.
+        const auto new_size = size + count;
+        const auto new_gap = std::max(new_size, MIN_GAP);
+        std::vector<std::string_view> buffer;
+        buffer.reserve(new_gap + new_size);
+        buffer.resize(new_gap);
+        for (size_t i = 0; i < pos; ++i)
+            buffer.push_back(remaining[i]);
+        buffer.insert(buffer.end(), new_args.begin(), new_args.end());
+        for (size_t i = pos; i < size; ++i)
+            buffer.push_back(remaining[i]);
+        m_buffer = std::move(buffer);
+        m_size = new_size;
+        m_is_used = true;
+        return arguments();
+    }
+}
@@ -0,0 +1,60 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <span>
+#include <string_view>
+#include <vector>
+#include "Argos/ArgumentSource.hpp"
+
+namespace argos
+{
+    /**
+     * @brief Stores the remaining arguments of an option iterator when
+     *  arguments have been inserted among them.
+     *
+     * The arguments are kept at the end of a buffer with a gap in
+     * front of them. Arguments are inserted at or next to the front,
+     * where the gap is, so inserting k arguments costs O(k) amortized
+     * regardless of how many arguments remain. The remaining arguments
+     * are still contiguous and are read through an ArgumentSource.
+     */
+    class ArgumentQueue
+    {
+    public:
+        ArgumentQueue();
+
+        /**
+         * @brief Creates a queue that holds @a args, and no gap.
+         */
+        explicit ArgumentQueue(std::vector<std::string_view> args);
+
+        /**
+         * @brief Returns the arguments in the queue.
+         */
+        [[nodiscard]] ArgumentSource arguments() const;
+
+        /**
+         * @brief Inserts @a new_args in front of argument number @a pos
+         *  in @a remaining and returns the result.
+         *
+         * If the queue is empty, @a remaining is copied to the queue.
+         * Otherwise @a remaining must be the result of the previous
+         * call to arguments() or insert(), possibly with arguments
+         * removed from the front. The strings themselves are never
+         * copied.
+         */
+        ArgumentSource insert(ArgumentSource remaining, size_t pos,
+                              std::span<const std::string_view> new_args);
+    private:
+        /// The remaining arguments are the last m_size elements.
+        std::vector<std::string_view> m_buffer;
+        size_t m_size = 0;
+        /// True once the queue has received arguments.
+        bool m_is_used = false;
+    };
+}
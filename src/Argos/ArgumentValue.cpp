@@ -9,8 +9,10 @@
 
 #include "Argos/ArgumentValues.hpp"
 #include "ArgosThrow.hpp"
+#include "ChoiceSet.hpp"
 #include "ParseValue.hpp"
 #include "ParsedArgumentsImpl.hpp"
+#include "SplitValues.hpp"
 #include "StringUtilities.hpp"
 
 namespace argos
@@ -23,7 +25,7 @@ namespace argos
             const auto s = value.value();
             if (!s)
                 return default_value;
-            auto n = parse_integer<T>(std::string(*s), base);
+            auto n = parse_integer<T>(*s, base);
             if (!n)
                 value.error();
             return *n;
@@ -35,7 +37,7 @@ namespace argos
             const auto s = value.value();
             if (!s)
                 return default_value;
-            auto n = parse_floating_point<T>(std::string(*s));
+            auto n = parse_floating_point<T>(*s);
             if (!n)
                 value.error();
             return *n;
@@ -50,11 +52,15 @@ namespace argos
     ArgumentValue::ArgumentValue(const std::optional<std::string_view>& value,
                                  std::shared_ptr<ParsedArgumentsImpl> args,
                                  ValueId value_id,
-                                 ArgumentId argument_id)
+                                 ArgumentId argument_id,
+                                 ValueType value_type,
+                                 TypedValue typed_value)
         : m_value(value),
           m_args(std::move(args)),
           m_value_id(value_id),
-          m_argument_id(argument_id)
+          m_argument_id(argument_id),
+          m_value_type(value_type),
+          m_typed_value(typed_value)
     {}
 
     ArgumentValue::ArgumentValue(const ArgumentValue&) = default;
@@ -91,51 +97,84 @@ namespace argos
     {
         if (!m_value)
             return default_value;
+        if (m_value_type == ValueType::BOOL)
+            return m_typed_value.bool_value;
         return !m_value->empty() && m_value != "0" && m_value != "false";
     }
 
     int ArgumentValue::as_int(int default_value, int base) const
     {
+        if (m_value && m_value_type == ValueType::INT && base == 10)
+            return m_typed_value.int_value;
         return get_integer<int>(*this, default_value, base);
     }
 
     unsigned ArgumentValue::as_uint(unsigned default_value, int base) const
     {
+        if (m_value && m_value_type == ValueType::UINT && base == 10)
+            return m_typed_value.uint_value;
         return get_integer<unsigned>(*this, default_value, base);
     }
 
     long ArgumentValue::as_long(long default_value, int base) const
     {
+        if (m_value && m_value_type == ValueType::LONG && base == 10)
+            return m_typed_value.long_value;
         return get_integer<long>(*this, default_value, base);
     }
 
     long long ArgumentValue::as_llong(long long default_value, int base) const
     {
+        if (m_value && m_value_type == ValueType::LLONG && base == 10)
+            return m_typed_value.llong_value;
         return get_integer<long long>(*this, default_value, base);
     }
 
     unsigned long
     ArgumentValue::as_ulong(unsigned long default_value, int base) const
     {
+        if (m_value && m_value_type == ValueType::ULONG && base == 10)
+            return m_typed_value.ulong_value;
         return get_integer<unsigned long>(*this, default_value, base);
     }
 
     unsigned long long
     ArgumentValue::as_ullong(unsigned long long default_value, int base) const
     {
+        if (m_value && m_value_type == ValueType::ULLONG && base == 10)
+            return m_typed_value.ullong_value;
         return get_integer<unsigned long long>(*this, default_value, base);
     }
 
     float ArgumentValue::as_float(float default_value) const
     {
+        if (m_value && m_value_type == ValueType::FLOAT)
+            return m_typed_value.float_value;
         return get_floating_point<float>(*this, default_value);
     }
 
     double ArgumentValue::as_double(double default_value) const
     {
+        if (m_value && m_value_type == ValueType::DOUBLE)
+            return m_typed_value.double_value;
         return get_floating_point<double>(*this, default_value);
     }
 
+    int ArgumentValue::as_choice(int default_value) const
+    {
+        if (!m_value)
+            return default_value;
+        if (m_value_type == ValueType::CHOICE)
+            return int(m_typed_value.uint_value);
+        const auto* choices = m_args ? m_args->get_choices(m_value_id) : nullptr;
+        if (!choices)
+            ARGOS_THROW("The value doesn't have any choices.");
+        const auto index = choices->find(*m_value);
+        if (!index)
+            error();
+        return int(*index);
+    }
+
     std::string ArgumentValue::as_string(const std::string& default_value) const
     {
         return m_value ? std::string(*m_value) : default_value;
@@ -169,6 +208,53 @@ namespace argos
         return split(separator, num_parts, num_parts);
     }
 
+    template <SplitNumber T>
+    std::vector<T>
+    ArgumentValue::split_as(char separator, unsigned thread_count) const
+    {
+        if (!m_value)
+            return {};
+        const auto chunks = split_chunks(*m_value, separator, thread_count);
+        std::vector<T> result(chunks.count);
+        if (const auto part = convert_chunks(chunks, separator, result.data()))
+            error("Invalid value: " + std::string(*part) + ".");
+        return result;
+    }
+
+    template <SplitNumber T>
+    size_t ArgumentValue::split_into(std::span<T> buffer, char separator,
+                                     unsigned thread_count) const
+    {
+        if (!m_value)
+            return 0;
+        const auto chunks = split_chunks(*m_value, separator, thread_count);
+        if (chunks.count > buffer.size())
+        {
+            error("Too many values: " + std::to_string(chunks.count)
+                  + ". The maximum is " + std::to_string(buffer.size()) + ".");
+        }
+        if (const auto part = convert_chunks(chunks, separator, buffer.data()))
+            error("Invalid value: " + std::string(*part) + ".");
+        return chunks.count;
+    }
+
+#define ARGOS_SPLIT_NUMBER(type) \
+    template std::vector<type> \
+    ArgumentValue::split_as<type>(char, unsigned) const; \
+    template size_t \
+    ArgumentValue::split_into<type>(std::span<type>, char, unsigned) const
+
+    ARGOS_SPLIT_NUMBER(int);
+    ARGOS_SPLIT_NUMBER(unsigned);
+    ARGOS_SPLIT_NUMBER(long);
+    ARGOS_SPLIT_NUMBER(long long);
+    ARGOS_SPLIT_NUMBER(unsigned long);
+    ARGOS_SPLIT_NUMBER(unsigned long long);
+    ARGOS_SPLIT_NUMBER(float);
+    ARGOS_SPLIT_NUMBER(double);
+
+#undef ARGOS_SPLIT_NUMBER
+
     void ArgumentValue::error(const std::string& message) const
     {
         if (!m_args)
@@ -8,8 +8,11 @@
 #include "Argos/ArgumentValues.hpp"
 
 #include "Argos/ArgumentValue.hpp"
+#include "ArgosThrow.hpp"
+#include "ChoiceSet.hpp"
 #include "ParseValue.hpp"
 #include "ParsedArgumentsImpl.hpp"
+#include "SplitValues.hpp"
 #include "StringUtilities.hpp"
 
 namespace argos
@@ -45,7 +48,7 @@ namespace argos
             result.reserve(values.size());
             for (auto& v : values.raw_values())
             {
-                auto value = parse_floating_point<T>(std::string(v));
+                auto value = parse_floating_point<T>(v);
                 if (!value)
                     error(values, v);
                 else
@@ -54,6 +57,51 @@ namespace argos
             return result;
         }
 
+        template <typename T>
+        std::vector<T> get_typed_values(const std::vector<TypedValue>& values,
+                                        T TypedValue::* member)
+        {
+            std::vector<T> result;
+            result.reserve(values.size());
+            for (const auto& value : values)
+                result.push_back(value.*member);
+            return result;
+        }
+
+        std::vector<SplitChunks> split_all_chunks(
+            const std::vector<std::pair<std::string_view, ArgumentId>>& values,
+            char separator,
+            unsigned thread_count)
+        {
+            std::vector<SplitChunks> result;
+            result.reserve(values.size());
+            for (const auto& [value, _] : values)
+                result.push_back(split_chunks(value, separator, thread_count));
+            return result;
+        }
+
+        size_t count_parts(const std::vector<SplitChunks>& chunks)
+        {
+            size_t count = 0;
+            for (const auto& c : chunks)
+                count += c.count;
+            return count;
+        }
+
+        template <typename T>
+        void convert_all_chunks(const ArgumentValues& values,
+                                const std::vector<SplitChunks>& chunks,
+                                char separator,
+                                T* out)
+        {
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                if (const auto part = convert_chunks(chunks[i], separator, out))
+                    values.value(i).error("Invalid value: " + std::string(*part) + ".");
+                out += chunks[i].count;
+            }
+        }
+
         template <typename T>
         std::vector<T> parse_integers(const ArgumentValues& values,
                                       const std::vector<T>& default_value,
@@ -66,7 +114,7 @@ namespace argos
             result.reserve(values.size());
             for (auto& v : values.raw_values())
             {
-                auto value = parse_integer<T>(std::string(v), base);
+                auto value = parse_integer<T>(v, base);
                 if (!value)
                     error(values, v);
                 else
@@ -79,11 +127,18 @@ namespace argos
     ArgumentValues::ArgumentValues(
             std::vector<std::pair<std::string_view, ArgumentId>> values,
             std::shared_ptr<ParsedArgumentsImpl> args,
-            ValueId value_id)
+            ValueId value_id,
+            ValueType value_type,
+            std::vector<TypedValue> typed_values)
         : m_values(std::move(values)),
           m_args(std::move(args)),
-          m_value_id(value_id)
-    {}
+          m_value_id(value_id),
+          m_value_type(value_type),
+          m_typed_values(std::move(typed_values))
+    {
+        if (m_typed_values.size() != m_values.size())
+            m_value_type = ValueType::STRING;
+    }
 
     ArgumentValues::ArgumentValues(const ArgumentValues&) = default;
 
@@ -132,8 +187,8 @@ namespace argos
     {
         std::vector<ArgumentValue> result;
         result.reserve(m_values.size());
-        for (const auto& [value, arg_id] : m_values)
-            result.emplace_back(value, m_args, m_value_id, arg_id);
+        for (size_t i = 0; i < m_values.size(); ++i)
+            result.push_back(value(i));
         return result;
     }
 
@@ -152,13 +207,24 @@ namespace argos
             return {{}, m_args, m_value_id, {}};
 
         const auto& [value, arg_id] = m_values.at(index);
-        return {value, m_args, m_value_id, arg_id};
+        if (m_value_type == ValueType::STRING)
+            return {value, m_args, m_value_id, arg_id};
+        return {value, m_args, m_value_id, arg_id,
+                m_value_type, m_typed_values[index]};
+    }
+
+    ValuesView<std::string_view> ArgumentValues::view() const &
+    {
+        return ValuesView<std::string_view>(
+            {m_values, m_typed_values, m_value_type, m_args.get()});
     }
 
     std::vector<int>
     ArgumentValues::as_ints(const std::vector<int>& default_value,
                             int base) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::INT && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::int_value);
         return parse_integers<int>(*this, default_value, base);
     }
 
@@ -166,6 +232,8 @@ namespace argos
     ArgumentValues::as_uints(const std::vector<unsigned>& default_value,
                              int base) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::UINT && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::uint_value);
         return parse_integers<unsigned>(*this, default_value, base);
     }
 
@@ -173,6 +241,8 @@ namespace argos
     ArgumentValues::as_longs(const std::vector<long>& default_value,
                              int base) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::LONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::long_value);
         return parse_integers<long>(*this, default_value, base);
     }
 
@@ -180,6 +250,8 @@ namespace argos
     ArgumentValues::as_llongs(const std::vector<long long>& default_value,
                               int base) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::LLONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::llong_value);
         return parse_integers<long long>(*this, default_value, base);
     }
 
@@ -187,6 +259,8 @@ namespace argos
     ArgumentValues::as_ulongs(const std::vector<unsigned long>& default_value,
                               int base) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::ULONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::ulong_value);
         return parse_integers<unsigned long>(*this, default_value, base);
     }
 
@@ -194,21 +268,97 @@ namespace argos
         const std::vector<unsigned long long>& default_value,
         int base) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::ULLONG && base == 10)
+            return get_typed_values(m_typed_values, &TypedValue::ullong_value);
         return parse_integers<unsigned long long>(*this, default_value, base);
     }
 
     std::vector<float>
     ArgumentValues::as_floats(const std::vector<float>& default_value) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::FLOAT)
+            return get_typed_values(m_typed_values, &TypedValue::float_value);
         return parse_floats(*this, default_value);
     }
 
     std::vector<double>
     ArgumentValues::as_doubles(const std::vector<double>& default_value) const
     {
+        if (!m_values.empty() && m_value_type == ValueType::DOUBLE)
+            return get_typed_values(m_typed_values, &TypedValue::double_value);
         return parse_floats(*this, default_value);
     }
 
+    std::vector<int>
+    ArgumentValues::as_choices(const std::vector<int>& default_value) const
+    {
+        if (m_values.empty())
+            return default_value;
+
+        std::vector<int> result;
+        result.reserve(m_values.size());
+        if (m_value_type == ValueType::CHOICE)
+        {
+            for (const auto& value : m_typed_values)
+                result.push_back(int(value.uint_value));
+            return result;
+        }
+
+        const auto* choices = m_args ? m_args->get_choices(m_value_id) : nullptr;
+        if (!choices)
+            ARGOS_THROW("The values don't have any choices.");
+        for (const auto& [value, _] : m_values)
+        {
+            const auto index = choices->find(value);
+            if (!index)
+                argos::error(*this, value);
+            result.push_back(int(*index));
+        }
+        return result;
+    }
+
+    template <SplitNumber T>
+    std::vector<T>
+    ArgumentValues::split_as(char separator, unsigned thread_count) const
+    {
+        const auto chunks = split_all_chunks(m_values, separator, thread_count);
+        std::vector<T> result(count_parts(chunks));
+        convert_all_chunks(*this, chunks, separator, result.data());
+        return result;
+    }
+
+    template <SplitNumber T>
+    size_t ArgumentValues::split_into(std::span<T> buffer, char separator,
+                                      unsigned thread_count) const
+    {
+        const auto chunks = split_all_chunks(m_values, separator, thread_count);
+        const auto count = count_parts(chunks);
+        if (count > buffer.size())
+        {
+            error("Too many values: " + std::to_string(count)
+                  + ". The maximum is " + std::to_string(buffer.size()) + ".");
+        }
+        convert_all_chunks(*this, chunks, separator, buffer.data());
+        return count;
+    }
+
+#define ARGOS_SPLIT_NUMBERS(type) \
+    template std::vector<type> \
+    ArgumentValues::split_as<type>(char, unsigned) const; \
+    template size_t \
+    ArgumentValues::split_into<type>(std::span<type>, char, unsigned) const
+
+    ARGOS_SPLIT_NUMBERS(int);
+    ARGOS_SPLIT_NUMBERS(unsigned);
+    ARGOS_SPLIT_NUMBERS(long);
+    ARGOS_SPLIT_NUMBERS(long long);
+    ARGOS_SPLIT_NUMBERS(unsigned long);
+    ARGOS_SPLIT_NUMBERS(unsigned long long);
+    ARGOS_SPLIT_NUMBERS(float);
+    ARGOS_SPLIT_NUMBERS(double);
+
+#undef ARGOS_SPLIT_NUMBERS
+
     std::vector<std::string> ArgumentValues::as_strings(
             const std::vector<std::string>& default_value) const
     {
@@ -0,0 +1,211 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "BatchParser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "ArgosThrow.hpp"
+#include "ArgumentIteratorImpl.hpp"
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t CHUNK_SIZE = 32;
+
+        /**
+         * @brief The chunks that remain for each thread.
+         *
+         * Each thread's chunks are a range [begin, end) packed into a
+         * single atomic 64-bit integer. The owner takes chunks from the
+         * front, other threads steal from the back. Chunks are never
+         * given back, which means a range that is seen to be empty
+         * stays empty until its owner steals a new one.
+         */
+        class ChunkRanges
+        {
+        public:
+            ChunkRanges(size_t chunk_count, unsigned thread_count)
+                : m_ranges(thread_count)
+            {
+                for (unsigned i = 0; i < thread_count; ++i)
+                {
+                    m_ranges[i].bounds = pack(
+                        uint32_t(chunk_count * i / thread_count),
+                        uint32_t(chunk_count * (i + 1) / thread_count));
+                }
+            }
+
+            /**
+             * @brief Gets the next chunk for @a thread, from its own
+             *  range or from the range of another thread.
+             */
+            bool next(unsigned thread, size_t& chunk)
+            {
+                return pop_front(thread, chunk) || steal(thread, chunk);
+            }
+        private:
+            struct alignas(64) Range
+            {
+                std::atomic<uint64_t> bounds;
+            };
+
+            static uint64_t pack(uint32_t begin, uint32_t end)
+            {
+                return uint64_t(begin) << 32 | end;
+            }
+
+            static std::pair<uint32_t, uint32_t> unpack(uint64_t bounds)
+            {
+                return {uint32_t(bounds >> 32), uint32_t(bounds)};
+            }
+
+            bool pop_front(unsigned thread, size_t& chunk)
+            {
+                auto& bounds = m_ranges[thread].bounds;
+                auto value = bounds.load();
+                while (true)
+                {
+                    const auto [begin, end] = unpack(value);
+                    if (begin >= end)
+                        return false;
+                    if (bounds.compare_exchange_weak(value, pack(begin + 1, end)))
+                    {
+                        chunk = begin;
+                        return true;
+                    }
+                }
+            }
+
+            bool steal(unsigned thread, size_t& chunk)
+            {
+                const auto n = unsigned(m_ranges.size());
+                for (unsigned i = 1; i < n; ++i)
+                {
+                    auto& victim = m_ranges[(thread + i) % n].bounds;
+                    auto value = victim.load();
+                    while (true)
+                    {
+                        const auto [begin, end] = unpack(value);
+                        if (begin >= end)
+                            break;
+                        const auto mid = begin + (end - begin) / 2;
+                        if (victim.compare_exchange_weak(value, pack(begin, mid)))
+                        {
+                            chunk = mid;
+                            m_ranges[thread].bounds = pack(mid + 1, end);
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            std::vector<Range> m_ranges;
+        };
+    }
+
+    BatchParser::BatchParser(std::shared_ptr<const ParserData> data,
+                             BatchParseCallback callback)
+        : m_data(std::move(data)),
+          m_callback(std::move(callback))
+    {}
+
+    std::vector<BatchParseResult>
+    BatchParser::parse(std::span<const ArgumentSource> sources,
+                       unsigned thread_count) const
+    {
+        std::vector<BatchParseResult> results(sources.size());
+        const auto chunk_count = (sources.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        if (chunk_count > UINT32_MAX)
+            ARGOS_THROW("Too many command lines in batch.");
+
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        thread_count = unsigned(std::min<size_t>(thread_count, chunk_count));
+        if (thread_count == 0)
+            return results;
+
+        ChunkRanges ranges(chunk_count, thread_count);
+        std::atomic<bool> stop = false;
+#if ARGOS_EXCEPTIONS
+        std::mutex mutex;
+        std::exception_ptr exception;
+#endif
+
+        auto work = [&](unsigned thread)
+        {
+#if ARGOS_EXCEPTIONS
+            try
+            {
+#endif
+                Scratch scratch;
+                size_t chunk;
+                while (!stop && ranges.next(thread, chunk))
+                {
+                    const auto end = std::min((chunk + 1) * CHUNK_SIZE,
+                                              sources.size());
+                    for (auto i = chunk * CHUNK_SIZE; i < end; ++i)
+                        parse(sources[i], scratch, i, results[i]);
+                }
+#if ARGOS_EXCEPTIONS
+            }
+            catch (...)
+            {
+                // Exceptions from the batch callback, or other
+                // exceptions than ArgosException from option and
+                // argument callbacks.
+                std::lock_guard lock(mutex);
+                if (!exception)
+                    exception = std::current_exception();
+                stop = true;
+            }
+#endif
+        };
+
+        // If creating a thread throws, the destructors of the jthreads
+        // join the ones that are already running.
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1);
+        for (unsigned i = 1; i < thread_count; ++i)
+            threads.emplace_back(work, i);
+        work(0);
+        for (auto& thread : threads)
+            thread.join();
+
+#if ARGOS_EXCEPTIONS
+        if (exception)
+            std::rethrow_exception(exception);
+#endif
+        return results;
+    }
+
+    void BatchParser::parse(ArgumentSource source,
+                            Scratch& scratch,
+                            size_t index,
+                            BatchParseResult& result) const
+    {
+        // The previous result can only be reused if the callback
+        // didn't keep it.
+        auto& impl = scratch.result;
+        if (impl && impl.use_count() == 1 && !impl->has_shared_subcommands())
+            impl->clear();
+        else
+            impl = std::make_shared<ParsedArgumentsImpl>(&m_data->command, m_data);
+
+        ParseError error;
+        ArgumentIteratorImpl::parse_silently(source, m_data, impl, error);
+        result.result_code = impl->result_code();
+        if (error)
+            result.error_message = error.message();
+        if (m_callback)
+            m_callback(index, ParsedArguments(impl));
+    }
+}
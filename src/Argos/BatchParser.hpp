@@ -0,0 +1,52 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <span>
+#include "Argos/CompiledParser.hpp"
+
+namespace argos
+{
+    class ParsedArgumentsImpl;
+
+    /**
+     * @brief Parses many command lines with the same parser on a number
+     *  of threads.
+     *
+     * The command lines are split into chunks that are distributed
+     * evenly among the threads. A thread that runs out of chunks steals
+     * half of the remaining chunks of another thread.
+     */
+    class BatchParser
+    {
+    public:
+        BatchParser(std::shared_ptr<const ParserData> data,
+                    BatchParseCallback callback);
+
+        [[nodiscard]] std::vector<BatchParseResult>
+        parse(std::span<const ArgumentSource> sources,
+              unsigned thread_count) const;
+    private:
+        /**
+         * The state each thread reuses from one command line to the
+         * next.
+         */
+        struct Scratch
+        {
+            std::shared_ptr<ParsedArgumentsImpl> result;
+        };
+
+        void parse(ArgumentSource source,
+                   Scratch& scratch,
+                   size_t index,
+                   BatchParseResult& result) const;
+
+        std::shared_ptr<const ParserData> m_data;
+        BatchParseCallback m_callback;
+    };
+}
@@ -0,0 +1,148 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace argos
+{
+    /**
+     * @brief A set of bits that is compared with other sets one 64-bit
+     *  word at a time.
+     *
+     * A set only stores the words in the range of bits it was assigned,
+     * the bits outside the range are zero. Sets with different ranges
+     * can be compared, only the words they have in common are read.
+     * This keeps sets with a few bits that are close together small,
+     * even if the bits' positions are large.
+     */
+    class BitSet
+    {
+    public:
+        BitSet() = default;
+
+        /**
+         * @brief Creates a set where the bits in [0, @a size) can be
+         *  set.
+         */
+        explicit BitSet(size_t size)
+        {
+            assign(0, size);
+        }
+
+        /**
+         * @brief Makes room for the bits in [@a first, @a last) and sets
+         *  all bits to 0.
+         */
+        void assign(size_t first, size_t last)
+        {
+            m_offset = first / 64;
+            m_words.assign(first < last ? (last + 63) / 64 - m_offset : 0, 0);
+        }
+
+        void set(size_t index)
+        {
+            m_words[index / 64 - m_offset] |= uint64_t(1) << (index % 64);
+        }
+
+        void reset(size_t index)
+        {
+            m_words[index / 64 - m_offset] &= ~(uint64_t(1) << (index % 64));
+        }
+
+        /**
+         * @brief Sets all bits to 0.
+         */
+        void reset()
+        {
+            std::fill(m_words.begin(), m_words.end(), 0);
+        }
+
+        [[nodiscard]] bool test(size_t index) const
+        {
+            const auto i = index / 64 - m_offset;
+            return i < m_words.size() && (m_words[i] >> (index % 64)) & 1;
+        }
+
+        /**
+         * @brief Returns the number of bits that are set in both this
+         *  set and @a other.
+         */
+        [[nodiscard]] size_t count_common(const BitSet& other) const
+        {
+            size_t count = 0;
+            const auto [first, last] = common_words(other);
+            for (auto i = first; i < last; ++i)
+                count += std::popcount(word(i) & other.word(i));
+            return count;
+        }
+
+        /**
+         * @brief Returns true if at least one bit is set in both this
+         *  set and @a other.
+         */
+        [[nodiscard]] bool intersects(const BitSet& other) const
+        {
+            const auto [first, last] = common_words(other);
+            for (auto i = first; i < last; ++i)
+            {
+                if (word(i) & other.word(i))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Returns the index of the first bit that is set in this
+         *  set, but not in @a other.
+         */
+        [[nodiscard]] std::optional<size_t>
+        find_first_missing(const BitSet& other) const
+        {
+            for (size_t i = 0; i < m_words.size(); ++i)
+            {
+                const auto n = i + m_offset;
+                auto w = m_words[i];
+                if (n >= other.m_offset
+                    && n - other.m_offset < other.m_words.size())
+                {
+                    w &= ~other.word(n);
+                }
+                if (w)
+                    return n * 64 + size_t(std::countr_zero(w));
+            }
+            return {};
+        }
+    private:
+        /**
+         * @brief Returns word number @a n, counting from bit 0, which
+         *  must be one of the stored words.
+         */
+        [[nodiscard]] uint64_t word(size_t n) const
+        {
+            return m_words[n - m_offset];
+        }
+
+        [[nodiscard]] std::pair<size_t, size_t>
+        common_words(const BitSet& other) const
+        {
+            return {std::max(m_offset, other.m_offset),
+                    std::min(m_offset + m_words.size(),
+                             other.m_offset + other.m_words.size())};
+        }
+
+        /// The number of the first word in m_words, counting from bit 0.
+        size_t m_offset = 0;
+        std::vector<uint64_t> m_words;
+    };
+}
@@ -0,0 +1,55 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ChoiceSet.hpp"
+
+#include "ArgosThrow.hpp"
+#include "StringUtilities.hpp"
+
+namespace argos
+{
+    ChoiceSet::ChoiceSet() = default;
+
+    ChoiceSet::ChoiceSet(std::vector<std::string> values)
+        : m_values(std::move(values))
+    {}
+
+    bool ChoiceSet::empty() const
+    {
+        return m_values.empty();
+    }
+
+    const std::vector<std::string>& ChoiceSet::values() const
+    {
+        return m_values;
+    }
+
+    void ChoiceSet::build_index(bool case_insensitive)
+    {
+        m_case_insensitive = case_insensitive;
+        init_hash_slots(m_table, m_values.size());
+        for (size_t i = 0; i < m_values.size(); ++i)
+        {
+            if (find(m_values[i]))
+                ARGOS_THROW("Choice listed more than once: " + m_values[i]);
+            insert_hash_slot(m_table, hash(m_values[i]), i);
+        }
+    }
+
+    std::optional<size_t> ChoiceSet::find(std::string_view value) const
+    {
+        return find_hash_slot(m_table, hash(value), [&](size_t i)
+        {
+            return are_equal(m_values[i], value, m_case_insensitive);
+        });
+    }
+
+    uint32_t ChoiceSet::hash(std::string_view value) const
+    {
+        return hash_string(value, m_case_insensitive);
+    }
+}
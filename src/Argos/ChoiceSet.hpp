@@ -0,0 +1,52 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "HashSlots.hpp"
+
+namespace argos
+{
+    /**
+     * @brief The values an argument or option accepts, and a hash
+     *  table that finds a value's position in the list.
+     */
+    class ChoiceSet
+    {
+    public:
+        ChoiceSet();
+
+        explicit ChoiceSet(std::vector<std::string> values);
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] const std::vector<std::string>& values() const;
+
+        /**
+         * @brief Builds the hash table, which must be done before
+         *  find() is called.
+         *
+         * @throw ArgosException if two values are equal.
+         */
+        void build_index(bool case_insensitive);
+
+        /**
+         * @brief Returns the position of @a value in values().
+         */
+        [[nodiscard]] std::optional<size_t> find(std::string_view value) const;
+    private:
+        [[nodiscard]] uint32_t hash(std::string_view value) const;
+
+        std::vector<std::string> m_values;
+        HashSlots m_table;
+        bool m_case_insensitive = false;
+    };
+}
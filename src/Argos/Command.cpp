@@ -63,6 +63,20 @@ namespace argos
         return *this;
     }
 
+    Command& Command::add(Argument& argument, ValueHandle& handle)
+    {
+        return add(std::move(argument), handle);
+    }
+
+    Command& Command::add(Argument&& argument, ValueHandle& handle)
+    {
+        check_command();
+        const auto index = unsigned(data_->arguments.size());
+        data_->add(argument.release());
+        handle = ValueHandle(data_->handle_id, false, index);
+        return *this;
+    }
+
     Command& Command::add(Option& option)
     {
         return add(std::move(option));
@@ -75,6 +89,20 @@ namespace argos
         return *this;
     }
 
+    Command& Command::add(Option& option, ValueHandle& handle)
+    {
+        return add(std::move(option), handle);
+    }
+
+    Command& Command::add(Option&& option, ValueHandle& handle)
+    {
+        check_command();
+        const auto index = unsigned(data_->options.size());
+        data_->add(option.release());
+        handle = ValueHandle(data_->handle_id, true, index);
+        return *this;
+    }
+
     Command& Command::add(Command& command)
     {
         return add(std::move(command));
@@ -164,6 +192,15 @@ namespace argos
         return *this;
     }
 
+    Command& Command::lazy_definition(std::function<void(Command&)> callback)
+    {
+        check_command();
+        if (!callback)
+            ARGOS_THROW("The lazy definition callback is empty.");
+        data_->lazy_definition = std::make_unique<LazyDefinition>(std::move(callback));
+        return *this;
+    }
+
     Command& Command::copy_from(Command& command)
     {
         check_command();
@@ -171,6 +208,42 @@ namespace argos
         return *this;
     }
 
+    Command& Command::mutually_exclusive(std::vector<std::string> names)
+    {
+        check_command();
+        data_->add_constraint(ConstraintType::MUTUALLY_EXCLUSIVE,
+                              std::move(names));
+        return *this;
+    }
+
+    Command& Command::at_least_one_of(std::vector<std::string> names)
+    {
+        check_command();
+        data_->add_constraint(ConstraintType::AT_LEAST_ONE_OF,
+                              std::move(names));
+        return *this;
+    }
+
+    Command& Command::depends_on(std::string name,
+                                 std::vector<std::string> names)
+    {
+        check_command();
+        names.insert(names.begin(), std::move(name));
+        data_->add_constraint(ConstraintType::DEPENDS_ON,
+                              std::move(names));
+        return *this;
+    }
+
+    Command& Command::conflicts_with(std::string name,
+                                     std::vector<std::string> names)
+    {
+        check_command();
+        names.insert(names.begin(), std::move(name));
+        data_->add_constraint(ConstraintType::CONFLICTS_WITH,
+                              std::move(names));
+        return *this;
+    }
+
     std::unique_ptr<CommandData> Command::release()
     {
         return std::move(data_);
@@ -8,19 +8,48 @@
 #include "CommandData.hpp"
 
 #include <algorithm>
+#include "Argos/Command.hpp"
 #include "Argos/Option.hpp"
 #include "ArgosThrow.hpp"
+#include "ParseValue.hpp"
 #include "ParserData.hpp"
 #include "StringUtilities.hpp"
+#include "ValueBinding.hpp"
 
 namespace argos
 {
     constexpr char DEFAULT_HELP_TEXT[] = "Display this help text.";
 
-    CommandData::CommandData() = default;
+    namespace
+    {
+        std::unique_ptr<LazyDefinition>
+        copy_lazy_definition(const std::unique_ptr<LazyDefinition>& lazy)
+        {
+            // A lazy definition that has been used is already part of the
+            // copied command.
+            if (!lazy || !lazy->callback)
+                return {};
+            return std::make_unique<LazyDefinition>(lazy->callback);
+        }
+
+        unsigned make_handle_id()
+        {
+            static std::atomic<unsigned> next_id = 0;
+            return ++next_id;
+        }
+    }
+
+    LazyDefinition::LazyDefinition(std::function<void(Command&)> callback)
+        : callback(std::move(callback))
+    {}
+
+    CommandData::CommandData()
+        : handle_id(make_handle_id())
+    {}
 
     CommandData::CommandData(const CommandData& rhs)
-        : current_section(rhs.current_section),
+        : constraints(rhs.constraints),
+          current_section(rhs.current_section),
           name(rhs.name),
           full_name(rhs.full_name),
           texts(rhs.texts),
@@ -28,7 +57,9 @@ namespace argos
           multi_command(rhs.multi_command),
           section(rhs.section),
           id(rhs.id),
-          argument_id(rhs.argument_id)
+          argument_id(rhs.argument_id),
+          handle_id(rhs.handle_id),
+          lazy_definition(copy_lazy_definition(rhs.lazy_definition))
     {
         arguments.reserve(rhs.arguments.size());
         for (const auto& a : rhs.arguments)
@@ -45,6 +76,7 @@ namespace argos
         : arguments(std::move(rhs.arguments)),
           options(std::move(rhs.options)),
           commands(std::move(rhs.commands)),
+          constraints(std::move(rhs.constraints)),
           current_section(std::move(rhs.current_section)),
           name(std::move(rhs.name)),
           full_name(std::move(rhs.full_name)),
@@ -53,7 +85,9 @@ namespace argos
           multi_command(rhs.multi_command),
           section(std::move(rhs.section)),
           id(rhs.id),
-          argument_id(rhs.argument_id)
+          argument_id(rhs.argument_id),
+          handle_id(rhs.handle_id),
+          lazy_definition(std::move(rhs.lazy_definition))
     {
     }
 
@@ -63,6 +97,7 @@ namespace argos
     {
         if (&rhs == this)
             return *this;
+        constraints = rhs.constraints;
         current_section = rhs.current_section;
         name = rhs.name;
         full_name = rhs.full_name;
@@ -72,6 +107,8 @@ namespace argos
         section = rhs.section;
         id = rhs.id;
         argument_id = rhs.argument_id;
+        handle_id = rhs.handle_id;
+        lazy_definition = copy_lazy_definition(rhs.lazy_definition);
 
         arguments.clear();
         arguments.reserve(rhs.arguments.size());
@@ -103,11 +140,14 @@ namespace argos
         arguments = std::move(rhs.arguments);
         options = std::move(rhs.options);
         commands = std::move(rhs.commands);
+        constraints = std::move(rhs.constraints);
         require_subcommand = rhs.require_subcommand;
         multi_command = rhs.multi_command;
         section = std::move(rhs.section);
         id = rhs.id;
         argument_id = rhs.argument_id;
+        handle_id = rhs.handle_id;
+        lazy_definition = std::move(rhs.lazy_definition);
         return *this;
     }
 
@@ -148,8 +188,37 @@ namespace argos
         commands.push_back(std::move(cmd));
     }
 
+    void CommandData::add_constraint(ConstraintType type,
+                                     std::vector<std::string> names)
+    {
+        switch (type)
+        {
+        case ConstraintType::MUTUALLY_EXCLUSIVE:
+            if (names.size() < 2)
+                ARGOS_THROW("A mutually exclusive group must have at least two names.");
+            break;
+        case ConstraintType::AT_LEAST_ONE_OF:
+            if (names.empty())
+                ARGOS_THROW("An at-least-one-of group must have at least one name.");
+            break;
+        case ConstraintType::DEPENDS_ON:
+        case ConstraintType::CONFLICTS_WITH:
+            if (names.size() < 2)
+                ARGOS_THROW("A dependency or conflict must have at least two names.");
+            break;
+        }
+        constraints.push_back({type, std::move(names)});
+    }
+
     void CommandData::copy_from(const CommandData& cmd)
     {
+        if (cmd.lazy_definition && cmd.lazy_definition->callback)
+        {
+            Command definition(cmd.name);
+            cmd.lazy_definition->callback(definition);
+            copy_from(*definition.release());
+        }
+
         for (const auto& a : cmd.arguments)
             arguments.push_back(std::make_unique<ArgumentData>(*a));
 
@@ -159,6 +228,9 @@ namespace argos
         for (const auto& c : cmd.commands)
             commands.push_back(std::make_unique<CommandData>(*c));
 
+        constraints.insert(constraints.end(), cmd.constraints.begin(),
+                           cmd.constraints.end());
+
         for (const auto& [text_id, source] : cmd.texts)
         {
             if (texts.contains(text_id))
@@ -170,6 +242,26 @@ namespace argos
             multi_command = cmd.multi_command;
     }
 
+    void CommandData::add_definition(CommandData&& cmd)
+    {
+        // The handles that were created along with the definition are
+        // valid for this command if the indexes are the same.
+        if (arguments.empty() && options.empty())
+            handle_id = cmd.handle_id;
+        for (auto& a : cmd.arguments)
+            add(std::move(a));
+        for (auto& o : cmd.options)
+            add(std::move(o));
+        for (auto& c : cmd.commands)
+            add(std::move(c));
+        for (auto& c : cmd.constraints)
+            constraints.push_back(std::move(c));
+        if (!require_subcommand)
+            require_subcommand = cmd.require_subcommand;
+        if (!multi_command)
+            multi_command = cmd.multi_command;
+    }
+
     void CommandData::build_option_index(bool case_insensitive)
     {
         std::vector<std::pair<std::string_view, const OptionData*>> index;
@@ -193,7 +285,7 @@ namespace argos
 
         if (it == index.end())
         {
-            option_index = std::move(index);
+            option_index = OptionTrie(std::move(index), case_insensitive);
             return;
         }
 
@@ -208,61 +300,40 @@ namespace argos
     }
 
     const OptionData* CommandData::find_option(std::string_view flag,
-                                               bool allow_abbreviations,
-                                               bool case_insensitive) const
+                                               bool allow_abbreviations) const
     {
-        auto opt = find_option_impl(flag, allow_abbreviations,
-                                    case_insensitive);
-        if (opt == nullptr && flag.size() > 2 && flag.back() == '=')
-        {
-            flag = flag.substr(0, flag.size() - 1);
-            opt = find_option_impl(flag, allow_abbreviations,
-                                   case_insensitive);
-            if (opt && opt->argument.empty())
-                opt = nullptr;
-        }
-        return opt;
+        return option_index.find(flag, allow_abbreviations);
     }
 
-    const OptionData* CommandData::find_option_impl(std::string_view flag,
-                                                    bool allow_abbreviations,
-                                                    bool case_insensitive) const
+    void CommandData::build_command_index(bool case_insensitive)
     {
-        const auto it = std::lower_bound(
-            option_index.begin(), option_index.end(),
-            std::pair(flag, nullptr),
-            [&](auto& a, auto& b)
-            {
-                return is_less(a.first, b.first, case_insensitive);
-            });
-        if (it == option_index.end())
-            return nullptr;
-        if (it->first == flag)
-            return it->second;
-        if (case_insensitive && are_equal_ci(it->first, flag))
-            return it->second;
-        if (!allow_abbreviations)
-            return nullptr;
-        if (!starts_with(it->first, flag, case_insensitive))
-            return nullptr;
-        const auto nxt = next(it);
-        if (nxt != option_index.end()
-            && starts_with(nxt->first, flag, case_insensitive))
-        {
-            return nullptr;
-        }
-        return it->second;
+        command_index = CommandIndex(commands, case_insensitive);
     }
 
     const CommandData* CommandData::find_command(std::string_view cmd_name,
-                                                 bool case_insensitive) const
+                                                 bool allow_abbreviations) const
     {
-        for (const auto& c : commands)
-        {
-            if (are_equal(c->name, cmd_name, case_insensitive))
-                return c.get();
-        }
-        return nullptr;
+        return command_index.find(cmd_name, allow_abbreviations);
+    }
+
+    void CommandData::build_value_index()
+    {
+        values = ValueIndex(arguments, options);
+    }
+
+    const ValueIndex& CommandData::value_index() const
+    {
+        return values;
+    }
+
+    void CommandData::build_constraint_checker()
+    {
+        checker = ConstraintChecker(arguments, options, constraints, values);
+    }
+
+    const ConstraintChecker& CommandData::constraint_checker() const
+    {
+        return checker;
     }
 
     namespace
@@ -405,6 +476,199 @@ namespace argos
 
             return {ValueId(id_maker.id), ArgumentId(argument_id)};
         }
+
+        /**
+         * @brief Builds the hash table for @a choices, and gives values
+         *  with choices ValueType::CHOICE unless they have another type.
+         */
+        void update_choices(ChoiceSet& choices, ValueType& type,
+                            bool has_binding, bool case_insensitive)
+        {
+            if (choices.empty())
+                return;
+            choices.build_index(case_insensitive);
+            if (type == ValueType::STRING && !has_binding)
+                type = ValueType::CHOICE;
+        }
+
+        struct ValueProperties
+        {
+            std::map<ValueId, ValueType> types;
+            std::map<ValueId, const ValueBinding*> bindings;
+            std::map<ValueId, const ChoiceSet*> choices;
+            std::map<ValueId, char> separators;
+        };
+
+        void check_value_type(ValueProperties& props,
+                              ValueId value_id,
+                              ValueType type,
+                              const ValueBinding* binding,
+                              const ChoiceSet& choices,
+                              char separator,
+                              std::string_view name)
+        {
+            if (separator != '\0')
+            {
+                const auto [it, inserted] = props.separators.emplace(value_id,
+                                                                     separator);
+                if (!inserted && it->second != separator)
+                {
+                    ARGOS_THROW("Conflicting dictionary separators for "
+                                + std::string(name) + ".");
+                }
+            }
+
+            if (!choices.empty())
+            {
+                const auto [it, inserted] = props.choices.emplace(value_id,
+                                                                  &choices);
+                if (!inserted && it->second->values() != choices.values())
+                {
+                    ARGOS_THROW("Conflicting choices for "
+                                + std::string(name) + ".");
+                }
+            }
+
+            auto& types = props.types;
+            auto& bindings = props.bindings;
+            if (binding)
+            {
+                const auto [it, inserted] = bindings.emplace(value_id, binding);
+                if (!inserted && it->second != binding)
+                {
+                    ARGOS_THROW("Conflicting bindings for "
+                                + std::string(name) + ".");
+                }
+                if (type != binding->value_type())
+                {
+                    ARGOS_THROW("Conflicting value types for "
+                                + std::string(name) + ".");
+                }
+            }
+
+            if (type == ValueType::STRING)
+                return;
+            const auto [it, inserted] = types.emplace(value_id, type);
+            if (!inserted && it->second != type)
+            {
+                ARGOS_THROW("Conflicting value types for "
+                            + std::string(name) + ".");
+            }
+        }
+
+        /**
+         * @brief Verifies that arguments and options that share a value
+         *  have the same ValueType, binding, choices and dictionary
+         *  separator, and that the constants and initial values of
+         *  options are valid values.
+         */
+        void check_value_types(const CommandData& cmd)
+        {
+            ValueProperties props;
+            for (const auto& a : cmd.arguments)
+            {
+                check_value_type(props, a->value_id, a->value_type,
+                                 a->binding.get(), a->choices, '\0',
+                                 a->name);
+            }
+            for (const auto& o : cmd.options)
+            {
+                if (o->operation == OptionOperation::NONE)
+                    continue;
+                check_value_type(props, o->value_id, o->value_type,
+                                 o->binding.get(), o->choices,
+                                 o->dictionary_separator, o->flags.front());
+            }
+
+            for (const auto& [value_id, type] : props.types)
+            {
+                if (type == ValueType::CHOICE
+                    && !props.choices.contains(value_id))
+                {
+                    ARGOS_THROW("Values of type CHOICE require a list of choices.");
+                }
+            }
+
+            for (const auto& o : cmd.options)
+            {
+                if (o->operation == OptionOperation::NONE)
+                    continue;
+                const auto type_it = props.types.find(o->value_id);
+                const auto choice_it = props.choices.find(o->value_id);
+                const auto separator_it = props.separators.find(o->value_id);
+                if (type_it == props.types.end()
+                    && choice_it == props.choices.end()
+                    && separator_it == props.separators.end())
+                {
+                    continue;
+                }
+
+                const auto type = type_it != props.types.end()
+                                      ? type_it->second
+                                      : ValueType::STRING;
+                const auto* choices = choice_it != props.choices.end()
+                                          ? choice_it->second
+                                          : nullptr;
+                const auto separator = separator_it != props.separators.end()
+                                           ? separator_it->second
+                                           : '\0';
+                auto is_valid = [&](const std::string& str)
+                {
+                    TypedValue value;
+                    return parse_typed_value(str, type, choices, value)
+                           && (separator == '\0'
+                               || str.find(separator) != std::string::npos);
+                };
+                // CLEAR-options don't use their constant.
+                if (!o->constant.empty()
+                    && o->operation != OptionOperation::CLEAR
+                    && !is_valid(o->constant))
+                {
+                    ARGOS_THROW("Invalid constant for " + o->flags.front()
+                                + ": " + o->constant);
+                }
+                if (!o->initial_value.empty() && !is_valid(o->initial_value))
+                {
+                    ARGOS_THROW("Invalid initial value for " + o->flags.front()
+                                + ": " + o->initial_value);
+                }
+            }
+        }
+
+        // NOLINT(*-no-recursion)
+        void finish_definition(CommandData& cmd,
+                               const ParserData& data,
+                               ValueId start_id,
+                               ArgumentId argument_id)
+        {
+            const auto case_insensitive = data.parser_settings.case_insensitive;
+            for (auto& o : cmd.options)
+            {
+                validate_and_update(*o, data.parser_settings.option_style);
+                update_choices(o->choices, o->value_type, bool(o->binding),
+                               case_insensitive);
+            }
+            for (auto& a : cmd.arguments)
+            {
+                update_choices(a->choices, a->value_type, bool(a->binding),
+                               case_insensitive);
+            }
+            update_require_command(cmd);
+            add_help_option(cmd, data.parser_settings);
+
+            std::tie(start_id, argument_id) = set_internal_ids(cmd, start_id, argument_id);
+            check_value_types(cmd);
+            cmd.build_value_index();
+            cmd.build_constraint_checker();
+
+            cmd.build_option_index(data.parser_settings.case_insensitive);
+            cmd.build_command_index(data.parser_settings.case_insensitive);
+            for (auto& c : cmd.commands)
+            {
+                c->full_name = cmd.name + ' ' + c->name;
+                finish_initialization(*c, data, start_id, argument_id);
+            }
+        }
     }
 
     bool has_flag(const CommandData& cmd,
@@ -430,20 +694,86 @@ namespace argos
     {
         if (cmd.full_name.empty())
             cmd.full_name = cmd.name;
-        for (auto& o : cmd.options)
-            validate_and_update(*o, data.parser_settings.option_style);
-        update_require_command(cmd);
-        add_help_option(cmd, data.parser_settings);
 
         argument_id = ArgumentId(argument_id + 1);
         cmd.argument_id = argument_id;
-        std::tie(start_id, argument_id) = set_internal_ids(cmd, start_id, argument_id);
 
-        cmd.build_option_index(data.parser_settings.case_insensitive);
-        for (auto& c : cmd.commands)
+        if (cmd.lazy_definition && cmd.lazy_definition->callback)
         {
-            c->full_name = cmd.name + ' ' + c->name;
-            finish_initialization(*c, data, start_id, argument_id);
+            cmd.lazy_definition->data = &data;
+            cmd.lazy_definition->start_id = start_id;
+            cmd.lazy_definition->argument_id = argument_id;
+            return;
         }
+
+        finish_definition(cmd, data, start_id, argument_id);
+    }
+
+    void CommandData::ensure_defined() const
+    {
+        if (!lazy_definition)
+            return;
+
+        auto& lazy = *lazy_definition;
+        std::call_once(lazy.once, [&]
+        {
+            if (!lazy.callback)
+                return;
+
+            Command definition(name);
+            lazy.callback(definition);
+            // The definition is completed on a copy to leave the command
+            // unchanged if it is invalid. call_once lets the next call
+            // try again (and fail the same way) if this one throws.
+            CommandData cmd(*this);
+            cmd.lazy_definition = nullptr;
+            cmd.add_definition(std::move(*definition.release()));
+            if (lazy.data)
+            {
+                finish_definition(cmd, *lazy.data, lazy.start_id, lazy.argument_id);
+                std::vector<ValueBinding*> bindings;
+                cmd.collect_bindings(bindings);
+                // Like the command, the ParserData is only const because
+                // it is shared. parse_batch() doesn't reset or guard
+                // bound variables, the bindings are refused while a
+                // batch is running.
+                if (!bindings.empty()
+                    && !const_cast<ParserData*>(lazy.data)->bindings.add(bindings))
+                {
+                    ARGOS_THROW("The sub-command \"" + name
+                                + "\" has bound variables, it can't be"
+                                  " defined by parse_batch().");
+                }
+            }
+
+            // The command is const because it is part of a shared
+            // ParserData, but only this function modifies it, and it
+            // only does so once.
+            auto& self = const_cast<CommandData&>(*this);
+            self.arguments = std::move(cmd.arguments);
+            self.options = std::move(cmd.options);
+            self.commands = std::move(cmd.commands);
+            self.constraints = std::move(cmd.constraints);
+            self.require_subcommand = cmd.require_subcommand;
+            self.multi_command = cmd.multi_command;
+            self.handle_id = cmd.handle_id;
+            self.option_index = std::move(cmd.option_index);
+            self.command_index = std::move(cmd.command_index);
+            self.values = std::move(cmd.values);
+            self.checker = std::move(cmd.checker);
+            lazy.callback = nullptr;
+            lazy.defined = true;
+        });
+    }
+
+    void CommandData::collect_bindings(std::vector<ValueBinding*>& bindings) const
+    {
+        if (lazy_definition && !lazy_definition->defined)
+            return;
+
+        const auto own_bindings = values.bindings();
+        bindings.insert(bindings.end(), own_bindings.begin(), own_bindings.end());
+        for (const auto& cmd : commands)
+            cmd->collect_bindings(bindings);
     }
 }
@@ -6,13 +6,44 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include "ArgumentData.hpp"
+#include "CommandIndex.hpp"
+#include "ConstraintChecker.hpp"
 #include "OptionData.hpp"
+#include "OptionTrie.hpp"
+#include "ValueIndex.hpp"
 
 namespace argos
 {
+    class Command;
+    struct ParserData;
+
+    /**
+     * The part of a command's definition that is deferred until the
+     * command is needed.
+     */
+    struct LazyDefinition
+    {
+        explicit LazyDefinition(std::function<void(Command&)> callback);
+
+        /// Adds the command's arguments, options and sub-commands. It is
+        /// set to nullptr once it has been called.
+        std::function<void(Command&)> callback;
+        std::once_flag once;
+        /// The values finish_initialization() would have used for
+        /// the command.
+        const ParserData* data = nullptr;
+        ValueId start_id = {};
+        ArgumentId argument_id = {};
+        /// Set when the definition has been added to the command.
+        std::atomic<bool> defined = false;
+    };
+
     struct CommandData
     {
         CommandData();
@@ -33,22 +64,87 @@ namespace argos
 
         void add(std::unique_ptr<CommandData> cmd);
 
+        /**
+         * @brief Adds a constraint, the first name is the argument or
+         *  option it applies to if @a type is DEPENDS_ON or
+         *  CONFLICTS_WITH.
+         */
+        void add_constraint(ConstraintType type,
+                            std::vector<std::string> names);
+
         void copy_from(const CommandData& cmd);
 
+        /**
+         * @brief Completes the definition of a command with a lazy
+         *  definition, does nothing for other commands.
+         *
+         * The arguments, options and sub-commands of a lazily defined
+         * command are only available after this function has been
+         * called. It can safely be called from multiple threads.
+         */
+        void ensure_defined() const;
+
         void build_option_index(bool case_insensitive);
 
+        void build_command_index(bool case_insensitive);
+
+        /**
+         * @brief Builds the index returned by value_index(), the IDs of
+         *  the arguments and options must have been assigned.
+         */
+        void build_value_index();
+
+        /**
+         * @brief Builds the checker returned by constraint_checker(),
+         *  the value index must have been built.
+         */
+        void build_constraint_checker();
+
+        /**
+         * @brief Returns the option with the given flag.
+         *
+         * Flags are compared case-insensitively if build_option_index()
+         * was called with case_insensitive set to true.
+         */
         [[nodiscard]] const OptionData*
         find_option(std::string_view flag,
-                    bool allow_abbreviations,
-                    bool case_insensitive) const;
+                    bool allow_abbreviations) const;
 
+        /**
+         * @brief Returns the sub-command with the given name.
+         *
+         * Names are compared case-insensitively if build_command_index()
+         * was called with case_insensitive set to true.
+         */
         [[nodiscard]] const CommandData*
         find_command(std::string_view cmd_name,
-                     bool case_insensitive) const;
+                     bool allow_abbreviations) const;
+
+        /**
+         * @brief Returns the index of the command's values and
+         *  argument IDs.
+         */
+        [[nodiscard]] const ValueIndex& value_index() const;
+
+        /**
+         * @brief Returns the checker for the command's mandatory options
+         *  and constraints.
+         */
+        [[nodiscard]] const ConstraintChecker& constraint_checker() const;
+
+        /**
+         * @brief Adds the bindings of the arguments and options of this
+         *  command and its sub-commands to @a bindings.
+         *
+         * Lazily defined sub-commands that haven't been defined yet
+         * are skipped.
+         */
+        void collect_bindings(std::vector<ValueBinding*>& bindings) const;
 
         std::vector<std::unique_ptr<ArgumentData>> arguments;
         std::vector<std::unique_ptr<OptionData>> options;
         std::vector<std::unique_ptr<CommandData>> commands;
+        std::vector<ConstraintData> constraints;
         std::string current_section;
 
         std::string name;
@@ -64,18 +160,26 @@ namespace argos
         std::string section;
         int id = 0;
         ArgumentId argument_id = {};
+        /**
+         * Identifies the command in the ValueHandles of its arguments
+         * and options. Copies of a command have the same handle_id.
+         */
+        unsigned handle_id;
+        std::unique_ptr<LazyDefinition> lazy_definition;
 
     private:
-        [[nodiscard]] const OptionData*
-        find_option_impl(std::string_view flag,
-                         bool allow_abbreviations,
-                         bool case_insensitive) const;
+        /**
+         * @brief Moves the arguments, options and sub-commands of @a cmd
+         *  to this command.
+         */
+        void add_definition(CommandData&& cmd);
 
-        std::vector<std::pair<std::string_view, const OptionData*>> option_index;
+        OptionTrie option_index;
+        CommandIndex command_index;
+        ValueIndex values;
+        ConstraintChecker checker;
     };
 
-    struct ParserData;
-
     /**
      * Finish the initialization of this command and any subcommands, and
      * make them ready for parsing arguments.
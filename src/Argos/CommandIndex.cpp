@@ -0,0 +1,96 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "CommandIndex.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include "ArgosThrow.hpp"
+#include "CommandData.hpp"
+
+namespace argos
+{
+    CommandIndex::CommandIndex() = default;
+
+    CommandIndex::CommandIndex(
+        const std::vector<std::unique_ptr<CommandData>>& commands,
+        bool case_insensitive)
+        : m_case_insensitive(case_insensitive)
+    {
+        m_index.reserve(commands.size());
+        for (const auto& cmd : commands)
+        {
+            auto& [name, command] = m_index.emplace_back(cmd->name, cmd.get());
+            for (auto& c : name)
+                c = fold(c);
+        }
+
+        std::sort(m_index.begin(), m_index.end());
+
+        const auto it = std::adjacent_find(
+            m_index.begin(), m_index.end(),
+            [](const auto& a, const auto& b) { return a.first == b.first; });
+        if (it != m_index.end())
+        {
+            ARGOS_THROW("Multiple definitions of command "
+                        + it->second->name);
+        }
+    }
+
+    const CommandData*
+    CommandIndex::find(std::string_view name, bool allow_abbreviations) const
+    {
+        // Compares like std::string's operator<, i.e. with the characters
+        // as unsigned.
+        const auto it = std::lower_bound(
+            m_index.begin(), m_index.end(), name,
+            [&](const auto& entry, std::string_view str)
+            {
+                const std::string_view key = entry.first;
+                const auto size = std::min(key.size(), str.size());
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const auto a = uint8_t(key[i]);
+                    const auto b = uint8_t(fold(str[i]));
+                    if (a != b)
+                        return a < b;
+                }
+                return key.size() < str.size();
+            });
+
+        if (it == m_index.end() || !is_prefix(name, it->first))
+            return nullptr;
+        if (it->first.size() == name.size())
+            return it->second;
+        if (!allow_abbreviations)
+            return nullptr;
+        const auto nxt = std::next(it);
+        if (nxt != m_index.end() && is_prefix(name, nxt->first))
+            return nullptr;
+        return it->second;
+    }
+
+    char CommandIndex::fold(char c) const
+    {
+        if (m_case_insensitive && 'a' <= c && c <= 'z')
+            return char(c - ('a' - 'A'));
+        return c;
+    }
+
+    bool CommandIndex::is_prefix(std::string_view name,
+                                 std::string_view key) const
+    {
+        if (key.size() < name.size())
+            return false;
+        for (size_t i = 0; i < name.size(); ++i)
+        {
+            if (key[i] != fold(name[i]))
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,57 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace argos
+{
+    struct CommandData;
+
+    /**
+     * @brief A sorted index of the names of a command's sub-commands.
+     *
+     * The names are case folded when the index is built if it is
+     * case-insensitive, lookups only fold the characters of the name
+     * they are looking for.
+     */
+    class CommandIndex
+    {
+    public:
+        CommandIndex();
+
+        /**
+         * @throw ArgosException if two commands have the same name.
+         */
+        CommandIndex(const std::vector<std::unique_ptr<CommandData>>& commands,
+                     bool case_insensitive);
+
+        /**
+         * @brief Returns the command named @a name.
+         *
+         * If @a allow_abbreviations is true, @a name can also be a prefix
+         * of the name of a single command.
+         */
+        [[nodiscard]] const CommandData*
+        find(std::string_view name, bool allow_abbreviations) const;
+    private:
+        [[nodiscard]] char fold(char c) const;
+
+        /**
+         * @brief Returns true if @a name is a prefix of @a key.
+         */
+        [[nodiscard]] bool is_prefix(std::string_view name,
+                                     std::string_view key) const;
+
+        std::vector<std::pair<std::string, const CommandData*>> m_index;
+        bool m_case_insensitive = false;
+    };
+}
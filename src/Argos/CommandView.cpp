@@ -59,6 +59,7 @@ namespace argos
 
     std::vector<ArgumentView> CommandView::arguments() const
     {
+        m_command->ensure_defined();
         std::vector<ArgumentView> result;
         for (const auto& arg : m_command->arguments)
             result.emplace_back(arg.get());
@@ -67,6 +68,7 @@ namespace argos
 
     std::vector<OptionView> CommandView::options() const
     {
+        m_command->ensure_defined();
         std::vector<OptionView> result;
         for (const auto& opt : m_command->options)
             result.emplace_back(opt.get());
@@ -75,6 +77,7 @@ namespace argos
 
     std::vector<CommandView> CommandView::subcommands() const
     {
+        m_command->ensure_defined();
         std::vector<CommandView> result;
         for (const auto& cmd : m_command->commands)
             result.emplace_back(cmd.get());
@@ -86,6 +89,7 @@ namespace argos
         // Instances of CommandView are only created after require_subcommand
         // has been automatically set, the or-value should therefore never
         // be returned, and it doesn't matter that it might not be correct.
+        m_command->ensure_defined();
         return m_command->require_subcommand.value_or(false);
     }
 }
@@ -0,0 +1,180 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Argos/CompiledParser.hpp"
+
+#include "ArgosThrow.hpp"
+#include "ArgumentIteratorImpl.hpp"
+#include "BatchParser.hpp"
+#include "HelpText.hpp"
+#include "ParserData.hpp"
+
+namespace argos
+{
+    namespace
+    {
+        /**
+         * @brief Keeps lazily defined sub-commands from adding bindings
+         *  while a batch is parsed.
+         */
+        class BatchGuard
+        {
+        public:
+            explicit BatchGuard(const BindingList& bindings)
+                : m_bindings(bindings)
+            {
+                m_bindings.begin_batch();
+            }
+
+            BatchGuard(const BatchGuard&) = delete;
+
+            ~BatchGuard()
+            {
+                m_bindings.end_batch();
+            }
+
+            BatchGuard& operator=(const BatchGuard&) = delete;
+        private:
+            const BindingList& m_bindings;
+        };
+    }
+
+    CompiledParser::CompiledParser(std::shared_ptr<const ParserData> data)
+        : m_data(std::move(data))
+    {
+        if (!m_data)
+            ARGOS_THROW("CompiledParser requires parser data.");
+    }
+
+    ParsedArguments CompiledParser::parse(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return parse_source({});
+        return parse_source({argv + 1, size_t(argc - 1)});
+    }
+
+    ParsedArguments
+    CompiledParser::parse(std::vector<std::string_view> args) const
+    {
+        return parse_source(ArgumentSource(args));
+    }
+
+    ParseResult CompiledParser::try_parse(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return try_parse_source({});
+        return try_parse_source({argv + 1, size_t(argc - 1)});
+    }
+
+    ParseResult
+    CompiledParser::try_parse(std::vector<std::string_view> args) const
+    {
+        return try_parse_source(ArgumentSource(args));
+    }
+
+    void CompiledParser::parse_into(ParsedArguments& result,
+                                    int argc, char** argv) const
+    {
+        if (argc <= 0)
+            return parse_source_into(result, {});
+        parse_source_into(result, {argv + 1, size_t(argc - 1)});
+    }
+
+    ArgumentIterator CompiledParser::make_iterator(int argc, char** argv) const
+    {
+        if (argc <= 0)
+            ARGOS_THROW("argc and argv must at least contain the command name.");
+        return make_iterator(std::vector<std::string_view>(argv + 1, argv + argc));
+    }
+
+    ArgumentIterator
+    CompiledParser::make_iterator(std::vector<std::string_view> args) const
+    {
+        return {std::move(args), m_data};
+    }
+
+    IncrementalParser CompiledParser::make_incremental_parser() const
+    {
+        return IncrementalParser(m_data);
+    }
+
+    ParsedArguments CompiledParser::parse_source(ArgumentSource args) const
+    {
+        return ParsedArguments(ArgumentIteratorImpl::parse(args, m_data));
+    }
+
+    void CompiledParser::parse_source_into(ParsedArguments& result,
+                                           ArgumentSource args) const
+    {
+        result.m_impl = ArgumentIteratorImpl::parse(args, m_data,
+                                                    reuse_or_create(result));
+    }
+
+    ParseResult CompiledParser::try_parse_source(ArgumentSource args) const
+    {
+        ParseError error;
+        auto impl = ArgumentIteratorImpl::parse_silently(args, m_data, {},
+                                                         error);
+        return {ParsedArguments(std::move(impl)), std::move(error)};
+    }
+
+    ParseError CompiledParser::try_parse_source_into(ParsedArguments& result,
+                                                     ArgumentSource args) const
+    {
+        ParseError error;
+        result.m_impl = ArgumentIteratorImpl::parse_silently(
+            args, m_data, reuse_or_create(result), error);
+        return error;
+    }
+
+    std::shared_ptr<ParsedArgumentsImpl>
+    CompiledParser::reuse_or_create(ParsedArguments& result) const
+    {
+        auto& impl = result.m_impl;
+        if (impl && impl.use_count() == 1 && impl->parser_data() == m_data
+            && !impl->has_shared_subcommands())
+        {
+            impl->clear();
+            return std::move(impl);
+        }
+        return {};
+    }
+
+    std::vector<BatchParseResult>
+    CompiledParser::parse_batch_sources(std::span<const ArgumentSource> sources,
+                                        unsigned thread_count,
+                                        const BatchParseCallback& callback) const
+    {
+        BatchGuard guard(m_data->bindings);
+        return BatchParser(m_data, callback).parse(sources, thread_count);
+    }
+
+    const std::string& CompiledParser::program_name() const
+    {
+        return m_data->command.name;
+    }
+
+    void CompiledParser::write_help_text() const
+    {
+        write_subcommand_help_text({});
+    }
+
+    void CompiledParser::write_subcommand_help_text(
+        const std::vector<std::string>& path) const
+    {
+        const auto* cmd = &m_data->command;
+        for (auto& name : path)
+        {
+            cmd = cmd->find_command(
+                name, m_data->parser_settings.allow_abbreviated_commands);
+            if (!cmd)
+                ARGOS_THROW("Unknown command: " + name);
+            cmd->ensure_defined();
+        }
+        argos::write_help_text(*m_data, *cmd);
+    }
+}
@@ -0,0 +1,227 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ConstraintChecker.hpp"
+
+#include <algorithm>
+#include <map>
+#include "ArgosThrow.hpp"
+#include "ArgumentData.hpp"
+#include "OptionData.hpp"
+#include "ValueIndex.hpp"
+
+namespace argos
+{
+    struct ConstraintChecker::Constraint
+    {
+        ConstraintType type = ConstraintType::MUTUALLY_EXCLUSIVE;
+        /// The position of the first name for DEPENDS_ON and
+        /// CONFLICTS_WITH.
+        size_t subject = 0;
+        /// The positions of the other names.
+        BitSet members;
+        /// The positions of all the names, in the order they were
+        /// defined, and the names.
+        std::vector<std::pair<size_t, std::string>> names;
+    };
+
+    namespace
+    {
+        using NameMap = std::map<std::string_view, ArgumentId>;
+
+        NameMap make_name_map(
+            const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+            const std::vector<std::unique_ptr<OptionData>>& options)
+        {
+            NameMap result;
+            for (const auto& a : arguments)
+            {
+                // Argument names don't have to be unique, an empty
+                // ArgumentId marks the ones that aren't.
+                const auto [it, inserted] = result.emplace(a->name,
+                                                           a->argument_id);
+                if (!inserted)
+                    it->second = {};
+            }
+            for (const auto& o : options)
+            {
+                for (const auto& flag : o->flags)
+                    result.emplace(flag, o->argument_id);
+            }
+            return result;
+        }
+
+        size_t get_position(const NameMap& names,
+                            const std::string& name,
+                            ArgumentId first_argument_id)
+        {
+            const auto it = names.find(name);
+            if (it == names.end())
+                ARGOS_THROW("Unknown option or argument in constraint: " + name);
+            if (it->second == ArgumentId{})
+                ARGOS_THROW("Ambiguous argument name in constraint: " + name);
+            return size_t(it->second) - size_t(first_argument_id);
+        }
+
+        std::string join_names(
+            const std::vector<std::pair<size_t, std::string>>& names)
+        {
+            std::string result;
+            for (const auto& [_, name] : names)
+            {
+                if (!result.empty())
+                    result += ", ";
+                result += name;
+            }
+            return result;
+        }
+    }
+
+    ConstraintChecker::ConstraintChecker() = default;
+
+    ConstraintChecker::ConstraintChecker(
+        const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+        const std::vector<std::unique_ptr<OptionData>>& options,
+        const std::vector<ConstraintData>& constraints,
+        const ValueIndex& index)
+        : m_first_value_id(index.first_value_id()),
+          m_first_argument_id(index.first_argument_id())
+    {
+        m_mandatory_values.assign(0, index.values().size());
+        m_mandatory_flags.assign(0, index.argument_count());
+        for (const auto& o : options)
+        {
+            if (o->optional)
+                continue;
+            m_mandatory_options.push_back(o.get());
+            if (o->operation == OptionOperation::NONE)
+                m_mandatory_flags.set(size_t(o->argument_id - m_first_argument_id));
+            else
+                m_mandatory_values.set(size_t(o->value_id - m_first_value_id));
+        }
+
+        if (constraints.empty())
+            return;
+
+        const auto names = make_name_map(arguments, options);
+        for (const auto& c : constraints)
+        {
+            auto& constraint = m_constraints.emplace_back();
+            constraint.type = c.type;
+            BitSet positions(index.argument_count());
+            for (const auto& name : c.names)
+            {
+                const auto pos = get_position(names, name, m_first_argument_id);
+                if (positions.test(pos))
+                {
+                    ARGOS_THROW("Option or argument is used twice in a constraint: "
+                                + name);
+                }
+                positions.set(pos);
+                constraint.names.emplace_back(pos, name);
+            }
+
+            auto it = constraint.names.begin();
+            if (c.type == ConstraintType::DEPENDS_ON
+                || c.type == ConstraintType::CONFLICTS_WITH)
+            {
+                constraint.subject = it->first;
+                ++it;
+            }
+            // The members' bits are usually close together, only the
+            // words between the first and last are stored.
+            const auto [lo, hi] = std::minmax_element(
+                it, constraint.names.end(),
+                [](auto& a, auto& b) {return a.first < b.first;});
+            constraint.members.assign(lo->first, hi->first + 1);
+            for (; it != constraint.names.end(); ++it)
+                constraint.members.set(it->first);
+        }
+    }
+
+    ConstraintChecker::ConstraintChecker(ConstraintChecker&&) noexcept = default;
+
+    ConstraintChecker::~ConstraintChecker() = default;
+
+    ConstraintChecker&
+    ConstraintChecker::operator=(ConstraintChecker&&) noexcept = default;
+
+    const OptionData*
+    ConstraintChecker::find_missing_option(const BitSet& values,
+                                           const BitSet& given) const
+    {
+        if (!m_mandatory_values.find_first_missing(values)
+            && !m_mandatory_flags.find_first_missing(given))
+        {
+            return nullptr;
+        }
+
+        // Report the missing options in the order they were defined,
+        // which isn't necessarily the order of their values.
+        for (const auto* o : m_mandatory_options)
+        {
+            const auto found = o->operation == OptionOperation::NONE
+                ? given.test(size_t(o->argument_id - m_first_argument_id))
+                : values.test(size_t(o->value_id - m_first_value_id));
+            if (!found)
+                return o;
+        }
+        return nullptr;
+    }
+
+    std::string ConstraintChecker::check_constraints(const BitSet& given) const
+    {
+        for (const auto& c : m_constraints)
+        {
+            switch (c.type)
+            {
+            case ConstraintType::MUTUALLY_EXCLUSIVE:
+                if (c.members.count_common(given) > 1)
+                {
+                    std::vector<std::string_view> found;
+                    for (const auto& [pos, name] : c.names)
+                    {
+                        if (given.test(pos))
+                            found.push_back(name);
+                    }
+                    return std::string(found[0]) + " cannot be used with "
+                           + std::string(found[1]) + ".";
+                }
+                break;
+            case ConstraintType::AT_LEAST_ONE_OF:
+                if (!c.members.intersects(given))
+                    return "At least one of these is required: "
+                           + join_names(c.names);
+                break;
+            case ConstraintType::DEPENDS_ON:
+                if (!given.test(c.subject)
+                    || !c.members.find_first_missing(given))
+                {
+                    break;
+                }
+                for (auto it = c.names.begin() + 1; it != c.names.end(); ++it)
+                {
+                    if (!given.test(it->first))
+                        return c.names.front().second + " requires "
+                               + it->second + ".";
+                }
+                break;
+            case ConstraintType::CONFLICTS_WITH:
+                if (!given.test(c.subject) || !c.members.intersects(given))
+                    break;
+                for (const auto& [pos, name] : c.names)
+                {
+                    if (pos != c.subject && given.test(pos))
+                        return c.names.front().second
+                               + " cannot be used with " + name + ".";
+                }
+                break;
+            }
+        }
+        return {};
+    }
+}
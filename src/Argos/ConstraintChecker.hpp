@@ -0,0 +1,107 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "Argos/ArgumentValue.hpp"
+#include "BitSet.hpp"
+
+namespace argos
+{
+    struct ArgumentData;
+    struct OptionData;
+    class ValueIndex;
+
+    enum class ConstraintType
+    {
+        /// At most one of the arguments and options can be given.
+        MUTUALLY_EXCLUSIVE,
+        /// At least one of the arguments and options must be given.
+        AT_LEAST_ONE_OF,
+        /// If the first argument or option is given, all the others
+        /// must be given too.
+        DEPENDS_ON,
+        /// If the first argument or option is given, none of the
+        /// others can be given.
+        CONFLICTS_WITH
+    };
+
+    /**
+     * @brief A constraint as it was defined, the names are flags and
+     *  argument names.
+     */
+    struct ConstraintData
+    {
+        ConstraintType type = ConstraintType::MUTUALLY_EXCLUSIVE;
+        std::vector<std::string> names;
+    };
+
+    /**
+     * @brief Checks the mandatory options and the constraints of a
+     *  command.
+     *
+     * Arguments and options are identified by their position in the
+     * command, i.e. argument_id - ValueIndex::first_argument_id(), and
+     * values by value_id - ValueIndex::first_value_id(). The checks
+     * compare bit sets with these positions a word at a time, the
+     * options are only looked at to produce an error message.
+     */
+    class ConstraintChecker
+    {
+    public:
+        ConstraintChecker();
+
+        /**
+         * @brief Resolves the names in @a constraints to positions in
+         *  @a index.
+         *
+         * Throws ArgosException if a name isn't a flag or argument name
+         * in the command.
+         */
+        ConstraintChecker(
+            const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+            const std::vector<std::unique_ptr<OptionData>>& options,
+            const std::vector<ConstraintData>& constraints,
+            const ValueIndex& index);
+
+        ConstraintChecker(ConstraintChecker&&) noexcept;
+
+        ~ConstraintChecker();
+
+        ConstraintChecker& operator=(ConstraintChecker&&) noexcept;
+
+        /**
+         * @brief Returns the first mandatory option that is missing.
+         *
+         * @a values has the positions of the values that are set,
+         * @a given has the positions of the arguments and options that
+         * have been given.
+         */
+        [[nodiscard]] const OptionData*
+        find_missing_option(const BitSet& values, const BitSet& given) const;
+
+        /**
+         * @brief Returns an error message for the first constraint
+         *  that is violated by @a given, or an empty string.
+         */
+        [[nodiscard]] std::string check_constraints(const BitSet& given) const;
+    private:
+        struct Constraint;
+
+        /// The mandatory options in the order they were defined.
+        std::vector<const OptionData*> m_mandatory_options;
+        /// The values of the mandatory options.
+        BitSet m_mandatory_values;
+        /// The mandatory options that don't have a value.
+        BitSet m_mandatory_flags;
+        ValueId m_first_value_id = {};
+        ArgumentId m_first_argument_id = {};
+        std::vector<Constraint> m_constraints;
+    };
+}
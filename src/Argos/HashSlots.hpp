@@ -0,0 +1,78 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace argos
+{
+    /**
+     * @brief The slots of a hash table that finds strings in a list
+     *  that is stored elsewhere.
+     *
+     * The table is open addressing with linear probing, and is at most
+     * half full. Each slot holds the hash of a string and the string's
+     * position in the list + 1, zero marks an empty slot. A lookup
+     * therefore normally makes a single string comparison regardless of
+     * the number of strings.
+     */
+    using HashSlots = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    /**
+     * @brief Makes @a slots an empty table with room for @a count
+     *  strings.
+     */
+    inline void init_hash_slots(HashSlots& slots, size_t count)
+    {
+        slots.assign(std::bit_ceil(2 * count), {0, 0});
+    }
+
+    /**
+     * @brief Adds the string at @a index, whose hash is @a hash, to
+     *  @a slots.
+     *
+     * The string must not be in the table already, and the table must
+     * have been made with room for it.
+     */
+    inline void insert_hash_slot(HashSlots& slots, uint32_t hash, size_t index)
+    {
+        const auto mask = slots.size() - 1;
+        auto i = hash & mask;
+        while (slots[i].second != 0)
+            i = (i + 1) & mask;
+        slots[i] = {hash, uint32_t(index + 1)};
+    }
+
+    /**
+     * @brief Returns the position of the string whose hash is @a hash
+     *  and for which @a is_match returns true.
+     *
+     * @a is_match is called with the positions of the strings that have
+     * the same hash.
+     */
+    template <typename IsMatch>
+    std::optional<size_t> find_hash_slot(const HashSlots& slots,
+                                         uint32_t hash,
+                                         IsMatch is_match)
+    {
+        if (slots.empty())
+            return {};
+
+        const auto mask = slots.size() - 1;
+        for (auto i = hash & mask; slots[i].second != 0; i = (i + 1) & mask)
+        {
+            const auto [slot_hash, index] = slots[i];
+            if (slot_hash == hash && is_match(size_t(index - 1)))
+                return index - 1;
+        }
+        return {};
+    }
+}
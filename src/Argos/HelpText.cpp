@@ -479,4 +479,19 @@ namespace argos
         else
             write_error_message(data, cmd, msg);
     }
+
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg)
+    {
+        return cmd.full_name + ": " + msg;
+    }
+
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg,
+                                  ArgumentId argument_id)
+    {
+        if (const auto name = get_name(cmd, argument_id); !name.empty())
+            return get_error_message(cmd, name + ": " + msg);
+        return get_error_message(cmd, msg);
+    }
 }
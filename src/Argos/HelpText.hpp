@@ -21,4 +21,15 @@ namespace argos
                              const CommandData& cmd,
                              const std::string& msg,
                              ArgumentId argument_id);
+
+    /**
+     * @brief Returns the first line of the error message that
+     *  write_error_message() writes, without any line breaks.
+     */
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg);
+
+    std::string get_error_message(const CommandData& cmd,
+                                  const std::string& msg,
+                                  ArgumentId argument_id);
 }
@@ -0,0 +1,91 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Argos/IncrementalParser.hpp"
+
+#include "ArgosThrow.hpp"
+#include "ArgumentIteratorImpl.hpp"
+
+namespace argos
+{
+    IncrementalParser::IncrementalParser(std::shared_ptr<const ParserData> parser_data)
+        : m_impl(std::make_unique<ArgumentIteratorImpl>(std::move(parser_data)))
+    {}
+
+    IncrementalParser::IncrementalParser(IncrementalParser&& rhs) noexcept
+        : m_impl(std::move(rhs.m_impl))
+    {}
+
+    IncrementalParser::~IncrementalParser() = default;
+
+    IncrementalParser&
+    IncrementalParser::operator=(IncrementalParser&& rhs) noexcept
+    {
+        m_impl = std::move(rhs.m_impl);
+        return *this;
+    }
+
+    IncrementalParser& IncrementalParser::max_lookahead(size_t n)
+    {
+        impl().set_max_lookahead(n);
+        return *this;
+    }
+
+    IncrementalParser& IncrementalParser::store_argument_values(bool value)
+    {
+        impl().set_store_argument_values(value);
+        return *this;
+    }
+
+    void IncrementalParser::push(std::string_view arg)
+    {
+        impl().push(arg);
+    }
+
+    void IncrementalParser::finish()
+    {
+        impl().finish();
+    }
+
+    IncrementalResult
+    IncrementalParser::next(std::unique_ptr<IArgumentView>& arg,
+                            std::string_view& value)
+    {
+        const auto result = impl().next();
+        if (get_result_view(result, arg, value))
+            return IncrementalResult::PROCESSED;
+
+        switch (std::get<0>(result))
+        {
+        case IteratorResultCode::INCOMPLETE:
+            return IncrementalResult::NEED_INPUT;
+        case IteratorResultCode::ERROR:
+            return IncrementalResult::FAILURE;
+        default:
+            return IncrementalResult::DONE;
+        }
+    }
+
+    ParsedArguments IncrementalParser::parsed_arguments() const
+    {
+        return ParsedArguments(impl().toplevel_parsed_arguments());
+    }
+
+    ArgumentIteratorImpl& IncrementalParser::impl()
+    {
+        if (!m_impl)
+            ARGOS_THROW("This IncrementalParser has been moved from.");
+        return *m_impl;
+    }
+
+    const ArgumentIteratorImpl& IncrementalParser::impl() const
+    {
+        if (!m_impl)
+            ARGOS_THROW("This IncrementalParser has been moved from.");
+        return *m_impl;
+    }
+}
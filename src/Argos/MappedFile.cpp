@@ -0,0 +1,147 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MappedFile.hpp"
+
+#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#elif defined(WIN32)
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fstream>
+#endif
+
+namespace argos
+{
+    MappedFile::MappedFile() = default;
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    std::span<char> MappedFile::data() const
+    {
+        return {m_data, m_size};
+    }
+
+#if defined(__APPLE__) || defined(unix) || defined(__unix) || defined(__unix__)
+
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            return false;
+
+        struct stat st = {};
+        bool success = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+        if (success && st.st_size != 0)
+        {
+            auto ptr = mmap(nullptr, size_t(st.st_size),
+                            PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                m_data = static_cast<char*>(ptr);
+                m_size = size_t(st.st_size);
+            }
+            else
+            {
+                success = false;
+            }
+        }
+        ::close(fd);
+        return success;
+    }
+
+    void MappedFile::close()
+    {
+        if (m_data)
+            munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+#elif defined(WIN32)
+
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                                        FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size = {};
+        bool success = GetFileSizeEx(file, &size) != 0;
+        if (success && size.QuadPart != 0)
+        {
+            success = false;
+            const HANDLE mapping = CreateFileMappingA(file, nullptr,
+                                                      PAGE_WRITECOPY,
+                                                      0, 0, nullptr);
+            if (mapping)
+            {
+                auto ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                if (ptr)
+                {
+                    m_data = static_cast<char*>(ptr);
+                    m_size = size_t(size.QuadPart);
+                    success = true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        return success;
+    }
+
+    void MappedFile::close()
+    {
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+#else
+
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+
+        const auto size = size_t(file.tellg());
+        file.seekg(0);
+        m_buffer = std::make_unique<char[]>(size);
+        if (!file.read(m_buffer.get(), std::streamsize(size)))
+        {
+            m_buffer = {};
+            return false;
+        }
+        m_data = m_buffer.get();
+        m_size = size;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        m_buffer = {};
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+#endif
+}
@@ -0,0 +1,48 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <span>
+#include <string>
+
+namespace argos
+{
+    /**
+     * @brief A private, writable memory-mapping of a file.
+     *
+     * Changes to the mapped memory are never written back to the file,
+     * and only the pages that are changed are copied. On platforms
+     * without memory-mapping the file is read into a buffer.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+
+        ~MappedFile();
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps the file at @a path, returns false if it can't be
+         *  opened.
+         */
+        bool open(const std::string& path);
+
+        [[nodiscard]] std::span<char> data() const;
+    private:
+        void close();
+
+        char* m_data = nullptr;
+        size_t m_size = 0;
+        /// Only used when memory-mapping isn't available.
+        std::unique_ptr<char[]> m_buffer;
+    };
+}
@@ -9,6 +9,7 @@
 
 #include "ArgosThrow.hpp"
 #include "OptionData.hpp"
+#include "ValueBinding.hpp"
 
 namespace argos
 {
@@ -185,6 +186,67 @@ namespace argos
         return *this;
     }
 
+    Option& Option::value_type(ValueType type)
+    {
+        check_option();
+        m_option->value_type = type;
+        return *this;
+    }
+
+    Option& Option::choices(std::vector<std::string> values)
+    {
+        check_option();
+        m_option->choices = ChoiceSet(std::move(values));
+        return *this;
+    }
+
+    Option& Option::dictionary(char separator)
+    {
+        check_option();
+        if (separator == '\0')
+            ARGOS_THROW("The separator can not be '\\0'.");
+        m_option->dictionary_separator = separator;
+        m_option->operation = OptionOperation::APPEND;
+        return *this;
+    }
+
+    Option& Option::set_binding(std::shared_ptr<ValueBinding> binding)
+    {
+        check_option();
+        m_option->value_type = binding->value_type();
+        m_option->binding = std::move(binding);
+        return *this;
+    }
+
+#define ARGOS_DEFINE_BIND(type) \
+    template <> \
+    Option& Option::bind<type>(type& variable) \
+    { \
+        return set_binding(make_binding(variable)); \
+    }
+
+    ARGOS_DEFINE_BIND(bool)
+    ARGOS_DEFINE_BIND(int)
+    ARGOS_DEFINE_BIND(unsigned)
+    ARGOS_DEFINE_BIND(long)
+    ARGOS_DEFINE_BIND(long long)
+    ARGOS_DEFINE_BIND(unsigned long)
+    ARGOS_DEFINE_BIND(unsigned long long)
+    ARGOS_DEFINE_BIND(float)
+    ARGOS_DEFINE_BIND(double)
+    ARGOS_DEFINE_BIND(std::string)
+    ARGOS_DEFINE_BIND(std::vector<int>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned>)
+    ARGOS_DEFINE_BIND(std::vector<long>)
+    ARGOS_DEFINE_BIND(std::vector<long long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long>)
+    ARGOS_DEFINE_BIND(std::vector<unsigned long long>)
+    ARGOS_DEFINE_BIND(std::vector<float>)
+    ARGOS_DEFINE_BIND(std::vector<double>)
+    ARGOS_DEFINE_BIND(std::vector<std::string>)
+
+#undef ARGOS_DEFINE_BIND
+
     Option& Option::optional(bool optional)
     {
         check_option();
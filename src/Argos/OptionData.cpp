@@ -83,6 +83,14 @@ namespace argos
         if (!option.argument.empty() && !option.constant.empty())
             ARGOS_THROW("Option cannot have both argument and constant.");
 
+        if (option.dictionary_separator != '\0')
+        {
+            if (option.operation != OptionOperation::APPEND)
+                ARGOS_THROW("Dictionary options must have operation APPEND.");
+            if (option.binding)
+                ARGOS_THROW("Dictionary options can not be bound to a variable.");
+        }
+
         switch (option.operation)
         {
         case OptionOperation::NONE:
@@ -6,14 +6,18 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include "Argos/Callbacks.hpp"
 #include "Argos/Enums.hpp"
+#include "ChoiceSet.hpp"
 #include "TextSource.hpp"
 
 namespace argos
 {
+    class ValueBinding;
+
     struct OptionData
     {
         std::vector<std::string> flags;
@@ -26,6 +30,12 @@ namespace argos
         OptionCallback callback;
         OptionOperation operation = OptionOperation::ASSIGN;
         OptionType type = OptionType::NORMAL;
+        ValueType value_type = ValueType::STRING;
+        ChoiceSet choices;
+        /// Non-zero if the values are key/value pairs separated by
+        /// this character.
+        char dictionary_separator = '\0';
+        std::shared_ptr<ValueBinding> binding;
         Visibility visibility = Visibility::NORMAL;
         bool optional = true;
         int id = 0;
@@ -7,101 +7,122 @@
 //****************************************************************************
 #include "OptionIterator.hpp"
 #include "ArgosThrow.hpp"
-#include "StringUtilities.hpp"
 
 namespace argos
 {
-    OptionIterator::OptionIterator()
-        : m_args(m_all_args)
+    OptionIterator::OptionIterator() = default;
+
+    OptionIterator::OptionIterator(std::vector<std::string_view> args, char prefix)
+        : m_queue(std::move(args)),
+          m_prefix(prefix)
     {
+        m_args = m_queue.arguments();
     }
 
-    OptionIterator::OptionIterator(std::vector<std::string_view> args, char prefix)
-        : m_all_args(args.begin(), args.end()),
-          m_args(m_all_args),
+    OptionIterator::OptionIterator(ArgumentSource args, char prefix)
+        : m_args(args),
           m_prefix(prefix)
     {
     }
 
-    OptionIterator::OptionIterator(const OptionIterator& rhs)
-        : m_all_args(rhs.m_all_args),
-          m_args(m_all_args.begin() + rhs.m_all_args.size() - rhs.m_args.size(), m_all_args.end()),
-          m_pos(rhs.m_pos),
-          m_prefix(rhs.m_prefix)
+    OptionIterator OptionIterator::lookahead() const
     {
+        OptionIterator result(m_args, m_prefix);
+        result.m_pos = m_pos;
+        result.m_index = m_index;
+        return result;
     }
 
-    std::optional<std::string> OptionIterator::next()
+    std::optional<std::string_view> OptionIterator::next()
     {
         if (m_pos != 0)
         {
             m_pos = 0;
-            pop_front(m_args);
+            m_args.pop_front();
+            ++m_index;
         }
 
         if (m_args.empty())
             return {};
 
-        if (m_args[0].size() <= 2 || m_args[0][0] != m_prefix)
+        const auto arg = m_args.front();
+        if (arg.size() <= 2 || arg[0] != m_prefix)
         {
             m_pos = std::string_view::npos;
-            return std::string(m_args[0]);
+            return arg;
         }
 
-        const auto eq = m_args[0].find('=');
+        const auto eq = arg.find('=');
         if (eq == std::string_view::npos)
         {
             m_pos = std::string_view::npos;
-            return std::string(m_args[0]);
+            return arg;
         }
 
         m_pos = eq + 1;
-        return std::string(m_args[0].substr(0, m_pos));
+        return arg.substr(0, m_pos);
     }
 
-    std::optional<std::string> OptionIterator::next_value()
+    std::optional<std::string_view> OptionIterator::next_value()
     {
         if (m_args.empty())
             return {};
 
         if (m_pos != std::string_view::npos)
         {
-            const auto result = m_args[0].substr(m_pos);
+            const auto result = m_args.front().substr(m_pos);
             m_pos = std::string_view::npos;
-            return std::string(result);
+            return result;
         }
 
-        pop_front(m_args);
+        m_args.pop_front();
+        ++m_index;
         if (m_args.empty())
         {
             m_pos = 0;
             return {};
         }
 
-        m_pos = m_args[0].size();
-        return std::string(m_args[0]);
+        m_pos = std::string_view::npos;
+        return m_args.front();
     }
 
     std::string_view OptionIterator::current() const
     {
         if (m_args.empty())
             ARGOS_THROW("There is no current argument.");
-        return m_args[0];
+        return m_args.front();
+    }
+
+    size_t OptionIterator::index() const
+    {
+        return m_index;
     }
 
-    std::span<std::string> OptionIterator::remaining_arguments() const
+    bool OptionIterator::is_within_argument() const
+    {
+        // Flags are never concatenated.
+        return false;
+    }
+
+    ArgumentSource OptionIterator::remaining_arguments() const
     {
         return m_pos == 0 ? m_args : m_args.subspan(1);
     }
 
     void OptionIterator::insert(const std::vector<std::string>& args)
     {
-        auto args_index = m_all_args.size() - m_args.size();
-        auto insert_index = args_index;
-        if (m_pos != 0)
-            insert_index++;
-        m_all_args.insert(m_all_args.begin() + insert_index,
-                          args.begin(), args.end());
-        m_args = std::span(m_all_args.begin() + args_index, m_all_args.end());
+        std::vector<std::string_view> views;
+        views.reserve(args.size());
+        for (const auto& arg : args)
+            views.push_back(m_strings.add(arg));
+        insert_arguments(m_pos != 0 ? 1 : 0, views);
+    }
+
+    void OptionIterator::insert_arguments(
+        size_t pos,
+        std::span<const std::string_view> args)
+    {
+        m_args = m_queue.insert(m_args, pos, args);
     }
 }
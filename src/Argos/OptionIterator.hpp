@@ -7,10 +7,12 @@
 //****************************************************************************
 #pragma once
 #include <optional>
-#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
+#include "Argos/ArgumentSource.hpp"
+#include "ArgumentQueue.hpp"
+#include "StringArena.hpp"
 
 namespace argos
 {
@@ -22,21 +24,66 @@ namespace argos
         explicit OptionIterator(std::vector<std::string_view> args,
                                 char prefix);
 
-        OptionIterator(const OptionIterator& rhs);
+        explicit OptionIterator(ArgumentSource args,
+                                char prefix);
+
+        OptionIterator(const OptionIterator&) = delete;
+
+        OptionIterator(OptionIterator&&) noexcept = default;
+
+        OptionIterator& operator=(OptionIterator&&) noexcept = default;
 
-        std::optional<std::string> next();
+        /**
+         * @brief Returns an iterator that reads the remaining arguments of
+         *  this iterator without copying them.
+         *
+         * The returned iterator is only valid as long as this iterator is
+         * not modified, and it must not be used to insert arguments.
+         */
+        [[nodiscard]] OptionIterator lookahead() const;
 
-        std::optional<std::string> next_value();
+        std::optional<std::string_view> next();
+
+        std::optional<std::string_view> next_value();
 
         [[nodiscard]] std::string_view current() const;
 
-        [[nodiscard]] std::span<std::string> remaining_arguments() const;
+        /**
+         * @brief Returns the position of current() among the arguments
+         *  the iterator was created with, including the ones that have
+         *  been inserted before it.
+         */
+        [[nodiscard]] size_t index() const;
+
+        /**
+         * @brief Returns true if the next call to next() will return
+         *  a flag from the argument the previous call returned a flag
+         *  from.
+         */
+        [[nodiscard]] bool is_within_argument() const;
+
+        [[nodiscard]] ArgumentSource remaining_arguments() const;
 
         void insert(const std::vector<std::string>& args);
     private:
-        std::vector<std::string> m_all_args;
-        std::span<std::string> m_args;
+        /**
+         * @brief Inserts @a args after the first @a pos remaining
+         *  arguments.
+         */
+        void insert_arguments(size_t pos,
+                              std::span<const std::string_view> args);
+
+        /// The remaining arguments. They are read directly from the
+        /// caller's memory until arguments are inserted, then from
+        /// m_queue.
+        ArgumentSource m_args;
+        ArgumentQueue m_queue;
+        /// The text of inserted arguments. Unlike a container of
+        /// strings, an empty arena doesn't allocate any memory.
+        StringArena m_strings;
         size_t m_pos = 0;
+        /// The number of arguments that have been removed from m_args.
+        size_t m_index = 0;
         char m_prefix = '-';
     };
 }
@@ -14,7 +14,7 @@ namespace argos
 {
     struct OptionIteratorWrapper
     {
-        std::optional<std::string> next()
+        std::optional<std::string_view> next()
         {
             if (std::holds_alternative<OptionIterator>(iterator))
                 return std::get<OptionIterator>(iterator).next();
@@ -22,7 +22,7 @@ namespace argos
                 return std::get<StandardOptionIterator>(iterator).next();
         }
 
-        std::optional<std::string> next_value()
+        std::optional<std::string_view> next_value()
         {
             if (std::holds_alternative<OptionIterator>(iterator))
                 return std::get<OptionIterator>(iterator).next_value();
@@ -38,7 +38,23 @@ namespace argos
                 return std::get<StandardOptionIterator>(iterator).current();
         }
 
-        [[nodiscard]] std::span<std::string> remaining_arguments()
+        [[nodiscard]] size_t index() const
+        {
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).index();
+            else
+                return std::get<StandardOptionIterator>(iterator).index();
+        }
+
+        [[nodiscard]] bool is_within_argument() const
+        {
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return std::get<OptionIterator>(iterator).is_within_argument();
+            else
+                return std::get<StandardOptionIterator>(iterator).is_within_argument();
+        }
+
+        [[nodiscard]] ArgumentSource remaining_arguments()
         {
             if (std::holds_alternative<OptionIterator>(iterator))
                 return std::get<OptionIterator>(iterator).remaining_arguments();
@@ -46,6 +62,14 @@ namespace argos
                 return std::get<StandardOptionIterator>(iterator).remaining_arguments();
         }
 
+        [[nodiscard]] OptionIteratorWrapper lookahead() const
+        {
+            if (std::holds_alternative<OptionIterator>(iterator))
+                return {std::get<OptionIterator>(iterator).lookahead()};
+            else
+                return {std::get<StandardOptionIterator>(iterator).lookahead()};
+        }
+
         void insert(const std::vector<std::string>& args)
         {
             if (std::holds_alternative<OptionIterator>(iterator))
@@ -0,0 +1,179 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "OptionTrie.hpp"
+
+#include <algorithm>
+#include "OptionData.hpp"
+
+namespace argos
+{
+    OptionTrie::OptionTrie() = default;
+
+    OptionTrie::OptionTrie(
+        std::vector<std::pair<std::string_view, const OptionData*>> flags,
+        bool case_insensitive)
+        : m_case_insensitive(case_insensitive)
+    {
+        std::vector<std::pair<std::string, const OptionData*>> folded;
+        folded.reserve(flags.size());
+        size_t text_size = 0;
+        for (const auto& [flag, option] : flags)
+        {
+            auto& [str, opt] = folded.emplace_back(flag, option);
+            for (auto& c : str)
+                c = fold(c);
+            text_size += str.size();
+        }
+        std::sort(folded.begin(), folded.end());
+
+        m_labels.reserve(text_size);
+        m_nodes.emplace_back();
+        if (folded.size() == 1)
+            m_nodes[0].unique_option = folded[0].second;
+        add_children(0, folded.begin(), folded.end(), 0);
+    }
+
+    const OptionData*
+    OptionTrie::find(std::string_view flag, bool allow_abbreviations) const
+    {
+        if (m_nodes.empty())
+            return nullptr;
+
+        // The position of a trailing '=' that is part of the option's
+        // argument rather than its flag.
+        const auto stem_size = flag.size() > 2 && flag.back() == '='
+                               ? flag.size() - 1
+                               : std::string_view::npos;
+        const OptionData* stem_option = nullptr;
+
+        const Node* node = &m_nodes[0];
+        size_t label_pos = 0;
+        for (size_t i = 0; i < flag.size(); ++i)
+        {
+            if (i == stem_size)
+            {
+                stem_option = get_option(*node, label_pos, allow_abbreviations);
+                if (stem_option && stem_option->argument.empty())
+                    stem_option = nullptr;
+            }
+
+            const auto c = fold(flag[i]);
+            if (label_pos == node->label_size)
+            {
+                const auto child = find_child(*node, c);
+                if (child == 0)
+                    return stem_option;
+                node = &m_nodes[child];
+                label_pos = 1;
+            }
+            else if (m_labels[node->label_offset + label_pos] == c)
+            {
+                ++label_pos;
+            }
+            else
+            {
+                return stem_option;
+            }
+        }
+
+        if (const auto* option = get_option(*node, label_pos, allow_abbreviations))
+            return option;
+        return stem_option;
+    }
+
+    bool OptionTrie::empty() const
+    {
+        return m_nodes.empty();
+    }
+
+    // NOLINT(*-no-recursion)
+    void OptionTrie::add_children(uint32_t node_index,
+                                  FlagIterator begin, FlagIterator end,
+                                  size_t depth)
+    {
+        // The flags are sorted, so flags with the same character at
+        // position depth are consecutive.
+        auto group_end = [&](FlagIterator it)
+        {
+            const auto c = it->first[depth];
+            return std::find_if(it, end, [&](const auto& f)
+            {
+                return f.first[depth] != c;
+            });
+        };
+
+        uint32_t child_count = 0;
+        for (auto it = begin; it != end; it = group_end(it))
+            ++child_count;
+
+        const auto first_child = uint32_t(m_nodes.size());
+        m_nodes[node_index].first_child = first_child;
+        m_nodes[node_index].child_count = child_count;
+        m_nodes.resize(m_nodes.size() + child_count);
+
+        auto child_index = first_child;
+        for (auto it = begin; it != end; ++child_index)
+        {
+            const auto next = group_end(it);
+            // The label is the longest prefix shared by all the flags in
+            // the group, i.e. the shared prefix of the first and the last.
+            const auto& first = it->first;
+            const auto& last = std::prev(next)->first;
+            const auto label_end = size_t(std::mismatch(
+                first.begin() + ptrdiff_t(depth), first.end(),
+                last.begin() + ptrdiff_t(depth), last.end()).first - first.begin());
+
+            auto& child = m_nodes[child_index];
+            child.label_offset = uint32_t(m_labels.size());
+            child.label_size = uint32_t(label_end - depth);
+            m_labels.append(first, depth, label_end - depth);
+            if (std::next(it) == next)
+                child.unique_option = it->second;
+
+            auto rest = it;
+            if (first.size() == label_end)
+                child.option = (rest++)->second;
+            if (rest != next)
+                add_children(child_index, rest, next, label_end);
+            it = next;
+        }
+    }
+
+    uint32_t OptionTrie::find_child(const Node& node, char c) const
+    {
+        const auto begin = m_nodes.begin() + node.first_child;
+        const auto end = begin + node.child_count;
+        // The flags were sorted with std::string's operator<, which
+        // compares the characters as unsigned.
+        const auto it = std::lower_bound(
+            begin, end, uint8_t(c),
+            [&](const Node& n, uint8_t ch)
+            {
+                return uint8_t(m_labels[n.label_offset]) < ch;
+            });
+        if (it == end || m_labels[it->label_offset] != c)
+            return 0;
+        return uint32_t(it - m_nodes.begin());
+    }
+
+    const OptionData* OptionTrie::get_option(const Node& node,
+                                             size_t label_pos,
+                                             bool allow_abbreviations) const
+    {
+        if (label_pos == node.label_size && node.option)
+            return node.option;
+        return allow_abbreviations ? node.unique_option : nullptr;
+    }
+
+    char OptionTrie::fold(char c) const
+    {
+        if (m_case_insensitive && 'a' <= c && c <= 'z')
+            return char(c - ('a' - 'A'));
+        return c;
+    }
+}
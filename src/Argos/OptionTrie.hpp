@@ -0,0 +1,85 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace argos
+{
+    struct OptionData;
+
+    /**
+     * @brief A path-compressed trie that maps flags to options.
+     *
+     * The nodes are stored in a single vector where the children of a
+     * node are consecutive and sorted on the first character of their
+     * labels. Flags are case folded when the trie is built if it is
+     * case-insensitive, lookups only fold the characters of the flag
+     * they are looking for.
+     */
+    class OptionTrie
+    {
+    public:
+        OptionTrie();
+
+        /**
+         * @brief Builds a trie from @a flags, which must be free of
+         *  duplicates.
+         */
+        OptionTrie(std::vector<std::pair<std::string_view, const OptionData*>> flags,
+                   bool case_insensitive);
+
+        /**
+         * @brief Returns the option with the flag @a flag.
+         *
+         * If @a allow_abbreviations is true, @a flag can also be a prefix
+         * of a single flag. A flag ending with '=' that isn't a flag
+         * itself matches an option with the same flag without the '='
+         * if the option takes an argument.
+         */
+        [[nodiscard]] const OptionData*
+        find(std::string_view flag, bool allow_abbreviations) const;
+
+        [[nodiscard]] bool empty() const;
+    private:
+        struct Node
+        {
+            uint32_t label_offset = 0;
+            uint32_t label_size = 0;
+            uint32_t first_child = 0;
+            uint32_t child_count = 0;
+            /// The option whose flag ends at this node.
+            const OptionData* option = nullptr;
+            /// The option if there is only one flag in this node's
+            /// subtree.
+            const OptionData* unique_option = nullptr;
+        };
+
+        using FlagIterator = std::vector<std::pair<std::string, const OptionData*>>::const_iterator;
+
+        void add_children(uint32_t node_index,
+                          FlagIterator begin, FlagIterator end,
+                          size_t depth);
+
+        [[nodiscard]] uint32_t find_child(const Node& node, char c) const;
+
+        [[nodiscard]] const OptionData*
+        get_option(const Node& node, size_t label_pos,
+                   bool allow_abbreviations) const;
+
+        [[nodiscard]] char fold(char c) const;
+
+        std::vector<Node> m_nodes;
+        /// The labels of all nodes.
+        std::string m_labels;
+        bool m_case_insensitive = false;
+    };
+}
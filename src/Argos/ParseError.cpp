@@ -0,0 +1,108 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Argos/ParseError.hpp"
+
+#include "HelpText.hpp"
+#include "ParserData.hpp"
+
+namespace argos
+{
+    ParseError::ParseError() = default;
+
+    ParseError::ParseError(ParseErrorCode code,
+                           std::string detail,
+                           ArgumentId argument_id,
+                           std::optional<size_t> token_index,
+                           const CommandData* command,
+                           std::shared_ptr<const ParserData> data)
+        : m_code(code),
+          m_argument_id(argument_id),
+          m_token_index(token_index),
+          m_detail(std::move(detail)),
+          m_command(command),
+          m_data(std::move(data))
+    {}
+
+    ParseError::operator bool() const
+    {
+        return m_code != ParseErrorCode::NONE;
+    }
+
+    ParseErrorCode ParseError::code() const
+    {
+        return m_code;
+    }
+
+    std::optional<size_t> ParseError::token_index() const
+    {
+        return m_token_index;
+    }
+
+    ArgumentId ParseError::argument_id() const
+    {
+        return m_argument_id;
+    }
+
+    const std::string& ParseError::detail() const
+    {
+        return m_detail;
+    }
+
+    std::string ParseError::message() const
+    {
+        if (!m_command)
+            return m_detail;
+        if (!has_argument_name())
+            return get_error_message(*m_command, m_detail);
+        return get_error_message(*m_command, m_detail, m_argument_id);
+    }
+
+    void ParseError::write() const
+    {
+        if (!m_command)
+            return;
+        if (!has_argument_name())
+            write_error_message(*m_data, *m_command, m_detail);
+        else
+            write_error_message(*m_data, *m_command, m_detail, m_argument_id);
+    }
+
+    bool ParseError::has_argument_name() const
+    {
+        // The detail of a missing option already names it.
+        return m_argument_id != ArgumentId{}
+               && m_code != ParseErrorCode::MISSING_OPTION;
+    }
+
+    ParseResult::ParseResult() = default;
+
+    ParseResult::ParseResult(ParsedArguments args, ParseError error)
+        : m_args(std::move(args)),
+          m_error(std::move(error))
+    {}
+
+    bool ParseResult::has_value() const
+    {
+        return !m_error;
+    }
+
+    ParseResult::operator bool() const
+    {
+        return has_value();
+    }
+
+    const ParsedArguments& ParseResult::value() const
+    {
+        return m_args;
+    }
+
+    const ParseError& ParseResult::error() const
+    {
+        return m_error;
+    }
+}
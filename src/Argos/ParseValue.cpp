@@ -5,63 +5,180 @@
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
-
 #include "ParseValue.hpp"
 
+#include <bit>
+#include <cctype>
 #include <cerrno>
+#include <charconv>
 #include <climits>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include "ChoiceSet.hpp"
 #include "StringUtilities.hpp"
 
 namespace argos
 {
     namespace
     {
-        template <typename T>
-        T str_to_int(const char* str, char** endp, int base);
+        /**
+         * @brief Removes leading whitespace and the sign from @a str,
+         *  returns true if the sign is '-'.
+         */
+        bool remove_whitespace_and_sign(std::string_view& str)
+        {
+            size_t i = 0;
+            while (i < str.size() && is_space(str[i]))
+                ++i;
+            bool negative = false;
+            if (i < str.size() && (str[i] == '-' || str[i] == '+'))
+                negative = str[i++] == '-';
+            str.remove_prefix(i);
+            return negative;
+        }
 
-        template <>
-        long str_to_int<long>(const char* str, char** endp, int base)
+        bool has_hex_prefix(std::string_view str)
         {
-            return strtol(str, endp, base);
+            return str.size() >= 2 && str[0] == '0'
+                   && (str[1] == 'x' || str[1] == 'X');
         }
 
-        template <>
-        long long str_to_int<long long>(const char* str, char** endp, int base)
+        /**
+         * @brief Returns true if all eight bytes in @a chunk are digits.
+         */
+        bool is_eight_digits(uint64_t chunk)
         {
-            return strtoll(str, endp, base);
+            return ((chunk & 0xF0F0F0F0F0F0F0F0)
+                    | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0)
+                       >> 4)) == 0x3333333333333333;
         }
 
-        template <>
-        unsigned long
-        str_to_int<unsigned long>(const char* str, char** endp, int base)
+        /**
+         * @brief Returns the value of the eight digits in @a chunk, where
+         *  the first digit is in the least significant byte.
+         */
+        uint32_t parse_eight_digits(uint64_t chunk)
         {
-            return strtoul(str, endp, base);
+            chunk -= 0x3030303030303030;
+            chunk = chunk * 10 + (chunk >> 8);
+            chunk = ((chunk & 0x000000FF000000FF)
+                     * (100 + (1000000ULL << 32))
+                     + ((chunk >> 16) & 0x000000FF000000FF)
+                       * (1 + (10000ULL << 32))) >> 32;
+            return uint32_t(chunk);
         }
 
-        template <>
-        unsigned long long
-        str_to_int<unsigned long long>(const char* str, char** endp, int base)
+        /**
+         * @brief Parses @a str, which must have at most 19 characters, if
+         *  it only consists of decimal digits.
+         *
+         * Eight digits are converted at a time with ordinary 64-bit
+         * arithmetic, which is considerably faster than std::from_chars
+         * for the long numbers that are typical of data values.
+         */
+        bool parse_decimal_digits(std::string_view str, uint64_t& value)
         {
-            return strtoull(str, endp, base);
+            uint64_t result = 0;
+            size_t i = 0;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                for (; i + 8 <= str.size(); i += 8)
+                {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, str.data() + i, 8);
+                    if (!is_eight_digits(chunk))
+                        return false;
+                    result = result * 100000000 + parse_eight_digits(chunk);
+                }
+            }
+            for (; i < str.size(); ++i)
+            {
+                const auto digit = unsigned(str[i]) - '0';
+                if (digit > 9)
+                    return false;
+                result = result * 10 + digit;
+            }
+            value = result;
+            return true;
         }
 
+        /**
+         * @brief Parses the digits in @a str as an unsigned number,
+         *  after removing the base prefix if there is one.
+         */
         template <typename T>
-        std::optional<T> parse_integer_impl(const std::string& str, int base)
+        bool parse_magnitude(std::string_view str, int base, T& value)
         {
+            if (base == 0)
+            {
+                if (has_hex_prefix(str))
+                {
+                    str.remove_prefix(2);
+                    base = 16;
+                }
+                else
+                {
+                    // A leading 0 is parsed as an octal digit.
+                    base = !str.empty() && str[0] == '0' ? 8 : 10;
+                }
+            }
+            else if (base == 16 && has_hex_prefix(str))
+            {
+                str.remove_prefix(2);
+            }
+            else if (base < 2 || 36 < base)
+            {
+                return false;
+            }
+
             if (str.empty())
+                return false;
+
+            if (base == 10 && str.size() <= size_t(std::numeric_limits<T>::digits10))
+            {
+                uint64_t n;
+                if (!parse_decimal_digits(str, n))
+                    return false;
+                value = T(n);
+                return true;
+            }
+
+            // The sign has been removed, and from_chars accepts none for
+            // unsigned types.
+            const auto end = str.data() + str.size();
+            const auto [ptr, ec] = std::from_chars(str.data(), end, value, base);
+            return ec == std::errc() && ptr == end;
+        }
+
+        template <typename T>
+        std::optional<T> parse_integer_impl(std::string_view str, int base)
+        {
+            using U = std::make_unsigned_t<T>;
+            const auto negative = remove_whitespace_and_sign(str);
+            U magnitude;
+            if (!parse_magnitude(str, base, magnitude))
                 return {};
-            char* endp = nullptr;
-            errno = 0;
-            auto value = str_to_int<T>(str.c_str(), &endp, base);
-            if (endp == str.c_str() + str.size() && errno == 0)
-                return value;
-            return {};
+
+            if constexpr (std::is_signed_v<T>)
+            {
+                constexpr auto max = U(std::numeric_limits<T>::max());
+                if (magnitude > max + U(negative))
+                    return {};
+            }
+
+            // The negation of unsigned numbers wraps around, just like in
+            // strtoul.
+            return T(negative ? U(0) - magnitude : magnitude);
         }
     }
 
     template <>
-    std::optional<int> parse_integer<int>(const std::string& str, int base)
+    std::optional<int> parse_integer<int>(std::string_view str, int base)
     {
         const auto n = parse_integer_impl<long>(str, base);
         if (!n)
@@ -77,7 +194,7 @@ namespace argos
 
     template <>
     std::optional<unsigned>
-    parse_integer<unsigned>(const std::string& str, int base)
+    parse_integer<unsigned>(std::string_view str, int base)
     {
         auto n = parse_integer_impl<unsigned long>(str, base);
         if (!n)
@@ -92,28 +209,28 @@ namespace argos
     }
 
     template <>
-    std::optional<long> parse_integer<long>(const std::string& str, int base)
+    std::optional<long> parse_integer<long>(std::string_view str, int base)
     {
         return parse_integer_impl<long>(str, base);
     }
 
     template <>
     std::optional<long long>
-    parse_integer<long long>(const std::string& str, int base)
+    parse_integer<long long>(std::string_view str, int base)
     {
         return parse_integer_impl<long long>(str, base);
     }
 
     template <>
     std::optional<unsigned long>
-    parse_integer<unsigned long>(const std::string& str, int base)
+    parse_integer<unsigned long>(std::string_view str, int base)
     {
         return parse_integer_impl<unsigned long>(str, base);
     }
 
     template <>
     std::optional<unsigned long long>
-    parse_integer<unsigned long long>(const std::string& str, int base)
+    parse_integer<unsigned long long>(std::string_view str, int base)
     {
         return parse_integer_impl<unsigned long long>(str, base);
     }
@@ -136,10 +253,11 @@ namespace argos
         }
 
         template <typename T>
-        std::optional<T> parse_floating_point_impl(const std::string& str)
+        std::optional<T> parse_with_strtod(std::string_view sv)
         {
-            if (str.empty())
+            if (sv.empty())
                 return {};
+            const std::string str(sv);
             char* endp = nullptr;
             errno = 0;
             auto value = str_to_float<T>(str.c_str(), &endp);
@@ -147,17 +265,126 @@ namespace argos
                 return value;
             return {};
         }
+
+#ifdef __cpp_lib_to_chars
+
+        template <typename T>
+        std::optional<T> parse_floating_point_impl(std::string_view str)
+        {
+            const auto original = str;
+            const auto negative = remove_whitespace_and_sign(str);
+            auto format = std::chars_format::general;
+            if (has_hex_prefix(str))
+            {
+                str.remove_prefix(2);
+                format = std::chars_format::hex;
+                // from_chars accepts "inf" and "nan" in hex format too.
+                if (str.empty() || !(std::isxdigit(uint8_t(str[0])) || str[0] == '.'))
+                    return {};
+            }
+
+            // The sign has already been removed.
+            if (str.empty() || str[0] == '-')
+                return {};
+
+            T value;
+            const auto end = str.data() + str.size();
+            const auto [ptr, ec] = std::from_chars(str.data(), end, value, format);
+            if (ec != std::errc() || ptr != end)
+                return {};
+
+            // strtod reports a range error if the result is subnormal
+            // and inexact, which from_chars doesn't tell us. Subnormal
+            // numbers are rare enough to let strtod decide.
+            if (std::fpclassify(value) == FP_SUBNORMAL)
+                return parse_with_strtod<T>(original);
+
+            return negative ? -value : value;
+        }
+
+#else
+
+        template <typename T>
+        std::optional<T> parse_floating_point_impl(std::string_view str)
+        {
+            return parse_with_strtod<T>(str);
+        }
+
+#endif
     }
 
     template <>
-    std::optional<float> parse_floating_point<float>(const std::string& str)
+    std::optional<float> parse_floating_point<float>(std::string_view str)
     {
         return parse_floating_point_impl<float>(str);
     }
 
     template <>
-    std::optional<double> parse_floating_point<double>(const std::string& str)
+    std::optional<double> parse_floating_point<double>(std::string_view str)
     {
         return parse_floating_point_impl<double>(str);
     }
+
+    namespace
+    {
+        template <typename T>
+        bool set_if_valid(const std::optional<T>& src, T& dst)
+        {
+            if (!src)
+                return false;
+            dst = *src;
+            return true;
+        }
+    }
+
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           TypedValue& value)
+    {
+        switch (type)
+        {
+        case ValueType::STRING:
+            return true;
+        case ValueType::BOOL:
+            value.bool_value = !str.empty() && str != "0" && str != "false";
+            return true;
+        case ValueType::INT:
+            return set_if_valid(parse_integer<int>(str, 10), value.int_value);
+        case ValueType::UINT:
+            return set_if_valid(parse_integer<unsigned>(str, 10), value.uint_value);
+        case ValueType::LONG:
+            return set_if_valid(parse_integer<long>(str, 10), value.long_value);
+        case ValueType::LLONG:
+            return set_if_valid(parse_integer<long long>(str, 10), value.llong_value);
+        case ValueType::ULONG:
+            return set_if_valid(parse_integer<unsigned long>(str, 10),
+                          value.ulong_value);
+        case ValueType::ULLONG:
+            return set_if_valid(parse_integer<unsigned long long>(str, 10),
+                          value.ullong_value);
+        case ValueType::FLOAT:
+            return set_if_valid(parse_floating_point<float>(str), value.float_value);
+        case ValueType::DOUBLE:
+            return set_if_valid(parse_floating_point<double>(str),
+                          value.double_value);
+        case ValueType::CHOICE:
+            // Requires the list of choices.
+            return false;
+        }
+        return false;
+    }
+
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           const ChoiceSet* choices, TypedValue& value)
+    {
+        if (!choices)
+            return parse_typed_value(str, type, value);
+
+        const auto index = choices->find(str);
+        if (!index)
+            return false;
+        if (type != ValueType::CHOICE)
+            return parse_typed_value(str, type, value);
+        value.uint_value = unsigned(*index);
+        return true;
+    }
 }
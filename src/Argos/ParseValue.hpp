@@ -6,45 +6,85 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
-#include <cerrno>
-#include <cinttypes>
 #include <optional>
-#include <string>
-#include <type_traits>
+#include <string_view>
+#include "Argos/ArgumentValue.hpp"
 
 namespace argos
 {
+    class ChoiceSet;
+
+    /**
+     * @brief Parses @a str the same way as strtol and its siblings in
+     *  the "C" locale, but fails rather than returning a partial result
+     *  if @a str contains anything else than the number.
+     *
+     * Leading whitespace and a sign are accepted. If @a base is 0, the
+     * base is determined by the prefix: "0x" for 16 and "0" for 8.
+     * Unsigned types accept negative numbers and wrap them around,
+     * like strtoul does.
+     */
     template <typename T>
-    std::optional<T> parse_integer(const std::string& str, int base) = delete;
+    std::optional<T> parse_integer(std::string_view str, int base) = delete;
 
     template <>
-    std::optional<int> parse_integer<int>(const std::string& str, int base);
+    std::optional<int> parse_integer<int>(std::string_view str, int base);
 
     template <>
     std::optional<unsigned>
-    parse_integer<unsigned>(const std::string& str, int base);
+    parse_integer<unsigned>(std::string_view str, int base);
 
     template <>
-    std::optional<long> parse_integer<long>(const std::string& str, int base);
+    std::optional<long> parse_integer<long>(std::string_view str, int base);
 
     template <>
     std::optional<long long>
-    parse_integer<long long>(const std::string& str, int base);
+    parse_integer<long long>(std::string_view str, int base);
 
     template <>
     std::optional<unsigned long>
-    parse_integer<unsigned long>(const std::string& str, int base);
+    parse_integer<unsigned long>(std::string_view str, int base);
 
     template <>
     std::optional<unsigned long long>
-    parse_integer<unsigned long long>(const std::string& str, int base);
+    parse_integer<unsigned long long>(std::string_view str, int base);
 
+    /**
+     * @brief Parses @a str the same way as strtod and strtof in the "C"
+     *  locale, but fails if @a str contains anything else than the
+     *  number, or if the number is out of range.
+     *
+     * Leading whitespace, a sign, hexadecimal numbers, infinity and NaN
+     * are accepted. Non-zero numbers that are too small to be
+     * represented as normalized numbers are out of range.
+     */
     template <typename T>
-    std::optional<T> parse_floating_point(const std::string& str);
+    std::optional<T> parse_floating_point(std::string_view str);
 
     template <>
-    std::optional<float> parse_floating_point<float>(const std::string& str);
+    std::optional<float> parse_floating_point<float>(std::string_view str);
 
     template <>
-    std::optional<double> parse_floating_point<double>(const std::string& str);
+    std::optional<double> parse_floating_point<double>(std::string_view str);
+
+    /**
+     * @brief Converts @a str to @a type and stores the result in the
+     *  corresponding member of @a value.
+     *
+     * Integers are parsed in base 10, and booleans the same way as
+     * ArgumentValue::as_bool() does. Returns false if @a str isn't a
+     * valid value of @a type.
+     */
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           TypedValue& value);
+
+    /**
+     * @brief Same as parse_typed_value(), but @a str must also be one of
+     *  @a choices unless @a choices is nullptr.
+     *
+     * If @a type is CHOICE, the position of @a str in @a choices is
+     * stored in value.uint_value.
+     */
+    bool parse_typed_value(std::string_view str, ValueType type,
+                           const ChoiceSet* choices, TypedValue& value);
 }
@@ -50,6 +50,11 @@ namespace argos
         return m_impl->has(arg.value_id());
     }
 
+    bool ParsedArguments::has(ValueHandle handle) const
+    {
+        return m_impl->has(m_impl->get_ids(handle).first);
+    }
+
     std::vector<ParsedArguments> ParsedArguments::subcommands() const
     {
         std::vector<ParsedArguments> result;
@@ -60,32 +65,73 @@ namespace argos
 
     ArgumentValue ParsedArguments::value(const std::string& name) const
     {
-        auto id = m_impl->get_value_id(name);
-        if (auto value = m_impl->get_value(id))
-            return {value->first, m_impl, id, value->second};
-        else
-            return {{}, m_impl, id, {}};
+        return ParsedArgumentsImpl::make_value(m_impl,
+                                               m_impl->get_value_id(name));
     }
 
     ArgumentValue ParsedArguments::value(const IArgumentView& arg) const
     {
-        if (auto value = m_impl->get_value(arg.value_id()))
-            return {value->first, m_impl, arg.value_id(), arg.argument_id()};
-        else
-            return {{}, m_impl, arg.value_id(), arg.argument_id()};
+        return ParsedArgumentsImpl::make_value(m_impl, arg.value_id(),
+                                               arg.argument_id());
+    }
+
+    ArgumentValue ParsedArguments::value(ValueHandle handle) const
+    {
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        return ParsedArgumentsImpl::make_value(m_impl, value_id, argument_id);
     }
 
     ArgumentValues ParsedArguments::values(const std::string& name) const
     {
-        auto id = m_impl->get_value_id(name);
-        auto values = m_impl->get_values(id);
-        return {values, m_impl, id};
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_value_id(name));
     }
 
     ArgumentValues ParsedArguments::values(const IArgumentView& arg) const
     {
-        auto values = m_impl->get_values(arg.value_id());
-        return {values, m_impl, arg.value_id()};
+        return ParsedArgumentsImpl::make_values(m_impl, arg.value_id());
+    }
+
+    ArgumentValues ParsedArguments::values(ValueHandle handle) const
+    {
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_ids(handle).first);
+    }
+
+    ValuesView<std::string_view>
+    ParsedArguments::values_view(const std::string& name) const
+    {
+        return ValuesView<std::string_view>(
+            m_impl->make_view(m_impl->get_value_id(name)));
+    }
+
+    ValuesView<std::string_view>
+    ParsedArguments::values_view(const IArgumentView& arg) const
+    {
+        return ValuesView<std::string_view>(m_impl->make_view(arg.value_id()));
+    }
+
+    ValuesView<std::string_view>
+    ParsedArguments::values_view(ValueHandle handle) const
+    {
+        return ValuesView<std::string_view>(
+            m_impl->make_view(m_impl->get_ids(handle).first));
+    }
+
+    ArgumentDictionary ParsedArguments::dictionary(const std::string& name) const
+    {
+        return m_impl->make_dictionary(m_impl->get_value_id(name));
+    }
+
+    ArgumentDictionary
+    ParsedArguments::dictionary(const IArgumentView& arg) const
+    {
+        return m_impl->make_dictionary(arg.value_id());
+    }
+
+    ArgumentDictionary ParsedArguments::dictionary(ValueHandle handle) const
+    {
+        return m_impl->make_dictionary(m_impl->get_ids(handle).first);
     }
 
     std::vector<std::unique_ptr<ArgumentView>>
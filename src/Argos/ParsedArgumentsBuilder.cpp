@@ -21,7 +21,8 @@ namespace argos
     ParsedArgumentsBuilder::append(const std::string& name,
                                    const std::string& value)
     {
-        m_impl->append_value(m_impl->get_value_id(name), value, {});
+        if (!m_impl->append_value(m_impl->get_value_id(name), value, {}))
+            m_impl->error("Invalid value: " + value + ".");
         return *this;
     }
 
@@ -29,7 +30,18 @@ namespace argos
     ParsedArgumentsBuilder::append(const IArgumentView& arg,
                                    const std::string& value)
     {
-        m_impl->append_value(arg.value_id(), value, arg.argument_id());
+        if (!m_impl->append_value(arg.value_id(), value, arg.argument_id()))
+            m_impl->error("Invalid value: " + value + ".", arg.argument_id());
+        return *this;
+    }
+
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::append(ValueHandle handle,
+                                   const std::string& value)
+    {
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        if (!m_impl->append_value(value_id, value, argument_id))
+            m_impl->error("Invalid value: " + value + ".", argument_id);
         return *this;
     }
 
@@ -37,7 +49,8 @@ namespace argos
     ParsedArgumentsBuilder::assign(const std::string& name,
                                    const std::string& value)
     {
-        m_impl->assign_value(m_impl->get_value_id(name), value, {});
+        if (!m_impl->assign_value(m_impl->get_value_id(name), value, {}))
+            m_impl->error("Invalid value: " + value + ".");
         return *this;
     }
 
@@ -45,7 +58,18 @@ namespace argos
     ParsedArgumentsBuilder::assign(const IArgumentView& arg,
                                    const std::string& value)
     {
-        m_impl->assign_value(arg.value_id(), value, arg.argument_id());
+        if (!m_impl->assign_value(arg.value_id(), value, arg.argument_id()))
+            m_impl->error("Invalid value: " + value + ".", arg.argument_id());
+        return *this;
+    }
+
+    ParsedArgumentsBuilder&
+    ParsedArgumentsBuilder::assign(ValueHandle handle,
+                                   const std::string& value)
+    {
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        if (!m_impl->assign_value(value_id, value, argument_id))
+            m_impl->error("Invalid value: " + value + ".", argument_id);
         return *this;
     }
 
@@ -63,37 +87,48 @@ namespace argos
         return *this;
     }
 
+    ParsedArgumentsBuilder& ParsedArgumentsBuilder::clear(ValueHandle handle)
+    {
+        m_impl->clear_value(m_impl->get_ids(handle).first);
+        return *this;
+    }
+
     ArgumentValue ParsedArgumentsBuilder::value(const std::string& name) const
     {
-        auto id = m_impl->get_value_id(name);
-        if (auto value = m_impl->get_value(id))
-            return {value->first, m_impl, id, value->second};
-        else
-            return {{}, m_impl, id, {}};
+        return ParsedArgumentsImpl::make_value(m_impl,
+                                               m_impl->get_value_id(name));
     }
 
     ArgumentValue
     ParsedArgumentsBuilder::value(const IArgumentView& arg) const
     {
-        if (auto value = m_impl->get_value(arg.value_id()))
-            return {value->first, m_impl, arg.value_id(), arg.argument_id()};
-        else
-            return {{}, m_impl, arg.value_id(), arg.argument_id()};
+        return ParsedArgumentsImpl::make_value(m_impl, arg.value_id(),
+                                               arg.argument_id());
+    }
+
+    ArgumentValue ParsedArgumentsBuilder::value(ValueHandle handle) const
+    {
+        const auto [value_id, argument_id] = m_impl->get_ids(handle);
+        return ParsedArgumentsImpl::make_value(m_impl, value_id, argument_id);
     }
 
     ArgumentValues
     ParsedArgumentsBuilder::values(const std::string& name) const
     {
-        auto id = m_impl->get_value_id(name);
-        auto values = m_impl->get_values(id);
-        return {std::move(values), m_impl, id};
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_value_id(name));
     }
 
     ArgumentValues
     ParsedArgumentsBuilder::values(const IArgumentView& arg) const
     {
-        auto values = m_impl->get_values(arg.value_id());
-        return {std::move(values), m_impl, arg.value_id()};
+        return ParsedArgumentsImpl::make_values(m_impl, arg.value_id());
+    }
+
+    ArgumentValues ParsedArgumentsBuilder::values(ValueHandle handle) const
+    {
+        return ParsedArgumentsImpl::make_values(m_impl,
+                                                m_impl->get_ids(handle).first);
     }
 
     bool ParsedArgumentsBuilder::has(const std::string& name) const
@@ -106,6 +141,11 @@ namespace argos
         return m_impl->has(arg.value_id());
     }
 
+    bool ParsedArgumentsBuilder::has(ValueHandle handle) const
+    {
+        return m_impl->has(m_impl->get_ids(handle).first);
+    }
+
     void ParsedArgumentsBuilder::error(const std::string& msg) const
     {
          m_impl->error(msg);
@@ -119,6 +159,14 @@ namespace argos
 
     std::ostream& ParsedArgumentsBuilder::stream() const
     {
+        if (m_impl->silent())
+        {
+            // Each thread has its own instance as writing to a stream
+            // without a buffer changes its state.
+            thread_local std::ostream null_stream(nullptr);
+            null_stream.clear();
+            return null_stream;
+        }
         const auto custom_stream = m_impl->parser_data()->help_settings.output_stream;
         return custom_stream ? *custom_stream : std::cout;
     }
@@ -12,67 +12,125 @@
 #include "Argos/ArgumentView.hpp"
 #include "Argos/OptionView.hpp"
 #include "ArgosThrow.hpp"
+#include "ArgumentIteratorImpl.hpp"
 #include "HelpText.hpp"
+#include "ParseValue.hpp"
+#include "ValueBinding.hpp"
 
 namespace argos
 {
-    namespace
+    ParsedArgumentsImpl::ParsedArgumentsImpl(const CommandData* command,
+                                             std::shared_ptr<const ParserData> data,
+                                             std::shared_ptr<StringArena> arena)
+        : m_arena(arena ? std::move(arena) : std::make_shared<StringArena>()),
+          m_command(command),
+          m_data(std::move(data))
     {
-        template <typename ItT, typename ValueT, typename IsLessT>
-        ItT lower_bound(ItT begin, ItT end, ValueT&& v, IsLessT is_less)
+        assert(m_data);
+        const auto& index = m_command->value_index();
+        m_first_value_id = index.first_value_id();
+        m_first_argument_id = index.first_argument_id();
+        const auto values = index.values();
+        m_slots.resize(values.size());
+        m_nonempty_values.assign(0, values.size());
+        m_given_arguments.assign(0, index.argument_count());
+        for (size_t i = 0; i < values.size(); ++i)
         {
-            while (begin != end)
-            {
-                auto offset = std::distance(begin, end) / 2;
-                auto mid = begin + offset;
-                if (is_less(*mid, v))
-                    begin = mid + 1;
-                else
-                    end = mid;
-            }
-            return begin;
+            m_slots[i].type = values[i].type;
+            m_slots[i].binding = values[i].binding;
+            m_slots[i].choices = values[i].choices;
+            m_slots[i].dictionary_separator = values[i].dictionary_separator;
         }
     }
 
-    ParsedArgumentsImpl::ParsedArgumentsImpl(const CommandData* command,
-                                             std::shared_ptr<ParserData> data)
-        : m_command(command),
-          m_data(std::move(data))
+    ParsedArgumentsImpl::~ParsedArgumentsImpl() = default;
+
+    bool ParsedArgumentsImpl::has_shared_subcommands() const
     {
-        assert(m_data);
-        for (auto& a : m_command->arguments)
+        return std::any_of(m_commands.begin(), m_commands.end(),
+                           [](auto& c)
+                           {
+                               return c.use_count() != 1
+                                      || c->has_shared_subcommands();
+                           });
+    }
+
+    void ParsedArgumentsImpl::clear()
+    {
+        m_entries.clear();
+        for (auto& slot : m_slots)
         {
-            m_ids.emplace_back(a->name, a->value_id, a->argument_id);
-            if (!a->alias.empty())
-                m_ids.emplace_back(a->alias, a->value_id, a->argument_id);
+            slot.first = slot.count = 0;
+            slot.is_initial = false;
         }
-        for (auto& o : m_command->options)
+        m_nonempty_values.reset();
+        m_given_arguments.reset();
+        m_values.clear();
+        m_typed_values.clear();
+        m_offsets.clear();
+        m_is_compact = true;
+        // All the sub-commands share the arena, clearing it more than
+        // once is harmless.
+        m_arena->clear();
+        m_unprocessed_arguments.clear();
+        for (auto& command : m_commands)
         {
-            if (o->operation == OptionOperation::NONE)
-                continue;
-
-            for (auto& f : o->flags)
-                m_ids.emplace_back(f, o->value_id, o->argument_id);
-            if (!o->alias.empty())
-                m_ids.emplace_back(o->alias, o->value_id, o->argument_id);
+            command->clear();
+            m_spare_commands.push_back(std::move(command));
         }
-        if (!m_ids.empty())
+        m_commands.clear();
+        m_result_code = ParserResultCode::NONE;
+        m_stop_option = nullptr;
+        m_silent_error = {};
+    }
+
+    void ParsedArgumentsImpl::reserve(size_t value_count, size_t text_size)
+    {
+        m_entries.reserve(value_count);
+        m_arena->reserve(text_size);
+    }
+
+    void ParsedArgumentsImpl::add_initial_values()
+    {
+        const auto& index = m_command->value_index();
+        for (const auto value_id : index.initialized_values())
         {
-            using std::get;
-            sort(m_ids.begin(), m_ids.end());
-            for (auto it = next(m_ids.begin()); it != m_ids.end(); ++it)
+            auto& slot = get_slot(value_id);
+            const auto values = index.initial_values(value_id);
+            m_nonempty_values.set(size_t(value_id - m_first_value_id));
+            if (!slot.binding)
             {
-                auto p = prev(it);
-                if (get<0>(*it) == get<0>(*p) && get<2>(*it) != get<2>(*p))
-                    get<2>(*it) = get<2>(*p) = {};
+                slot.count = values.size();
+                slot.is_initial = true;
+                continue;
             }
-            m_ids.erase(unique(m_ids.begin(), m_ids.end()), m_ids.end());
+
+            const auto typed_values = index.typed_initial_values(value_id);
+            for (size_t i = 0; i < values.size(); ++i)
+                slot.binding->append(values[i].first, typed_values[i]);
+            slot.count += values.size();
         }
     }
 
     bool ParsedArgumentsImpl::has(ValueId value_id) const
     {
-        return m_values.find(value_id) != m_values.end();
+        const auto* slot = find_slot(value_id);
+        return slot && slot->count != 0;
+    }
+
+    const BitSet& ParsedArgumentsImpl::nonempty_values() const
+    {
+        return m_nonempty_values;
+    }
+
+    void ParsedArgumentsImpl::set_given(ArgumentId argument_id)
+    {
+        m_given_arguments.set(size_t(argument_id - m_first_argument_id));
+    }
+
+    const BitSet& ParsedArgumentsImpl::given_arguments() const
+    {
+        return m_given_arguments;
     }
 
     const std::vector<std::string>&
@@ -81,80 +139,244 @@ namespace argos
         return m_unprocessed_arguments;
     }
 
-    void ParsedArgumentsImpl::add_unprocessed_argument(const std::string& arg)
+    void ParsedArgumentsImpl::add_unprocessed_argument(std::string_view arg)
     {
-        m_unprocessed_arguments.push_back(arg);
+        m_unprocessed_arguments.emplace_back(arg);
     }
 
-    std::string_view
+    std::optional<std::string_view>
     ParsedArgumentsImpl::assign_value(ValueId value_id,
-                                      const std::string& value,
+                                      std::string_view value,
                                       ArgumentId argument_id)
     {
-        auto it = m_values.lower_bound(value_id);
-        if (it == m_values.end() || it->first != value_id)
-            return append_value(value_id, value, argument_id);
-
-        it->second = {value, argument_id};
-        auto nxt = next(it);
-        while (nxt != m_values.end() && nxt->first == value_id)
-            m_values.erase(nxt++);
-        return it->second.first;
+        auto& slot = get_slot(value_id);
+        TypedValue typed_value;
+        if (!is_valid_value(slot, value, typed_value))
+            return {};
+        m_nonempty_values.set(size_t(value_id - m_first_value_id));
+        if (slot.binding)
+        {
+            slot.binding->assign(value, typed_value);
+            slot.count = 1;
+            return value;
+        }
+        slot.count = 0;
+        slot.is_initial = false;
+        return add_entry(slot, value_id, value, argument_id, typed_value);
     }
 
-    std::string_view
+    std::optional<std::string_view>
     ParsedArgumentsImpl::append_value(ValueId value_id,
-                                      const std::string& value,
+                                      std::string_view value,
                                       ArgumentId argument_id)
     {
-        return m_values.insert({value_id, {value, argument_id}})->second.first;
+        auto& slot = get_slot(value_id);
+        TypedValue typed_value;
+        if (!is_valid_value(slot, value, typed_value))
+            return {};
+        m_nonempty_values.set(size_t(value_id - m_first_value_id));
+        if (slot.binding)
+        {
+            slot.binding->append(value, typed_value);
+            ++slot.count;
+            return value;
+        }
+        if (slot.is_initial)
+            copy_initial_values(slot, value_id);
+        return add_entry(slot, value_id, value, argument_id, typed_value);
     }
 
     void ParsedArgumentsImpl::clear_value(ValueId value_id)
     {
-        m_values.erase(value_id);
+        auto* slot = find_slot(value_id);
+        if (slot)
+            m_nonempty_values.reset(size_t(value_id - m_first_value_id));
+        if (slot && slot->binding)
+        {
+            slot->binding->clear();
+            slot->count = 0;
+        }
+        else if (slot && slot->count != 0)
+        {
+            slot->count = 0;
+            slot->is_initial = false;
+            m_is_compact = false;
+        }
     }
 
     ValueId
     ParsedArgumentsImpl::get_value_id(std::string_view value_name) const
     {
-        using std::get;
-        auto it = lower_bound(m_ids.begin(), m_ids.end(), value_name,
-                              [](auto& p, auto& s) { return get<0>(p) < s; });
-        if (it == m_ids.end() || get<0>(*it) != value_name)
+        const auto ids = m_command->value_index().find(value_name);
+        if (!ids)
             ARGOS_THROW("Unknown value: " + std::string(value_name));
-        return get<1>(*it);
+        return ids->first;
+    }
+
+    const ChoiceSet* ParsedArgumentsImpl::get_choices(ValueId value_id) const
+    {
+        const auto* slot = find_slot(value_id);
+        return slot ? slot->choices : nullptr;
+    }
+
+    std::pair<ValueId, ArgumentId>
+    ParsedArgumentsImpl::get_ids(ValueHandle handle) const
+    {
+        if (!handle)
+            ARGOS_THROW("ValueHandle has not been set.");
+        const auto index = handle.index();
+        if (handle.command() != m_command->handle_id)
+        {
+            ARGOS_THROW("ValueHandle doesn't belong to command "
+                        + m_command->full_name + ".");
+        }
+        if (handle.is_option() && index < m_command->options.size())
+        {
+            const auto& o = *m_command->options[index];
+            return {o.value_id, o.argument_id};
+        }
+        if (!handle.is_option() && index < m_command->arguments.size())
+        {
+            const auto& a = *m_command->arguments[index];
+            return {a.value_id, a.argument_id};
+        }
+        ARGOS_THROW("ValueHandle doesn't belong to command "
+                    + m_command->full_name + ".");
     }
 
     std::optional<std::pair<std::string_view, ArgumentId>>
     ParsedArgumentsImpl::get_value(ValueId value_id) const
     {
-        auto it = m_values.lower_bound(value_id);
-        if (it == m_values.end() || it->first != value_id)
+        const auto* slot = find_slot(value_id);
+        if (!slot || slot->count == 0 || slot->binding)
             return {};
-        auto nx = next(it);
-        if (nx != m_values.end() && nx->first == value_id)
+        if (slot->count != 1)
             ARGOS_THROW("Attempt to read multiple values as a single value.");
-        return it->second;
+        if (slot->is_initial)
+            return m_command->value_index().initial_values(value_id).front();
+        const auto& entry = m_entries[slot->first];
+        return std::pair(entry.value, entry.argument_id);
     }
 
-    std::vector<std::pair<std::string_view, ArgumentId>>
+    std::span<const std::pair<std::string_view, ArgumentId>>
     ParsedArgumentsImpl::get_values(ValueId value_id) const
     {
-        std::vector<std::pair<std::string_view, ArgumentId>> result;
-        for (auto it = m_values.lower_bound(value_id);
-             it != m_values.end() && it->first == value_id; ++it)
+        const auto* slot = find_slot(value_id);
+        if (!slot || slot->count == 0 || slot->binding)
+            return {};
+        if (slot->is_initial)
+            return m_command->value_index().initial_values(value_id);
+        if (!m_is_compact)
+            do_compact();
+        const auto index = size_t(slot - m_slots.data());
+        return std::span(m_values).subspan(m_offsets[index], slot->count);
+    }
+
+    ArgumentValue
+    ParsedArgumentsImpl::make_value(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                                    ValueId value_id,
+                                    std::optional<ArgumentId> argument_id)
+    {
+        const auto* slot = args->find_slot(value_id);
+        if (!slot || slot->count == 0 || slot->binding)
+            return {{}, args, value_id, argument_id.value_or(ArgumentId())};
+        if (slot->count != 1)
+            ARGOS_THROW("Attempt to read multiple values as a single value.");
+        if (slot->is_initial)
         {
-            result.emplace_back(it->second);
+            const auto& index = args->m_command->value_index();
+            const auto [value, id] = index.initial_values(value_id).front();
+            return {value, args, value_id, argument_id.value_or(id),
+                    slot->type, index.typed_initial_values(value_id).front()};
         }
-        return result;
+        const auto& entry = args->m_entries[slot->first];
+        return {entry.value, args, value_id,
+                argument_id.value_or(entry.argument_id),
+                slot->type, entry.typed_value};
+    }
+
+    ArgumentValues
+    ParsedArgumentsImpl::make_values(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                                     ValueId value_id)
+    {
+        const auto values = args->get_values(value_id);
+        const auto* slot = args->find_slot(value_id);
+        if (values.empty() || slot->type == ValueType::STRING)
+            return {{values.begin(), values.end()}, args, value_id};
+
+        if (slot->is_initial)
+        {
+            const auto typed_values = args->m_command->value_index()
+                .typed_initial_values(value_id);
+            return {{values.begin(), values.end()}, args, value_id,
+                    slot->type, {typed_values.begin(), typed_values.end()}};
+        }
+
+        const auto index = size_t(slot - args->m_slots.data());
+        const auto typed_values = std::span(args->m_typed_values)
+            .subspan(args->m_offsets[index], slot->count);
+        return {{values.begin(), values.end()}, args, value_id,
+                slot->type, {typed_values.begin(), typed_values.end()}};
+    }
+
+    ValuesViewData ParsedArgumentsImpl::make_view(ValueId value_id) const
+    {
+        const auto values = get_values(value_id);
+        if (values.empty())
+            return {{}, {}, ValueType::STRING, this};
+
+        const auto* slot = find_slot(value_id);
+        if (slot->type == ValueType::STRING)
+            return {values, {}, ValueType::STRING, this};
+
+        if (slot->is_initial)
+        {
+            return {values,
+                    m_command->value_index().typed_initial_values(value_id),
+                    slot->type, this};
+        }
+
+        const auto index = size_t(slot - m_slots.data());
+        return {values,
+                std::span(m_typed_values).subspan(m_offsets[index], slot->count),
+                slot->type, this};
+    }
+
+    ArgumentDictionary
+    ParsedArgumentsImpl::make_dictionary(ValueId value_id) const
+    {
+        const auto* slot = find_slot(value_id);
+        const auto separator = slot && slot->dictionary_separator != '\0'
+                                   ? slot->dictionary_separator
+                                   : '=';
+        return {get_values(value_id), separator};
+    }
+
+    void ParsedArgumentsImpl::compact()
+    {
+        if (!m_is_compact)
+            do_compact();
+        for (const auto& command : m_commands)
+            command->compact();
     }
 
     const std::shared_ptr<ParsedArgumentsImpl>&
     ParsedArgumentsImpl::add_subcommand(const CommandData* command)
     {
-        m_commands.push_back(std::make_shared<ParsedArgumentsImpl>(
-            command, m_data));
+        const auto spare = std::find_if(
+            m_spare_commands.begin(), m_spare_commands.end(),
+            [&](auto& c) { return c->command() == command; });
+        if (spare != m_spare_commands.end())
+        {
+            m_commands.push_back(std::move(*spare));
+            m_spare_commands.erase(spare);
+        }
+        else
+        {
+            m_commands.push_back(std::make_shared<ParsedArgumentsImpl>(
+                command, m_data, m_arena));
+        }
+        m_commands.back()->set_silent(m_silent);
         return m_commands.back();
     }
 
@@ -168,36 +390,23 @@ namespace argos
     ParsedArgumentsImpl::get_argument_views(ValueId value_id) const
     {
         std::vector<std::unique_ptr<IArgumentView>> result;
-        for (auto& a : m_command->arguments)
-        {
-            if (a->value_id == value_id)
-                result.emplace_back(std::make_unique<ArgumentView>(a.get()));
-        }
-        for (auto& o : m_command->options)
-        {
-            if (o->value_id == value_id)
-                result.emplace_back(std::make_unique<OptionView>(o.get()));
-        }
+        for (const auto argument_id : m_command->value_index().argument_ids(value_id))
+            result.push_back(get_argument_view(argument_id));
         return result;
     }
 
     std::unique_ptr<IArgumentView>
     ParsedArgumentsImpl::get_argument_view(ArgumentId argument_id) const
     {
-        for (auto& a : m_command->arguments)
-        {
-            if (a->argument_id == argument_id)
-                return std::make_unique<ArgumentView>(a.get());
-        }
-        for (auto& o : m_command->options)
-        {
-            if (o->argument_id == argument_id)
-                return std::make_unique<OptionView>(o.get());
-        }
+        const auto& index = m_command->value_index();
+        if (const auto* a = index.find_argument(argument_id))
+            return std::make_unique<ArgumentView>(a);
+        if (const auto* o = index.find_option(argument_id))
+            return std::make_unique<OptionView>(o);
         return {};
     }
 
-    const std::shared_ptr<ParserData>& ParsedArgumentsImpl::parser_data() const
+    const std::shared_ptr<const ParserData>& ParsedArgumentsImpl::parser_data() const
     {
         return m_data;
     }
@@ -228,8 +437,35 @@ namespace argos
         m_stop_option = option;
     }
 
+    bool ParsedArgumentsImpl::silent() const
+    {
+        return m_silent;
+    }
+
+    void ParsedArgumentsImpl::set_silent(bool silent)
+    {
+        m_silent = silent;
+        for (const auto& command : m_commands)
+            command->set_silent(silent);
+    }
+
+    const std::optional<std::pair<std::string, ArgumentId>>&
+    ParsedArgumentsImpl::silent_error() const
+    {
+        return m_silent_error;
+    }
+
+    IteratorBuffers& ParsedArgumentsImpl::iterator_buffers()
+    {
+        if (!m_iterator_buffers)
+            m_iterator_buffers = std::make_unique<IteratorBuffers>();
+        return *m_iterator_buffers;
+    }
+
     void ParsedArgumentsImpl::error(const std::string& message) const
     {
+        if (m_silent)
+            throw_silent_error(message, {});
         write_error_message(*m_data, *m_command, message);
         if (m_data->parser_settings.auto_exit)
             exit(m_data->parser_settings.error_exit_code);
@@ -238,12 +474,126 @@ namespace argos
     }
 
     void ParsedArgumentsImpl::error(const std::string& message,
-                                    ArgumentId argument_id)
+                                    ArgumentId argument_id) const
     {
+        if (m_silent)
+            throw_silent_error(message, argument_id);
         write_error_message(*m_data, *m_command, message, argument_id);
         if (m_data->parser_settings.auto_exit)
             exit(m_data->parser_settings.error_exit_code);
         else
             ARGOS_THROW("Error while parsing arguments.");
     }
+
+    void ParsedArgumentsImpl::throw_silent_error(const std::string& message,
+                                                 ArgumentId argument_id) const
+    {
+        // ArgumentIteratorImpl turns the stored message into a ParseError,
+        // which only formats it on demand.
+        m_silent_error.emplace(message, argument_id);
+#if ARGOS_EXCEPTIONS
+        ARGOS_THROW("Error while parsing arguments.");
+#else
+        throw_exception(ArgosException(
+            argument_id == ArgumentId{}
+                ? get_error_message(*m_command, message)
+                : get_error_message(*m_command, message, argument_id)));
+#endif
+    }
+
+    ParsedArgumentsImpl::ValueSlot*
+    ParsedArgumentsImpl::find_slot(ValueId value_id)
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        return index < m_slots.size() ? &m_slots[index] : nullptr;
+    }
+
+    const ParsedArgumentsImpl::ValueSlot*
+    ParsedArgumentsImpl::find_slot(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        return index < m_slots.size() ? &m_slots[index] : nullptr;
+    }
+
+    ParsedArgumentsImpl::ValueSlot&
+    ParsedArgumentsImpl::get_slot(ValueId value_id)
+    {
+        auto* slot = find_slot(value_id);
+        if (!slot)
+            ARGOS_THROW("Unknown value ID: " + std::to_string(value_id));
+        return *slot;
+    }
+
+    void ParsedArgumentsImpl::copy_initial_values(ValueSlot& slot,
+                                                  ValueId value_id)
+    {
+        const auto& index = m_command->value_index();
+        const auto values = index.initial_values(value_id);
+        const auto typed_values = index.typed_initial_values(value_id);
+        slot.first = m_entries.size();
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            m_entries.push_back({value_id, values[i].second,
+                                 values[i].first, typed_values[i]});
+        }
+        slot.is_initial = false;
+        m_is_compact = false;
+    }
+
+    bool ParsedArgumentsImpl::is_valid_value(const ValueSlot& slot,
+                                             std::string_view value,
+                                             TypedValue& typed_value)
+    {
+        if (slot.dictionary_separator != '\0'
+            && value.find(slot.dictionary_separator) == std::string_view::npos)
+        {
+            return false;
+        }
+        return parse_typed_value(value, slot.type, slot.choices, typed_value);
+    }
+
+    std::string_view ParsedArgumentsImpl::add_entry(ValueSlot& slot,
+                                                    ValueId value_id,
+                                                    std::string_view value,
+                                                    ArgumentId argument_id,
+                                                    TypedValue typed_value)
+    {
+        if (slot.count++ == 0)
+            slot.first = m_entries.size();
+        const auto text = m_arena->add(value);
+        m_entries.push_back({value_id, argument_id, text, typed_value});
+        m_is_compact = false;
+        return text;
+    }
+
+    void ParsedArgumentsImpl::do_compact() const
+    {
+        // Counting sort of the live entries by ValueId. m_offsets[i + 1]
+        // is used as the insertion point for slot i while the values
+        // are copied, and ends up as the start of slot i + 1.
+        // Bound values and initial values have no entries.
+        auto entry_count = [](const ValueSlot& slot)
+        {
+            return slot.binding || slot.is_initial ? 0 : slot.count;
+        };
+        m_offsets.assign(m_slots.size() + 1, 0);
+        for (size_t i = 1; i < m_slots.size(); ++i)
+            m_offsets[i + 1] = m_offsets[i] + entry_count(m_slots[i - 1]);
+
+        m_values.resize(m_offsets.back() + (m_slots.empty() ? 0 : entry_count(m_slots.back())));
+        m_typed_values.resize(m_values.size());
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            const auto& entry = m_entries[i];
+            const auto index = size_t(entry.value_id) - size_t(m_first_value_id);
+            const auto& slot = m_slots[index];
+            if (entry_count(slot) != 0 && i >= slot.first)
+            {
+                const auto pos = m_offsets[index + 1]++;
+                m_values[pos] = {entry.value, entry.argument_id};
+                m_typed_values[pos] = entry.typed_value;
+            }
+        }
+        m_is_compact = true;
+    }
 }
@@ -6,44 +6,185 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
-#include <map>
-#include "Argos/IArgumentView.hpp"
+#include <span>
+#include "Argos/ArgumentDictionary.hpp"
+#include "Argos/ArgumentValues.hpp"
+#include "Argos/ValueHandle.hpp"
+#include "Argos/ValuesView.hpp"
+#include "BitSet.hpp"
 #include "ParserData.hpp"
+#include "StringArena.hpp"
 
 namespace argos
 {
     class ArgumentIteratorImpl;
+    class ChoiceSet;
+    class ValueBinding;
+    struct IteratorBuffers;
 
     class ParsedArgumentsImpl
     {
     public:
         explicit ParsedArgumentsImpl(const CommandData* command,
-                                     std::shared_ptr<ParserData> data);
+                                     std::shared_ptr<const ParserData> data,
+                                     std::shared_ptr<StringArena> arena = {});
+
+        ParsedArgumentsImpl(const ParsedArgumentsImpl&) = delete;
+
+        ~ParsedArgumentsImpl();
+
+        ParsedArgumentsImpl& operator=(const ParsedArgumentsImpl&) = delete;
+
+        /**
+         * @brief Returns true if the parsed arguments of any of the
+         *  sub-commands are referenced by other objects than their
+         *  parent, i.e. if clear() would invalidate values that are
+         *  still in use.
+         */
+        [[nodiscard]] bool has_shared_subcommands() const;
+
+        /**
+         * @brief Removes all values, sub-commands and unprocessed
+         *  arguments, but keeps the memory for the next parse.
+         *
+         * The sub-commands are kept as well, add_subcommand() reuses
+         * them. Invalidates all string_views to the values. Must not
+         * be called if has_shared_subcommands() returns true.
+         */
+        void clear();
+
+        /**
+         * @brief Reserves room for @a value_count values with a total
+         *  length of @a text_size.
+         */
+        void reserve(size_t value_count, size_t text_size);
+
+        /**
+         * @brief Gives the options their initial values.
+         *
+         * The initial values are not copied, the values are read from
+         * the command's ValueIndex until they are assigned, appended
+         * to or cleared.
+         */
+        void add_initial_values();
 
         [[nodiscard]] bool has(ValueId value_id) const;
 
+        /**
+         * @brief Returns the values that have at least one value, by
+         *  position in the command (value_id - first ValueId).
+         */
+        [[nodiscard]] const BitSet& nonempty_values() const;
+
+        /**
+         * @brief Marks the argument or option with @a argument_id as
+         *  given on the command line.
+         */
+        void set_given(ArgumentId argument_id);
+
+        /**
+         * @brief Returns the arguments and options that were given on
+         *  the command line, by position in the command
+         *  (argument_id - first ArgumentId).
+         */
+        [[nodiscard]] const BitSet& given_arguments() const;
+
         [[nodiscard]] const std::vector<std::string>& unprocessed_arguments() const;
 
-        void add_unprocessed_argument(const std::string& arg);
+        void add_unprocessed_argument(std::string_view arg);
 
-        std::string_view assign_value(ValueId value_id,
-                                      const std::string& value,
-                                      ArgumentId argument_id);
+        /**
+         * @brief Replaces the current values of @a value_id with
+         *  @a value.
+         *
+         * Returns the stored copy of @a value, or nothing if @a value
+         * isn't valid, see is_valid_value(). Nothing is changed in
+         * that case. If the value is bound to a variable,
+         * @a value itself is returned.
+         */
+        std::optional<std::string_view> assign_value(ValueId value_id,
+                                                     std::string_view value,
+                                                     ArgumentId argument_id);
 
-        std::string_view append_value(ValueId value_id,
-                                      const std::string& value,
-                                      ArgumentId argument_id);
+        /**
+         * @brief Adds @a value to the values of @a value_id.
+         *
+         * Returns the stored copy of @a value, or nothing if @a value
+         * isn't valid, see is_valid_value().
+         */
+        std::optional<std::string_view> append_value(ValueId value_id,
+                                                     std::string_view value,
+                                                     ArgumentId argument_id);
 
         void clear_value(ValueId value_id);
 
         [[nodiscard]] ValueId get_value_id(std::string_view value_name) const;
 
+        /**
+         * @brief Returns the choices of @a value_id, or nullptr if it
+         *  doesn't have any.
+         */
+        [[nodiscard]] const ChoiceSet* get_choices(ValueId value_id) const;
+
+        /**
+         * @brief Returns the ValueId and ArgumentId of the argument or
+         *  option @a handle refers to.
+         */
+        [[nodiscard]] std::pair<ValueId, ArgumentId>
+        get_ids(ValueHandle handle) const;
+
         [[nodiscard]] std::optional<std::pair<std::string_view, ArgumentId>>
         get_value(ValueId value_id) const;
 
-        [[nodiscard]] std::vector<std::pair<std::string_view, ArgumentId>>
+        [[nodiscard]] std::span<const std::pair<std::string_view, ArgumentId>>
         get_values(ValueId value_id) const;
 
+        /**
+         * @brief Returns the ArgumentValue for @a value_id in @a args.
+         *
+         * The value's argument ID is used unless @a argument_id is
+         * given. The value carries its converted value if it has a
+         * ValueType.
+         */
+        [[nodiscard]] static ArgumentValue
+        make_value(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                   ValueId value_id,
+                   std::optional<ArgumentId> argument_id = {});
+
+        /**
+         * @brief Returns the ArgumentValues for @a value_id in @a args.
+         */
+        [[nodiscard]] static ArgumentValues
+        make_values(const std::shared_ptr<ParsedArgumentsImpl>& args,
+                    ValueId value_id);
+
+        /**
+         * @brief Returns the data for a ValuesView of the values of
+         *  @a value_id.
+         *
+         * The view refers to the values in this object, compact()
+         * must have been called if several threads use the values.
+         */
+        [[nodiscard]] ValuesViewData make_view(ValueId value_id) const;
+
+        /**
+         * @brief Returns the values of @a value_id as key/value pairs.
+         *
+         * The separator is the one given to Option::dictionary(), or
+         * '=' if the value doesn't have one.
+         */
+        [[nodiscard]] ArgumentDictionary make_dictionary(ValueId value_id) const;
+
+        /**
+         * @brief Groups the values of this command and its sub-commands
+         *  by ValueId.
+         *
+         * get_values() does this on demand, calling compact() when
+         * parsing is complete ensures that the const member functions
+         * can be called concurrently.
+         */
+        void compact();
+
         const std::shared_ptr<ParsedArgumentsImpl>&
         add_subcommand(const CommandData* command);
 
@@ -56,7 +197,7 @@ namespace argos
         [[nodiscard]] std::unique_ptr<IArgumentView>
         get_argument_view(ArgumentId argument_id) const;
 
-        [[nodiscard]] const std::shared_ptr<ParserData>& parser_data() const;
+        [[nodiscard]] const std::shared_ptr<const ParserData>& parser_data() const;
 
         [[nodiscard]] const CommandData* command() const;
 
@@ -68,22 +209,136 @@ namespace argos
 
         void set_breaking_option(const OptionData* option);
 
+        /**
+         * @brief Returns true if errors must be reported with
+         *  exceptions rather than written to the output stream.
+         */
+        [[nodiscard]] bool silent() const;
+
+        /**
+         * @brief Makes error() store the error message and throw an
+         *  ArgosException instead of writing it to the output stream and
+         *  exiting. The setting applies to the current sub-commands,
+         *  and sub-commands added later inherit it.
+         */
+        void set_silent(bool silent);
+
+        /**
+         * @brief Returns the message and argument of the last error()
+         *  in silent mode, if there was one.
+         */
+        [[nodiscard]] const std::optional<std::pair<std::string, ArgumentId>>&
+        silent_error() const;
+
+        /**
+         * @brief Returns the buffers ArgumentIteratorImpl uses when
+         *  this is the top-level command, they are created on demand.
+         */
+        IteratorBuffers& iterator_buffers();
+
         [[noreturn]]
         void error(const std::string& message) const;
 
         [[noreturn]]
-        void error(const std::string& message, ArgumentId argument_id);
+        void error(const std::string& message, ArgumentId argument_id) const;
 
     private:
-        /// The values received from ArgumentIteratorImpl.
-        std::multimap<ValueId, std::pair<std::string, ArgumentId>> m_values;
-        /// Index from flag, argument name or alias to ValueId and ArgumentId
-        std::vector<std::tuple<std::string_view, ValueId, ArgumentId>> m_ids;
+        [[noreturn]]
+        void throw_silent_error(const std::string& message,
+                                ArgumentId argument_id) const;
+
+        struct ValueEntry
+        {
+            ValueId value_id;
+            ArgumentId argument_id;
+            std::string_view value;
+            TypedValue typed_value;
+        };
+
+        struct ValueSlot
+        {
+            /// Index of the first live entry in m_entries.
+            size_t first = 0;
+            size_t count = 0;
+            /// The values are converted to this type when they are added.
+            ValueType type = ValueType::STRING;
+            /// If set, the values are written to the binding instead of
+            /// m_entries, and count is only the number of values.
+            ValueBinding* binding = nullptr;
+            /// If set, the values must be among these.
+            const ChoiceSet* choices = nullptr;
+            /// If non-zero, the values must contain this character.
+            char dictionary_separator = '\0';
+            /// If true, the values are the initial values in the
+            /// command's ValueIndex rather than entries in m_entries.
+            bool is_initial = false;
+        };
+
+        /**
+         * @brief Returns true if @a value can be converted to the
+         *  slot's ValueType, is among its choices and contains its
+         *  dictionary separator.
+         */
+        static bool is_valid_value(const ValueSlot& slot,
+                                   std::string_view value,
+                                   TypedValue& typed_value);
+
+        std::string_view add_entry(ValueSlot& slot,
+                                   ValueId value_id,
+                                   std::string_view value,
+                                   ArgumentId argument_id,
+                                   TypedValue typed_value);
+
+        /**
+         * @brief Copies the views of the initial values in @a slot to
+         *  m_entries so that more values can be added after them.
+         */
+        void copy_initial_values(ValueSlot& slot, ValueId value_id);
+
+        ValueSlot* find_slot(ValueId value_id);
+
+        [[nodiscard]] const ValueSlot* find_slot(ValueId value_id) const;
+
+        ValueSlot& get_slot(ValueId value_id);
+
+        void do_compact() const;
+
+        /// The values received from ArgumentIteratorImpl in the order
+        /// they were received. Entries that precede their slot's first
+        /// index have been overwritten or cleared.
+        std::vector<ValueEntry> m_entries;
+        /// One slot per ValueId in this command, indexed by
+        /// value_id - m_first_value_id.
+        std::vector<ValueSlot> m_slots;
+        ValueId m_first_value_id = {};
+        /// Bit i is set if slot i has at least one value.
+        BitSet m_nonempty_values;
+        /// Bit i is set if the argument or option with ArgumentId
+        /// m_first_argument_id + i has been given.
+        BitSet m_given_arguments;
+        ArgumentId m_first_argument_id = {};
+        /// The live values from m_entries grouped by ValueId, the values
+        /// for slot i are in [m_offsets[i], m_offsets[i + 1]).
+        mutable std::vector<std::pair<std::string_view, ArgumentId>> m_values;
+        /// The converted values, parallel to m_values.
+        mutable std::vector<TypedValue> m_typed_values;
+        mutable std::vector<size_t> m_offsets;
+        mutable bool m_is_compact = true;
+        /// Owns the text of the values, shared with the sub-commands.
+        std::shared_ptr<StringArena> m_arena;
         std::vector<std::string> m_unprocessed_arguments;
         const CommandData* m_command;
         std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_commands;
-        std::shared_ptr<ParserData> m_data;
+        /// Sub-commands from before the last call to clear() that
+        /// add_subcommand() can reuse.
+        std::vector<std::shared_ptr<ParsedArgumentsImpl>> m_spare_commands;
+        std::unique_ptr<IteratorBuffers> m_iterator_buffers;
+        std::shared_ptr<const ParserData> m_data;
         ParserResultCode m_result_code = ParserResultCode::NONE;
         const OptionData* m_stop_option = nullptr;
+        bool m_silent = false;
+        /// Lets ArgumentIteratorImpl report errors from callbacks
+        /// without parsing the exception's message.
+        mutable std::optional<std::pair<std::string, ArgumentId>> m_silent_error;
     };
 }
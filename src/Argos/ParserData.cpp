@@ -6,9 +6,9 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "ParserData.hpp"
+#include "ArgosThrow.hpp"
 #include "Argos/Option.hpp"
-
-#include <iostream>
+#include "ValueBinding.hpp"
 
 namespace argos
 {
@@ -39,27 +39,73 @@ namespace argos
             if (flag.empty())
                 return;
 
-            auto stream = data.help_settings.output_stream
-                              ? data.help_settings.output_stream
-                              : &std::cout;
             auto opt = Option().flag(flag).type(OptionType::STOP)
                 .help("Display the program version.")
                 .constant("1")
-                .callback([v = data.version, stream]
-                (auto& a)
-                    {
-                        *stream << a.builder.program_name() << " " << v << "\n";
-                        return true;
-                    })
+                .callback([v = data.version](auto& a)
+                {
+                    a.builder.stream() << a.builder.program_name() << " " << v << "\n";
+                    return true;
+                })
                 .release();
             opt->section = cmd.current_section;
             cmd.options.push_back(std::move(opt));
         }
     }
 
+    void BindingList::assign(std::vector<ValueBinding*> bindings)
+    {
+        std::lock_guard lock(m_mutex);
+        m_bindings = std::move(bindings);
+        m_empty = m_bindings.empty();
+    }
+
+    bool BindingList::add(std::span<ValueBinding* const> bindings)
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_batches != 0)
+            return false;
+        m_bindings.insert(m_bindings.end(), bindings.begin(), bindings.end());
+        m_empty = m_bindings.empty();
+        return true;
+    }
+
+    void BindingList::reset() const
+    {
+        // Most parsers have no bindings, they don't need the lock.
+        if (m_empty)
+            return;
+
+        std::lock_guard lock(m_mutex);
+        for (auto* binding : m_bindings)
+            binding->reset();
+    }
+
+    bool BindingList::empty() const
+    {
+        return m_empty;
+    }
+
+    void BindingList::begin_batch() const
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_bindings.empty())
+            ARGOS_THROW("parse_batch() can't be used with bound variables.");
+        ++m_batches;
+    }
+
+    void BindingList::end_batch() const
+    {
+        std::lock_guard lock(m_mutex);
+        --m_batches;
+    }
+
     void finish_initialization(ParserData& data)
     {
         add_version_option(data);
         finish_initialization(data.command, data);
+        std::vector<ValueBinding*> bindings;
+        data.command.collect_bindings(bindings);
+        data.bindings.assign(std::move(bindings));
     }
 }
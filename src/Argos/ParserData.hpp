@@ -6,8 +6,11 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <variant>
 #include "Argos/Enums.hpp"
 #include "ArgumentData.hpp"
@@ -32,8 +35,10 @@ namespace argos
         OptionStyle option_style = OptionStyle::STANDARD;
         bool auto_exit = true;
         bool allow_abbreviated_options = false;
+        bool allow_abbreviated_commands = false;
         bool ignore_undefined_options = false;
         bool ignore_undefined_arguments = false;
+        bool allow_response_files = false;
         bool case_insensitive = false;
         bool generate_help_option = true;
         int normal_exit_code = 0;
@@ -47,12 +52,64 @@ namespace argos
         std::vector<std::string> word_split_rules;
     };
 
+    /**
+     * @brief The variables that are bound to the arguments and options
+     *  of a parser.
+     *
+     * Lazily defined sub-commands add their bindings when they are
+     * defined, which can happen while the parser is in use.
+     */
+    class BindingList
+    {
+    public:
+        void assign(std::vector<ValueBinding*> bindings);
+
+        /**
+         * @brief Adds @a bindings to the list unless a batch is running.
+         *
+         * @return false if a batch is running and the bindings weren't
+         *  added.
+         */
+        [[nodiscard]] bool add(std::span<ValueBinding* const> bindings);
+
+        /**
+         * @brief Throws ArgosException if the list has any bindings,
+         *  otherwise makes add() refuse new ones until end_batch()
+         *  is called.
+         *
+         * Batches can overlap, add() accepts bindings again when every
+         * batch has ended.
+         */
+        void begin_batch() const;
+
+        void end_batch() const;
+
+        /**
+         * @brief Gives the variables back the values they had when they
+         *  were bound.
+         */
+        void reset() const;
+
+        [[nodiscard]] bool empty() const;
+
+    private:
+        std::vector<ValueBinding*> m_bindings;
+        std::atomic<bool> m_empty = true;
+        mutable size_t m_batches = 0;
+        mutable std::mutex m_mutex;
+    };
+
     struct ParserData
     {
         CommandData command;
         ParserSettings parser_settings;
         HelpSettings help_settings;
         std::string version;
+        /**
+         * The bindings of all the arguments and options in command,
+         * they are collected by finish_initialization().
+         */
+        BindingList bindings;
     };
 
     void finish_initialization(ParserData& data);
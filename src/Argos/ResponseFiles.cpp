@@ -0,0 +1,140 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ResponseFiles.hpp"
+
+#include <algorithm>
+#include "StringUtilities.hpp"
+
+namespace argos
+{
+    namespace
+    {
+        bool is_response_file(std::string_view arg)
+        {
+            return arg.size() > 1 && arg[0] == '@';
+        }
+    }
+
+    bool ResponseFiles::has_response_files(ArgumentSource args)
+    {
+        for (size_t i = 0; i < args.size(); ++i)
+        {
+            if (is_response_file(args[i]))
+                return true;
+        }
+        return false;
+    }
+
+    bool ResponseFiles::expand(ArgumentSource args)
+    {
+        m_arguments.reserve(m_arguments.size() + args.size());
+        for (size_t i = 0; i < args.size(); ++i)
+        {
+            const auto arg = args[i];
+            if (!is_response_file(arg))
+                m_arguments.push_back(arg);
+            else if (!expand_file(arg))
+                return false;
+        }
+        return true;
+    }
+
+    ArgumentSource ResponseFiles::arguments() const
+    {
+        return ArgumentSource(m_arguments);
+    }
+
+    const std::string& ResponseFiles::error_message() const
+    {
+        return m_error_message;
+    }
+
+    bool ResponseFiles::expand_file(std::string_view arg)
+    {
+        std::error_code ec;
+        auto path = std::filesystem::canonical(
+            std::filesystem::path(arg.substr(1)), ec);
+        auto file = std::make_unique<MappedFile>();
+        if (ec || !file->open(path.string()))
+        {
+            // The same as GCC: files that can't be read are kept as
+            // normal arguments.
+            m_arguments.push_back(arg);
+            return true;
+        }
+
+        if (std::find(m_file_stack.begin(), m_file_stack.end(), path)
+            != m_file_stack.end())
+        {
+            m_error_message = "Response file includes itself: "
+                              + std::string(arg.substr(1));
+            return false;
+        }
+
+        ResponseFileTokenizer tokenizer(file->data());
+        m_files.push_back(std::move(file));
+        m_file_stack.push_back(std::move(path));
+        std::string_view token;
+        while (tokenizer.next(token))
+        {
+            if (!is_response_file(token))
+                m_arguments.push_back(token);
+            else if (!expand_file(token))
+                return false;
+        }
+        m_file_stack.pop_back();
+        return true;
+    }
+
+    ResponseFileTokenizer::ResponseFileTokenizer(std::span<char> text)
+        : m_text(text)
+    {}
+
+    bool ResponseFileTokenizer::next(std::string_view& token)
+    {
+        const auto size = m_text.size();
+        while (m_pos < size && is_space(m_text[m_pos]))
+            ++m_pos;
+        if (m_pos == size)
+            return false;
+
+        const auto start = m_pos;
+        auto out = m_pos;
+        char quote = 0;
+        while (m_pos < size)
+        {
+            auto c = m_text[m_pos];
+            if (quote != 0 && c == quote)
+            {
+                quote = 0;
+                ++m_pos;
+                continue;
+            }
+            if (quote == 0)
+            {
+                if (is_space(c))
+                    break;
+                if (c == '\'' || c == '"')
+                {
+                    quote = c;
+                    ++m_pos;
+                    continue;
+                }
+            }
+            if (c == '\\' && m_pos + 1 < size)
+                c = m_text[++m_pos];
+            if (out != m_pos)
+                m_text[out] = c;
+            ++out;
+            ++m_pos;
+        }
+
+        token = {m_text.data() + start, out - start};
+        return true;
+    }
+}
@@ -0,0 +1,77 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "Argos/ArgumentSource.hpp"
+#include "MappedFile.hpp"
+
+namespace argos
+{
+    /**
+     * @brief Replaces "@FILE" arguments with the arguments in FILE.
+     *
+     * The files are memory-mapped and tokenized in place: quotes and
+     * escape characters are removed by moving the rest of the token
+     * backwards in the mapped memory, and the arguments are views of
+     * the mapped memory. Both the files and the arguments remain valid
+     * until the ResponseFiles instance is destroyed.
+     */
+    class ResponseFiles
+    {
+    public:
+        /**
+         * @brief Returns true if any of @a args starts with '@'.
+         */
+        static bool has_response_files(ArgumentSource args);
+
+        /**
+         * @brief Appends @a args to arguments(), with response files
+         *  replaced by their contents.
+         *
+         * Returns false if a response file refers to itself, directly or
+         * through other response files, see error_message().
+         */
+        bool expand(ArgumentSource args);
+
+        [[nodiscard]] ArgumentSource arguments() const;
+
+        [[nodiscard]] const std::string& error_message() const;
+    private:
+        bool expand_file(std::string_view arg);
+
+        std::vector<std::unique_ptr<MappedFile>> m_files;
+        std::vector<std::string_view> m_arguments;
+        /// The files that are currently being expanded.
+        std::vector<std::filesystem::path> m_file_stack;
+        std::string m_error_message;
+    };
+
+    /**
+     * @brief Splits @a text into arguments in place.
+     *
+     * Arguments are separated by whitespace. Single and double quotes
+     * group characters, including whitespace, into a single argument,
+     * and a backslash makes the next character a normal character.
+     * Characters are only written to @a text where a quote or backslash
+     * has been removed earlier in the same argument.
+     */
+    class ResponseFileTokenizer
+    {
+    public:
+        explicit ResponseFileTokenizer(std::span<char> text);
+
+        bool next(std::string_view& token);
+    private:
+        std::span<char> m_text;
+        size_t m_pos = 0;
+    };
+}
@@ -0,0 +1,157 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "SplitValues.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include "ParseValue.hpp"
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+        /**
+         * @brief Counts the occurrences of @a c in @a text eight bytes
+         *  at a time.
+         */
+        size_t count_char(std::string_view text, char c)
+        {
+            constexpr uint64_t ONES = 0x0101010101010101u;
+            constexpr uint64_t LOW_BITS = 0x7F7F7F7F7F7F7F7Fu;
+            const auto pattern = ONES * uint8_t(c);
+            size_t count = 0;
+            size_t i = 0;
+            for (; i + 8 <= text.size(); i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, text.data() + i, 8);
+                // The high bit of a byte in zeros is set if and only if
+                // the byte in word equals c.
+                const auto x = word ^ pattern;
+                const auto zeros = ~(((x & LOW_BITS) + LOW_BITS) | x | LOW_BITS);
+                count += size_t(std::popcount(zeros));
+            }
+            for (; i < text.size(); ++i)
+                count += text[i] == c ? 1 : 0;
+            return count;
+        }
+
+        template <typename T>
+        std::optional<T> convert_part(std::string_view part)
+        {
+            if constexpr (std::is_integral_v<T>)
+                return parse_integer<T>(part, 10);
+            else
+                return parse_floating_point<T>(part);
+        }
+
+        template <typename T>
+        std::optional<std::string_view>
+        convert_chunk(std::string_view chunk, char separator, T* out)
+        {
+            while (true)
+            {
+                const auto pos = chunk.find(separator);
+                const auto part = chunk.substr(0, pos);
+                const auto value = convert_part<T>(part);
+                if (!value)
+                    return part;
+                *out++ = *value;
+                if (pos == std::string_view::npos)
+                    return {};
+                chunk.remove_prefix(pos + 1);
+            }
+        }
+    }
+
+    SplitChunks split_chunks(std::string_view text, char separator,
+                             unsigned thread_count)
+    {
+        SplitChunks result;
+        if (text.empty())
+            return result;
+
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        const auto chunk_count = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE,
+                                                    1, thread_count);
+
+        // Each chunk ends where the first separator after its share of
+        // the text is.
+        size_t begin = 0;
+        for (size_t i = 1; i < chunk_count; ++i)
+        {
+            const auto pos = text.find(separator, std::max(
+                begin, text.size() * i / chunk_count));
+            if (pos == std::string_view::npos)
+                break;
+            result.chunks.push_back(text.substr(begin, pos - begin));
+            begin = pos + 1;
+        }
+        result.chunks.push_back(text.substr(begin));
+
+        for (const auto& chunk : result.chunks)
+        {
+            result.offsets.push_back(result.count);
+            result.count += count_char(chunk, separator) + 1;
+        }
+        return result;
+    }
+
+    template <typename T>
+    std::optional<std::string_view>
+    convert_chunks(const SplitChunks& chunks, char separator, T* out)
+    {
+        const auto n = chunks.chunks.size();
+        std::vector<std::optional<std::string_view>> errors(n);
+        auto work = [&](size_t i)
+        {
+            errors[i] = convert_chunk(chunks.chunks[i], separator,
+                                      out + chunks.offsets[i]);
+        };
+
+        // jthread, as the threads that have been started must be joined
+        // if starting one of the others fails.
+        std::vector<std::jthread> threads;
+        threads.reserve(n == 0 ? 0 : n - 1);
+        for (size_t i = 1; i < n; ++i)
+            threads.emplace_back(work, i);
+        if (n != 0)
+            work(0);
+        for (auto& thread : threads)
+            thread.join();
+
+        for (const auto& error : errors)
+        {
+            if (error)
+                return error;
+        }
+        return {};
+    }
+
+#define ARGOS_CONVERT_CHUNKS(type) \
+    template std::optional<std::string_view> \
+    convert_chunks<type>(const SplitChunks&, char, type*)
+
+    ARGOS_CONVERT_CHUNKS(int);
+    ARGOS_CONVERT_CHUNKS(unsigned);
+    ARGOS_CONVERT_CHUNKS(long);
+    ARGOS_CONVERT_CHUNKS(long long);
+    ARGOS_CONVERT_CHUNKS(unsigned long);
+    ARGOS_CONVERT_CHUNKS(unsigned long long);
+    ARGOS_CONVERT_CHUNKS(float);
+    ARGOS_CONVERT_CHUNKS(double);
+
+#undef ARGOS_CONVERT_CHUNKS
+}
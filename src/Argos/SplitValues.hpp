@@ -0,0 +1,53 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace argos
+{
+    /**
+     * @brief A text that is split on a separator, divided into chunks
+     *  of whole parts that can be converted by different threads.
+     */
+    struct SplitChunks
+    {
+        /// The chunks in order. The separators between them are not
+        /// included.
+        std::vector<std::string_view> chunks;
+        /// The index of the first part of each chunk.
+        std::vector<size_t> offsets;
+        /// The total number of parts.
+        size_t count = 0;
+    };
+
+    /**
+     * @brief Divides @a text into at most @a thread_count chunks and
+     *  counts the parts separated by @a separator in each of them.
+     *
+     * An empty text has no parts. Small texts are not divided, every
+     * chunk gets at least 64 KiB. If @a thread_count is 0, the number
+     * of hardware threads is used.
+     */
+    SplitChunks split_chunks(std::string_view text, char separator,
+                             unsigned thread_count);
+
+    /**
+     * @brief Converts the parts of @a chunks to numbers and writes them
+     *  to @a out, which must have room for chunks.count numbers.
+     *
+     * Each chunk is converted by its own thread. Returns the first
+     * part that isn't a valid number, if any, in which case the
+     * contents of @a out are unspecified. Integers are parsed in
+     * base 10.
+     */
+    template <typename T>
+    std::optional<std::string_view>
+    convert_chunks(const SplitChunks& chunks, char separator, T* out);
+}
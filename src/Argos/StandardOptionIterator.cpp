@@ -7,124 +7,180 @@
 //****************************************************************************
 #include "StandardOptionIterator.hpp"
 
+#include <array>
 #include "ArgosThrow.hpp"
-#include "StringUtilities.hpp"
 
 namespace argos
 {
-    StandardOptionIterator::StandardOptionIterator()
+    namespace
     {
+        /// "-\0-\1-\2...", lets next() return split short flags without
+        /// allocating strings.
+        constexpr auto SHORT_FLAGS = []
+        {
+            std::array<char, 512> result = {};
+            for (size_t i = 0; i < 256; ++i)
+            {
+                result[2 * i] = '-';
+                result[2 * i + 1] = char(i);
+            }
+            return result;
+        }();
+
+        std::string_view get_short_flag(char c)
+        {
+            return {&SHORT_FLAGS[2 * static_cast<unsigned char>(c)], 2};
+        }
     }
 
+    StandardOptionIterator::StandardOptionIterator() = default;
+
     StandardOptionIterator::StandardOptionIterator(std::vector<std::string_view> args)
-        : m_all_args(args.begin(), args.end()),
-          m_args(m_all_args)
+        : m_queue(std::move(args))
     {
+        m_args = m_queue.arguments();
     }
 
-    StandardOptionIterator::StandardOptionIterator(const StandardOptionIterator& rhs)
-        : m_all_args(rhs.m_all_args),
-          m_args(m_all_args.begin() + rhs.m_all_args.size() - rhs.m_args.size(), m_all_args.end()),
-          m_pos(rhs.m_pos)
+    StandardOptionIterator::StandardOptionIterator(ArgumentSource args)
+        : m_args(args)
     {
     }
 
-    std::optional<std::string> StandardOptionIterator::next()
+    StandardOptionIterator StandardOptionIterator::lookahead() const
+    {
+        StandardOptionIterator result(m_args);
+        result.m_pos = m_pos;
+        result.m_index = m_index;
+        return result;
+    }
+
+    std::optional<std::string_view> StandardOptionIterator::next()
     {
         if (m_pos != 0)
         {
             // m_pos is always greater than one if we get here.
-            if (m_pos < m_args[0].size() && m_args[0][1] != '-')
+            const auto arg = m_args.front();
+            if (m_pos < arg.size() && arg[1] != '-')
             {
-                const auto c = m_args[0][m_pos++];
-                if (m_pos == m_args[0].size())
-                    m_pos = std::string::npos;
-                return std::string{'-', c};
+                const auto c = arg[m_pos++];
+                if (m_pos == arg.size())
+                    m_pos = std::string_view::npos;
+                return get_short_flag(c);
             }
-            pop_front(m_args);
+            m_args.pop_front();
+            ++m_index;
             m_pos = 0;
         }
 
         if (m_args.empty())
             return {};
 
-        if (m_args[0].size() <= 2 || m_args[0][0] != '-')
+        const auto arg = m_args.front();
+        if (arg.size() <= 2 || arg[0] != '-')
         {
-            m_pos = std::string::npos;
-            return m_args[0];
+            m_pos = std::string_view::npos;
+            return arg;
         }
 
-        if (m_args[0][1] != '-')
+        if (arg[1] != '-')
         {
             m_pos = 2;
-            return m_args[0].substr(0, 2);
+            return arg.substr(0, 2);
         }
 
-        m_pos = m_args[0].find('=');
+        m_pos = arg.find('=');
 
-        if (m_pos == std::string::npos)
-            return m_args[0];
+        if (m_pos == std::string_view::npos)
+            return arg;
 
         m_pos++;
-        return m_args[0].substr(0, m_pos);
+        return arg.substr(0, m_pos);
     }
 
-    std::optional<std::string> StandardOptionIterator::next_value()
+    std::optional<std::string_view> StandardOptionIterator::next_value()
     {
         if (m_args.empty())
             return {};
 
-        if (m_pos != std::string::npos)
+        if (m_pos != std::string_view::npos)
         {
             const auto pos = m_pos;
-            m_pos = std::string::npos;
-            return m_args[0].substr(pos);
+            m_pos = std::string_view::npos;
+            return m_args.front().substr(pos);
         }
 
-        pop_front(m_args);
+        m_args.pop_front();
+        ++m_index;
         if (m_args.empty())
         {
             m_pos = 0;
             return {};
         }
 
-        return m_args[0];
+        return m_args.front();
     }
 
     std::string_view StandardOptionIterator::current() const
     {
         if (m_args.empty())
             ARGOS_THROW("There is no current argument.");
-        return m_args[0];
+        return m_args.front();
+    }
+
+    size_t StandardOptionIterator::index() const
+    {
+        return m_index;
+    }
+
+    bool StandardOptionIterator::is_within_argument() const
+    {
+        // Mirrors the first test in next().
+        if (m_pos == 0 || m_args.empty())
+            return false;
+        const auto arg = m_args.front();
+        return m_pos < arg.size() && arg[1] != '-';
     }
 
-    std::span<std::string> StandardOptionIterator::remaining_arguments()
+    ArgumentSource StandardOptionIterator::remaining_arguments()
     {
         split_concatenated_flags();
         return m_pos == 0 ? m_args : m_args.subspan(1);
     }
 
-    void StandardOptionIterator::insert(std::vector<std::string> args)
+    void StandardOptionIterator::insert(const std::vector<std::string>& args)
     {
         split_concatenated_flags();
-        auto args_index = m_all_args.size() - m_args.size();
-        auto insert_index = args_index;
-        if (m_pos != 0)
-            insert_index++;
-        m_all_args.insert(m_all_args.begin() + insert_index,
-                          args.begin(), args.end());
-        m_args = std::span(m_all_args.begin() + args_index, m_all_args.end());
+        std::vector<std::string_view> views;
+        views.reserve(args.size());
+        for (const auto& arg : args)
+            views.push_back(m_strings.add(arg));
+        insert_arguments(m_pos != 0 ? 1 : 0, views);
     }
 
     void StandardOptionIterator::split_concatenated_flags()
     {
-        if (m_pos == 0 || m_pos >= m_args[0].size() || m_args[0][1] == '-')
+        if (m_pos == 0 || m_args.empty())
             return;
 
-        auto index = m_all_args.size() - m_args.size();
-        m_all_args.insert(m_all_args.begin() + index + 1,
-                          "-" + m_args[0].substr(m_pos));
-        m_all_args[index].resize(m_pos);
-        m_args = std::span(m_all_args.begin() + index, m_all_args.end());
+        const auto arg = m_args.front();
+        if (m_pos >= arg.size() || arg[1] == '-')
+            return;
+
+        // Replaces "-abc" with "-a" and "-bc".
+        const std::string_view parts[] = {
+            arg.substr(0, m_pos),
+            m_strings.add("-" + std::string(arg.substr(m_pos)))
+        };
+        m_args.pop_front();
+        insert_arguments(0, parts);
+        // Both parts have the position of the argument they came from.
+        --m_index;
+    }
+
+    void StandardOptionIterator::insert_arguments(
+        size_t pos,
+        std::span<const std::string_view> args)
+    {
+        m_args = m_queue.insert(m_args, pos, args);
     }
 }
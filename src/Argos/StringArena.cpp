@@ -0,0 +1,57 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "StringArena.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace argos
+{
+    namespace
+    {
+        constexpr size_t MIN_BLOCK_SIZE = 256;
+    }
+
+    void StringArena::reserve(size_t size)
+    {
+        if (size <= m_available)
+            return;
+
+        m_block_size = std::max(size, MIN_BLOCK_SIZE);
+        m_blocks.push_back(std::make_unique_for_overwrite<char[]>(m_block_size));
+        m_next = m_blocks.back().get();
+        m_available = m_block_size;
+    }
+
+    std::string_view StringArena::add(std::string_view str)
+    {
+        if (str.empty())
+            return {};
+
+        if (str.size() > m_available)
+            reserve(std::max(str.size(), 2 * m_block_size));
+
+        std::memcpy(m_next, str.data(), str.size());
+        std::string_view result(m_next, str.size());
+        m_next += str.size();
+        m_available -= str.size();
+        return result;
+    }
+
+    void StringArena::clear()
+    {
+        if (m_blocks.empty())
+            return;
+
+        // The last block is the largest one.
+        if (m_blocks.size() > 1)
+            m_blocks.erase(m_blocks.begin(), std::prev(m_blocks.end()));
+        m_next = m_blocks.back().get();
+        m_available = m_block_size;
+    }
+}
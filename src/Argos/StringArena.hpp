@@ -0,0 +1,45 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace argos
+{
+    /**
+     * @brief Stores strings in a small number of large blocks.
+     *
+     * Strings are never moved or freed individually, the string_views
+     * returned by add() remain valid until the arena is destroyed.
+     */
+    class StringArena
+    {
+    public:
+        /**
+         * @brief Makes sure that strings with a total size of at least
+         *  @a size can be added without allocating more memory.
+         */
+        void reserve(size_t size);
+
+        std::string_view add(std::string_view str);
+
+        /**
+         * @brief Removes all strings, but keeps the largest block for
+         *  the strings that are added next.
+         *
+         * Invalidates all string_views returned by add().
+         */
+        void clear();
+    private:
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        char* m_next = nullptr;
+        size_t m_available = 0;
+        size_t m_block_size = 0;
+    };
+}
@@ -220,4 +220,15 @@ namespace argos
             return c < 'A' || 'Z' < c;
         });
     }
+
+    uint32_t hash_string(std::string_view str, bool case_insensitive)
+    {
+        uint32_t h = 2166136261u;
+        for (const char c : str)
+        {
+            h ^= uint8_t(case_insensitive ? to_lower(c) : c);
+            h *= 16777619u;
+        }
+        return h;
+    }
 }
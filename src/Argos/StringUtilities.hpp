@@ -7,6 +7,7 @@
 //****************************************************************************
 #pragma once
 
+#include <cstdint>
 #include <span>
 #include <string>
 #include <string_view>
@@ -48,6 +49,21 @@ namespace argos
 
     bool is_lower(std::string_view word);
 
+    /**
+     * @brief Returns the 32-bit FNV-1a hash of @a str, or of @a str in
+     *  lower case if @a case_insensitive is true.
+     */
+    uint32_t hash_string(std::string_view str, bool case_insensitive = false);
+
+    /**
+     * @brief Returns true for the characters that isspace() accepts in
+     *  the "C" locale.
+     */
+    inline bool is_space(char c)
+    {
+        return c == ' ' || ('\t' <= c && c <= '\r');
+    }
+
     template <typename T>
     inline void pop_front(std::span<T>& span)
     {
@@ -0,0 +1,183 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Argos/ArgumentValue.hpp"
+
+namespace argos
+{
+    /**
+     * @brief Writes the values of an argument or option to a variable
+     *  in the program rather than to ParsedArguments.
+     */
+    class ValueBinding
+    {
+    public:
+        virtual ~ValueBinding() = default;
+
+        /**
+         * @brief The type the values must be converted to before they
+         *  are passed to assign() or append().
+         */
+        [[nodiscard]] virtual ValueType value_type() const = 0;
+
+        /**
+         * @brief Replaces the variable's current value or values with
+         *  @a value.
+         *
+         * @a text is the value before it was converted.
+         */
+        virtual void assign(std::string_view text, const TypedValue& value) = 0;
+
+        /**
+         * @brief Adds @a value to a vector, replaces any other value.
+         */
+        virtual void append(std::string_view text, const TypedValue& value) = 0;
+
+        /**
+         * @brief Empties a vector, gives any other variable back the
+         *  value it had when the binding was made.
+         */
+        virtual void clear() = 0;
+
+        /**
+         * @brief Gives the variable back the value it had when the
+         *  binding was made, which is done before each parse.
+         */
+        virtual void reset() = 0;
+    };
+
+    template <typename T>
+    struct BoundType;
+
+#define ARGOS_BOUND_TYPE(type, value_type_, member) \
+    template <> \
+    struct BoundType<type> \
+    { \
+        static constexpr ValueType VALUE_TYPE = ValueType::value_type_; \
+        static type get(std::string_view, const TypedValue& value) \
+        { \
+            return value.member; \
+        } \
+    }
+
+    ARGOS_BOUND_TYPE(bool, BOOL, bool_value);
+    ARGOS_BOUND_TYPE(int, INT, int_value);
+    ARGOS_BOUND_TYPE(unsigned, UINT, uint_value);
+    ARGOS_BOUND_TYPE(long, LONG, long_value);
+    ARGOS_BOUND_TYPE(long long, LLONG, llong_value);
+    ARGOS_BOUND_TYPE(unsigned long, ULONG, ulong_value);
+    ARGOS_BOUND_TYPE(unsigned long long, ULLONG, ullong_value);
+    ARGOS_BOUND_TYPE(float, FLOAT, float_value);
+    ARGOS_BOUND_TYPE(double, DOUBLE, double_value);
+
+#undef ARGOS_BOUND_TYPE
+
+    template <>
+    struct BoundType<std::string>
+    {
+        static constexpr ValueType VALUE_TYPE = ValueType::STRING;
+
+        static std::string get(std::string_view text, const TypedValue&)
+        {
+            return std::string(text);
+        }
+    };
+
+    template <typename T>
+    class ScalarBinding : public ValueBinding
+    {
+    public:
+        explicit ScalarBinding(T& variable)
+            : m_variable(variable),
+              m_default_value(variable)
+        {}
+
+        [[nodiscard]] ValueType value_type() const override
+        {
+            return BoundType<T>::VALUE_TYPE;
+        }
+
+        void assign(std::string_view text, const TypedValue& value) override
+        {
+            m_variable = BoundType<T>::get(text, value);
+        }
+
+        void append(std::string_view text, const TypedValue& value) override
+        {
+            m_variable = BoundType<T>::get(text, value);
+        }
+
+        void clear() override
+        {
+            m_variable = m_default_value;
+        }
+
+        void reset() override
+        {
+            m_variable = m_default_value;
+        }
+    private:
+        T& m_variable;
+        T m_default_value;
+    };
+
+    template <typename T>
+    class VectorBinding : public ValueBinding
+    {
+    public:
+        explicit VectorBinding(std::vector<T>& variable)
+            : m_variable(variable),
+              m_default_value(variable)
+        {}
+
+        [[nodiscard]] ValueType value_type() const override
+        {
+            return BoundType<T>::VALUE_TYPE;
+        }
+
+        void assign(std::string_view text, const TypedValue& value) override
+        {
+            m_variable.clear();
+            m_variable.push_back(BoundType<T>::get(text, value));
+        }
+
+        void append(std::string_view text, const TypedValue& value) override
+        {
+            m_variable.push_back(BoundType<T>::get(text, value));
+        }
+
+        void clear() override
+        {
+            m_variable.clear();
+        }
+
+        void reset() override
+        {
+            m_variable = m_default_value;
+        }
+    private:
+        std::vector<T>& m_variable;
+        std::vector<T> m_default_value;
+    };
+
+    template <typename T>
+    std::shared_ptr<ValueBinding> make_binding(T& variable)
+    {
+        return std::make_shared<ScalarBinding<T>>(variable);
+    }
+
+    template <typename T>
+    std::shared_ptr<ValueBinding> make_binding(std::vector<T>& variable)
+    {
+        return std::make_shared<VectorBinding<T>>(variable);
+    }
+}
@@ -0,0 +1,257 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ValueIndex.hpp"
+
+#include <algorithm>
+#include <climits>
+#include "ArgumentData.hpp"
+#include "OptionData.hpp"
+#include "ParseValue.hpp"
+
+namespace argos
+{
+    ValueIndex::ValueIndex() = default;
+
+    ValueIndex::ValueIndex(
+        const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+        const std::vector<std::unique_ptr<OptionData>>& options)
+    {
+        using std::get;
+
+        // Every argument and option that has a value, in the order
+        // argument_ids() returns them.
+        std::vector<std::tuple<ValueId, ArgumentId, ValueType, ValueBinding*,
+                               const ChoiceSet*, char>> values;
+        auto get_choices = [](const ChoiceSet& choices)
+        {
+            return choices.empty() ? nullptr : &choices;
+        };
+        for (const auto& a : arguments)
+        {
+            m_names.emplace_back(a->name, a->value_id, a->argument_id);
+            if (!a->alias.empty())
+                m_names.emplace_back(a->alias, a->value_id, a->argument_id);
+            values.emplace_back(a->value_id, a->argument_id,
+                                a->value_type, a->binding.get(),
+                                get_choices(a->choices), '\0');
+        }
+        for (const auto& o : options)
+        {
+            if (o->operation == OptionOperation::NONE)
+                continue;
+
+            for (const auto& f : o->flags)
+                m_names.emplace_back(f, o->value_id, o->argument_id);
+            if (!o->alias.empty())
+                m_names.emplace_back(o->alias, o->value_id, o->argument_id);
+            values.emplace_back(o->value_id, o->argument_id,
+                                o->value_type, o->binding.get(),
+                                get_choices(o->choices),
+                                o->dictionary_separator);
+        }
+
+        if (!m_names.empty())
+        {
+            std::sort(m_names.begin(), m_names.end());
+            for (auto it = next(m_names.begin()); it != m_names.end(); ++it)
+            {
+                auto p = prev(it);
+                if (get<0>(*it) == get<0>(*p) && get<2>(*it) != get<2>(*p))
+                    get<2>(*it) = get<2>(*p) = {};
+            }
+            m_names.erase(std::unique(m_names.begin(), m_names.end()),
+                          m_names.end());
+        }
+
+        if (!values.empty())
+        {
+            // The value IDs of a command are consecutive.
+            const auto [min_it, max_it] = std::minmax_element(
+                values.begin(), values.end(),
+                [](auto& a, auto& b) { return get<0>(a) < get<0>(b); });
+            m_first_value_id = get<0>(*min_it);
+            m_values.resize(size_t(get<0>(*max_it) - m_first_value_id) + 1);
+
+            // Counting sort of the ArgumentIds by ValueId, m_value_offsets
+            // is used as the insertion point like in
+            // ParsedArgumentsImpl::do_compact().
+            m_value_offsets.assign(m_values.size() + 1, 0);
+            for (const auto& v : values)
+                ++m_value_offsets[size_t(get<0>(v) - m_first_value_id) + 1];
+            for (size_t i = 1; i < m_value_offsets.size(); ++i)
+                m_value_offsets[i] += m_value_offsets[i - 1];
+            m_value_arguments.resize(values.size());
+            auto next_pos = m_value_offsets;
+            for (const auto& [value_id, argument_id, type, binding, choices,
+                              separator] : values)
+            {
+                const auto index = size_t(value_id - m_first_value_id);
+                m_value_arguments[next_pos[index]++] = argument_id;
+                // CommandData has verified that values that are shared
+                // by several arguments and options don't have
+                // conflicting types, bindings, choices or separators.
+                auto& info = m_values[index];
+                if (type != ValueType::STRING)
+                    info.type = type;
+                if (binding)
+                    info.binding = binding;
+                if (choices)
+                    info.choices = choices;
+                if (separator)
+                    info.dictionary_separator = separator;
+            }
+        }
+
+        for (const auto& info : m_values)
+        {
+            if (info.binding)
+                m_bindings.push_back(info.binding);
+        }
+
+        // The initial values, grouped by value in the order of the
+        // options. CommandData has verified that they can be converted
+        // to the values' types.
+        m_initial_offsets.assign(m_values.size() + 1, 0);
+        std::vector<const OptionData*> initialized;
+        for (const auto& o : options)
+        {
+            if (o->operation == OptionOperation::NONE
+                || o->initial_value.empty())
+            {
+                continue;
+            }
+            initialized.push_back(o.get());
+            ++m_initial_offsets[size_t(o->value_id - m_first_value_id) + 1];
+        }
+        std::stable_sort(initialized.begin(), initialized.end(),
+                         [](auto* a, auto* b) { return a->value_id < b->value_id; });
+        for (size_t i = 1; i < m_initial_offsets.size(); ++i)
+            m_initial_offsets[i] += m_initial_offsets[i - 1];
+        for (const auto* o : initialized)
+        {
+            if (m_initialized_values.empty()
+                || m_initialized_values.back() != o->value_id)
+            {
+                m_initialized_values.push_back(o->value_id);
+            }
+            m_initial_values.emplace_back(o->initial_value, o->argument_id);
+            TypedValue value;
+            const auto& info = m_values[size_t(o->value_id - m_first_value_id)];
+            parse_typed_value(o->initial_value, info.type, info.choices, value);
+            m_typed_initial_values.push_back(value);
+        }
+
+        // The argument IDs of a command are consecutive too.
+        int min_id = INT_MAX, max_id = INT_MIN;
+        auto update_range = [&](ArgumentId id)
+        {
+            min_id = std::min(min_id, int(id));
+            max_id = std::max(max_id, int(id));
+        };
+        for (const auto& a : arguments)
+            update_range(a->argument_id);
+        for (const auto& o : options)
+            update_range(o->argument_id);
+        if (min_id > max_id)
+            return;
+
+        m_first_argument_id = ArgumentId(min_id);
+        m_arguments.resize(size_t(max_id - min_id) + 1);
+        for (const auto& a : arguments)
+            m_arguments[size_t(a->argument_id - min_id)].first = a.get();
+        for (const auto& o : options)
+            m_arguments[size_t(o->argument_id - min_id)].second = o.get();
+    }
+
+    std::optional<std::pair<ValueId, ArgumentId>>
+    ValueIndex::find(std::string_view name) const
+    {
+        using std::get;
+        const auto it = std::lower_bound(
+            m_names.begin(), m_names.end(), name,
+            [](auto& entry, std::string_view s) { return get<0>(entry) < s; });
+        if (it == m_names.end() || get<0>(*it) != name)
+            return {};
+        return std::pair(get<1>(*it), get<2>(*it));
+    }
+
+    ValueId ValueIndex::first_value_id() const
+    {
+        return m_first_value_id;
+    }
+
+    std::span<const ValueIndex::ValueInfo> ValueIndex::values() const
+    {
+        return m_values;
+    }
+
+    std::span<ValueBinding* const> ValueIndex::bindings() const
+    {
+        return m_bindings;
+    }
+
+    std::span<const ArgumentId>
+    ValueIndex::argument_ids(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        if (index >= m_values.size())
+            return {};
+        return std::span(m_value_arguments).subspan(
+            m_value_offsets[index],
+            m_value_offsets[index + 1] - m_value_offsets[index]);
+    }
+
+    std::span<const ValueId> ValueIndex::initialized_values() const
+    {
+        return m_initialized_values;
+    }
+
+    std::span<const std::pair<std::string_view, ArgumentId>>
+    ValueIndex::initial_values(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        if (index >= m_values.size())
+            return {};
+        return std::span(m_initial_values).subspan(
+            m_initial_offsets[index],
+            m_initial_offsets[index + 1] - m_initial_offsets[index]);
+    }
+
+    std::span<const TypedValue>
+    ValueIndex::typed_initial_values(ValueId value_id) const
+    {
+        const auto index = size_t(value_id) - size_t(m_first_value_id);
+        if (index >= m_values.size())
+            return {};
+        return std::span(m_typed_initial_values).subspan(
+            m_initial_offsets[index],
+            m_initial_offsets[index + 1] - m_initial_offsets[index]);
+    }
+
+    const ArgumentData* ValueIndex::find_argument(ArgumentId argument_id) const
+    {
+        const auto index = size_t(argument_id) - size_t(m_first_argument_id);
+        return index < m_arguments.size() ? m_arguments[index].first : nullptr;
+    }
+
+    const OptionData* ValueIndex::find_option(ArgumentId argument_id) const
+    {
+        const auto index = size_t(argument_id) - size_t(m_first_argument_id);
+        return index < m_arguments.size() ? m_arguments[index].second : nullptr;
+    }
+
+    ArgumentId ValueIndex::first_argument_id() const
+    {
+        return m_first_argument_id;
+    }
+
+    size_t ValueIndex::argument_count() const
+    {
+        return m_arguments.size();
+    }
+}
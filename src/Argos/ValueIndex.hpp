@@ -0,0 +1,160 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Argos/ArgumentValue.hpp"
+
+namespace argos
+{
+    struct ArgumentData;
+    class ChoiceSet;
+    struct OptionData;
+    class ValueBinding;
+
+    /**
+     * @brief The ValueIds and ArgumentIds of a command's arguments and
+     *  options, and the names they can be looked up by.
+     *
+     * The index is built once when the command's definition is
+     * complete, so ParsedArgumentsImpl doesn't have to build it for
+     * every parse.
+     */
+    class ValueIndex
+    {
+    public:
+        struct ValueInfo
+        {
+            ValueType type = ValueType::STRING;
+            ValueBinding* binding = nullptr;
+            /// The values the value is restricted to, if any.
+            const ChoiceSet* choices = nullptr;
+            /// Non-zero if the values are key/value pairs separated by
+            /// this character.
+            char dictionary_separator = '\0';
+        };
+
+        ValueIndex();
+
+        /**
+         * @brief Indexes @a arguments and @a options, whose ValueIds
+         *  and ArgumentIds must have been assigned.
+         *
+         * Arguments and options that share a value are assumed to have
+         * the same ValueType, binding, choices and dictionary separator.
+         */
+        ValueIndex(const std::vector<std::unique_ptr<ArgumentData>>& arguments,
+                   const std::vector<std::unique_ptr<OptionData>>& options);
+
+        /**
+         * @brief Returns the ValueId and ArgumentId of the argument or
+         *  option with the name, flag or alias @a name.
+         *
+         * The ArgumentId is empty if several arguments or options have
+         * the same name.
+         */
+        [[nodiscard]] std::optional<std::pair<ValueId, ArgumentId>>
+        find(std::string_view name) const;
+
+        /**
+         * @brief The lowest ValueId in the command.
+         */
+        [[nodiscard]] ValueId first_value_id() const;
+
+        /**
+         * @brief The type and binding of each value in the command,
+         *  indexed by value_id - first_value_id().
+         */
+        [[nodiscard]] std::span<const ValueInfo> values() const;
+
+        /**
+         * @brief Returns the bindings of the command's values.
+         */
+        [[nodiscard]] std::span<ValueBinding* const> bindings() const;
+
+        /**
+         * @brief Returns the ArgumentIds of the arguments and options
+         *  with value @a value_id, arguments first.
+         */
+        [[nodiscard]] std::span<const ArgumentId>
+        argument_ids(ValueId value_id) const;
+
+        /**
+         * @brief Returns the values that have initial values, in
+         *  ascending order.
+         */
+        [[nodiscard]] std::span<const ValueId> initialized_values() const;
+
+        /**
+         * @brief Returns the initial values of the options with value
+         *  @a value_id, and the ArgumentIds of the options.
+         *
+         * The views refer to the strings in the options' OptionData.
+         */
+        [[nodiscard]] std::span<const std::pair<std::string_view, ArgumentId>>
+        initial_values(ValueId value_id) const;
+
+        /**
+         * @brief Returns the initial values of value @a value_id
+         *  converted to its ValueType, parallel to initial_values().
+         */
+        [[nodiscard]] std::span<const TypedValue>
+        typed_initial_values(ValueId value_id) const;
+
+        /**
+         * @brief Returns the argument with @a argument_id, or nullptr
+         *  if it is an option or not part of the command.
+         */
+        [[nodiscard]] const ArgumentData*
+        find_argument(ArgumentId argument_id) const;
+
+        /**
+         * @brief Returns the option with @a argument_id, or nullptr if
+         *  it is an argument or not part of the command.
+         */
+        [[nodiscard]] const OptionData*
+        find_option(ArgumentId argument_id) const;
+
+        /**
+         * @brief The lowest ArgumentId of the command's arguments and
+         *  options.
+         */
+        [[nodiscard]] ArgumentId first_argument_id() const;
+
+        /**
+         * @brief The number of arguments and options in the command,
+         *  their ArgumentIds are consecutive from first_argument_id().
+         */
+        [[nodiscard]] size_t argument_count() const;
+    private:
+        /// Flags, argument names and aliases sorted by name.
+        std::vector<std::tuple<std::string_view, ValueId, ArgumentId>> m_names;
+        ValueId m_first_value_id = {};
+        std::vector<ValueInfo> m_values;
+        std::vector<ValueBinding*> m_bindings;
+        /// The ArgumentIds of value i are in
+        /// [m_value_offsets[i], m_value_offsets[i + 1]).
+        std::vector<ArgumentId> m_value_arguments;
+        std::vector<size_t> m_value_offsets;
+        std::vector<ValueId> m_initialized_values;
+        /// The initial values of value i are in
+        /// [m_initial_offsets[i], m_initial_offsets[i + 1]).
+        std::vector<std::pair<std::string_view, ArgumentId>> m_initial_values;
+        std::vector<TypedValue> m_typed_initial_values;
+        std::vector<size_t> m_initial_offsets;
+        ArgumentId m_first_argument_id = {};
+        /// Indexed by argument_id - m_first_argument_id, exactly one
+        /// of the pointers is set in each entry.
+        std::vector<std::pair<const ArgumentData*, const OptionData*>> m_arguments;
+    };
+}
@@ -0,0 +1,26 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Argos/ValuesView.hpp"
+
+#include "ArgosThrow.hpp"
+#include "ParseValue.hpp"
+#include "ParsedArgumentsImpl.hpp"
+
+namespace argos
+{
+    TypedValue ValuesViewData::convert(size_t index, ValueType type) const
+    {
+        const auto& [value, argument_id] = values[index];
+        TypedValue result;
+        if (parse_typed_value(value, type, result))
+            return result;
+        if (!args)
+            ARGOS_THROW("Invalid value: " + std::string(value) + ".");
+        args->error("Invalid value: " + std::string(value) + ".", argument_id);
+    }
+}
@@ -0,0 +1,149 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<size_t> allocation_count = 0;
+    std::atomic<size_t> allocated_bytes = 0;
+
+    void* allocate(size_t size, size_t alignment = 0) noexcept
+    {
+        ++allocation_count;
+        allocated_bytes += size;
+        if (size == 0)
+            size = 1;
+        if (alignment == 0)
+            return std::malloc(size);
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        return std::aligned_alloc(alignment,
+                                  (size + alignment - 1) / alignment * alignment);
+    }
+
+    void* allocate_or_throw(size_t size, size_t alignment = 0)
+    {
+        if (void* p = allocate(size, alignment))
+            return p;
+        throw std::bad_alloc();
+    }
+}
+
+// All the variants of new and delete are replaced, as a program that
+// mixes them with the default ones, e.g. under AddressSanitizer, reports
+// mismatched allocations and deallocations.
+
+void* operator new(size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void* operator new[](size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, size_t(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, size_t(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept
+{
+    return allocate(size, size_t(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept
+{
+    return allocate(size, size_t(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+AllocationCount current_allocation_count()
+{
+    return {allocation_count, allocated_bytes};
+}
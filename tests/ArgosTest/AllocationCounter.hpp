@@ -0,0 +1,30 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief The number and total size of the allocations made with
+ *  operator new and new[], which AllocationCounter.cpp replaces.
+ */
+struct AllocationCount
+{
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+AllocationCount current_allocation_count();
+
+template <typename Func>
+AllocationCount count_allocations(Func func)
+{
+    const auto start = current_allocation_count();
+    func();
+    const auto end = current_allocation_count();
+    return {end.count - start.count, end.bytes - start.bytes};
+}
@@ -9,6 +9,8 @@
 #include "Argos/ArgumentCounter.hpp"
 #include "../../include/Argos/Argument.hpp"
 
+#include <climits>
+
 TEST_CASE("Test non-deterministic counter.")
 {
     argos::CommandData command;
@@ -41,3 +43,26 @@ TEST_CASE("Test non-deterministic counter.")
         REQUIRE(counter.next_argument() == nullptr);
     }
 }
+
+TEST_CASE("find_argument distributes values like the counter")
+{
+    argos::CommandData command;
+    auto& args = command.arguments;
+    args.push_back(argos::Argument("1").count(1, UINT_MAX).release());
+    args.push_back(argos::Argument("2").count(0, 1).release());
+    args.push_back(argos::Argument("3").release());
+
+    for (size_t total = 0; total < 6; ++total)
+    {
+        argos::ArgumentCounter counter(command, total);
+        for (size_t i = 0; i < total; ++i)
+        {
+            CAPTURE(total, i);
+            REQUIRE(argos::ArgumentCounter::find_argument(command, total, i)
+                    == counter.next_argument());
+        }
+    }
+
+    REQUIRE(argos::ArgumentCounter::find_argument(command, SIZE_MAX, 1) == args[0].get());
+    REQUIRE(argos::ArgumentCounter::find_argument(command, 3, 3) == nullptr);
+}
@@ -8,6 +8,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Argos/ArgumentParser.hpp"
 
+#include <array>
+#include <span>
 #include <sstream>
 #include "Argv.hpp"
 
@@ -309,6 +311,23 @@ TEST_CASE("LAST_OPTION option")
     REQUIRE(args.value("arg").as_string() == "--bar");
 }
 
+TEST_CASE("LAST_OPTION option with DASH option style")
+{
+    using namespace argos;
+    Argv argv{"test", "--", "-bar", "baz", "qux"};
+    auto args = argos::ArgumentParser("test")
+        .auto_exit(false)
+        .option_style(OptionStyle::DASH)
+        .add(Argument("arg").count(1, 5))
+        .add(Option("-bar"))
+        .add(Option("--").type(OptionType::LAST_OPTION))
+        .parse(argv.size(), argv.data());
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(!args.value("-bar").as_bool());
+    REQUIRE(args.values("arg").as_strings()
+            == std::vector<std::string>{"-bar", "baz", "qux"});
+}
+
 TEST_CASE("Argument with variable count")
 {
     using namespace argos;
@@ -708,6 +727,41 @@ TEST_CASE("Test options with initial_value")
     }
 }
 
+TEST_CASE("Initial values with APPEND, CLEAR and shared values")
+{
+    using namespace argos;
+    using V = std::vector<std::string>;
+    auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Option{"-i"}.argument("DIR").initial_value("/usr")
+            .operation(OptionOperation::APPEND))
+        .add(Option{"-I"}.alias("-i").argument("DIR").initial_value("/opt")
+            .operation(OptionOperation::APPEND))
+        .add(Option{"--no-dirs"}.alias("-i")
+            .operation(OptionOperation::CLEAR))
+        .add(Option{"-n"}.argument("N").initial_value("5")
+            .value_type(ValueType::INT))
+        .compile();
+
+    auto args = parser.parse(std::vector<std::string_view>{});
+    REQUIRE(args.values("-i").as_strings() == V{"/usr", "/opt"});
+    REQUIRE(args.value("-n").as_int() == 5);
+    REQUIRE(args.value("-n").argument()->argument_id()
+            == args.all_options()[3]->argument_id());
+
+    args = parser.parse(std::vector<std::string_view>{"-I", "/home", "-n", "7"});
+    REQUIRE(args.values("-i").as_strings() == V{"/usr", "/opt", "/home"});
+    REQUIRE(args.value("-n").as_int() == 7);
+
+    args = parser.parse(std::vector<std::string_view>{"--no-dirs", "-i", "/a"});
+    REQUIRE(args.values("-i").as_strings() == V{"/a"});
+
+    args = parser.parse(std::vector<std::string_view>{"--no-dirs"});
+    REQUIRE(!args.has("-i"));
+    REQUIRE(args.values("-i").empty());
+    REQUIRE(args.value("-n").as_int() == 5);
+}
+
 TEST_CASE("Version option")
 {
     using namespace argos;
@@ -760,3 +814,41 @@ TEST_CASE("Check that word-splitting rules are used")
     auto help_text = ss.str();
     REQUIRE(help_text == "USAGE\n  test\n\nFull of weird in-\ncomprehensibilities.\n");
 }
+
+TEST_CASE("Parse arguments from different kinds of ranges")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Argument("FILE"))
+        .add(Option{"-n"}.argument("NUM"))
+        .compile();
+
+    SECTION("std::vector<std::string>")
+    {
+        std::vector<std::string> args{"-n", "5", "file.txt"};
+        auto result = parser.parse(args);
+        REQUIRE(result.value("-n").as_int() == 5);
+        REQUIRE(result.value("FILE").as_string() == "file.txt");
+    }
+
+    SECTION("std::array<const char*>")
+    {
+        std::array<const char*, 2> args{"-n7", "file.txt"};
+        auto result = parser.parse(args);
+        REQUIRE(result.value("-n").as_int() == 7);
+        REQUIRE(result.value("FILE").as_string() == "file.txt");
+    }
+
+    SECTION("std::span<char*>")
+    {
+        Argv argv{"test", "file.txt", "-n", "9"};
+        auto result = ArgumentParser("test")
+            .auto_exit(false)
+            .add(Argument("FILE"))
+            .add(Option{"-n"}.argument("NUM"))
+            .parse(std::span(argv.data() + 1, argv.size() - 1));
+        REQUIRE(result.value("-n").as_int() == 9);
+        REQUIRE(result.value("FILE").as_string() == "file.txt");
+    }
+}
@@ -6,9 +6,11 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgosException.hpp"
 #include "Argos/ArgumentParser.hpp"
 
 #include <cstring>
+#include <sstream>
 
 TEST_CASE("Test ArgumentValue split")
 {
@@ -71,3 +73,150 @@ TEST_CASE("ArgumentValueIterator")
     }
     REQUIRE(i == strlen(expected));
 }
+
+TEST_CASE("Typed values are converted while parsing")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Argument("N").value_type(ValueType::INT))
+        .add(Option{"-x"}.argument("X").value_type(ValueType::DOUBLE)
+            .operation(OptionOperation::APPEND))
+        .add(Option{"-b"}.argument("B").value_type(ValueType::BOOL))
+        .add(Option{"-u"}.argument("U").value_type(ValueType::ULLONG)
+            .initial_value("7"))
+        .parse({"-x", "0.5", "12", "-x", "-2.25", "-b", "false"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("N").as_int() == 12);
+    REQUIRE(args.value("N").as_int(0, 16) == 18);
+    REQUIRE(args.value("N").as_long() == 12);
+    REQUIRE(args.value("N").as_string() == "12");
+    REQUIRE(args.values("-x").as_doubles() == std::vector<double>{0.5, -2.25});
+    REQUIRE(args.values("-x").value(1).as_double() == -2.25);
+    REQUIRE(args.values("-x").values()[0].as_double() == 0.5);
+    REQUIRE(args.values("-x").as_floats() == std::vector<float>{0.5, -2.25});
+    REQUIRE(!args.value("-b").as_bool(true));
+    REQUIRE(args.value("-u").as_ullong() == 7);
+}
+
+TEST_CASE("Invalid typed values are parse errors")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Argument("N").value_type(ValueType::UINT))
+        .add(Option{"-n"}.argument("NUM").value_type(ValueType::INT))
+        .compile();
+
+    auto args = parser.parse({"-n", "1x", "1"});
+    REQUIRE(args.result_code() == ParserResultCode::FAILURE);
+    REQUIRE(ss.str().find("-n: Invalid value: 1x.") != std::string::npos);
+
+    ss.str({});
+    args = parser.parse({"-n", "2", "1.5"});
+    REQUIRE(args.result_code() == ParserResultCode::FAILURE);
+    REQUIRE(ss.str().find("N: Invalid value: 1.5.") != std::string::npos);
+
+    args = parser.parse({"-n", "-3", "4"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("-n").as_int() == -3);
+}
+
+TEST_CASE("Invalid value type definitions")
+{
+    using namespace argos;
+    REQUIRE_THROWS_AS(ArgumentParser("test")
+                          .auto_exit(false)
+                          .add(Option{"-n"}.constant("one")
+                              .value_type(ValueType::INT))
+                          .parse({}),
+                      ArgosException);
+    REQUIRE_THROWS_AS(ArgumentParser("test")
+                          .auto_exit(false)
+                          .add(Option{"-n"}.argument("N").initial_value("1e400")
+                              .value_type(ValueType::DOUBLE))
+                          .parse({}),
+                      ArgosException);
+    REQUIRE_THROWS_AS(ArgumentParser("test")
+                          .auto_exit(false)
+                          .add(Option{"-n"}.argument("N")
+                              .value_type(ValueType::INT))
+                          .add(Option{"-m"}.argument("N").alias("-n")
+                              .value_type(ValueType::LONG))
+                          .parse({}),
+                      ArgosException);
+
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Option{"-n"}.argument("N").value_type(ValueType::INT))
+        .add(Option{"-m"}.constant("5").alias("-n"))
+        .parse({"-n", "4", "-m"});
+    REQUIRE(args.value("-n").as_int() == 5);
+}
+
+TEST_CASE("Split and convert values in bulk")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"-w"}.argument("W").operation(OptionOperation::APPEND))
+        .compile();
+
+    auto args = compiled.parse({"-w", "1,-2, 3", "-w", "4"});
+    REQUIRE(args.values("-w").split_as<int>(',')
+            == std::vector<int>{1, -2, 3, 4});
+    REQUIRE(args.values("-w").split_as<double>(',')
+            == std::vector<double>{1, -2, 3, 4});
+
+    long buffer[4] = {};
+    REQUIRE(args.values("-w").split_into<long>(buffer, ',') == 4);
+    REQUIRE(buffer[2] == 3);
+    REQUIRE_THROWS_AS(args.values("-w").split_into<long>({buffer, 3}, ','),
+                      ArgosException);
+    REQUIRE(ss.str().find("-w: Too many values: 4. The maximum is 3.")
+            != std::string::npos);
+
+    args = compiled.parse({"-w", "1,2,,4"});
+    REQUIRE_THROWS_AS(args.value("-w").split_as<unsigned>(','),
+                      ArgosException);
+    REQUIRE(ss.str().find("Invalid value: .") != std::string::npos);
+
+    args = compiled.parse({});
+    REQUIRE(args.value("-w").split_as<float>(',').empty());
+    REQUIRE(args.values("-w").split_as<float>(',').empty());
+}
+
+TEST_CASE("Split and convert a large value with several threads")
+{
+    using namespace argos;
+    std::string text;
+    for (int i = 0; i < 100000; ++i)
+        text += std::to_string(i) + ";";
+    text += "100000";
+
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Argument("IDS"))
+        .compile();
+    auto args = compiled.parse({text});
+    std::vector<long long> expected(100001);
+    for (size_t i = 0; i < expected.size(); ++i)
+        expected[i] = static_cast<long long>(i);
+    REQUIRE(args.value("IDS").split_as<long long>(';', 4) == expected);
+
+    // The first invalid part is reported, regardless of which thread
+    // converts it.
+    text.replace(text.find(";50000;"), 7, ";5000x;");
+    text.replace(text.find(";90000;"), 7, ";9000y;");
+    args = compiled.parse({text});
+    REQUIRE_THROWS_AS(args.value("IDS").split_as<int>(';', 4),
+                      ArgosException);
+    REQUIRE(ss.str().find("Invalid value: 5000x.") != std::string::npos);
+    REQUIRE(ss.str().find("9000y") == std::string::npos);
+}
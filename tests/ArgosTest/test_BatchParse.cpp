@@ -0,0 +1,146 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgumentParser.hpp"
+
+#include <atomic>
+#include <ranges>
+#include <sstream>
+
+namespace
+{
+    argos::CompiledParser make_parser(std::ostream& stream)
+    {
+        using namespace argos;
+        ArgumentParser parser("test");
+        // The batch must neither write to the stream nor exit.
+        parser.auto_exit(true)
+            .stream(&stream)
+            .version("2.0")
+            .add(Arg("FILE"))
+            .add(Opt("-n", "--number").argument("NUM"))
+            .add(Opt("--check").argument("N")
+                .callback([](OptionCallbackArguments& a)
+                {
+                    if (a.value != "ok")
+                        a.builder.error("not ok", a.view);
+                }));
+        return parser.compile();
+    }
+
+    template <typename Range>
+    concept CanParseBatch = requires (const argos::CompiledParser& parser,
+                                      const Range& command_lines)
+    {
+        parser.parse_batch(command_lines);
+    };
+}
+
+TEST_CASE("parse_batch returns results in input order")
+{
+    std::stringstream ss;
+    const auto parser = make_parser(ss);
+    std::vector<std::vector<std::string>> command_lines;
+    for (int i = 0; i < 1000; ++i)
+    {
+        switch (i % 4)
+        {
+        case 0:
+            command_lines.push_back({"-n", std::to_string(i), "file"});
+            break;
+        case 1:
+            command_lines.push_back({"--unknown", "file"});
+            break;
+        case 2:
+            command_lines.push_back({"--help"});
+            break;
+        default:
+            command_lines.push_back({"--check", "bad", "file"});
+            break;
+        }
+    }
+
+    std::atomic<int> sum = 0;
+    const auto results = parser.parse_batch(
+        command_lines, 4,
+        [&](size_t index, const argos::ParsedArguments& args)
+        {
+            if (index % 4 == 0)
+                sum += args.value("-n").as_int();
+        });
+
+    REQUIRE(results.size() == command_lines.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        switch (i % 4)
+        {
+        case 0:
+            REQUIRE(result.result_code == argos::ParserResultCode::SUCCESS);
+            REQUIRE(result.error_message.empty());
+            break;
+        case 1:
+            REQUIRE(result.result_code == argos::ParserResultCode::FAILURE);
+            REQUIRE(result.error_message == "test: Unknown option: --unknown");
+            break;
+        case 2:
+            REQUIRE(result.result_code == argos::ParserResultCode::STOP);
+            break;
+        default:
+            REQUIRE(result.result_code == argos::ParserResultCode::FAILURE);
+            REQUIRE(result.error_message == "test: --check: not ok");
+            break;
+        }
+    }
+    REQUIRE(sum == 249 * 500);
+    REQUIRE(ss.str().empty());
+}
+
+TEST_CASE("parse_batch only accepts ranges that store their command lines")
+{
+    using CommandLines = std::vector<std::vector<std::string>>;
+    // A view that creates copies of the command lines when they are read.
+    using Copies = decltype(std::views::transform(
+        std::declval<const CommandLines&>(),
+        [](const std::vector<std::string>& line) { return line; }));
+
+    STATIC_REQUIRE(CanParseBatch<CommandLines>);
+    STATIC_REQUIRE(CanParseBatch<std::span<const std::vector<std::string_view>>>);
+    STATIC_REQUIRE(!CanParseBatch<Copies>);
+}
+
+TEST_CASE("parse_batch with more threads than command lines")
+{
+    std::stringstream ss;
+    const auto parser = make_parser(ss);
+    const std::vector<std::vector<std::string_view>> command_lines = {
+        {"a"}, {"--version"}, {}
+    };
+    const auto results = parser.parse_batch(command_lines, 16);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].result_code == argos::ParserResultCode::SUCCESS);
+    REQUIRE(results[1].result_code == argos::ParserResultCode::STOP);
+    REQUIRE(results[2].result_code == argos::ParserResultCode::FAILURE);
+    REQUIRE(ss.str().empty());
+
+    REQUIRE(parser.parse_batch(std::vector<std::vector<std::string>>()).empty());
+}
+
+TEST_CASE("parse_batch passes on exceptions from the callback")
+{
+    std::stringstream ss;
+    const auto parser = make_parser(ss);
+    const std::vector<std::vector<std::string>> command_lines(100, {"file"});
+    REQUIRE_THROWS_AS(parser.parse_batch(
+        command_lines, 2,
+        [](size_t index, const argos::ParsedArguments&)
+        {
+            if (index == 50)
+                throw std::runtime_error("callback");
+        }), std::runtime_error);
+}
@@ -135,3 +135,146 @@ TEST_CASE("Test option callback adding new args")
     REQUIRE_FALSE(args.value("-c").as_bool());
     REQUIRE(args.value("-d").as_bool());
 }
+
+TEST_CASE("Option callback adding arguments to variadic argument")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Argument("FILE").count(1, 10))
+        .add(Argument("DIR"))
+        .add(Option({"--two"}).callback(
+            [](auto& oa)
+            {
+                oa.new_arguments = {"x", "y"};
+            }))
+        .parse({"a", "--two", "b", "--two", "c"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("FILE").as_strings()
+            == std::vector<std::string>{"a", "x", "y", "b", "x", "y"});
+    REQUIRE(args.value("DIR").as_string() == "c");
+}
+
+TEST_CASE("Option callbacks expanding to options with callbacks")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Argument("FILE").count(0, 1000))
+        .add(Option({"-n"}).argument("N").operation(OptionOperation::APPEND))
+        .add(Option({"--inner"}).callback(
+            [](auto& oa)
+            {
+                for (int i = 0; i < 100; ++i)
+                    oa.new_arguments.push_back("f" + std::to_string(i));
+            }))
+        .add(Option({"--outer"}).callback(
+            [](auto& oa)
+            {
+                oa.new_arguments = {"-n", "1", "--inner", "-n", "2", "--inner"};
+            }))
+        .parse({"a", "--outer", "b", "--outer", "c"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("-n").as_strings()
+            == std::vector<std::string>{"1", "2", "1", "2"});
+    const auto files = args.values("FILE").as_strings();
+    REQUIRE(files.size() == 403);
+    REQUIRE(files[0] == "a");
+    REQUIRE(files[1] == "f0");
+    REQUIRE(files[200] == "f99");
+    REQUIRE(files[201] == "b");
+    REQUIRE(files[202] == "f0");
+    REQUIRE(files[402] == "c");
+}
+
+TEST_CASE("Option callback adding option that takes the next argument")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Argument("FILE").count(1, 10))
+        .add(Argument("DIR"))
+        .add(Option({"-o"}).argument("NAME"))
+        .add(Option({"--out"}).callback(
+            [](auto& oa)
+            {
+                oa.new_arguments = {"-o"};
+            }))
+        .parse({"a", "--out", "b", "c", "d"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("-o").as_string() == "b");
+    REQUIRE(args.values("FILE").as_strings() == std::vector<std::string>{"a", "c"});
+    REQUIRE(args.value("DIR").as_string() == "d");
+}
+
+TEST_CASE("Option callback adding end of options marker")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Argument("FILE").count(1, 10))
+        .add(Argument("DIR"))
+        .add(Option({"--"}).type(OptionType::LAST_OPTION))
+        .add(Option({"-v"}))
+        .add(Option({"--rest"}).callback(
+            [](auto& oa)
+            {
+                oa.new_arguments = {"--"};
+            }))
+        .parse({"a", "--rest", "-v", "b"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(!args.has("-v"));
+    REQUIRE(args.values("FILE").as_strings() == std::vector<std::string>{"a", "-v"});
+    REQUIRE(args.value("DIR").as_string() == "b");
+}
+
+TEST_CASE("Argument callback adding arguments before a sibling command")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .allow_multiple_subcommands(true)
+        .add(Command("copy")
+            .add(Argument("FILE").count(1, 10)
+                .callback([](auto& aa)
+                {
+                    if (aa.value == "a")
+                        aa.new_arguments = {"b"};
+                }))
+            .add(Argument("DIR")))
+        .parse({"copy", "a", "copy", "d", "copy", "e", "f"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto commands = args.subcommands();
+    REQUIRE(commands.size() == 2);
+    REQUIRE(commands[0].values("FILE").as_strings()
+            == std::vector<std::string>{"a"});
+    REQUIRE(commands[0].value("DIR").as_string() == "b");
+    REQUIRE(commands[1].values("FILE").as_strings()
+            == std::vector<std::string>{"d", "copy", "e"});
+    REQUIRE(commands[1].value("DIR").as_string() == "f");
+}
+
+TEST_CASE("Argument callback turning a sibling command into an argument")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .allow_multiple_subcommands(true)
+        .add(Command("copy")
+            .add(Argument("FILE").count(1, 10)
+                .callback([](auto& aa)
+                {
+                    if (aa.value == "a")
+                        aa.new_arguments = {"-o"};
+                }))
+            .add(Argument("DIR"))
+            .add(Option({"-o"}).argument("NAME")))
+        .parse({"copy", "a", "b", "copy", "d", "e"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto commands = args.subcommands();
+    REQUIRE(commands.size() == 1);
+    REQUIRE(commands[0].value("-o").as_string() == "b");
+    REQUIRE(commands[0].values("FILE").as_strings()
+            == std::vector<std::string>{"a", "copy", "d"});
+    REQUIRE(commands[0].value("DIR").as_string() == "e");
+}
@@ -0,0 +1,150 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/Argos.hpp"
+
+#include <sstream>
+
+namespace
+{
+    bool contains(const std::stringstream& ss, std::string_view text)
+    {
+        return ss.str().find(text) != std::string::npos;
+    }
+}
+
+TEST_CASE("Option with choices")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"--color"}.argument("COLOR")
+                              .choices({"red", "green", "blue"}))
+        .compile();
+
+    auto args = compiled.parse({"--color", "blue"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("--color").as_choice() == 2);
+    REQUIRE(args.value("--color").as_string() == "blue");
+
+    args = compiled.parse({});
+    REQUIRE(args.value("--color").as_choice() == -1);
+    REQUIRE(args.value("--color").as_choice(0) == 0);
+
+    args = compiled.parse({"--color", "Blue"});
+    REQUIRE(args.result_code() == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "Invalid value: Blue."));
+}
+
+TEST_CASE("Case-insensitive choices")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .case_insensitive(true)
+        .add(Option{"--color"}.argument("COLOR")
+                              .choices({"red", "green", "blue"}))
+        .parse({"--COLOR", "GrEeN"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("--color").as_choice() == 1);
+}
+
+TEST_CASE("Argument with choices")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Argument("MODE").count(1, 3).choices({"fast", "slow", "off"}))
+        .compile();
+
+    auto args = compiled.parse({"off", "fast", "off"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("MODE").as_choices() == std::vector<int>{2, 0, 2});
+
+    REQUIRE(compiled.parse({"fast", "medium"}).result_code()
+            == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "MODE: Invalid value: medium."));
+}
+
+TEST_CASE("Choices with another value type")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"--size"}.argument("N")
+                             .value_type(ValueType::INT)
+                             .choices({"8", "16", "32"}))
+        .compile();
+
+    auto args = compiled.parse({"--size", "16"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("--size").as_int() == 16);
+    REQUIRE(args.value("--size").as_choice() == 1);
+
+    REQUIRE(compiled.parse({"--size", "12"}).result_code()
+            == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "Invalid value: 12."));
+}
+
+TEST_CASE("Options sharing a value with choices")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Option{"--level"}.argument("LEVEL")
+                              .choices({"low", "high"})
+                              .initial_value("low"))
+        .add(Option{"--high"}.alias("--level").constant("high"))
+        .parse({"--high"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("--level").as_choice() == 1);
+}
+
+TEST_CASE("Invalid choices")
+{
+    using namespace argos;
+    SECTION("Choice listed twice")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-a"}.argument("A").choices({"x", "y", "x"}));
+        REQUIRE_THROWS(parser.compile());
+    }
+    SECTION("Choice listed twice when case-insensitive")
+    {
+        ArgumentParser parser("test");
+        parser.case_insensitive(true)
+            .add(Option{"-a"}.argument("A").choices({"x", "X"}));
+        REQUIRE_THROWS(parser.compile());
+    }
+    SECTION("Initial value that isn't a choice")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-a"}.argument("A").choices({"x", "y"})
+                               .initial_value("z"));
+        REQUIRE_THROWS(parser.compile());
+    }
+    SECTION("Conflicting choices")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-a"}.argument("A").choices({"x", "y"}))
+            .add(Option{"-b"}.argument("B").alias("-a").choices({"x"}));
+        REQUIRE_THROWS(parser.compile());
+    }
+    SECTION("CHOICE without choices")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-a"}.argument("A").value_type(ValueType::CHOICE));
+        REQUIRE_THROWS(parser.compile());
+    }
+}
@@ -0,0 +1,135 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgumentParser.hpp"
+
+#include <sstream>
+#include <thread>
+#include "Argv.hpp"
+
+namespace
+{
+    argos::ArgumentParser make_parser()
+    {
+        using namespace argos;
+        ArgumentParser parser("test");
+        parser.auto_exit(false)
+            .add(Arg("FILE").count(1, 2))
+            .add(Opt("-n", "--number").argument("NUM"))
+            .add(Opt("-v", "--verbose"));
+        return parser;
+    }
+}
+
+TEST_CASE("CompiledParser parses repeatedly")
+{
+    const auto parser = make_parser().compile();
+    for (int i = 0; i < 3; ++i)
+    {
+        auto args = parser.parse({"-v", "a.txt", "--number=" + std::to_string(i)});
+        REQUIRE(args.result_code() == argos::ParserResultCode::SUCCESS);
+        REQUIRE(args.value("--verbose").as_bool());
+        REQUIRE(args.value("--number").as_int() == i);
+        REQUIRE(args.value("FILE").as_string() == "a.txt");
+    }
+}
+
+TEST_CASE("CompiledParser with argc and argv")
+{
+    const auto parser = make_parser().compile();
+    Argv argv{"other", "a.txt", "b.txt"};
+    auto args = parser.parse(argv.size(), argv.data());
+    REQUIRE(args.values("FILE").as_strings() == std::vector<std::string>{"a.txt", "b.txt"});
+    REQUIRE(parser.program_name() == "test");
+}
+
+TEST_CASE("CompiledParser is unaffected by later changes to ArgumentParser")
+{
+    std::stringstream ss;
+    auto parser = make_parser();
+    parser.stream(&ss);
+    const auto compiled = parser.compile();
+    parser.add(argos::Opt("-x"));
+    REQUIRE(parser.parse({"-x", "a.txt"}).result_code()
+            == argos::ParserResultCode::SUCCESS);
+
+    auto args = compiled.parse({"-x", "a.txt"});
+    REQUIRE(args.result_code() == argos::ParserResultCode::FAILURE);
+}
+
+TEST_CASE("CompiledParser reports invalid definitions when compiled")
+{
+    argos::ArgumentParser parser("test");
+    parser.add(argos::Opt("-a")).add(argos::Opt("-a"));
+    REQUIRE_THROWS(parser.compile());
+}
+
+TEST_CASE("CompiledParser make_iterator")
+{
+    const auto parser = make_parser().compile();
+    auto it = parser.make_iterator({"-v", "a.txt"});
+    std::unique_ptr<argos::IArgumentView> arg;
+    std::string_view value;
+    REQUIRE(it.next(arg, value));
+    const auto* option = dynamic_cast<const argos::OptionView*>(arg.get());
+    REQUIRE(option);
+    REQUIRE(option->flags().front() == "-v");
+    REQUIRE(it.next(arg, value));
+    REQUIRE(value == "a.txt");
+    REQUIRE(!it.next(arg, value));
+}
+
+TEST_CASE("CompiledParser writes help text")
+{
+    std::stringstream ss;
+    auto parser = make_parser();
+    parser.stream(&ss);
+    parser.compile().write_help_text();
+    REQUIRE(ss.str().find("--number <NUM>") != std::string::npos);
+}
+
+TEST_CASE("CompiledParser can be used from multiple threads")
+{
+    const auto parser = make_parser().compile();
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4);
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&parser, &failures, t]
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto n = t * 1000 + i;
+                auto args = parser.parse({"--number", std::to_string(n),
+                                          "a.txt"});
+                if (args.value("--number").as_int() != n)
+                    ++failures[t];
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    REQUIRE(failures == std::vector<int>(4));
+}
+
+TEST_CASE("CompiledParser and const parse keep the program version")
+{
+    std::stringstream ss;
+    auto parser = make_parser();
+    parser.stream(&ss).version("1.2.3");
+
+    REQUIRE(parser.compile().parse({"--version"}).result_code()
+            == argos::ParserResultCode::STOP);
+    REQUIRE(ss.str() == "test 1.2.3\n");
+
+    ss.str({});
+    const auto& const_parser = parser;
+    REQUIRE(const_parser.parse({"--version"}).result_code()
+            == argos::ParserResultCode::STOP);
+    REQUIRE(ss.str() == "test 1.2.3\n");
+}
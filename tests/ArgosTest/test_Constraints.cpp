@@ -0,0 +1,182 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/Argos.hpp"
+
+#include <sstream>
+
+namespace
+{
+    argos::ArgumentParser make_parser(std::stringstream& ss)
+    {
+        using namespace argos;
+        ArgumentParser parser("test");
+        parser.auto_exit(false)
+            .stream(&ss)
+            .add(Option{"-a", "--alpha"})
+            .add(Option{"-b"})
+            .add(Option{"-c"}.argument("N"))
+            .add(Option{"--no-c"}.alias("-c")
+                                 .operation(OptionOperation::CLEAR))
+            .add(Argument("FILE").count(0, 1));
+        return parser;
+    }
+
+    bool contains(const std::stringstream& ss, std::string_view text)
+    {
+        return ss.str().find(text) != std::string::npos;
+    }
+}
+
+TEST_CASE("Mutually exclusive options")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto parser = make_parser(ss);
+    parser.mutually_exclusive({"--alpha", "-b", "FILE"});
+    auto compiled = std::move(parser).compile();
+
+    REQUIRE(compiled.parse({"-a"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-b", "-c", "1"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({}).result_code() == ParserResultCode::SUCCESS);
+
+    REQUIRE(compiled.parse({"-b", "-a"}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "--alpha cannot be used with -b."));
+    REQUIRE(compiled.parse({"-b", "file"}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "-b cannot be used with FILE."));
+}
+
+TEST_CASE("At least one of several options")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto parser = make_parser(ss);
+    parser.at_least_one_of({"-b", "-c"});
+    auto compiled = std::move(parser).compile();
+
+    REQUIRE(compiled.parse({"-b"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-c", "2"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-a"}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "At least one of these is required: -b, -c"));
+}
+
+TEST_CASE("Option that depends on other options")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto parser = make_parser(ss);
+    parser.depends_on("-a", {"-b", "-c"});
+    auto compiled = std::move(parser).compile();
+
+    REQUIRE(compiled.parse({}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-b"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-a", "-b", "-c", "1"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-a", "-b"}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "-a requires -c."));
+}
+
+TEST_CASE("Option that conflicts with other options")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto parser = make_parser(ss);
+    parser.conflicts_with("-c", {"-a", "-b"});
+    auto compiled = std::move(parser).compile();
+
+    REQUIRE(compiled.parse({"-a", "-b"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-c", "1"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-c", "1", "-b"}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "-c cannot be used with -b."));
+}
+
+TEST_CASE("Constraints only count options given on the command line")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"--level"}.argument("N").initial_value("1"))
+        .add(Option{"--fast"})
+        .conflicts_with("--fast", {"--level"})
+        .parse({"--fast"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("--level").as_int() == 1);
+}
+
+TEST_CASE("Constraints with unknown names")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto parser = make_parser(ss);
+    REQUIRE_THROWS_AS(parser.mutually_exclusive({"-a"}), ArgosException);
+    REQUIRE_THROWS_AS(parser.depends_on("-a", {}), ArgosException);
+    parser.mutually_exclusive({"-a", "-d"});
+    REQUIRE_THROWS_AS(std::move(parser).compile(), ArgosException);
+}
+
+TEST_CASE("Constraints in sub-commands")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .allow_multiple_subcommands(true)
+        .add(Option{"-x"})
+        .add(Command("one")
+            .add(Option{"-a"})
+            .add(Option{"-b"})
+            .mutually_exclusive({"-a", "-b"}))
+        .add(Command("two")
+            .add(Option{"-a"})
+            .add(Option{"-b"}))
+        .compile();
+
+    REQUIRE(compiled.parse({"one", "-a", "two", "-a", "-b"}).result_code()
+            == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"two", "-a", "-b", "one", "-a", "-b"}).result_code()
+            == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "-a cannot be used with -b."));
+}
+
+TEST_CASE("Mandatory option that shares its value with another option")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"--verbose"}.alias("--quiet").constant("1").mandatory())
+        .add(Option{"--quiet"}.constant("0"))
+        .add(Option{"--name"}.argument("NAME").mandatory())
+        .compile();
+
+    REQUIRE(compiled.parse({"--quiet", "--name", "n"}).result_code()
+            == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"--quiet"}).result_code()
+            == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "Mandatory option is missing: --name"));
+}
+
+TEST_CASE("Mandatory option that is cleared")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"-c"}.argument("N").mandatory())
+        .add(Option{"--no-c"}.alias("-c").operation(OptionOperation::CLEAR))
+        .compile();
+
+    REQUIRE(compiled.parse({"-c", "1"}).result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(compiled.parse({"-c", "1", "--no-c"}).result_code()
+            == ParserResultCode::FAILURE);
+    REQUIRE(contains(ss, "Mandatory option is missing: -c"));
+}
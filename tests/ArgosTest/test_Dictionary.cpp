@@ -0,0 +1,87 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/Argos.hpp"
+
+#include <sstream>
+
+TEST_CASE("Dictionary option")
+{
+    using namespace argos;
+    std::stringstream ss;
+    auto compiled = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Option{"-D"}.argument("NAME=VALUE").dictionary())
+        .compile();
+
+    auto args = compiled.parse({"-D", "A=1", "-DB=", "-D", "C=x=y",
+                                "-D", "A=2"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto dict = args.dictionary("-D");
+    REQUIRE(dict.size() == 3);
+    REQUIRE(dict.lookup("A") == "2");
+    REQUIRE(dict.lookup("B") == "");
+    REQUIRE(dict.lookup("C") == "x=y");
+    REQUIRE(!dict.lookup("D"));
+    REQUIRE(!dict.contains("a"));
+
+    using Entry = ArgumentDictionary::Entry;
+    const std::vector<Entry> expected{{"A", "2"}, {"B", ""}, {"C", "x=y"}};
+    REQUIRE(dict.entries() == expected);
+
+    REQUIRE(compiled.parse({}).dictionary("-D").empty());
+
+    REQUIRE(compiled.parse({"-D", "A"}).result_code()
+            == ParserResultCode::FAILURE);
+    REQUIRE(ss.str().find("Invalid value: A.") != std::string::npos);
+}
+
+TEST_CASE("Dictionary options sharing a value")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Option{"--set"}.argument("KEY:VALUE").dictionary(':'))
+        .add(Option{"--debug"}.alias("--set").constant("level:debug"))
+        .add(Option{"--reset"}.alias("--set")
+                              .operation(OptionOperation::CLEAR))
+        .parse({"--set", "a:1", "--reset", "--debug", "--set", "b:2"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto dict = args.dictionary("--set");
+    REQUIRE(dict.size() == 2);
+    REQUIRE(dict.lookup("level") == "debug");
+    REQUIRE(dict.lookup("b") == "2");
+    REQUIRE(!dict.contains("a"));
+}
+
+TEST_CASE("Invalid dictionary options")
+{
+    using namespace argos;
+    SECTION("Operation ASSIGN")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-D"}.argument("N=V").dictionary()
+                               .operation(OptionOperation::ASSIGN));
+        REQUIRE_THROWS(parser.compile());
+    }
+    SECTION("Constant without separator")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-D"}.argument("N=V").dictionary())
+            .add(Option{"--debug"}.alias("-D").constant("DEBUG"));
+        REQUIRE_THROWS(parser.compile());
+    }
+    SECTION("Conflicting separators")
+    {
+        ArgumentParser parser("test");
+        parser.add(Option{"-D"}.argument("N=V").dictionary())
+            .add(Option{"--set"}.argument("N:V").alias("-D").dictionary(':'));
+        REQUIRE_THROWS(parser.compile());
+    }
+}
@@ -0,0 +1,266 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgumentParser.hpp"
+
+#include <climits>
+#include <sstream>
+
+namespace
+{
+    using namespace argos;
+
+    std::string get_name(const IArgumentView* view)
+    {
+        if (const auto* a = dynamic_cast<const ArgumentView*>(view))
+            return a->name();
+        if (const auto* o = dynamic_cast<const OptionView*>(view))
+            return o->flags().front();
+        if (const auto* c = dynamic_cast<const CommandView*>(view))
+            return c->name();
+        return "?";
+    }
+
+    /// Calls next() until it returns something other than PROCESSED,
+    /// and returns the names and values of the processed arguments.
+    IncrementalResult drain(IncrementalParser& parser,
+                            std::vector<std::string>* events = nullptr)
+    {
+        std::unique_ptr<IArgumentView> arg;
+        std::string_view value;
+        while (true)
+        {
+            const auto result = parser.next(arg, value);
+            if (result != IncrementalResult::PROCESSED)
+                return result;
+            if (events)
+            {
+                events->push_back(get_name(arg.get()) + "="
+                                  + std::string(value));
+            }
+        }
+    }
+
+    std::string describe(const ParsedArguments& args,
+                         const std::vector<std::string>& names)
+    {
+        std::string result = std::to_string(int(args.result_code()));
+        for (const auto& name : names)
+        {
+            result += " " + name + ":";
+            for (const auto& value : args.values(name).as_strings())
+                result += value + ",";
+        }
+        for (const auto& arg : args.unprocessed_arguments())
+            result += " +" + arg;
+        for (const auto& cmd : args.subcommands())
+            result += " [" + cmd.command().name() + "]";
+        return result;
+    }
+
+    CompiledParser make_copy_parser(std::ostream& stream)
+    {
+        return ArgumentParser("copy")
+            .auto_exit(false)
+            .stream(&stream)
+            .add(Arg("FILE").count(1, UINT_MAX))
+            .add(Arg("DEST"))
+            .add(Opt("-v", "--verbose"))
+            .add(Opt("-o", "--option").argument("OPT")
+                     .operation(OptionOperation::APPEND))
+            .add(Opt("-s", "--stop").type(OptionType::STOP))
+            .compile();
+    }
+}
+
+TEST_CASE("IncrementalParser processes options as soon as possible")
+{
+    std::stringstream ss;
+    auto parser = make_copy_parser(ss).make_incremental_parser();
+    std::vector<std::string> events;
+
+    parser.push("-v");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events == std::vector<std::string>{"-v="});
+
+    parser.push("--option");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events.size() == 1);
+    parser.push("x");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events.back() == "-o=x");
+
+    parser.push("-vo");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events.back() == "-o=x");
+    parser.push("y");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events == std::vector<std::string>{"-v=", "-o=x", "-v=", "-o=y"});
+}
+
+TEST_CASE("IncrementalParser holds back arguments until their meaning is known")
+{
+    std::stringstream ss;
+    auto parser = make_copy_parser(ss).make_incremental_parser();
+    std::vector<std::string> events;
+
+    parser.push("a");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events == std::vector<std::string>{"FILE=a"});
+
+    // "b" is DEST if nothing follows it.
+    parser.push("b");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events.size() == 1);
+
+    parser.push("-v");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events.size() == 1);
+
+    parser.push("c");
+    REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    REQUIRE(events == std::vector<std::string>{"FILE=a", "FILE=b", "-v="});
+
+    parser.finish();
+    REQUIRE(drain(parser, &events) == IncrementalResult::DONE);
+    REQUIRE(events == std::vector<std::string>{"FILE=a", "FILE=b", "-v=", "DEST=c"});
+
+    const auto args = parser.parsed_arguments();
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("FILE").as_strings() == std::vector<std::string>{"a", "b"});
+    REQUIRE(args.value("DEST").as_string() == "c");
+}
+
+TEST_CASE("IncrementalParser reports arguments that remain ambiguous for too long")
+{
+    std::stringstream ss;
+    auto parser = make_copy_parser(ss).make_incremental_parser();
+    parser.max_lookahead(3);
+    for (const auto* arg : {"a", "b", "-v", "-v"})
+    {
+        parser.push(arg);
+        REQUIRE(drain(parser) == IncrementalResult::NEED_INPUT);
+    }
+    parser.push("-v");
+    REQUIRE(drain(parser) == IncrementalResult::FAILURE);
+    REQUIRE(ss.str().find("Unable to determine if \"b\" is DEST or FILE") != std::string::npos);
+    REQUIRE(parser.parsed_arguments().result_code() == ParserResultCode::FAILURE);
+}
+
+TEST_CASE("IncrementalParser can leave argument values out of the result")
+{
+    std::stringstream ss;
+    auto parser = make_copy_parser(ss).make_incremental_parser();
+    parser.store_argument_values(false);
+    std::vector<std::string> events;
+    for (int i = 0; i < 1000; ++i)
+    {
+        parser.push(std::to_string(i));
+        REQUIRE(drain(parser, &events) == IncrementalResult::NEED_INPUT);
+    }
+    parser.finish();
+    REQUIRE(drain(parser, &events) == IncrementalResult::DONE);
+    REQUIRE(events.size() == 1000);
+    REQUIRE(events.front() == "FILE=0");
+    REQUIRE(events.back() == "DEST=999");
+    const auto args = parser.parsed_arguments();
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(!args.has("FILE"));
+}
+
+TEST_CASE("IncrementalParser adds arguments after a stop option to the unprocessed arguments")
+{
+    std::stringstream ss;
+    auto parser = make_copy_parser(ss).make_incremental_parser();
+    for (const auto* arg : {"a", "b", "--stop", "c"})
+        parser.push(arg);
+    REQUIRE(drain(parser) == IncrementalResult::DONE);
+    parser.push("d");
+    const auto args = parser.parsed_arguments();
+    REQUIRE(args.result_code() == ParserResultCode::STOP);
+    REQUIRE(args.unprocessed_arguments() == std::vector<std::string>{"c", "d"});
+}
+
+TEST_CASE("IncrementalParser gives the same results as parse")
+{
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .allow_multiple_subcommands(true)
+        .add(Opt("-v", "--verbose"))
+        .add(Cmd("copy")
+            .add(Arg("SRC").count(1, UINT_MAX))
+            .add(Arg("DST").count(1, 2))
+            .add(Opt("-f", "--force"))
+            .add(Opt("--").type(OptionType::LAST_OPTION))
+            .add(Opt("-m", "--mode").argument("MODE"))
+            .add(Opt("-x").argument("ARGS")
+                     .callback([](OptionCallbackArguments& a)
+                     {
+                         a.new_arguments = {"inserted", "-f"};
+                     })))
+        .add(Cmd("list")
+            .add(Arg("DIR").count(0, UINT_MAX))
+            .add(Opt("-l")))
+        .compile();
+
+    auto describe_all = [](const ParsedArguments& args)
+    {
+        auto result = describe(args, {"--verbose"});
+        for (const auto& cmd : args.subcommands())
+        {
+            result += " | " + describe(cmd, cmd.command().name() == "copy"
+                                                ? std::vector<std::string>{"SRC", "DST", "--force", "--mode"}
+                                                : std::vector<std::string>{"DIR", "-l"});
+        }
+        return result;
+    };
+
+    const std::vector<std::vector<std::string_view>> command_lines = {
+        {"copy", "a", "b"},
+        {"copy", "a", "b", "c", "d", "e"},
+        {"-v", "copy", "-fm", "fast", "a", "-m", "slow", "b", "c"},
+        {"copy", "a", "b", "list", "x", "y"},
+        {"copy", "a", "list", "b", "list"},
+        {"copy", "a", "-x", "x", "b"},
+        {"copy", "a", "--", "-b", "-c"},
+        {"copy", "a", "b", "--", "c", "list"},
+        {"copy", "a"},
+        {"copy", "a", "-m"},
+        {"copy", "a", "b", "c", "d", "--unknown"},
+        {"list", "-l", "x", "copy", "a", "b"},
+    };
+
+    for (const auto& command_line : command_lines)
+    {
+        std::string text;
+        for (auto arg : command_line)
+            text += std::string(arg) + " ";
+        CAPTURE(text);
+
+        const auto expected = describe_all(parser.parse(command_line));
+
+        auto incremental = parser.make_incremental_parser();
+        IncrementalResult result = IncrementalResult::NEED_INPUT;
+        for (auto arg : command_line)
+        {
+            incremental.push(arg);
+            if (result == IncrementalResult::NEED_INPUT)
+                result = drain(incremental);
+        }
+        if (result == IncrementalResult::NEED_INPUT)
+        {
+            incremental.finish();
+            result = drain(incremental);
+        }
+
+        REQUIRE(result != IncrementalResult::NEED_INPUT);
+        REQUIRE(describe_all(incremental.parsed_arguments()) == expected);
+    }
+}
@@ -0,0 +1,107 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/OptionTrie.hpp"
+#include "Argos/Option.hpp"
+#include "Argos/OptionData.hpp"
+
+namespace
+{
+    struct TrieFixture
+    {
+        explicit TrieFixture(bool case_insensitive)
+        {
+            add(argos::Option("--verbose"));
+            add(argos::Option("--version"));
+            add(argos::Option("--ver"));
+            add(argos::Option("--file").argument("FILE"));
+            add(argos::Option("--filter="));
+            add(argos::Option("-v"));
+            add(argos::Option("--size").argument("N"));
+
+            std::vector<std::pair<std::string_view, const argos::OptionData*>> flags;
+            for (const auto& option : options)
+                flags.emplace_back(option->flags.front(), option.get());
+            trie = argos::OptionTrie(std::move(flags), case_insensitive);
+        }
+
+        void add(argos::Option option)
+        {
+            options.push_back(option.release());
+        }
+
+        const argos::OptionData* find(std::string_view flag, bool abbreviations = false) const
+        {
+            return trie.find(flag, abbreviations);
+        }
+
+        const argos::OptionData* get(size_t index) const
+        {
+            return options[index].get();
+        }
+
+        std::vector<std::unique_ptr<argos::OptionData>> options;
+        argos::OptionTrie trie;
+    };
+}
+
+TEST_CASE("OptionTrie exact matches")
+{
+    TrieFixture f(false);
+    REQUIRE(f.find("--verbose") == f.get(0));
+    REQUIRE(f.find("--version") == f.get(1));
+    REQUIRE(f.find("--ver") == f.get(2));
+    REQUIRE(f.find("-v") == f.get(5));
+    REQUIRE(f.find("--filter=") == f.get(4));
+    REQUIRE(f.find("--verb") == nullptr);
+    REQUIRE(f.find("--verbosee") == nullptr);
+    REQUIRE(f.find("--VERBOSE") == nullptr);
+    REQUIRE(f.find("-") == nullptr);
+    REQUIRE(f.find("--x") == nullptr);
+}
+
+TEST_CASE("OptionTrie abbreviations")
+{
+    TrieFixture f(false);
+    REQUIRE(f.find("--verb", true) == f.get(0));
+    REQUIRE(f.find("--vers", true) == f.get(1));
+    REQUIRE(f.find("--ver", true) == f.get(2));
+    REQUIRE(f.find("--ve", true) == nullptr);
+    REQUIRE(f.find("--fil", true) == nullptr);
+    REQUIRE(f.find("--filt", true) == f.get(4));
+    REQUIRE(f.find("--s", true) == f.get(6));
+}
+
+TEST_CASE("OptionTrie flags followed by '='")
+{
+    TrieFixture f(false);
+    REQUIRE(f.find("--file=") == f.get(3));
+    REQUIRE(f.find("--size=") == f.get(6));
+    REQUIRE(f.find("--verbose=") == nullptr);
+    REQUIRE(f.find("--fi=", true) == nullptr);
+    REQUIRE(f.find("--si=", true) == f.get(6));
+    REQUIRE(f.find("--si=") == nullptr);
+}
+
+TEST_CASE("OptionTrie case-insensitive")
+{
+    TrieFixture f(true);
+    REQUIRE(f.find("--VERBOSE") == f.get(0));
+    REQUIRE(f.find("--Version") == f.get(1));
+    REQUIRE(f.find("-V") == f.get(5));
+    REQUIRE(f.find("--FILE=") == f.get(3));
+    REQUIRE(f.find("--VERB", true) == f.get(0));
+    REQUIRE(f.find("--VERB") == nullptr);
+}
+
+TEST_CASE("Empty OptionTrie")
+{
+    argos::OptionTrie trie;
+    REQUIRE(trie.empty());
+    REQUIRE(trie.find("--foo", true) == nullptr);
+}
@@ -0,0 +1,194 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/Argos.hpp"
+
+#include <sstream>
+
+namespace
+{
+    argos::CompiledParser make_parser(std::ostream& stream)
+    {
+        using namespace argos;
+        // try_parse must neither write to the stream nor exit.
+        return ArgumentParser("test")
+            .auto_exit(true)
+            .stream(&stream)
+            .add(Arg("FILE"))
+            .add(Opt("-n", "--number").argument("NUM").value_type(ValueType::INT))
+            .add(Opt("-v"))
+            .add(Opt("--check").argument("N")
+                .callback([](OptionCallbackArguments& a)
+                {
+                    if (a.value != "ok")
+                        a.builder.error("not ok", a.view);
+                }))
+            .compile();
+    }
+}
+
+TEST_CASE("try_parse without errors")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = make_parser(ss);
+    const auto result = parser.try_parse({"-n", "12", "file"});
+    REQUIRE(result);
+    REQUIRE(result.has_value());
+    REQUIRE(!result.error());
+    REQUIRE(result.error().code() == ParseErrorCode::NONE);
+    REQUIRE(result.value().value("-n").as_int() == 12);
+    REQUIRE(result.value().value("FILE").as_string() == "file");
+
+    const auto help = parser.try_parse({"--help"});
+    REQUIRE(help);
+    REQUIRE(help.value().result_code() == ParserResultCode::STOP);
+    REQUIRE(ss.str().empty());
+}
+
+TEST_CASE("try_parse returns error codes and token indices")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = make_parser(ss);
+
+    SECTION("Unknown option")
+    {
+        const auto result = parser.try_parse({"file", "-vx"});
+        REQUIRE(!result);
+        REQUIRE(result.value().result_code() == ParserResultCode::FAILURE);
+        const auto& error = result.error();
+        REQUIRE(error.code() == ParseErrorCode::UNKNOWN_OPTION);
+        REQUIRE(error.token_index() == 1);
+        REQUIRE(error.argument_id() == ArgumentId{});
+        REQUIRE(error.detail() == "Unknown option: -vx");
+        REQUIRE(error.message() == "test: Unknown option: -vx");
+    }
+    SECTION("Invalid value")
+    {
+        const auto result = parser.try_parse({"-v", "--number=abc", "file"});
+        const auto& error = result.error();
+        REQUIRE(error.code() == ParseErrorCode::INVALID_VALUE);
+        REQUIRE(error.token_index() == 1);
+        const auto valid = parser.try_parse({"-n", "1", "file"});
+        REQUIRE(error.argument_id()
+                == valid.value().value("-n").argument()->argument_id());
+        REQUIRE(error.message() == "test: -n, --number: Invalid value: abc.");
+    }
+    SECTION("Missing value")
+    {
+        const auto result = parser.try_parse({"file", "-n"});
+        REQUIRE(result.error().code() == ParseErrorCode::MISSING_VALUE);
+        REQUIRE(result.error().token_index() == 1);
+        REQUIRE(result.error().message() == "test: -n: no value given.");
+        // A flag that is concatenated with another one.
+        REQUIRE(parser.try_parse({"file", "-vn"}).error().token_index() == 1);
+    }
+    SECTION("Too many arguments")
+    {
+        const auto result = parser.try_parse({"file", "-v", "extra"});
+        REQUIRE(result.error().code() == ParseErrorCode::TOO_MANY_ARGUMENTS);
+        REQUIRE(result.error().token_index() == 2);
+    }
+    SECTION("Too few arguments")
+    {
+        const auto result = parser.try_parse({"-v"});
+        REQUIRE(result.error().code() == ParseErrorCode::TOO_FEW_ARGUMENTS);
+        REQUIRE(!result.error().token_index());
+    }
+    SECTION("Error from callback")
+    {
+        const auto result = parser.try_parse({"--check", "bad", "file"});
+        REQUIRE(result.error().code() == ParseErrorCode::CALLBACK);
+        REQUIRE(result.error().argument_id() != ArgumentId{});
+        REQUIRE(result.error().message() == "test: --check: not ok");
+    }
+    REQUIRE(ss.str().empty());
+}
+
+TEST_CASE("try_parse throws errors in lazy definitions")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Cmd("sub").lazy_definition([](Command& cmd)
+        {
+            cmd.add(Opt("invalid"));
+        }))
+        .compile();
+    REQUIRE_THROWS_AS(parser.try_parse({"sub"}), ArgosException);
+    REQUIRE(ss.str().empty());
+}
+
+TEST_CASE("ParseError writes the message on demand")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Opt("--mode").argument("MODE").mandatory())
+        .compile();
+    const auto result = parser.try_parse({});
+    REQUIRE(result.error().code() == ParseErrorCode::MISSING_OPTION);
+    REQUIRE(result.error().message()
+            == "test: Mandatory option is missing: --mode");
+    REQUIRE(ss.str().empty());
+
+    result.error().write();
+    const auto written = ss.str();
+    REQUIRE(!written.empty());
+
+    // The same text that parse() writes.
+    ss.str({});
+    static_cast<void>(parser.parse({}));
+    REQUIRE(ss.str() == written);
+}
+
+TEST_CASE("try_parse_into reuses the parsed arguments")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = make_parser(ss);
+    ParsedArguments args;
+    REQUIRE(!parser.try_parse_into(args, std::vector<std::string>{"a"}));
+    REQUIRE(args.value("FILE").as_string() == "a");
+
+    const auto error = parser.try_parse_into(
+        args, std::vector<std::string>{"-q", "b"});
+    REQUIRE(error.code() == ParseErrorCode::UNKNOWN_OPTION);
+    REQUIRE(error.token_index() == 0);
+    REQUIRE(args.result_code() == ParserResultCode::FAILURE);
+}
+
+TEST_CASE("Values from try_parse report errors like values from parse")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Opt("--n").argument("N"))
+        .add(Cmd("sub").add(Opt("--m").argument("M")))
+        .compile();
+    const auto result = parser.try_parse({"--n", "abc", "sub", "--m", "xyz"});
+    REQUIRE(result);
+    REQUIRE(ss.str().empty());
+
+    REQUIRE_THROWS_AS(result.value().value("--n").as_int(), ArgosException);
+    REQUIRE(ss.str().find("--n: Invalid value: abc.")
+            != std::string::npos);
+
+    ss.str({});
+    const auto sub = result.value().subcommands()[0];
+    REQUIRE_THROWS_AS(sub.value("--m").as_int(), ArgosException);
+    REQUIRE(ss.str().find("--m: Invalid value: xyz.")
+            != std::string::npos);
+}
@@ -8,6 +8,139 @@
 #include "Argos/ParseValue.hpp"
 #include <catch2/catch_test_macros.hpp>
 
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The strtol-based implementation that parse_integer and
+    // parse_floating_point must be identical to.
+
+    template <typename T>
+    T str_to_int(const char* str, char** endp, int base);
+
+    template <>
+    long str_to_int<long>(const char* str, char** endp, int base)
+    {
+        return strtol(str, endp, base);
+    }
+
+    template <>
+    long long str_to_int<long long>(const char* str, char** endp, int base)
+    {
+        return strtoll(str, endp, base);
+    }
+
+    template <>
+    unsigned long
+    str_to_int<unsigned long>(const char* str, char** endp, int base)
+    {
+        return strtoul(str, endp, base);
+    }
+
+    template <>
+    unsigned long long
+    str_to_int<unsigned long long>(const char* str, char** endp, int base)
+    {
+        return strtoull(str, endp, base);
+    }
+
+    template <typename T>
+    std::optional<T> reference_integer(const std::string& str, int base)
+    {
+        if constexpr (std::is_same_v<T, int>)
+        {
+            const auto n = reference_integer<long>(str, base);
+            if (!n || *n < INT_MIN || INT_MAX < *n)
+                return {};
+            return int(*n);
+        }
+        else if constexpr (std::is_same_v<T, unsigned>)
+        {
+            const auto n = reference_integer<unsigned long>(str, base);
+            if (!n || UINT_MAX < *n)
+                return {};
+            return unsigned(*n);
+        }
+        else
+        {
+            if (str.empty())
+                return {};
+            char* endp = nullptr;
+            errno = 0;
+            auto value = str_to_int<T>(str.c_str(), &endp, base);
+            if (endp == str.c_str() + str.size() && errno == 0)
+                return value;
+            return {};
+        }
+    }
+
+    template <typename T>
+    std::optional<T> reference_floating_point(const std::string& str)
+    {
+        if (str.empty())
+            return {};
+        char* endp = nullptr;
+        errno = 0;
+        T value;
+        if constexpr (std::is_same_v<T, float>)
+            value = strtof(str.c_str(), &endp);
+        else
+            value = strtod(str.c_str(), &endp);
+        if (endp == str.c_str() + str.size() && errno == 0)
+            return value;
+        return {};
+    }
+
+    template <typename T>
+    bool is_identical(std::optional<T> a, std::optional<T> b)
+    {
+        if (!a || !b)
+            return !a && !b;
+        if (std::isnan(*a) || std::isnan(*b))
+            return std::isnan(*a) && std::isnan(*b);
+        return std::memcmp(&*a, &*b, sizeof(T)) == 0;
+    }
+
+    std::vector<std::string> make_strings(std::string_view alphabet,
+                                          size_t count, size_t max_length)
+    {
+        std::mt19937 rng(12345);
+        std::uniform_int_distribution<size_t> length(0, max_length);
+        std::uniform_int_distribution<size_t> index(0, alphabet.size() - 1);
+        std::vector<std::string> result;
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::string s(length(rng), ' ');
+            for (auto& c : s)
+                c = alphabet[index(rng)];
+            result.push_back(s);
+        }
+        return result;
+    }
+
+    const std::vector<std::string> INTEGER_STRINGS = {
+        "", " ", "0", "-0", "+0", "00", "08", "0x", "0X1f", "-0x1F", "0x-1",
+        "+-1", "--1", "- 1", " 12", "\t\n12", "12 ", "1_000", "0b101",
+        "123456789", "1234567890", "12345678901234567", "0000000000000000001",
+        "2147483647", "2147483648", "-2147483648", "-2147483649",
+        "4294967295", "4294967296", "-4294967295", "-4294967296",
+        "9223372036854775807", "9223372036854775808",
+        "-9223372036854775808", "-9223372036854775809",
+        "18446744073709551615", "18446744073709551616",
+        "-18446744073709551615", "-18446744073709551616",
+        "99999999999999999999", "777", "0777", "zz", "ZZ", "-zZ",
+        "0xffffffffffffffff", "0x10000000000000000", "1/", "1:", "a"
+    };
+}
+
 TEST_CASE("parse_integer on empty string")
 {
     REQUIRE(!argos::parse_integer<int>({}, 0).has_value());
@@ -17,3 +150,69 @@ TEST_CASE("parse_floating_point on empty string")
 {
     REQUIRE(!argos::parse_floating_point<double>({}).has_value());
 }
+
+TEST_CASE("parse_integer is identical to strtol")
+{
+    auto strings = INTEGER_STRINGS;
+    for (auto& s : make_strings(" +-0123456789abcfxzXZ", 20000, 22))
+        strings.push_back(s);
+    for (auto& s : make_strings("0123456789", 2000, 21))
+        strings.push_back(s);
+
+    for (int base : {0, 1, 2, 8, 10, 16, 36, 37})
+    {
+        for (const auto& s : strings)
+        {
+            CAPTURE(s, base);
+            REQUIRE(argos::parse_integer<int>(s, base)
+                    == reference_integer<int>(s, base));
+            REQUIRE(argos::parse_integer<unsigned>(s, base)
+                    == reference_integer<unsigned>(s, base));
+            REQUIRE(argos::parse_integer<long>(s, base)
+                    == reference_integer<long>(s, base));
+            REQUIRE(argos::parse_integer<long long>(s, base)
+                    == reference_integer<long long>(s, base));
+            REQUIRE(argos::parse_integer<unsigned long>(s, base)
+                    == reference_integer<unsigned long>(s, base));
+            REQUIRE(argos::parse_integer<unsigned long long>(s, base)
+                    == reference_integer<unsigned long long>(s, base));
+        }
+    }
+}
+
+TEST_CASE("parse_floating_point is identical to strtod")
+{
+    std::vector<std::string> strings = {
+        "", " ", ".", "0", "-0", "+0", "1.", ".5", " .5", "-.5e-3", "1e",
+        "1e+", "1e-", "e5", "1.5E10", "0.1", "3.4028235e38", "3.4028236e38",
+        "1.17549435e-38", "1e-40", "1e-310", "4.9e-324", "2e-324",
+        "1e-400", "1.7976931348623157e308", "1e309", "0e-400", "inf",
+        "-INF", "+infinity", "infinit", "nan", "-NaN", "nan(123)", "nan(",
+        "nanx", "0x1p3", "-0X1.8P-1", "0x.8", "0x", "0xp1", "0x1p", "0xinf",
+        "0x1g", "--1", "+-1", "- 1", "1 ", "1,5", "0x1p-1080", "0x1p1030"
+    };
+    for (auto& s : make_strings(" +-.0123456789eEpPxXaifn", 20000, 12))
+        strings.push_back(s);
+
+    std::mt19937 rng(54321);
+    std::uniform_real_distribution<double> mantissa(-10, 10);
+    std::uniform_int_distribution<int> exponent(-330, 330);
+    char buffer[64];
+    for (int i = 0; i < 5000; ++i)
+    {
+        const auto value = mantissa(rng) * std::pow(10.0, exponent(rng));
+        snprintf(buffer, sizeof(buffer), "%.*g", i % 20, value);
+        strings.emplace_back(buffer);
+        snprintf(buffer, sizeof(buffer), "%a", value);
+        strings.emplace_back(buffer);
+    }
+
+    for (const auto& s : strings)
+    {
+        CAPTURE(s);
+        REQUIRE(is_identical(argos::parse_floating_point<double>(s),
+                             reference_floating_point<double>(s)));
+        REQUIRE(is_identical(argos::parse_floating_point<float>(s),
+                             reference_floating_point<float>(s)));
+    }
+}
@@ -80,3 +80,133 @@ TEST_CASE("Check options of arguments of main command and sub-commands")
     REQUIRE(all_args.size() == 1);
     REQUIRE(all_args[0]->name() == "ARG");
 }
+
+TEST_CASE("Find the arguments and options of shared values")
+{
+    using namespace argos;
+    auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("--fast").alias("MODE").constant("fast").id(1))
+        .add(Opt("--slow").alias("MODE").constant("slow").id(2))
+        .add(Arg("FILE").optional(true).id(3))
+        .compile();
+
+    auto args = parser.parse(std::vector<std::string_view>{"--slow", "file"});
+    REQUIRE(args.value("MODE").as_string() == "slow");
+    REQUIRE(args.value("MODE").argument()->id() == 2);
+    REQUIRE(args.value("--fast").as_string() == "slow");
+    REQUIRE(args.value("FILE").argument()->id() == 3);
+    const auto views = args.values("MODE").arguments();
+    REQUIRE(views.size() == 2);
+    REQUIRE(views[0]->id() == 1);
+    REQUIRE(views[1]->id() == 2);
+    REQUIRE_THROWS(args.value("--medium"));
+
+    args = parser.parse(std::vector<std::string_view>{"--fast"});
+    REQUIRE(args.value("MODE").argument()->id() == 1);
+    REQUIRE(!args.has("FILE"));
+}
+
+TEST_CASE("Find the values of a lazily defined sub-command")
+{
+    using namespace argos;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Cmd("sub").lazy_definition([](Command& cmd)
+        {
+            cmd.add(Opt("-x").argument("X").id(7));
+        }))
+        .parse(std::vector<std::string_view>{"sub", "-x", "12"});
+    const auto sub = args.subcommands().at(0);
+    REQUIRE(sub.value("-x").as_int() == 12);
+    REQUIRE(sub.value("-x").argument()->id() == 7);
+}
+
+TEST_CASE("Access values with ValueHandle")
+{
+    using namespace argos;
+    ValueHandle count, verbose, quiet, name, none;
+    Command sub("sub");
+    sub.add(Opt("--name").argument("NAME"), name);
+    ArgumentParser parser("test");
+    parser.auto_exit(false)
+        .add(Opt("-n", "--count").argument("N"), count)
+        .add(Opt("-v").alias("--verbose"), verbose)
+        .add(Opt("--verbose"))
+        .add(Opt("-q").alias("--verbose").operation(OptionOperation::CLEAR),
+             quiet)
+        .add(std::move(sub));
+    REQUIRE(count);
+    REQUIRE(!none);
+    const auto compiled = parser.compile();
+
+    auto args = compiled.parse({"-n", "3", "-v", "sub"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.has(count));
+    REQUIRE(args.value(count).as_int() == 3);
+    REQUIRE(args.value(count).argument()->argument_id()
+            == args.value("-n").argument()->argument_id());
+    REQUIRE(args.has(verbose));
+    REQUIRE(args.has(quiet));
+    REQUIRE_THROWS_AS(args.value(none), ArgosException);
+
+    args = compiled.parse({"sub", "--name", "x"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(!args.has(count));
+    REQUIRE(args.subcommands().front().value(name).as_string() == "x");
+
+    ValueHandle file;
+    auto args2 = ArgumentParser("test2")
+        .auto_exit(false)
+        .add(Arg("FILE").count(0, 2), file)
+        .parse({"a", "b"});
+    REQUIRE(args2.values(file).as_strings()
+            == std::vector<std::string>{"a", "b"});
+    REQUIRE_THROWS_AS(args.values(file), ArgosException);
+}
+
+TEST_CASE("ValueHandle used with another command's ParsedArguments")
+{
+    using namespace argos;
+    ValueHandle top, a_value, b_value;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-t").argument("T"), top)
+        .add(Cmd("a").add(Opt("-x").argument("X"), a_value))
+        .add(Cmd("b").add(Opt("-y").argument("Y"), b_value))
+        .compile();
+
+    const auto args = parser.parse({"-t", "1", "a", "-x", "2"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto a = args.subcommands().front();
+    REQUIRE(a.value(a_value).as_int() == 2);
+    // The handles have the same index as a_value.
+    REQUIRE_THROWS_AS(a.value(b_value), ArgosException);
+    REQUIRE_THROWS_AS(a.value(top), ArgosException);
+    REQUIRE_THROWS_AS(args.value(a_value), ArgosException);
+
+    const auto b = parser.parse({"b", "-y", "3"}).subcommands().front();
+    REQUIRE(b.value(b_value).as_int() == 3);
+    REQUIRE_THROWS_AS(b.value(a_value), ArgosException);
+}
+
+TEST_CASE("ParsedArgumentsBuilder with ValueHandle")
+{
+    using namespace argos;
+    ValueHandle n, m;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-n").argument("N"), n)
+        .add(Opt("-m").argument("M")
+                 .callback([&](OptionCallbackArguments& cb)
+                 {
+                     cb.builder.append(n, "7");
+                     cb.builder.assign(m, cb.builder.values(n).value(0)
+                                              .as_string());
+                 }),
+             m)
+        .parse({"-n", "1", "-m", "2"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values(n).as_ints() == std::vector<int>{1, 7});
+    REQUIRE(args.value(m).as_string() == "1");
+}
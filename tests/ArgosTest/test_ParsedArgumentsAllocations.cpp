@@ -0,0 +1,216 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgumentParser.hpp"
+
+#include <climits>
+#include <sstream>
+#include "AllocationCounter.hpp"
+
+namespace
+{
+    std::vector<std::string> make_arguments(size_t n)
+    {
+        std::vector<std::string> result;
+        result.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (i % 10 == 0)
+                result.emplace_back("--include=directory/number/" + std::to_string(i));
+            else
+                result.push_back("a/somewhat/long/file/name" + std::to_string(i) + ".txt");
+        }
+        return result;
+    }
+}
+
+TEST_CASE("The number of allocations doesn't depend on the number of arguments")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Arg("FILE").count(1, UINT_MAX))
+        .add(Opt("-i", "--include").argument("DIR").operation(OptionOperation::APPEND))
+        .add(Opt("-v", "--verbose"))
+        .compile();
+
+    auto parse = [&](const std::vector<std::string>& args)
+    {
+        return count_allocations([&]
+        {
+            const auto result = parser.parse(args);
+            REQUIRE(result.result_code() == ParserResultCode::SUCCESS);
+        }).count;
+    };
+
+    const auto small = make_arguments(100);
+    const auto large = make_arguments(100'000);
+    parse(small);
+    const auto small_count = parse(small);
+    const auto large_count = parse(large);
+    INFO("100 arguments: " << small_count << " allocations, 100000 arguments: "
+         << large_count << " allocations");
+    REQUIRE(large_count == small_count);
+}
+
+TEST_CASE("Interleaved values are grouped by argument or option")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Arg("FILE").count(1, UINT_MAX))
+        .add(Opt("-i").argument("DIR").operation(OptionOperation::APPEND))
+        .add(Opt("-n").argument("NUM"))
+        .add(Opt("-c").operation(OptionOperation::CLEAR).alias("-i"))
+        .compile();
+
+    const auto args = parser.parse(std::vector<std::string_view>{
+        "a", "-i", "x", "-n", "1", "b", "-i", "y", "-c", "-i", "z",
+        "-n", "2", "c"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("FILE").as_strings()
+            == std::vector<std::string>{"a", "b", "c"});
+    REQUIRE(args.values("-i").as_strings() == std::vector<std::string>{"z"});
+    REQUIRE(args.value("-n").as_int() == 2);
+}
+
+TEST_CASE("A warmed-up parse_into loop doesn't allocate memory")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-v", "--verbose"))
+        .add(Cmd("build")
+            .add(Arg("FILE").count(1, UINT_MAX))
+            .add(Opt("-i", "--include").argument("DIR")
+                     .operation(OptionOperation::APPEND))
+            .add(Opt("-q")))
+        .add(Cmd("clean")
+            .add(Arg("DIR").optional(true)))
+        .compile();
+
+    const std::vector<std::vector<std::string_view>> command_lines = {
+        {"-v", "build", "-qi", "include", "a.c", "b.c"},
+        {"clean", "out"},
+        {"build", "--include=dir", "a/long/file/name.c"},
+        {"-v", "clean"}
+    };
+
+    ParsedArguments args;
+    auto parse_all = [&]
+    {
+        for (const auto& command_line : command_lines)
+        {
+            parser.parse_into(args, command_line);
+            REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+        }
+    };
+
+    parse_all();
+    parse_all();
+    REQUIRE(count_allocations(parse_all).count == 0);
+    REQUIRE(args.value("-v").as_bool());
+    REQUIRE(args.subcommands().front().value("DIR").as_string().empty());
+}
+
+TEST_CASE("parse_into doesn't clear results that are still in use")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-n").argument("NUM"))
+        .add(Cmd("run").add(Arg("FILE")))
+        .compile();
+
+    ParsedArguments args;
+    parser.parse_into(args, std::vector<std::string_view>{"-n", "1", "run", "a"});
+    const auto subcommand = args.subcommands().front();
+    parser.parse_into(args, std::vector<std::string_view>{"-n", "2", "run", "b"});
+    REQUIRE(subcommand.value("FILE").as_string() == "a");
+    REQUIRE(args.value("-n").as_int() == 2);
+    REQUIRE(args.subcommands().front().value("FILE").as_string() == "b");
+
+    const auto copy = args;
+    parser.parse_into(args, std::vector<std::string_view>{"-n", "3", "run", "c"});
+    REQUIRE(copy.value("-n").as_int() == 2);
+    REQUIRE(copy.subcommands().front().value("FILE").as_string() == "b");
+    REQUIRE(args.value("-n").as_int() == 3);
+}
+
+TEST_CASE("Reading values through a ValuesView doesn't allocate memory")
+{
+    using namespace argos;
+    const auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-n").argument("NUM").operation(OptionOperation::APPEND)
+                 .value_type(ValueType::INT))
+        .add(Opt("-x").argument("NUM").operation(OptionOperation::APPEND))
+        .parse(std::vector<std::string_view>{"-n", "1", "-x", "2.5", "-n", "2",
+                                             "-x", "0.5", "-n", "3"});
+
+    int int_sum = 0;
+    double double_sum = 0;
+    size_t text_size = 0;
+    const auto count = count_allocations([&]
+    {
+        for (const auto n : args.values_view("-n").view_as<int>())
+            int_sum += n;
+        for (const auto x : args.values_view("-x").view_as<double>())
+            double_sum += x;
+        for (const auto s : args.values_view("-x"))
+            text_size += s.size();
+    }).count;
+    REQUIRE(count == 0);
+    REQUIRE(int_sum == 6);
+    REQUIRE(double_sum == 3.0);
+    REQUIRE(text_size == 6);
+}
+
+TEST_CASE("Results are compacted however parsing ends")
+{
+    using namespace argos;
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Arg("FILE").count(1, UINT_MAX))
+        .add(Opt("-i").argument("DIR").operation(OptionOperation::APPEND))
+        .add(Opt("--stop").type(OptionType::STOP))
+        .compile();
+
+    // Reading the values of a compacted result doesn't allocate memory,
+    // compacting it does.
+    auto read_values = [](const ParsedArguments& args)
+    {
+        size_t size = 0;
+        const auto count = count_allocations([&]
+        {
+            for (const auto s : args.values_view("-i"))
+                size += s.size();
+            for (const auto s : args.values_view("FILE"))
+                size += s.size();
+        }).count;
+        REQUIRE(size != 0);
+        return count;
+    };
+
+    const auto stopped = parser.parse(std::vector<std::string_view>{
+        "-i", "x", "a", "-i", "y", "--stop", "b"});
+    REQUIRE(stopped.result_code() == ParserResultCode::STOP);
+    REQUIRE(read_values(stopped) == 0);
+
+    const auto failed = parser.parse(std::vector<std::string_view>{
+        "-i", "x", "a", "-i", "y", "-q"});
+    REQUIRE(failed.result_code() == ParserResultCode::FAILURE);
+    REQUIRE(read_values(failed) == 0);
+
+    const auto result = parser.try_parse(std::vector<std::string_view>{
+        "-i", "x", "a", "-i", "y", "-q"});
+    REQUIRE(!result);
+    REQUIRE(read_values(result.value()) == 0);
+}
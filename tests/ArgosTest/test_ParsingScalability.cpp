@@ -0,0 +1,208 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgumentParser.hpp"
+
+#include <climits>
+#include "AllocationCounter.hpp"
+#include "Argos/ArgumentIteratorImpl.hpp"
+
+// The tests in this file verify that parsing does a linear amount of work
+// in the number of arguments. Timing the parser makes the tests depend on
+// the machine and its load, so they count what the parser does instead:
+// the options and arguments it reads ahead to count each command's
+// arguments, and the memory it allocates. Reading the remaining arguments
+// again for each sub-command or inserted argument, or copying them, makes
+// the work per argument grow with the number of arguments. The number of
+// arguments read ahead per argument must stay below a small constant. The
+// memory per argument for large argument lists is compared with the memory
+// per argument for 1000 arguments, the limit allows for the rounding of
+// buffer sizes, but not for quadratic behavior.
+
+namespace
+{
+    constexpr double MAX_GROWTH = 2.0;
+    constexpr double MAX_SCANS_PER_ARGUMENT = 5.0;
+    constexpr size_t REFERENCE_SIZE = 1000;
+    constexpr size_t SIZES[] = {10, 1'000, 100'000, 1'000'000};
+
+    std::vector<std::string> make_arguments(size_t n, size_t group_size = 0,
+                                            const std::string& group_start = {})
+    {
+        std::vector<std::string> result;
+        result.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (group_size != 0 && i % group_size == 0)
+                result.push_back(group_start);
+            else
+                result.push_back("file" + std::to_string(i) + ".txt");
+        }
+        return result;
+    }
+
+    struct Work
+    {
+        /// The number of arguments read ahead per argument.
+        double scans = 0;
+        /// The number of bytes allocated per argument.
+        double bytes = 0;
+    };
+
+    /**
+     * @brief Returns the work @a parse does per argument when it parses
+     *  the @a n arguments @a make_args returns.
+     */
+    template <typename MakeArgs, typename Parse>
+    Work measure_work(size_t n, MakeArgs make_args, Parse parse)
+    {
+        using argos::ArgumentIteratorImpl;
+        const auto strings = make_args(n);
+        const std::vector<std::string_view> args(strings.begin(), strings.end());
+        const auto scans = ArgumentIteratorImpl::scanned_argument_count();
+        const auto allocations = count_allocations([&] { parse(args); });
+        const auto size = double(args.size());
+        return {double(ArgumentIteratorImpl::scanned_argument_count() - scans) / size,
+                double(allocations.bytes) / size};
+    }
+
+    template <typename MakeArgs, typename Parse>
+    void check_linear_scaling(MakeArgs make_args, Parse parse)
+    {
+        const auto reference = measure_work(REFERENCE_SIZE, make_args, parse);
+        for (const auto n : SIZES)
+        {
+            const auto work = measure_work(n, make_args, parse);
+            INFO("n = " << n << ": " << work.scans << " arguments read ahead and "
+                 << work.bytes << " bytes allocated per argument, "
+                 << reference.bytes << " bytes for n = " << REFERENCE_SIZE);
+            CHECK(work.scans < MAX_SCANS_PER_ARGUMENT);
+            if (n > REFERENCE_SIZE)
+                CHECK(work.bytes < reference.bytes * MAX_GROWTH);
+        }
+    }
+}
+
+TEST_CASE("Parsing scales linearly for variadic arguments")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Arg("FILE").count(1, UINT_MAX))
+        .add(Arg("DIR"))
+        .add(Opt("-v"))
+        .compile();
+
+    check_linear_scaling([](size_t n) { return make_arguments(n); },
+                         [&](const std::vector<std::string_view>& args)
+                         {
+                             auto result = parser.parse(args);
+                             REQUIRE(result.result_code() == ParserResultCode::SUCCESS);
+                             REQUIRE(result.values("FILE").size() == args.size() - 1);
+                         });
+}
+
+TEST_CASE("Parsing scales linearly for multiple subcommands")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .allow_multiple_subcommands(true)
+        .add(Command("copy")
+            .add(Arg("FILE").count(1, UINT_MAX))
+            .add(Arg("DIR")))
+        .compile();
+
+    check_linear_scaling([](size_t n) { return make_arguments(n - n % 4, 4, "copy"); },
+                         [&](const std::vector<std::string_view>& args)
+                         {
+                             auto result = parser.parse(args);
+                             REQUIRE(result.result_code() == ParserResultCode::SUCCESS);
+                             REQUIRE(result.subcommands().size() == args.size() / 4);
+                         });
+}
+
+TEST_CASE("Parsing scales linearly when callbacks insert arguments")
+{
+    using namespace argos;
+    size_t count = 0;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Arg("FILE").count(1, UINT_MAX)
+            .callback([&](auto& args)
+            {
+                if (++count % 100 == 0)
+                    args.new_arguments.emplace_back("extra.txt");
+            }))
+        .add(Arg("DIR"))
+        .compile();
+
+    check_linear_scaling([](size_t n) { return make_arguments(n); },
+                         [&](const std::vector<std::string_view>& args)
+                         {
+                             count = 0;
+                             auto result = parser.parse(args);
+                             REQUIRE(result.result_code() == ParserResultCode::SUCCESS);
+                             REQUIRE(result.value("DIR").as_string() == args.back());
+                         });
+}
+
+TEST_CASE("Parsing scales linearly when callbacks insert options that take values")
+{
+    using namespace argos;
+    // Every tenth file inserts -o, which takes the next file as its value.
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Arg("FILE").count(1, UINT_MAX)
+            .callback([](auto& args)
+            {
+                if (args.value.ends_with("0.txt"))
+                    args.new_arguments.emplace_back("-o");
+            }))
+        .add(Arg("DEST"))
+        .add(Opt("-o").argument("O").operation(OptionOperation::APPEND))
+        .compile();
+
+    check_linear_scaling([](size_t n) { return make_arguments(n); },
+                         [&](const std::vector<std::string_view>& args)
+                         {
+                             auto result = parser.parse(args);
+                             const auto inserted = (args.size() - 2) / 10 + 1;
+                             REQUIRE(result.result_code() == ParserResultCode::SUCCESS);
+                             REQUIRE(result.values("-o").size() == inserted);
+                             REQUIRE(result.values("FILE").size() == args.size() - 1 - inserted);
+                             REQUIRE(result.value("DEST").as_string() == args.back());
+                         });
+}
+
+TEST_CASE("Parsing scales linearly when callbacks insert the end of options marker")
+{
+    using namespace argos;
+    // The first "--" ends the options, the others are files.
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Arg("FILE").count(1, UINT_MAX)
+            .callback([](auto& args)
+            {
+                if (args.value.ends_with("0.txt"))
+                    args.new_arguments.emplace_back("--");
+            }))
+        .add(Arg("DEST"))
+        .add(Opt("--").type(OptionType::LAST_OPTION))
+        .compile();
+
+    check_linear_scaling([](size_t n) { return make_arguments(n); },
+                         [&](const std::vector<std::string_view>& args)
+                         {
+                             auto result = parser.parse(args);
+                             const auto inserted = (args.size() - 2) / 10 + 1;
+                             REQUIRE(result.result_code() == ParserResultCode::SUCCESS);
+                             REQUIRE(result.values("FILE").size() == args.size() - 2 + inserted);
+                             REQUIRE(result.value("DEST").as_string() == args.back());
+                         });
+}
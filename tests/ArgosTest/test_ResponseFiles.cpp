@@ -0,0 +1,158 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/Argos.hpp"
+#include "Argos/ResponseFiles.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "Argv.hpp"
+
+namespace
+{
+    using namespace argos;
+
+    /// A file in the temporary directory that is removed again when
+    /// the test is done.
+    struct TempFile
+    {
+        TempFile(const std::string& name, const std::string& contents)
+            : path((std::filesystem::temp_directory_path()
+                    / ("argos_test_" + name)).string())
+        {
+            std::ofstream(path, std::ios::binary) << contents;
+        }
+
+        ~TempFile()
+        {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+
+        std::string path;
+    };
+
+    std::vector<std::string> tokenize(std::string text)
+    {
+        std::vector<std::string> result;
+        ResponseFileTokenizer tokenizer(text);
+        std::string_view token;
+        while (tokenizer.next(token))
+            result.emplace_back(token);
+        return result;
+    }
+
+    ArgumentParser make_parser(std::ostream& stream)
+    {
+        ArgumentParser parser("test");
+        parser.auto_exit(false)
+            .stream(&stream)
+            .allow_response_files(true)
+            .add(Opt("-I").argument("DIR").operation(OptionOperation::APPEND))
+            .add(Opt("-o").argument("FILE"))
+            .add(Arg("SOURCE").count(0, 100));
+        return parser;
+    }
+}
+
+TEST_CASE("Tokenize response file")
+{
+    using V = std::vector<std::string>;
+    REQUIRE(tokenize("") == V{});
+    REQUIRE(tokenize(" \n\t ") == V{});
+    REQUIRE(tokenize("a bb\n ccc\r\n") == V{"a", "bb", "ccc"});
+    REQUIRE(tokenize(R"("a b" 'c "d"' e"f g"h)") == V{"a b", "c \"d\"", "ef gh"});
+    REQUIRE(tokenize(R"(a\ b c\\d \"e)") == V{"a b", "c\\d", "\"e"});
+    REQUIRE(tokenize(R"("a\"b" '')") == V{"a\"b", ""});
+    REQUIRE(tokenize("a\\") == V{"a\\"});
+    REQUIRE(tokenize("\"a b") == V{"a b"});
+}
+
+TEST_CASE("Parse arguments from response file")
+{
+    TempFile file("args.rsp", "-I 'dir 1'\n-I dir\\ 2 -o out\n\"a.c\" b.c\n");
+    Argv argv{"test", "x.c", "@" + file.path, "y.c"};
+    std::stringstream ss;
+    const auto args = make_parser(ss).parse(argv.size(), argv.data());
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("-I").as_strings()
+            == std::vector<std::string>{"dir 1", "dir 2"});
+    REQUIRE(args.value("-o").as_string() == "out");
+    REQUIRE(args.values("SOURCE").as_strings()
+            == std::vector<std::string>{"x.c", "a.c", "b.c", "y.c"});
+}
+
+TEST_CASE("Response files are ignored unless they are allowed")
+{
+    TempFile file("ignored.rsp", "a.c");
+    Argv argv{"test", "@" + file.path};
+    std::stringstream ss;
+    const auto args = make_parser(ss).allow_response_files(false)
+        .parse(argv.size(), argv.data());
+    REQUIRE(args.values("SOURCE").as_strings()
+            == std::vector<std::string>{"@" + file.path});
+}
+
+TEST_CASE("Nested response files")
+{
+    TempFile inner("inner.rsp", "-I inner b.c");
+    TempFile outer("outer.rsp", "a.c @" + inner.path + " c.c");
+    Argv argv{"test", "@" + outer.path, "@" + inner.path};
+    std::stringstream ss;
+    const auto args = make_parser(ss).parse(argv.size(), argv.data());
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("-I").as_strings()
+            == std::vector<std::string>{"inner", "inner"});
+    REQUIRE(args.values("SOURCE").as_strings()
+            == std::vector<std::string>{"a.c", "b.c", "c.c", "b.c"});
+}
+
+TEST_CASE("Response file that includes itself")
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto a_path = (dir / "argos_test_cycle_a.rsp").string();
+    TempFile b("cycle_b.rsp", "b.c @" + a_path);
+    TempFile a("cycle_a.rsp", "a.c @" + b.path);
+    Argv argv{"test", "@" + a.path};
+    std::stringstream ss;
+    const auto args = make_parser(ss).parse(argv.size(), argv.data());
+    REQUIRE(args.result_code() == ParserResultCode::FAILURE);
+    REQUIRE(ss.str().find("Response file includes itself") != std::string::npos);
+}
+
+TEST_CASE("Response file that can't be read is a normal argument")
+{
+    const auto path = (std::filesystem::temp_directory_path()
+                       / "argos_test_no_such_file.rsp").string();
+    Argv argv{"test", "@" + path, "@"};
+    std::stringstream ss;
+    const auto args = make_parser(ss).parse(argv.size(), argv.data());
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.values("SOURCE").as_strings()
+            == std::vector<std::string>{"@" + path, "@"});
+}
+
+TEST_CASE("IncrementalParser expands response files")
+{
+    TempFile file("incremental.rsp", "-o out a.c");
+    std::stringstream ss;
+    auto parser = make_parser(ss).compile().make_incremental_parser();
+    parser.push("@" + file.path);
+    parser.push("b.c");
+    parser.finish();
+    std::unique_ptr<IArgumentView> arg;
+    std::string_view value;
+    while (parser.next(arg, value) == IncrementalResult::PROCESSED)
+    {}
+    const auto args = parser.parsed_arguments();
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(args.value("-o").as_string() == "out");
+    REQUIRE(args.values("SOURCE").as_strings()
+            == std::vector<std::string>{"a.c", "b.c"});
+}
@@ -117,3 +117,54 @@ TEST_CASE("Test skipping value after =.")
     value = it.next();
     REQUIRE(!value.has_value());
 }
+
+TEST_CASE("Test that arguments are not copied.")
+{
+    std::vector<std::string> strings{"--def=ghi", "-ab", "jkl"};
+    argos::StandardOptionIterator it{argos::ArgumentSource(strings)};
+    auto value = it.next();
+    REQUIRE(value.has_value());
+    REQUIRE(value->data() == strings[0].data());
+    value = it.next_value();
+    REQUIRE(value.has_value());
+    REQUIRE(value->data() == strings[0].data() + 6);
+    value = it.next();
+    REQUIRE(value.has_value());
+    REQUIRE(*value == "-a");
+    value = it.next();
+    REQUIRE(value.has_value());
+    REQUIRE(*value == "-b");
+    value = it.next();
+    REQUIRE(value.has_value());
+    REQUIRE(value->data() == strings[2].data());
+}
+
+TEST_CASE("Test inserting arguments repeatedly.")
+{
+    std::vector<std::string> strings{"-ab", "x", "y"};
+    argos::StandardOptionIterator it{argos::ArgumentSource(strings)};
+    REQUIRE(*it.next() == "-a");
+    it.insert({"--c", "-de"});
+    REQUIRE(*it.next() == "--c");
+    std::vector<std::string> many;
+    for (int i = 0; i < 100; ++i)
+        many.push_back("m" + std::to_string(i));
+    it.insert(many);
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(*it.next() == many[i]);
+        if (i % 10 == 0)
+            it.insert({"i" + std::to_string(i)});
+        if (i % 10 == 0)
+            REQUIRE(*it.next() == "i" + std::to_string(i));
+    }
+    REQUIRE(*it.next() == "-d");
+    it.insert({"z"});
+    REQUIRE(*it.next() == "z");
+    REQUIRE(*it.next() == "-e");
+    REQUIRE(*it.next() == "-b");
+    REQUIRE(*it.next() == "x");
+    REQUIRE(it.remaining_arguments().size() == 1);
+    REQUIRE(*it.next() == "y");
+    REQUIRE(!it.next());
+}
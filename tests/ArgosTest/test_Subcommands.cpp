@@ -308,3 +308,171 @@ TEST_CASE("Multi-commands with arguments with count")
     REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
     REQUIRE(args.subcommands().size() == 2);
 }
+
+TEST_CASE("Case-insensitive command names")
+{
+    using namespace argos;
+    std::stringstream stream;
+    const auto parser = ArgumentParser()
+        .auto_exit(false)
+        .stream(&stream)
+        .case_insensitive(true)
+        .add(Command("Foo"))
+        .add(Command("bar"))
+        .move();
+    REQUIRE(parser.parse({"fOO"}).subcommands()[0].name() == "Foo");
+    REQUIRE(parser.parse({"BAR"}).subcommands()[0].name() == "bar");
+    REQUIRE(parser.parse({"ba"}).result_code() == ParserResultCode::FAILURE);
+}
+
+TEST_CASE("Abbreviated command names")
+{
+    using namespace argos;
+    std::stringstream stream;
+    const auto parser = ArgumentParser()
+        .auto_exit(false)
+        .stream(&stream)
+        .allow_abbreviated_commands(true)
+        .allow_multiple_subcommands(true)
+        .add(Command("list"))
+        .add(Command("link"))
+        .add(Command("lin"))
+        .add(Command("status"))
+        .move();
+
+    auto names = [&](std::vector<std::string_view> args)
+    {
+        std::vector<std::string> result;
+        for (auto& cmd : parser.parse(args).subcommands())
+            result.emplace_back(cmd.name());
+        return result;
+    };
+
+    REQUIRE(names({"st", "lis", "lin", "link"})
+            == std::vector<std::string>{"status", "list", "lin", "link"});
+    REQUIRE(parser.parse({"li"}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(parser.allow_abbreviated_commands());
+}
+
+TEST_CASE("Many subcommands")
+{
+    using namespace argos;
+    ArgumentParser parser;
+    parser.auto_exit(false).allow_multiple_subcommands(true);
+    for (int i = 0; i < 800; ++i)
+        parser.add(Command("cmd" + std::to_string(i)));
+    const auto compiled = parser.compile();
+
+    const auto args = compiled.parse({"cmd799", "cmd0", "cmd400", "cmd79"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto commands = args.subcommands();
+    REQUIRE(commands.size() == 4);
+    REQUIRE(commands[0].name() == "cmd799");
+    REQUIRE(commands[1].name() == "cmd0");
+    REQUIRE(commands[2].name() == "cmd400");
+    REQUIRE(commands[3].name() == "cmd79");
+}
+
+TEST_CASE("Commands must have unique names")
+{
+    using namespace argos;
+    auto parser = ArgumentParser()
+        .auto_exit(false)
+        .add(Command("foo"))
+        .add(Command("foo"))
+        .move();
+    REQUIRE_THROWS_AS(parser.parse({"foo"}), ArgosException);
+}
+
+TEST_CASE("Lazily defined commands")
+{
+    using namespace argos;
+    std::vector<std::string> defined;
+    std::stringstream stream;
+    ArgumentParser parser;
+    parser.auto_exit(false).stream(&stream);
+    for (const auto* name : {"foo", "bar", "baz"})
+    {
+        parser.add(Command(name)
+            .help(std::string("Does ") + name + " things.")
+            .lazy_definition([&defined, name](Command& cmd)
+            {
+                defined.emplace_back(name);
+                cmd.add(Arg("FILE"))
+                    .add(Opt("-n", "--number").argument("N"));
+            }));
+    }
+    const auto compiled = parser.compile();
+    REQUIRE(defined.empty());
+
+    SECTION("Only the selected command is defined")
+    {
+        const auto args = compiled.parse({"bar", "-n", "3", "file.txt"});
+        REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+        REQUIRE(defined == std::vector<std::string>{"bar"});
+        const auto cmd = args.subcommands()[0];
+        REQUIRE(cmd.value("--number").as_int() == 3);
+        REQUIRE(cmd.value("FILE").as_string() == "file.txt");
+
+        REQUIRE(compiled.parse({"bar", "file.txt"}).result_code()
+                == ParserResultCode::SUCCESS);
+        REQUIRE(defined == std::vector<std::string>{"bar"});
+    }
+
+    SECTION("Help text of a lazily defined command")
+    {
+        compiled.write_subcommand_help_text({"baz"});
+        REQUIRE(defined == std::vector<std::string>{"baz"});
+        REQUIRE(stream.str().find("--number") != std::string::npos);
+    }
+
+    SECTION("The parent's help text doesn't define the commands")
+    {
+        compiled.write_help_text();
+        REQUIRE(defined.empty());
+        REQUIRE(stream.str().find("Does baz things.") != std::string::npos);
+    }
+}
+
+TEST_CASE("Nested lazily defined commands")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser()
+        .auto_exit(false)
+        .add(Command("remote")
+            .lazy_definition([](Command& cmd)
+            {
+                cmd.add(Command("add")
+                    .lazy_definition([](Command& sub)
+                    {
+                        sub.add(Arg("NAME")).add(Arg("URL"));
+                    }));
+            }))
+        .compile();
+
+    const auto args = parser.parse({"remote", "add", "origin", "url"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    const auto remote = args.subcommands()[0];
+    REQUIRE(remote.name() == "remote");
+    const auto add = remote.subcommands()[0];
+    REQUIRE(add.value("NAME").as_string() == "origin");
+    REQUIRE(add.value("URL").as_string() == "url");
+}
+
+TEST_CASE("An invalid lazy definition fails every time it is used")
+{
+    using namespace argos;
+    const auto parser = ArgumentParser()
+        .auto_exit(false)
+        .add(Command("sub")
+            .lazy_definition([](Command& cmd)
+            {
+                cmd.add(Opt("--x").argument("X")
+                    .value_type(ValueType::INT)
+                    .initial_value("abc"));
+            }))
+        .compile();
+
+    REQUIRE_THROWS_AS(parser.parse({"sub", "--x", "1"}), ArgosException);
+    REQUIRE_THROWS_AS(parser.parse({"sub", "--x", "1"}), ArgosException);
+}
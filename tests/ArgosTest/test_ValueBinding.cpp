@@ -0,0 +1,216 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgosException.hpp"
+#include "Argos/ArgumentParser.hpp"
+
+#include <sstream>
+
+using namespace argos;
+
+namespace
+{
+    struct Config
+    {
+        int threads = 4;
+        bool verbose = false;
+        std::string name = "default";
+        std::vector<double> weights;
+        std::vector<std::string> files;
+    };
+}
+
+TEST_CASE("Bound options and arguments")
+{
+    Config cfg;
+    ArgumentParser parser("test");
+    parser.auto_exit(false)
+        .add(Opt("-j", "--threads").argument("N").bind(cfg.threads))
+        .add(Opt("-v", "--verbose").bind(cfg.verbose))
+        .add(Opt("-q", "--quiet").alias("--verbose")
+                 .operation(OptionOperation::CLEAR))
+        .add(Opt("--name").argument("NAME").bind(cfg.name))
+        .add(Opt("-w").argument("W").operation(OptionOperation::APPEND)
+                 .bind(cfg.weights))
+        .add(Arg("FILE").count(0, 10).bind(cfg.files));
+    const auto compiled = parser.compile();
+
+    auto args = compiled.parse({"-j", "8", "-v", "-w", "0.5", "a", "-w", "2",
+                                "--name=x", "b"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(cfg.threads == 8);
+    REQUIRE(cfg.verbose);
+    REQUIRE(cfg.name == "x");
+    REQUIRE(cfg.weights == std::vector<double>{0.5, 2});
+    REQUIRE(cfg.files == std::vector<std::string>{"a", "b"});
+
+    REQUIRE(args.has("-j"));
+    REQUIRE(!args.value("-j"));
+    REQUIRE(args.values("FILE").empty());
+    REQUIRE(args.has("--name"));
+
+    args = compiled.parse({"-v", "-q", "-j", "2", "-j", "3"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(!cfg.verbose);
+    REQUIRE(!args.has("--verbose"));
+    REQUIRE(cfg.threads == 3);
+    // The variables get the values they had when they were bound
+    // before each parse.
+    REQUIRE(cfg.name == "default");
+    REQUIRE(cfg.weights.empty());
+    REQUIRE(cfg.files.empty());
+
+    args = compiled.parse({"-w", "1", "c"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(cfg.threads == 4);
+    REQUIRE(cfg.weights == std::vector<double>{1});
+    REQUIRE(cfg.files == std::vector<std::string>{"c"});
+}
+
+TEST_CASE("Bound vectors with ASSIGN and CLEAR")
+{
+    std::vector<int> values = {1, 2};
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-a").argument("N").operation(OptionOperation::APPEND)
+                 .bind(values))
+        .add(Opt("-s").argument("N").alias("-a"))
+        .add(Opt("-c").alias("-a").operation(OptionOperation::CLEAR))
+        .parse({"-a", "3", "-a", "4"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(values == std::vector<int>{1, 2, 3, 4});
+
+    values = {1, 2};
+    args = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-a").argument("N").operation(OptionOperation::APPEND)
+                 .bind(values))
+        .add(Opt("-s").argument("N").alias("-a"))
+        .add(Opt("-c").alias("-a").operation(OptionOperation::CLEAR))
+        .parse({"-a", "3", "-s", "5", "-a", "6", "-c", "-a", "7"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(values == std::vector<int>{7});
+}
+
+TEST_CASE("Initial values of bound vectors in repeated parses")
+{
+    std::vector<int> values;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-a").argument("N").operation(OptionOperation::APPEND)
+                 .initial_value("1").bind(values))
+        .compile();
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(parser.parse({"-a", "2"}).result_code()
+                == ParserResultCode::SUCCESS);
+        REQUIRE(values == std::vector<int>{1, 2});
+    }
+}
+
+TEST_CASE("Invalid values for bound options")
+{
+    int n = 5;
+    std::stringstream ss;
+    auto args = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Opt("-n").argument("N").bind(n))
+        .parse({"-n", "five"});
+    REQUIRE(args.result_code() == ParserResultCode::FAILURE);
+    REQUIRE(ss.str().find("-n: Invalid value: five.") != std::string::npos);
+    REQUIRE(n == 5);
+}
+
+TEST_CASE("Mandatory bound options")
+{
+    unsigned n = 0;
+    std::stringstream ss;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .stream(&ss)
+        .add(Opt("-n").argument("N").bind(n).mandatory())
+        .compile();
+    REQUIRE(parser.parse({}).result_code() == ParserResultCode::FAILURE);
+    REQUIRE(parser.parse({"-n", "3"}).result_code()
+            == ParserResultCode::SUCCESS);
+    REQUIRE(n == 3);
+}
+
+TEST_CASE("Invalid bindings")
+{
+    int a = 0, b = 0;
+    REQUIRE_THROWS_AS(ArgumentParser("test")
+                          .auto_exit(false)
+                          .add(Opt("-a").argument("N").bind(a))
+                          .add(Opt("-b").argument("N").alias("-a").bind(b))
+                          .parse({}),
+                      ArgosException);
+    REQUIRE_THROWS_AS(ArgumentParser("test")
+                          .auto_exit(false)
+                          .add(Opt("-a").argument("N").bind(a)
+                                   .value_type(ValueType::DOUBLE))
+                          .parse({}),
+                      ArgosException);
+    REQUIRE_THROWS_AS(ArgumentParser("test")
+                          .auto_exit(false)
+                          .add(Opt("-a").bind(a).constant("x"))
+                          .parse({}),
+                      ArgosException);
+}
+
+TEST_CASE("Bound options in lazily defined sub-commands")
+{
+    int n = 0;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Cmd("sub").lazy_definition([&n](Command& cmd)
+        {
+            cmd.add(Opt("-n").argument("N").bind(n));
+        }))
+        .compile();
+    REQUIRE(parser.parse({"sub", "-n", "3"}).result_code()
+            == ParserResultCode::SUCCESS);
+    REQUIRE(n == 3);
+    REQUIRE(parser.parse({"sub"}).result_code()
+            == ParserResultCode::SUCCESS);
+    REQUIRE(n == 0);
+}
+
+TEST_CASE("parse_batch with bound options")
+{
+    int n = 0;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Opt("-n").argument("N").bind(n))
+        .compile();
+    const std::vector<std::vector<std::string>> command_lines = {{"-n", "1"}};
+    REQUIRE_THROWS_AS(parser.parse_batch(command_lines), ArgosException);
+}
+
+TEST_CASE("parse_batch with bound options in a lazily defined sub-command")
+{
+    int n = 0;
+    const auto parser = ArgumentParser("test")
+        .auto_exit(false)
+        .add(Cmd("sub").lazy_definition([&n](Command& cmd)
+        {
+            cmd.add(Opt("-n").argument("N").bind(n));
+        }))
+        .compile();
+    const std::vector<std::vector<std::string>> command_lines = {
+        {"sub", "-n", "1"}, {"sub", "-n", "2"}};
+    REQUIRE_THROWS_AS(parser.parse_batch(command_lines, 2), ArgosException);
+    REQUIRE(n == 0);
+
+    // The sub-command is defined by the first parse outside a batch.
+    const auto args = parser.parse({"sub", "-n", "3"});
+    REQUIRE(args.result_code() == ParserResultCode::SUCCESS);
+    REQUIRE(n == 3);
+    REQUIRE_THROWS_AS(parser.parse_batch(command_lines, 2), ArgosException);
+}
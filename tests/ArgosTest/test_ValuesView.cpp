@@ -0,0 +1,89 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Argos/ArgosException.hpp"
+#include "Argos/ArgumentParser.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+using namespace argos;
+
+static_assert(std::ranges::random_access_range<ValuesView<int>>);
+static_assert(std::ranges::sized_range<ValuesView<std::string_view>>);
+static_assert(std::ranges::borrowed_range<ValuesView<double>>);
+
+namespace
+{
+    CompiledParser make_parser()
+    {
+        return ArgumentParser("test")
+            .auto_exit(false)
+            .add(Arg("NUMBER").count(0, 10))
+            .add(Opt("-t").argument("N").operation(OptionOperation::APPEND)
+                     .value_type(ValueType::LONG))
+            .add(Opt("-d").argument("DIR").initial_value("/usr")
+                     .operation(OptionOperation::APPEND))
+            .compile();
+    }
+}
+
+TEST_CASE("Iterate over the raw values in a ValuesView")
+{
+    const auto args = make_parser().parse(
+        std::vector<std::string_view>{"1", "22", "-d", "/opt", "333"});
+    const auto view = args.values_view("NUMBER");
+    REQUIRE(view.size() == 3);
+    REQUIRE(view[1] == "22");
+    REQUIRE(std::vector<std::string_view>(view.begin(), view.end())
+            == std::vector<std::string_view>{"1", "22", "333"});
+    REQUIRE(std::ranges::find(view, "333") == view.begin() + 2);
+
+    const auto dirs = args.values_view("-d");
+    REQUIRE(dirs.size() == 2);
+    REQUIRE(dirs.front() == "/usr");
+    REQUIRE(dirs.back() == "/opt");
+}
+
+TEST_CASE("Convert the values in a ValuesView")
+{
+    const auto args = make_parser().parse(
+        std::vector<std::string_view>{"1", "-t", "10", "22", "-t", "20"});
+
+    const auto numbers = args.values_view("NUMBER").view_as<int>();
+    REQUIRE(numbers[0] == 1);
+    REQUIRE(numbers[1] == 22);
+
+    auto doubled = args.values_view("-t").view_as<long>()
+                   | std::views::transform([](long n) { return 2 * n; });
+    REQUIRE(std::vector<long>(doubled.begin(), doubled.end())
+            == std::vector<long>{20, 40});
+
+    const auto values = args.values("-t");
+    long sum = 0;
+    for (const auto n : values.view_as<long>())
+        sum += n;
+    REQUIRE(sum == 30);
+}
+
+TEST_CASE("A ValuesView reports invalid values when they are read")
+{
+    const auto args = make_parser().parse(
+        std::vector<std::string_view>{"1", "two"});
+    const auto numbers = args.values_view("NUMBER").view_as<int>();
+    REQUIRE(numbers[0] == 1);
+    REQUIRE_THROWS_AS(numbers[1], ArgosException);
+}
+
+TEST_CASE("A ValuesView of a missing value is empty")
+{
+    const auto args = make_parser().parse(std::vector<std::string_view>{});
+    REQUIRE(args.values_view("NUMBER").empty());
+    REQUIRE(args.values_view("-t").view_as<long>().empty());
+    REQUIRE_THROWS(args.values_view("-x"));
+}